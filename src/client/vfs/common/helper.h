@@ -213,6 +213,15 @@ inline std::string FsStat2Str(const FsStat& fs_stat) {
 }
 
 inline std::string Slice2Str(const Slice& slice) {
+  if (slice.IsPacked()) {
+    return fmt::format(
+        "(id: {}, range: [{}-{}], compaction: {}, is_zero: {}, size: {}, "
+        "pack_offset: {}, pack_refs: {})",
+        slice.id, slice.offset, slice.End(), slice.compaction,
+        slice.is_zero ? "true" : "false", slice.size, slice.pack_offset,
+        slice.pack_refs);
+  }
+
   return fmt::format(
       "(id: {}, range: [{}-{}], compaction: {}, is_zero: {}, size: {})",
       slice.id, slice.offset, slice.End(), slice.compaction,
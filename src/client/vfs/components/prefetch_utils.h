@@ -92,9 +92,11 @@ inline std::vector<BlockContext> Chunk2Block(ContextSPtr ctx, VFSHub* vfs_hub,
 
   std::vector<BlockContext> block_contexts;
   for (const auto& block_req : block_reqs) {
-    cache::BlockKey key(req.fs_id, req.ino, block_req.block.slice_id,
-                        block_req.block.index, block_req.block.version);
-    block_contexts.emplace_back(key, block_req.block.block_len);
+    // packed block is prefetched as the whole pack object
+    cache::BlockKey key(req.fs_id, block_req.block.KeyIno(req.ino),
+                        block_req.block.slice_id, block_req.block.index,
+                        block_req.block.version);
+    block_contexts.emplace_back(key, block_req.block.ObjectLen());
   }
 
   return block_contexts;
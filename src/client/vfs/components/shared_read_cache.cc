@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client/vfs/components/shared_read_cache.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "client/vfs/hub/vfs_hub.h"
+#include "common/status.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+SharedReadCache::SharedReadCache(VFSHub* hub, int64_t capacity_bytes,
+                                 int64_t chunk_size)
+    : hub_(hub),
+      capacity_bytes_(capacity_bytes),
+      chunk_size_(chunk_size),
+      dedup_ratio_("vfs_shared_read_cache_dedup_ratio", DedupRatio, this) {}
+
+SharedReadCache::~SharedReadCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (used_bytes_ > 0) {
+    hub_->GetReadBufferManager()->Release(used_bytes_);
+  }
+  used_bytes_ = 0;
+
+  lru_.clear();
+  entries_.clear();
+  chunks_.clear();
+}
+
+double SharedReadCache::DedupRatio(void* arg) {
+  auto* self = reinterpret_cast<SharedReadCache*>(arg);
+  uint64_t fetch_bytes = self->fetch_bytes_.get_value();
+  if (fetch_bytes == 0) {
+    return 0.0;
+  }
+
+  return static_cast<double>(self->serve_bytes_.get_value()) / fetch_bytes;
+}
+
+void SharedReadCache::ServeWaiter(const EntrySPtr& entry, Waiter& waiter,
+                                  Status s) {
+  if (s.ok()) {
+    entry->data.CopyTo(waiter.data, waiter.length, waiter.offset);
+  }
+
+  waiter.cb(s);
+}
+
+void SharedReadCache::RangeAsync(ContextSPtr ctx, Ino ino, int64_t chunk_index,
+                                 uint64_t chunk_version, RangeReq req,
+                                 StatusCallback cb) {
+  CHECK(req.data != nullptr) << "data is nullptr.";
+  CHECK(req.offset + req.length <= static_cast<int64_t>(req.block_size))
+      << fmt::format("invalid range, offset({}) length({}) block_size({}).",
+                     req.offset, req.length, req.block_size);
+
+  Waiter waiter{.offset = req.offset,
+                .length = req.length,
+                .data = req.data,
+                .cb = std::move(cb)};
+
+  std::string key = req.block.StoreKey();
+  EntrySPtr entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      entry = it->second;
+      if (!entry->ready) {
+        // same block is fetching, wait for it
+        join_count_ << 1;
+        serve_bytes_ << req.length;
+        entry->waiters.push_back(std::move(waiter));
+        return;
+      }
+
+      lru_.splice(lru_.begin(), lru_, entry->lru_it);
+
+    } else {
+      entry = std::make_shared<Entry>();
+      entry->key = key;
+      entry->ino = ino;
+      entry->chunk_index = chunk_index;
+      entry->chunk_version = chunk_version;
+      entry->bytes = static_cast<int64_t>(req.block_size);
+      entry->waiters.push_back(std::move(waiter));
+
+      entries_.emplace(key, entry);
+
+      auto& chunk_state = chunks_[ChunkKey{ino, chunk_index}];
+      chunk_state.version = std::max(chunk_state.version, chunk_version);
+      chunk_state.keys.insert(key);
+    }
+  }
+
+  if (entry->ready) {
+    hit_count_ << 1;
+    serve_bytes_ << req.length;
+    ServeWaiter(entry, waiter, Status::OK());
+    return;
+  }
+
+  miss_count_ << 1;
+  serve_bytes_ << req.length;
+
+  // fetch the whole block, so other ranges of it can be served later
+  RangeReq fetch_req;
+  fetch_req.block = req.block;
+  fetch_req.block_size = req.block_size;
+  fetch_req.offset = 0;
+  fetch_req.length = static_cast<int64_t>(req.block_size);
+  fetch_req.data = &entry->data;
+
+  hub_->GetBlockStore()->RangeAsync(
+      ctx, fetch_req, [this, entry](Status s) { OnFetchDone(entry, s); });
+}
+
+void SharedReadCache::OnFetchDone(EntrySPtr entry, Status s) {
+  std::vector<Waiter> waiters;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    waiters.swap(entry->waiters);
+
+    if (s.ok()) {
+      fetch_bytes_ << entry->bytes;
+    }
+
+    if (!entry->erased) {
+      if (s.ok()) {
+        entry->ready = true;
+        lru_.push_front(entry);
+        entry->lru_it = lru_.begin();
+
+        used_bytes_ += entry->bytes;
+        hub_->GetReadBufferManager()->Take(entry->bytes);
+
+        EvictUnlock();
+
+      } else {
+        LOG(WARNING) << fmt::format(
+            "[vfs.shared_read_cache] fetch block fail, key({}) status({}).",
+            entry->key, s.ToString());
+
+        // next reader will retry
+        EraseUnlock(entry, true);
+      }
+    }
+  }
+
+  for (auto& waiter : waiters) {
+    ServeWaiter(entry, waiter, s);
+  }
+}
+
+void SharedReadCache::UpdateChunkVersion(Ino ino, int64_t chunk_index,
+                                         uint64_t version) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = chunks_.find(ChunkKey{ino, chunk_index});
+  if (it == chunks_.end() || version <= it->second.version) {
+    return;
+  }
+
+  auto& chunk_state = it->second;
+  chunk_state.version = version;
+
+  std::vector<EntrySPtr> stale_entries;
+  for (const auto& key : chunk_state.keys) {
+    auto entry_it = entries_.find(key);
+    if (entry_it != entries_.end() &&
+        entry_it->second->chunk_version < version) {
+      stale_entries.push_back(entry_it->second);
+    }
+  }
+
+  for (const auto& entry : stale_entries) {
+    chunk_state.keys.erase(entry->key);
+    EraseUnlock(entry, false);
+  }
+
+  if (chunk_state.keys.empty()) {
+    chunks_.erase(it);
+  }
+}
+
+void SharedReadCache::Invalidate(Ino ino, int64_t offset, int64_t size) {
+  if (size <= 0 || chunk_size_ <= 0) {
+    return;
+  }
+
+  int64_t first_index = offset / chunk_size_;
+  int64_t last_index = (offset + size - 1) / chunk_size_;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = chunks_.lower_bound(ChunkKey{ino, first_index});
+  while (it != chunks_.end() && it->first.first == ino &&
+         it->first.second <= last_index) {
+    it = EraseChunkUnlock(it);
+  }
+}
+
+std::map<SharedReadCache::ChunkKey, SharedReadCache::ChunkState>::iterator
+SharedReadCache::EraseChunkUnlock(
+    std::map<ChunkKey, ChunkState>::iterator it) {
+  for (const auto& key : it->second.keys) {
+    auto entry_it = entries_.find(key);
+    if (entry_it != entries_.end()) {
+      EraseUnlock(entry_it->second, false);
+    }
+  }
+
+  return chunks_.erase(it);
+}
+
+void SharedReadCache::EraseUnlock(const EntrySPtr& entry,
+                                  bool erase_from_chunk) {
+  entries_.erase(entry->key);
+
+  if (entry->ready) {
+    lru_.erase(entry->lru_it);
+    used_bytes_ -= entry->bytes;
+    hub_->GetReadBufferManager()->Release(entry->bytes);
+  } else {
+    entry->erased = true;
+  }
+
+  if (erase_from_chunk) {
+    auto it = chunks_.find(ChunkKey{entry->ino, entry->chunk_index});
+    if (it != chunks_.end()) {
+      it->second.keys.erase(entry->key);
+      if (it->second.keys.empty()) {
+        chunks_.erase(it);
+      }
+    }
+  }
+}
+
+void SharedReadCache::EvictUnlock() {
+  // also give memory back when read buffer is under pressure
+  auto* read_buffer_manager = hub_->GetReadBufferManager();
+  while (!lru_.empty() &&
+         (used_bytes_ > capacity_bytes_ ||
+          read_buffer_manager->GetUsedBytes() >
+              read_buffer_manager->GetTotalBytes())) {
+    EntrySPtr entry = lru_.back();
+    EraseUnlock(entry, true);
+    evict_count_ << 1;
+  }
+}
+
+int64_t SharedReadCache::Bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return used_bytes_;
+}
+
+void SharedReadCache::Summary(Json::Value& value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  value["name"] = "shared_read_cache";
+  value["count"] = lru_.size();
+  value["bytes"] = used_bytes_;
+  value["capacity_bytes"] = capacity_bytes_;
+  value["hit_count"] = hit_count_.get_value();
+  value["miss_count"] = miss_count_.get_value();
+  value["join_count"] = join_count_.get_value();
+  value["evict_count"] = evict_count_.get_value();
+  value["dedup_ratio"] = DedupRatio(this);
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINGOFS_CLIENT_VFS_COMPONENTS_SHARED_READ_CACHE_H_
+#define DINGOFS_CLIENT_VFS_COMPONENTS_SHARED_READ_CACHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "bvar/passive_status.h"
+#include "bvar/reducer.h"
+#include "client/vfs/blockstore/block_store.h"
+#include "client/vfs/vfs_meta.h"
+#include "common/callback.h"
+#include "common/io_buffer.h"
+#include "common/trace/context.h"
+#include "json/value.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+class VFSHub;
+class SharedReadCache;
+using SharedReadCacheUPtr = std::unique_ptr<SharedReadCache>;
+
+// Block data cache shared by all file handles of the client.
+// FileReader is per fh, so readers of the same file on different fh used to
+// fetch and buffer their own copy. Here a block is fetched once as a whole,
+// concurrent readers of it wait on the same in-flight fetch, and later
+// readers are served from memory which is charged to ReadBufferManager.
+// Entries are keyed by (ino, chunk index, block key), the block key carries
+// slice id and version, every entry also remember the chunk version it was
+// fetched under, a newer chunk version drops the old entries of the chunk.
+class SharedReadCache {
+ public:
+  SharedReadCache(VFSHub* hub, int64_t capacity_bytes, int64_t chunk_size);
+  ~SharedReadCache();
+
+  static SharedReadCacheUPtr New(VFSHub* hub, int64_t capacity_bytes,
+                                 int64_t chunk_size) {
+    return std::make_unique<SharedReadCache>(hub, capacity_bytes, chunk_size);
+  }
+
+  // read [req.offset, req.offset + req.length) of the block into req.data
+  void RangeAsync(ContextSPtr ctx, Ino ino, int64_t chunk_index,
+                  uint64_t chunk_version, RangeReq req, StatusCallback cb);
+
+  // called after reading the slices of chunk, drop entries fetched under
+  // older chunk version
+  void UpdateChunkVersion(Ino ino, int64_t chunk_index, uint64_t version);
+
+  // drop all entries of chunks overlapping [offset, offset + size)
+  void Invalidate(Ino ino, int64_t offset, int64_t size);
+
+  int64_t Bytes();
+
+  void Summary(Json::Value& value);
+
+ private:
+  struct Waiter {
+    int64_t offset{0};
+    int64_t length{0};
+    IOBuffer* data{nullptr};
+    StatusCallback cb;
+  };
+
+  struct Entry {
+    std::string key;
+    Ino ino{0};
+    int64_t chunk_index{0};
+    uint64_t chunk_version{0};
+    int64_t bytes{0};
+
+    bool ready{false};
+    // erased from index while fetching, result is only used by waiters
+    bool erased{false};
+    IOBuffer data;
+    std::vector<Waiter> waiters;
+    std::list<std::shared_ptr<Entry>>::iterator lru_it;
+  };
+  using EntrySPtr = std::shared_ptr<Entry>;
+
+  struct ChunkState {
+    uint64_t version{0};
+    std::unordered_set<std::string> keys;
+  };
+  // (ino, chunk_index)
+  using ChunkKey = std::pair<Ino, int64_t>;
+
+  void OnFetchDone(EntrySPtr entry, Status s);
+
+  static void ServeWaiter(const EntrySPtr& entry, Waiter& waiter, Status s);
+
+  // protected by mutex_
+  void EraseUnlock(const EntrySPtr& entry, bool erase_from_chunk);
+  // protected by mutex_, return next iterator
+  std::map<ChunkKey, ChunkState>::iterator EraseChunkUnlock(
+      std::map<ChunkKey, ChunkState>::iterator it);
+  // protected by mutex_
+  void EvictUnlock();
+
+  static double DedupRatio(void* arg);
+
+  VFSHub* hub_;
+  const int64_t capacity_bytes_;
+  const int64_t chunk_size_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, EntrySPtr> entries_;
+  // ready entries, most recently used at front
+  std::list<EntrySPtr> lru_;
+  std::map<ChunkKey, ChunkState> chunks_;
+  int64_t used_bytes_{0};
+
+  // metrics
+  bvar::Adder<uint64_t> hit_count_{"vfs_shared_read_cache_hit_count"};
+  bvar::Adder<uint64_t> miss_count_{"vfs_shared_read_cache_miss_count"};
+  // reader joined an in-flight fetch of the same block
+  bvar::Adder<uint64_t> join_count_{"vfs_shared_read_cache_join_count"};
+  bvar::Adder<uint64_t> evict_count_{"vfs_shared_read_cache_evict_count"};
+  bvar::Adder<uint64_t> fetch_bytes_{"vfs_shared_read_cache_fetch_bytes"};
+  bvar::Adder<uint64_t> serve_bytes_{"vfs_shared_read_cache_serve_bytes"};
+  // serve_bytes / fetch_bytes
+  bvar::PassiveStatus<double> dedup_ratio_;
+};
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_CLIENT_VFS_COMPONENTS_SHARED_READ_CACHE_H_
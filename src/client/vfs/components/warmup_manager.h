@@ -20,11 +20,14 @@
 
 #include <atomic>
 #include <cstdint>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "client/vfs/blockstore/block_store.h"
 #include "client/vfs/components/context.h"
+#include "client/vfs/data/common/common.h"
 #include "client/vfs/vfs_meta.h"
 #include "common/metrics/client/vfs/warmup_metric.h"
 #include "common/status.h"
@@ -58,11 +61,22 @@ class WarmupTask {
                                       : std::vector<BlockContext>();
   }
 
-  // Store file blocks for a file
+  // Store file blocks for a file, pack object shared by files of the task
+  // is only warmed up by the first file
   void SetFileBlocks(Ino file, const std::vector<BlockContext>& blocks) {
     utils::WriteLockGuard lck(rwlock_);
-    file_blocks_[file] = blocks;
-    IncTotal(blocks.size());
+    std::vector<BlockContext> to_warmup;
+    to_warmup.reserve(blocks.size());
+    for (const auto& block : blocks) {
+      if (block.key.ino == kPackBlockIno &&
+          !pack_keys_.insert(block.key.Filename()).second) {
+        continue;
+      }
+      to_warmup.push_back(block);
+    }
+
+    IncTotal(to_warmup.size());
+    file_blocks_[file] = std::move(to_warmup);
   }
 
   std::vector<Ino> GetFileInodes() const {
@@ -119,6 +133,7 @@ class WarmupTask {
   Ino task_key_{0};
   std::unordered_map<Ino, std::vector<BlockContext>>
       file_blocks_;  // inode -> blocks
+  std::unordered_set<std::string> pack_keys_;
   mutable BthreadRWLock rwlock_;
   WarmupTaskContext context_;
   WarmupProgress progress_;
@@ -34,6 +34,14 @@ std::string SliceReadReq::ToString() const {
 }
 
 std::string BlockDesc::ToString() const {
+  if (packed) {
+    return fmt::format(
+        "(file_range:[{}-{}], len: {}, zero: {}, version: {}, slice_id: {}, "
+        "block_index: {}, pack_len: {})",
+        file_offset, End(), block_len, zero, version, slice_id, index,
+        pack_len);
+  }
+
   return fmt::format(
       "(file_range:[{}-{}], len: {}, zero: {}, version: {}, slice_id: {}, "
       "block_index: {})",
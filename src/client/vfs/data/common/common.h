@@ -51,6 +51,9 @@ struct SliceReadReq {
   std::string ToString() const;
 };
 
+// pack objects are shared by files, so they are keyed without ino
+static constexpr uint64_t kPackBlockIno = 0;
+
 struct BlockDesc {
   int64_t file_offset;
   int64_t block_len;  // the len of the block
@@ -58,8 +61,17 @@ struct BlockDesc {
   uint64_t version;
   uint64_t slice_id;
   uint64_t index;  // block index in the chunk
+  // block is a range of a pack object, block_len is the len of the range
+  bool packed{false};
+  uint64_t pack_len{0};  // the len of the whole pack object
 
   uint64_t End() const { return file_offset + block_len; }
+
+  // ino used in block key
+  uint64_t KeyIno(uint64_t ino) const { return packed ? kPackBlockIno : ino; }
+  // len of the object stored under block key
+  int64_t ObjectLen() const { return packed ? pack_len : block_len; }
+
   std::string ToString() const;
 };
 
@@ -165,6 +165,33 @@ std::vector<BlockReadReq> ConvertSliceReadReqToBlockReadReqs(
   std::vector<BlockReadReq> block_read_reqs;
 
   const auto& slice = slice_req.slice.value();
+  if (slice.IsPacked()) {
+    // the whole slice is one range of the pack object
+    BlockDesc block{
+        .file_offset = static_cast<int64_t>(slice.offset),
+        .block_len = static_cast<int64_t>(slice.length),
+        .zero = slice.is_zero,
+        .version = slice.compaction,
+        .slice_id = slice.id,
+        .index = 0,
+        .packed = true,
+        .pack_len = slice.size,
+    };
+
+    int64_t offset_in_slice = slice_req.file_offset - slice.offset;
+    block_read_reqs.push_back(BlockReadReq{
+        .file_offset = slice_req.file_offset,
+        .block_offset =
+            static_cast<int64_t>(slice.pack_offset) + offset_in_slice,
+        .len = slice_req.len,
+        .block = block,
+    });
+
+    VLOG(9) << "ConvertSliceReadReqToBlockReadReqs: packed block_read_req: "
+            << block_read_reqs.back().ToString();
+
+    return block_read_reqs;
+  }
   int64_t slice_offset = slice.offset;
   int64_t slice_len = slice.length;
   uint64_t slice_id = slice.id;
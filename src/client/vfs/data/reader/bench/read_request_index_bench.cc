@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Read request index benchmark, compare overlap query of the offset index
+// with a linear scan over a seq keyed map which is the layout FileReader used
+// before, report elapsed time of both.
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "client/vfs/data/common/common.h"
+#include "client/vfs/data/reader/read_request.h"
+#include "client/vfs/data/reader/read_request_index.h"
+
+DEFINE_int64(req_num, 4096, "outstanding request number");
+DEFINE_int64(query_num, 4096, "overlap query number");
+DEFINE_int64(req_len, 128 * 1024, "request length");
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+using Timer = std::chrono::steady_clock;
+
+static const int64_t kChunkSize = 64 * 1024 * 1024;
+
+static ReadRequestSptr NewRequest(int64_t offset, int64_t len) {
+  auto req = std::make_shared<ReadRequest>(
+      1, offset / kChunkSize, offset % kChunkSize,
+      FileRange{.offset = offset, .len = len});
+  req->state = ReadRequestState::kReady;
+  return req;
+}
+
+static int64_t ElapsedUs(Timer::time_point begin) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Timer::now() -
+                                                               begin)
+      .count();
+}
+
+static void RunBench() {
+  ReadRequestIndex index;
+  std::map<int64_t, ReadRequestSptr> seq_map;
+  for (int64_t i = 0; i < FLAGS_req_num; ++i) {
+    auto req = NewRequest(i * FLAGS_req_len, FLAGS_req_len);
+    index.Insert(req);
+    seq_map.emplace(req->ReqId(), req);
+  }
+
+  int64_t index_hits = 0;
+  auto begin = Timer::now();
+  for (int64_t i = 0; i < FLAGS_query_num; ++i) {
+    FileRange frange{.offset = (i * FLAGS_req_len) + 1, .len = FLAGS_req_len};
+    index.ForEachOverlap(frange, [&](const ReadRequestSptr& req) {
+      std::lock_guard<std::mutex> lock(req->mutex);
+      ++index_hits;
+      return true;
+    });
+  }
+  int64_t index_us = ElapsedUs(begin);
+
+  int64_t scan_hits = 0;
+  begin = Timer::now();
+  for (int64_t i = 0; i < FLAGS_query_num; ++i) {
+    FileRange frange{.offset = (i * FLAGS_req_len) + 1, .len = FLAGS_req_len};
+    for (const auto& [seq, req] : seq_map) {
+      std::lock_guard<std::mutex> lock(req->mutex);
+      if (req->Overlaps(frange)) ++scan_hits;
+    }
+  }
+  int64_t scan_us = ElapsedUs(begin);
+
+  CHECK(index_hits == scan_hits) << "hits mismatch, index: " << index_hits
+                                 << ", linear scan: " << scan_hits;
+
+  std::cout << "outstanding requests: " << FLAGS_req_num
+            << " queries: " << FLAGS_query_num << " hits: " << index_hits
+            << "\n";
+  std::cout << "index: " << index_us << "us\n";
+  std::cout << "linear scan: " << scan_us << "us\n";
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(FLAGS_req_num > 0) << "req_num must be positive.";
+  CHECK(FLAGS_query_num > 0) << "query_num must be positive.";
+  CHECK(FLAGS_req_len > 0) << "req_len must be positive.";
+
+  dingofs::client::vfs::RunBench();
+
+  return 0;
+}
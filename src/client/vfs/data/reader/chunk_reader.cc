@@ -90,6 +90,13 @@ void ChunkReader::ReadAsync(ContextSPtr ctx, StatusCallback cb) {
     return;
   }
 
+  auto* shared_cache = hub_->GetSharedReadCache();
+  if (shared_cache != nullptr) {
+    shared_cache->UpdateChunkVersion(reader_->chunk_.ino, reader_->chunk_.index,
+                                     chunk_slices.version);
+    reader_->UseSharedCache(chunk_slices.version);
+  }
+
   reader_->ReadAsync(SpanScope::GetContext(span), chunk_slices.slices,
                      std::move(cb));
 }
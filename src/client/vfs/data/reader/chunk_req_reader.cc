@@ -44,8 +44,9 @@ namespace vfs {
 namespace {
 
 BlockKey GenerateBlockKey(const BlockCacheReadReq* req) {
-  BlockKey key(req->fs_id, req->ino, req->block_req.block.slice_id,
-               req->block_req.block.index, req->block_req.block.version);
+  const auto& block = req->block_req.block;
+  BlockKey key(req->fs_id, block.KeyIno(req->ino), block.slice_id,
+               block.index, block.version);
   return key;
 }
 
@@ -223,12 +224,18 @@ void ChunkReqReader::ProcessBlockCacheReadReq(
 
     RangeReq req;
     req.block = GenerateBlockKey(block_cache_req);
-    req.block_size = block_cache_req->block_req.block.block_len;
+    req.block_size = block_cache_req->block_req.block.ObjectLen();
     req.offset = block_cache_req->block_req.block_offset;
     req.length = block_cache_req->block_req.len;
     req.data = &block_cache_req->io_buffer;
 
-    hub_->GetBlockStore()->RangeAsync(span_ctx, req, std::move(callback));
+    auto* shared_cache = hub_->GetSharedReadCache();
+    if (use_shared_cache_ && shared_cache != nullptr) {
+      shared_cache->RangeAsync(span_ctx, chunk_.ino, chunk_.index,
+                               chunk_version_, req, std::move(callback));
+    } else {
+      hub_->GetBlockStore()->RangeAsync(span_ctx, req, std::move(callback));
+    }
   }
 }
 
@@ -256,8 +263,9 @@ void ChunkReqReader::ReadAsync(ContextSPtr ctx,
 
   uint32_t block_req_index = 0;
   for (auto& block_req : block_reqs) {
-    cache::BlockKey key(chunk_.fs_id, chunk_.ino, block_req.block.slice_id,
-                        block_req.block.index, block_req.block.version);
+    cache::BlockKey key(chunk_.fs_id, block_req.block.KeyIno(chunk_.ino),
+                        block_req.block.slice_id, block_req.block.index,
+                        block_req.block.version);
 
     VLOG(6) << fmt::format("{} Read block_key: {}, block_req: {}", UUID(),
                            key.StoreKey(), block_req.ToString());
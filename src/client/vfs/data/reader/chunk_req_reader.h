@@ -74,6 +74,13 @@ class ChunkReqReader {
 
   IOBuffer GetDataBuffer() const;
 
+  // read blocks through shared read cache, chunk_version is the version of
+  // the slices passed to ReadAsync
+  void UseSharedCache(uint64_t chunk_version) {
+    use_shared_cache_ = true;
+    chunk_version_ = chunk_version;
+  }
+
  private:
   friend class ChunkReader;
 
@@ -105,6 +112,9 @@ class ChunkReqReader {
   StatusCallback cb_;
   IOBuffer data_buf_;
   bool ready_{false};
+
+  bool use_shared_cache_{false};
+  uint64_t chunk_version_{0};
 };
 
 }  // namespace vfs
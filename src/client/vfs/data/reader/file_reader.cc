@@ -27,7 +27,6 @@
 
 #include <algorithm>
 #include <atomic>
-#include <boost/range/algorithm/find.hpp>
 #include <boost/range/algorithm/sort.hpp>
 #include <cmath>
 #include <cstdint>
@@ -87,7 +86,7 @@ FileReader::~FileReader() {
     std::vector<ReadRequestSptr> to_delete;
 
     std::unique_lock<std::mutex> lock(mutex_);
-    for (auto& [req_id, req_ptr] : requests_) {
+    requests_.ForEach([&](const ReadRequestSptr& req_ptr) {
       {
         std::lock_guard<std::mutex> req_lock(req_ptr->mutex);
         VLOG(12) << fmt::format("{} FileReader destructor delete req: {}",
@@ -97,7 +96,8 @@ FileReader::~FileReader() {
                                TransitionReason::kInvalidate);
       }
       to_delete.push_back(req_ptr);
-    }
+      return true;
+    });
 
     for (const auto& req : to_delete) {
       DeleteReadRequestUnlock(req);
@@ -113,9 +113,94 @@ FileReader::~FileReader() {
 Status FileReader::Open() {
   VLOG(9) << fmt::format("{} FileReader opened", uuid_);
   SchedulePeriodicShrink();
+
+  if (FLAGS_vfs_slice_prefetch_file_max_mb > 0) {
+    AcquireRef();
+    vfs_hub_->GetBGExecutor()->Execute([this]() {
+      PrefetchSliceOnOpen();
+      ReleaseRef();
+    });
+  }
+
   return Status::OK();
 }
 
+void FileReader::PrefetchSliceOnOpen() {
+  if (closing_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  auto span = vfs_hub_->GetTraceManager()->StartSpan(
+      "FileReader::PrefetchSliceOnOpen");
+
+  Attr attr;
+  Status s = GetAttr(SpanScope::GetContext(span), &attr);
+  if (!s.ok() || attr.length == 0 ||
+      attr.length > FLAGS_vfs_slice_prefetch_file_max_mb * 1024 * 1024) {
+    return;
+  }
+
+  uint64_t chunk_num = (attr.length + chunk_size_ - 1) / chunk_size_;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slice_prefetch_end_index_ >= chunk_num) {
+      return;
+    }
+    slice_prefetch_end_index_ = chunk_num;
+  }
+
+  VLOG(6) << fmt::format("{} PrefetchSliceOnOpen length: {}, chunk_num: {}",
+                         uuid_, attr.length, chunk_num);
+
+  s = vfs_hub_->GetMetaSystem()->PrefetchSlice(
+      SpanScope::GetContext(span), ino_, fh_, 0, chunk_num);
+  if (!s.ok() && !s.IsNotSupport()) {
+    LOG(WARNING) << fmt::format("{} PrefetchSliceOnOpen failed, status: {}",
+                                uuid_, s.ToString());
+  }
+}
+
+void FileReader::CheckSlicePrefetch(const FileRange& ahead, int64_t flen) {
+  if (FLAGS_vfs_slice_prefetch_chunks == 0 ||
+      policy_->level < FLAGS_vfs_slice_prefetch_min_level) {
+    return;
+  }
+
+  // prefetch slices of the chunks after readahead window, so when readahead
+  // reach them, block fetch needn't wait for metadata
+  uint64_t chunk_num = (flen + chunk_size_ - 1) / chunk_size_;
+  uint64_t next_index = ahead.End() / chunk_size_;
+  uint64_t end_index =
+      std::min(next_index + FLAGS_vfs_slice_prefetch_chunks, chunk_num);
+
+  uint64_t start_index = std::max(next_index, slice_prefetch_end_index_);
+  if (start_index >= end_index) {
+    return;
+  }
+
+  slice_prefetch_end_index_ = end_index;
+  PrefetchSliceAsync(start_index, end_index - start_index);
+}
+
+void FileReader::PrefetchSliceAsync(uint64_t start_index, uint32_t count) {
+  VLOG(9) << fmt::format("{} PrefetchSliceAsync chunk [{}-{})", uuid_,
+                         start_index, start_index + count);
+
+  AcquireRef();
+  vfs_hub_->GetBGExecutor()->Execute([this, start_index, count]() {
+    auto span =
+        vfs_hub_->GetTraceManager()->StartSpan("FileReader::PrefetchSlice");
+    Status s = vfs_hub_->GetMetaSystem()->PrefetchSlice(
+        SpanScope::GetContext(span), ino_, fh_, start_index, count);
+    if (!s.ok() && !s.IsNotSupport()) {
+      LOG(WARNING) << fmt::format(
+          "{} PrefetchSlice chunk [{}-{}) failed, status: {}", uuid_,
+          start_index, start_index + count, s.ToString());
+    }
+    ReleaseRef();
+  });
+}
+
 void FileReader::Close() {
   if (closing_.load(std::memory_order_acquire)) {
     return;
@@ -163,14 +248,14 @@ void FileReader::ShrinkMem() {
   std::vector<ReadRequestSptr> to_delete;
 
   std::unique_lock<std::mutex> lock(mutex_);
-  for (auto& [req_id, req] : requests_) {
+  requests_.ForEach([&](const ReadRequestSptr& req) {
     std::unique_lock<std::mutex> req_lock(req->mutex);
     VLOG(9) << fmt::format("{} ShrinkMem check req: {}", uuid_,
                            req->ToStringUnlock());
 
     // We can only delete if no one is reading it
     if (req->readers > 0) {
-      continue;
+      return true;
     }
 
     // TODO: support delete new/busy requests
@@ -192,7 +277,9 @@ void FileReader::ShrinkMem() {
       }
       to_delete.push_back(req);
     }
-  }
+
+    return true;
+  });
 
   for (const auto& req : to_delete) {
     DeleteReadRequestUnlock(req);
@@ -234,16 +321,11 @@ void FileReader::Invalidate(int64_t offset, int64_t size) {
 
   std::unique_lock<std::mutex> lock(mutex_);
 
-  for (auto& [req_id, req] : requests_) {
+  FileRange frange{.offset = offset, .len = size};
+  requests_.ForEachOverlap(frange, [&](const ReadRequestSptr& req) {
     VLOG(9) << fmt::format("{} Invalidate check req: {}", uuid_,
                            req->ToString());
 
-    FileRange frange{.offset = offset, .len = size};
-
-    if (!req->Overlaps(frange)) {
-      continue;
-    }
-
     {
       std::unique_lock<std::mutex> req_lock(req->mutex);
       if (req->state == ReadRequestState::kBusy) {
@@ -261,7 +343,9 @@ void FileReader::Invalidate(int64_t offset, int64_t size) {
         }
       }
     }
-  }  // end for
+
+    return true;
+  });
 
   for (const auto& req : to_delete) {
     DeleteReadRequestUnlock(req);
@@ -307,9 +391,8 @@ ReadRequestSptr FileReader::NewReadRequest(int64_t s, int64_t e) {
   req->access_sec = butil::monotonic_time_s();
   req->readers = 0;
 
-  auto [it, inserted] = requests_.emplace(req->ReqId(), std::move(req));
-  CHECK(inserted);
-  ReadRequestSptr new_req = it->second;
+  ReadRequestSptr new_req = std::move(req);
+  requests_.Insert(new_req);
   VLOG(9) << fmt::format("{} NewReadRequest req: {}", uuid_,
                          new_req->ToString());
 
@@ -342,7 +425,7 @@ void FileReader::DeleteReadRequestUnlock(ReadRequestSptr req) {
 
   ReleaseMem(req->req.frange.len);
 
-  CHECK(requests_.erase(req->ReqId()) == 1);
+  CHECK(requests_.Erase(req));
 }
 
 void FileReader::OnReadRequestComplete(ChunkReader* reader, ReadRequestSptr req,
@@ -491,53 +574,54 @@ void FileReader::MakeReadahead(ContextSPtr ctx, const FileRange& frange) {
 
   FileRange ahead = frange;
 
-  for (auto it = requests_.rbegin(); it != requests_.rend(); ++it) {
-    int64_t req_id = it->first;
-    ReadRequest* req = it->second.get();
-
-    VLOG(9) << fmt::format("{} MakeReadahead check req: {} for frange: {}",
-                           uuid_, req->ToString(), ahead.ToString());
-
-    if (req->state == ReadRequestState::kInvalid) {
-      continue;
-    }
+  // skip the head of ahead already covered by existing requests,
+  // a request covering ahead.offset can only start before it
+  bool advanced = true;
+  while (ahead.len > 0 && advanced) {
+    advanced = false;
+    FileRange head{.offset = ahead.offset, .len = 1};
+    requests_.ForEachOverlap(head, [&](const ReadRequestSptr& req) {
+      VLOG(9) << fmt::format("{} MakeReadahead check req: {} for frange: {}",
+                             uuid_, req->ToString(), ahead.ToString());
+
+      if (req->IsInvalid()) {
+        return true;
+      }
 
-    if (req->req.frange.offset <= ahead.offset &&
-        req->req.frange.End() > ahead.offset) {
       if (req->req.frange.End() < ahead.End()) {
         // ahead:              |--------|
         // or existing req:  |---|
         // NOTE: sequence is important here
         ahead.len = ahead.End() - req->req.frange.End();
         ahead.offset = req->req.frange.End();
+        advanced = true;
       } else {
         // ahead:              |--------|
         // existing req:     |------------|
         ahead.len = 0;
-        break;
-      }
-    } else {
-      // has overlap
-      // ahead:              |--------|
-      // or existing req:       |---|
-
-      // ahead:              |--------|
-      // or existing req:            |----|
-      // has overlap
-      if (!(ahead.offset >= req->req.frange.End() ||
-            ahead.End() <= req->req.frange.offset)) {
-        ahead.len = 0;
-        break;
       }
+      return false;
+    });
+  }
 
-      // others cases, no overlap ,readahead frange
-      // ahead:              |--------|
-      // or existing req:|-|
+  // any other overlap means the range is partially being read
+  // ahead:              |--------|
+  // or existing req:       |---|
 
-      // ahead:              |--------|
-      // or existing req:                 |-|
-    }
-  };
+  // ahead:              |--------|
+  // or existing req:            |----|
+  if (ahead.len > 0) {
+    requests_.ForEachOverlap(ahead, [&](const ReadRequestSptr& req) {
+      if (req->IsInvalid()) {
+        return true;
+      }
+
+      VLOG(9) << fmt::format("{} MakeReadahead overlap req: {} for frange: {}",
+                             uuid_, req->ToString(), ahead.ToString());
+      ahead.len = 0;
+      return false;
+    });
+  }
 
   VLOG(9) << fmt::format("{} MakeReadahead: final_ahead: {}, origin_ahead: {}",
                          uuid_, ahead.ToString(), frange.ToString());
@@ -587,6 +671,7 @@ void FileReader::CheckReadahead(ContextSPtr ctx, const FileRange& frange,
 
     if (ahead.len > 0) {
       MakeReadahead(SpanScope::GetContext(span), ahead);
+      CheckSlicePrefetch(ahead, flen);
     }
   }
 
@@ -602,30 +687,28 @@ std::vector<int64_t> FileReader::SplitRange(ContextSPtr ctx,
   ranges.push_back(frange.offset);
   ranges.push_back(frange.End());
 
-  auto contains = [&ranges](uint64_t point) -> bool {
-    return boost::range::find(ranges, point) != ranges.end();
-  };
-
-  for (const auto& [uuid, req] : requests_) {
+  requests_.ForEachOverlap(frange, [&](const ReadRequestSptr& req) {
     VLOG(9) << fmt::format("{} SplitRange check req: {} for frange: {}", uuid_,
                            req->ToString(), frange.ToString());
 
-    if (req->state == ReadRequestState::kInvalid) {
-      continue;
+    if (req->IsInvalid()) {
+      return true;
     }
 
-    if (frange.Contains(req->req.frange.offset) &&
-        !contains(req->req.frange.offset)) {
+    if (frange.Contains(req->req.frange.offset)) {
       ranges.push_back(req->req.frange.offset);
     }
 
-    uint64_t req_end = req->req.frange.End();
-    if (frange.Contains(req_end) && !contains(req_end)) {
+    int64_t req_end = req->req.frange.End();
+    if (frange.Contains(req_end)) {
       ranges.push_back(req_end);
     }
-  }
+
+    return true;
+  });
 
   boost::range::sort(ranges);
+  ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
   return ranges;
 };
 
@@ -643,31 +726,37 @@ std::vector<PartialReadRequest> FileReader::PrepareRequests(
     int64_t s = ranges[i];
     int64_t e = ranges[i + 1];
 
-    for (const auto& [uuid, req] : requests_) {
+    FileRange seg{.offset = s, .len = e - s};
+    requests_.ForEachOverlap(seg, [&](const ReadRequestSptr& req) {
+      // cheap filter without taking req lock
+      if (req->IsInvalid() || req->req.frange.offset > s ||
+          req->req.frange.End() < e) {
+        return true;
+      }
+
       std::unique_lock<std::mutex> req_lock(req->mutex);
 
       VLOG(9) << fmt::format(
           "{} PrepareRequests check req: {} for range [{}-{}))", uuid_,
           req->ToStringUnlock(), s, e);
 
-      if (req->state == ReadRequestState::kInvalid) {
-        continue;
+      // state may changed before we hold the lock
+      if (req->IsInvalid()) {
+        return true;
       }
 
-      if (req->req.frange.offset <= s && req->req.frange.End() >= e) {
-        read_reqs.emplace_back(PartialReadRequest{
-            .req = req, .offset = s - req->req.frange.offset, .len = e - s});
-        req->access_sec = butil::monotonic_time_s();
-        req->IncReaderUnlock();
-        added = true;
+      read_reqs.emplace_back(PartialReadRequest{
+          .req = req, .offset = s - req->req.frange.offset, .len = e - s});
+      req->access_sec = butil::monotonic_time_s();
+      req->IncReaderUnlock();
+      added = true;
 
-        VLOG(9) << fmt::format(
-            "{} PrepareRequests reuse existing req: {} for range [{}-{}), "
-            "len: {}",
-            uuid_, req->UUID(), s, e, (e - s));
-        break;
-      }
-    }  // end for
+      VLOG(9) << fmt::format(
+          "{} PrepareRequests reuse existing req: {} for range [{}-{}), "
+          "len: {}",
+          uuid_, req->UUID(), s, e, (e - s));
+      return false;
+    });
 
     if (!added) {
       while (s < e) {
@@ -693,7 +782,7 @@ void FileReader::CleanUpRequest(ContextSPtr ctx, const FileRange& frange) {
       "FileReader::CleanUpRequest", ctx->GetTraceSpan());
 
   const uint64_t now = butil::monotonic_time_s();
-  uint32_t req_num = requests_.size();
+  uint32_t req_num = requests_.Size();
 
   auto can_remove = [&req_num, now, this](const ReadRequestSptr& req) -> bool {
     if (req->access_sec + kReqValidityTimeoutS < now) {
@@ -743,14 +832,15 @@ void FileReader::CleanUpRequest(ContextSPtr ctx, const FileRange& frange) {
 
   std::vector<ReadRequestSptr> to_delete;
 
-  for (auto& [req_id, req] : requests_) {
+  requests_.ForEach([&](const ReadRequestSptr& req) {
     VLOG(9) << fmt::format("{} CleanUpRequest check req: {}", uuid_,
                            req->ToString());
     if (should_delete(req)) {
       to_delete.push_back(req);
       req_num--;
     }
-  }
+    return true;
+  });
 
   for (const auto& req : to_delete) {
     DeleteReadRequestUnlock(req);
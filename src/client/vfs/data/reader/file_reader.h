@@ -21,12 +21,12 @@
 
 #include <atomic>
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <mutex>
 
 #include "client/vfs/data/reader/chunk_reader.h"
 #include "client/vfs/data/reader/read_request.h"
+#include "client/vfs/data/reader/read_request_index.h"
 #include "client/vfs/data/reader/readahead_policy.h"
 #include "client/vfs/data_buffer.h"
 #include "common/status.h"
@@ -66,6 +66,11 @@ class FileReader {
   void CheckPrefetch(ContextSPtr ctx, const Attr& attr,
                      const FileRange& frange);
 
+  // pretected by mutex_
+  void CheckSlicePrefetch(const FileRange& ahead, int64_t flen);
+  void PrefetchSliceAsync(uint64_t start_index, uint32_t count);
+  void PrefetchSliceOnOpen();
+
   void ShrinkMem();
   void SchedulePeriodicShrink();
   void RunPeriodicShrink();
@@ -124,9 +129,11 @@ class FileReader {
 
   std::mutex mutex_;
   std::unique_ptr<ReadaheadPoclicy> policy_;
+  // slices of chunks before this index are prefetched
+  uint64_t slice_prefetch_end_index_{0};
   // TODO : use dec/inc refs
-  // seq -> ReadRequestSptr
-  std::map<int64_t, ReadRequestSptr> requests_;
+  // file offset -> ReadRequestSptr
+  ReadRequestIndex requests_;
 };
 
 using FileReaderUPtr = std::unique_ptr<FileReader>;
@@ -25,16 +25,16 @@ namespace vfs {
 void ReadRequest::ToStateUnLock(ReadRequestState new_state,
                                 TransitionReason reason) {
   VLOG(9) << fmt::format("ReadRequest::ToState uuid: {} [{}-{}] reason: {}",
-                         UUID(), ReadRequestStateToString(state),
+                         UUID(), ReadRequestStateToString(State()),
                          ReadRequestStateToString(new_state),
                          TransitionReasonToString(reason));
-  state = new_state;
+  state.store(new_state, std::memory_order_release);
 }
 
 std::string ReadRequest::ToStringUnlock() const {
   return fmt::format(
       "(uuid: {}, state: {}, readers: {}, access_sec: {},req:  {}, status: {})",
-      UUID(), ReadRequestStateToString(state), readers, access_sec,
+      UUID(), ReadRequestStateToString(State()), readers, access_sec,
       req.ToString(), status.ToString());
 }
 
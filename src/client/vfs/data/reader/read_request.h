@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 #include <glog/logging.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
@@ -86,7 +87,9 @@ struct ReadRequest {
   mutable std::mutex mutex;
   std::condition_variable cv;
   int32_t readers{0};
-  ReadRequestState state;
+  // written under mutex, but can be read without it, e.g. when FileReader
+  // filters out invalid requests before locking the one it wants
+  std::atomic<ReadRequestState> state{kNew};
   Status status;
   int64_t access_sec;
   IOBuffer buffer;
@@ -113,6 +116,12 @@ struct ReadRequest {
 
   void ToStateUnLock(ReadRequestState new_state, TransitionReason reason);
 
+  ReadRequestState State() const {
+    return state.load(std::memory_order_acquire);
+  }
+
+  bool IsInvalid() const { return State() == ReadRequestState::kInvalid; }
+
   uint64_t ReqId() const { return req.req_id; }
 
   bool Overlaps(const FileRange& other) const {
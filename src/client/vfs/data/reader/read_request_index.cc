@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client/vfs/data/reader/read_request_index.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+void ReadRequestIndex::Insert(const ReadRequestSptr& req) {
+  CHECK_GT(req->req.frange.len, 0);
+
+  auto [it, inserted] = requests_.emplace(ToKey(req), req);
+  CHECK(inserted) << "duplicate read request: " << req->UUID();
+
+  max_len_ = std::max(max_len_, req->req.frange.len);
+}
+
+bool ReadRequestIndex::Erase(const ReadRequestSptr& req) {
+  return requests_.erase(ToKey(req)) == 1;
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINGOFS_CLIENT_VFS_DATA_READER_READ_REQUEST_INDEX_H_
+#define DINGOFS_CLIENT_VFS_DATA_READER_READ_REQUEST_INDEX_H_
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "client/vfs/data/common/common.h"
+#include "client/vfs/data/reader/read_request.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+// Outstanding read requests of one file, ordered by file offset.
+// Requests are split at block boundary, so their length is bounded, an
+// overlap query only needs to start at (offset - max_len) instead of
+// scanning every request.
+// NOTE: not thread safe, protected by FileReader mutex
+class ReadRequestIndex {
+ public:
+  ReadRequestIndex() = default;
+  ~ReadRequestIndex() = default;
+
+  void Insert(const ReadRequestSptr& req);
+
+  bool Erase(const ReadRequestSptr& req);
+
+  size_t Size() const { return requests_.size(); }
+  bool Empty() const { return requests_.empty(); }
+
+  // visit all requests in offset order, stop when fn return false
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (const auto& [key, req] : requests_) {
+      if (!fn(req)) {
+        break;
+      }
+    }
+  }
+
+  // visit requests overlapping frange in offset order,
+  // stop when fn return false
+  template <typename Fn>
+  void ForEachOverlap(const FileRange& frange, Fn&& fn) const {
+    auto it = requests_.lower_bound(Key{frange.offset - max_len_ + 1, 0});
+    for (; it != requests_.end() && it->first.first < frange.End(); ++it) {
+      if (!it->second->Overlaps(frange)) {
+        continue;
+      }
+      if (!fn(it->second)) {
+        break;
+      }
+    }
+  }
+
+ private:
+  // (file offset, req id)
+  using Key = std::pair<int64_t, uint64_t>;
+
+  static Key ToKey(const ReadRequestSptr& req) {
+    return Key{req->req.frange.offset, req->ReqId()};
+  }
+
+  std::map<Key, ReadRequestSptr> requests_;
+  // max len of all requests ever inserted, only grows,
+  // bounded by block size
+  int64_t max_len_{1};
+};
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_CLIENT_VFS_DATA_READER_READ_REQUEST_INDEX_H_
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client/vfs/data/slice/pack_writer.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "cache/blockcache/cache_store.h"
+#include "client/vfs/data/common/common.h"
+#include "client/vfs/hub/vfs_hub.h"
+#include "common/options/client.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+PackWriter::PackWriter(VFSHub* hub, uint64_t fs_id, uint64_t pack_size)
+    : vfs_hub_(hub), fs_id_(fs_id), pack_size_(pack_size) {}
+
+void PackWriter::Stop() {
+  PackUPtr pack;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (stopped_) {
+      return;
+    }
+
+    stopped_ = true;
+    if (pending_ != nullptr) {
+      pack = std::move(pending_);
+      ++inflight_packs_;
+    }
+  }
+
+  if (pack != nullptr) {
+    FlushAsync(std::move(pack));
+  }
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  cv_.wait(lk, [this] { return inflight_packs_ == 0; });
+
+  LOG(INFO) << "[vfs.pack] pack writer stopped.";
+}
+
+bool PackWriter::CanPack(uint64_t chunk_index, uint64_t chunk_offset,
+                         uint64_t len) const {
+  return chunk_index == 0 && chunk_offset == 0 && len > 0 &&
+         len <= FLAGS_vfs_data_pack_slice_max_kb * 1024 && len <= pack_size_;
+}
+
+// protected by mutex_
+void PackWriter::NewPackUnlocked() {
+  pending_ = std::make_unique<Pack>();
+  pending_->seq = next_seq_++;
+
+  uint64_t seq = pending_->seq;
+  vfs_hub_->GetBGExecutor()->Schedule([this, seq] { SealByTimer(seq); },
+                                      FLAGS_vfs_data_pack_delay_ms);
+}
+
+void PackWriter::AddAsync(Ino ino, BlockDataUPtr block_data, PackCallback cb) {
+  uint64_t len = block_data->Len();
+  IOBuffer data = block_data->ToIOBuffer();
+
+  bool stopped = false;
+  std::vector<PackUPtr> to_flush;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    stopped = stopped_;
+    if (!stopped) {
+      // a pack holds at most one slice of a file, slices of the same file
+      // share the pack id, and mds dedups slices of chunk by id
+      if (pending_ != nullptr && (pending_->inos.count(ino) > 0 ||
+                                  pending_->len + len > pack_size_)) {
+        to_flush.push_back(std::move(pending_));
+      }
+
+      if (pending_ == nullptr) {
+        NewPackUnlocked();
+      }
+
+      pending_->entries.push_back(Entry{.ino = ino,
+                                        .offset = pending_->len,
+                                        .block_data = std::move(block_data),
+                                        .cb = std::move(cb)});
+      pending_->inos.insert(ino);
+      pending_->data.Append(&data);
+      pending_->len += len;
+
+      if (pending_->len >= pack_size_) {
+        to_flush.push_back(std::move(pending_));
+      }
+
+      inflight_packs_ += to_flush.size();
+    }
+  }
+
+  if (stopped) {
+    cb(Status::Internal("pack writer stopped"), PackLocation{});
+    return;
+  }
+
+  slice_count_ << 1;
+
+  VLOG(6) << fmt::format("[vfs.pack] add slice, ino: {}, len: {}, seal: {}",
+                         ino, len, to_flush.size());
+
+  for (auto& pack : to_flush) {
+    FlushAsync(std::move(pack));
+  }
+}
+
+void PackWriter::SealByTimer(uint64_t seq) {
+  PackUPtr pack;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (pending_ == nullptr || pending_->seq != seq) {
+      return;
+    }
+
+    pack = std::move(pending_);
+    ++inflight_packs_;
+  }
+
+  FlushAsync(std::move(pack));
+}
+
+void PackWriter::FlushAsync(PackUPtr pack) {
+  inflight_count_ << 1;
+
+  Pack* raw = pack.release();
+  vfs_hub_->GetFlushExecutor()->Execute([this, raw]() { DoFlush(raw); });
+}
+
+void PackWriter::DoFlush(Pack* pack) {
+  auto span = vfs_hub_->GetTraceManager()->StartSpan("PackWriter::DoFlush");
+
+  CHECK(!pack->entries.empty()) << "pack has no slice.";
+
+  uint64_t pack_id = 0;
+  Status s = vfs_hub_->GetMetaSystem()->NewPackId(
+      SpanScope::GetContext(span), pack->entries.front().ino, &pack_id);
+  if (!s.ok()) {
+    LOG(ERROR) << fmt::format("[vfs.pack] new pack id fail, status: {}",
+                              s.ToString());
+    FlushDone(pack, 0, s);
+    return;
+  }
+
+  cache::BlockKey key(fs_id_, kPackBlockIno, pack_id, 0, 0);
+  PutReq req;
+  req.block = key;
+  req.data = pack->data;
+  req.write_back = FLAGS_vfs_data_writeback;
+
+  VLOG(6) << fmt::format("[vfs.pack] flush pack: key={}, len={}, slices={}",
+                         key.StoreKey(), pack->len, pack->entries.size());
+
+  auto ctx = SpanScope::GetContext(span);
+  auto on_flushed = [this, pack, pack_id, span](Status status) {
+    SpanScope::End(span);
+    vfs_hub_->GetCBExecutor()->Execute(
+        [this, pack, pack_id, status]() { FlushDone(pack, pack_id, status); });
+  };
+
+  vfs_hub_->GetBlockStore()->PutAsync(ctx, req, std::move(on_flushed));
+}
+
+// take ownership of pack
+void PackWriter::FlushDone(Pack* pack, uint64_t pack_id, Status s) {
+  std::unique_ptr<Pack> guard(pack);
+
+  if (s.ok()) {
+    pack_count_ << 1;
+    pack_bytes_ << pack->len;
+  } else {
+    LOG(WARNING) << fmt::format(
+        "[vfs.pack] flush pack fail, pack_id: {}, slices: {}, status: {}",
+        pack_id, pack->entries.size(), s.ToString());
+  }
+
+  for (auto& entry : pack->entries) {
+    PackLocation loc{.pack_id = pack_id,
+                     .pack_offset = entry.offset,
+                     .pack_len = pack->len,
+                     .pack_refs = pack->entries.size()};
+    entry.cb(s, loc);
+  }
+
+  inflight_count_ << -1;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    --inflight_packs_;
+  }
+  cv_.notify_all();
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DINGOFS_CLIENT_VFS_DATA_SLICE_PACK_WRITER_H_
+#define DINGOFS_CLIENT_VFS_DATA_SLICE_PACK_WRITER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bvar/reducer.h"
+#include "client/vfs/data/slice/block_data.h"
+#include "client/vfs/vfs_meta.h"
+#include "common/io_buffer.h"
+#include "common/status.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+class VFSHub;
+class PackWriter;
+using PackWriterUPtr = std::unique_ptr<PackWriter>;
+
+// where a packed slice is stored
+struct PackLocation {
+  uint64_t pack_id{0};      // slice id of the pack object
+  uint64_t pack_offset{0};  // offset of the slice data in the pack object
+  uint64_t pack_len{0};     // len of the whole pack object
+  uint64_t pack_refs{0};    // number of slices in the pack
+};
+
+using PackCallback = std::function<void(Status s, const PackLocation& loc)>;
+
+// Packs small slices of different files into one shared block object, so a
+// directory of small files is stored and fetched with few objects.
+// Slices are appended to the pending pack, which is sealed and uploaded
+// when it is full, when it already holds a slice of the same file, or
+// vfs_data_pack_delay_ms after its first slice.
+class PackWriter {
+ public:
+  PackWriter(VFSHub* hub, uint64_t fs_id, uint64_t pack_size);
+  ~PackWriter() = default;
+
+  static PackWriterUPtr New(VFSHub* hub, uint64_t fs_id, uint64_t pack_size) {
+    return std::make_unique<PackWriter>(hub, fs_id, pack_size);
+  }
+
+  // seal pending pack and wait all inflight packs done
+  void Stop();
+
+  // whether a slice at chunk_offset of chunk should be packed, only the head
+  // of a small file is packed
+  bool CanPack(uint64_t chunk_index, uint64_t chunk_offset, uint64_t len) const;
+
+  // take ownership of block_data, cb is called after the pack is uploaded
+  void AddAsync(Ino ino, BlockDataUPtr block_data, PackCallback cb);
+
+ private:
+  struct Entry {
+    Ino ino{0};
+    uint64_t offset{0};
+    BlockDataUPtr block_data;
+    PackCallback cb;
+  };
+
+  struct Pack {
+    uint64_t seq{0};
+    uint64_t len{0};
+    IOBuffer data;
+    std::vector<Entry> entries;
+    std::unordered_set<Ino> inos;
+  };
+  using PackUPtr = std::unique_ptr<Pack>;
+
+  // protected by mutex_
+  void NewPackUnlocked();
+  void SealByTimer(uint64_t seq);
+
+  void FlushAsync(PackUPtr pack);
+  void DoFlush(Pack* pack);
+  void FlushDone(Pack* pack, uint64_t pack_id, Status s);
+
+  VFSHub* vfs_hub_;
+  const uint64_t fs_id_;
+  const uint64_t pack_size_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_{false};
+  uint64_t next_seq_{1};
+  PackUPtr pending_;
+  int64_t inflight_packs_{0};
+
+  // metrics
+  bvar::Adder<uint64_t> pack_count_{"vfs_pack_writer_pack_count"};
+  bvar::Adder<uint64_t> slice_count_{"vfs_pack_writer_slice_count"};
+  bvar::Adder<uint64_t> pack_bytes_{"vfs_pack_writer_pack_bytes"};
+  bvar::Adder<int64_t> inflight_count_{"vfs_pack_writer_inflight_count"};
+};
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_CLIENT_VFS_DATA_SLICE_PACK_WRITER_H_
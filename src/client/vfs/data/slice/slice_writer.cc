@@ -170,7 +170,58 @@ void SliceWriter::SliceFlushed(Status status, SliceFlushTask* task) {
   FlushDone(status);
 }
 
+bool SliceWriter::PackFlush() {
+  PackWriter* pack_writer = vfs_hub_->GetPackWriter();
+  if (pack_writer == nullptr) {
+    return false;
+  }
+
+  BlockDataUPtr block_data;
+  {
+    std::lock_guard<std::mutex> lg(write_flush_mutex_);
+    if (block_datas_.size() != 1 ||
+        !pack_writer->CanPack(context_.chunk_index, chunk_offset_, len_)) {
+      return false;
+    }
+
+    block_data = std::move(block_datas_.begin()->second);
+    block_datas_.clear();
+  }
+
+  VLOG(4) << fmt::format("{} PackFlush len: {}", UUID(), block_data->Len());
+
+  pack_writer->AddAsync(context_.ino, std::move(block_data),
+                        [this](Status s, const PackLocation& loc) {
+                          SlicePacked(std::move(s), loc);
+                        });
+  return true;
+}
+
+void SliceWriter::SlicePacked(Status status, const PackLocation& loc) {
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format("{} Failed to pack slice: {}, status: {}",
+                                UUID(), ToString(), status.ToString());
+  }
+
+  {
+    std::lock_guard<std::mutex> lg(write_flush_mutex_);
+    if (status.ok()) {
+      id_ = loc.pack_id;
+      pack_loc_ = loc;
+    } else {
+      flush_status_ = status;
+    }
+  }
+
+  FlushDone(status);
+}
+
 void SliceWriter::DoFlush() {
+  // small file head is stored in a shared pack object
+  if (PackFlush()) {
+    return;
+  }
+
   // TODO: get ctx from parent
   auto span = vfs_hub_->GetTraceManager()->StartSpan("SliceWriter::DoFlush");
 
@@ -210,6 +261,7 @@ Slice SliceWriter::GetCommitSlice() {
 
   uint64_t len = 0;
   uint64_t chunk_offset = 0;
+  PackLocation pack_loc;
 
   {
     std::lock_guard<std::mutex> lg(write_flush_mutex_);
@@ -219,6 +271,7 @@ Slice SliceWriter::GetCommitSlice() {
 
     len = len_;
     chunk_offset = chunk_offset_;
+    pack_loc = pack_loc_;
   }
 
   Slice slice{.id = id_,
@@ -227,6 +280,11 @@ Slice SliceWriter::GetCommitSlice() {
               .compaction = 0,
               .is_zero = false,
               .size = len};
+  if (pack_loc.pack_refs > 0) {
+    slice.size = pack_loc.pack_len;
+    slice.pack_offset = pack_loc.pack_offset;
+    slice.pack_refs = pack_loc.pack_refs;
+  }
 
   VLOG(4) << fmt::format(
       "{} GetCommitSlices completed, slice: {}, slice_data: {}", UUID(),
@@ -25,6 +25,7 @@
 
 #include "client/vfs/data/slice/block_data.h"
 #include "client/vfs/data/slice/common.h"
+#include "client/vfs/data/slice/pack_writer.h"
 #include "client/vfs/data/slice/task/slice_flush_task.h"
 #include "client/vfs/vfs_meta.h"
 #include "common/callback.h"
@@ -98,6 +99,10 @@ class SliceWriter {
   void FlushDone(Status s);
   void DoFlush();
 
+  // return false if the slice is not packable
+  bool PackFlush();
+  void SlicePacked(Status status, const PackLocation& loc);
+
   const SliceDataContext context_;
   VFSHub* vfs_hub_{nullptr};
 
@@ -111,6 +116,8 @@ class SliceWriter {
   uint64_t len_{0};
   bool flushing_{false};  // used to prevent multiple flushes
   uint64_t id_{0};        // from mds
+  // set when the slice is stored in a pack object
+  PackLocation pack_loc_;
   // block_index -> BlockData, this should be immutable
   std::map<uint64_t, BlockDataUPtr> block_datas_;
   StatusCallback flush_cb_;
@@ -23,6 +23,7 @@
 #include <sstream>
 
 #include "client/vfs/data/file.h"
+#include "client/vfs/hub/vfs_hub.h"
 #include "client/vfs/vfs_fh.h"
 #include "common/const.h"
 #include "fmt/format.h"
@@ -152,6 +153,11 @@ void HandleManager::Invalidate(uint64_t fh, int64_t offset, int64_t size) {
   } else {
     LOG(WARNING) << "Invalidate failed, file is nullptr, fh:" << fh;
   }
+
+  auto* shared_cache = vfs_hub_->GetSharedReadCache();
+  if (shared_cache != nullptr) {
+    shared_cache->Invalidate(handle->ino, offset, size);
+  }
 }
 
 Status HandleManager::FlushByIno(Ino ino) {
@@ -202,6 +208,11 @@ void HandleManager::InvalidateByIno(Ino ino, int64_t offset, int64_t size) {
     handle->file->Invalidate(offset, size);
     handle->ReleaseRef();
   }
+
+  auto* shared_cache = vfs_hub_->GetSharedReadCache();
+  if (shared_cache != nullptr) {
+    shared_cache->Invalidate(ino, offset, size);
+  }
 }
 
 void HandleManager::Summary(Json::Value& value) {
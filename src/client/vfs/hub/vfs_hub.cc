@@ -28,6 +28,7 @@
 #include "client/vfs/compaction/compactor_impl.h"
 #include "client/vfs/components/prefetch_manager.h"
 #include "client/vfs/components/warmup_manager.h"
+#include "client/vfs/data/slice/pack_writer.h"
 #include "client/vfs/metasystem/local/metasystem.h"
 #include "client/vfs/metasystem/mds/metasystem.h"
 #include "client/vfs/metasystem/memory/metasystem.h"
@@ -90,6 +91,11 @@ VFSHubImpl::~VFSHubImpl() {
     bg_executor_.reset();
   }
 
+  // after bg executor, no more seal timer
+  if (pack_writer_ != nullptr) {
+    pack_writer_.reset();
+  }
+
   if (warmup_manager_ != nullptr) {
     warmup_manager_.reset();
   }
@@ -102,6 +108,11 @@ VFSHubImpl::~VFSHubImpl() {
     block_store_.reset();
   }
 
+  // after block store, no more inflight fetch
+  if (shared_read_cache_ != nullptr) {
+    shared_read_cache_.reset();
+  }
+
   if (meta_wrapper_ != nullptr) {
     meta_wrapper_.reset();
   }
@@ -261,9 +272,24 @@ Status VFSHubImpl::Start(bool upgrade) {
     read_buffer_manager_ = std::make_unique<ReadBufferManager>(total_bytes);
   }
 
+  // shared read cache, must after read buffer manager
+  if (FLAGS_vfs_shared_read_cache_enable) {
+    int64_t capacity_bytes = FLAGS_vfs_shared_read_cache_mb * 1024 * 1024;
+    if (capacity_bytes <= 0) {
+      return Status::Internal("invalid vfs_shared_read_cache_mb");
+    }
+
+    shared_read_cache_ = SharedReadCache::New(this, capacity_bytes,
+                                              fs_info_.chunk_size);
+  }
+
   file_suffix_watcher_ =
       std::make_unique<FileSuffixWatcher>(FLAGS_vfs_data_writeback_suffix);
 
+  if (FLAGS_vfs_data_pack_enable) {
+    pack_writer_ = PackWriter::New(this, fs_info_.id, fs_info_.block_size);
+  }
+
   // prefetch manager
   {
     if (block_store_->EnableCache()) {
@@ -314,6 +340,11 @@ Status VFSHubImpl::Stop(bool upgrade) {
     handle_manager_->Stop();
   }
 
+  // after all files flushed, before executors stop
+  if (pack_writer_ != nullptr) {
+    pack_writer_->Stop();
+  }
+
   if (read_executor_ != nullptr) {
     read_executor_->Stop();
   }
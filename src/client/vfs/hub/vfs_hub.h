@@ -27,6 +27,7 @@
 #include "client/vfs/compaction/compactor.h"
 #include "client/vfs/components/file_suffix_watcher.h"
 #include "client/vfs/components/prefetch_manager.h"
+#include "client/vfs/components/shared_read_cache.h"
 #include "client/vfs/components/warmup_manager.h"
 #include "client/vfs/handle/handle_manager.h"
 #include "client/vfs/memory/read_buffer_manager.h"
@@ -44,6 +45,8 @@ namespace dingofs {
 namespace client {
 namespace vfs {
 
+class PackWriter;
+
 class VFSHub {
  public:
   VFSHub() = default;
@@ -82,6 +85,12 @@ class VFSHub {
 
   virtual WarmupManager* GetWarmupManager() = 0;
 
+  // nullptr if shared read cache is disabled
+  virtual SharedReadCache* GetSharedReadCache() = 0;
+
+  // nullptr if small file packing is disabled
+  virtual PackWriter* GetPackWriter() = 0;
+
   virtual Compactor* GetCompactor() = 0;
 
   virtual TraceManager* GetTraceManager() = 0;
@@ -168,6 +177,12 @@ class VFSHubImpl : public VFSHub {
     return warmup_manager_.get();
   }
 
+  SharedReadCache* GetSharedReadCache() override {
+    return shared_read_cache_.get();
+  }
+
+  PackWriter* GetPackWriter() override { return pack_writer_.get(); }
+
   Compactor* GetCompactor() override {
     CHECK_NOTNULL(compactor_);
     return compactor_.get();
@@ -214,6 +229,8 @@ class VFSHubImpl : public VFSHub {
   std::unique_ptr<FileSuffixWatcher> file_suffix_watcher_;
   std::unique_ptr<PrefetchManager> prefetch_manager_;
   std::unique_ptr<WarmupManager> warmup_manager_;
+  std::unique_ptr<SharedReadCache> shared_read_cache_;
+  std::unique_ptr<PackWriter> pack_writer_;
   std::unique_ptr<utils::LogCleanManager> logclean_manager_;
 };
 
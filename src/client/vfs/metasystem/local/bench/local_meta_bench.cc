@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Local meta system benchmark in mdtest style, every thread create/stat/
+// unlink files under its own dir, report ops/s of each phase. Run it with
+// --vfs_meta_local_engine=leveldb and compact to compare engines.
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/vfs/metasystem/local/metasystem.h"
+#include "common/const.h"
+#include "common/options/client.h"
+
+DEFINE_string(dir, "/tmp/local_meta_bench", "bench db dir");
+DEFINE_string(fs_name, "bench", "fs name");
+DEFINE_uint32(file_num, 10000, "file number per thread");
+DEFINE_uint32(thread_num, 8, "thread number");
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+using Timer = std::chrono::steady_clock;
+
+static std::string FileName(uint32_t i) { return "file_" + std::to_string(i); }
+
+// run func(thread_index, file_index) on all threads, return ops/s
+static double RunPhase(const std::function<bool(uint32_t, uint32_t)>& func) {
+  std::atomic<uint64_t> error_count{0};
+  std::vector<std::thread> threads;
+
+  auto begin = Timer::now();
+  for (uint32_t t = 0; t < FLAGS_thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint32_t i = 0; i < FLAGS_file_num; ++i) {
+        if (!func(t, i)) error_count.fetch_add(1);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  double elapsed_s =
+      std::chrono::duration<double>(Timer::now() - begin).count();
+
+  CHECK(error_count.load() == 0)
+      << "phase has errors, count: " << error_count.load();
+
+  return static_cast<double>(FLAGS_thread_num) * FLAGS_file_num / elapsed_s;
+}
+
+static void RunBench() {
+  const std::string storage_info = "storage=file&path=" + FLAGS_dir + "/data";
+  LocalMetaSystem meta_system(FLAGS_dir, FLAGS_fs_name, storage_info);
+  auto status = meta_system.Init(false);
+  CHECK(status.ok()) << "init local meta system fail, " << status.ToString();
+
+  // one dir per thread
+  std::vector<Ino> dirs(FLAGS_thread_num);
+  for (uint32_t t = 0; t < FLAGS_thread_num; ++t) {
+    Attr attr;
+    std::string name = "dir_" + std::to_string(t) + "_" +
+                       std::to_string(Timer::now().time_since_epoch().count());
+    status = meta_system.MkDir(nullptr, kRootIno, name, 0, 0, 0755, &attr);
+    CHECK(status.ok()) << "mkdir fail, " << status.ToString();
+    dirs[t] = attr.ino;
+  }
+
+  double create_ops = RunPhase([&](uint32_t t, uint32_t i) {
+    Attr attr;
+    return meta_system
+        .MkNod(nullptr, dirs[t], FileName(i), 0, 0, S_IFREG | 0644, 0, &attr)
+        .ok();
+  });
+
+  double stat_ops = RunPhase([&](uint32_t t, uint32_t i) {
+    Attr attr;
+    return meta_system.Lookup(nullptr, dirs[t], FileName(i), &attr).ok();
+  });
+
+  double unlink_ops = RunPhase([&](uint32_t t, uint32_t i) {
+    return meta_system.Unlink(nullptr, dirs[t], FileName(i)).ok();
+  });
+
+  meta_system.Stop(false);
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "engine: " << FLAGS_vfs_meta_local_engine
+            << " files: " << FLAGS_file_num << " threads: " << FLAGS_thread_num
+            << "\n";
+  std::cout << "create ops/s: " << create_ops << "\n";
+  std::cout << "stat ops/s: " << stat_ops << "\n";
+  std::cout << "unlink ops/s: " << unlink_ops << "\n";
+}
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(FLAGS_file_num > 0) << "file_num must be positive.";
+  CHECK(FLAGS_thread_num > 0) << "thread_num must be positive.";
+
+  dingofs::client::vfs::local::RunBench();
+
+  return 0;
+}
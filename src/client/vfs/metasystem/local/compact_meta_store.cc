@@ -0,0 +1,676 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "client/vfs/metasystem/local/compact_meta_store.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/options/client.h"
+#include "fmt/format.h"
+#include "glog/logging.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+using dingofs::mds::AttrEntry;
+using dingofs::mds::DentryEntry;
+
+// ops per snapshot record
+static const uint32_t kSnapshotRecordOps = 4096;
+// flush snapshot buffer to file when exceed
+static const size_t kSnapshotBufferSize = 4 * 1024 * 1024;
+
+static_assert(sizeof(CompactMetaStore::InodeCore) == 80,
+              "inode core layout changed, log is not compatible.");
+
+namespace {
+
+class Encoder {
+ public:
+  explicit Encoder(std::string& buf) : buf_(buf) {}
+
+  void PutU8(uint8_t value) { PutBytes(&value, sizeof(value)); }
+  void PutU32(uint32_t value) { PutBytes(&value, sizeof(value)); }
+  void PutU64(uint64_t value) { PutBytes(&value, sizeof(value)); }
+  void PutString(const std::string& value) {
+    PutU32(value.size());
+    buf_.append(value);
+  }
+  void PutBytes(const void* data, size_t size) {
+    buf_.append(reinterpret_cast<const char*>(data), size);
+  }
+
+ private:
+  std::string& buf_;
+};
+
+class Decoder {
+ public:
+  explicit Decoder(const std::string& buf)
+      : pos_(buf.data()), end_(buf.data() + buf.size()) {}
+
+  bool GetU8(uint8_t& value) { return GetBytes(&value, sizeof(value)); }
+  bool GetU32(uint32_t& value) { return GetBytes(&value, sizeof(value)); }
+  bool GetU64(uint64_t& value) { return GetBytes(&value, sizeof(value)); }
+  bool GetString(std::string& value) {
+    uint32_t size = 0;
+    if (!GetU32(size) || static_cast<size_t>(end_ - pos_) < size) {
+      return false;
+    }
+    value.assign(pos_, size);
+    pos_ += size;
+    return true;
+  }
+  bool GetBytes(void* data, size_t size) {
+    if (static_cast<size_t>(end_ - pos_) < size) return false;
+    memcpy(data, pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+ private:
+  const char* pos_;
+  const char* end_;
+};
+
+void EncodeInode(Encoder& encoder, Ino ino,
+                 const CompactMetaStore::InodeRecord& record) {
+  encoder.PutU8(static_cast<uint8_t>(MetaBatch::OpType::kPutInode));
+  encoder.PutU64(ino);
+  encoder.PutBytes(&record.core, sizeof(record.core));
+  if (record.ext == nullptr) return;
+
+  const auto& ext = *record.ext;
+  encoder.PutString(ext.symlink);
+  encoder.PutU32(ext.more_parents.size());
+  for (auto parent : ext.more_parents) encoder.PutU64(parent);
+  encoder.PutU32(ext.xattrs.size());
+  for (const auto& [name, value] : ext.xattrs) {
+    encoder.PutString(name);
+    encoder.PutString(value);
+  }
+}
+
+void EncodeDentry(Encoder& encoder, Ino parent, const std::string& name,
+                  const CompactMetaStore::DentryRecord& record) {
+  encoder.PutU8(static_cast<uint8_t>(MetaBatch::OpType::kPutDentry));
+  encoder.PutU64(parent);
+  encoder.PutString(name);
+  encoder.PutU64(record.ino);
+  encoder.PutU32(record.flag);
+  encoder.PutU8(record.type);
+}
+
+void EncodeKv(Encoder& encoder, const std::string& key,
+              const std::string& value) {
+  encoder.PutU8(static_cast<uint8_t>(MetaBatch::OpType::kPut));
+  encoder.PutString(key);
+  encoder.PutString(value);
+}
+
+bool DecodeInode(Decoder& decoder, Ino& ino,
+                 CompactMetaStore::InodeRecord& record) {
+  if (!decoder.GetU64(ino) ||
+      !decoder.GetBytes(&record.core, sizeof(record.core))) {
+    return false;
+  }
+  if (!record.core.has_ext) return true;
+
+  auto ext = std::make_unique<CompactMetaStore::InodeExt>();
+  uint32_t count = 0;
+  if (!decoder.GetString(ext->symlink) || !decoder.GetU32(count)) {
+    return false;
+  }
+  ext->more_parents.resize(count);
+  for (auto& parent : ext->more_parents) {
+    if (!decoder.GetU64(parent)) return false;
+  }
+
+  if (!decoder.GetU32(count)) return false;
+  ext->xattrs.resize(count);
+  for (auto& [name, value] : ext->xattrs) {
+    if (!decoder.GetString(name) || !decoder.GetString(value)) return false;
+  }
+
+  record.ext = std::move(ext);
+  return true;
+}
+
+}  // namespace
+
+bool CompactMetaStore::Open(const std::string& path) {
+  path_ = path;
+
+  utils::Duration duration;
+  utils::WriteLockGuard lk(lock_);
+
+  uint64_t valid_size = 0;
+  auto status = RecordFile::Replay(
+      SnapshotPath(),
+      [this](const std::string& payload) { return ApplyPayload(payload); },
+      valid_size);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.compact] load snapshot fail, {}.",
+                              status.ToString());
+    return false;
+  }
+
+  status = wal_.Open(WalPath(), [this](const std::string& payload) {
+    return ApplyPayload(payload);
+  });
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.compact] open wal fail, {}.",
+                              status.ToString());
+    return false;
+  }
+
+  is_opened_ = true;
+
+  LOG(INFO) << fmt::format(
+      "[meta.compact][{}ms] open {}, inodes({}) dirs({}) kvs({}).",
+      duration.ElapsedMs(), path, inodes_.size(), dirs_.size(),
+      kvs_.size());
+
+  return true;
+}
+
+void CompactMetaStore::Close() {
+  if (!is_opened_) return;
+
+  // checkpoint on close, so next open need not replay log
+  auto status = Checkpoint();
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.compact] checkpoint fail, {}.",
+                              status.ToString());
+  }
+
+  wal_.Close();
+  is_opened_ = false;
+}
+
+Status CompactMetaStore::GetInode(Ino ino, AttrEntry& attr_entry) {
+  utils::ReadLockGuard lk(lock_);
+
+  auto it = inodes_.find(ino);
+  if (it == inodes_.end()) return Status::NotFound("not found");
+
+  attr_entry = ToAttrEntry(ino, it->second);
+
+  return Status::OK();
+}
+
+Status CompactMetaStore::GetDentry(Ino parent, const std::string& name,
+                                   DentryEntry& dentry_entry) {
+  utils::ReadLockGuard lk(lock_);
+
+  auto dir_it = dirs_.find(parent);
+  if (dir_it == dirs_.end()) return Status::NotFound("not found");
+
+  auto it = dir_it->second.find(name);
+  if (it == dir_it->second.end()) return Status::NotFound("not found");
+
+  dentry_entry.set_fs_id(fs_id_);
+  dentry_entry.set_parent(parent);
+  dentry_entry.set_name(name);
+  dentry_entry.set_ino(it->second.ino);
+  dentry_entry.set_flag(it->second.flag);
+  dentry_entry.set_type(static_cast<pb::mds::FileType>(it->second.type));
+
+  return Status::OK();
+}
+
+Status CompactMetaStore::GetDentries(Ino parent,
+                                     std::vector<DentryEntry>& dentries) {
+  utils::ReadLockGuard lk(lock_);
+
+  auto dir_it = dirs_.find(parent);
+  if (dir_it == dirs_.end()) return Status::OK();
+
+  dentries.reserve(dentries.size() + dir_it->second.size());
+  for (const auto& [name, record] : dir_it->second) {
+    DentryEntry dentry_entry;
+    dentry_entry.set_fs_id(fs_id_);
+    dentry_entry.set_parent(parent);
+    dentry_entry.set_name(name);
+    dentry_entry.set_ino(record.ino);
+    dentry_entry.set_flag(record.flag);
+    dentry_entry.set_type(static_cast<pb::mds::FileType>(record.type));
+
+    dentries.push_back(std::move(dentry_entry));
+  }
+
+  return Status::OK();
+}
+
+Status CompactMetaStore::CheckDirEmpty(Ino ino, bool& is_empty) {
+  utils::ReadLockGuard lk(lock_);
+
+  if (inodes_.find(ino) == inodes_.end()) {
+    LOG(ERROR) << fmt::format("[meta.fs] check dir empty, not found inode {}.",
+                              ino);
+    return Status::NotFound("not found inode.");
+  }
+
+  auto dir_it = dirs_.find(ino);
+  is_empty = (dir_it == dirs_.end() || dir_it->second.empty());
+
+  return Status::OK();
+}
+
+Status CompactMetaStore::Get(const std::string& key, std::string& value) {
+  utils::ReadLockGuard lk(lock_);
+
+  auto it = kvs_.find(key);
+  if (it == kvs_.end()) return Status::NotFound("not found");
+
+  value = it->second;
+
+  return Status::OK();
+}
+
+// func must not access store
+Status CompactMetaStore::Scan(const std::string& start_key, ScanFunc func) {
+  utils::ReadLockGuard lk(lock_);
+
+  for (auto it = kvs_.lower_bound(start_key); it != kvs_.end(); ++it) {
+    if (!func(it->first, it->second)) break;
+  }
+
+  return Status::OK();
+}
+
+Status CompactMetaStore::Write(const MetaBatch& batch, uint64_t& sequence) {
+  // encode out of lock, apply the same payload as replay does
+  std::string payload;
+  EncodeBatch(batch, payload);
+
+  {
+    utils::WriteLockGuard lk(lock_);
+
+    CHECK(ApplyPayload(payload)) << "apply meta batch fail.";
+    sequence = wal_.Append(payload);
+  }
+
+  const uint64_t checkpoint_bytes =
+      static_cast<uint64_t>(FLAGS_vfs_meta_local_checkpoint_wal_mb) * 1024 *
+      1024;
+  if (checkpoint_bytes > 0 && wal_.Size() >= checkpoint_bytes) {
+    auto status = Checkpoint();
+    if (!status.ok()) return status;
+  }
+
+  return Status::OK();
+}
+
+Status CompactMetaStore::Sync(uint64_t sequence) {
+  return wal_.Sync(sequence);
+}
+
+Status CompactMetaStore::Checkpoint() {
+  if (is_checkpointing_.exchange(true)) return Status::OK();
+
+  utils::Duration duration;
+  Status status;
+  {
+    utils::WriteLockGuard lk(lock_);
+
+    // all applied batches must be in log before drop it
+    status = wal_.Sync(wal_.LastSequence());
+    if (status.ok()) status = WriteSnapshot();
+    if (status.ok()) status = wal_.Reset();
+
+    LOG(INFO) << fmt::format(
+        "[meta.compact][{}ms] checkpoint inodes({}) dirs({}) kvs({}), {}.",
+        duration.ElapsedMs(), inodes_.size(), dirs_.size(), kvs_.size(),
+        status.ToString());
+  }
+
+  is_checkpointing_.store(false);
+
+  return status;
+}
+
+void CompactMetaStore::Summary(Json::Value& value) {
+  utils::ReadLockGuard lk(lock_);
+
+  value["name"] = Name();
+  value["inode_count"] = static_cast<Json::UInt64>(inodes_.size());
+  value["dir_count"] = static_cast<Json::UInt64>(dirs_.size());
+  value["kv_count"] = static_cast<Json::UInt64>(kvs_.size());
+  value["wal_bytes"] = static_cast<Json::UInt64>(wal_.Size());
+}
+
+CompactMetaStore::InodeRecord CompactMetaStore::ToInodeRecord(
+    const AttrEntry& attr_entry) {
+  InodeRecord record;
+  auto& core = record.core;
+  memset(&core, 0, sizeof(core));
+  core.length = attr_entry.length();
+  core.ctime = attr_entry.ctime();
+  core.mtime = attr_entry.mtime();
+  core.atime = attr_entry.atime();
+  core.rdev = attr_entry.rdev();
+  core.version = attr_entry.version();
+  core.parent = attr_entry.parents().empty() ? 0 : attr_entry.parents(0);
+  core.uid = attr_entry.uid();
+  core.gid = attr_entry.gid();
+  core.mode = attr_entry.mode();
+  core.nlink = attr_entry.nlink();
+  core.flags = attr_entry.flags();
+  core.type = static_cast<uint8_t>(attr_entry.type());
+  core.maybe_tiny_file = attr_entry.maybe_tiny_file() ? 1 : 0;
+
+  if (attr_entry.symlink().empty() && attr_entry.parents_size() <= 1 &&
+      attr_entry.xattrs().empty()) {
+    return record;
+  }
+
+  core.has_ext = 1;
+  record.ext = std::make_unique<InodeExt>();
+  record.ext->symlink = attr_entry.symlink();
+  if (attr_entry.parents_size() > 1) {
+    record.ext->more_parents.assign(attr_entry.parents().begin() + 1,
+                                    attr_entry.parents().end());
+  }
+  for (const auto& [name, value] : attr_entry.xattrs()) {
+    record.ext->xattrs.emplace_back(name, value);
+  }
+
+  return record;
+}
+
+AttrEntry CompactMetaStore::ToAttrEntry(Ino ino,
+                                        const InodeRecord& record) const {
+  const auto& core = record.core;
+
+  AttrEntry attr_entry;
+  attr_entry.set_fs_id(fs_id_);
+  attr_entry.set_ino(ino);
+  attr_entry.set_length(core.length);
+  attr_entry.set_ctime(core.ctime);
+  attr_entry.set_mtime(core.mtime);
+  attr_entry.set_atime(core.atime);
+  attr_entry.set_uid(core.uid);
+  attr_entry.set_gid(core.gid);
+  attr_entry.set_mode(core.mode);
+  attr_entry.set_nlink(core.nlink);
+  attr_entry.set_type(static_cast<pb::mds::FileType>(core.type));
+  attr_entry.set_rdev(core.rdev);
+  attr_entry.set_flags(core.flags);
+  attr_entry.set_maybe_tiny_file(core.maybe_tiny_file != 0);
+  attr_entry.set_version(core.version);
+  if (core.parent != 0) attr_entry.add_parents(core.parent);
+
+  if (record.ext != nullptr) {
+    const auto& ext = *record.ext;
+    attr_entry.set_symlink(ext.symlink);
+    for (auto parent : ext.more_parents) attr_entry.add_parents(parent);
+    for (const auto& [name, value] : ext.xattrs) {
+      (*attr_entry.mutable_xattrs())[name] = value;
+    }
+  }
+
+  return attr_entry;
+}
+
+void CompactMetaStore::EncodeBatch(const MetaBatch& batch,
+                                   std::string& payload) {
+  Encoder encoder(payload);
+  encoder.PutU32(batch.Ops().size());
+
+  for (const auto& op : batch.Ops()) {
+    switch (op.type) {
+      case MetaBatch::OpType::kPutInode:
+        EncodeInode(encoder, op.ino, ToInodeRecord(op.attr_entry));
+        break;
+      case MetaBatch::OpType::kDeleteInode:
+        encoder.PutU8(static_cast<uint8_t>(op.type));
+        encoder.PutU64(op.ino);
+        break;
+      case MetaBatch::OpType::kPutDentry:
+        EncodeDentry(
+            encoder, op.ino, op.name,
+            DentryRecord{
+                .ino = op.dentry_entry.ino(),
+                .flag = op.dentry_entry.flag(),
+                .type = static_cast<uint8_t>(op.dentry_entry.type())});
+        break;
+      case MetaBatch::OpType::kDeleteDentry:
+        encoder.PutU8(static_cast<uint8_t>(op.type));
+        encoder.PutU64(op.ino);
+        encoder.PutString(op.name);
+        break;
+      case MetaBatch::OpType::kPut:
+        EncodeKv(encoder, op.name, op.value);
+        break;
+      case MetaBatch::OpType::kDelete:
+        encoder.PutU8(static_cast<uint8_t>(op.type));
+        encoder.PutString(op.name);
+        break;
+      default:
+        LOG(FATAL) << "unknown meta batch op type.";
+    }
+  }
+}
+
+bool CompactMetaStore::ApplyPayload(const std::string& payload) {
+  Decoder decoder(payload);
+
+  uint32_t count = 0;
+  if (!decoder.GetU32(count)) return false;
+
+  for (uint32_t i = 0; i < count; ++i) {
+    uint8_t type = 0;
+    if (!decoder.GetU8(type)) return false;
+
+    switch (static_cast<MetaBatch::OpType>(type)) {
+      case MetaBatch::OpType::kPutInode: {
+        Ino ino = 0;
+        InodeRecord record;
+        if (!DecodeInode(decoder, ino, record)) return false;
+        ApplyPutInode(ino, std::move(record));
+      } break;
+
+      case MetaBatch::OpType::kDeleteInode: {
+        Ino ino = 0;
+        if (!decoder.GetU64(ino)) return false;
+        ApplyDeleteInode(ino);
+      } break;
+
+      case MetaBatch::OpType::kPutDentry: {
+        Ino parent = 0;
+        std::string name;
+        DentryRecord record;
+        if (!decoder.GetU64(parent) || !decoder.GetString(name) ||
+            !decoder.GetU64(record.ino) || !decoder.GetU32(record.flag) ||
+            !decoder.GetU8(record.type)) {
+          return false;
+        }
+        ApplyPutDentry(parent, name, record);
+      } break;
+
+      case MetaBatch::OpType::kDeleteDentry: {
+        Ino parent = 0;
+        std::string name;
+        if (!decoder.GetU64(parent) || !decoder.GetString(name)) return false;
+        ApplyDeleteDentry(parent, name);
+      } break;
+
+      case MetaBatch::OpType::kPut: {
+        std::string key, value;
+        if (!decoder.GetString(key) || !decoder.GetString(value)) {
+          return false;
+        }
+        kvs_.insert_or_assign(std::move(key), std::move(value));
+      } break;
+
+      case MetaBatch::OpType::kDelete: {
+        std::string key;
+        if (!decoder.GetString(key)) return false;
+        kvs_.erase(key);
+      } break;
+
+      default:
+        LOG(ERROR) << fmt::format("[meta.compact] unknown op type({}).", type);
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void CompactMetaStore::ApplyPutInode(Ino ino, InodeRecord&& record) {
+  inodes_.insert_or_assign(ino, std::move(record));
+}
+
+void CompactMetaStore::ApplyDeleteInode(Ino ino) {
+  inodes_.erase(ino);
+
+  // dir must be empty when deleted
+  auto it = dirs_.find(ino);
+  if (it != dirs_.end() && it->second.empty()) dirs_.erase(it);
+}
+
+void CompactMetaStore::ApplyPutDentry(Ino parent, const std::string& name,
+                                      const DentryRecord& record) {
+  dirs_[parent].insert_or_assign(name, record);
+}
+
+void CompactMetaStore::ApplyDeleteDentry(Ino parent, const std::string& name) {
+  auto it = dirs_.find(parent);
+  if (it == dirs_.end()) return;
+
+  it->second.erase(name);
+}
+
+Status CompactMetaStore::WriteSnapshot() {
+  const std::string tmp_path = SnapshotPath() + ".tmp";
+  int fd = ::open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+  if (fd < 0) {
+    return Status::IoError(
+        fmt::format("open {} fail, {}.", tmp_path, strerror(errno)));
+  }
+
+  std::string buffer;
+  std::string payload;
+  uint32_t op_count = 0;
+  Status status;
+
+  auto write_buffer = [&](bool force) {
+    if (!status.ok() || (!force && buffer.size() < kSnapshotBufferSize)) {
+      return;
+    }
+
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+      ssize_t n = ::write(fd, buffer.data() + offset, buffer.size() - offset);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        status = Status::IoError(
+            fmt::format("write {} fail, {}.", tmp_path, strerror(errno)));
+        return;
+      }
+      offset += n;
+    }
+    buffer.clear();
+  };
+
+  // payload is [count][ops], count is patched when record is sealed
+  auto seal_record = [&](bool force) {
+    if (op_count == 0 || (!force && op_count < kSnapshotRecordOps)) return;
+
+    memcpy(payload.data(), &op_count, sizeof(op_count));
+    RecordFile::AppendRecord(payload, buffer);
+    payload.clear();
+    op_count = 0;
+    write_buffer(false);
+  };
+
+  auto begin_op = [&]() -> Encoder {
+    if (payload.empty()) payload.resize(sizeof(op_count));
+    ++op_count;
+    return Encoder(payload);
+  };
+
+  for (const auto& [ino, record] : inodes_) {
+    auto encoder = begin_op();
+    EncodeInode(encoder, ino, record);
+    seal_record(false);
+  }
+
+  for (const auto& [parent, dir_index] : dirs_) {
+    for (const auto& [name, record] : dir_index) {
+      auto encoder = begin_op();
+      EncodeDentry(encoder, parent, name, record);
+      seal_record(false);
+    }
+  }
+
+  for (const auto& [key, value] : kvs_) {
+    auto encoder = begin_op();
+    EncodeKv(encoder, key, value);
+    seal_record(false);
+  }
+
+  seal_record(true);
+  write_buffer(true);
+
+  if (status.ok() && ::fsync(fd) != 0) {
+    status = Status::IoError(
+        fmt::format("sync {} fail, {}.", tmp_path, strerror(errno)));
+  }
+  ::close(fd);
+  if (!status.ok()) return status;
+
+  if (::rename(tmp_path.c_str(), SnapshotPath().c_str()) != 0) {
+    return Status::IoError(
+        fmt::format("rename {} fail, {}.", tmp_path, strerror(errno)));
+  }
+
+  // rename is durable only after dir synced, wal is reset after this
+  return SyncDir(path_);
+}
+
+Status CompactMetaStore::SyncDir(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd < 0) {
+    return Status::IoError(
+        fmt::format("open dir {} fail, {}.", path, strerror(errno)));
+  }
+
+  Status status;
+  if (::fsync(fd) != 0) {
+    status = Status::IoError(
+        fmt::format("sync dir {} fail, {}.", path, strerror(errno)));
+  }
+  ::close(fd);
+
+  return status;
+}
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
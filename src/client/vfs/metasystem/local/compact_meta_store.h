@@ -0,0 +1,151 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_LOCAL_COMPACT_META_STORE_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_LOCAL_COMPACT_META_STORE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
+#include "client/vfs/metasystem/local/meta_store.h"
+#include "client/vfs/metasystem/local/meta_wal.h"
+#include "utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+// leveldb free meta store.
+// all meta live in memory: inode as fixed layout record, dir as b-tree of
+// name -> dentry, others as ordered kv. every write batch is appended to a
+// write ahead log with group commit, and the whole state is checkpointed
+// to a snapshot when log grows too large, so there is no protobuf codec and
+// no compaction on the hot path.
+class CompactMetaStore : public MetaStore {
+ public:
+  CompactMetaStore(uint32_t fs_id) : fs_id_(fs_id) {}
+  ~CompactMetaStore() override { Close(); }
+
+  std::string Name() const override { return "compact"; }
+
+  bool Open(const std::string& path) override;
+  void Close() override;
+
+  Status GetInode(Ino ino, mds::AttrEntry& attr_entry) override;
+  Status GetDentry(Ino parent, const std::string& name,
+                   mds::DentryEntry& dentry_entry) override;
+  Status GetDentries(Ino parent,
+                     std::vector<mds::DentryEntry>& dentries) override;
+  Status CheckDirEmpty(Ino ino, bool& is_empty) override;
+
+  Status Get(const std::string& key, std::string& value) override;
+  Status Scan(const std::string& start_key, ScanFunc func) override;
+
+  Status Write(const MetaBatch& batch, uint64_t& sequence) override;
+  Status Sync(uint64_t sequence) override;
+
+  // dump whole state to snapshot and reset log
+  Status Checkpoint();
+
+  void Summary(Json::Value& value) override;
+
+  // fixed layout part of inode, also the layout in log
+  struct InodeCore {
+    uint64_t length;
+    uint64_t ctime;
+    uint64_t mtime;
+    uint64_t atime;
+    uint64_t rdev;
+    uint64_t version;
+    // first parent
+    Ino parent;
+    uint32_t uid;
+    uint32_t gid;
+    uint32_t mode;
+    uint32_t nlink;
+    uint32_t flags;
+    uint8_t type;
+    uint8_t maybe_tiny_file;
+    uint8_t has_ext;
+    uint8_t padding;
+  };
+
+  // rare attrs, most inodes have none
+  struct InodeExt {
+    std::string symlink;
+    std::vector<Ino> more_parents;
+    std::vector<std::pair<std::string, std::string>> xattrs;
+  };
+
+  struct InodeRecord {
+    InodeCore core;
+    std::unique_ptr<InodeExt> ext;
+  };
+
+  struct DentryRecord {
+    Ino ino;
+    uint32_t flag;
+    uint8_t type;
+  };
+
+ private:
+  using DirIndex = absl::btree_map<std::string, DentryRecord>;
+
+  static InodeRecord ToInodeRecord(const mds::AttrEntry& attr_entry);
+  mds::AttrEntry ToAttrEntry(Ino ino, const InodeRecord& record) const;
+
+  // encode/decode batch op to/from log payload
+  static void EncodeBatch(const MetaBatch& batch, std::string& payload);
+  bool ApplyPayload(const std::string& payload);
+
+  // must hold lock
+  void ApplyBatch(const MetaBatch& batch);
+  void ApplyPutInode(Ino ino, InodeRecord&& record);
+  void ApplyDeleteInode(Ino ino);
+  void ApplyPutDentry(Ino parent, const std::string& name,
+                      const DentryRecord& record);
+  void ApplyDeleteDentry(Ino parent, const std::string& name);
+
+  Status WriteSnapshot();
+  static Status SyncDir(const std::string& path);
+
+  std::string SnapshotPath() const { return path_ + "/meta.snapshot"; }
+  std::string WalPath() const { return path_ + "/meta.wal"; }
+
+  const uint32_t fs_id_;
+  std::string path_;
+
+  utils::RWLock lock_;
+  absl::flat_hash_map<Ino, InodeRecord> inodes_;
+  absl::flat_hash_map<Ino, DirIndex> dirs_;
+  absl::btree_map<std::string, std::string> kvs_;
+
+  MetaWal wal_;
+  std::atomic<bool> is_checkpointing_{false};
+  bool is_opened_{false};
+};
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_LOCAL_COMPACT_META_STORE_H_
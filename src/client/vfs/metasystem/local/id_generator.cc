@@ -26,9 +26,9 @@ namespace local {
 
 static const uint32_t kMaxRetryTimes = 5;
 
-LevelIdGenerator::LevelIdGenerator(leveldb::DB* db, const std::string& name,
+StoreIdGenerator::StoreIdGenerator(MetaStore* store, const std::string& name,
                                    int64_t start_id, int batch_size)
-    : db_(db),
+    : store_(store),
       name_(name),
       key_(mds::MetaCodec::EncodeAutoIncrementIDKey(name)),
       next_id_(start_id),
@@ -37,11 +37,11 @@ LevelIdGenerator::LevelIdGenerator(leveldb::DB* db, const std::string& name,
   CHECK(bthread_mutex_init(&mutex_, nullptr) == 0) << "init mutex fail.";
 }
 
-LevelIdGenerator::~LevelIdGenerator() {
+StoreIdGenerator::~StoreIdGenerator() {
   CHECK(bthread_mutex_destroy(&mutex_) == 0) << "destory mutex fail.";
 }
 
-bool LevelIdGenerator::Init() {
+bool StoreIdGenerator::Init() {
   uint64_t alloc_id = 0;
   auto status = GetOrPutAllocId(alloc_id);
   if (!status.ok()) {
@@ -57,7 +57,7 @@ bool LevelIdGenerator::Init() {
   return true;
 }
 
-bool LevelIdGenerator::Destroy() {
+bool StoreIdGenerator::Destroy() {
   BAIDU_SCOPED_LOCK(mutex_);
 
   auto status = DestroyId();
@@ -71,11 +71,11 @@ bool LevelIdGenerator::Destroy() {
   return true;
 }
 
-bool LevelIdGenerator::GenID(uint32_t num, uint64_t& id) {
+bool StoreIdGenerator::GenID(uint32_t num, uint64_t& id) {
   return GenID(num, 0, id);
 }
 
-bool LevelIdGenerator::GenID(uint32_t num, uint64_t min_slice_id,
+bool StoreIdGenerator::GenID(uint32_t num, uint64_t min_slice_id,
                              uint64_t& id) {
   if (num == 0) {
     LOG(ERROR) << fmt::format("[idalloc.{}] num cant not 0.", name_);
@@ -105,13 +105,13 @@ bool LevelIdGenerator::GenID(uint32_t num, uint64_t min_slice_id,
   return true;
 }
 
-std::string LevelIdGenerator::Describe() const {
+std::string StoreIdGenerator::Describe() const {
   return fmt::format(
       "[store] name({}) batch_size({}) last_alloc_id({}) next_id({})", name_,
       batch_size_, last_alloc_id_, next_id_);
 }
 
-Status LevelIdGenerator::GetOrPutAllocId(uint64_t& alloc_id) {
+Status StoreIdGenerator::GetOrPutAllocId(uint64_t& alloc_id) {
   std::string value;
   auto status = Get(key_, value);
   if (!status.ok()) {
@@ -133,7 +133,7 @@ Status LevelIdGenerator::GetOrPutAllocId(uint64_t& alloc_id) {
   return Status::OK();
 }
 
-Status LevelIdGenerator::AllocateIds(uint32_t size) {
+Status StoreIdGenerator::AllocateIds(uint32_t size) {
   utils::Duration duration;
   Status status;
   uint32_t retry = 0;
@@ -170,32 +170,22 @@ Status LevelIdGenerator::AllocateIds(uint32_t size) {
   return status;
 }
 
-Status LevelIdGenerator::DestroyId() {
-  auto status = db_->Delete(leveldb::WriteOptions(), key_);
-  if (!status.ok()) {
-    return Status::Internal(status.ToString());
-  }
+Status StoreIdGenerator::DestroyId() {
+  MetaBatch batch;
+  batch.Delete(key_);
 
-  return Status::OK();
+  return store_->WriteAndSync(batch);
 }
 
-Status LevelIdGenerator::Get(const std::string& key, std::string& value) {
-  auto status = db_->Get(leveldb::ReadOptions(), key, &value);
-  if (!status.ok()) {
-    if (status.IsNotFound()) return Status::NotFound("not found");
-    return Status::Internal(fmt::format("get fail, {}.", status.ToString()));
-  }
-
-  return Status::OK();
+Status StoreIdGenerator::Get(const std::string& key, std::string& value) {
+  return store_->Get(key, value);
 }
 
-Status LevelIdGenerator::Put(const std::string& key, const std::string& value) {
-  auto status = db_->Put(leveldb::WriteOptions(), key, value);
-  if (!status.ok()) {
-    return Status::Internal(fmt::format("put fail, {}.", status.ToString()));
-  }
+Status StoreIdGenerator::Put(const std::string& key, const std::string& value) {
+  MetaBatch batch;
+  batch.Put(key, value);
 
-  return Status::OK();
+  return store_->WriteAndSync(batch);
 }
 
 }  // namespace local
@@ -20,7 +20,7 @@
 
 #include "bthread/types.h"
 #include "common/status.h"
-#include "leveldb/db.h"
+#include "client/vfs/metasystem/local/meta_store.h"
 
 namespace dingofs {
 namespace client {
@@ -43,15 +43,17 @@ class IdGenerator {
 
 using IdGeneratorUPtr = std::unique_ptr<IdGenerator>;
 
-class LevelIdGenerator : public IdGenerator {
+// id generator persist alloc id in meta store
+class StoreIdGenerator : public IdGenerator {
  public:
-  LevelIdGenerator(leveldb::DB* db, const std::string& name, int64_t start_id,
+  StoreIdGenerator(MetaStore* store, const std::string& name, int64_t start_id,
                    int batch_size);
-  ~LevelIdGenerator() override;
+  ~StoreIdGenerator() override;
 
-  static IdGeneratorUPtr New(leveldb::DB* db, const std::string& name,
+  static IdGeneratorUPtr New(MetaStore* store, const std::string& name,
                              int64_t start_id, int batch_size) {
-    return std::make_unique<LevelIdGenerator>(db, name, start_id, batch_size);
+    return std::make_unique<StoreIdGenerator>(store, name, start_id,
+                                              batch_size);
   }
 
   bool Init() override;
@@ -85,7 +87,7 @@ class LevelIdGenerator : public IdGenerator {
 
   bool is_destroyed_{false};
 
-  leveldb::DB* db_{nullptr};
+  MetaStore* store_{nullptr};
 };
 
 }  // namespace local
@@ -0,0 +1,265 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "client/vfs/metasystem/local/meta_store.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "client/vfs/metasystem/local/compact_meta_store.h"
+#include "fmt/format.h"
+#include "glog/logging.h"
+#include "leveldb/options.h"
+#include "leveldb/write_batch.h"
+#include "mds/common/codec.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+using dingofs::mds::AttrEntry;
+using dingofs::mds::DentryEntry;
+using dingofs::mds::MetaCodec;
+
+void MetaBatch::PutInode(const AttrEntry& attr_entry) {
+  Op op;
+  op.type = OpType::kPutInode;
+  op.ino = attr_entry.ino();
+  op.attr_entry = attr_entry;
+  ops_.push_back(std::move(op));
+}
+
+void MetaBatch::DeleteInode(Ino ino) {
+  Op op;
+  op.type = OpType::kDeleteInode;
+  op.ino = ino;
+  ops_.push_back(std::move(op));
+}
+
+void MetaBatch::PutDentry(const DentryEntry& dentry_entry) {
+  Op op;
+  op.type = OpType::kPutDentry;
+  op.ino = dentry_entry.parent();
+  op.name = dentry_entry.name();
+  op.dentry_entry = dentry_entry;
+  ops_.push_back(std::move(op));
+}
+
+void MetaBatch::DeleteDentry(Ino parent, const std::string& name) {
+  Op op;
+  op.type = OpType::kDeleteDentry;
+  op.ino = parent;
+  op.name = name;
+  ops_.push_back(std::move(op));
+}
+
+void MetaBatch::Put(const std::string& key, const std::string& value) {
+  Op op;
+  op.type = OpType::kPut;
+  op.name = key;
+  op.value = value;
+  ops_.push_back(std::move(op));
+}
+
+void MetaBatch::Delete(const std::string& key) {
+  Op op;
+  op.type = OpType::kDelete;
+  op.name = key;
+  ops_.push_back(std::move(op));
+}
+
+bool LevelMetaStore::Open(const std::string& path) {
+  leveldb::Options options;
+  options.create_if_missing = true;
+  leveldb::Status status = leveldb::DB::Open(options, path, &db_);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[local] init leveldb fail, {} {}.", path,
+                              status.ToString());
+    return false;
+  }
+
+  return true;
+}
+
+void LevelMetaStore::Close() {
+  if (db_ == nullptr) return;
+
+  LOG(INFO) << "[meta.fs] close leveldb.";
+  delete db_;
+  db_ = nullptr;
+}
+
+Status LevelMetaStore::GetInode(Ino ino, AttrEntry& attr_entry) {
+  std::string value;
+  auto status = Get(MetaCodec::EncodeInodeKey(fs_id_, ino), value);
+  if (!status.ok()) return status;
+
+  attr_entry = MetaCodec::DecodeInodeValue(value);
+
+  return Status::OK();
+}
+
+Status LevelMetaStore::GetDentry(Ino parent, const std::string& name,
+                                 DentryEntry& dentry_entry) {
+  std::string value;
+  auto status = Get(MetaCodec::EncodeDentryKey(fs_id_, parent, name), value);
+  if (!status.ok()) return status;
+
+  dentry_entry = MetaCodec::DecodeDentryValue(value);
+
+  return Status::OK();
+}
+
+Status LevelMetaStore::GetDentries(Ino parent,
+                                   std::vector<DentryEntry>& dentries) {
+  auto* iter = db_->NewIterator(leveldb::ReadOptions());
+
+  iter->Seek(MetaCodec::EncodeInodeKey(fs_id_, parent));
+  if (iter->Valid()) {
+    CHECK(MetaCodec::IsInodeKey(iter->key().ToString())) << "not inode key.";
+    iter->Next();  // skip inode key
+  }
+
+  while (iter->Valid()) {
+    if (!MetaCodec::IsDentryKey(iter->key().ToString())) {
+      break;
+    }
+
+    dentries.push_back(MetaCodec::DecodeDentryValue(iter->value().ToString()));
+
+    iter->Next();
+  }
+
+  delete iter;
+
+  return Status::OK();
+}
+
+Status LevelMetaStore::CheckDirEmpty(Ino ino, bool& is_empty) {
+  auto* iter = db_->NewIterator(leveldb::ReadOptions());
+  iter->Seek(MetaCodec::EncodeInodeKey(fs_id_, ino));
+
+  if (!iter->Valid() || !MetaCodec::IsInodeKey(iter->key().ToString())) {
+    LOG(ERROR) << fmt::format("[meta.fs] check dir empty, not found inode {}.",
+                              ino);
+    delete iter;
+    return Status::NotFound("not found inode.");
+  }
+
+  uint32_t fs_id;
+  Ino temp_ino;
+  MetaCodec::DecodeInodeKey(iter->key().ToString(), fs_id, temp_ino);
+  if (temp_ino != ino) {
+    LOG(ERROR) << fmt::format("[meta.fs] decode ino not match, {}!={}.",
+                              temp_ino, ino);
+    delete iter;
+    return Status::NotFound("not found inode.");
+  }
+
+  iter->Next();  // skip inode key
+
+  if (iter->Valid() && MetaCodec::IsDentryKey(iter->key().ToString())) {
+    is_empty = false;
+  } else {
+    is_empty = true;
+  }
+
+  delete iter;
+
+  return Status::OK();
+}
+
+Status LevelMetaStore::Get(const std::string& key, std::string& value) {
+  auto status = db_->Get(leveldb::ReadOptions(), key, &value);
+  if (!status.ok()) {
+    if (status.IsNotFound()) return Status::NotFound("not found");
+    return Status::IoError(fmt::format("get fail, {}.", status.ToString()));
+  }
+
+  return Status::OK();
+}
+
+Status LevelMetaStore::Scan(const std::string& start_key, ScanFunc func) {
+  auto* iter = db_->NewIterator(leveldb::ReadOptions());
+
+  for (iter->Seek(start_key); iter->Valid(); iter->Next()) {
+    if (!func(iter->key().ToString(), iter->value().ToString())) break;
+  }
+
+  auto status = iter->status();
+  delete iter;
+  if (!status.ok()) {
+    return Status::IoError(fmt::format("scan fail, {}.", status.ToString()));
+  }
+
+  return Status::OK();
+}
+
+Status LevelMetaStore::Write(const MetaBatch& batch, uint64_t&) {
+  leveldb::WriteBatch write_batch;
+
+  for (const auto& op : batch.Ops()) {
+    switch (op.type) {
+      case MetaBatch::OpType::kPutInode:
+        write_batch.Put(MetaCodec::EncodeInodeKey(fs_id_, op.ino),
+                        MetaCodec::EncodeInodeValue(op.attr_entry));
+        break;
+      case MetaBatch::OpType::kDeleteInode:
+        write_batch.Delete(MetaCodec::EncodeInodeKey(fs_id_, op.ino));
+        break;
+      case MetaBatch::OpType::kPutDentry:
+        write_batch.Put(MetaCodec::EncodeDentryKey(fs_id_, op.ino, op.name),
+                        MetaCodec::EncodeDentryValue(op.dentry_entry));
+        break;
+      case MetaBatch::OpType::kDeleteDentry:
+        write_batch.Delete(MetaCodec::EncodeDentryKey(fs_id_, op.ino, op.name));
+        break;
+      case MetaBatch::OpType::kPut:
+        write_batch.Put(op.name, op.value);
+        break;
+      case MetaBatch::OpType::kDelete:
+        write_batch.Delete(op.name);
+        break;
+      default:
+        LOG(FATAL) << "unknown meta batch op type.";
+    }
+  }
+
+  auto status = db_->Write(leveldb::WriteOptions(), &write_batch);
+  if (!status.ok()) {
+    return Status::IoError(fmt::format("put fail, {}.", status.ToString()));
+  }
+
+  return Status::OK();
+}
+
+MetaStoreUPtr NewMetaStore(const std::string& engine, uint32_t fs_id) {
+  if (engine == "leveldb") {
+    return std::make_unique<LevelMetaStore>(fs_id);
+
+  } else if (engine == "compact") {
+    return std::make_unique<CompactMetaStore>(fs_id);
+  }
+
+  LOG(ERROR) << fmt::format("[meta.fs] unknown local meta engine({}).",
+                            engine);
+  return nullptr;
+}
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,159 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_LOCAL_META_STORE_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_LOCAL_META_STORE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "json/value.h"
+#include "leveldb/db.h"
+#include "mds/common/type.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+using mds::Ino;
+
+// mutations of one local meta operation, applied atomically by meta store.
+// inode and dentry are typed, so store could keep them in native layout.
+class MetaBatch {
+ public:
+  enum class OpType : uint8_t {
+    kPutInode = 0,
+    kDeleteInode = 1,
+    kPutDentry = 2,
+    kDeleteDentry = 3,
+    kPut = 4,
+    kDelete = 5,
+  };
+
+  struct Op {
+    OpType type{OpType::kPut};
+    // inode ino or dentry parent
+    Ino ino{0};
+    // dentry name or key
+    std::string name;
+    std::string value;
+    mds::AttrEntry attr_entry;
+    mds::DentryEntry dentry_entry;
+  };
+
+  void PutInode(const mds::AttrEntry& attr_entry);
+  void DeleteInode(Ino ino);
+  void PutDentry(const mds::DentryEntry& dentry_entry);
+  void DeleteDentry(Ino parent, const std::string& name);
+  void Put(const std::string& key, const std::string& value);
+  void Delete(const std::string& key);
+
+  const std::vector<Op>& Ops() const { return ops_; }
+  bool Empty() const { return ops_.empty(); }
+
+ private:
+  std::vector<Op> ops_;
+};
+
+class MetaStore;
+using MetaStoreUPtr = std::unique_ptr<MetaStore>;
+
+// storage engine of local meta system
+class MetaStore {
+ public:
+  MetaStore() = default;
+  virtual ~MetaStore() = default;
+
+  // return false when stop
+  using ScanFunc =
+      std::function<bool(const std::string& key, const std::string& value)>;
+
+  virtual std::string Name() const = 0;
+
+  virtual bool Open(const std::string& path) = 0;
+  virtual void Close() = 0;
+
+  virtual Status GetInode(Ino ino, mds::AttrEntry& attr_entry) = 0;
+  virtual Status GetDentry(Ino parent, const std::string& name,
+                           mds::DentryEntry& dentry_entry) = 0;
+  virtual Status GetDentries(Ino parent,
+                             std::vector<mds::DentryEntry>& dentries) = 0;
+  // return NotFound when not found dir inode
+  virtual Status CheckDirEmpty(Ino ino, bool& is_empty) = 0;
+
+  // untyped kv, e.g. fs info/quota/chunk/delfile/id
+  virtual Status Get(const std::string& key, std::string& value) = 0;
+  // ordered scan kv from start key
+  virtual Status Scan(const std::string& start_key, ScanFunc func) = 0;
+
+  // batch is visible when return, and durable after Sync(sequence).
+  // caller could sync out of its own lock, so concurrent writers share one
+  // log flush.
+  virtual Status Write(const MetaBatch& batch, uint64_t& sequence) = 0;
+  virtual Status Sync(uint64_t sequence) = 0;
+
+  Status WriteAndSync(const MetaBatch& batch) {
+    uint64_t sequence = 0;
+    auto status = Write(batch, sequence);
+    if (!status.ok()) return status;
+    return Sync(sequence);
+  }
+
+  virtual void Summary(Json::Value& value) { value["name"] = Name(); }
+};
+
+// meta store on leveldb, every entry is protobuf encoded by MetaCodec
+class LevelMetaStore : public MetaStore {
+ public:
+  LevelMetaStore(uint32_t fs_id) : fs_id_(fs_id) {}
+  ~LevelMetaStore() override { Close(); }
+
+  std::string Name() const override { return "leveldb"; }
+
+  bool Open(const std::string& path) override;
+  void Close() override;
+
+  Status GetInode(Ino ino, mds::AttrEntry& attr_entry) override;
+  Status GetDentry(Ino parent, const std::string& name,
+                   mds::DentryEntry& dentry_entry) override;
+  Status GetDentries(Ino parent,
+                     std::vector<mds::DentryEntry>& dentries) override;
+  Status CheckDirEmpty(Ino ino, bool& is_empty) override;
+
+  Status Get(const std::string& key, std::string& value) override;
+  Status Scan(const std::string& start_key, ScanFunc func) override;
+
+  Status Write(const MetaBatch& batch, uint64_t& sequence) override;
+  Status Sync(uint64_t) override { return Status::OK(); }
+
+ private:
+  const uint32_t fs_id_;
+
+  leveldb::DB* db_{nullptr};
+};
+
+// engine: leveldb or compact
+MetaStoreUPtr NewMetaStore(const std::string& engine, uint32_t fs_id);
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_LOCAL_META_STORE_H_
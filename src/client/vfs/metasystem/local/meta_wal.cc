@@ -0,0 +1,225 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "client/vfs/metasystem/local/meta_wal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "bthread/bthread.h"
+#include "bthread/mutex.h"
+#include "butil/crc32c.h"
+#include "common/options/client.h"
+#include "fmt/format.h"
+#include "glog/logging.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+static const size_t kRecordHeaderSize = 8;
+// guard against garbage length of torn record
+static const uint32_t kMaxRecordSize = 256 * 1024 * 1024;
+
+Status RecordFile::Replay(const std::string& path, ReplayFunc func,
+                          uint64_t& valid_size) {
+  valid_size = 0;
+
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    if (errno == ENOENT) return Status::OK();
+    return Status::IoError(
+        fmt::format("open {} fail, {}.", path, strerror(errno)));
+  }
+
+  std::string payload;
+  char header[kRecordHeaderSize];
+  while (fread(header, 1, kRecordHeaderSize, file) == kRecordHeaderSize) {
+    uint32_t length, crc;
+    memcpy(&length, header, sizeof(length));
+    memcpy(&crc, header + sizeof(length), sizeof(crc));
+    if (length > kMaxRecordSize) break;
+
+    payload.resize(length);
+    if (fread(payload.data(), 1, length, file) != length) break;
+    if (butil::crc32c::Value(payload.data(), payload.size()) != crc) break;
+
+    if (!func(payload)) {
+      fclose(file);
+      return Status::Internal(fmt::format("replay {} fail.", path));
+    }
+
+    valid_size += kRecordHeaderSize + length;
+  }
+
+  fclose(file);
+
+  return Status::OK();
+}
+
+void RecordFile::AppendRecord(const std::string& payload, std::string& out) {
+  uint32_t length = payload.size();
+  uint32_t crc = butil::crc32c::Value(payload.data(), payload.size());
+
+  out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  out.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+  out.append(payload);
+}
+
+MetaWal::MetaWal() {
+  CHECK(bthread_mutex_init(&mutex_, nullptr) == 0) << "init mutex fail.";
+  CHECK(bthread_cond_init(&cond_, nullptr) == 0) << "init cond fail.";
+}
+
+MetaWal::~MetaWal() {
+  Close();
+
+  bthread_cond_destroy(&cond_);
+  bthread_mutex_destroy(&mutex_);
+}
+
+Status MetaWal::Open(const std::string& path, RecordFile::ReplayFunc func) {
+  path_ = path;
+
+  uint64_t valid_size = 0;
+  auto status = RecordFile::Replay(path, std::move(func), valid_size);
+  if (!status.ok()) return status;
+
+  fd_ = ::open(path.c_str(), O_CREAT | O_WRONLY, 0644);
+  if (fd_ < 0) {
+    return Status::IoError(
+        fmt::format("open wal {} fail, {}.", path, strerror(errno)));
+  }
+
+  // drop torn tail record
+  if (::ftruncate(fd_, valid_size) != 0 ||
+      ::lseek(fd_, valid_size, SEEK_SET) < 0) {
+    return Status::IoError(
+        fmt::format("truncate wal {} fail, {}.", path, strerror(errno)));
+  }
+
+  size_.store(valid_size);
+
+  LOG(INFO) << fmt::format("[meta.wal] open wal {} size({}).", path,
+                           valid_size);
+
+  return Status::OK();
+}
+
+void MetaWal::Close() {
+  if (fd_ < 0) return;
+
+  Sync(LastSequence());
+
+  ::close(fd_);
+  fd_ = -1;
+}
+
+uint64_t MetaWal::Append(const std::string& payload) {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  RecordFile::AppendRecord(payload, pending_buffer_);
+  ++pending_count_;
+
+  return ++last_sequence_;
+}
+
+Status MetaWal::Sync(uint64_t sequence) {
+  bthread_mutex_lock(&mutex_);
+
+  while (durable_sequence_ < sequence && error_.ok()) {
+    if (is_flushing_) {
+      bthread_cond_wait(&cond_, &mutex_);
+      continue;
+    }
+
+    // become leader, flush for all pending writers
+    is_flushing_ = true;
+    std::string buffer;
+    buffer.swap(pending_buffer_);
+    const uint64_t flush_sequence = last_sequence_;
+    group_size_ << pending_count_;
+    pending_count_ = 0;
+
+    bthread_mutex_unlock(&mutex_);
+    auto status = Flush(buffer);
+    bthread_mutex_lock(&mutex_);
+
+    is_flushing_ = false;
+    if (status.ok()) {
+      durable_sequence_ = flush_sequence;
+    } else {
+      error_ = status;
+    }
+    bthread_cond_broadcast(&cond_);
+  }
+
+  auto status = error_;
+  bthread_mutex_unlock(&mutex_);
+
+  return status;
+}
+
+uint64_t MetaWal::LastSequence() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  return last_sequence_;
+}
+
+Status MetaWal::Reset() {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  CHECK(!is_flushing_ && pending_buffer_.empty())
+      << "reset wal with pending records.";
+
+  if (::ftruncate(fd_, 0) != 0 || ::lseek(fd_, 0, SEEK_SET) < 0) {
+    return Status::IoError(
+        fmt::format("reset wal {} fail, {}.", path_, strerror(errno)));
+  }
+  size_.store(0);
+
+  return Status::OK();
+}
+
+Status MetaWal::Flush(const std::string& buffer) {
+  size_t offset = 0;
+  while (offset < buffer.size()) {
+    ssize_t n = ::write(fd_, buffer.data() + offset, buffer.size() - offset);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return Status::IoError(
+          fmt::format("write wal {} fail, {}.", path_, strerror(errno)));
+    }
+    offset += n;
+  }
+
+  if (FLAGS_vfs_meta_local_wal_sync && ::fdatasync(fd_) != 0) {
+    return Status::IoError(
+        fmt::format("sync wal {} fail, {}.", path_, strerror(errno)));
+  }
+
+  size_.fetch_add(buffer.size(), std::memory_order_relaxed);
+
+  return Status::OK();
+}
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
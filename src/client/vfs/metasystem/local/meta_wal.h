@@ -0,0 +1,99 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_LOCAL_META_WAL_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_LOCAL_META_WAL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "bthread/types.h"
+#include "bvar/recorder.h"
+#include "common/status.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+// record file format: [length(4)][crc32c(4)][payload] ...
+// a torn tail record is dropped by Replay.
+class RecordFile {
+ public:
+  using ReplayFunc = std::function<bool(const std::string& payload)>;
+
+  // read records in order, valid_size is the end of the last good record
+  static Status Replay(const std::string& path, ReplayFunc func,
+                       uint64_t& valid_size);
+
+  static void AppendRecord(const std::string& payload, std::string& out);
+};
+
+// write ahead log of compact meta store.
+// writers append record to a shared buffer, the first one who waits for
+// durability flushes the buffer for all pending writers(group commit).
+class MetaWal {
+ public:
+  MetaWal();
+  ~MetaWal();
+
+  MetaWal(const MetaWal&) = delete;
+  MetaWal& operator=(const MetaWal&) = delete;
+
+  // replay exist records then open for append
+  Status Open(const std::string& path, RecordFile::ReplayFunc func);
+  void Close();
+
+  // return sequence of the record
+  uint64_t Append(const std::string& payload);
+  // wait until the record of sequence is written(and synced if enable)
+  Status Sync(uint64_t sequence);
+  uint64_t LastSequence();
+
+  // drop all records, caller ensures all records are checkpointed
+  Status Reset();
+
+  uint64_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+ private:
+  Status Flush(const std::string& buffer);
+
+  std::string path_;
+  int fd_{-1};
+
+  bthread_mutex_t mutex_;
+  bthread_cond_t cond_;
+
+  std::string pending_buffer_;
+  uint32_t pending_count_{0};
+  uint64_t last_sequence_{0};
+  uint64_t durable_sequence_{0};
+  bool is_flushing_{false};
+  // sticky error, log is broken after a failed flush
+  Status error_;
+
+  std::atomic<uint64_t> size_{0};
+
+  // records written by one flush
+  bvar::IntRecorder group_size_{"meta_local_wal_group_size"};
+};
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_LOCAL_META_WAL_H_
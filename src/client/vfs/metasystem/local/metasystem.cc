@@ -29,10 +29,9 @@
 #include "common/const.h"
 #include "common/directory.h"
 #include "common/helper.h"
+#include "common/options/client.h"
 #include "fmt/format.h"
 #include "glog/logging.h"
-#include "leveldb/options.h"
-#include "leveldb/write_batch.h"
 #include "mds/common/codec.h"
 #include "utils/uuid.h"
 
@@ -196,15 +195,26 @@ LocalMetaSystem::LocalMetaSystem(const std::string& db_path,
       inode_cache_(meta::InodeCache::New(kFsId)) {}  // NOLINT
 
 Status LocalMetaSystem::Init(bool upgrade) {
+  store_ = NewMetaStore(FLAGS_vfs_meta_local_engine, kFsId);
+  if (store_ == nullptr) {
+    return Status::InvalidParam(fmt::format("unknown local meta engine({}).",
+                                            FLAGS_vfs_meta_local_engine));
+  }
+
+  // each engine has its own dir, the leveldb one keeps the old path
   std::string db_path = fmt::format("{}/{}", db_path_, fs_name_);
+  if (store_->Name() != "leveldb") {
+    db_path = fmt::format("{}_{}", db_path, store_->Name());
+  }
   // create db path if not exist
   if (!dingofs::Helper::CreateDirectory(db_path)) {
     return Status::Internal(
         fmt::format("create db path dir fail, path : {}", db_path_));
   }
 
-  if (!OpenLevelDB(db_path)) {
-    return Status::Internal("open leveldb fail.");
+  if (!store_->Open(db_path)) {
+    return Status::Internal(
+        fmt::format("open {} meta store fail.", store_->Name()));
   }
 
   if (!InitIdGenerators()) {
@@ -230,7 +240,7 @@ Status LocalMetaSystem::Init(bool upgrade) {
 void LocalMetaSystem::Stop(bool upgrade) {
   crontab_manager_.Destroy();
 
-  CloseLevelDB();
+  if (store_ != nullptr) store_->Close();
 }
 
 bool LocalMetaSystem::Dump(ContextSPtr, Json::Value& value) {
@@ -263,15 +273,11 @@ bool LocalMetaSystem::Load(ContextSPtr, const Json::Value& value) {
 
 Status LocalMetaSystem::Lookup(ContextSPtr, Ino parent, const std::string& name,
                                Attr* attr) {
-  const uint32_t fs_id = fs_info_.fs_id();
-
   // get dentry
-  std::string value;
-  auto status = Get(MetaCodec::EncodeDentryKey(fs_id, parent, name), value);
+  DentryEntry dentry_entry;
+  auto status = store_->GetDentry(parent, name, dentry_entry);
   if (!status.ok()) return status;
 
-  auto dentry_entry = MetaCodec::DecodeDentryValue(value);
-
   // get inode
   AttrEntry attr_entry;
   status = GetAttrEntry(dentry_entry.ino(), attr_entry);
@@ -314,34 +320,29 @@ Status LocalMetaSystem::MkNod(ContextSPtr, Ino parent, const std::string& name,
   dentry_entry.set_type(pb::mds::FileType::FILE);
 
   AttrEntry parent_attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
-    std::string value;
-    std::string parent_inode_key = MetaCodec::EncodeInodeKey(fs_id, parent);
-    auto status = Get(parent_inode_key, value);
+    auto status = store_->GetInode(parent, parent_attr_entry);
     if (!status.ok()) return status;
-    CHECK(!value.empty()) << "not found parent inode.";
 
-    parent_attr_entry = MetaCodec::DecodeInodeValue(value);
     parent_attr_entry.set_ctime(std::max(parent_attr_entry.ctime(), now_ns));
     parent_attr_entry.set_mtime(std::max(parent_attr_entry.mtime(), now_ns));
     parent_attr_entry.set_version(parent_attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, MetaCodec::EncodeInodeKey(fs_id, ino),
-         MetaCodec::EncodeInodeValue(attr_entry)},
-        {KeyValue::OpType::kPut,
-         MetaCodec::EncodeDentryKey(fs_id, parent, name),
-         MetaCodec::EncodeDentryValue(dentry_entry)},
-        {KeyValue::OpType::kPut, parent_inode_key,
-         MetaCodec::EncodeInodeValue(parent_attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    batch.PutDentry(dentry_entry);
+    batch.PutInode(parent_attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
   PutInodeToCache(parent_attr_entry);
 
@@ -374,15 +375,13 @@ Status LocalMetaSystem::Open(ContextSPtr, Ino ino, int flags, uint64_t) {
 
   int64_t file_length = 0;
   AttrEntry attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get inode
-    std::string value;
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_info_.fs_id(), ino);
-    auto status = Get(inode_key, value);
-
-    attr_entry = MetaCodec::DecodeInodeValue(value);
+    auto status = store_->GetInode(ino, attr_entry);
+    if (!status.ok()) return status;
 
     if (flags & O_TRUNC) {
       file_length = attr_entry.length();
@@ -396,15 +395,16 @@ Status LocalMetaSystem::Open(ContextSPtr, Ino ino, int flags, uint64_t) {
 
     attr_entry.set_version(attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, inode_key,
-         MetaCodec::EncodeInodeValue(attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
 
   if (flags & O_TRUNC) UpdateFsUsage(-file_length, 0, "open");
@@ -452,7 +452,7 @@ Status LocalMetaSystem::ReadSlice(ContextSPtr, Ino ino, uint64_t index,
   // get chunk info
   std::string value;
   std::string chunk_key = MetaCodec::EncodeChunkKey(fs_id, ino, index);
-  auto status = Get(chunk_key, value);
+  auto status = store_->Get(chunk_key, value);
   if (!status.ok()) {
     if (status.IsNotFound()) return Status::OK();
     return status;
@@ -468,6 +468,8 @@ Status LocalMetaSystem::ReadSlice(ContextSPtr, Ino ino, uint64_t index,
     slice.length = slice_info.len();
     slice.compaction = slice_info.compaction_version();
     slice.is_zero = slice_info.zero();
+    slice.pack_offset = slice_info.pack_offset();
+    slice.pack_refs = slice_info.pack_refs();
 
     slices->push_back(slice);
   }
@@ -490,19 +492,17 @@ Status LocalMetaSystem::WriteSlice(ContextSPtr, Ino ino, uint64_t index,
 
   int64_t delta_size = 0;
   AttrEntry attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
     // get inode
-    std::string value;
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_id, ino);
-    auto status = Get(inode_key, value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok() && !status.IsNotFound()) return status;
 
-    if (status.ok()) attr_entry = MetaCodec::DecodeInodeValue(value);
-
     // get chunk info
+    std::string value;
     std::string chunk_key = MetaCodec::EncodeChunkKey(fs_id, ino, index);
-    status = Get(chunk_key, value);
+    status = store_->Get(chunk_key, value);
 
     mds::ChunkEntry chunk_entry;
     if (!status.ok()) {
@@ -519,7 +519,7 @@ Status LocalMetaSystem::WriteSlice(ContextSPtr, Ino ino, uint64_t index,
 
     uint64_t new_length = 0;
     for (const auto& slice : slices) {
-      new_length = std::max(new_length, slice.offset + slice.size);
+      new_length = std::max(new_length, slice.End());
 
       auto* slice_entry = chunk_entry.add_slices();
 
@@ -529,15 +529,17 @@ Status LocalMetaSystem::WriteSlice(ContextSPtr, Ino ino, uint64_t index,
       slice_entry->set_size(slice.size);
       slice_entry->set_compaction_version(slice.compaction);
       slice_entry->set_zero(slice.is_zero);
+      if (slice.IsPacked()) {
+        slice_entry->set_pack_offset(slice.pack_offset);
+        slice_entry->set_pack_refs(slice.pack_refs);
+      }
     }
 
     chunk_entry.set_version(chunk_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, chunk_key,
-         MetaCodec::EncodeChunkValue(chunk_entry)},
-    };
+    // write to store
+    MetaBatch batch;
+    batch.Put(chunk_key, MetaCodec::EncodeChunkValue(chunk_entry));
     if (attr_entry.ino() > 0 && attr_entry.length() < new_length) {
       delta_size = new_length - attr_entry.length();
       attr_entry.set_length(new_length);
@@ -545,14 +547,16 @@ Status LocalMetaSystem::WriteSlice(ContextSPtr, Ino ino, uint64_t index,
       attr_entry.set_mtime(std::max(attr_entry.mtime(), now_ns));
       attr_entry.set_version(attr_entry.version() + 1);
 
-      kvs.push_back({KeyValue::OpType::kPut, inode_key,
-                     MetaCodec::EncodeInodeValue(attr_entry)});
+      batch.PutInode(attr_entry);
     }
 
-    status = Put(kvs);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   if (attr_entry.ino() > 0) PutInodeToCache(attr_entry);
 
   if (delta_size != 0) UpdateFsUsage(delta_size, 0, "symlink");
@@ -562,21 +566,17 @@ Status LocalMetaSystem::WriteSlice(ContextSPtr, Ino ino, uint64_t index,
 
 Status LocalMetaSystem::Write(ContextSPtr, Ino ino, const char* buf,
                               uint64_t offset, uint64_t size, uint64_t) {
-  const uint32_t fs_id = fs_info_.fs_id();
   const uint64_t now_ns = utils::TimestampNs();
 
   AttrEntry attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get inode
-    std::string value;
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_id, ino);
-    auto status = Get(inode_key, value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(value);
-
     if (attr_entry.length() < offset + size) {
       attr_entry.set_length(offset + size);
     }
@@ -584,15 +584,16 @@ Status LocalMetaSystem::Write(ContextSPtr, Ino ino, const char* buf,
     attr_entry.set_mtime(std::max(attr_entry.mtime(), now_ns));
     attr_entry.set_version(attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, inode_key,
-         MetaCodec::EncodeInodeValue(attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
 
   return Status::OK();
@@ -630,35 +631,30 @@ Status LocalMetaSystem::MkDir(ContextSPtr, Ino parent, const std::string& name,
   dentry_entry.set_type(pb::mds::FileType::DIRECTORY);
 
   AttrEntry parent_attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
-    std::string value;
-    std::string parent_inode_key = MetaCodec::EncodeInodeKey(fs_id, parent);
-    auto status = Get(parent_inode_key, value);
+    auto status = store_->GetInode(parent, parent_attr_entry);
     if (!status.ok()) return status;
-    CHECK(!value.empty()) << "not found parent inode.";
 
-    parent_attr_entry = MetaCodec::DecodeInodeValue(value);
     parent_attr_entry.set_nlink(parent_attr_entry.nlink() + 1);
     parent_attr_entry.set_ctime(std::max(parent_attr_entry.ctime(), now_ns));
     parent_attr_entry.set_mtime(std::max(parent_attr_entry.mtime(), now_ns));
     parent_attr_entry.set_version(parent_attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, MetaCodec::EncodeInodeKey(fs_id, ino),
-         MetaCodec::EncodeInodeValue(attr_entry)},
-        {KeyValue::OpType::kPut,
-         MetaCodec::EncodeDentryKey(fs_id, parent, name),
-         MetaCodec::EncodeDentryValue(dentry_entry)},
-        {KeyValue::OpType::kPut, parent_inode_key,
-         MetaCodec::EncodeInodeValue(parent_attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    batch.PutDentry(dentry_entry);
+    batch.PutInode(parent_attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
   PutInodeToCache(parent_attr_entry);
 
@@ -672,41 +668,33 @@ Status LocalMetaSystem::MkDir(ContextSPtr, Ino parent, const std::string& name,
 Status LocalMetaSystem::RmDir(ContextSPtr, Ino parent,
                               const std::string& name) {
   const uint64_t now_ns = utils::TimestampNs();
-  const uint32_t fs_id = fs_info_.fs_id();
 
   AttrEntry attr_entry;
   AttrEntry parent_attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get parent/name dentry
-    std::string value;
-    std::string dentry_key = MetaCodec::EncodeDentryKey(fs_id, parent, name);
-    auto status = Get(dentry_key, value);
+    DentryEntry dentry_entry;
+    auto status = store_->GetDentry(parent, name, dentry_entry);
     if (!status.ok()) return status;
 
-    auto dentry_entry = MetaCodec::DecodeDentryValue(value);
-
     // get parent/name inode
-    std::string inode_key =
-        MetaCodec::EncodeInodeKey(fs_id, dentry_entry.ino());
-    status = Get(inode_key, value);
+    status = store_->GetInode(dentry_entry.ino(), attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(value);
     CHECK(attr_entry.type() == pb::mds::FileType::DIRECTORY)
         << fmt::format("not directory type, ino({}).", attr_entry.ino());
 
     bool is_empty = false;
-    status = CheckDirEmpty(attr_entry.ino(), is_empty);
+    status = store_->CheckDirEmpty(attr_entry.ino(), is_empty);
     if (!status.ok()) return status;
     if (!is_empty) return Status::NotEmpty("directory not empty.");
 
     // get parent inode
-    std::string parent_inode_key = MetaCodec::EncodeInodeKey(fs_id, parent);
-    status = Get(parent_inode_key, value);
+    status = store_->GetInode(parent, parent_attr_entry);
     if (!status.ok()) return status;
-    parent_attr_entry = MetaCodec::DecodeInodeValue(value);
 
     // update parent inode
     parent_attr_entry.set_nlink(parent_attr_entry.nlink() - 1);
@@ -714,18 +702,18 @@ Status LocalMetaSystem::RmDir(ContextSPtr, Ino parent,
     parent_attr_entry.set_mtime(std::max(parent_attr_entry.mtime(), now_ns));
     parent_attr_entry.set_version(parent_attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kDelete, inode_key, ""},
-        {KeyValue::OpType::kDelete, dentry_key, ""},
-        {KeyValue::OpType::kPut, parent_inode_key,
-         MetaCodec::EncodeInodeValue(parent_attr_entry)},
-    };
-
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.DeleteInode(attr_entry.ino());
+    batch.DeleteDentry(parent, name);
+    batch.PutInode(parent_attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   DeleteInodeFromCache(attr_entry.ino());
   PutInodeToCache(parent_attr_entry);
 
@@ -737,7 +725,7 @@ Status LocalMetaSystem::RmDir(ContextSPtr, Ino parent,
 Status LocalMetaSystem::OpenDir(ContextSPtr, Ino ino, uint64_t fh,
                                 bool& need_cache) {
   std::vector<DentryEntry> dentries;
-  auto status = GetDentries(ino, dentries);
+  auto status = store_->GetDentries(ino, dentries);
   if (!status.ok()) return status;
 
   auto dir_iterator = DirIterator::New(ino, fh, std::move(dentries));
@@ -796,16 +784,14 @@ Status LocalMetaSystem::Link(ContextSPtr, Ino ino, Ino new_parent,
 
   AttrEntry attr_entry;
   AttrEntry parent_attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get inode
-    std::string value;
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_id, ino);
-    auto status = Get(inode_key, value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(value);
     CHECK(attr_entry.type() != pb::mds::FileType::DIRECTORY)
         << fmt::format("not file type, ino({}).", attr_entry.ino());
 
@@ -816,10 +802,8 @@ Status LocalMetaSystem::Link(ContextSPtr, Ino ino, Ino new_parent,
     attr_entry.set_version(attr_entry.version() + 1);
 
     // get parent inode
-    std::string parent_inode_key = MetaCodec::EncodeInodeKey(fs_id, new_parent);
-    status = Get(parent_inode_key, value);
+    status = store_->GetInode(new_parent, parent_attr_entry);
     if (!status.ok()) return status;
-    parent_attr_entry = MetaCodec::DecodeInodeValue(value);
 
     parent_attr_entry.set_ctime(std::max(parent_attr_entry.ctime(), now_ns));
     parent_attr_entry.set_mtime(std::max(parent_attr_entry.mtime(), now_ns));
@@ -834,20 +818,18 @@ Status LocalMetaSystem::Link(ContextSPtr, Ino ino, Ino new_parent,
     dentry_entry.set_flag(0);
     dentry_entry.set_type(pb::mds::FileType::FILE);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, inode_key,
-         MetaCodec::EncodeInodeValue(attr_entry)},
-        {KeyValue::OpType::kPut,
-         MetaCodec::EncodeDentryKey(fs_id, new_parent, new_name),
-         MetaCodec::EncodeDentryValue(dentry_entry)},
-        {KeyValue::OpType::kPut, parent_inode_key,
-         MetaCodec::EncodeInodeValue(parent_attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    batch.PutDentry(dentry_entry);
+    batch.PutInode(parent_attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
   PutInodeToCache(parent_attr_entry);
 
@@ -863,15 +845,13 @@ Status LocalMetaSystem::Unlink(ContextSPtr, Ino parent,
 
   AttrEntry attr_entry;
   AttrEntry parent_attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
-    // get parent inode key
-    std::string value;
-    std::string parent_inode_key = MetaCodec::EncodeInodeKey(fs_id, parent);
-    auto status = Get(parent_inode_key, value);
+    // get parent inode
+    auto status = store_->GetInode(parent, parent_attr_entry);
     if (!status.ok()) return status;
-    parent_attr_entry = MetaCodec::DecodeInodeValue(value);
 
     // update parent inode
     parent_attr_entry.set_ctime(std::max(parent_attr_entry.ctime(), now_ns));
@@ -879,19 +859,14 @@ Status LocalMetaSystem::Unlink(ContextSPtr, Ino parent,
     parent_attr_entry.set_version(parent_attr_entry.version() + 1);
 
     // get parent/name dentry
-    std::string dentry_key = MetaCodec::EncodeDentryKey(fs_id, parent, name);
-    status = Get(dentry_key, value);
+    DentryEntry dentry_entry;
+    status = store_->GetDentry(parent, name, dentry_entry);
     if (!status.ok()) return status;
 
-    auto dentry_entry = MetaCodec::DecodeDentryValue(value);
-
     // get parent/name inode
-    std::string inode_key =
-        MetaCodec::EncodeInodeKey(fs_id, dentry_entry.ino());
-    status = Get(inode_key, value);
+    status = store_->GetInode(dentry_entry.ino(), attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(value);
     CHECK(attr_entry.type() != pb::mds::FileType::DIRECTORY)
         << fmt::format("not file type, ino({}).", attr_entry.ino());
 
@@ -900,27 +875,27 @@ Status LocalMetaSystem::Unlink(ContextSPtr, Ino parent,
     DelParentIno(attr_entry, parent);
     attr_entry.set_version(attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs;
+    // write to store
+    MetaBatch batch;
     if (attr_entry.nlink() == 0) {
-      kvs.push_back({KeyValue::OpType::kDelete, inode_key, ""});
+      batch.DeleteInode(attr_entry.ino());
 
       // save delete file info
-      kvs.push_back({KeyValue::OpType::kPut,
-                     MetaCodec::EncodeDelFileKey(fs_id, dentry_entry.ino()),
-                     MetaCodec::EncodeDelFileValue(attr_entry)});
+      batch.Put(MetaCodec::EncodeDelFileKey(fs_id, dentry_entry.ino()),
+                MetaCodec::EncodeDelFileValue(attr_entry));
 
     } else {
-      kvs.push_back({KeyValue::OpType::kPut, inode_key,
-                     MetaCodec::EncodeInodeValue(attr_entry)});
+      batch.PutInode(attr_entry);
     }
-    kvs.push_back({KeyValue::OpType::kDelete, dentry_key, ""});
-    kvs.push_back({KeyValue::OpType::kPut, parent_inode_key,
-                   MetaCodec::EncodeInodeValue(parent_attr_entry)});
-    status = Put(kvs);
+    batch.DeleteDentry(parent, name);
+    batch.PutInode(parent_attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
   PutInodeToCache(parent_attr_entry);
 
@@ -963,35 +938,29 @@ Status LocalMetaSystem::Symlink(ContextSPtr, Ino parent,
   dentry_entry.set_type(pb::mds::FileType::SYM_LINK);
 
   AttrEntry parent_attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
-    std::string value;
-    const std::string parent_inode_key =
-        MetaCodec::EncodeInodeKey(fs_id, parent);
-    auto status = Get(parent_inode_key, value);
+    auto status = store_->GetInode(parent, parent_attr_entry);
     if (!status.ok()) return status;
-    CHECK(!value.empty()) << "not found parent inode.";
 
-    parent_attr_entry = MetaCodec::DecodeInodeValue(value);
     parent_attr_entry.set_ctime(std::max(parent_attr_entry.ctime(), now_ns));
     parent_attr_entry.set_mtime(std::max(parent_attr_entry.mtime(), now_ns));
     parent_attr_entry.set_version(parent_attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, MetaCodec::EncodeInodeKey(fs_id, ino),
-         MetaCodec::EncodeInodeValue(attr_entry)},
-        {KeyValue::OpType::kPut,
-         MetaCodec::EncodeDentryKey(fs_id, parent, name),
-         MetaCodec::EncodeDentryValue(dentry_entry)},
-        {KeyValue::OpType::kPut, parent_inode_key,
-         MetaCodec::EncodeInodeValue(parent_attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    batch.PutDentry(dentry_entry);
+    batch.PutInode(parent_attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
   PutInodeToCache(parent_attr_entry);
 
@@ -1031,20 +1000,15 @@ Status LocalMetaSystem::GetAttr(ContextSPtr, Ino ino, Attr* attr) {
 
 Status LocalMetaSystem::SetAttr(ContextSPtr, Ino ino, int to_set,
                                 const Attr& in_attr, Attr* out_attr) {
-  const uint32_t fs_id = fs_info_.fs_id();
-
   AttrEntry attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get inode
-    std::string value;
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_id, ino);
-    auto status = Get(inode_key, value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(value);
-
     if (to_set & kSetAttrMode) {
       attr_entry.set_mode(in_attr.mode);
     }
@@ -1087,15 +1051,16 @@ Status LocalMetaSystem::SetAttr(ContextSPtr, Ino ino, int to_set,
 
     attr_entry.set_version(attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, inode_key,
-         MetaCodec::EncodeInodeValue(attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
 
   *out_attr = meta::Helper::ToAttr(attr_entry);
@@ -1118,35 +1083,32 @@ Status LocalMetaSystem::GetXattr(ContextSPtr, Ino ino, const std::string& name,
 
 Status LocalMetaSystem::SetXattr(ContextSPtr, Ino ino, const std::string& name,
                                  const std::string& value, int) {
-  const uint32_t fs_id = fs_info_.fs_id();
   const uint64_t now_ns = utils::TimestampNs();
 
   AttrEntry attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get inode
-    std::string inode_value;
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_id, ino);
-    auto status = Get(inode_key, inode_value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(inode_value);
-
     (*attr_entry.mutable_xattrs())[name] = value;
     attr_entry.set_ctime(std::max(attr_entry.ctime(), now_ns));
     attr_entry.set_mtime(std::max(attr_entry.mtime(), now_ns));
     attr_entry.set_version(attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, inode_key,
-         MetaCodec::EncodeInodeValue(attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
 
   return Status::OK();
@@ -1154,35 +1116,32 @@ Status LocalMetaSystem::SetXattr(ContextSPtr, Ino ino, const std::string& name,
 
 Status LocalMetaSystem::RemoveXattr(ContextSPtr, Ino ino,
                                     const std::string& name) {
-  const uint32_t fs_id = fs_info_.fs_id();
   const uint64_t now_ns = utils::TimestampNs();
 
   AttrEntry attr_entry;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
     // get inode
-    std::string inode_key = MetaCodec::EncodeInodeKey(fs_id, ino);
-    std::string inode_value;
-    auto status = Get(inode_key, inode_value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok()) return status;
 
-    attr_entry = MetaCodec::DecodeInodeValue(inode_value);
-
     (*attr_entry.mutable_xattrs()).erase(name);
     attr_entry.set_ctime(std::max(attr_entry.ctime(), now_ns));
     attr_entry.set_mtime(std::max(attr_entry.mtime(), now_ns));
     attr_entry.set_version(attr_entry.version() + 1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, inode_key,
-         MetaCodec::EncodeInodeValue(attr_entry)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.PutInode(attr_entry);
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   PutInodeToCache(attr_entry);
 
   return Status::OK();
@@ -1219,65 +1178,46 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
   AttrEntry prev_new_attr_entry;
 
   bool is_exist_new_dentry = false;
+  uint64_t sequence = 0;
   {
     utils::WriteLockGuard lk(lock_);
 
-    std::vector<KeyValue> kvs;
+    MetaBatch batch;
 
     // get old_parent inode
-    std::string value;
-    std::string old_parent_inode_key =
-        MetaCodec::EncodeInodeKey(fs_id, old_parent);
-    auto status = Get(old_parent_inode_key, value);
+    auto status = store_->GetInode(old_parent, old_parent_attr_entry);
     if (!status.ok()) return status;
-    old_parent_attr_entry = MetaCodec::DecodeInodeValue(value);
 
     // get old_parent/name dentry
-    std::string old_dentry_key =
-        MetaCodec::EncodeDentryKey(fs_id, old_parent, old_name);
-    status = Get(old_dentry_key, value);
+    status = store_->GetDentry(old_parent, old_name, old_dentry);
     if (!status.ok()) return status;
-    old_dentry = MetaCodec::DecodeDentryValue(value);
 
     // get old_parent/name inode
-    std::string old_inode_key =
-        MetaCodec::EncodeInodeKey(fs_id, old_dentry.ino());
-    status = Get(old_inode_key, value);
+    status = store_->GetInode(old_dentry.ino(), old_attr_entry);
     if (!status.ok()) return status;
-    old_attr_entry = MetaCodec::DecodeInodeValue(value);
 
     // get new_parent inode
     if (is_same_parent) {
       new_parent_attr_entry = old_parent_attr_entry;
     } else {
-      std::string new_parent_inode_key =
-          MetaCodec::EncodeInodeKey(fs_id, new_parent);
-      status = Get(new_parent_inode_key, value);
+      status = store_->GetInode(new_parent, new_parent_attr_entry);
       if (!status.ok()) return status;
-      new_parent_attr_entry = MetaCodec::DecodeInodeValue(value);
     }
 
     // get new_parent/name dentry
-    std::string new_dentry_key =
-        MetaCodec::EncodeDentryKey(fs_id, new_parent, new_name);
-    status = Get(new_dentry_key, value);
-    if (status.ok()) {
-      prev_new_dentry = MetaCodec::DecodeDentryValue(value);
-    }
+    status = store_->GetDentry(new_parent, new_name, prev_new_dentry);
+    if (!status.ok() && !status.IsNotFound()) return status;
+
     is_exist_new_dentry = (prev_new_dentry.ino() != 0);
     if (is_exist_new_dentry) {
       // get pre new inode
-      std::string prev_new_inode_key =
-          MetaCodec::EncodeInodeKey(fs_id, prev_new_dentry.ino());
-      status = Get(prev_new_inode_key, value);
+      status = store_->GetInode(prev_new_dentry.ino(), prev_new_attr_entry);
       if (!status.ok()) return status;
 
-      prev_new_attr_entry = MetaCodec::DecodeInodeValue(value);
-
       if (prev_new_dentry.type() == pb::mds::DIRECTORY) {
         // check new dentry is empty
         bool is_empty = false;
-        status = CheckDirEmpty(prev_new_dentry.ino(), is_empty);
+        status = store_->CheckDirEmpty(prev_new_dentry.ino(), is_empty);
         if (!status.ok()) return status;
         if (!is_empty) {
           return Status::NotEmpty(fmt::format("new dentry({}/{}) is not empty.",
@@ -1285,10 +1225,7 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
         }
 
         // delete exist new inode
-        kvs.push_back({
-            KeyValue::OpType::kDelete,
-            prev_new_inode_key,
-        });
+        batch.DeleteInode(prev_new_dentry.ino());
 
       } else {
         // update exist new inode nlink
@@ -1300,30 +1237,22 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
         prev_new_attr_entry.set_version(prev_new_attr_entry.version() + 1);
         if (prev_new_attr_entry.nlink() <= 0) {
           // delete exist new inode
-          kvs.push_back({
-              KeyValue::OpType::kDelete,
-              prev_new_inode_key,
-          });
+          batch.DeleteInode(prev_new_dentry.ino());
 
           // save delete file info
-          kvs.push_back(
-              {KeyValue::OpType::kPut,
-               MetaCodec::EncodeDelFileKey(fs_id, prev_new_attr_entry.ino()),
-               MetaCodec::EncodeDelFileValue(prev_new_attr_entry)});
+          batch.Put(
+              MetaCodec::EncodeDelFileKey(fs_id, prev_new_attr_entry.ino()),
+              MetaCodec::EncodeDelFileValue(prev_new_attr_entry));
 
         } else {
           // update exist new inode attr
-          kvs.push_back({KeyValue::OpType::kPut, prev_new_inode_key,
-                         MetaCodec::EncodeInodeValue(prev_new_attr_entry)});
+          batch.PutInode(prev_new_attr_entry);
         }
       }
     }
 
     // delete old dentry
-    kvs.push_back({
-        KeyValue::OpType::kDelete,
-        old_dentry_key,
-    });
+    batch.DeleteDentry(old_parent, old_name);
 
     // add new dentry
     DentryEntry new_dentry;
@@ -1333,8 +1262,7 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
     new_dentry.set_type(old_dentry.type());
     new_dentry.set_parent(new_parent);
 
-    kvs.push_back({KeyValue::OpType::kPut, new_dentry_key,
-                   MetaCodec::EncodeDentryValue(new_dentry)});
+    batch.PutDentry(new_dentry);
 
     // update old inode attr
     old_attr_entry.set_ctime(std::max(old_attr_entry.ctime(), now_ns));
@@ -1344,8 +1272,7 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
     }
     old_attr_entry.set_version(old_attr_entry.version() + 1);
 
-    kvs.push_back({KeyValue::OpType::kPut, old_inode_key,
-                   MetaCodec::EncodeInodeValue(old_attr_entry)});
+    batch.PutInode(old_attr_entry);
 
     // update old parent inode attr
     old_parent_attr_entry.set_ctime(
@@ -1358,8 +1285,7 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
     }
     old_parent_attr_entry.set_version(old_parent_attr_entry.version() + 1);
 
-    kvs.push_back({KeyValue::OpType::kPut, old_parent_inode_key,
-                   MetaCodec::EncodeInodeValue(old_parent_attr_entry)});
+    batch.PutInode(old_parent_attr_entry);
 
     if (!is_same_parent) {
       // update new parent inode attr
@@ -1372,16 +1298,17 @@ Status LocalMetaSystem::Rename(ContextSPtr, Ino old_parent,
         new_parent_attr_entry.set_nlink(new_parent_attr_entry.nlink() + 1);
       new_parent_attr_entry.set_version(new_parent_attr_entry.version() + 1);
 
-      kvs.push_back({KeyValue::OpType::kPut,
-                     MetaCodec::EncodeInodeKey(fs_id, new_parent),
-                     MetaCodec::EncodeInodeValue(new_parent_attr_entry)});
+      batch.PutInode(new_parent_attr_entry);
     }
 
-    // write to leveldb
-    status = Put(kvs);
+    // write to store
+    status = store_->Write(batch, sequence);
     if (!status.ok()) return status;
   }
 
+  auto status = store_->Sync(sequence);
+  if (!status.ok()) return status;
+
   // update inode cache
   PutInodeToCache(old_parent_attr_entry);
   if (!is_same_parent) PutInodeToCache(new_parent_attr_entry);
@@ -1483,6 +1410,18 @@ bool LocalMetaSystem::GetDescription(Json::Value& value) {
   return true;
 }
 
+bool LocalMetaSystem::GetSummary(Json::Value& value) {
+  CHECK(value.isArray()) << "value is not array.";
+
+  if (store_ != nullptr) {
+    Json::Value store_value = Json::objectValue;
+    store_->Summary(store_value);
+    value.append(store_value);
+  }
+
+  return true;
+}
+
 void LocalMetaSystem::SetFsStorageInfo(mds::FsInfoEntry& fs_info,
                                        const std::string& storage_info) {
   LOG(INFO) << "generate storage info from: " << storage_info;
@@ -1587,7 +1526,7 @@ mds::FsInfoEntry LocalMetaSystem::GenFsInfo() {
 
 Status LocalMetaSystem::InitFsInfo() {
   std::string value;
-  auto status = Get(MetaCodec::EncodeFsKey(fs_name_), value);
+  auto status = store_->Get(MetaCodec::EncodeFsKey(fs_name_), value);
   if (!status.ok() && !status.IsNotFound()) {
     return status;
   }
@@ -1600,13 +1539,12 @@ Status LocalMetaSystem::InitFsInfo() {
   // not found, create new fs_info
   fs_info_ = GenFsInfo();
 
-  // write to leveldb
-  std::vector<KeyValue> kvs = {
-      {KeyValue::OpType::kPut, MetaCodec::EncodeFsKey(fs_name_),
-       MetaCodec::EncodeFsValue(fs_info_)},
-  };
+  // write to store
+  MetaBatch batch;
+  batch.Put(MetaCodec::EncodeFsKey(fs_name_),
+            MetaCodec::EncodeFsValue(fs_info_));
 
-  status = Put(kvs);
+  status = store_->WriteAndSync(batch);
   if (!status.ok()) return status;
 
   return Status::OK();
@@ -1614,7 +1552,8 @@ Status LocalMetaSystem::InitFsInfo() {
 
 Status LocalMetaSystem::InitFsQuota() {
   std::string value;
-  auto status = Get(MetaCodec::EncodeFsQuotaKey(fs_info_.fs_id()), value);
+  auto status =
+      store_->Get(MetaCodec::EncodeFsQuotaKey(fs_info_.fs_id()), value);
   if (!status.ok() && !status.IsNotFound()) return status;
   if (status.ok()) {
     fs_quota_ = MetaCodec::DecodeFsQuotaValue(value);
@@ -1625,12 +1564,11 @@ Status LocalMetaSystem::InitFsQuota() {
     fs_quota_.set_used_bytes(0);
     fs_quota_.set_used_inodes(1);
 
-    // write to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kPut, MetaCodec::EncodeFsQuotaKey(fs_info_.fs_id()),
-         MetaCodec::EncodeFsQuotaValue(fs_quota_)},
-    };
-    status = Put(kvs);
+    // write to store
+    MetaBatch batch;
+    batch.Put(MetaCodec::EncodeFsQuotaKey(fs_info_.fs_id()),
+              MetaCodec::EncodeFsQuotaValue(fs_quota_));
+    status = store_->WriteAndSync(batch);
     if (!status.ok()) return status;
   }
 
@@ -1670,15 +1608,11 @@ Status LocalMetaSystem::InitRoot() {
   auto status = GetAttrEntry(kRootIno, old_attr_entry);
   if (status.ok()) return Status::OK();
 
-  // write to leveldb
-  std::vector<KeyValue> kvs = {
-      {KeyValue::OpType::kPut, MetaCodec::EncodeInodeKey(fs_id, kRootIno),
-       MetaCodec::EncodeInodeValue(attr_entry)},
-      {KeyValue::OpType::kPut,
-       MetaCodec::EncodeDentryKey(fs_id, kRootParentIno, "/"),
-       MetaCodec::EncodeDentryValue(dentry_entry)},
-  };
-  status = Put(kvs);
+  // write to store
+  MetaBatch batch;
+  batch.PutInode(attr_entry);
+  batch.PutDentry(dentry_entry);
+  status = store_->WriteAndSync(batch);
   if (!status.ok()) return status;
 
   PutInodeToCache(attr_entry);
@@ -1687,7 +1621,7 @@ Status LocalMetaSystem::InitRoot() {
 }
 
 bool LocalMetaSystem::InitIdGenerators() {
-  CHECK(db_ != nullptr) << "leveldb is null.";
+  CHECK(store_ != nullptr) << "meta store is null.";
 
   static const std::string kInoIdGeneratorName = "InoGenerator";
   static const int64_t kInoStartId = 100000000;
@@ -1697,15 +1631,16 @@ bool LocalMetaSystem::InitIdGenerators() {
   static const int64_t kSliceIdStartId = 100000000;
   static const int kSliceIdBatchSize = 1000;
 
-  ino_generator_ = LevelIdGenerator::New(db_, kInoIdGeneratorName, kInoStartId,
-                                         kInoIdBatchSize);
+  ino_generator_ = StoreIdGenerator::New(store_.get(), kInoIdGeneratorName,
+                                         kInoStartId, kInoIdBatchSize);
   if (!ino_generator_->Init()) {
     LOG(ERROR) << "init ino generator fail.";
     return false;
   }
 
-  slice_id_generator_ = LevelIdGenerator::New(
-      db_, kSliceIdGeneratorName, kSliceIdStartId, kSliceIdBatchSize);
+  slice_id_generator_ =
+      StoreIdGenerator::New(store_.get(), kSliceIdGeneratorName,
+                            kSliceIdStartId, kSliceIdBatchSize);
   if (!slice_id_generator_->Init()) {
     LOG(ERROR) << "init slice id generator fail.";
     return false;
@@ -1754,72 +1689,10 @@ Status LocalMetaSystem::GetAttrEntry(Ino ino, AttrEntry& attr_entry) {
   {
     utils::ReadLockGuard lk(lock_);
 
-    std::string value;
-    auto status = Get(MetaCodec::EncodeInodeKey(fs_info_.fs_id(), ino), value);
+    auto status = store_->GetInode(ino, attr_entry);
     if (!status.ok()) return status;
-
-    attr_entry = MetaCodec::DecodeInodeValue(value);
-  }
-
-  return Status::OK();
-}
-
-Status LocalMetaSystem::GetDentries(Ino parent,
-                                    std::vector<DentryEntry>& dentries) {
-  auto* iter = db_->NewIterator(leveldb::ReadOptions());
-
-  iter->Seek(MetaCodec::EncodeInodeKey(fs_info_.fs_id(), parent));
-  if (iter->Valid()) {
-    CHECK(MetaCodec::IsInodeKey(iter->key().ToString())) << "not inode key.";
-    iter->Next();  // skip inode key
-  }
-
-  while (iter->Valid()) {
-    if (!MetaCodec::IsDentryKey(iter->key().ToString())) {
-      break;
-    }
-
-    dentries.push_back(MetaCodec::DecodeDentryValue(iter->value().ToString()));
-
-    iter->Next();
-  }
-
-  delete iter;
-
-  return Status::OK();
-}
-
-Status LocalMetaSystem::CheckDirEmpty(Ino ino, bool& is_empty) {
-  auto* iter = db_->NewIterator(leveldb::ReadOptions());
-  iter->Seek(MetaCodec::EncodeInodeKey(fs_info_.fs_id(), ino));
-
-  if (!iter->Valid() || !MetaCodec::IsInodeKey(iter->key().ToString())) {
-    LOG(ERROR) << fmt::format("[meta.fs] check dir empty, not found inode {}.",
-                              ino);
-    delete iter;
-    return Status::NotFound("not found inode.");
-  }
-
-  uint32_t fs_id;
-  Ino temp_ino;
-  MetaCodec::DecodeInodeKey(iter->key().ToString(), fs_id, temp_ino);
-  if (temp_ino != ino) {
-    LOG(ERROR) << fmt::format("[meta.fs] decode ino not match, {}!={}.",
-                              temp_ino, ino);
-    delete iter;
-    return Status::NotFound("not found inode.");
-  }
-
-  iter->Next();  // skip inode key
-
-  if (iter->Valid() && MetaCodec::IsDentryKey(iter->key().ToString())) {
-    is_empty = false;
-  } else {
-    is_empty = true;
   }
 
-  delete iter;
-
   return Status::OK();
 }
 
@@ -1827,34 +1700,29 @@ Status LocalMetaSystem::CleanChunk(Ino ino) {
   const uint32_t fs_id = fs_info_.fs_id();
 
   // scan chunk keys
-  std::vector<KeyValue> delete_kvs;
-  auto* iter = db_->NewIterator(leveldb::ReadOptions());
-  iter->Seek(MetaCodec::EncodeChunkKey(fs_id, ino, 0));
-
-  while (iter->Valid()) {
-    if (!MetaCodec::IsChunkKey(iter->key().ToString())) break;
-
-    uint32_t temp_fs_id;
-    Ino temp_ino;
-    uint64_t chunk_index;
-    MetaCodec::DecodeChunkKey(iter->key().ToString(), temp_fs_id, temp_ino,
-                              chunk_index);
-    if (temp_ino != ino) break;
-
-    delete_kvs.push_back({KeyValue::OpType::kDelete, iter->key().ToString()});
-
-    iter->Next();
-  }
+  MetaBatch batch;
+  auto status = store_->Scan(
+      MetaCodec::EncodeChunkKey(fs_id, ino, 0),
+      [&](const std::string& key, const std::string&) -> bool {
+        if (!MetaCodec::IsChunkKey(key)) return false;
+
+        uint32_t temp_fs_id;
+        Ino temp_ino;
+        uint64_t chunk_index;
+        MetaCodec::DecodeChunkKey(key, temp_fs_id, temp_ino, chunk_index);
+        if (temp_ino != ino) return false;
+
+        batch.Delete(key);
+        return true;
+      });
 
-  // write delete chunk keys to leveldb
-  auto status = Put(delete_kvs);
+  // write delete chunk keys to store
+  if (status.ok() && !batch.Empty()) status = store_->WriteAndSync(batch);
   if (!status.ok()) {
     LOG(ERROR) << fmt::format("[meta.fs] clean chunk fail, ino({}), {}.", ino,
                               status.ToString());
   }
 
-  delete iter;
-
   return status;
 }
 
@@ -1872,17 +1740,15 @@ Status LocalMetaSystem::DoCleanDelfile() {
 
   // scan del file keys
   std::vector<std::string> keys;
-  auto* iter = db_->NewIterator(leveldb::ReadOptions());
-  iter->Seek(MetaCodec::EncodeDelFileKey(fs_id, 0));
+  auto status = store_->Scan(
+      MetaCodec::EncodeDelFileKey(fs_id, 0),
+      [&keys](const std::string& key, const std::string&) -> bool {
+        if (!MetaCodec::IsDelFileKey(key)) return false;
 
-  while (iter->Valid()) {
-    if (!MetaCodec::IsDelFileKey(iter->key().ToString())) break;
-
-    keys.push_back(iter->key().ToString());
-
-    iter->Next();
-  }
-  delete iter;
+        keys.push_back(key);
+        return true;
+      });
+  if (!status.ok()) return status;
 
   LOG(INFO) << fmt::format("[meta.fs] start clean del file, count({}).",
                            keys.size());
@@ -1896,11 +1762,10 @@ Status LocalMetaSystem::DoCleanDelfile() {
     auto status = CleanChunk(ino);
     if (!status.ok()) continue;
 
-    // write delete del file key to leveldb
-    std::vector<KeyValue> kvs = {
-        {KeyValue::OpType::kDelete, key},
-    };
-    status = Put(kvs);
+    // write delete del file key to store
+    MetaBatch batch;
+    batch.Delete(key);
+    status = store_->WriteAndSync(batch);
     if (!status.ok()) {
       LOG(ERROR) << fmt::format(
           "[meta.fs] clean del file key fail, ino({}), {}.", ino,
@@ -1930,12 +1795,11 @@ void LocalMetaSystem::UpdateFsUsage(int64_t byte_delta, int64_t inode_delta,
   fs_quota_.set_used_bytes(fs_quota_.used_bytes() + byte_delta);
   fs_quota_.set_used_inodes(fs_quota_.used_inodes() + inode_delta);
 
-  // write to leveldb
-  std::vector<KeyValue> kvs = {
-      {KeyValue::OpType::kPut, MetaCodec::EncodeFsQuotaKey(fs_info_.fs_id()),
-       MetaCodec::EncodeFsQuotaValue(fs_quota_)},
-  };
-  auto status = Put(kvs);
+  // write to store
+  MetaBatch batch;
+  batch.Put(MetaCodec::EncodeFsQuotaKey(fs_info_.fs_id()),
+            MetaCodec::EncodeFsQuotaValue(fs_quota_));
+  auto status = store_->WriteAndSync(batch);
   if (!status.ok()) {
     LOG(ERROR) << fmt::format(
         "[meta.fs] update fs quota fail, reason({}), byte_delta({}), "
@@ -1950,54 +1814,6 @@ mds::QuotaEntry LocalMetaSystem::GetFsQuota() {
   return fs_quota_;
 }
 
-bool LocalMetaSystem::OpenLevelDB(const std::string& db_path) {
-  leveldb::Options options;
-  options.create_if_missing = true;
-  leveldb::Status status = leveldb::DB::Open(options, db_path, &db_);
-  if (!status.ok()) {
-    LOG(ERROR) << fmt::format("[local] init leveldb fail, {} {}.", db_path,
-                              status.ToString());
-    return false;
-  }
-
-  return true;
-}
-
-void LocalMetaSystem::CloseLevelDB() {
-  LOG(INFO) << "[meta.fs] close leveldb.";
-  delete db_;
-  db_ = nullptr;
-}
-
-Status LocalMetaSystem::Get(const std::string& key, std::string& value) {
-  auto status = db_->Get(leveldb::ReadOptions(), key, &value);
-  if (!status.ok()) {
-    if (status.IsNotFound()) return Status::NotFound("not found");
-    return Status::IoError(fmt::format("get fail, {}.", status.ToString()));
-  }
-
-  return Status::OK();
-}
-
-Status LocalMetaSystem::Put(std::vector<KeyValue>& kvs) {
-  leveldb::WriteBatch batch;
-
-  for (const auto& kv : kvs) {
-    if (kv.opt_type == KeyValue::OpType::kPut) {
-      batch.Put(kv.key, kv.value);
-    } else if (kv.opt_type == KeyValue::OpType::kDelete) {
-      batch.Delete(kv.key);
-    }
-  }
-
-  auto status = db_->Write(leveldb::WriteOptions(), &batch);
-  if (!status.ok()) {
-    return Status::IoError(fmt::format("put fail, {}.", status.ToString()));
-  }
-
-  return Status::OK();
-}
-
 }  // namespace local
 }  // namespace vfs
 }  // namespace client
@@ -24,13 +24,13 @@
 #include "bthread/types.h"
 #include "client/vfs/metasystem/local/dir_iterator.h"
 #include "client/vfs/metasystem/local/id_generator.h"
+#include "client/vfs/metasystem/local/meta_store.h"
 #include "client/vfs/metasystem/mds/inode_cache.h"
 #include "client/vfs/metasystem/meta_system.h"
 #include "client/vfs/vfs_meta.h"
 #include "common/trace/context.h"
 #include "dingofs/mds.pb.h"
 #include "json/value.h"
-#include "leveldb/db.h"
 #include "mds/common/crontab.h"
 #include "mds/common/type.h"
 
@@ -39,28 +39,6 @@ namespace client {
 namespace vfs {
 namespace local {
 
-struct KeyValue {
-  enum class OpType : uint8_t {
-    kPut = 0,
-    kDelete = 1,
-  };
-
-  static std::string OpTypeName(OpType op_type) {
-    switch (op_type) {
-      case OpType::kPut:
-        return "Put";
-      case OpType::kDelete:
-        return "Delete";
-      default:
-        return "Unknown";
-    }
-  }
-
-  OpType opt_type{OpType::kPut};
-  std::string key;
-  std::string value;
-};
-
 // for open file
 class OpenFileMemo {
  public:
@@ -181,7 +159,7 @@ class LocalMetaSystem : public vfs::MetaSystem {
   Status GetFsInfo(ContextSPtr ctx, FsInfo* fs_info) override;
 
   bool GetDescription(Json::Value& value) override;
-  bool GetSummary(Json::Value&) override { return true; }
+  bool GetSummary(Json::Value& value) override;
 
  private:
   void SetFsStorageInfo(mds::FsInfoEntry& fs_info,
@@ -200,11 +178,8 @@ class LocalMetaSystem : public vfs::MetaSystem {
   Ino GenDirIno();
   Ino GenFileIno();
 
-  // prior to get inode from cache, fetch from leveldb if not exist
+  // prior to get inode from cache, fetch from store if not exist
   Status GetAttrEntry(Ino ino, mds::AttrEntry& attr_entry);
-  Status GetDentries(Ino parent, std::vector<mds::DentryEntry>& dentries);
-
-  Status CheckDirEmpty(Ino ino, bool& is_empty);
 
   Status CleanChunk(Ino ino);
   void CleanDelfile();
@@ -220,13 +195,6 @@ class LocalMetaSystem : public vfs::MetaSystem {
                      const std::string& reason);
   mds::QuotaEntry GetFsQuota();
 
-  // leveldb operations
-  bool OpenLevelDB(const std::string& db_path);
-  void CloseLevelDB();
-
-  Status Get(const std::string& key, std::string& value);
-  Status Put(std::vector<KeyValue>& kvs);
-
   const std::string fs_name_;
   const std::string db_path_;
   const std::string storage_info_;
@@ -253,9 +221,10 @@ class LocalMetaSystem : public vfs::MetaSystem {
   // This is manage crontab, like heartbeat.
   mds::CrontabManager crontab_manager_;
 
+  // serialize read-modify-write of meta
   utils::RWLock lock_;
-  // for store data
-  leveldb::DB* db_{nullptr};
+  // for store data, leveldb or compact engine
+  MetaStoreUPtr store_;
 };
 
 }  // namespace local
@@ -0,0 +1,186 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "client/vfs/metasystem/mds/attr_lease.h"
+
+#include "common/const.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// keep recall time for a while to discard raced lease
+static const uint64_t kKeepRecallTimeNs = 60ULL * 1000 * 1000 * 1000;
+
+void AttrLeaseCache::Put(Ino ino, const pb::mds::AttrLease& lease,
+                         uint64_t request_time_ns) {
+  if (lease.type() == pb::mds::ATTR_LEASE_NONE || lease.lease_ms() == 0) {
+    return;
+  }
+
+  const uint64_t expire_time_ns = request_time_ns + lease.lease_ms() * 1000000;
+  shard_map_.withWLock(
+      [ino, &lease, expire_time_ns, request_time_ns](Map& map) mutable {
+        auto& entry = map[ino];
+        // recalled after send request, lease maybe revoked
+        if (entry.recall_time_ns >= request_time_ns) return;
+
+        entry.type = lease.type();
+        entry.expire_time_ns = expire_time_ns;
+      },
+      ino);
+}
+
+void AttrLeaseCache::Delete(Ino ino) {
+  shard_map_.withWLock([ino](Map& map) mutable { map.erase(ino); }, ino);
+}
+
+bool AttrLeaseCache::Check(Ino ino) {
+  bool valid = false;
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.withRLock(
+      [ino, &valid, now_ns](Map& map) {
+        auto it = map.find(ino);
+        if (it != map.end()) {
+          valid = it->second.type != pb::mds::ATTR_LEASE_NONE &&
+                  it->second.expire_time_ns > now_ns;
+        }
+      },
+      ino);
+
+  if (valid) {
+    hit_count_ << 1;
+  } else {
+    miss_count_ << 1;
+  }
+
+  return valid;
+}
+
+bool AttrLeaseCache::SetDirty(Ino ino, const DirtyAttr& dirty_attr) {
+  bool ok = false;
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.withWLock(
+      [ino, &dirty_attr, &ok, now_ns](Map& map) mutable {
+        auto it = map.find(ino);
+        if (it == map.end()) return;
+
+        auto& entry = it->second;
+        if (entry.type != pb::mds::ATTR_LEASE_WRITE ||
+            entry.expire_time_ns <= now_ns) {
+          return;
+        }
+
+        auto& dirty = entry.dirty_attr;
+        if (dirty_attr.to_set & kSetAttrAtime) dirty.atime = dirty_attr.atime;
+        if (dirty_attr.to_set & kSetAttrMtime) dirty.mtime = dirty_attr.mtime;
+        if (dirty_attr.to_set & kSetAttrCtime) dirty.ctime = dirty_attr.ctime;
+        dirty.to_set |= dirty_attr.to_set;
+
+        ok = true;
+      },
+      ino);
+
+  return ok;
+}
+
+bool AttrLeaseCache::TakeDirty(Ino ino, DirtyAttr& dirty_attr) {
+  bool has_dirty = false;
+  shard_map_.withWLock(
+      [ino, &dirty_attr, &has_dirty](Map& map) mutable {
+        auto it = map.find(ino);
+        if (it == map.end() || it->second.dirty_attr.to_set == 0) return;
+
+        dirty_attr = it->second.dirty_attr;
+        it->second.dirty_attr = DirtyAttr{};
+        has_dirty = true;
+      },
+      ino);
+
+  return has_dirty;
+}
+
+void AttrLeaseCache::Recall(Ino ino) {
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.withWLock(
+      [ino, now_ns](Map& map) mutable {
+        auto& entry = map[ino];
+        entry.type = pb::mds::ATTR_LEASE_NONE;
+        entry.expire_time_ns = 0;
+        entry.recall_time_ns = now_ns;
+      },
+      ino);
+
+  recall_count_ << 1;
+}
+
+std::vector<Ino> AttrLeaseCache::GetDirtyExpiring(uint64_t expire_time_ns) {
+  std::vector<Ino> inos;
+  shard_map_.iterate([&inos, expire_time_ns](Map& map) {
+    for (const auto& [ino, entry] : map) {
+      if (entry.dirty_attr.to_set != 0 &&
+          entry.expire_time_ns <= expire_time_ns) {
+        inos.push_back(ino);
+      }
+    }
+  });
+
+  return inos;
+}
+
+void AttrLeaseCache::CleanExpired() {
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.iterateWLock([now_ns](Map& map) {
+    for (auto it = map.begin(); it != map.end();) {
+      const auto& entry = it->second;
+      if (entry.expire_time_ns < now_ns && entry.dirty_attr.to_set == 0 &&
+          entry.recall_time_ns + kKeepRecallTimeNs < now_ns) {
+        auto temp_it = it++;
+        map.erase(temp_it);
+      } else {
+        ++it;
+      }
+    }
+  });
+}
+
+size_t AttrLeaseCache::Size() {
+  size_t size = 0;
+  shard_map_.iterate([&size](Map& map) { size += map.size(); });
+  return size;
+}
+
+void AttrLeaseCache::Summary(Json::Value& value) {
+  const uint64_t hit_count = hit_count_.get_value();
+  const uint64_t miss_count = miss_count_.get_value();
+
+  value["name"] = "attrlease";
+  value["count"] = Size();
+  value["hit_count"] = hit_count;
+  value["miss_count"] = miss_count;
+  value["hit_ratio"] =
+      (hit_count + miss_count) == 0
+          ? 0.0
+          : static_cast<double>(hit_count) / (hit_count + miss_count);
+  value["recall_count"] = recall_count_.get_value();
+  value["recall_latency_us"] = recall_latency_.latency();
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
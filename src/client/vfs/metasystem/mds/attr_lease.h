@@ -0,0 +1,103 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_MDS_ATTR_LEASE_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_MDS_ATTR_LEASE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
+#include "client/vfs/vfs_meta.h"
+#include "dingofs/mds.pb.h"
+#include "json/value.h"
+#include "utils/shards.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// attr lease granted by mds, read lease allow serve getattr from inode
+// cache, write lease additionally allow update time attr locally, the
+// dirty attr is written back when lease is recalled or about to expire.
+class AttrLeaseCache {
+ public:
+  AttrLeaseCache() = default;
+  ~AttrLeaseCache() = default;
+
+  struct DirtyAttr {
+    uint32_t to_set{0};
+    uint64_t atime{0};
+    uint64_t mtime{0};
+    uint64_t ctime{0};
+  };
+
+  // request_time_ns is the time send request, used to discard lease which is
+  // raced with recall.
+  void Put(Ino ino, const pb::mds::AttrLease& lease, uint64_t request_time_ns);
+  void Delete(Ino ino);
+
+  // whether hold valid lease, count hit ratio
+  bool Check(Ino ino);
+
+  // record dirty time attr, return false if not hold write lease
+  bool SetDirty(Ino ino, const DirtyAttr& dirty_attr);
+  bool TakeDirty(Ino ino, DirtyAttr& dirty_attr);
+
+  // drop lease, dirty attr should be taken before
+  void Recall(Ino ino);
+  void ObserveRecallLatency(uint64_t latency_us) {
+    recall_latency_ << latency_us;
+  }
+
+  // dirty inode whose lease expire before the time
+  std::vector<Ino> GetDirtyExpiring(uint64_t expire_time_ns);
+
+  void CleanExpired();
+
+  size_t Size();
+
+  void Summary(Json::Value& value);
+
+ private:
+  struct Lease {
+    pb::mds::AttrLeaseType type{pb::mds::ATTR_LEASE_NONE};
+    uint64_t expire_time_ns{0};
+    uint64_t recall_time_ns{0};
+    DirtyAttr dirty_attr;
+  };
+
+  using Map = absl::flat_hash_map<Ino, Lease>;
+
+  constexpr static size_t kShardNum = 32;
+  utils::Shards<Map, kShardNum> shard_map_;
+
+  // metric
+  bvar::Adder<uint64_t> hit_count_{"meta_attr_lease_hit_count"};
+  bvar::Adder<uint64_t> miss_count_{"meta_attr_lease_miss_count"};
+  bvar::Adder<uint64_t> recall_count_{"meta_attr_lease_recall_count"};
+  bvar::LatencyRecorder recall_latency_{"meta_attr_lease_recall"};
+};
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_MDS_ATTR_LEASE_H_
@@ -17,8 +17,19 @@
 #include <bthread/types.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
 
+#include "absl/container/flat_hash_map.h"
+#include "bthread/countdown_event.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/recorder.h"
+#include "bvar/reducer.h"
+#include "bvar/status.h"
+#include "common/options/client.h"
+
 namespace dingofs {
 namespace client {
 namespace vfs {
@@ -26,6 +37,17 @@ namespace meta {
 
 static const uint32_t kBatchOperationReserveSize = 256;
 
+// latency from write slice operation enqueue to commit done
+static bvar::LatencyRecorder meta_write_slice_latency("meta_write_slice");
+// inodes committed by one group commit rpc
+static bvar::IntRecorder meta_group_commit_inodes("meta_group_commit_inodes");
+static bvar::Status<uint32_t> meta_group_commit_window_us(
+    "meta_group_commit_window_us", 0);
+// inodes fetched by one batch getattr rpc
+static bvar::IntRecorder meta_batch_read_inodes("meta_batch_read_inodes");
+// lookups shared the rpc of the same name lookup
+static bvar::Adder<uint64_t> meta_lookup_coalesced("meta_lookup_coalesced");
+
 void WriteSliceOperation::BatchRun(MDSClient& mds_client,
                                    BatchOperation& batch_operation) {
   const Ino ino = batch_operation.ino;
@@ -68,6 +90,60 @@ void WriteSliceOperation::BatchRun(MDSClient& mds_client,
 
   for (auto& operation : operations) {
     operation->Done(status, out_chunks);
+    meta_write_slice_latency
+        << (utils::TimestampNs() - operation->GetTime()) / 1000;
+  }
+}
+
+void WriteSliceOperation::GroupRun(
+    MDSClient& mds_client, std::vector<BatchOperation>& batch_operations) {
+  CHECK(batch_operations.size() > 1) << "group commit need multiple inodes.";
+
+  // prepare params, one param per inode which keeps inode commit order
+  std::vector<MDSClient::WriteSliceParam> params;
+  params.reserve(batch_operations.size());
+  for (auto& batch_operation : batch_operations) {
+    MDSClient::WriteSliceParam param;
+    param.ino = batch_operation.ino;
+    for (auto& operation : batch_operation.operations) {
+      std::dynamic_pointer_cast<WriteSliceOperation>(operation)->PreHandle(
+          param.delta_slices);
+    }
+
+    params.push_back(std::move(param));
+  }
+
+  auto ctx = batch_operations[0].operations[0]->GetContext();
+  if (ctx == nullptr) ctx = std::make_shared<Context>("");
+  auto status = mds_client.BatchWriteSlice(ctx, params);
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format(
+        "[meta.batch_processor] group commit fail, inodes({}) error({}), "
+        "fallback to commit one by one.",
+        batch_operations.size(), status.ToString());
+
+    for (auto& batch_operation : batch_operations) {
+      BatchRun(mds_client, batch_operation);
+    }
+    return;
+  }
+
+  meta_group_commit_inodes << batch_operations.size();
+
+  for (size_t i = 0; i < batch_operations.size(); ++i) {
+    auto& param = params[i];
+    if (!param.status.ok()) {
+      LOG(ERROR) << fmt::format(
+          "[meta.batch_processor.{}] group writeslice fail, error({}).",
+          param.ino, param.status.ToString());
+    }
+
+    for (auto& operation : batch_operations[i].operations) {
+      std::dynamic_pointer_cast<WriteSliceOperation>(operation)->Done(
+          param.status, param.out_chunks);
+      meta_write_slice_latency
+          << (utils::TimestampNs() - operation->GetTime()) / 1000;
+    }
   }
 }
 
@@ -247,6 +323,159 @@ void UnlinkOperation::BatchRun(MDSClient& mds_client,
   for (auto& operation : operations) operation->NotifyEvent();
 }
 
+void GetAttrOperation::GroupRun(MDSClient& mds_client,
+                                std::vector<OperationSPtr>& operations) {
+  CHECK(!operations.empty()) << "getattr operations is empty.";
+
+  // dedup ino, many threads stat the same file at the same time
+  std::vector<Ino> inos;
+  absl::flat_hash_map<Ino, std::vector<GetAttrOperationSPtr>> ino_operations;
+  for (auto& operation : operations) {
+    auto getattr_operation =
+        std::dynamic_pointer_cast<GetAttrOperation>(operation);
+    auto& same_ino_operations = ino_operations[getattr_operation->ino];
+    if (same_ino_operations.empty()) inos.push_back(getattr_operation->ino);
+    same_ino_operations.push_back(getattr_operation);
+  }
+
+  auto ctx = operations[0]->GetContext();
+  if (ctx == nullptr) ctx = std::make_shared<Context>("");
+
+  std::vector<AttrEntry> attr_entries;
+  std::vector<pb::mds::AttrLease> attr_leases;
+  Status status;
+  if (inos.size() == 1) {
+    AttrEntry attr_entry;
+    pb::mds::AttrLease attr_lease;
+    status = mds_client.GetAttr(ctx, inos[0], attr_entry, &attr_lease);
+    if (status.ok()) {
+      attr_entries.push_back(std::move(attr_entry));
+      attr_leases.push_back(std::move(attr_lease));
+    }
+
+  } else {
+    status = mds_client.BatchGetAttr(ctx, inos, attr_entries, attr_leases);
+    meta_batch_read_inodes << inos.size();
+  }
+
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format(
+        "[meta.batch_processor] batch getattr fail, inodes({}) error({}).",
+        inos.size(), status.ToString());
+
+    for (auto& operation : operations) {
+      operation->SetStatus(status);
+      operation->NotifyEvent();
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < attr_entries.size(); ++i) {
+    auto it = ino_operations.find(attr_entries[i].ino());
+    if (it == ino_operations.end()) continue;
+
+    for (auto& operation : it->second) {
+      operation->SetResult(attr_entries[i], attr_leases[i]);
+      operation->NotifyEvent();
+    }
+    ino_operations.erase(it);
+  }
+
+  // not returned by mds means the inode has gone
+  for (auto& [ino, same_ino_operations] : ino_operations) {
+    for (auto& operation : same_ino_operations) {
+      operation->SetStatus(Status::NotExist("not found inode"));
+      operation->NotifyEvent();
+    }
+  }
+}
+
+void LookupOperation::BatchRun(MDSClient& mds_client,
+                               BatchOperation& batch_operation) {
+  const Ino parent = batch_operation.ino;
+
+  CHECK(batch_operation.type == Operation::OpType::kLookup) << fmt::format(
+      "not match batch_operation type({}), ino({}) expect lookup.",
+      static_cast<uint32_t>(batch_operation.type), parent);
+
+  // group by name, keep first seen order
+  std::vector<std::vector<LookupOperationSPtr>> name_operations;
+  absl::flat_hash_map<std::string, size_t> name_index;
+  for (auto& operation : batch_operation.operations) {
+    auto lookup_operation =
+        std::dynamic_pointer_cast<LookupOperation>(operation);
+    auto [it, inserted] =
+        name_index.try_emplace(lookup_operation->name, name_operations.size());
+    if (inserted) name_operations.emplace_back();
+    name_operations[it->second].push_back(lookup_operation);
+  }
+
+  meta_lookup_coalesced
+      << (batch_operation.operations.size() - name_operations.size());
+
+  auto lookup_func = [&mds_client,
+                      parent](std::vector<LookupOperationSPtr>& operations) {
+    auto ctx = operations[0]->GetContext();
+    if (ctx == nullptr) ctx = std::make_shared<Context>("");
+
+    AttrEntry attr_entry;
+    uint64_t dentry_lease_ms = 0;
+    auto status = mds_client.Lookup(ctx, parent, operations[0]->name,
+                                    attr_entry, &dentry_lease_ms);
+    for (auto& operation : operations) {
+      if (status.ok()) {
+        operation->SetResult(attr_entry, dentry_lease_ms);
+      } else {
+        operation->SetStatus(status);
+      }
+      operation->NotifyEvent();
+    }
+  };
+
+  if (name_operations.size() == 1) {
+    lookup_func(name_operations[0]);
+    return;
+  }
+
+  // different names has no batch rpc, run them concurrently
+  struct Params {
+    std::function<void(std::vector<LookupOperationSPtr>&)>& func;
+    std::vector<LookupOperationSPtr>& operations;
+    bthread::CountdownEvent& count_down;
+  };
+
+  std::function<void(std::vector<LookupOperationSPtr>&)> func = lookup_func;
+  bthread::CountdownEvent count_down(name_operations.size());
+  for (auto& operations : name_operations) {
+    Params* params = new Params({.func = func,
+                                 .operations = operations,
+                                 .count_down = count_down});
+
+    bthread_t tid;
+    bthread_attr_t attr = BTHREAD_ATTR_SMALL;
+    if (bthread_start_background(
+            &tid, &attr,
+            [](void* arg) -> void* {
+              Params* params = reinterpret_cast<Params*>(arg);
+
+              params->func(params->operations);
+              params->count_down.signal();
+
+              delete params;
+
+              return nullptr;
+            },
+            params) != 0) {
+      delete params;
+      LOG(ERROR) << "[meta.batch_processor] start background thread fail.";
+      lookup_func(operations);
+      count_down.signal();
+    }
+  }
+
+  CHECK(count_down.wait() == 0) << "count down wait fail.";
+}
+
 BatchProcessor::BatchProcessor(MDSClient& mds_client)
     : mds_client_(mds_client) {
   CHECK(bthread_mutex_init(&mutex_, nullptr) == 0)
@@ -357,17 +586,48 @@ void BatchProcessor::ProcessOperation() {
 
       stage_operations.push_back(operation);
 
-      if (!is_waited && FLAGS_vfs_meta_batch_operation_merge_delay_us > 0) {
-        bthread_usleep(FLAGS_vfs_meta_batch_operation_merge_delay_us);
+      const uint32_t merge_delay_us = MergeDelayUs();
+      if (!is_waited && merge_delay_us > 0) {
+        bthread_usleep(merge_delay_us);
         is_waited = true;
       }
 
     } while (true);
 
+    // getattr is merged across inodes, so not group by inode
+    std::vector<OperationSPtr> getattr_operations;
+    auto removed = std::remove_if(
+        stage_operations.begin(), stage_operations.end(),
+        [&getattr_operations](const OperationSPtr& operation) {
+          if (operation->GetOpType() != Operation::OpType::kGetAttr) {
+            return false;
+          }
+          getattr_operations.push_back(operation);
+          return true;
+        });
+    stage_operations.erase(removed, stage_operations.end());
+    if (!getattr_operations.empty()) {
+      LaunchBatchRead(std::move(getattr_operations));
+    }
+
+    std::vector<BatchOperation> write_slice_batch_operations;
     auto batch_operation_map = Grouping(stage_operations);
     for (auto& [_, batch_operation] : batch_operation_map) {
+      if (FLAGS_vfs_meta_group_commit_enable &&
+          batch_operation.type == Operation::OpType::kWriteSlice) {
+        write_slice_batch_operations.push_back(std::move(batch_operation));
+        continue;
+      }
+
       LaunchExecuteBatchOperation(std::move(batch_operation));
     }
+
+    if (FLAGS_vfs_meta_group_commit_enable) {
+      AdaptGroupCommitWindow(write_slice_batch_operations.size());
+      if (!write_slice_batch_operations.empty()) {
+        LaunchGroupCommit(std::move(write_slice_batch_operations));
+      }
+    }
   }
 
   // print pending operations
@@ -396,6 +656,144 @@ std::map<BatchProcessor::Key, BatchOperation> BatchProcessor::Grouping(
   return batch_operation_map;
 }
 
+uint32_t BatchProcessor::MergeDelayUs() const {
+  if (!FLAGS_vfs_meta_group_commit_enable) {
+    return FLAGS_vfs_meta_batch_operation_merge_delay_us;
+  }
+
+  return std::max(group_commit_delay_us_,
+                  FLAGS_vfs_meta_batch_operation_merge_delay_us);
+}
+
+// widen window when several inodes commit together, shrink it when commits
+// arrive alone, so idle fsync pays no extra latency
+void BatchProcessor::AdaptGroupCommitWindow(size_t write_slice_inode_num) {
+  const uint32_t min_delay_us = FLAGS_vfs_meta_batch_operation_merge_delay_us;
+  const uint32_t max_delay_us =
+      std::max(FLAGS_vfs_meta_group_commit_max_delay_us, min_delay_us);
+
+  if (write_slice_inode_num > 1) {
+    group_commit_delay_us_ =
+        std::min(std::max(group_commit_delay_us_ * 2, min_delay_us + 1),
+                 max_delay_us);
+
+  } else if (write_slice_inode_num == 1) {
+    group_commit_delay_us_ =
+        std::max(group_commit_delay_us_ / 2, min_delay_us);
+  }
+
+  meta_group_commit_window_us.set_value(group_commit_delay_us_);
+}
+
+void BatchProcessor::LaunchGroupCommit(
+    std::vector<BatchOperation>&& batch_operations) {
+  // group by mds which serve the inode
+  std::map<uint64_t, std::vector<BatchOperation>> mds_batch_operations;
+  for (auto& batch_operation : batch_operations) {
+    uint64_t mds_id = mds_client_.GetMdsId(batch_operation.ino);
+    mds_batch_operations[mds_id].push_back(std::move(batch_operation));
+  }
+
+  const size_t max_inodes =
+      std::max(FLAGS_vfs_meta_group_commit_max_inodes, 2U);
+  for (auto& [_, operations] : mds_batch_operations) {
+    for (size_t start = 0; start < operations.size(); start += max_inodes) {
+      size_t end = std::min(start + max_inodes, operations.size());
+      if (end - start == 1) {
+        LaunchExecuteBatchOperation(std::move(operations[start]));
+        continue;
+      }
+
+      std::vector<BatchOperation> group(
+          std::make_move_iterator(operations.begin() + start),
+          std::make_move_iterator(operations.begin() + end));
+      LaunchExecuteGroupCommit(std::move(group));
+    }
+  }
+}
+
+void BatchProcessor::LaunchExecuteGroupCommit(
+    std::vector<BatchOperation>&& batch_operations) {
+  struct Params {
+    MDSClient& mds_client;
+    std::vector<BatchOperation> batch_operations;
+  };
+
+  Params* params = new Params({.mds_client = mds_client_,
+                               .batch_operations = std::move(batch_operations)});
+
+  bthread_t tid;
+  bthread_attr_t attr = BTHREAD_ATTR_SMALL;
+  if (bthread_start_background(
+          &tid, &attr,
+          [](void* arg) -> void* {
+            Params* params = reinterpret_cast<Params*>(arg);
+
+            WriteSliceOperation::GroupRun(params->mds_client,
+                                          params->batch_operations);
+
+            delete params;
+
+            return nullptr;
+          },
+          params) != 0) {
+    delete params;
+    LOG(FATAL) << "[meta.batch_processor] start background thread fail.";
+  }
+}
+
+void BatchProcessor::LaunchBatchRead(
+    std::vector<OperationSPtr>&& operations) {
+  // group by mds which serve the inode
+  std::map<uint64_t, std::vector<OperationSPtr>> mds_operations;
+  for (auto& operation : operations) {
+    uint64_t mds_id = mds_client_.GetMdsId(operation->GetIno());
+    mds_operations[mds_id].push_back(std::move(operation));
+  }
+
+  const size_t max_inodes =
+      std::max(FLAGS_vfs_meta_batch_read_max_inodes, 1U);
+  for (auto& [_, same_mds_operations] : mds_operations) {
+    for (size_t start = 0; start < same_mds_operations.size();
+         start += max_inodes) {
+      size_t end = std::min(start + max_inodes, same_mds_operations.size());
+      std::vector<OperationSPtr> batch(
+          std::make_move_iterator(same_mds_operations.begin() + start),
+          std::make_move_iterator(same_mds_operations.begin() + end));
+      LaunchExecuteBatchRead(std::move(batch));
+    }
+  }
+}
+
+void BatchProcessor::LaunchExecuteBatchRead(
+    std::vector<OperationSPtr>&& operations) {
+  struct Params {
+    MDSClient& mds_client;
+    std::vector<OperationSPtr> operations;
+  };
+
+  Params* params = new Params(
+      {.mds_client = mds_client_, .operations = std::move(operations)});
+
+  bthread_t tid;
+  bthread_attr_t attr = BTHREAD_ATTR_SMALL;
+  if (bthread_start_background(
+          &tid, &attr,
+          [](void* arg) -> void* {
+            Params* params = reinterpret_cast<Params*>(arg);
+
+            GetAttrOperation::GroupRun(params->mds_client, params->operations);
+
+            delete params;
+
+            return nullptr;
+          },
+          params) != 0) {
+    delete params;
+    LOG(FATAL) << "[meta.batch_processor] start background thread fail.";
+  }
+}
+
 void BatchProcessor::LaunchExecuteBatchOperation(
     BatchOperation&& batch_operation) {
   struct Params {
@@ -443,6 +841,9 @@ void BatchProcessor::ExecuteBatchOperation(MDSClient& mds_client,
     case Operation::OpType::kUnlink: {
       UnlinkOperation::BatchRun(mds_client, batch_operation);
     } break;
+    case Operation::OpType::kLookup: {
+      LookupOperation::BatchRun(mds_client, batch_operation);
+    } break;
     default: {
       LOG(FATAL) << fmt::format(
           "[meta.batch_processor] unknown batch_operation type({}).",
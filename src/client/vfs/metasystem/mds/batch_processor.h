@@ -47,6 +47,8 @@ class Operation {
     kMkDir = 1,
     kMkNod = 2,
     kUnlink = 3,
+    kGetAttr = 4,
+    kLookup = 5,
   };
 
   std::string OpName() const { return OpName(GetOpType()); }
@@ -61,6 +63,10 @@ class Operation {
         return "mknod";
       case OpType::kUnlink:
         return "unlink";
+      case OpType::kGetAttr:
+        return "getattr";
+      case OpType::kLookup:
+        return "lookup";
       default:
         return "unknown";
     }
@@ -115,6 +121,9 @@ struct WriteSliceOperation : public Operation {
   }
 
   static void BatchRun(MDSClient& mds_client, BatchOperation& batch_operation);
+  // commit write slice of different inodes served by the same mds in one rpc
+  static void GroupRun(MDSClient& mds_client,
+                       std::vector<BatchOperation>& batch_operations);
 };
 
 using WriteSliceOperationSPtr = std::shared_ptr<WriteSliceOperation>;
@@ -223,6 +232,64 @@ struct UnlinkOperation : public Operation {
 
 using UnlinkOperationSPtr = std::shared_ptr<UnlinkOperation>;
 
+struct GetAttrOperation : public Operation {
+  GetAttrOperation(ContextSPtr& ctx, Ino ino) : Operation(ctx), ino(ino) {}
+
+  struct Result {
+    AttrEntry attr_entry;
+    pb::mds::AttrLease attr_lease;
+  };
+
+  Ino ino;
+
+  Result result;
+
+  OpType GetOpType() const override { return OpType::kGetAttr; }
+  Ino GetIno() const override { return ino; }
+
+  void SetResult(const AttrEntry& attr_entry,
+                 const pb::mds::AttrLease& attr_lease) {
+    result.attr_entry = attr_entry;
+    result.attr_lease = attr_lease;
+  }
+  Result& GetResult() { return result; }
+
+  // fetch attr of different inodes served by the same mds in one rpc
+  static void GroupRun(MDSClient& mds_client,
+                       std::vector<OperationSPtr>& operations);
+};
+
+using GetAttrOperationSPtr = std::shared_ptr<GetAttrOperation>;
+
+struct LookupOperation : public Operation {
+  LookupOperation(ContextSPtr& ctx, Ino parent, std::string name)
+      : Operation(ctx), parent(parent), name(name) {}
+
+  struct Result {
+    AttrEntry attr_entry;
+    uint64_t dentry_lease_ms{0};
+  };
+
+  Ino parent;
+  std::string name;
+
+  Result result;
+
+  OpType GetOpType() const override { return OpType::kLookup; }
+  Ino GetIno() const override { return parent; }
+
+  void SetResult(const AttrEntry& attr_entry, uint64_t dentry_lease_ms) {
+    result.attr_entry = attr_entry;
+    result.dentry_lease_ms = dentry_lease_ms;
+  }
+  Result& GetResult() { return result; }
+
+  // same name lookup share one rpc, different names run concurrently
+  static void BatchRun(MDSClient& mds_client, BatchOperation& batch_operation);
+};
+
+using LookupOperationSPtr = std::shared_ptr<LookupOperation>;
+
 struct BatchOperation {
   Ino ino;
   Operation::OpType type;
@@ -266,6 +333,17 @@ class BatchProcessor {
   static void ExecuteBatchOperation(MDSClient& mds_client,
                                     BatchOperation& batch_operation);
 
+  // merge write slice of different inodes by mds
+  void LaunchGroupCommit(std::vector<BatchOperation>&& batch_operations);
+  void LaunchExecuteGroupCommit(std::vector<BatchOperation>&& batch_operations);
+
+  // merge getattr of different inodes by mds
+  void LaunchBatchRead(std::vector<OperationSPtr>&& operations);
+  void LaunchExecuteBatchRead(std::vector<OperationSPtr>&& operations);
+
+  uint32_t MergeDelayUs() const;
+  void AdaptGroupCommitWindow(size_t write_slice_inode_num);
+
   // consumer thread
   bthread_t tid_{0};
   bthread_mutex_t mutex_;
@@ -273,6 +351,9 @@ class BatchProcessor {
 
   std::atomic<bool> stopped_{false};
 
+  // adaptive group commit window, only access by consumer thread
+  uint32_t group_commit_delay_us_{0};
+
   MDSClient& mds_client_;
 
   butil::MPSCQueue<OperationSPtr> operations_;
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Inode cache benchmark, report cached inode count per GB and getattr
+// throughput per core.
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "client/vfs/metasystem/mds/inode_cache.h"
+
+DEFINE_uint64(inode_num, 1000000, "cached inode number");
+DEFINE_uint32(thread_num, 4, "getattr thread number");
+DEFINE_uint32(duration_s, 10, "getattr duration seconds");
+DEFINE_uint32(xattr_percent, 1, "percent of inode with xattr");
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+using Timer = std::chrono::steady_clock;
+
+static uint64_t GetRssBytes() {
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+static mds::AttrEntry GenAttr(uint64_t ino, bool with_xattr) {
+  mds::AttrEntry attr;
+  attr.set_fs_id(1);
+  attr.set_ino(ino);
+  attr.set_type(pb::mds::FileType::FILE);
+  attr.set_length(4096);
+  attr.set_uid(1000);
+  attr.set_gid(1000);
+  attr.set_mode(S_IFREG | 0644);
+  attr.set_nlink(1);
+  attr.set_ctime(1);
+  attr.set_mtime(1);
+  attr.set_atime(1);
+  attr.set_version(1);
+  attr.add_parents(1);
+  if (with_xattr) {
+    (*attr.mutable_xattrs())["user.bench"] = "value";
+  }
+
+  return attr;
+}
+
+static void RunBench() {
+  auto inode_cache = InodeCache::New(1);
+
+  // fill
+  const uint64_t start_ino = 1000;
+  uint64_t rss_begin = GetRssBytes();
+  for (uint64_t i = 0; i < FLAGS_inode_num; ++i) {
+    uint64_t ino = start_ino + i;
+    inode_cache->Put(ino, GenAttr(ino, (i % 100) < FLAGS_xattr_percent));
+  }
+  uint64_t rss_end = GetRssBytes();
+
+  double bytes_per_inode =
+      static_cast<double>(rss_end - rss_begin) / FLAGS_inode_num;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "inode num: " << FLAGS_inode_num << "\n";
+  std::cout << "rss bytes per inode: " << bytes_per_inode << "\n";
+  std::cout << "estimate bytes per inode: "
+            << static_cast<double>(inode_cache->Bytes()) / FLAGS_inode_num
+            << "\n";
+  std::cout << "inodes per GB: " << (1024.0 * 1024 * 1024) / bytes_per_inode
+            << "\n";
+
+  // getattr
+  std::atomic<bool> stop{false};
+  std::vector<uint64_t> op_counts(FLAGS_thread_num, 0);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < FLAGS_thread_num; ++i) {
+    threads.emplace_back([&, i]() {
+      std::mt19937_64 rng(i);
+      std::uniform_int_distribution<uint64_t> dist(
+          start_ino, start_ino + FLAGS_inode_num - 1);
+      uint64_t count = 0, sum = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int j = 0; j < 1024; ++j) {
+          auto inode = inode_cache->Get(dist(rng));
+          if (inode != nullptr) sum += inode->ToAttr().length;
+        }
+        count += 1024;
+      }
+      op_counts[i] = count;
+      CHECK(sum > 0);
+    });
+  }
+
+  auto begin = Timer::now();
+  std::this_thread::sleep_for(std::chrono::seconds(FLAGS_duration_s));
+  stop.store(true);
+  for (auto& thread : threads) thread.join();
+  double elapsed_s =
+      std::chrono::duration<double>(Timer::now() - begin).count();
+
+  uint64_t total = 0;
+  for (auto count : op_counts) total += count;
+  std::cout << "getattr threads: " << FLAGS_thread_num << "\n";
+  std::cout << "getattr ops/s: " << total / elapsed_s << "\n";
+  std::cout << "getattr ops/s per core: "
+            << total / elapsed_s / FLAGS_thread_num << "\n";
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(FLAGS_inode_num > 0) << "inode_num must be positive.";
+  CHECK(FLAGS_thread_num > 0) << "thread_num must be positive.";
+
+  dingofs::client::vfs::meta::RunBench();
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Metadata storm benchmark, many threads stat/open small files under a
+// mounted dir, report ops/s and latency. Run it against a mount with and
+// without --vfs_meta_batch_read_enable to compare.
+
+#include <fcntl.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_string(dir, "", "bench dir under mount point");
+DEFINE_uint32(file_num, 10000, "file number");
+DEFINE_uint32(thread_num, 64, "thread number");
+DEFINE_uint32(duration_s, 30, "bench duration seconds");
+DEFINE_string(op, "stat", "bench op, stat or open");
+DEFINE_bool(skip_create, false, "skip create files, reuse exist files");
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+using Timer = std::chrono::steady_clock;
+
+static std::string FilePath(uint32_t i) {
+  return FLAGS_dir + "/storm_" + std::to_string(i);
+}
+
+static void CreateFiles() {
+  for (uint32_t i = 0; i < FLAGS_file_num; ++i) {
+    int fd = ::open(FilePath(i).c_str(), O_CREAT | O_WRONLY, 0644);
+    CHECK(fd >= 0) << "create file fail, path: " << FilePath(i);
+    ::close(fd);
+  }
+}
+
+static bool DoOp(const std::string& path) {
+  if (FLAGS_op == "open") {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    ::close(fd);
+    return true;
+  }
+
+  struct stat st;
+  return ::stat(path.c_str(), &st) == 0;
+}
+
+static void RunBench() {
+  if (!FLAGS_skip_create) CreateFiles();
+
+  struct ThreadResult {
+    uint64_t count{0};
+    uint64_t error_count{0};
+    std::vector<uint32_t> latency_us;
+  };
+
+  std::atomic<bool> stop{false};
+  std::vector<ThreadResult> results(FLAGS_thread_num);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < FLAGS_thread_num; ++i) {
+    threads.emplace_back([&, i]() {
+      std::mt19937 rng(i);
+      std::uniform_int_distribution<uint32_t> dist(0, FLAGS_file_num - 1);
+      auto& result = results[i];
+      while (!stop.load(std::memory_order_relaxed)) {
+        std::string path = FilePath(dist(rng));
+        auto begin = Timer::now();
+        if (!DoOp(path)) ++result.error_count;
+        result.latency_us.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                Timer::now() - begin)
+                .count());
+        ++result.count;
+      }
+    });
+  }
+
+  auto begin = Timer::now();
+  std::this_thread::sleep_for(std::chrono::seconds(FLAGS_duration_s));
+  stop.store(true);
+  for (auto& thread : threads) thread.join();
+  double elapsed_s =
+      std::chrono::duration<double>(Timer::now() - begin).count();
+
+  uint64_t total = 0, error_total = 0;
+  std::vector<uint32_t> latency_us;
+  for (auto& result : results) {
+    total += result.count;
+    error_total += result.error_count;
+    latency_us.insert(latency_us.end(), result.latency_us.begin(),
+                      result.latency_us.end());
+  }
+  std::sort(latency_us.begin(), latency_us.end());
+  auto percentile = [&latency_us](double p) -> uint32_t {
+    if (latency_us.empty()) return 0;
+    return latency_us[static_cast<size_t>(p * (latency_us.size() - 1))];
+  };
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "op: " << FLAGS_op << " files: " << FLAGS_file_num
+            << " threads: " << FLAGS_thread_num << "\n";
+  std::cout << "ops/s: " << total / elapsed_s << "\n";
+  std::cout << "ops/s per thread: " << total / elapsed_s / FLAGS_thread_num
+            << "\n";
+  std::cout << "errors: " << error_total << "\n";
+  std::cout << "latency us p50: " << percentile(0.5)
+            << " p99: " << percentile(0.99)
+            << " p999: " << percentile(0.999) << "\n";
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(!FLAGS_dir.empty()) << "dir is empty.";
+  CHECK(FLAGS_file_num > 0) << "file_num must be positive.";
+  CHECK(FLAGS_thread_num > 0) << "thread_num must be positive.";
+  CHECK(FLAGS_op == "stat" || FLAGS_op == "open") << "op must be stat or open.";
+
+  dingofs::client::vfs::meta::RunBench();
+
+  return 0;
+}
@@ -711,6 +711,19 @@ void ChunkCache::CleanExpired(uint64_t expire_s) {
   });
 }
 
+std::vector<ChunkSetSPtr> ChunkCache::GetActive(uint64_t active_since_s) {
+  std::vector<ChunkSetSPtr> chunk_sets;
+  shard_map_.iterate([&](const Map& map) {
+    for (const auto& [_, chunk_set] : map) {
+      if (chunk_set->GetLastActiveTimeS() >= active_since_s) {
+        chunk_sets.push_back(chunk_set);
+      }
+    }
+  });
+
+  return chunk_sets;
+}
+
 void ChunkCache::Summary(Json::Value& value) {
   value["name"] = "chunkcache";
   value["count"] = Size();
@@ -391,6 +391,9 @@ class ChunkCache {
 
   void CleanExpired(uint64_t expire_s);
 
+  // chunk sets active since the timestamp(s)
+  std::vector<ChunkSetSPtr> GetActive(uint64_t active_since_s);
+
   void Summary(Json::Value& value);
   bool Dump(Json::Value& value, bool is_summary = false);
 
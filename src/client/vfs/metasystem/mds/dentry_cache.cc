@@ -0,0 +1,163 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "client/vfs/metasystem/mds/dentry_cache.h"
+
+#include <algorithm>
+
+#include "utils/time.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// keep invalidate time for a while to discard raced lookup result
+static const uint64_t kKeepInvalidateTimeNs = 60ULL * 1000 * 1000 * 1000;
+
+void DentryCache::Put(Ino parent, const std::string& name, Ino ino,
+                      uint64_t lease_ms, uint64_t request_time_ns) {
+  if (lease_ms == 0) return;
+
+  const uint64_t expire_time_ns = request_time_ns + lease_ms * 1000000;
+  shard_map_.withWLock(
+      [parent, &name, ino, expire_time_ns, request_time_ns](Map& map) mutable {
+        auto& entry = map[parent];
+        // invalidated after send request, result maybe stale
+        if (entry.invalidate_time_ns >= request_time_ns) return;
+        auto delete_it = entry.delete_times.find(name);
+        if (delete_it != entry.delete_times.end() &&
+            delete_it->second >= request_time_ns) {
+          return;
+        }
+
+        if (entry.expire_time_ns < utils::TimestampNs()) {
+          entry.dentries.clear();
+        }
+
+        entry.expire_time_ns = std::max(entry.expire_time_ns, expire_time_ns);
+        entry.dentries[name] = ino;
+      },
+      parent);
+}
+
+void DentryCache::Delete(Ino parent, const std::string& name) {
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.withWLock(
+      [parent, &name, now_ns](Map& map) mutable {
+        auto& entry = map[parent];
+        entry.dentries.erase(name);
+        entry.delete_times[name] = now_ns;
+      },
+      parent);
+}
+
+void DentryCache::Invalidate(Ino parent) {
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.withWLock(
+      [parent, now_ns](Map& map) mutable {
+        auto& entry = map[parent];
+        entry.dentries.clear();
+        entry.delete_times.clear();
+        entry.invalidate_time_ns = now_ns;
+      },
+      parent);
+
+  invalidate_count_ << 1;
+}
+
+void DentryCache::CleanExpired() {
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.iterateWLock([now_ns](Map& map) {
+    for (auto it = map.begin(); it != map.end();) {
+      auto& entry = it->second;
+      absl::erase_if(entry.delete_times, [now_ns](const auto& delete_time) {
+        return delete_time.second + kKeepInvalidateTimeNs < now_ns;
+      });
+
+      if (entry.expire_time_ns < now_ns &&
+          entry.invalidate_time_ns + kKeepInvalidateTimeNs < now_ns &&
+          entry.delete_times.empty()) {
+        auto temp_it = it++;
+        map.erase(temp_it);
+      } else {
+        ++it;
+      }
+    }
+  });
+}
+
+bool DentryCache::Get(Ino parent, const std::string& name, Ino& ino) {
+  bool found = false;
+  const uint64_t now_ns = utils::TimestampNs();
+  shard_map_.withRLock(
+      [parent, &name, &ino, &found, now_ns](Map& map) {
+        auto it = map.find(parent);
+        if (it == map.end() || it->second.expire_time_ns < now_ns) return;
+
+        auto dentry_it = it->second.dentries.find(name);
+        if (dentry_it != it->second.dentries.end()) {
+          ino = dentry_it->second;
+          found = true;
+        }
+      },
+      parent);
+
+  if (found) {
+    hit_count_ << 1;
+  } else {
+    miss_count_ << 1;
+  }
+
+  return found;
+}
+
+size_t DentryCache::Size() {
+  size_t size = 0;
+  shard_map_.iterate([&size](Map& map) {
+    for (const auto& [_, entry] : map) size += entry.dentries.size();
+  });
+  return size;
+}
+
+size_t DentryCache::Bytes() {
+  size_t bytes = 0;
+  shard_map_.iterate([&bytes](Map& map) {
+    for (const auto& [_, entry] : map) {
+      bytes += sizeof(Ino) + sizeof(Entry);
+      for (const auto& [name, _] : entry.dentries) {
+        bytes += name.size() + sizeof(Ino);
+      }
+      for (const auto& [name, _] : entry.delete_times) {
+        bytes += name.size() + sizeof(uint64_t);
+      }
+    }
+  });
+  return bytes;
+}
+
+void DentryCache::Summary(Json::Value& value) {
+  value["name"] = "dentrycache";
+  value["count"] = Size();
+  value["bytes"] = Bytes();
+  value["hit_count"] = hit_count_.get_value();
+  value["miss_count"] = miss_count_.get_value();
+  value["invalidate_count"] = invalidate_count_.get_value();
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
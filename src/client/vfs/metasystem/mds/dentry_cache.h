@@ -0,0 +1,87 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_MDS_DENTRY_CACHE_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_MDS_DENTRY_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "bvar/reducer.h"
+#include "client/vfs/vfs_meta.h"
+#include "json/value.h"
+#include "utils/shards.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// cache dentry of directory under lease granted by mds, negative dentry
+// is cached as ino 0. the whole directory is dropped when mds revoke the
+// lease or the lease expired.
+class DentryCache {
+ public:
+  DentryCache() = default;
+  ~DentryCache() = default;
+
+  // request_time_ns is the time send lookup request, used to discard result
+  // which is raced with invalidation.
+  void Put(Ino parent, const std::string& name, Ino ino, uint64_t lease_ms,
+           uint64_t request_time_ns);
+  // forget dentry changed by self, lookup result of it requested before
+  // is discarded, so call it again after the change is done.
+  void Delete(Ino parent, const std::string& name);
+  void Invalidate(Ino parent);
+  void CleanExpired();
+
+  bool Get(Ino parent, const std::string& name, Ino& ino);
+
+  size_t Size();
+  size_t Bytes();
+
+  void Summary(Json::Value& value);
+
+ private:
+  struct Entry {
+    uint64_t expire_time_ns{0};
+    uint64_t invalidate_time_ns{0};
+    // name -> ino
+    absl::flat_hash_map<std::string, Ino> dentries;
+    // name -> delete time
+    absl::flat_hash_map<std::string, uint64_t> delete_times;
+  };
+
+  // parent -> entry
+  using Map = absl::flat_hash_map<Ino, Entry>;
+
+  constexpr static size_t kShardNum = 32;
+  utils::Shards<Map, kShardNum> shard_map_;
+
+  // metric
+  bvar::Adder<uint64_t> hit_count_{"meta_dentry_cache_hit_count"};
+  bvar::Adder<uint64_t> miss_count_{"meta_dentry_cache_miss_count"};
+  bvar::Adder<uint64_t> invalidate_count_{
+      "meta_dentry_cache_invalidate_count"};
+};
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_MDS_DENTRY_CACHE_H_
@@ -16,37 +16,118 @@
 
 #include <sys/types.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include "bthread/mutex.h"
+#include "butil/scoped_lock.h"
 #include "client/vfs/common/helper.h"
 #include "common/options/client.h"
 #include "fmt/format.h"
 #include "glog/logging.h"
+#include "utils/time.h"
 
 namespace dingofs {
 namespace client {
 namespace vfs {
 namespace meta {
 
+DirIterator::DirIterator(MDSClient& mds_client, Ino ino, uint64_t fh)
+    : mds_client_(mds_client), ino_(ino), fh_(fh) {
+  CHECK(bthread_mutex_init(&mutex_, nullptr) == 0)
+      << "[dir_iterator] bthread_mutex_init fail.";
+  CHECK(bthread_cond_init(&cond_, nullptr) == 0)
+      << "[dir_iterator] bthread_cond_init fail.";
+
+  last_fetch_time_ns_ = utils::TimestampNs();
+}
+
 DirIterator::~DirIterator() {
   std::string str;
   for (auto offset : offset_stats_) {
     str += fmt::format("{},", offset);
   }
 
-  LOG_DEBUG << fmt::format("[dir_iterator.{}.{}] offset stats: {} {}.", ino_,
-                           fh_, offset_stats_.size(), str);
+  LOG_DEBUG << fmt::format(
+      "[dir_iterator.{}.{}] offset stats: {} {}, window({}).", ino_, fh_,
+      offset_stats_.size(), str, window_);
+
+  bthread_cond_destroy(&cond_);
+  bthread_mutex_destroy(&mutex_);
+}
+
+void DirIterator::EnableSnapshot(const DirCursor& cursor) {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  enable_snapshot_ = true;
+  snapshot_with_attr_ = true;
+  snapshot_cursor_ = cursor;
+}
+
+void DirIterator::LoadSnapshot(const DirSnapshotSPtr& snapshot) {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  is_from_snapshot_ = true;
+  is_fetch_ = true;
+  is_eof_ = true;
+  with_attr_ = snapshot->with_attr;
+  entries_ = *snapshot->entries;
+  if (!entries_.empty()) last_name_ = entries_.back().name;
+}
+
+DirSnapshotSPtr DirIterator::TakeSnapshot() {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  if (!enable_snapshot_ || !is_eof_ || !fetch_status_.ok()) return nullptr;
+
+  auto snapshot = std::make_shared<DirSnapshot>();
+  snapshot->cursor = snapshot_cursor_;
+  snapshot->with_attr = snapshot_with_attr_;
+  snapshot->create_time_s = utils::Timestamp();
+  snapshot->refresh_time_s = snapshot->create_time_s;
+  snapshot->entries =
+      std::make_shared<std::vector<DirEntry>>(std::move(snapshot_entries_));
+
+  enable_snapshot_ = false;
+  snapshot_entries_.clear();
+
+  return snapshot;
+}
+
+void DirIterator::Stop() {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  is_stop_ = true;
 }
 
 void DirIterator::Remember(uint64_t off) { offset_stats_.push_back(off); }
 
 Status DirIterator::GetValue(ContextSPtr& ctx, uint64_t off, bool with_attr,
                              DirEntry& dir_entry) {
+  std::unique_lock<bthread_mutex_t> lock(mutex_);
+
   CHECK(off >= offset_) << fmt::format(
       "[dir_iterator.{}.{}] off out of range, {} {}.", ino_, fh_, offset_, off);
 
-  with_attr_ = with_attr;
+  if (with_attr && !with_attr_) {
+    // entries fetched ahead have no attr, refetch them from consumed position
+    if (is_from_snapshot_ || !prefetch_batches_.empty()) {
+      is_from_snapshot_ = false;
+      enable_snapshot_ = false;
+      prefetch_batches_.clear();
+      if (off - offset_ < entries_.size()) entries_.resize(off - offset_);
+      last_name_ = entries_.empty() ? base_name_ : entries_.back().name;
+      is_eof_ = false;
+    }
+    with_attr_ = true;
+
+  } else if (!with_attr && with_attr_ && !is_from_snapshot_) {
+    with_attr_ = false;
+  }
 
   do {
     if (off < offset_ + entries_.size()) {
@@ -54,63 +135,217 @@ Status DirIterator::GetValue(ContextSPtr& ctx, uint64_t off, bool with_attr,
       return Status::OK();
     }
 
-    if (is_fetch_ && entries_.size() < FLAGS_vfs_meta_read_dir_batch_size) {
-      return Status::NoData("not more dentry");
+    // switch to next prefetched batch
+    if (!prefetch_batches_.empty()) {
+      AdjustWindow();
+
+      if (!entries_.empty()) base_name_ = entries_.back().name;
+      offset_ += entries_.size();
+      entries_ = std::move(prefetch_batches_.front());
+      prefetch_batches_.pop_front();
+
+      MaybePrefetch(ctx);
+      continue;
     }
 
-    auto status = Fetch(ctx);
-    if (!status.ok()) return status;
+    if (is_eof_) return Status::NoData("not more dentry");
+
+    if (!fetch_status_.ok()) {
+      auto status = fetch_status_;
+      fetch_status_ = Status::OK();
+      return status;
+    }
+
+    if (is_fetching_) {
+      // consumer is faster than prefetch, wait fetching batch
+      bthread_cond_wait(&cond_, &mutex_);
+      continue;
+    }
+
+    // fetch in caller
+    is_fetching_ = true;
+    lock.unlock();
+    Fetch(ctx);
+    lock.lock();
 
   } while (true);
 
   return Status::OK();
 }
 
-Status DirIterator::Fetch(ContextSPtr& ctx) {
+void DirIterator::AdjustWindow() {
+  uint64_t now_us = utils::TimestampUs();
+  if (switch_batch_time_us_ != 0) {
+    uint64_t elapsed_us = now_us - switch_batch_time_us_;
+    consume_time_us_ = consume_time_us_ == 0
+                           ? elapsed_us
+                           : (consume_time_us_ * 3 + elapsed_us) / 4;
+  }
+  switch_batch_time_us_ = now_us;
+
+  uint32_t max_window = FLAGS_vfs_meta_read_dir_prefetch_max_batches;
+  if (max_window == 0) return;
+
+  // in-advance batches needed to hide fetch latency
+  uint64_t window =
+      (fetch_latency_us_ / std::max(consume_time_us_, uint64_t{1})) + 1;
+  window_ =
+      std::clamp(window, uint64_t{1}, static_cast<uint64_t>(max_window));
+}
+
+void DirIterator::MaybePrefetch(ContextSPtr& ctx) {
+  if (FLAGS_vfs_meta_read_dir_prefetch_max_batches == 0) return;
+  if (is_stop_ || is_eof_ || is_fetching_ || !fetch_status_.ok()) return;
+  if (prefetch_batches_.size() >= window_) return;
+
+  is_fetching_ = true;
+  LaunchFetch(ctx);
+}
+
+void DirIterator::LaunchFetch(ContextSPtr& ctx) {
+  struct Params {
+    DirIteratorSPtr dir_iterator;
+    ContextSPtr ctx;
+  };
+
+  Params* params =
+      new Params({.dir_iterator = shared_from_this(), .ctx = ctx});
+
+  bthread_t tid;
+  bthread_attr_t attr = BTHREAD_ATTR_SMALL;
+  if (bthread_start_background(
+          &tid, &attr,
+          [](void* arg) -> void* {
+            Params* params = reinterpret_cast<Params*>(arg);
+
+            params->dir_iterator->Fetch(params->ctx);
+
+            delete params;
+
+            return nullptr;
+          },
+          params) != 0) {
+    delete params;
+    // fallback to fetch by consumer
+    is_fetching_ = false;
+    LOG(ERROR) << fmt::format(
+        "[dir_iterator.{}.{}] start prefetch bthread fail.", ino_, fh_);
+  }
+}
+
+void DirIterator::Fetch(ContextSPtr ctx) {
+  std::string last_name;
+  bool with_attr;
+  {
+    BAIDU_SCOPED_LOCK(mutex_);
+    last_name = last_name_;
+    with_attr = with_attr_;
+  }
+
+  utils::Duration duration;
+
   std::vector<DirEntry> entries;
-  auto status = mds_client_.ReadDir(ctx, ino_, fh_, last_name_,
+  auto status = mds_client_.ReadDir(ctx, ino_, fh_, last_name,
                                     FLAGS_vfs_meta_read_dir_batch_size,
-                                    with_attr_, entries);
+                                    with_attr, entries);
   if (!status.ok()) {
     LOG(ERROR) << fmt::format(
-        "[dir_iterator.{}.{}] readdir fail, offset({}) last_name({}).", ino_,
-        fh_, offset_, last_name_);
-    return status;
+        "[dir_iterator.{}.{}] readdir fail, last_name({}) error({}).", ino_,
+        fh_, last_name, status.ToString());
   }
 
-  is_fetch_ = true;
+  if (status.ok() && with_attr && warmup_func_ != nullptr) {
+    warmup_func_(entries);
+  }
 
-  offset_ += entries_.size();
-  entries_ = std::move(entries);
-  if (!entries_.empty()) {
-    last_name_ = entries_.back().name;
+  std::unique_lock<bthread_mutex_t> lock(mutex_);
+
+  is_fetching_ = false;
+
+  // consumer need attr or reset during fetching, drop the batch
+  if (last_name != last_name_ || (!with_attr && with_attr_)) {
+    bthread_cond_broadcast(&cond_);
+    return;
   }
 
-  return Status::OK();
+  if (!status.ok()) {
+    fetch_status_ = status;
+    bthread_cond_broadcast(&cond_);
+    return;
+  }
+
+  uint64_t latency_us = duration.ElapsedUs();
+  fetch_latency_us_ = fetch_latency_us_ == 0
+                          ? latency_us
+                          : (fetch_latency_us_ * 3 + latency_us) / 4;
+
+  is_fetch_ = true;
+  is_eof_ = entries.size() < FLAGS_vfs_meta_read_dir_batch_size;
+  if (!entries.empty()) last_name_ = entries.back().name;
+
+  if (enable_snapshot_) {
+    if (snapshot_entries_.size() + entries.size() >
+        FLAGS_vfs_meta_dir_snapshot_max_entries) {
+      enable_snapshot_ = false;
+      snapshot_entries_.clear();
+    } else {
+      snapshot_with_attr_ = snapshot_with_attr_ && with_attr;
+      snapshot_entries_.insert(snapshot_entries_.end(), entries.begin(),
+                               entries.end());
+    }
+  }
+
+  prefetch_batches_.push_back(std::move(entries));
+
+  MaybePrefetch(ctx);
+
+  bthread_cond_broadcast(&cond_);
 }
 
-size_t DirIterator::Size() { return entries_.size(); }
+size_t DirIterator::Size() {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  size_t size = entries_.size();
+  for (const auto& batch : prefetch_batches_) size += batch.size();
+  return size;
+}
 
 size_t DirIterator::Bytes() {
-  return sizeof(DirIterator) + (entries_.size() * sizeof(DirEntry));
+  size_t count = Size();
+
+  BAIDU_SCOPED_LOCK(mutex_);
+  count += snapshot_entries_.size();
+
+  return sizeof(DirIterator) + (count * sizeof(DirEntry));
 }
 
 bool DirIterator::Dump(Json::Value& value) {
+  std::unique_lock<bthread_mutex_t> lock(mutex_);
+
+  // wait in-flight fetch, make last_name consistent with entries
+  while (is_fetching_) bthread_cond_wait(&cond_, &mutex_);
+
   value["ino"] = ino_;
   value["fh"] = fh_;
   value["last_name"] = last_name_;
   value["with_attr"] = with_attr_;
   value["offset"] = offset_;
   value["is_fetch"] = is_fetch_;
+  value["is_eof"] = is_eof_;
   value["last_fetch_time_ns"] = last_fetch_time_ns_.load();
 
+  // prefetched batches are dumped as part of current batch
   Json::Value entries = Json::arrayValue;
-  for (const auto& entry : entries_) {
+  auto dump_entry_fn = [&entries](const DirEntry& entry) {
     Json::Value entry_item;
     entry_item["ino"] = entry.ino;
     entry_item["name"] = entry.name;
     DumpAttr(entry.attr, entry_item["attr"]);
     entries.append(entry_item);
+  };
+  for (const auto& entry : entries_) dump_entry_fn(entry);
+  for (const auto& batch : prefetch_batches_) {
+    for (const auto& entry : batch) dump_entry_fn(entry);
   }
   value["entries"] = entries;
 
@@ -123,10 +358,13 @@ bool DirIterator::Load(const Json::Value& value) {
     return false;
   }
 
+  BAIDU_SCOPED_LOCK(mutex_);
+
   last_name_ = value["last_name"].asString();
   with_attr_ = value["with_attr"].asBool();
   offset_ = value["offset"].asUInt();
   is_fetch_ = value["is_fetch"].asBool();
+  is_eof_ = value["is_eof"].asBool();
   last_fetch_time_ns_.store(value["last_fetch_time_ns"].asUInt64());
 
   const Json::Value& entries = value["entries"];
@@ -203,6 +441,7 @@ void DirIteratorManager::Delete(Ino ino, uint64_t fh) {
         uint32_t erase_index = UINT32_MAX;
         for (uint32_t i = 0; i < vec.size(); ++i) {
           if (vec[i]->Fh() == fh) {
+            vec[i]->Stop();
             erase_index = i;
             break;
           }
@@ -322,6 +561,176 @@ bool DirIteratorManager::Load(MDSClient& mds_client, const Json::Value& value) {
   return true;
 }
 
+void DirSnapshotCache::Put(Ino ino, DirSnapshotSPtr snapshot) {
+  shard_map_.withWLock(
+      [this, ino, &snapshot](Map& map) {
+        auto it = map.find(ino);
+        if (it != map.end()) {
+          const auto& cursor = it->second->cursor;
+          if (cursor.epoch == snapshot->cursor.epoch &&
+              cursor.seq > snapshot->cursor.seq) {
+            return;
+          }
+        } else {
+          total_count_ << 1;
+        }
+
+        map[ino] = snapshot;
+      },
+      ino);
+}
+
+DirSnapshotSPtr DirSnapshotCache::Get(Ino ino) {
+  uint64_t expired_time_s =
+      utils::Timestamp() - FLAGS_vfs_meta_dir_snapshot_expired_s;
+
+  DirSnapshotSPtr snapshot;
+  shard_map_.withRLock(
+      [ino, expired_time_s, &snapshot](Map& map) {
+        auto it = map.find(ino);
+        if (it == map.end()) return;
+
+        const auto& cached = it->second;
+        if (IsExpired(cached, expired_time_s)) return;
+
+        snapshot = cached;
+      },
+      ino);
+
+  if (snapshot != nullptr) {
+    hit_count_ << 1;
+  } else {
+    miss_count_ << 1;
+  }
+
+  return snapshot;
+}
+
+DirSnapshotSPtr DirSnapshotCache::ApplyDelta(
+    const DirSnapshotSPtr& snapshot, const DirCursor& cursor,
+    const std::vector<DirEntryDelta>& deltas) {
+  auto new_snapshot = std::make_shared<DirSnapshot>(*snapshot);
+  new_snapshot->cursor = cursor;
+  new_snapshot->refresh_time_s = utils::Timestamp();
+  if (deltas.empty()) return new_snapshot;
+
+  // the last change of name wins
+  std::map<std::string, const DirEntryDelta*> changes;
+  for (const auto& delta : deltas) {
+    changes[delta.entry.name] = &delta;
+    if (!delta.is_delete && delta.entry.attr.ino == 0) {
+      new_snapshot->with_attr = false;
+    }
+  }
+
+  // merge sorted entries with sorted changes
+  auto entries = std::make_shared<std::vector<DirEntry>>();
+  entries->reserve(snapshot->entries->size() + changes.size());
+
+  auto it = changes.begin();
+  for (const auto& entry : *snapshot->entries) {
+    for (; it != changes.end() && it->first < entry.name; ++it) {
+      if (!it->second->is_delete) entries->push_back(it->second->entry);
+    }
+
+    if (it != changes.end() && it->first == entry.name) {
+      if (!it->second->is_delete) entries->push_back(it->second->entry);
+      ++it;
+      continue;
+    }
+
+    entries->push_back(entry);
+  }
+
+  for (; it != changes.end(); ++it) {
+    if (!it->second->is_delete) entries->push_back(it->second->entry);
+  }
+
+  new_snapshot->entries = entries;
+
+  return new_snapshot;
+}
+
+bool DirSnapshotCache::IsExpired(const DirSnapshotSPtr& snapshot,
+                                 uint64_t expired_time_s) {
+  // attr of unchanged entries are not refreshed by delta
+  uint64_t time_s =
+      snapshot->with_attr ? snapshot->create_time_s : snapshot->refresh_time_s;
+  return time_s < expired_time_s;
+}
+
+void DirSnapshotCache::Delete(Ino ino) {
+  shard_map_.withWLock([ino](Map& map) { map.erase(ino); }, ino);
+}
+
+void DirSnapshotCache::CleanExpired() {
+  CleanExpired(utils::Timestamp() - FLAGS_vfs_meta_dir_snapshot_expired_s);
+}
+
+void DirSnapshotCache::CleanExpired(uint64_t expired_time_s) {
+  uint64_t count = 0;
+  shard_map_.iterateWLock([expired_time_s, &count](Map& map) {
+    for (auto it = map.begin(); it != map.end();) {
+      if (IsExpired(it->second, expired_time_s)) {
+        auto temp_it = it++;
+        map.erase(temp_it);
+        ++count;
+      } else {
+        ++it;
+      }
+    }
+  });
+
+  if (count > 0) {
+    clean_count_ << count;
+    LOG(INFO) << fmt::format("[meta.dir_snapshot] clean expired, count({}).",
+                             count);
+  }
+}
+
+std::vector<std::pair<Ino, DirSnapshotSPtr>> DirSnapshotCache::GetRefreshed(
+    uint64_t refresh_since_s) {
+  std::vector<std::pair<Ino, DirSnapshotSPtr>> snapshots;
+  shard_map_.iterate([&](const Map& map) {
+    for (const auto& [ino, snapshot] : map) {
+      if (snapshot->refresh_time_s >= refresh_since_s) {
+        snapshots.emplace_back(ino, snapshot);
+      }
+    }
+  });
+
+  return snapshots;
+}
+
+size_t DirSnapshotCache::Size() {
+  size_t size = 0;
+  shard_map_.iterate([&size](const Map& map) { size += map.size(); });
+
+  return size;
+}
+
+size_t DirSnapshotCache::Bytes() {
+  size_t bytes = 0;
+  shard_map_.iterate([&bytes](const Map& map) {
+    for (const auto& [_, snapshot] : map) {
+      bytes += sizeof(DirSnapshot) + (snapshot->entries->size() *
+                                      sizeof(DirEntry));
+    }
+  });
+
+  return bytes;
+}
+
+void DirSnapshotCache::Summary(Json::Value& value) {
+  value["name"] = "dirsnapshot";
+  value["count"] = Size();
+  value["bytes"] = Bytes();
+  value["total_count"] = total_count_.get_value();
+  value["hit_count"] = hit_count_.get_value();
+  value["miss_count"] = miss_count_.get_value();
+  value["clean_count"] = clean_count_.get_value();
+}
+
 }  // namespace meta
 }  // namespace vfs
 }  // namespace client
@@ -18,11 +18,16 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "bthread/bthread.h"
+#include "bvar/reducer.h"
 #include "client/vfs/metasystem/mds/mds_client.h"
 #include "client/vfs/vfs_meta.h"
 #include "common/status.h"
@@ -36,13 +41,28 @@ namespace meta {
 class DirIterator;
 using DirIteratorSPtr = std::shared_ptr<DirIterator>;
 
+// snapshot of whole dir entries, entries are sorted by name as mds does,
+// kept up to date by applying dentry changes after cursor
+struct DirSnapshot {
+  DirCursor cursor;
+  bool with_attr{false};
+  // time of full listing
+  uint64_t create_time_s{0};
+  // time of last applied changes
+  uint64_t refresh_time_s{0};
+  std::shared_ptr<const std::vector<DirEntry>> entries;
+};
+using DirSnapshotSPtr = std::shared_ptr<DirSnapshot>;
+
 // used by read dir
-class DirIterator {
+// fetch batches ahead of consumer, the number of in-advance batches is
+// adapted to the ratio of fetch latency and consume time of one batch.
+class DirIterator : public std::enable_shared_from_this<DirIterator> {
  public:
-  DirIterator(MDSClient& mds_client, Ino ino, uint64_t fh)
-      : mds_client_(mds_client), ino_(ino), fh_(fh) {
-    last_fetch_time_ns_ = utils::TimestampNs();
-  }
+  // called when a batch arrived, used to warm up inode cache
+  using WarmupFunc = std::function<void(const std::vector<DirEntry>&)>;
+
+  DirIterator(MDSClient& mds_client, Ino ino, uint64_t fh);
   ~DirIterator();
 
   static DirIteratorSPtr New(MDSClient& mds_client, Ino ino, uint64_t fh) {
@@ -52,6 +72,19 @@ class DirIterator {
   Ino INo() const { return ino_; }
   uint64_t Fh() const { return fh_; }
 
+  void SetWarmupFunc(WarmupFunc&& func) { warmup_func_ = std::move(func); }
+
+  // collect all entries for building snapshot, cursor is taken before
+  // listing, changes after it will be applied to the snapshot
+  void EnableSnapshot(const DirCursor& cursor);
+  // serve from snapshot, no need fetch from mds
+  void LoadSnapshot(const DirSnapshotSPtr& snapshot);
+  bool IsFromSnapshot() const { return is_from_snapshot_; }
+  // return snapshot when all entries has been fetched
+  DirSnapshotSPtr TakeSnapshot();
+
+  void Stop();
+
   void Remember(uint64_t off);
 
   Status GetValue(ContextSPtr& ctx, uint64_t off, bool with_attr,
@@ -66,25 +99,103 @@ class DirIterator {
   bool Load(const Json::Value& value);
 
  private:
-  Status Fetch(ContextSPtr& ctx);
+  // run in bthread or caller, need not hold mutex_
+  void Fetch(ContextSPtr ctx);
+  // need hold mutex_
+  void MaybePrefetch(ContextSPtr& ctx);
+  void LaunchFetch(ContextSPtr& ctx);
+  void AdjustWindow();
 
   const Ino ino_;
   const uint64_t fh_;
+
+  bthread_mutex_t mutex_;
+  bthread_cond_t cond_;
+
   bool with_attr_{true};
 
+  // entries_ is the batch serving consumer, offset_ is its first offset
   uint64_t offset_{0};
-  std::string last_name_;
   std::vector<DirEntry> entries_;
+  // batches fetched ahead of consumer
+  std::deque<std::vector<DirEntry>> prefetch_batches_;
+  // last name of the latest fetched batch
+  std::string last_name_;
+  // last name before entries_
+  std::string base_name_;
 
   bool is_fetch_{false};
+  bool is_eof_{false};
+  bool is_fetching_{false};
+  bool is_stop_{false};
+  Status fetch_status_;
   std::atomic<uint64_t> last_fetch_time_ns_{0};
 
+  // adaptive prefetch window
+  uint32_t window_{1};
+  uint64_t fetch_latency_us_{0};
+  uint64_t consume_time_us_{0};
+  uint64_t switch_batch_time_us_{0};
+
+  // snapshot
+  bool enable_snapshot_{false};
+  bool is_from_snapshot_{false};
+  bool snapshot_with_attr_{true};
+  DirCursor snapshot_cursor_;
+  std::vector<DirEntry> snapshot_entries_;
+
+  WarmupFunc warmup_func_;
+
   MDSClient& mds_client_;
 
   // stat
   std::vector<uint64_t> offset_stats_;
 };
 
+// cache whole entries of recently read dir
+class DirSnapshotCache {
+ public:
+  DirSnapshotCache() = default;
+  ~DirSnapshotCache() = default;
+
+  void Put(Ino ino, DirSnapshotSPtr snapshot);
+  // return snapshot which is not expired
+  DirSnapshotSPtr Get(Ino ino);
+  void Delete(Ino ino);
+
+  // generate new snapshot with changes applied
+  static DirSnapshotSPtr ApplyDelta(const DirSnapshotSPtr& snapshot,
+                                    const DirCursor& cursor,
+                                    const std::vector<DirEntryDelta>& deltas);
+
+  void CleanExpired();
+  // clean snapshot not refreshed since expired_time_s
+  void CleanExpired(uint64_t expired_time_s);
+
+  // snapshots refreshed since the timestamp(s)
+  std::vector<std::pair<Ino, DirSnapshotSPtr>> GetRefreshed(
+      uint64_t refresh_since_s);
+
+  size_t Size();
+  size_t Bytes();
+  void Summary(Json::Value& value);
+
+ private:
+  static bool IsExpired(const DirSnapshotSPtr& snapshot,
+                        uint64_t expired_time_s);
+
+  using Map = absl::flat_hash_map<Ino, DirSnapshotSPtr>;
+
+  constexpr static size_t kShardNum = 32;
+  utils::Shards<Map, kShardNum> shard_map_;
+
+  // metrics
+  bvar::Adder<uint64_t> total_count_{"meta_dir_snapshot_total_count"};
+  bvar::Adder<uint64_t> hit_count_{"meta_dir_snapshot_hit_count"};
+  bvar::Adder<uint64_t> miss_count_{"meta_dir_snapshot_miss_count"};
+  bvar::Adder<uint64_t> clean_count_{"meta_dir_snapshot_clean_count"};
+};
+
 class DirIteratorManager {
  public:
   DirIteratorManager() = default;
@@ -175,6 +175,8 @@ class Helper {
     out_slice.compaction = slice.compaction_version();
     out_slice.is_zero = slice.zero();
     out_slice.size = slice.size();
+    out_slice.pack_offset = slice.pack_offset();
+    out_slice.pack_refs = slice.pack_refs();
 
     return out_slice;
   }
@@ -188,6 +190,10 @@ class Helper {
     out_slice.set_compaction_version(slice.compaction);
     out_slice.set_zero(slice.is_zero);
     out_slice.set_size(slice.size);
+    if (slice.IsPacked()) {
+      out_slice.set_pack_offset(slice.pack_offset);
+      out_slice.set_pack_refs(slice.pack_refs);
+    }
 
     return out_slice;
   }
@@ -16,10 +16,13 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "client/vfs/metasystem/mds/helper.h"
+#include "client/vfs/metasystem/mds/slab.h"
+#include "common/const.h"
 #include "common/logging.h"
 #include "fmt/format.h"
 #include "utils/concurrent/concurrent.h"
@@ -30,99 +33,315 @@ namespace client {
 namespace vfs {
 namespace meta {
 
-bool Inode::PutIf(const AttrEntry& attr) {
-  utils::WriteLockGuard lk(lock_);
+// per shard slab of inode, process lifetime and never freed, because inode
+// may be still referenced after InodeCache destroyed.
+static constexpr size_t kInodeSlabNum = 32;
+static FixedSlab* GetInodeSlab(Ino ino) {
+  static FixedSlab* slabs = new FixedSlab[kInodeSlabNum];
+  return &slabs[ino % kInodeSlabNum];
+}
 
-  LOG_DEBUG << fmt::format(
-      "[meta.icache.{}] update attr,this({}) version({}->{}).", ino_,
-      (void*)this, version_, attr.version());
+static size_t GetInodeSlabBytes() {
+  size_t bytes = 0;
+  for (size_t i = 0; i < kInodeSlabNum; ++i) bytes += GetInodeSlab(i)->Bytes();
+  return bytes;
+}
 
+Inode::Inode(const AttrEntry& attr)
+    : fs_id_(attr.fs_id()), type_(attr.type()), ino_(attr.ino()) {
+  StoreAttr(attr);
+  ext_ = BuildExt(attr);
   UpdateLastAccessTime();
+}
 
-  if (attr.version() <= version_) {
-    return false;
+InodeSPtr Inode::New(const AttrEntry& attr) {
+  return std::allocate_shared<Inode>(
+      SlabAllocator<Inode>(GetInodeSlab(attr.ino())), attr);
+}
+
+size_t Inode::SlotSize() {
+  // allocate_shared put control block and object together, the control block
+  // type is implementation defined, so probe its size by a real allocation.
+  static_assert(sizeof(SizeProbeAllocator<Inode>) ==
+                    sizeof(SlabAllocator<Inode>),
+                "probe allocator size mismatch.");
+  static const size_t slot_size = []() {
+    size_t size = 0;
+    std::allocate_shared<Inode>(SizeProbeAllocator<Inode>(&size), AttrEntry());
+    return FixedSlab::SlotSizeOf(size);
+  }();
+
+  return slot_size;
+}
+
+Inode::ExtSPtr Inode::BuildExt(const AttrEntry& attr) {
+  if (attr.symlink().empty() && attr.parents_size() <= 1 &&
+      attr.xattrs().empty()) {
+    return nullptr;
   }
 
-  // clone new attr
-  length_ = attr.length();
-  ctime_ = attr.ctime();
-  mtime_ = attr.mtime();
-  atime_ = attr.atime();
-  uid_ = attr.uid();
-  gid_ = attr.gid();
-  mode_ = attr.mode();
-  nlink_ = attr.nlink();
-  symlink_ = attr.symlink();
-  rdev_ = attr.rdev();
-  flags_ = attr.flags();
-  maybe_tiny_file_ = attr.maybe_tiny_file();
-
-  parents_.clear();
-  parents_.insert(parents_.end(), attr.parents().begin(), attr.parents().end());
-
-  xattrs_.clear();
+  auto ext = std::make_shared<Ext>();
+  ext->symlink = attr.symlink();
+  if (attr.parents_size() > 1) {
+    ext->more_parents.assign(attr.parents().begin() + 1, attr.parents().end());
+  }
   for (const auto& xattr : attr.xattrs()) {
-    xattrs_.emplace(xattr.first, xattr.second);
+    ext->xattrs.emplace(xattr.first, xattr.second);
+  }
+
+  return ext;
+}
+
+void Inode::WriteBegin() {
+  uint32_t seq = seq_.load(std::memory_order_relaxed);
+  for (;;) {
+    if ((seq & 1) == 0 &&
+        seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                   std::memory_order_relaxed)) {
+      break;
+    }
+
+    // writer is rare and short, just spin
+    seq = seq_.load(std::memory_order_relaxed);
+  }
+
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void Inode::WriteEnd() {
+  seq_.store(seq_.load(std::memory_order_relaxed) + 1,
+             std::memory_order_release);
+}
+
+void Inode::LoadCore(Core& core, ExtSPtr& ext) const {
+  for (;;) {
+    uint32_t seq = seq_.load(std::memory_order_acquire);
+    if (seq & 1) continue;
+
+    core.length = length_.load(std::memory_order_relaxed);
+    core.ctime = ctime_.load(std::memory_order_relaxed);
+    core.mtime = mtime_.load(std::memory_order_relaxed);
+    core.atime = atime_.load(std::memory_order_relaxed);
+    core.rdev = rdev_.load(std::memory_order_relaxed);
+    core.version = version_.load(std::memory_order_relaxed);
+    core.parent = parent_.load(std::memory_order_relaxed);
+    core.uid = uid_.load(std::memory_order_relaxed);
+    core.gid = gid_.load(std::memory_order_relaxed);
+    core.mode = mode_.load(std::memory_order_relaxed);
+    core.nlink = nlink_.load(std::memory_order_relaxed);
+    core.flags = flags_.load(std::memory_order_relaxed);
+    core.maybe_tiny_file = maybe_tiny_file_.load(std::memory_order_relaxed);
+    ext = LoadExt();
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq == seq_.load(std::memory_order_relaxed)) break;
+  }
+}
+
+void Inode::StoreExt(ExtSPtr ext) {
+  if (ext != nullptr && ext->Empty()) ext = nullptr;
+  std::atomic_store(&ext_, std::move(ext));
+}
+
+std::shared_ptr<Inode::Ext> Inode::CloneExt() const {
+  auto ext = LoadExt();
+  return ext != nullptr ? std::make_shared<Ext>(*ext) : std::make_shared<Ext>();
+}
+
+void Inode::StoreAttr(const AttrEntry& attr) {
+  length_.store(attr.length(), std::memory_order_relaxed);
+  ctime_.store(attr.ctime(), std::memory_order_relaxed);
+  mtime_.store(attr.mtime(), std::memory_order_relaxed);
+  atime_.store(attr.atime(), std::memory_order_relaxed);
+  rdev_.store(attr.rdev(), std::memory_order_relaxed);
+  parent_.store(attr.parents().empty() ? 0 : attr.parents(0),
+                std::memory_order_relaxed);
+  uid_.store(attr.uid(), std::memory_order_relaxed);
+  gid_.store(attr.gid(), std::memory_order_relaxed);
+  mode_.store(attr.mode(), std::memory_order_relaxed);
+  nlink_.store(attr.nlink(), std::memory_order_relaxed);
+  flags_.store(attr.flags(), std::memory_order_relaxed);
+  maybe_tiny_file_.store(attr.maybe_tiny_file(), std::memory_order_relaxed);
+  version_.store(attr.version(), std::memory_order_relaxed);
+}
+
+std::string Inode::Symlink() const {
+  auto ext = LoadExt();
+  return ext != nullptr ? ext->symlink : "";
+}
+
+std::vector<uint64_t> Inode::Parents() const {
+  std::vector<uint64_t> parents;
+  for (;;) {
+    uint32_t seq = seq_.load(std::memory_order_acquire);
+    if (seq & 1) continue;
+
+    parents.clear();
+    mds::Ino parent = parent_.load(std::memory_order_relaxed);
+    auto ext = LoadExt();
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq != seq_.load(std::memory_order_relaxed)) continue;
+
+    if (parent != 0) parents.push_back(parent);
+    if (ext != nullptr) {
+      parents.insert(parents.end(), ext->more_parents.begin(),
+                     ext->more_parents.end());
+    }
+    break;
+  }
+
+  return parents;
+}
+
+Inode::XAttrSet Inode::ListXAttrs() const {
+  Inode::XAttrSet xattrs;
+  auto ext = LoadExt();
+  if (ext == nullptr) return xattrs;
+
+  for (const auto& [key, value] : ext->xattrs) {
+    xattrs.push_back(std::make_pair(key, value));
+  }
+
+  return xattrs;
+}
+
+std::string Inode::GetXAttr(const std::string& name) const {
+  auto ext = LoadExt();
+  if (ext == nullptr) return "";
+
+  auto it = ext->xattrs.find(name);
+  return (it != ext->xattrs.end()) ? it->second : "";
+}
+
+void Inode::SetXAttr(const std::string& name, const std::string& value) {
+  WriteBegin();
+
+  auto ext = CloneExt();
+  ext->xattrs[name] = value;
+  StoreExt(std::move(ext));
+
+  WriteEnd();
+}
+
+void Inode::RemoveXAttr(const std::string& name) {
+  WriteBegin();
+
+  auto ext = LoadExt();
+  if (ext != nullptr && ext->xattrs.count(name) > 0) {
+    auto new_ext = CloneExt();
+    new_ext->xattrs.erase(name);
+    StoreExt(std::move(new_ext));
+  }
+
+  WriteEnd();
+}
+
+bool Inode::PutIf(const AttrEntry& attr) {
+  UpdateLastAccessTime();
+
+  // fast path without entering write section
+  if (attr.version() <= Version()) return false;
+
+  // build ext out of write section, keep the section short
+  auto ext = BuildExt(attr);
+
+  WriteBegin();
+
+  uint64_t version = version_.load(std::memory_order_relaxed);
+
+  LOG_DEBUG << fmt::format(
+      "[meta.icache.{}] update attr,this({}) version({}->{}).", ino_,
+      (void*)this, version, attr.version());
+
+  if (attr.version() <= version) {
+    WriteEnd();
+    return false;
   }
 
-  version_ = attr.version();
+  StoreAttr(attr);
+  StoreExt(std::move(ext));
+
+  WriteEnd();
 
   return true;
 }
 
+void Inode::UpdateTime(uint32_t to_set, uint64_t atime, uint64_t mtime,
+                       uint64_t ctime) {
+  WriteBegin();
+
+  if (to_set & kSetAttrAtime) atime_.store(atime, std::memory_order_relaxed);
+  if (to_set & kSetAttrMtime) mtime_.store(mtime, std::memory_order_relaxed);
+  if (to_set & kSetAttrCtime) ctime_.store(ctime, std::memory_order_relaxed);
+
+  WriteEnd();
+}
+
 Attr Inode::ToAttr() const {
-  utils::ReadLockGuard lk(lock_);
+  Core core;
+  ExtSPtr ext;
+  LoadCore(core, ext);
 
   Attr attr;
   attr.ino = ino_;
-  attr.mode = mode_;
-  attr.nlink = nlink_;
-  attr.uid = uid_;
-  attr.gid = gid_;
-  attr.length = length_;
-  attr.rdev = rdev_;
-  attr.atime = atime_;
-  attr.mtime = mtime_;
-  attr.ctime = ctime_;
+  attr.mode = core.mode;
+  attr.nlink = core.nlink;
+  attr.uid = core.uid;
+  attr.gid = core.gid;
+  attr.length = core.length;
+  attr.rdev = core.rdev;
+  attr.atime = core.atime;
+  attr.mtime = core.mtime;
+  attr.ctime = core.ctime;
   attr.type = Helper::ToFileType(type_);
-  attr.flags = flags_;
-
-  attr.parents = std::vector<mds::Ino>(parents_.begin(), parents_.end());
-  for (const auto& [key, value] : xattrs_) {
-    attr.xattrs.push_back(std::make_pair(key, value));
+  attr.flags = core.flags;
+
+  if (core.parent != 0) attr.parents.push_back(core.parent);
+  if (ext != nullptr) {
+    attr.parents.insert(attr.parents.end(), ext->more_parents.begin(),
+                        ext->more_parents.end());
+    for (const auto& [key, value] : ext->xattrs) {
+      attr.xattrs.push_back(std::make_pair(key, value));
+    }
   }
 
-  attr.version = version_;
+  attr.version = core.version;
 
   return attr;
 }
 
 Inode::AttrEntry Inode::ToAttrEntry() const {
-  utils::ReadLockGuard lk(lock_);
+  Core core;
+  ExtSPtr ext;
+  LoadCore(core, ext);
 
   Inode::AttrEntry attr;
   attr.set_fs_id(fs_id_);
   attr.set_ino(ino_);
-  attr.set_length(length_);
-  attr.set_ctime(ctime_);
-  attr.set_mtime(mtime_);
-  attr.set_atime(atime_);
-  attr.set_uid(uid_);
-  attr.set_gid(gid_);
-  attr.set_mode(mode_);
-  attr.set_nlink(nlink_);
+  attr.set_length(core.length);
+  attr.set_ctime(core.ctime);
+  attr.set_mtime(core.mtime);
+  attr.set_atime(core.atime);
+  attr.set_uid(core.uid);
+  attr.set_gid(core.gid);
+  attr.set_mode(core.mode);
+  attr.set_nlink(core.nlink);
   attr.set_type(type_);
-  attr.set_symlink(symlink_);
-  attr.set_rdev(rdev_);
-  attr.set_flags(flags_);
-  attr.set_maybe_tiny_file(maybe_tiny_file_);
-  for (const auto& parent : parents_) {
-    attr.add_parents(parent);
-  }
-  for (const auto& [key, value] : xattrs_) {
-    (*attr.mutable_xattrs())[key] = value;
+  attr.set_rdev(core.rdev);
+  attr.set_flags(core.flags);
+  attr.set_maybe_tiny_file(core.maybe_tiny_file);
+  if (core.parent != 0) attr.add_parents(core.parent);
+  if (ext != nullptr) {
+    attr.set_symlink(ext->symlink);
+    for (const auto& parent : ext->more_parents) {
+      attr.add_parents(parent);
+    }
+    for (const auto& [key, value] : ext->xattrs) {
+      (*attr.mutable_xattrs())[key] = value;
+    }
   }
-  attr.set_version(version_);
+  attr.set_version(core.version);
 
   return attr;
 }
@@ -213,14 +432,29 @@ void InodeCache::CleanExpired(uint64_t expire_s) {
   }
 }
 
+std::vector<InodeSPtr> InodeCache::GetActive(uint64_t active_since_s) {
+  std::vector<InodeSPtr> inodes;
+  shard_map_.iterate([&](const Map& map) {
+    for (const auto& [_, inode] : map) {
+      if (inode->GetlastActiveTime() >= active_since_s) {
+        inodes.push_back(inode);
+      }
+    }
+  });
+
+  return inodes;
+}
+
 size_t InodeCache::Size() {
   size_t size = 0;
   shard_map_.iterate([&size](Map& map) { size += map.size(); });
   return size;
 }
 
+// map entry plus reserved bytes of inode slab, slab is shared by all caches
+// of the process and include inode still referenced outside.
 size_t InodeCache::Bytes() {
-  return Size() * (sizeof(Ino) + sizeof(InodeSPtr) + sizeof(Inode));
+  return (Size() * (sizeof(Ino) + sizeof(InodeSPtr))) + GetInodeSlabBytes();
 }
 
 void InodeCache::Summary(Json::Value& value) {
@@ -26,7 +26,6 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
-#include "absl/container/inlined_vector.h"
 #include "client/vfs/vfs_meta.h"
 #include "json/value.h"
 #include "mds/common/type.h"
@@ -47,6 +46,13 @@ using InodeCacheUPtr = std::unique_ptr<InodeCache>;
 
 using mds::Ino;
 
+// compact inode of client cache.
+// hot attrs are kept in fixed size atomic fields which guarded by a seqlock,
+// so single attr getter is one relaxed load and ToAttr/ToAttrEntry copy a
+// consistent snapshot without any lock. rare attrs(symlink, more than one
+// parent, xattrs) are kept in an immutable out of line Ext which is replaced
+// as a whole by writer, most inodes have no Ext at all.
+// inode object is allocated from per shard slab, see Inode::New.
 class Inode {
  public:
   using FileType = pb::mds::FileType;
@@ -54,137 +60,46 @@ class Inode {
   using XAttrMap = ::google::protobuf::Map<std::string, std::string>;
   using XAttrSet = std::vector<std::pair<std::string, std::string>>;
 
-  Inode(const AttrEntry& attr)
-      : fs_id_(attr.fs_id()),
-        ino_(attr.ino()),
-        type_(attr.type()),
-        length_(attr.length()),
-        ctime_(attr.ctime()),
-        mtime_(attr.mtime()),
-        atime_(attr.atime()),
-        uid_(attr.uid()),
-        gid_(attr.gid()),
-        mode_(attr.mode()),
-        nlink_(attr.nlink()),
-        symlink_(attr.symlink()),
-        rdev_(attr.rdev()),
-        flags_(attr.flags()),
-        maybe_tiny_file_(attr.maybe_tiny_file()),
-        version_(attr.version()),
-        parents_(attr.parents().begin(), attr.parents().end()),
-        last_active_time_s_(utils::Timestamp()) {
-    for (const auto& xattr : attr.xattrs()) {
-      xattrs_.emplace(xattr.first, xattr.second);
-    }
-  }
-
+  Inode(const AttrEntry& attr);
   ~Inode() = default;
 
-  static InodeSPtr New(const AttrEntry& inode) {
-    return std::make_shared<Inode>(inode);
-  }
+  static InodeSPtr New(const AttrEntry& attr);
+  // slab slot size of inode, include shared_ptr control block
+  static size_t SlotSize();
 
   uint32_t FsId() const { return fs_id_; }
   uint64_t Ino() const { return ino_; }
   FileType Type() const { return type_; }
 
-  uint64_t Length() const {
-    utils::ReadLockGuard lk(lock_);
-    return length_;
-  }
-  uint32_t Uid() const {
-    utils::ReadLockGuard lk(lock_);
-    return uid_;
-  }
-  uint32_t Gid() const {
-    utils::ReadLockGuard lk(lock_);
-    return gid_;
-  }
-  uint32_t Mode() const {
-    utils::ReadLockGuard lk(lock_);
-    return mode_;
-  }
-  uint32_t Nlink() const {
-    utils::ReadLockGuard lk(lock_);
-    return nlink_;
-  }
-  std::string Symlink() const {
-    utils::ReadLockGuard lk(lock_);
-    return symlink_;
-  }
-  uint64_t Rdev() const {
-    utils::ReadLockGuard lk(lock_);
-    return rdev_;
-  }
-  uint64_t Ctime() const {
-    utils::ReadLockGuard lk(lock_);
-
-    return ctime_;
-  }
-  uint64_t Mtime() const {
-    utils::ReadLockGuard lk(lock_);
-    return mtime_;
-  }
-  uint64_t Atime() const {
-    utils::ReadLockGuard lk(lock_);
-    return atime_;
-  }
-  uint32_t Flags() const {
-    utils::ReadLockGuard lk(lock_);
-    return flags_;
-  }
+  uint64_t Length() const { return length_.load(std::memory_order_relaxed); }
+  uint32_t Uid() const { return uid_.load(std::memory_order_relaxed); }
+  uint32_t Gid() const { return gid_.load(std::memory_order_relaxed); }
+  uint32_t Mode() const { return mode_.load(std::memory_order_relaxed); }
+  uint32_t Nlink() const { return nlink_.load(std::memory_order_relaxed); }
+  uint64_t Rdev() const { return rdev_.load(std::memory_order_relaxed); }
+  uint64_t Ctime() const { return ctime_.load(std::memory_order_relaxed); }
+  uint64_t Mtime() const { return mtime_.load(std::memory_order_relaxed); }
+  uint64_t Atime() const { return atime_.load(std::memory_order_relaxed); }
+  uint32_t Flags() const { return flags_.load(std::memory_order_relaxed); }
   bool MaybeTinyFile() const {
-    utils::ReadLockGuard lk(lock_);
-    return maybe_tiny_file_;
-  }
-  uint64_t Version() const {
-    utils::ReadLockGuard lk(lock_);
-    return version_;
-  }
-
-  bool IsDeleted() const {
-    utils::ReadLockGuard lk(lock_);
-
-    return nlink_ == 0;
-  }
-
-  std::vector<uint64_t> Parents() const {
-    utils::ReadLockGuard lk(lock_);
-
-    return std::vector<uint64_t>(parents_.begin(), parents_.end());
+    return maybe_tiny_file_.load(std::memory_order_relaxed);
   }
+  uint64_t Version() const { return version_.load(std::memory_order_relaxed); }
 
-  XAttrSet ListXAttrs() const {
-    utils::ReadLockGuard lk(lock_);
-
-    Inode::XAttrSet xattrs;
-    for (const auto& [key, value] : xattrs_) {
-      xattrs.push_back(std::make_pair(key, value));
-    }
-
-    return xattrs;
-  }
+  bool IsDeleted() const { return Nlink() == 0; }
 
-  std::string GetXAttr(const std::string& name) const {
-    utils::ReadLockGuard lk(lock_);
-
-    auto it = xattrs_.find(name);
-    return (it != xattrs_.end()) ? it->second : "";
-  }
-
-  void SetXAttr(const std::string& name, const std::string& value) {
-    utils::WriteLockGuard lk(lock_);
-
-    xattrs_[name] = value;
-  }
+  std::string Symlink() const;
+  std::vector<uint64_t> Parents() const;
 
-  void RemoveXAttr(const std::string& name) {
-    utils::WriteLockGuard lk(lock_);
-
-    xattrs_.erase(name);
-  }
+  XAttrSet ListXAttrs() const;
+  std::string GetXAttr(const std::string& name) const;
+  void SetXAttr(const std::string& name, const std::string& value);
+  void RemoveXAttr(const std::string& name);
 
   bool PutIf(const AttrEntry& attr);
+  // update time attr locally, used under attr write lease
+  void UpdateTime(uint32_t to_set, uint64_t atime, uint64_t mtime,
+                  uint64_t ctime);
 
   Attr ToAttr() const;
   AttrEntry ToAttrEntry() const;
@@ -193,33 +108,75 @@ class Inode {
   uint64_t GetlastActiveTime();
 
  private:
-  mutable utils::RWLock lock_;
+  // rare attrs, immutable after publish
+  struct Ext {
+    std::string symlink;
+    // parents except the first one
+    std::vector<mds::Ino> more_parents;
+    absl::flat_hash_map<std::string, std::string> xattrs;
+
+    bool Empty() const {
+      return symlink.empty() && more_parents.empty() && xattrs.empty();
+    }
+  };
+  using ExtSPtr = std::shared_ptr<const Ext>;
+
+  // hot attrs snapshot read under seqlock
+  struct Core {
+    uint64_t length;
+    uint64_t ctime;
+    uint64_t mtime;
+    uint64_t atime;
+    uint64_t rdev;
+    uint64_t version;
+    mds::Ino parent;
+    uint32_t uid;
+    uint32_t gid;
+    uint32_t mode;
+    uint32_t nlink;
+    uint32_t flags;
+    bool maybe_tiny_file;
+  };
+
+  static ExtSPtr BuildExt(const AttrEntry& attr);
+
+  // writer exclusive section, odd seq means writing
+  void WriteBegin();
+  void WriteEnd();
+
+  void LoadCore(Core& core, ExtSPtr& ext) const;
+  ExtSPtr LoadExt() const { return std::atomic_load(&ext_); }
+  void StoreExt(ExtSPtr ext);
+  // copy current ext or empty one, caller must be in write section
+  std::shared_ptr<Ext> CloneExt() const;
+
+  void StoreAttr(const AttrEntry& attr);
 
   const uint32_t fs_id_{0};
-  const mds::Ino ino_{0};
   const FileType type_;
+  std::atomic<uint32_t> seq_{0};
+  const mds::Ino ino_{0};
 
-  uint32_t uid_{0};
-  uint32_t gid_{0};
-  uint32_t mode_{0};
-  uint32_t nlink_{0};
-  std::string symlink_;
-  uint64_t rdev_{0};
-  uint32_t flags_;
-  bool maybe_tiny_file_{false};
-
-  static constexpr size_t kDefaultParentNum = 8;
-  absl::InlinedVector<mds::Ino, kDefaultParentNum> parents_;
-  absl::flat_hash_map<std::string, std::string> xattrs_;
-
-  uint64_t length_{0};
-  uint64_t ctime_{0};
-  uint64_t mtime_{0};
-  uint64_t atime_{0};
-
-  uint64_t version_{0};
-
-  std::atomic<uint64_t> last_active_time_s_{0};
+  std::atomic<uint64_t> length_{0};
+  std::atomic<uint64_t> ctime_{0};
+  std::atomic<uint64_t> mtime_{0};
+  std::atomic<uint64_t> atime_{0};
+  std::atomic<uint64_t> rdev_{0};
+  std::atomic<uint64_t> version_{0};
+  // first parent, 0 means no parent
+  std::atomic<mds::Ino> parent_{0};
+
+  std::atomic<uint32_t> uid_{0};
+  std::atomic<uint32_t> gid_{0};
+  std::atomic<uint32_t> mode_{0};
+  std::atomic<uint32_t> nlink_{0};
+  std::atomic<uint32_t> flags_{0};
+  std::atomic<bool> maybe_tiny_file_{false};
+
+  std::atomic<uint32_t> last_active_time_s_{0};
+
+  // null when no rare attrs
+  ExtSPtr ext_;
 };
 
 class InodeCache {
@@ -246,6 +203,9 @@ class InodeCache {
 
   void CleanExpired(uint64_t expire_s);
 
+  // inodes active since the timestamp(s)
+  std::vector<InodeSPtr> GetActive(uint64_t active_since_s);
+
   size_t Size();
   size_t Bytes();
 
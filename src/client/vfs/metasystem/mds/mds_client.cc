@@ -95,6 +95,10 @@ void MDSClient::Summary(Json::Value& value) {
   value.append(rpc_value);
 }
 
+size_t MDSClient::Bytes() {
+  return parent_memo_.Bytes() + mds_router_->Bytes() + mds_discovery_.Bytes();
+}
+
 bool MDSClient::Dump(Json::Value& value) {
   DumpOption options;
   options.parent_memo = true;
@@ -178,6 +182,17 @@ MDSMeta MDSClient::GetMdsByParent(int64_t parent, bool& is_primary_mds) {
   return mds_meta;
 }
 
+bool MDSClient::GetFollowerMds(MDSMeta& mds_meta) {
+  auto mdses = mds_discovery_.GetNormalMDS(false);
+  if (mdses.empty()) return false;
+
+  // round robin spread read load
+  uint64_t index = follower_index_.fetch_add(1, std::memory_order_relaxed);
+  mds_meta = mdses[index % mdses.size()];
+
+  return true;
+}
+
 uint64_t MDSClient::GetInodeVersion(Ino ino) {
   uint64_t version = 0;
   parent_memo_.GetVersion(ino, version);
@@ -293,7 +308,7 @@ Status MDSClient::UmountFs(const std::string& name,
 }
 
 Status MDSClient::Lookup(ContextSPtr& ctx, Ino parent, const std::string& name,
-                         AttrEntry& attr_entry) {
+                         AttrEntry& attr_entry, uint64_t* dentry_lease_ms) {
   CHECK(fs_id_ != 0) << "fs_id is invalid.";
 
   auto get_mds_fn = [this, parent](bool& is_primary_mds) -> MDSMeta {
@@ -314,8 +329,11 @@ Status MDSClient::Lookup(ContextSPtr& ctx, Ino parent, const std::string& name,
   request.set_parent(parent);
   request.set_name(name);
 
-  auto status = SendRequest(span_ctx, span, get_mds_fn, "MDSService", "Lookup",
-                            request, response);
+  auto status = SendReadRequest(span_ctx, span, get_mds_fn, "MDSService",
+                                "Lookup", request, response);
+  if (dentry_lease_ms != nullptr) {
+    *dentry_lease_ms = response.dentry_lease_ms();
+  }
   if (!status.ok()) {
     SpanScope::SetStatus(span, status);
     return status;
@@ -656,8 +674,9 @@ Status MDSClient::ReadDir(ContextSPtr& ctx, Ino ino, uint64_t fh,
   request.set_with_attr(with_attr);
   request.set_fh(fh);
 
-  auto status = SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
-                            "MDSService", "ReadDir", request, response);
+  auto status =
+      SendReadRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                      "MDSService", "ReadDir", request, response);
   if (!status.ok()) {
     SpanScope::SetStatus(span, status);
     return status;
@@ -674,13 +693,62 @@ Status MDSClient::ReadDir(ContextSPtr& ctx, Ino ino, uint64_t fh,
   return Status::OK();
 }
 
+Status MDSClient::ReadDirSince(ContextSPtr& ctx, Ino ino, DirCursor& cursor,
+                               uint32_t limit, bool with_attr,
+                               bool& is_complete,
+                               std::vector<DirEntryDelta>& deltas) {
+  CHECK(fs_id_ != 0) << "fs_id is invalid.";
+
+  auto get_mds_fn = [this, ino](bool& is_primary_mds) -> MDSMeta {
+    return GetMdsByParent(ino, is_primary_mds);
+  };
+
+  auto span = trace_manager_.StartChildSpan("MDSClient::ReadDirSince",
+                                            ctx->GetTraceSpan());
+
+  pb::mds::ReadDirSinceRequest request;
+  pb::mds::ReadDirSinceResponse response;
+
+  request.mutable_context()->set_inode_version(GetInodeVersion(ino));
+
+  request.set_fs_id(fs_id_);
+  request.set_ino(ino);
+  request.set_epoch(cursor.epoch);
+  request.set_seq(cursor.seq);
+  request.set_limit(limit);
+  request.set_with_attr(with_attr);
+
+  auto status = SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                            "MDSService", "ReadDirSince", request, response);
+  if (!status.ok()) {
+    SpanScope::SetStatus(span, status);
+    return status;
+  }
+
+  is_complete = response.is_complete();
+  cursor.epoch = response.epoch();
+  cursor.seq = response.seq();
+
+  deltas.reserve(response.deltas_size());
+  for (const auto& delta : response.deltas()) {
+    const auto& entry = delta.entry();
+    if (!delta.is_delete() && entry.has_inode()) {
+      parent_memo_.Upsert(entry.ino(), ino, entry.inode().version());
+    }
+    deltas.push_back(DirEntryDelta{.is_delete = delta.is_delete(),
+                                   .entry = Helper::ToDirEntry(entry)});
+  }
+
+  return Status::OK();
+}
+
 Status MDSClient::Open(
     ContextSPtr& ctx, Ino ino, int flags, const std::string& session_id,
     bool prefetch_chunk,
     const std::vector<mds::ChunkDescriptor>& chunk_descriptors,
     bool prefetch_data, AttrEntry& attr_entry,
     std::vector<mds::ChunkEntry>& chunks, std::string& data,
-    uint64_t& data_version) {
+    uint64_t& data_version, pb::mds::AttrLease* attr_lease) {
   CHECK(fs_id_ != 0) << "fs_id is invalid.";
   CHECK(!session_id.empty()) << "session_id is empty.";
 
@@ -721,6 +789,7 @@ Status MDSClient::Open(
     data.swap(*response.mutable_data());
     data_version = response.data_version();
   }
+  if (attr_lease != nullptr) attr_lease->Swap(response.mutable_attr_lease());
 
   parent_memo_.UpsertVersion(ino, response.inode().version());
 
@@ -989,7 +1058,8 @@ Status MDSClient::ReadLink(ContextSPtr& ctx, Ino ino, std::string& symlink) {
   return Status::OK();
 }
 
-Status MDSClient::GetAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry) {
+Status MDSClient::GetAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry,
+                          pb::mds::AttrLease* attr_lease) {
   CHECK(fs_id_ != 0) << "fs_id is invalid.";
 
   auto get_mds_fn = [this, ino](bool& is_primary_mds) -> MDSMeta {
@@ -1009,8 +1079,9 @@ Status MDSClient::GetAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry) {
   request.set_fs_id(fs_id_);
   request.set_ino(ino);
 
-  auto status = SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
-                            "MDSService", "GetAttr", request, response);
+  auto status =
+      SendReadRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                      "MDSService", "GetAttr", request, response);
   if (!status.ok()) {
     SpanScope::SetStatus(span, status);
     return status;
@@ -1019,6 +1090,50 @@ Status MDSClient::GetAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry) {
   parent_memo_.UpsertVersion(ino, response.inode().version());
 
   attr_entry.Swap(response.mutable_inode());
+  if (attr_lease != nullptr) attr_lease->Swap(response.mutable_attr_lease());
+
+  return Status::OK();
+}
+
+Status MDSClient::BatchGetAttr(ContextSPtr& ctx, const std::vector<Ino>& inos,
+                               std::vector<AttrEntry>& attr_entries,
+                               std::vector<pb::mds::AttrLease>& attr_leases) {
+  CHECK(fs_id_ != 0) << "fs_id is invalid.";
+  CHECK(!inos.empty()) << "inos is empty.";
+
+  const Ino first_ino = inos.front();
+  auto get_mds_fn = [this, first_ino](bool& is_primary_mds) -> MDSMeta {
+    return GetMds(first_ino, is_primary_mds);
+  };
+
+  auto span = trace_manager_.StartChildSpan("MDSClient::BatchGetAttr",
+                                            ctx->GetTraceSpan());
+
+  pb::mds::BatchGetInodeRequest request;
+  pb::mds::BatchGetInodeResponse response;
+
+  request.set_fs_id(fs_id_);
+  for (const auto& ino : inos) request.add_inoes(ino);
+
+  auto status = SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                            "MDSService", "BatchGetInode", request, response);
+  if (!status.ok()) {
+    SpanScope::SetStatus(span, status);
+    return status;
+  }
+
+  const bool has_lease = response.attr_leases_size() == response.inodes_size();
+  attr_entries.reserve(response.inodes_size());
+  attr_leases.reserve(response.inodes_size());
+  for (int i = 0; i < response.inodes_size(); ++i) {
+    auto* mut_inode = response.mutable_inodes(i);
+    parent_memo_.UpsertVersion(mut_inode->ino(), mut_inode->version());
+
+    attr_entries.push_back(std::move(*mut_inode));
+    attr_leases.push_back(has_lease
+                              ? std::move(*response.mutable_attr_leases(i))
+                              : pb::mds::AttrLease());
+  }
 
   return Status::OK();
 }
@@ -1324,10 +1439,40 @@ Status MDSClient::NewSliceId(ContextSPtr& ctx, uint32_t num, uint64_t* id) {
   return Status::OK();
 }
 
+Status MDSClient::NewPackId(ContextSPtr& ctx, uint64_t* id) {
+  CHECK(fs_id_ != 0) << "fs_id is invalid.";
+
+  auto get_mds_fn = [this](bool& is_primary_mds) -> MDSMeta {
+    return GetMdsByParent(kRootIno, is_primary_mds);
+  };
+
+  auto span = trace_manager_.StartChildSpan("MDSClient::NewPackId",
+                                            ctx->GetTraceSpan());
+
+  pb::mds::AllocSliceIdRequest request;
+  pb::mds::AllocSliceIdResponse response;
+
+  request.set_fs_id(fs_id_);
+  request.set_alloc_num(1);
+  request.set_is_pack(true);
+
+  auto status = SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                            "MDSService", "AllocSliceId", request, response);
+  if (!status.ok()) {
+    SpanScope::SetStatus(span, status);
+    return status;
+  }
+
+  *id = response.slice_id();
+
+  return Status::OK();
+}
+
 Status MDSClient::ReadSlice(
     ContextSPtr& ctx, Ino ino,
     const std::vector<ChunkDescriptor>& chunk_descriptors,
-    std::vector<mds::ChunkEntry>& chunks) {
+    std::vector<mds::ChunkEntry>& chunks,
+    std::vector<uint32_t>* not_modified_indexes) {
   CHECK(fs_id_ != 0) << "fs_id is invalid.";
   CHECK(ino != 0) << "ino is zero.";
 
@@ -1350,14 +1495,19 @@ Status MDSClient::ReadSlice(
   mds::Helper::VectorToPbRepeated(chunk_descriptors,
                                   request.mutable_chunk_descriptors());
 
-  auto status = SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
-                            "MDSService", "ReadSlice", request, response);
+  auto status =
+      SendReadRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                      "MDSService", "ReadSlice", request, response);
   if (!status.ok()) {
     SpanScope::SetStatus(span, status);
     return status;
   }
 
   chunks = mds::Helper::PbRepeatedToVector(*response.mutable_chunks());
+  if (not_modified_indexes != nullptr) {
+    not_modified_indexes->assign(response.not_modified_indexes().begin(),
+                                 response.not_modified_indexes().end());
+  }
 
   return Status::OK();
 }
@@ -1402,6 +1552,65 @@ Status MDSClient::WriteSlice(
   return Status::OK();
 }
 
+Status MDSClient::BatchWriteSlice(ContextSPtr& ctx,
+                                  std::vector<WriteSliceParam>& params) {
+  CHECK(fs_id_ != 0) << "fs_id is invalid.";
+  CHECK(ctx != nullptr) << "context is nullptr.";
+  CHECK(!params.empty()) << "params is empty.";
+
+  const Ino first_ino = params.front().ino;
+  auto get_mds_fn = [this, first_ino](bool& is_primary_mds) -> MDSMeta {
+    return GetMds(first_ino, is_primary_mds);
+  };
+
+  auto span = trace_manager_.StartChildSpan("MDSClient::BatchWriteSlice",
+                                            ctx->GetTraceSpan());
+  pb::mds::BatchWriteSliceRequest request;
+  pb::mds::BatchWriteSliceResponse response;
+
+  request.set_fs_id(fs_id_);
+  for (auto& param : params) {
+    SetAncestorInContext(request, param.ino);
+
+    auto* item = request.add_items();
+    item->set_ino(param.ino);
+    mds::Helper::VectorToPbRepeated(param.delta_slices,
+                                    item->mutable_delta_slices());
+  }
+
+  auto status =
+      SendRequest(SpanScope::GetContext(span, ctx), span, get_mds_fn,
+                  "MDSService", "BatchWriteSlice", request, response);
+  if (!status.ok()) {
+    SpanScope::SetStatus(span, status);
+    return status;
+  }
+
+  CHECK(response.results_size() == static_cast<int>(params.size()))
+      << fmt::format("results size({}) not match params size({}).",
+                     response.results_size(), params.size());
+
+  for (int i = 0; i < response.results_size(); ++i) {
+    auto* result = response.mutable_results(i);
+    auto& param = params[i];
+    CHECK(result->ino() == param.ino) << fmt::format(
+        "result ino({}) not match param ino({}).", result->ino(), param.ino);
+
+    param.status = TransformError(result->error());
+    if (param.status.ok()) {
+      param.out_chunks =
+          mds::Helper::PbRepeatedToVector(result->mutable_chunks());
+    }
+  }
+
+  return Status::OK();
+}
+
+uint64_t MDSClient::GetMdsId(Ino ino) {
+  bool is_primary_mds = true;
+  return GetMds(ino, is_primary_mds).ID();
+}
+
 struct CompactChunkParam {
   uint64_t version{0};
 
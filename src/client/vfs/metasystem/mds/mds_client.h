@@ -50,6 +50,17 @@ using mds::MDSMeta;
 
 using GetMdsFn = std::function<MDSMeta(bool& is_primary_mds)>;
 
+// position of dir dentry change log on mds
+struct DirCursor {
+  uint64_t epoch{0};
+  uint64_t seq{0};
+};
+
+struct DirEntryDelta {
+  bool is_delete{false};
+  DirEntry entry;
+};
+
 class MDSClient {
  public:
   MDSClient(const ClientId& client_id, mds::FsInfo& fs_info, RPC&& rpc,
@@ -60,6 +71,8 @@ class MDSClient {
   void Stop();
 
   void Summary(Json::Value& value);
+  // memory of parent memo, router and discovery
+  size_t Bytes();
   bool Dump(Json::Value& value);
   bool Dump(const DumpOption& options, Json::Value& value);
   bool Load(const Json::Value& value);
@@ -79,8 +92,9 @@ class MDSClient {
                  const pb::mds::MountPoint& mount_point);
   Status UmountFs(const std::string& name, const std::string& client_id);
 
+  // dentry_lease_ms is set even dentry not found
   Status Lookup(ContextSPtr& ctx, Ino parent, const std::string& name,
-                AttrEntry& attr_entry);
+                AttrEntry& attr_entry, uint64_t* dentry_lease_ms = nullptr);
 
   Status Create(ContextSPtr& ctx, Ino parent, const std::string& name,
                 uint32_t uid, uint32_t gid, uint32_t mode, int flag,
@@ -123,13 +137,19 @@ class MDSClient {
   Status ReadDir(ContextSPtr& ctx, Ino ino, uint64_t fh,
                  const std::string& last_name, uint32_t limit, bool with_attr,
                  std::vector<DirEntry>& entries);
+  // read dentry changes after cursor, is_complete is false when mds can not
+  // serve them incrementally, cursor is set to the latest position.
+  Status ReadDirSince(ContextSPtr& ctx, Ino ino, DirCursor& cursor,
+                      uint32_t limit, bool with_attr, bool& is_complete,
+                      std::vector<DirEntryDelta>& deltas);
 
   Status Open(ContextSPtr& ctx, Ino ino, int flags,
               const std::string& session_id, bool prefetch_chunk,
               const std::vector<mds::ChunkDescriptor>& chunk_descriptors,
               bool prefetch_data, AttrEntry& attr_entry,
               std::vector<mds::ChunkEntry>& chunks, std::string& data,
-              uint64_t& data_version);
+              uint64_t& data_version,
+              pb::mds::AttrLease* attr_lease = nullptr);
   Status Release(ContextSPtr& ctx, Ino ino, const std::string& session_id);
 
   Status FlushFile(ContextSPtr& ctx, Ino ino, uint64_t length,
@@ -150,7 +170,13 @@ class MDSClient {
                  AttrEntry& attr_entry, AttrEntry& parent_attr_entry);
   Status ReadLink(ContextSPtr& ctx, Ino ino, std::string& symlink);
 
-  Status GetAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry);
+  // get attr of file inodes served by the same mds in one rpc, not found
+  // inode is absent in attr_entries, attr_leases is parallel to attr_entries
+  Status BatchGetAttr(ContextSPtr& ctx, const std::vector<Ino>& inos,
+                      std::vector<AttrEntry>& attr_entries,
+                      std::vector<pb::mds::AttrLease>& attr_leases);
+  Status GetAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry,
+                 pb::mds::AttrLease* attr_lease = nullptr);
   Status SetAttr(ContextSPtr& ctx, Ino ino, const Attr& attr, int to_set,
                  AttrEntry& attr_entry, bool& shrink_file);
   Status GetXAttr(ContextSPtr& ctx, Ino ino, const std::string& name,
@@ -167,15 +193,33 @@ class MDSClient {
                 std::vector<Ino>& effected_inos);
 
   Status NewSliceId(ContextSPtr& ctx, uint32_t num, uint64_t* id);
+  Status NewPackId(ContextSPtr& ctx, uint64_t* id);
 
+  // chunk of descriptor with if_modified and unchanged version is returned
+  // in not_modified_indexes instead of chunks
   Status ReadSlice(ContextSPtr& ctx, Ino ino,
                    const std::vector<ChunkDescriptor>& chunk_descriptors,
-                   std::vector<mds::ChunkEntry>& chunks);
+                   std::vector<mds::ChunkEntry>& chunks,
+                   std::vector<uint32_t>* not_modified_indexes = nullptr);
 
   Status WriteSlice(ContextSPtr& ctx, Ino ino,
                     const std::vector<mds::DeltaSliceEntry>& delta_slices,
                     std::vector<mds::ChunkEntry>& out_chunks);
 
+  struct WriteSliceParam {
+    Ino ino{0};
+    std::vector<mds::DeltaSliceEntry> delta_slices;
+
+    Status status;
+    std::vector<mds::ChunkEntry> out_chunks;
+  };
+  // write slices of inodes served by the same mds in one rpc
+  Status BatchWriteSlice(ContextSPtr& ctx,
+                         std::vector<WriteSliceParam>& params);
+
+  // id of mds which serve the ino
+  uint64_t GetMdsId(Ino ino);
+
   struct CompactChunkParam {
     uint64_t version{0};
 
@@ -205,6 +249,8 @@ class MDSClient {
 
   MDSMeta GetMds(Ino ino, bool& is_primary_mds);
   MDSMeta GetMdsByParent(int64_t parent, bool& is_primary_mds);
+  // any normal mds may serve follower read
+  bool GetFollowerMds(MDSMeta& mds_meta);
 
   uint64_t GetInodeVersion(Ino ino);
   int32_t GetInodeRenameRefCount(Ino ino);
@@ -224,6 +270,13 @@ class MDSClient {
                      const std::string& api_name, Request& request,
                      Response& response);
 
+  // read with bounded staleness from follower, fallback to owner when fail
+  template <typename Request, typename Response>
+  Status SendReadRequest(ContextSPtr ctx, SpanScopeSPtr& span,
+                         GetMdsFn get_mds_fn, const std::string& service_name,
+                         const std::string& api_name, Request& request,
+                         Response& response);
+
   uint32_t fs_id_{0};
   uint64_t epoch_{0};
 
@@ -238,6 +291,8 @@ class MDSClient {
 
   MDSRouterUPtr mds_router_;
 
+  std::atomic<uint64_t> follower_index_{0};
+
   TraceManager& trace_manager_;
 };
 
@@ -324,6 +379,51 @@ Status MDSClient::SendRequest(ContextSPtr ctx, SpanScopeSPtr& span,
   return status;
 }
 
+template <typename Request, typename Response>
+Status MDSClient::SendReadRequest(ContextSPtr ctx, SpanScopeSPtr& span,
+                                  GetMdsFn get_mds_fn,
+                                  const std::string& service_name,
+                                  const std::string& api_name,
+                                  Request& request, Response& response) {
+  MDSMeta mds_meta;
+  if (!FLAGS_vfs_meta_follower_read_enable || !GetFollowerMds(mds_meta)) {
+    return SendRequest(ctx, span, get_mds_fn, service_name, api_name, request,
+                       response);
+  }
+
+  SendRequestOption option;
+  option.timeout_retry = false;
+
+  request.mutable_info()->set_request_id(
+      ctx ? ctx->SessionID() : std::to_string(utils::TimestampNs()));
+  if (span != nullptr) {
+    request.mutable_info()->set_span_id(SpanScope::GetSpanID(span));
+  }
+
+  auto* mut_ctx = request.mutable_context();
+  mut_ctx->set_client_id(client_id_.ID());
+  mut_ctx->set_epoch(epoch_);
+  mut_ctx->set_is_bypass_cache(false);
+  mut_ctx->set_is_follower_read(true);
+  mut_ctx->set_max_staleness_ms(FLAGS_vfs_meta_follower_max_staleness_ms);
+
+  auto endpoint = StrToEndpoint(mds_meta.Host(), mds_meta.Port());
+  auto status = rpc_.SendRequest(endpoint, service_name, api_name, request,
+                                 response, option);
+  // not found is a valid answer within staleness bound
+  if (status.ok() || status.Errno() == pb::error::ENOT_FOUND) return status;
+
+  LOG(INFO) << fmt::format(
+      "[meta.client] follower read fail, {} reqid({}) mds({}) status({}).",
+      api_name, request.info().request_id(), mds_meta.ID(), status.ToString());
+
+  mut_ctx->set_is_follower_read(false);
+  response.Clear();
+
+  return SendRequest(ctx, span, get_mds_fn, service_name, api_name, request,
+                     response);
+}
+
 }  // namespace meta
 }  // namespace vfs
 }  // namespace client
@@ -14,6 +14,7 @@
 
 #include "client/vfs/metasystem/mds/mds_router.h"
 
+#include <climits>
 #include <cstdint>
 
 #include "dingofs/mds.pb.h"
@@ -105,19 +106,51 @@ bool MonoMDSRouter::Dump(Json::Value& value) {
 
 void ParentHashMDSRouter::UpdateMDSes(
     const pb::mds::HashPartition& hash_partition) {
-  utils::WriteLockGuard lk(lock_);
-
+  // build new table out of rcu, readers keep using old one
+  RouteTable table;
+  table.bucket_num = hash_partition.bucket_num();
+  table.ino_affinity = hash_partition.ino_affinity();
+  table.mds_metas.resize(table.bucket_num);
   for (const auto& [mds_id, bucket_set] : hash_partition.distributions()) {
     mds::MDSMeta mds_meta;
     CHECK(mds_discovery_.GetMDS(mds_id, mds_meta))
         << fmt::format("not found mds by mds_id({}).", mds_id);
 
     for (const auto& bucket_id : bucket_set.bucket_ids()) {
-      mds_map_[bucket_id] = mds_meta;
+      CHECK(bucket_id < table.bucket_num)
+          << fmt::format("invalid bucket_id({}).", bucket_id);
+      table.mds_metas[bucket_id] = mds_meta;
     }
   }
 
-  hash_partition_ = hash_partition;
+  route_table_.Modify([&table](RouteTable& bg) {
+    bg = table;
+    return 1;
+  });
+}
+
+bool ParentHashMDSRouter::GetMDSByBucket(uint64_t hash_key,
+                                         mds::MDSMeta& mds_meta) {
+  RouteTableDBD::ScopedPtr ptr;
+  if (route_table_.Read(&ptr) != 0 || ptr->bucket_num == 0) return false;
+
+  return GetMDSByBucket(*ptr, hash_key, mds_meta);
+}
+
+bool ParentHashMDSRouter::GetMDSByBucket(const RouteTable& table,
+                                         uint64_t hash_key,
+                                         mds::MDSMeta& mds_meta) {
+  const auto& mds_meta_ref = table.mds_metas[hash_key % table.bucket_num];
+  if (mds_meta_ref.ID() == 0) {
+    LOG(ERROR) << fmt::format(
+        "[meta.router] not found mds by hash key({}), bucket({}).", hash_key,
+        hash_key % table.bucket_num);
+    return false;
+  }
+
+  mds_meta = mds_meta_ref;
+
+  return true;
 }
 
 bool ParentHashMDSRouter::Init(
@@ -132,48 +165,45 @@ bool ParentHashMDSRouter::Init(
 }
 
 bool ParentHashMDSRouter::GetMDSByParent(Ino parent, mds::MDSMeta& mds_meta) {
-  utils::ReadLockGuard lk(lock_);
-
-  int64_t bucket_id = parent % hash_partition_.bucket_num();
-  auto it = mds_map_.find(bucket_id);
-  CHECK(it != mds_map_.end())
-      << fmt::format("not found mds by parent({}).", parent);
-
-  mds_meta = it->second;
-
-  return true;
+  return GetMDSByBucket(parent, mds_meta);
 }
 
 bool ParentHashMDSRouter::GetMDS(Ino ino, mds::MDSMeta& mds_meta) {
   Ino parent = 1;
   if (ino != 1 && !parent_memo_.GetParent(ino, parent)) {
-    return false;
+    // dir ino has no affinity, its children are hashed by itself
+    if (ino & 1) return false;
+
+    RouteTableDBD::ScopedPtr ptr;
+    if (route_table_.Read(&ptr) != 0 || ptr->bucket_num == 0) return false;
+    // file ino is not allocated by affinity, caller pick a random mds
+    if (!ptr->ino_affinity) return false;
+
+    // file ino affinity bucket is same as its parent bucket, see mds
+    // FileSystem::GenFileIno. the parent may be changed by rename/link,
+    // then mds still serve it as a non-owner.
+    affinity_route_count_ << 1;
+    return GetMDSByBucket(*ptr, ino >> 1, mds_meta);
   }
 
-  utils::ReadLockGuard lk(lock_);
-
-  int64_t bucket_id = parent % hash_partition_.bucket_num();
-  auto it = mds_map_.find(bucket_id);
-  CHECK(it != mds_map_.end())
-      << fmt::format("not found mds by parent({}).", parent);
-
-  mds_meta = it->second;
-
-  return true;
+  return GetMDSByBucket(parent, mds_meta);
 }
 
 bool ParentHashMDSRouter::GetRandomlyMDS(mds::MDSMeta& mds_meta) {
-  utils::ReadLockGuard lk(lock_);
-
-  Ino parent =
-      mds::Helper::GenerateRandomInteger(0, hash_partition_.bucket_num());
-  int64_t bucket_id = parent % hash_partition_.bucket_num();
-  auto it = mds_map_.find(bucket_id);
-  CHECK(it != mds_map_.end())
-      << fmt::format("not found mds by parent({}).", parent);
+  RouteTableDBD::ScopedPtr ptr;
+  if (route_table_.Read(&ptr) != 0 || ptr->bucket_num == 0) return false;
+
+  // skip bucket without mds, e.g. during partition change
+  uint64_t start = mds::Helper::GenerateRandomInteger(0, INT32_MAX);
+  for (uint64_t i = 0; i < ptr->bucket_num; ++i) {
+    const auto& mds_meta_ref = ptr->mds_metas[(start + i) % ptr->bucket_num];
+    if (mds_meta_ref.ID() != 0) {
+      mds_meta = mds_meta_ref;
+      return true;
+    }
+  }
 
-  mds_meta = it->second;
-  return true;
+  return false;
 }
 
 bool ParentHashMDSRouter::UpdateRouter(
@@ -188,27 +218,32 @@ bool ParentHashMDSRouter::UpdateRouter(
 }
 
 size_t ParentHashMDSRouter::Size() {
-  utils::ReadLockGuard lk(lock_);
-  return mds_map_.size();
+  RouteTableDBD::ScopedPtr ptr;
+  if (route_table_.Read(&ptr) != 0) return 0;
+
+  return ptr->mds_metas.size();
 }
 
 size_t ParentHashMDSRouter::Bytes() {
-  utils::ReadLockGuard lk(lock_);
-  return sizeof(ParentHashMDSRouter) +
-         (mds_map_.size() * (sizeof(mds::MDSMeta) + sizeof(int64_t)));
+  // double buffered
+  return sizeof(ParentHashMDSRouter) + (Size() * sizeof(mds::MDSMeta) * 2);
 }
 
 void ParentHashMDSRouter::Summary(Json::Value& value) {
   value["name"] = "mdsrouter";
   value["count"] = Size();
   value["bytes"] = Bytes();
+  value["affinity_route_count"] = affinity_route_count_.get_value();
 }
 
 bool ParentHashMDSRouter::Dump(Json::Value& value) {
-  utils::ReadLockGuard lk(lock_);
+  RouteTableDBD::ScopedPtr ptr;
+  if (route_table_.Read(&ptr) != 0) return false;
 
   Json::Value mds_routers = Json::arrayValue;
-  for (const auto& [bucket_id, mds_meta] : mds_map_) {
+  for (uint32_t bucket_id = 0; bucket_id < ptr->mds_metas.size();
+       ++bucket_id) {
+    const auto& mds_meta = ptr->mds_metas[bucket_id];
     Json::Value item;
     item["bucket_id"] = bucket_id;
     item["id"] = mds_meta.ID();
@@ -17,8 +17,10 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
-#include "absl/container/flat_hash_map.h"
+#include "butil/containers/doubly_buffered_data.h"
+#include "bvar/reducer.h"
 #include "client/vfs/metasystem/mds/mds_discovery.h"
 #include "client/vfs/metasystem/mds/parent_memo.h"
 #include "dingofs/mds.pb.h"
@@ -90,6 +92,10 @@ class MonoMDSRouter : public MDSRouter {
 class ParentHashMDSRouter;
 using ParentHashMDSRouterUPtr = std::unique_ptr<ParentHashMDSRouter>;
 
+// route by parent bucket, bucket = parent % bucket_num.
+// route table is read through rcu snapshot, so routing takes no lock.
+// if fs allocate file ino with parent affinity, when parent is not in memo,
+// file ino is routed by its affinity bucket instead of random mds.
 class ParentHashMDSRouter : public MDSRouter {
  public:
   ParentHashMDSRouter(MDSDiscovery& mds_discovery, ParentMemo& parent_memo)
@@ -118,15 +124,27 @@ class ParentHashMDSRouter : public MDSRouter {
   void Summary(Json::Value& value) override;
 
  private:
+  struct RouteTable {
+    uint32_t bucket_num{0};
+    // file ino is allocated in parent bucket
+    bool ino_affinity{false};
+    // index is bucket_id
+    std::vector<mds::MDSMeta> mds_metas;
+  };
+  using RouteTableDBD = butil::DoublyBufferedData<RouteTable>;
+
   void UpdateMDSes(const pb::mds::HashPartition& hash_partition);
+  bool GetMDSByBucket(uint64_t hash_key, mds::MDSMeta& mds_meta);
+  static bool GetMDSByBucket(const RouteTable& table, uint64_t hash_key,
+                             mds::MDSMeta& mds_meta);
 
   MDSDiscovery& mds_discovery_;
   ParentMemo& parent_memo_;
 
-  utils::RWLock lock_;
-  pb::mds::HashPartition hash_partition_;
-  // bucket_id -> mds_meta
-  absl::flat_hash_map<int64_t, mds::MDSMeta> mds_map_;
+  RouteTableDBD route_table_;
+
+  // route file ino by affinity bucket for parent memo miss
+  bvar::Adder<uint64_t> affinity_route_count_{"meta_router_affinity_route"};
 };
 
 }  // namespace meta
@@ -0,0 +1,140 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "client/vfs/metasystem/mds/memory_governor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "common/options/client.h"
+#include "fmt/format.h"
+#include "glog/logging.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// evict until used bytes below this percent of budget
+static const uint32_t kLowWatermarkPercent = 90;
+static const uint64_t kMinIdleWindowS = 1;
+
+void MemoryGovernor::Register(Consumer&& consumer) {
+  CHECK(consumer.bytes_fn != nullptr) << "bytes_fn is null.";
+  if (consumer.cost_weight > 0) {
+    CHECK(consumer.max_idle_s_fn != nullptr) << "max_idle_s_fn is null.";
+    CHECK(consumer.evict_fn != nullptr) << "evict_fn is null.";
+  }
+
+  consumers_.push_back(std::move(consumer));
+}
+
+size_t MemoryGovernor::UsedBytes(std::vector<size_t>& bytes_vec) {
+  bytes_vec.resize(consumers_.size());
+
+  size_t used_bytes = 0;
+  for (size_t i = 0; i < consumers_.size(); ++i) {
+    bytes_vec[i] = consumers_[i].bytes_fn();
+    used_bytes += bytes_vec[i];
+  }
+
+  return used_bytes;
+}
+
+void MemoryGovernor::Run() {
+  const uint64_t budget_bytes =
+      FLAGS_vfs_meta_memory_budget_mb * 1024UL * 1024UL;
+
+  std::vector<size_t> bytes_vec;
+  size_t used_bytes = UsedBytes(bytes_vec);
+  const size_t origin_used_bytes = used_bytes;
+
+  uint64_t window_s = 0;
+  if (budget_bytes > 0 && used_bytes > budget_bytes) {
+    over_budget_count_ << 1;
+
+    // start from the window where every cache is bounded by its ttl
+    for (const auto& consumer : consumers_) {
+      if (consumer.cost_weight == 0) continue;
+      window_s =
+          std::max(window_s, consumer.max_idle_s_fn() / consumer.cost_weight);
+    }
+
+    const size_t target_bytes = budget_bytes / 100 * kLowWatermarkPercent;
+    const uint64_t now_s = utils::Timestamp();
+    while (used_bytes > target_bytes && window_s > kMinIdleWindowS) {
+      window_s /= 2;
+
+      for (const auto& consumer : consumers_) {
+        if (consumer.cost_weight == 0) continue;
+
+        uint64_t idle_s = std::min(window_s * consumer.cost_weight,
+                                   consumer.max_idle_s_fn());
+        consumer.evict_fn(now_s - idle_s);
+      }
+
+      evict_round_count_ << 1;
+      used_bytes = UsedBytes(bytes_vec);
+    }
+
+    if (origin_used_bytes > used_bytes) {
+      evict_bytes_ << (origin_used_bytes - used_bytes);
+    }
+
+    LOG(INFO) << fmt::format(
+        "[meta.memory] evict finish, budget({}) used({}->{}) window({}s).",
+        budget_bytes, origin_used_bytes, used_bytes, window_s);
+
+    if (used_bytes > budget_bytes) {
+      LOG(WARNING) << fmt::format(
+          "[meta.memory] still exceed budget, budget({}) used({}).",
+          budget_bytes, used_bytes);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  used_bytes_ = used_bytes;
+  idle_window_s_ = window_s;
+  consumer_bytes_.swap(bytes_vec);
+}
+
+void MemoryGovernor::Summary(Json::Value& value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  value["name"] = "memorygovernor";
+  value["budget_bytes"] = FLAGS_vfs_meta_memory_budget_mb * 1024UL * 1024UL;
+  value["used_bytes"] = used_bytes_;
+  value["idle_window_s"] = idle_window_s_;
+  value["over_budget_count"] = over_budget_count_.get_value();
+  value["evict_round_count"] = evict_round_count_.get_value();
+  value["evict_bytes"] = evict_bytes_.get_value();
+
+  Json::Value items = Json::arrayValue;
+  for (size_t i = 0; i < consumers_.size() && i < consumer_bytes_.size();
+       ++i) {
+    Json::Value item;
+    item["name"] = consumers_[i].name;
+    item["cost_weight"] = consumers_[i].cost_weight;
+    item["bytes"] = consumer_bytes_[i];
+    items.append(item);
+  }
+  value["consumers"] = items;
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
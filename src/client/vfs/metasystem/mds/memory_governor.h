@@ -0,0 +1,86 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_MDS_MEMORY_GOVERNOR_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_MDS_MEMORY_GOVERNOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bvar/reducer.h"
+#include "json/value.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// enforce one memory budget over all metadata caches.
+// when exceed the budget, shrink the idle window of every cache step by
+// step and evict entries idle longer than it, the window of cache is
+// proportional to its refetch cost, so cheap entries are evicted first.
+// the ttl of cache is the upper bound of its window.
+class MemoryGovernor {
+ public:
+  struct Consumer {
+    std::string name;
+    // relative cost of refetching, 0 means only accounting not evictable
+    uint32_t cost_weight{0};
+    std::function<size_t()> bytes_fn;
+    // upper bound of idle window
+    std::function<uint64_t()> max_idle_s_fn;
+    // evict entries not active since the timestamp(s)
+    std::function<void(uint64_t)> evict_fn;
+  };
+
+  MemoryGovernor() = default;
+  ~MemoryGovernor() = default;
+
+  // not thread safe, call before Run
+  void Register(Consumer&& consumer);
+
+  // check budget and evict, run in crontab
+  void Run();
+
+  void Summary(Json::Value& value);
+
+ private:
+  size_t UsedBytes(std::vector<size_t>& bytes_vec);
+
+  std::vector<Consumer> consumers_;
+
+  // last check result, protected by mutex_
+  std::mutex mutex_;
+  size_t used_bytes_{0};
+  uint64_t idle_window_s_{0};
+  std::vector<size_t> consumer_bytes_;
+
+  // metrics
+  bvar::Adder<uint64_t> evict_round_count_{
+      "meta_memory_governor_evict_round_count"};
+  bvar::Adder<uint64_t> evict_bytes_{"meta_memory_governor_evict_bytes"};
+  bvar::Adder<uint64_t> over_budget_count_{
+      "meta_memory_governor_over_budget_count"};
+};
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_MDS_MEMORY_GOVERNOR_H_
@@ -0,0 +1,268 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "client/vfs/metasystem/mds/meta_disk_cache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/helper.h"
+#include "common/logging.h"
+#include "dingofs/mds.pb.h"
+#include "fmt/format.h"
+#include "glog/logging.h"
+#include "leveldb/iterator.h"
+#include "leveldb/options.h"
+#include "leveldb/write_batch.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+static const std::string kInodePrefix = "I";
+
+static std::string InodeKey(Ino ino) {
+  return fmt::format("{}{:016x}", kInodePrefix, ino);
+}
+
+static std::string ChunkKey(Ino ino, uint32_t index) {
+  return fmt::format("C{:016x}{:08x}", ino, index);
+}
+
+static std::string DirKey(Ino ino) { return fmt::format("D{:016x}", ino); }
+
+// dir value: epoch(8B) + seq(8B) + ReadDirResponse with name and ino
+static constexpr size_t kDirHeaderSize = 2 * sizeof(uint64_t);
+
+static std::string EncodeDirSnapshot(const DirSnapshot& snapshot) {
+  std::string value(kDirHeaderSize, '\0');
+  memcpy(value.data(), &snapshot.cursor.epoch, sizeof(uint64_t));
+  memcpy(value.data() + sizeof(uint64_t), &snapshot.cursor.seq,
+         sizeof(uint64_t));
+
+  pb::mds::ReadDirResponse dir;
+  for (const auto& entry : *snapshot.entries) {
+    auto* mut_entry = dir.add_entries();
+    mut_entry->set_name(entry.name);
+    mut_entry->set_ino(entry.ino);
+  }
+  value.append(dir.SerializeAsString());
+
+  return value;
+}
+
+static DirSnapshotSPtr DecodeDirSnapshot(const std::string& value) {
+  if (value.size() < kDirHeaderSize) return nullptr;
+
+  pb::mds::ReadDirResponse dir;
+  if (!dir.ParseFromArray(value.data() + kDirHeaderSize,
+                          value.size() - kDirHeaderSize)) {
+    return nullptr;
+  }
+
+  auto entries = std::make_shared<std::vector<DirEntry>>();
+  entries->reserve(dir.entries_size());
+  for (const auto& entry : dir.entries()) {
+    DirEntry out_entry;
+    out_entry.name = entry.name();
+    out_entry.ino = entry.ino();
+    entries->push_back(std::move(out_entry));
+  }
+
+  auto snapshot = std::make_shared<DirSnapshot>();
+  memcpy(&snapshot->cursor.epoch, value.data(), sizeof(uint64_t));
+  memcpy(&snapshot->cursor.seq, value.data() + sizeof(uint64_t),
+         sizeof(uint64_t));
+  // attr is not persisted
+  snapshot->with_attr = false;
+  snapshot->create_time_s = utils::Timestamp();
+  snapshot->refresh_time_s = snapshot->create_time_s;
+  snapshot->entries = std::move(entries);
+
+  return snapshot;
+}
+
+MetaDiskCache::~MetaDiskCache() { Close(); }
+
+bool MetaDiskCache::Open(const std::string& path) {
+  CHECK(db_ == nullptr) << "meta disk cache already opened.";
+
+  if (!dingofs::Helper::CreateDirectory(path)) {
+    LOG(ERROR) << fmt::format("[meta.diskcache] create dir fail, path({}).",
+                              path);
+    return false;
+  }
+
+  leveldb::Options options;
+  options.create_if_missing = true;
+  auto status = leveldb::DB::Open(options, path, &db_);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.diskcache] open fail, path({}) {}.", path,
+                              status.ToString());
+    db_ = nullptr;
+    return false;
+  }
+
+  path_ = path;
+
+  LOG(INFO) << fmt::format("[meta.diskcache] open, path({}).", path);
+
+  return true;
+}
+
+void MetaDiskCache::Close() {
+  if (db_ == nullptr) return;
+
+  delete db_;
+  db_ = nullptr;
+
+  LOG(INFO) << fmt::format("[meta.diskcache] close, path({}).", path_);
+}
+
+bool MetaDiskCache::Clear() {
+  CHECK(db_ != nullptr) << "meta disk cache not opened.";
+
+  Close();
+
+  auto status = leveldb::DestroyDB(path_, leveldb::Options());
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.diskcache] destroy fail, path({}) {}.",
+                              path_, status.ToString());
+  }
+
+  return Open(path_);
+}
+
+void MetaDiskCache::Write(leveldb::WriteBatch& batch) {
+  if (db_ == nullptr) return;
+
+  // no sync, losing the tail on crash only costs a refetch
+  auto status = db_->Write(leveldb::WriteOptions(), &batch);
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format("[meta.diskcache] write fail, {}.",
+                                status.ToString());
+  }
+}
+
+void MetaDiskCache::PutInodes(const std::vector<mds::AttrEntry>& attrs) {
+  if (attrs.empty()) return;
+
+  leveldb::WriteBatch batch;
+  for (const auto& attr : attrs) {
+    batch.Put(InodeKey(attr.ino()), attr.SerializeAsString());
+  }
+  Write(batch);
+
+  put_count_ << attrs.size();
+}
+
+void MetaDiskCache::PutChunks(Ino ino,
+                              const std::vector<mds::ChunkEntry>& chunks) {
+  if (chunks.empty()) return;
+
+  leveldb::WriteBatch batch;
+  for (const auto& chunk : chunks) {
+    batch.Put(ChunkKey(ino, chunk.index()), chunk.SerializeAsString());
+  }
+  Write(batch);
+
+  put_count_ << chunks.size();
+}
+
+void MetaDiskCache::PutDirSnapshot(Ino ino, const DirSnapshot& snapshot) {
+  if (snapshot.entries == nullptr) return;
+
+  leveldb::WriteBatch batch;
+  batch.Put(DirKey(ino), EncodeDirSnapshot(snapshot));
+  Write(batch);
+
+  put_count_ << 1;
+}
+
+bool MetaDiskCache::GetChunk(Ino ino, uint32_t index, mds::ChunkEntry& chunk) {
+  if (db_ == nullptr) return false;
+
+  std::string value;
+  auto status = db_->Get(leveldb::ReadOptions(), ChunkKey(ino, index), &value);
+  if (!status.ok() || !chunk.ParseFromString(value)) {
+    miss_count_ << 1;
+    return false;
+  }
+
+  hit_count_ << 1;
+  return true;
+}
+
+DirSnapshotSPtr MetaDiskCache::GetDirSnapshot(Ino ino) {
+  if (db_ == nullptr) return nullptr;
+
+  std::string value;
+  auto status = db_->Get(leveldb::ReadOptions(), DirKey(ino), &value);
+  auto snapshot = status.ok() ? DecodeDirSnapshot(value) : nullptr;
+  if (snapshot == nullptr) {
+    miss_count_ << 1;
+    return nullptr;
+  }
+
+  hit_count_ << 1;
+  return snapshot;
+}
+
+size_t MetaDiskCache::ScanInode(
+    const std::function<void(const mds::AttrEntry&)>& handler) {
+  if (db_ == nullptr) return 0;
+
+  size_t count = 0;
+  std::unique_ptr<leveldb::Iterator> iter(
+      db_->NewIterator(leveldb::ReadOptions()));
+  for (iter->Seek(kInodePrefix); iter->Valid(); iter->Next()) {
+    if (!iter->key().starts_with(kInodePrefix)) break;
+
+    mds::AttrEntry attr;
+    if (!attr.ParseFromArray(iter->value().data(), iter->value().size())) {
+      continue;
+    }
+
+    handler(attr);
+    ++count;
+  }
+
+  return count;
+}
+
+void MetaDiskCache::Summary(Json::Value& value) {
+  value["name"] = "metadiskcache";
+  value["path"] = path_;
+  value["put_count"] = put_count_.get_value();
+  value["hit_count"] = hit_count_.get_value();
+  value["miss_count"] = miss_count_.get_value();
+
+  std::string usage;
+  if (db_ != nullptr &&
+      db_->GetProperty("leveldb.approximate-memory-usage", &usage)) {
+    value["memory_usage"] = usage;
+  }
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -21,14 +21,17 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "client/vfs/common/client_id.h"
 #include "client/vfs/metasystem/mds/helper.h"
 #include "client/vfs/metasystem/mds/mds_client.h"
+#include "bvar/latency_recorder.h"
 #include "client/vfs/vfs_meta.h"
 #include "common/const.h"
+#include "common/directory.h"
 #include "common/io_buffer.h"
 #include "common/logging.h"
 #include "common/options/client.h"
@@ -44,6 +47,8 @@
 #include "json/value.h"
 #include "json/writer.h"
 #include "mds/common/helper.h"
+#include "mds/common/synchronization.h"
+#include "utils/time.h"
 #include "utils/uuid.h"
 
 namespace dingofs {
@@ -56,6 +61,16 @@ const uint32_t kMaxXAttrValueLength = 64 * 1024;
 
 const uint32_t kHeartbeatIntervalS = 5;                     // seconds
 const uint32_t kCleanExpiredModifyTimeMemoIntervalS = 300;  // seconds
+const uint32_t kFlushExpiringDirtyAttrIntervalMs = 1000;     // milliseconds
+const uint32_t kMemoryGovernIntervalMs = 5000;               // milliseconds
+
+// relative refetch cost of meta caches, used by memory governor.
+// one inode costs one rpc for a small entry, dir snapshot costs a whole
+// listing, tiny file data is large and costs one read.
+const uint32_t kInodeCacheCostWeight = 4;
+const uint32_t kChunkCacheCostWeight = 2;
+const uint32_t kTinyFileDataCostWeight = 1;
+const uint32_t kDirSnapshotCostWeight = 8;
 
 const std::string kSliceIdCacheName = "slice";
 
@@ -65,6 +80,9 @@ DEFINE_uint32(vfs_meta_worker_num, 128, "number of meta workers");
 DEFINE_uint32(vfs_meta_worker_max_pending_num, 1048576,
               "meta worker max pending num");
 
+// latency of flush all slice of file, which fsync/flush wait for
+static bvar::LatencyRecorder meta_flush_slice_latency("meta_flush_slice");
+
 static std::vector<std::string> SplitMdsAddrs(const std::string& mds_addrs) {
   std::vector<std::string> addrs;
 
@@ -173,6 +191,10 @@ Status MDSMetaSystem::Init(bool upgrade) {
     return Status::Internal("init batch processor fail");
   }
 
+  InitMemoryGovernor();
+
+  if (FLAGS_vfs_meta_disk_cache_enable) InitMetaDiskCache();
+
   // init crontab
   if (!InitCrontab()) {
     return Status::Internal("init crontab fail");
@@ -199,6 +221,12 @@ void MDSMetaSystem::Stop(bool upgrade) {
 
   compact_processor_.Stop();
 
+  // rewrite meta disk cache with the whole working set
+  if (meta_disk_cache_.IsOpened() && meta_disk_cache_.Clear()) {
+    PersistMetaCache(0);
+  }
+  meta_disk_cache_.Close();
+
   if (!upgrade) UnmountFs();
 
   mds_client_.Stop();
@@ -230,14 +258,36 @@ bool MDSMetaSystem::GetSummary(Json::Value& value) {
   dir_iterator_manager_.Summary(dir_iterator_value);
   value.append(dir_iterator_value);
 
+  Json::Value dir_snapshot_value = Json::objectValue;
+  dir_snapshot_cache_.Summary(dir_snapshot_value);
+  value.append(dir_snapshot_value);
+
   Json::Value inode_cache_value = Json::objectValue;
   inode_cache_.Summary(inode_cache_value);
   value.append(inode_cache_value);
 
+  Json::Value dentry_cache_value = Json::objectValue;
+  dentry_cache_.Summary(dentry_cache_value);
+  value.append(dentry_cache_value);
+
+  Json::Value attr_lease_value = Json::objectValue;
+  attr_lease_cache_.Summary(attr_lease_value);
+  value.append(attr_lease_value);
+
   Json::Value tiny_file_data_cache_value = Json::objectValue;
   tiny_file_data_cache_.Summary(tiny_file_data_cache_value);
   value.append(tiny_file_data_cache_value);
 
+  Json::Value memory_governor_value = Json::objectValue;
+  memory_governor_.Summary(memory_governor_value);
+  value.append(memory_governor_value);
+
+  if (meta_disk_cache_.IsOpened()) {
+    Json::Value meta_disk_cache_value = Json::objectValue;
+    meta_disk_cache_.Summary(meta_disk_cache_value);
+    value.append(meta_disk_cache_value);
+  }
+
   mds_client_.Summary(value);
 
   return true;
@@ -309,6 +359,10 @@ bool MDSMetaSystem::Dump(const DumpOption& options, Json::Value& value) {
     return false;
   }
 
+  if (options.memory_governor) {
+    memory_governor_.Summary(value["memory_governor"]);
+  }
+
   if (options.chunk_cache && !chunk_cache_.Dump(value, options.is_summary)) {
     return false;
   }
@@ -477,6 +531,22 @@ void MDSMetaSystem::CleanExpiredInodeCache() {
   inode_cache_.CleanExpired(expired_time_s);
 }
 
+void MDSMetaSystem::CleanExpiredDentryCache() { dentry_cache_.CleanExpired(); }
+
+void MDSMetaSystem::CleanExpiredDirSnapshot() {
+  dir_snapshot_cache_.CleanExpired();
+}
+
+void MDSMetaSystem::CleanExpiredAttrLease() {
+  attr_lease_cache_.CleanExpired();
+}
+
+void MDSMetaSystem::InvalidateDentry(Ino parent) {
+  LOG(INFO) << fmt::format("[meta.fs.{}] invalidate dentry cache.", parent);
+
+  dentry_cache_.Invalidate(parent);
+}
+
 void MDSMetaSystem::CleanExpiredTinyFileDataCache() {
   uint64_t expired_time_s =
       utils::Timestamp() - FLAGS_vfs_meta_tiny_file_data_cache_expired_s;
@@ -484,6 +554,150 @@ void MDSMetaSystem::CleanExpiredTinyFileDataCache() {
   tiny_file_data_cache_.CleanExpired(expired_time_s);
 }
 
+void MDSMetaSystem::InitMemoryGovernor() {
+  // evictable caches, ttl flag is the upper bound of idle window
+  memory_governor_.Register({
+      .name = "inodecache",
+      .cost_weight = kInodeCacheCostWeight,
+      .bytes_fn = [this]() { return inode_cache_.Bytes(); },
+      .max_idle_s_fn = []() { return FLAGS_vfs_meta_inode_cache_expired_s; },
+      .evict_fn =
+          [this](uint64_t time_s) { inode_cache_.CleanExpired(time_s); },
+  });
+  memory_governor_.Register({
+      .name = "chunkcache",
+      .cost_weight = kChunkCacheCostWeight,
+      .bytes_fn = [this]() { return chunk_cache_.Bytes(); },
+      .max_idle_s_fn = []() { return FLAGS_vfs_meta_chunk_cache_expired_s; },
+      .evict_fn =
+          [this](uint64_t time_s) { chunk_cache_.CleanExpired(time_s); },
+  });
+  memory_governor_.Register({
+      .name = "tinyfiledatacache",
+      .cost_weight = kTinyFileDataCostWeight,
+      .bytes_fn = [this]() { return tiny_file_data_cache_.Bytes(); },
+      .max_idle_s_fn =
+          []() { return FLAGS_vfs_meta_tiny_file_data_cache_expired_s; },
+      .evict_fn =
+          [this](uint64_t time_s) {
+            tiny_file_data_cache_.CleanExpired(time_s);
+          },
+  });
+  memory_governor_.Register({
+      .name = "dirsnapshot",
+      .cost_weight = kDirSnapshotCostWeight,
+      .bytes_fn = [this]() { return dir_snapshot_cache_.Bytes(); },
+      .max_idle_s_fn =
+          []() -> uint64_t { return FLAGS_vfs_meta_dir_snapshot_expired_s; },
+      .evict_fn =
+          [this](uint64_t time_s) { dir_snapshot_cache_.CleanExpired(time_s); },
+  });
+
+  // state needed for correctness, only accounting
+  memory_governor_.Register({
+      .name = "modifytimememo",
+      .bytes_fn = [this]() { return modify_time_memo_.Bytes(); },
+  });
+  memory_governor_.Register({
+      .name = "chunkmemo",
+      .bytes_fn = [this]() { return chunk_memo_.Bytes(); },
+  });
+  memory_governor_.Register({
+      .name = "filesession",
+      .bytes_fn = [this]() { return file_session_map_.Bytes(); },
+  });
+  memory_governor_.Register({
+      .name = "diriterator",
+      .bytes_fn = [this]() { return dir_iterator_manager_.Bytes(); },
+  });
+  memory_governor_.Register({
+      .name = "dentrycache",
+      .bytes_fn = [this]() { return dentry_cache_.Bytes(); },
+  });
+  memory_governor_.Register({
+      .name = "mdsclient",
+      .bytes_fn = [this]() { return mds_client_.Bytes(); },
+  });
+}
+
+void MDSMetaSystem::InitMetaDiskCache() {
+  const std::string dir = FLAGS_vfs_meta_disk_cache_dir.empty()
+                              ? GetDefaultDir(kCacheDir) + "/meta"
+                              : FLAGS_vfs_meta_disk_cache_dir;
+  if (!meta_disk_cache_.Open(fmt::format("{}/{}", dir, name_))) {
+    LOG(WARNING) << "[meta.fs] open meta disk cache fail, run without it.";
+    return;
+  }
+
+  // dir attr is served from cache without lease, only file attr which is
+  // revalidated by attr lease is safe to restore
+  if (FLAGS_vfs_meta_attr_lease_enable) {
+    utils::Duration duration;
+    size_t count = 0;
+    meta_disk_cache_.ScanInode([&](const AttrEntry& attr) {
+      if (attr.type() != pb::mds::FileType::FILE) return;
+
+      PutInodeToCache(attr);
+      ++count;
+    });
+
+    LOG(INFO) << fmt::format(
+        "[meta.fs] restore inode from meta disk cache, count({}) "
+        "elapsed({}ms).",
+        count, duration.ElapsedMs());
+  }
+
+  last_persist_time_s_ = utils::Timestamp();
+}
+
+void MDSMetaSystem::PersistMetaCache(uint64_t active_since_s) {
+  const uint64_t now_s = utils::Timestamp();
+
+  std::vector<AttrEntry> attrs;
+  for (const auto& inode : inode_cache_.GetActive(active_since_s)) {
+    if (inode->Type() != pb::mds::FileType::FILE) continue;
+    attrs.push_back(inode->ToAttrEntry());
+  }
+  meta_disk_cache_.PutInodes(attrs);
+
+  // only committed slices, uncommitted ones are not visible to others
+  size_t chunk_count = 0;
+  for (const auto& chunk_set : chunk_cache_.GetActive(active_since_s)) {
+    std::vector<mds::ChunkEntry> chunks;
+    for (const auto& chunk : chunk_set->GetAll()) {
+      if (!chunk->IsCompleted()) continue;
+
+      uint64_t version = 0;
+      auto slices = chunk->GetCommitedSlice(version);
+      if (version == 0) continue;
+
+      mds::ChunkEntry chunk_entry;
+      chunk_entry.set_index(chunk->GetIndex());
+      chunk_entry.set_chunk_size(fs_info_.GetChunkSize());
+      chunk_entry.set_block_size(fs_info_.GetBlockSize());
+      chunk_entry.set_version(version);
+      for (const auto& slice : slices) {
+        *chunk_entry.add_slices() = Helper::ToSlice(slice);
+      }
+      chunks.push_back(std::move(chunk_entry));
+    }
+
+    chunk_count += chunks.size();
+    meta_disk_cache_.PutChunks(chunk_set->GetIno(), chunks);
+  }
+
+  auto snapshots = dir_snapshot_cache_.GetRefreshed(active_since_s);
+  for (const auto& [ino, snapshot] : snapshots) {
+    meta_disk_cache_.PutDirSnapshot(ino, *snapshot);
+  }
+
+  last_persist_time_s_ = now_s;
+
+  LOG(INFO) << fmt::format(
+      "[meta.fs] persist meta cache, inode({}) chunk({}) dir({}).",
+      attrs.size(), chunk_count, snapshots.size());
+}
+
 bool MDSMetaSystem::InitCrontab() {
   // add heartbeat crontab
   crontab_configs_.push_back({
@@ -504,9 +718,38 @@ bool MDSMetaSystem::InitCrontab() {
         this->CleanExpiredChunkCache();
         this->CleanExpiredInodeCache();
         this->CleanExpiredTinyFileDataCache();
+        this->CleanExpiredDentryCache();
+        this->CleanExpiredAttrLease();
+        this->CleanExpiredDirSnapshot();
       },
   });
 
+  // add memory governor crontab
+  crontab_configs_.push_back({
+      "MEMORY_GOVERN",
+      kMemoryGovernIntervalMs,
+      true,
+      [this](void*) { this->memory_governor_.Run(); },
+  });
+
+  // add persist meta cache crontab
+  if (meta_disk_cache_.IsOpened()) {
+    crontab_configs_.push_back({
+        "PERSIST_META_CACHE",
+        FLAGS_vfs_meta_disk_cache_flush_interval_s * 1000,
+        true,
+        [this](void*) { this->PersistMetaCache(last_persist_time_s_); },
+    });
+  }
+
+  // add flush dirty attr crontab
+  crontab_configs_.push_back({
+      "FLUSH_DIRTY_ATTR",
+      kFlushExpiringDirtyAttrIntervalMs,
+      true,
+      [this](void*) { this->FlushExpiringDirtyAttr(); },
+  });
+
   crontab_manager_.AddCrontab(crontab_configs_);
 
   return true;
@@ -538,10 +781,40 @@ Status MDSMetaSystem::Lookup(ContextSPtr ctx, Ino parent,
                              const std::string& name, Attr* attr) {
   AssertStop();
 
+  if (FLAGS_vfs_meta_dentry_cache_enable) {
+    Ino ino = 0;
+    if (dentry_cache_.Get(parent, name, ino)) {
+      if (ino == 0) return Status::NotExist("not found dentry");
+
+      auto inode = GetInodeFromCache(ino);
+      if (inode != nullptr) {
+        *attr = Helper::ToAttr(inode->ToAttrEntry());
+        return Status::OK();
+      }
+    }
+  }
+
+  const uint64_t request_time_ns = utils::TimestampNs();
   AttrEntry attr_entry;
-  auto status = mds_client_.Lookup(ctx, parent, name, attr_entry);
+  uint64_t dentry_lease_ms = 0;
+  Status status;
+  if (FLAGS_vfs_meta_batch_read_enable) {
+    auto operation = std::make_shared<LookupOperation>(ctx, parent, name);
+    status = RunOperation(operation);
+    if (status.ok()) {
+      attr_entry = operation->GetResult().attr_entry;
+      dentry_lease_ms = operation->GetResult().dentry_lease_ms;
+    }
+
+  } else {
+    status =
+        mds_client_.Lookup(ctx, parent, name, attr_entry, &dentry_lease_ms);
+  }
   if (!status.ok()) {
     if (status.Errno() == pb::error::ENOT_FOUND) {
+      if (FLAGS_vfs_meta_dentry_cache_enable) {
+        dentry_cache_.Put(parent, name, 0, dentry_lease_ms, request_time_ns);
+      }
       return Status::NotExist("not found dentry");
     }
     return status;
@@ -550,6 +823,10 @@ Status MDSMetaSystem::Lookup(ContextSPtr ctx, Ino parent,
   *attr = Helper::ToAttr(attr_entry);
 
   PutInodeToCache(attr_entry);
+  if (FLAGS_vfs_meta_dentry_cache_enable) {
+    dentry_cache_.Put(parent, name, attr_entry.ino(), dentry_lease_ms,
+                      request_time_ns);
+  }
 
   return Status::OK();
 }
@@ -560,6 +837,11 @@ Status MDSMetaSystem::Create(ContextSPtr ctx, Ino parent,
                              uint64_t fh) {
   AssertStop();
 
+  // mds not revoke lease of self, so forget dentry by self, forget again
+  // after done to discard lookup result raced with it
+  dentry_cache_.Delete(parent, name);
+  mds::DEFER(dentry_cache_.Delete(parent, name));
+
   std::string session_id = utils::GenerateUUID();
   AttrEntry attr_entry, parent_attr_entry;
   auto status = mds_client_.Create(ctx, parent, name, uid, gid, mode, flags,
@@ -603,6 +885,9 @@ Status MDSMetaSystem::MkNod(ContextSPtr ctx, Ino parent,
                             uint32_t mode, uint64_t rdev, Attr* attr) {
   AssertStop();
 
+  dentry_cache_.Delete(parent, name);
+  mds::DEFER(dentry_cache_.Delete(parent, name));
+
   AttrEntry attr_entry, parent_attr_entry;
   if (FLAGS_vfs_meta_batch_operation_enable) {
     auto operation = std::make_shared<MkNodOperation>(ctx, parent, name, uid,
@@ -680,13 +965,16 @@ Status MDSMetaSystem::DoOpen(ContextSPtr ctx, Ino ino, int flags, uint64_t fh,
   // check whether prefetch tiny file data
   bool is_prefetch_data = IsPrefetchTinyFileData(ino);
 
+  const uint64_t request_time_ns = utils::TimestampNs();
   AttrEntry attr_entry;
   std::vector<mds::ChunkEntry> chunks;
   std::string tiny_file_data;
   uint64_t data_version = 0;
-  auto status = mds_client_.Open(
-      ctx, ino, flags, session_id, is_prefetch_chunk, chunk_descriptors,
-      is_prefetch_data, attr_entry, chunks, tiny_file_data, data_version);
+  pb::mds::AttrLease attr_lease;
+  auto status = mds_client_.Open(ctx, ino, flags, session_id, is_prefetch_chunk,
+                                 chunk_descriptors, is_prefetch_data,
+                                 attr_entry, chunks, tiny_file_data,
+                                 data_version, &attr_lease);
 
   LOG(INFO) << fmt::format(
       "[meta.fs.{}.{}] open file flags({:o}:{}) session_id({}) "
@@ -699,6 +987,9 @@ Status MDSMetaSystem::DoOpen(ContextSPtr ctx, Ino ino, int flags, uint64_t fh,
   // update inode cache
   InodeSPtr inode = PutInodeToCache(attr_entry);
   file_session->SetInode(inode);
+  if (FLAGS_vfs_meta_attr_lease_enable) {
+    attr_lease_cache_.Put(ino, attr_lease, request_time_ns);
+  }
 
   // truncate file, forget chunk memo and delete chunk cache
   if (flags & O_TRUNC) {
@@ -891,6 +1182,9 @@ void MDSMetaSystem::AsyncClose(ContextSPtr ctx, Ino ino, uint64_t fh,
         return;
       }
 
+      // write back dirty attr before release
+      metasystem_.FlushDirtyAttr(ctx_, ino_);
+
       auto status = mds_client_.Release(ctx_, ino_, session_id_);
       if (!status.ok()) {
         LOG(ERROR) << fmt::format("[meta.fs.{}.{}] close file fail, error({}).",
@@ -954,8 +1248,22 @@ Status MDSMetaSystem::ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index,
     chunk_descriptor.set_version(
         chunk_memo_.GetVersion(ino, static_cast<uint32_t>(index)));
 
+    // revalidate persisted chunk, mds only reply whether it is modified
+    mds::ChunkEntry disk_chunk;
+    const bool has_disk_chunk =
+        meta_disk_cache_.IsOpened() &&
+        meta_disk_cache_.GetChunk(ino, static_cast<uint32_t>(index),
+                                  disk_chunk) &&
+        disk_chunk.version() >= chunk_descriptor.version();
+    if (has_disk_chunk) {
+      chunk_descriptor.set_version(disk_chunk.version());
+      chunk_descriptor.set_if_modified(true);
+    }
+
     std::vector<mds::ChunkEntry> chunks;
-    auto status = mds_client_.ReadSlice(ctx, ino, {chunk_descriptor}, chunks);
+    std::vector<uint32_t> not_modified_indexes;
+    auto status = mds_client_.ReadSlice(ctx, ino, {chunk_descriptor}, chunks,
+                                        &not_modified_indexes);
     if (!status.ok()) {
       LOG(ERROR) << fmt::format(
           "[meta.fs.{}.{}.{}] reeadslice fail, error({}).", ino, fh, index,
@@ -963,6 +1271,10 @@ Status MDSMetaSystem::ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index,
       return status;
     }
 
+    if (has_disk_chunk && !not_modified_indexes.empty()) {
+      chunks.push_back(std::move(disk_chunk));
+    }
+
     // not found chunk, return empty slice
     if (chunks.empty()) {
       mds::ChunkEntry chunk_entry;
@@ -988,6 +1300,72 @@ Status MDSMetaSystem::ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index,
   return Status::OK();
 }
 
+Status MDSMetaSystem::PrefetchSlice(ContextSPtr ctx, Ino ino, uint64_t fh,
+                                    uint64_t start_index, uint32_t count) {
+  AssertStop();
+
+  // not prefetch beyond the end of file
+  uint64_t end_index = start_index + count;
+  auto inode = GetInodeFromCache(ino);
+  if (inode != nullptr) {
+    const uint64_t chunk_size = fs_info_.GetChunkSize();
+    end_index = std::min(end_index,
+                         (inode->Length() + chunk_size - 1) / chunk_size);
+  }
+
+  auto chunk_set = chunk_cache_.GetOrCreate(ino);
+
+  // only fetch chunks not in cache, one rpc for all of them
+  std::vector<mds::ChunkDescriptor> chunk_descriptors;
+  for (uint64_t index = start_index; index < end_index; ++index) {
+    auto chunk = chunk_set->Get(index);
+    if (chunk != nullptr && chunk->IsCompleted()) continue;
+
+    mds::ChunkDescriptor chunk_descriptor;
+    chunk_descriptor.set_index(static_cast<uint32_t>(index));
+    chunk_descriptor.set_version(
+        chunk_memo_.GetVersion(ino, static_cast<uint32_t>(index)));
+    chunk_descriptors.push_back(chunk_descriptor);
+  }
+  if (chunk_descriptors.empty()) return Status::OK();
+
+  std::vector<mds::ChunkEntry> chunks;
+  auto status = mds_client_.ReadSlice(ctx, ino, chunk_descriptors, chunks);
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format(
+        "[meta.fs.{}.{}] prefetch slice [{},{}) fail, error({}).", ino, fh,
+        start_index, end_index, status.ToString());
+    return status;
+  }
+
+  // not found chunk, same as readslice, cache empty chunk
+  std::set<uint32_t> found_indexes;
+  for (const auto& chunk : chunks) found_indexes.insert(chunk.index());
+  for (const auto& chunk_descriptor : chunk_descriptors) {
+    if (found_indexes.count(chunk_descriptor.index()) > 0) continue;
+
+    mds::ChunkEntry chunk_entry;
+    chunk_entry.set_index(chunk_descriptor.index());
+    chunk_entry.set_chunk_size(fs_info_.GetChunkSize());
+    chunk_entry.set_block_size(fs_info_.GetBlockSize());
+    chunk_entry.set_version(0);
+    chunks.push_back(chunk_entry);
+  }
+
+  // update cache
+  chunk_set->Put(chunks, "prefetchslice");
+  // update chunk memo
+  for (const auto& chunk : chunks) {
+    chunk_memo_.Remember(ino, chunk.index(), chunk.version());
+  }
+
+  LOG_DEBUG << fmt::format(
+      "[meta.fs.{}.{}] prefetch slice [{},{}) fetch chunks({}).", ino, fh,
+      start_index, end_index, chunk_descriptors.size());
+
+  return Status::OK();
+}
+
 Status MDSMetaSystem::NewSliceId(ContextSPtr, Ino ino, uint64_t* id) {
   AssertStop();
 
@@ -999,6 +1377,20 @@ Status MDSMetaSystem::NewSliceId(ContextSPtr, Ino ino, uint64_t* id) {
   return Status::OK();
 }
 
+Status MDSMetaSystem::NewPackId(ContextSPtr ctx, Ino ino, uint64_t* id) {
+  AssertStop();
+
+  // not from id cache, mds must know the id is a pack
+  auto status = mds_client_.NewPackId(ctx, id);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.fs.{}] newpackid fail, error({}).", ino,
+                              status.ToString());
+    return status;
+  }
+
+  return Status::OK();
+}
+
 Status MDSMetaSystem::WriteSlice(ContextSPtr ctx, Ino ino, uint64_t index,
                                  uint64_t fh,
                                  const std::vector<Slice>& slices) {
@@ -1095,6 +1487,9 @@ Status MDSMetaSystem::MkDir(ContextSPtr ctx, Ino parent,
                             uint32_t mode, Attr* attr) {
   AssertStop();
 
+  dentry_cache_.Delete(parent, name);
+  mds::DEFER(dentry_cache_.Delete(parent, name));
+
   AttrEntry attr_entry, parent_attr_entry;
 
   if (FLAGS_vfs_meta_batch_operation_enable) {
@@ -1129,6 +1524,9 @@ Status MDSMetaSystem::RmDir(ContextSPtr ctx, Ino parent,
                             const std::string& name) {
   AssertStop();
 
+  dentry_cache_.Delete(parent, name);
+  mds::DEFER(dentry_cache_.Delete(parent, name));
+
   AttrEntry parent_attr_entry;
   Ino ino;
   auto status = mds_client_.RmDir(ctx, parent, name, ino, parent_attr_entry);
@@ -1145,11 +1543,20 @@ Status MDSMetaSystem::RmDir(ContextSPtr ctx, Ino parent,
   return Status::OK();
 }
 
-Status MDSMetaSystem::OpenDir(ContextSPtr, Ino ino, uint64_t fh,
+Status MDSMetaSystem::OpenDir(ContextSPtr ctx, Ino ino, uint64_t fh,
                               bool& need_cache) {
   AssertStop();
 
   auto dir_iterator = DirIterator::New(mds_client_, ino, fh);
+  dir_iterator->SetWarmupFunc(
+      [this, start_time_ns = ctx->start_time_ns](
+          const std::vector<DirEntry>& entries) {
+        WarmupInodeCache(start_time_ns, entries);
+      });
+
+  if (FLAGS_vfs_meta_dir_snapshot_enable) {
+    PrepareDirSnapshot(ctx, ino, dir_iterator);
+  }
 
   need_cache = false;
   dir_iterator_manager_.PutWithFunc(
@@ -1173,6 +1580,7 @@ Status MDSMetaSystem::ReadDir(ContextSPtr ctx, Ino ino, uint64_t fh,
 
   dir_iterator->Remember(offset);
 
+  bool is_from_snapshot = dir_iterator->IsFromSnapshot();
   while (true) {
     DirEntry entry;
     auto status = dir_iterator->GetValue(ctx, offset++, with_attr, entry);
@@ -1183,6 +1591,14 @@ Status MDSMetaSystem::ReadDir(ContextSPtr ctx, Ino ino, uint64_t fh,
       return status;
     }
 
+    // attr in snapshot may be older than inode cache
+    if (is_from_snapshot && with_attr) {
+      auto inode = GetInodeFromCache(entry.ino);
+      if (inode != nullptr && inode->Version() > entry.attr.version) {
+        entry.attr = inode->ToAttr();
+      }
+    }
+
     bool is_amend = false;
     CorrectAttr(ctx, dir_iterator->LastFetchTimeNs(), entry.attr, is_amend,
                 "readdir");
@@ -1200,14 +1616,69 @@ Status MDSMetaSystem::ReadDir(ContextSPtr ctx, Ino ino, uint64_t fh,
 Status MDSMetaSystem::ReleaseDir(ContextSPtr, Ino ino, uint64_t fh) {
   AssertStop();
 
+  auto dir_iterator = dir_iterator_manager_.Get(ino, fh);
+  if (dir_iterator != nullptr) {
+    auto snapshot = dir_iterator->TakeSnapshot();
+    if (snapshot != nullptr) dir_snapshot_cache_.Put(ino, snapshot);
+  }
+
   dir_iterator_manager_.Delete(ino, fh);
   return Status::OK();
 }
 
+void MDSMetaSystem::PrepareDirSnapshot(ContextSPtr& ctx, Ino ino,
+                                       DirIteratorSPtr& dir_iterator) {
+  auto snapshot = dir_snapshot_cache_.Get(ino);
+  // persisted listing is revalidated by the changes since its cursor
+  if (snapshot == nullptr && meta_disk_cache_.IsOpened()) {
+    snapshot = meta_disk_cache_.GetDirSnapshot(ino);
+  }
+
+  DirCursor cursor = (snapshot != nullptr) ? snapshot->cursor : DirCursor{};
+  bool with_attr = (snapshot != nullptr) ? snapshot->with_attr : false;
+
+  bool is_complete = false;
+  std::vector<DirEntryDelta> deltas;
+  auto status = mds_client_.ReadDirSince(ctx, ino, cursor,
+                                         FLAGS_vfs_meta_dir_delta_max_count,
+                                         with_attr, is_complete, deltas);
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format(
+        "[meta.fs.{}] read dir since fail, error({}).", ino,
+        status.ToString());
+    return;
+  }
+
+  if (snapshot != nullptr && is_complete) {
+    // cost scales with the changes, not the dir size
+    snapshot = DirSnapshotCache::ApplyDelta(snapshot, cursor, deltas);
+    dir_snapshot_cache_.Put(ino, snapshot);
+
+    dir_iterator->LoadSnapshot(snapshot);
+    return;
+  }
+
+  // full listing, changes after the cursor will be applied next time
+  dir_iterator->EnableSnapshot(cursor);
+}
+
+void MDSMetaSystem::WarmupInodeCache(uint64_t start_time_ns,
+                                     const std::vector<DirEntry>& entries) {
+  for (const auto& entry : entries) {
+    // modified by self after fetch, leave it to correct when consume
+    if (modify_time_memo_.ModifiedSince(entry.ino, start_time_ns)) continue;
+
+    PutInodeToCache(Helper::ToAttr(entry.attr));
+  }
+}
+
 Status MDSMetaSystem::Link(ContextSPtr ctx, Ino ino, Ino new_parent,
                            const std::string& new_name, Attr* attr) {
   AssertStop();
 
+  dentry_cache_.Delete(new_parent, new_name);
+  mds::DEFER(dentry_cache_.Delete(new_parent, new_name));
+
   AttrEntry attr_entry, parent_attr_entry;
   auto status = mds_client_.Link(ctx, ino, new_parent, new_name, attr_entry,
                                  parent_attr_entry);
@@ -1229,6 +1700,9 @@ Status MDSMetaSystem::Unlink(ContextSPtr ctx, Ino parent,
                              const std::string& name) {
   AssertStop();
 
+  dentry_cache_.Delete(parent, name);
+  mds::DEFER(dentry_cache_.Delete(parent, name));
+
   AttrEntry attr_entry, parent_attr_entry;
 
   if (FLAGS_vfs_meta_batch_operation_enable) {
@@ -1266,6 +1740,9 @@ Status MDSMetaSystem::Symlink(ContextSPtr ctx, Ino parent,
                               Attr* attr) {
   AssertStop();
 
+  dentry_cache_.Delete(parent, name);
+  mds::DEFER(dentry_cache_.Delete(parent, name));
+
   AttrEntry attr_entry, parent_attr_entry;
   auto status = mds_client_.Symlink(ctx, parent, name, uid, gid, link,
                                     attr_entry, parent_attr_entry);
@@ -1304,13 +1781,16 @@ Status MDSMetaSystem::GetAttr(ContextSPtr ctx, Ino ino, Attr* attr) {
 
   AttrEntry attr_entry;
 
+  // file attr is served from cache only under lease when enable attr lease
+  const bool use_lease = FLAGS_vfs_meta_attr_lease_enable && !mds::IsDir(ino);
+
   auto inode = GetInodeFromCache(ino);
-  if (inode != nullptr) {
+  if (inode != nullptr && (!use_lease || attr_lease_cache_.Check(ino))) {
     attr_entry = inode->ToAttrEntry();
     // ctx->hit_cache = true;
 
   } else {
-    auto status = mds_client_.GetAttr(ctx, ino, attr_entry);
+    auto status = FetchAttr(ctx, ino, attr_entry);
     if (!status.ok()) return status;
   }
 
@@ -1326,10 +1806,50 @@ Status MDSMetaSystem::GetAttr(ContextSPtr ctx, Ino ino, Attr* attr) {
   return Status::OK();
 }
 
+// fetch attr from mds, concurrent fetch of files are merged into batch rpc,
+// cache it when granted attr lease.
+Status MDSMetaSystem::FetchAttr(ContextSPtr& ctx, Ino ino,
+                                AttrEntry& attr_entry) {
+  const bool use_lease = FLAGS_vfs_meta_attr_lease_enable && !mds::IsDir(ino);
+
+  const uint64_t request_time_ns = utils::TimestampNs();
+  pb::mds::AttrLease attr_lease;
+  if (FLAGS_vfs_meta_batch_read_enable && !mds::IsDir(ino)) {
+    auto operation = std::make_shared<GetAttrOperation>(ctx, ino);
+    auto status = RunOperation(operation);
+    if (!status.ok()) return status;
+
+    attr_entry = operation->GetResult().attr_entry;
+    attr_lease = operation->GetResult().attr_lease;
+
+  } else {
+    auto status = mds_client_.GetAttr(ctx, ino, attr_entry, &attr_lease);
+    if (!status.ok()) return status;
+  }
+
+  if (use_lease && attr_lease.type() != pb::mds::ATTR_LEASE_NONE) {
+    PutInodeToCache(attr_entry);
+    attr_lease_cache_.Put(ino, attr_lease, request_time_ns);
+  }
+
+  return Status::OK();
+}
+
 Status MDSMetaSystem::SetAttr(ContextSPtr ctx, Ino ino, int set,
                               const Attr& attr, Attr* out_attr) {
   AssertStop();
 
+  // only change time attr, update locally under write lease
+  const int kSetTimeMask = kSetAttrAtime | kSetAttrMtime | kSetAttrAtimeNow |
+                           kSetAttrMtimeNow | kSetAttrCtime;
+  if (FLAGS_vfs_meta_attr_lease_enable && (set & ~kSetTimeMask) == 0) {
+    auto inode = GetInodeFromCache(ino);
+    if (inode != nullptr && SetAttrLocally(inode, set, attr)) {
+      *out_attr = inode->ToAttr();
+      return Status::OK();
+    }
+  }
+
   AttrEntry attr_entry;
   bool shrink_file;
   auto status =
@@ -1352,6 +1872,90 @@ Status MDSMetaSystem::SetAttr(ContextSPtr ctx, Ino ino, int set,
   return Status::OK();
 }
 
+bool MDSMetaSystem::SetAttrLocally(InodeSPtr& inode, int set,
+                                   const Attr& attr) {
+  const uint64_t now_ns = utils::TimestampNs();
+
+  AttrLeaseCache::DirtyAttr dirty_attr;
+  if (set & kSetAttrAtime) {
+    dirty_attr.atime = attr.atime;
+    dirty_attr.to_set |= kSetAttrAtime;
+  } else if (set & kSetAttrAtimeNow) {
+    dirty_attr.atime = now_ns;
+    dirty_attr.to_set |= kSetAttrAtime;
+  }
+
+  if (set & kSetAttrMtime) {
+    dirty_attr.mtime = attr.mtime;
+    dirty_attr.to_set |= kSetAttrMtime;
+  } else if (set & kSetAttrMtimeNow) {
+    dirty_attr.mtime = now_ns;
+    dirty_attr.to_set |= kSetAttrMtime;
+  }
+
+  // always update ctime
+  dirty_attr.ctime = (set & kSetAttrCtime) ? attr.ctime : now_ns;
+  dirty_attr.to_set |= kSetAttrCtime;
+
+  if (!attr_lease_cache_.SetDirty(inode->Ino(), dirty_attr)) return false;
+
+  inode->UpdateTime(dirty_attr.to_set, dirty_attr.atime, dirty_attr.mtime,
+                    dirty_attr.ctime);
+
+  return true;
+}
+
+Status MDSMetaSystem::FlushDirtyAttr(ContextSPtr ctx, Ino ino) {
+  AttrLeaseCache::DirtyAttr dirty_attr;
+  if (!attr_lease_cache_.TakeDirty(ino, dirty_attr)) return Status::OK();
+
+  Attr attr;
+  attr.atime = dirty_attr.atime;
+  attr.mtime = dirty_attr.mtime;
+  attr.ctime = dirty_attr.ctime;
+
+  AttrEntry attr_entry;
+  bool shrink_file;
+  auto status = mds_client_.SetAttr(ctx, ino, attr, dirty_attr.to_set,
+                                    attr_entry, shrink_file);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[meta.fs.{}] flush dirty attr fail, error({}).",
+                              ino, status.ToString());
+    return status;
+  }
+
+  PutInodeToCache(attr_entry);
+
+  return Status::OK();
+}
+
+void MDSMetaSystem::FlushExpiringDirtyAttr() {
+  const uint64_t expire_time_ns =
+      utils::TimestampNs() + kFlushExpiringDirtyAttrIntervalMs * 2 * 1000000;
+  auto inos = attr_lease_cache_.GetDirtyExpiring(expire_time_ns);
+  if (inos.empty()) return;
+
+  auto ctx = std::make_shared<Context>("");
+  for (const auto& ino : inos) {
+    FlushDirtyAttr(ctx, ino);
+  }
+}
+
+void MDSMetaSystem::RecallAttrLease(Ino ino) {
+  utils::Duration duration;
+
+  // write back data and dirty attr before give up lease
+  auto ctx = std::make_shared<Context>("");
+  if (file_session_map_.GetSession(ino) != nullptr) FlushSlice(ctx, ino);
+  FlushDirtyAttr(ctx, ino);
+
+  attr_lease_cache_.Recall(ino);
+  attr_lease_cache_.ObserveRecallLatency(duration.ElapsedUs());
+
+  LOG(INFO) << fmt::format("[meta.fs.{}][{}us] recall attr lease.", ino,
+                           duration.ElapsedUs());
+}
+
 Status MDSMetaSystem::GetXattr(ContextSPtr ctx, Ino ino,
                                const std::string& name, std::string* value) {
   AssertStop();
@@ -1364,6 +1968,19 @@ Status MDSMetaSystem::GetXattr(ContextSPtr ctx, Ino ino,
     return Status::OK();
   }
 
+  // file xattrs come along with attr, so share the batched attr fetch
+  if (FLAGS_vfs_meta_batch_read_enable && !mds::IsDir(ino)) {
+    AttrEntry attr_entry;
+    auto status = FetchAttr(ctx, ino, attr_entry);
+    if (!status.ok()) {
+      return Status::NoData(status.Errno(), status.ToString());
+    }
+
+    auto it = attr_entry.xattrs().find(name);
+    *value = (it != attr_entry.xattrs().end()) ? it->second : "";
+    return Status::OK();
+  }
+
   // get xattr from mds
   auto status = mds_client_.GetXAttr(ctx, ino, name, *value);
   if (!status.ok()) {
@@ -1438,6 +2055,11 @@ Status MDSMetaSystem::Rename(ContextSPtr ctx, Ino old_parent,
                              const std::string& new_name) {
   AssertStop();
 
+  dentry_cache_.Delete(old_parent, old_name);
+  dentry_cache_.Delete(new_parent, new_name);
+  mds::DEFER(dentry_cache_.Delete(old_parent, old_name);
+             dentry_cache_.Delete(new_parent, new_name));
+
   std::vector<Ino> effected_inos;
   auto status = mds_client_.Rename(ctx, old_parent, old_name, new_parent,
                                    new_name, effected_inos);
@@ -1581,6 +2203,8 @@ Status MDSMetaSystem::FlushSlice(ContextSPtr ctx, Ino ino) {
 
   LOG(INFO) << fmt::format("[meta.fs.{}] flush all slice.", ino);
 
+  utils::Duration duration;
+
   do {
     bool has_stage = chunk_set->HasStage();
     bool has_committing = chunk_set->HasCommitting();
@@ -1597,7 +2221,11 @@ Status MDSMetaSystem::FlushSlice(ContextSPtr ctx, Ino ino) {
   } while (true);
 
   // flush file length and data
-  return FlushFile(ctx, GetInode(file_session), chunk_set);
+  auto status = FlushFile(ctx, GetInode(file_session), chunk_set);
+
+  meta_flush_slice_latency << duration.ElapsedUs();
+
+  return status;
 }
 
 void MDSMetaSystem::FlushAllSlice() {
@@ -22,15 +22,19 @@
 
 #include "client/vfs/common/client_id.h"
 #include "client/vfs/compaction/compactor.h"
+#include "client/vfs/metasystem/mds/attr_lease.h"
 #include "client/vfs/metasystem/mds/batch_processor.h"
 #include "client/vfs/metasystem/mds/chunk.h"
 #include "client/vfs/metasystem/mds/chunk_memo.h"
 #include "client/vfs/metasystem/mds/compact.h"
+#include "client/vfs/metasystem/mds/dentry_cache.h"
 #include "client/vfs/metasystem/mds/dir_iterator.h"
 #include "client/vfs/metasystem/mds/executor.h"
 #include "client/vfs/metasystem/mds/file_session.h"
 #include "client/vfs/metasystem/mds/id_cache.h"
 #include "client/vfs/metasystem/mds/inode_cache.h"
+#include "client/vfs/metasystem/mds/memory_governor.h"
+#include "client/vfs/metasystem/mds/meta_disk_cache.h"
 #include "client/vfs/metasystem/mds/mds_client.h"
 #include "client/vfs/metasystem/mds/modify_time_memo.h"
 #include "client/vfs/metasystem/mds/tiny_file_data.h"
@@ -114,7 +118,11 @@ class MDSMetaSystem : public vfs::MetaSystem {
   Status ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index, uint64_t fh,
                    std::vector<Slice>* slices, uint64_t& version) override;
 
+  Status PrefetchSlice(ContextSPtr ctx, Ino ino, uint64_t fh,
+                       uint64_t start_index, uint32_t count) override;
+
   Status NewSliceId(ContextSPtr ctx, Ino ino, uint64_t* id) override;
+  Status NewPackId(ContextSPtr ctx, Ino ino, uint64_t* id) override;
 
   Status WriteSlice(ContextSPtr ctx, Ino ino, uint64_t index, uint64_t fh,
                     const std::vector<Slice>& slices) override;
@@ -164,6 +172,9 @@ class MDSMetaSystem : public vfs::MetaSystem {
   Status Compact(ContextSPtr ctx, Ino ino, uint32_t chunk_index,
                  bool is_async) override;
 
+  void InvalidateDentry(Ino parent) override;
+  void RecallAttrLease(Ino ino) override;
+
   bool GetDescription(Json::Value& value) override;
 
  private:
@@ -180,8 +191,24 @@ class MDSMetaSystem : public vfs::MetaSystem {
   void CleanExpiredChunkCache();
   void CleanExpiredInodeCache();
   void CleanExpiredTinyFileDataCache();
+  void CleanExpiredDentryCache();
+  void CleanExpiredAttrLease();
+  void CleanExpiredDirSnapshot();
 
   bool InitCrontab();
+  void InitMemoryGovernor();
+
+  // open meta disk cache and restore inodes
+  void InitMetaDiskCache();
+  // persist caches active since the timestamp(s) to meta disk cache
+  void PersistMetaCache(uint64_t active_since_s);
+
+  // serve opendir from snapshot or prepare building snapshot
+  void PrepareDirSnapshot(ContextSPtr& ctx, Ino ino,
+                          DirIteratorSPtr& dir_iterator);
+  // put attr of read dir batch into inode cache in advance
+  void WarmupInodeCache(uint64_t start_time_ns,
+                        const std::vector<DirEntry>& entries);
 
   // inode cache
   InodeSPtr PutInodeToCache(const AttrEntry& attr_entry) {
@@ -208,6 +235,11 @@ class MDSMetaSystem : public vfs::MetaSystem {
   // flush slices of all files
   void FlushAllSlice();
 
+  // attr lease
+  bool SetAttrLocally(InodeSPtr& inode, int set, const Attr& attr);
+  Status FlushDirtyAttr(ContextSPtr ctx, Ino ino);
+  void FlushExpiringDirtyAttr();
+
   Status CorrectAttr(ContextSPtr ctx, uint64_t time_ns, Attr& attr,
                      bool& is_amend, const std::string& caller);
   bool CorrectAttrLength(Attr& attr, const std::string& caller);
@@ -224,6 +256,7 @@ class MDSMetaSystem : public vfs::MetaSystem {
 
   // batch operation
   Status RunOperation(OperationSPtr operation);
+  Status FetchAttr(ContextSPtr& ctx, Ino ino, AttrEntry& attr_entry);
 
   void AssertStop() {
     CHECK(!stopped_.load(std::memory_order_relaxed)) << "metasystem is stopped";
@@ -248,11 +281,23 @@ class MDSMetaSystem : public vfs::MetaSystem {
 
   DirIteratorManager dir_iterator_manager_;
 
+  // dir snapshot cache
+  DirSnapshotCache dir_snapshot_cache_;
+
   IdCache id_cache_;
   InodeCache inode_cache_;
+  DentryCache dentry_cache_;
+  AttrLeaseCache attr_lease_cache_;
 
   TinyFileDataCache tiny_file_data_cache_;
 
+  // enforce memory budget over meta caches
+  MemoryGovernor memory_governor_;
+
+  // persist meta caches on local disk for warm remount
+  MetaDiskCache meta_disk_cache_;
+  uint64_t last_persist_time_s_{0};
+
   // Crontab config
   std::vector<mds::CrontabConfig> crontab_configs_;
   // This is manage crontab, like heartbeat.
@@ -15,6 +15,7 @@
 #ifndef DINGOFS_SRC_CLIENT_VFS_META_MDS_RPC_H_
 #define DINGOFS_SRC_CLIENT_VFS_META_MDS_RPC_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <memory>
@@ -60,8 +61,16 @@ inline bool IsInvalidEndpoint(const EndPoint& endpoint) {
 }
 
 inline uint32_t CalWaitTimeUs(int retry) {
-  // exponential backoff
-  return mds::Helper::GenerateRealRandomInteger(50000, 100000) * (1 << retry);
+  // exponential backoff with full jitter, so clients failed together do not
+  // retry together, the wait is bounded by max wait
+  constexpr int64_t kBaseWaitUs = 50000;
+  const int64_t max_wait_us =
+      static_cast<int64_t>(FLAGS_vfs_meta_rpc_retry_max_wait_ms) * 1000;
+  const int64_t ceil_us =
+      std::min(kBaseWaitUs << std::min(retry, 16), max_wait_us);
+
+  return mds::Helper::GenerateRealRandomInteger(
+      kBaseWaitUs / 2, std::max(ceil_us, kBaseWaitUs / 2));
 }
 
 inline bool IsRetry(int& retry, int max_retry) {
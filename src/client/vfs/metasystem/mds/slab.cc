@@ -0,0 +1,145 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "client/vfs/metasystem/mds/slab.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "glog/logging.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+static size_t AlignUp(size_t size, size_t align) {
+  return (size + align - 1) / align * align;
+}
+
+FixedSlab::FixedSlab(size_t chunk_bytes) : chunk_bytes_(chunk_bytes) {
+  CHECK(chunk_bytes_ > 0 && (chunk_bytes_ & (chunk_bytes_ - 1)) == 0)
+      << "chunk size must be power of 2.";
+}
+
+FixedSlab::~FixedSlab() {
+  for (auto& [addr, chunk] : chunks_) {
+    ::operator delete(reinterpret_cast<void*>(addr),
+                      std::align_val_t(chunk_bytes_));
+  }
+}
+
+void* FixedSlab::Allocate(size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (slot_size_ == 0) {
+    slot_size_ = SlotSizeOf(size);
+    CHECK(slot_size_ <= chunk_bytes_) << "slot size exceed chunk size.";
+    slot_num_ = chunk_bytes_ / slot_size_;
+  }
+
+  if (size > slot_size_) {
+    large_bytes_ += size;
+    return ::operator new(size);
+  }
+
+  if (partial_chunks_.empty()) NewChunk();
+
+  auto addr = *partial_chunks_.begin();
+  auto& chunk = chunks_[addr];
+  FreeNode* node = chunk.free_list;
+  chunk.free_list = node->next;
+  if (--chunk.free_count == 0) partial_chunks_.erase(addr);
+  ++used_count_;
+
+  return node;
+}
+
+void FixedSlab::Deallocate(void* ptr, size_t size) {
+  if (ptr == nullptr) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (size > slot_size_) {
+    large_bytes_ -= size;
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto addr = reinterpret_cast<uintptr_t>(ptr) & ~(chunk_bytes_ - 1);
+  auto it = chunks_.find(addr);
+  CHECK(it != chunks_.end()) << "slot not belong to slab.";
+
+  auto& chunk = it->second;
+  auto* node = static_cast<FreeNode*>(ptr);
+  node->next = chunk.free_list;
+  chunk.free_list = node;
+  if (++chunk.free_count == 1) partial_chunks_.insert(addr);
+  --used_count_;
+
+  if (chunk.free_count == slot_num_ && chunks_.size() > 1) FreeChunk(addr);
+}
+
+size_t FixedSlab::SlotSizeOf(size_t size) {
+  return AlignUp(std::max(size, sizeof(FreeNode)), alignof(std::max_align_t));
+}
+
+void FixedSlab::NewChunk() {
+  auto* data = static_cast<char*>(
+      ::operator new(chunk_bytes_, std::align_val_t(chunk_bytes_)));
+  auto addr = reinterpret_cast<uintptr_t>(data);
+
+  auto& chunk = chunks_[addr];
+  for (size_t i = 0; i < slot_num_; ++i) {
+    auto* node = reinterpret_cast<FreeNode*>(data + (i * slot_size_));
+    node->next = chunk.free_list;
+    chunk.free_list = node;
+  }
+  chunk.free_count = slot_num_;
+
+  partial_chunks_.insert(addr);
+}
+
+void FixedSlab::FreeChunk(uintptr_t addr) {
+  partial_chunks_.erase(addr);
+  chunks_.erase(addr);
+
+  ::operator delete(reinterpret_cast<void*>(addr),
+                    std::align_val_t(chunk_bytes_));
+}
+
+size_t FixedSlab::Bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return (chunks_.size() * chunk_bytes_) + large_bytes_;
+}
+
+size_t FixedSlab::UsedCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return used_count_;
+}
+
+size_t FixedSlab::ChunkCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return chunks_.size();
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,162 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_MDS_SLAB_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_MDS_SLAB_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+// allocate fixed size slots from large chunks, avoid per object malloc
+// header and fragmentation. the slot size is decided by first allocation,
+// larger allocation fallback to operator new. chunk is aligned to its size,
+// so the chunk of a slot is found by mask. slot is allocated from the lowest
+// address chunk with free slot to keep others drained, and a chunk is
+// returned once all its slots are free, except the last one.
+class FixedSlab {
+ public:
+  // chunk_bytes must be power of 2
+  explicit FixedSlab(size_t chunk_bytes = kDefaultChunkBytes);
+  ~FixedSlab();
+
+  FixedSlab(const FixedSlab&) = delete;
+  FixedSlab& operator=(const FixedSlab&) = delete;
+
+  void* Allocate(size_t size);
+  void Deallocate(void* ptr, size_t size);
+
+  // slot size used for allocation of size
+  static size_t SlotSizeOf(size_t size);
+
+  // reserved bytes of chunks and fallback allocation
+  size_t Bytes();
+  size_t UsedCount();
+  size_t ChunkCount();
+
+ private:
+  static constexpr size_t kDefaultChunkBytes = 64 * 1024;
+
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  struct Chunk {
+    FreeNode* free_list{nullptr};
+    size_t free_count{0};
+  };
+
+  void NewChunk();
+  void FreeChunk(uintptr_t addr);
+
+  const size_t chunk_bytes_;
+
+  std::mutex mutex_;
+  size_t slot_size_{0};
+  size_t slot_num_{0};
+  // chunk address -> chunk
+  std::unordered_map<uintptr_t, Chunk> chunks_;
+  // chunks which has free slot, ordered by address
+  std::set<uintptr_t> partial_chunks_;
+  size_t used_count_{0};
+  size_t large_bytes_{0};
+};
+
+// std allocator adapter of FixedSlab, used by std::allocate_shared
+template <typename T>
+class SlabAllocator {
+ public:
+  using value_type = T;
+
+  explicit SlabAllocator(FixedSlab* slab) : slab_(slab) {}
+  template <typename U>
+  SlabAllocator(const SlabAllocator<U>& other)  // NOLINT
+      : slab_(other.slab_) {}
+
+  T* allocate(size_t n) {
+    if (n != 1) return std::allocator<T>().allocate(n);
+    return static_cast<T*>(slab_->Allocate(sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    if (n != 1) return std::allocator<T>().deallocate(ptr, n);
+    slab_->Deallocate(ptr, sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const SlabAllocator<U>& other) const {
+    return slab_ == other.slab_;
+  }
+  template <typename U>
+  bool operator!=(const SlabAllocator<U>& other) const {
+    return slab_ != other.slab_;
+  }
+
+ private:
+  template <typename U>
+  friend class SlabAllocator;
+
+  FixedSlab* slab_;
+};
+
+// std allocator which only record the allocated bytes, used to get the real
+// allocation size of allocator aware construction, e.g. the control block of
+// std::allocate_shared which type is implementation defined.
+template <typename T>
+class SizeProbeAllocator {
+ public:
+  using value_type = T;
+
+  explicit SizeProbeAllocator(size_t* size) : size_(size) {}
+  template <typename U>
+  SizeProbeAllocator(const SizeProbeAllocator<U>& other)  // NOLINT
+      : size_(other.size_) {}
+
+  T* allocate(size_t n) {
+    *size_ = sizeof(T) * n;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* ptr, size_t n) { std::allocator<T>().deallocate(ptr, n); }
+
+  template <typename U>
+  bool operator==(const SizeProbeAllocator<U>& other) const {
+    return size_ == other.size_;
+  }
+  template <typename U>
+  bool operator!=(const SizeProbeAllocator<U>& other) const {
+    return size_ != other.size_;
+  }
+
+ private:
+  template <typename U>
+  friend class SizeProbeAllocator;
+
+  size_t* size_;
+};
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_MDS_SLAB_H_
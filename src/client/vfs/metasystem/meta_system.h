@@ -48,6 +48,7 @@ struct DumpOption {
   bool inode_cache{false};
   bool rpc{false};
   bool mds_discovery{false};
+  bool memory_governor{false};
 
   bool is_summary{false};
 };
@@ -96,8 +97,30 @@ class MetaSystem {
                            uint64_t fh, std::vector<Slice>* slices,
                            uint64_t& version) = 0;
 
+  /**
+   * Batch fetch the slices of chunks [start_index, start_index + count) into
+   * cache, so later ReadSlice of them needn't wait for metadata
+   * @param ino the file to be read
+   * @param start_index the first chunk index
+   * @param count the number of chunks
+   */
+  virtual Status PrefetchSlice(ContextSPtr ctx, Ino ino,           // NOLINT
+                               uint64_t fh, uint64_t start_index,  // NOLINT
+                               uint32_t count) {                   // NOLINT
+    return Status::NotSupport("not supported");
+  }
+
   virtual Status NewSliceId(ContextSPtr ctx, Ino ino, uint64_t* id) = 0;
 
+  /**
+   * Allocate id of a pack object, mds records a pending ref of the pack so
+   * it can be collected even if none of its slices is committed
+   * @param ino the inode of first slice in the pack
+   */
+  virtual Status NewPackId(ContextSPtr ctx, Ino ino, uint64_t* id) {
+    return NewSliceId(ctx, ino, id);
+  }
+
   /**
    * Write the slices of a file meta
    * @param ino the file to be written
@@ -123,6 +146,12 @@ class MetaSystem {
     return Status::NotSupport("not supported");
   }
 
+  // drop cached dentries of parent, called when mds revoke the dentry lease
+  virtual void InvalidateDentry(Ino parent) {}  // NOLINT
+
+  // write back dirty attr and give up attr lease, called when mds recall it
+  virtual void RecallAttrLease(Ino ino) {}  // NOLINT
+
   /**
    * Hard link a file to a new parent directory
    * @param ino the file to be linked
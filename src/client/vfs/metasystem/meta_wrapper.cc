@@ -55,6 +55,18 @@ Status MetaWrapper::NewSliceId(ContextSPtr ctx, Ino ino, uint64_t* id) {
   return s;
 }
 
+Status MetaWrapper::NewPackId(ContextSPtr ctx, Ino ino, uint64_t* id) {
+  Status s;
+  MetaLogGuard log_guard([&]() {
+    return absl::StrFormat("new_pack_id: (%d) %d, %s", ino, *id, s.ToString());
+  });
+  metrics::client::SliceMetricGuard guard(&s, &slice_metric_->new_sliceid,
+                                          butil::cpuwide_time_us());
+
+  s = target_->NewPackId(ctx, ino, id);
+  return s;
+}
+
 Status MetaWrapper::ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index,
                               uint64_t fh, std::vector<Slice>* slices,
                               uint64_t& version) {
@@ -70,6 +82,18 @@ Status MetaWrapper::ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index,
   return s;
 }
 
+Status MetaWrapper::PrefetchSlice(ContextSPtr ctx, Ino ino, uint64_t fh,
+                                  uint64_t start_index, uint32_t count) {
+  Status s;
+  MetaLogGuard log_guard([&]() {
+    return absl::StrFormat("prefetch_slice (%d,%d,%d): %s [fh:%d]", ino,
+                           start_index, count, s.ToString(), fh);
+  });
+
+  s = target_->PrefetchSlice(ctx, ino, fh, start_index, count);
+  return s;
+}
+
 Status MetaWrapper::WriteSlice(ContextSPtr ctx, Ino ino, uint64_t index,
                                uint64_t fh, const std::vector<Slice>& slices) {
   Status s;
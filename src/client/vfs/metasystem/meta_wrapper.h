@@ -159,7 +159,11 @@ class MetaWrapper {
   Status ReadSlice(ContextSPtr ctx, Ino ino, uint64_t index, uint64_t fh,
                    std::vector<Slice>* slices, uint64_t& version);
 
+  Status PrefetchSlice(ContextSPtr ctx, Ino ino, uint64_t fh,
+                       uint64_t start_index, uint32_t count);
+
   Status NewSliceId(ContextSPtr ctx, Ino ino, uint64_t* id);
+  Status NewPackId(ContextSPtr ctx, Ino ino, uint64_t* id);
 
   Status WriteSlice(ContextSPtr ctx, Ino ino, uint64_t index, uint64_t fh,
                     const std::vector<Slice>& slices);
@@ -179,6 +183,10 @@ class MetaWrapper {
     return target_->Compact(ctx, ino, chunk_index, is_async);
   }
 
+  void InvalidateDentry(Ino parent) { target_->InvalidateDentry(parent); }
+
+  void RecallAttrLease(Ino ino) { target_->RecallAttrLease(ino); }
+
   Status StatFs(ContextSPtr ctx, Ino ino, FsStat* fs_stat) {
     return target_->StatFs(ctx, ino, fs_stat);
   }
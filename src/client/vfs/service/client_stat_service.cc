@@ -1449,6 +1449,13 @@ void ClientStatServiceImpl::RenderMainPage(const brpc::Server* server,
   vfs_hub_->GetHandleManager()->Summary(handle_value);
   summary_value.append(handle_value);
 
+  auto* shared_read_cache = vfs_hub_->GetSharedReadCache();
+  if (shared_read_cache != nullptr) {
+    Json::Value shared_read_cache_value = Json::objectValue;
+    shared_read_cache->Summary(shared_read_cache_value);
+    summary_value.append(shared_read_cache_value);
+  }
+
   if (!vfs_hub_->GetMetaSystem()->GetSummary(summary_value)) {
     LOG(ERROR) << fmt::format("get summary fail.");
     os << "</body>";
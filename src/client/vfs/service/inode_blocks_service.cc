@@ -126,10 +126,10 @@ static void DumpFlatFile(butil::IOBufBuilder& os, FlatFile* flat_file,
 
   // Print each row
   for (const auto& req : block_reqs) {
-    cache::BlockKey key(fs_id, ino, req.block.slice_id, req.block.index,
-                        req.block.version);
+    cache::BlockKey key(fs_id, req.block.KeyIno(ino), req.block.slice_id,
+                        req.block.index, req.block.version);
 
-    const auto file_pos = req.block.file_offset + req.block_offset;
+    const auto file_pos = req.file_offset;
     const auto& block_key = key.StoreKey();
 
     if (use_delimiter) {
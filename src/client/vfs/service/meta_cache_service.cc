@@ -0,0 +1,66 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "client/vfs/service/meta_cache_service.h"
+
+#include <brpc/closure_guard.h>
+#include <brpc/controller.h>
+#include <fmt/format.h>
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+void MetaCacheServiceImpl::InvalidateDentry(
+    google::protobuf::RpcController* controller,
+    const pb::client::InvalidateDentryRequest* request,
+    pb::client::InvalidateDentryResponse* response,
+    google::protobuf::Closure* done) {
+  (void)controller;
+  (void)response;
+  brpc::ClosureGuard done_guard(done);
+
+  VLOG(1) << fmt::format(
+      "[service.metacache] invalidate dentry, fs({}) count({}).",
+      request->fs_id(), request->parents_size());
+
+  auto* meta_system = vfs_hub_->GetMetaSystem();
+  for (const auto& parent : request->parents()) {
+    meta_system->InvalidateDentry(parent);
+  }
+}
+
+void MetaCacheServiceImpl::RecallAttrLease(
+    google::protobuf::RpcController* controller,
+    const pb::client::RecallAttrLeaseRequest* request,
+    pb::client::RecallAttrLeaseResponse* response,
+    google::protobuf::Closure* done) {
+  (void)controller;
+  (void)response;
+  brpc::ClosureGuard done_guard(done);
+
+  VLOG(1) << fmt::format(
+      "[service.metacache] recall attr lease, fs({}) count({}).",
+      request->fs_id(), request->inos_size());
+
+  auto* meta_system = vfs_hub_->GetMetaSystem();
+  for (const auto& ino : request->inos()) {
+    meta_system->RecallAttrLease(ino);
+  }
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
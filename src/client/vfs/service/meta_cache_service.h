@@ -0,0 +1,59 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_META_CACHE_SERVICE_H_
+#define DINGOFS_SRC_CLIENT_VFS_META_CACHE_SERVICE_H_
+
+#include <glog/logging.h>
+
+#include "client/vfs/hub/vfs_hub.h"
+#include "dingofs/vfs.pb.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+// receive mds notification to invalidate cached metadata
+class MetaCacheServiceImpl : public pb::client::MetaCacheService {
+ public:
+  MetaCacheServiceImpl() = default;
+
+  ~MetaCacheServiceImpl() override = default;
+
+  void Init(VFSHub* hub) {
+    CHECK_NOTNULL(hub);
+    vfs_hub_ = hub;
+  }
+
+  void InvalidateDentry(google::protobuf::RpcController* controller,
+                        const pb::client::InvalidateDentryRequest* request,
+                        pb::client::InvalidateDentryResponse* response,
+                        google::protobuf::Closure* done) override;
+
+  // flush dirty attr and drop the lease, reply after write back done
+  void RecallAttrLease(google::protobuf::RpcController* controller,
+                       const pb::client::RecallAttrLeaseRequest* request,
+                       pb::client::RecallAttrLeaseResponse* response,
+                       google::protobuf::Closure* done) override;
+
+ private:
+  vfs::VFSHub* vfs_hub_;
+};
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_META_CACHE_SERVICE_H_
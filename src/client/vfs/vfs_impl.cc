@@ -659,6 +659,18 @@ Status VFSImpl::StartBrpcServer() {
     }
   }
 
+  {
+    meta_cache_service_.Init(vfs_hub_.get());
+    int rc = brpc_server_.AddService(&meta_cache_service_,
+                                     brpc::SERVER_DOESNT_OWN_SERVICE);
+    if (rc != 0) {
+      std::string error_msg = fmt::format(
+          "Add meta cache service to brpc server failed, rc: {}", rc);
+      LOG(ERROR) << error_msg;
+      return Status::Internal(error_msg);
+    }
+  }
+
   {
     client_stat_service_.Init(vfs_hub_.get());
 
@@ -30,6 +30,7 @@
 #include "client/vfs/service/client_stat_service.h"
 #include "client/vfs/service/compact_service.h"
 #include "client/vfs/service/inode_blocks_service.h"
+#include "client/vfs/service/meta_cache_service.h"
 #include "client/vfs/vfs.h"
 #include "common/trace/context.h"
 
@@ -154,6 +155,7 @@ class VFSImpl : public VFS {
   brpc::Server brpc_server_;
   InodeBlocksServiceImpl inode_blocks_service_;
   CompactServiceImpl compact_service_;
+  MetaCacheServiceImpl meta_cache_service_;
   ClientStatServiceImpl client_stat_service_;
 };
 
@@ -112,9 +112,16 @@ struct Slice {
   uint64_t length;      // length of the slice
   uint64_t compaction;  // compaction version
   bool is_zero;         // is zero slice
-  uint64_t size;        // now same as length, maybe use for future or remove
+  uint64_t size;        // same as length, or pack object length if packed
+  // packed slice is a range of a pack object shared with other small files,
+  // id is the pack slice id and data is at [pack_offset, pack_offset+length)
+  // of the pack object, pack_refs is the number of slices in the pack
+  uint64_t pack_offset{0};
+  uint64_t pack_refs{0};
 
   uint64_t End() const { return offset + length; }
+
+  bool IsPacked() const { return pack_refs > 0; }
 };
 
 enum StoreType : uint8_t {
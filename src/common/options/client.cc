@@ -85,6 +85,35 @@ DEFINE_uint64(vfs_meta_tiny_file_data_cache_expired_s, 3600,
               "tiny file data cache expired time");
 DEFINE_validator(vfs_meta_tiny_file_data_cache_expired_s, brpc::PassValidate);
 
+DEFINE_bool(vfs_meta_dentry_cache_enable, false,
+            "enable cache dentry under lease granted by mds");
+DEFINE_validator(vfs_meta_dentry_cache_enable, brpc::PassValidate);
+
+DEFINE_bool(vfs_meta_attr_lease_enable, false,
+            "enable serve attr under lease granted by mds");
+DEFINE_validator(vfs_meta_attr_lease_enable, brpc::PassValidate);
+
+DEFINE_uint64(vfs_meta_memory_budget_mb, 1024,
+              "memory budget of meta caches, 0 means no limit");
+DEFINE_validator(vfs_meta_memory_budget_mb, brpc::PassValidate);
+
+DEFINE_bool(vfs_meta_disk_cache_enable, false,
+            "enable persist meta cache on local disk for warm remount");
+DEFINE_string(vfs_meta_disk_cache_dir, "",
+              "dir of meta disk cache, default under client cache dir");
+DEFINE_uint32(vfs_meta_disk_cache_flush_interval_s, 10,
+              "interval of persist recently active meta cache to disk");
+DEFINE_validator(vfs_meta_disk_cache_flush_interval_s, brpc::PassValidate);
+
+DEFINE_string(vfs_meta_local_engine, "leveldb",
+              "engine of local meta system, leveldb or compact");
+DEFINE_bool(vfs_meta_local_wal_sync, false,
+            "sync wal of compact local meta engine on every commit");
+DEFINE_validator(vfs_meta_local_wal_sync, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_local_checkpoint_wal_mb, 512,
+              "checkpoint compact local meta engine when wal exceed");
+DEFINE_validator(vfs_meta_local_checkpoint_wal_mb, brpc::PassValidate);
+
 DEFINE_bool(vfs_tiny_file_data_enable, false, "enable vfs meta prefetch data");
 DEFINE_validator(vfs_tiny_file_data_enable, brpc::PassValidate);
 
@@ -110,6 +139,25 @@ DEFINE_int64(vfs_read_buffer_total_mb, 1024, "total read buffer size in MB");
 DEFINE_bool(vfs_print_readahead_stats, false, "print readahead stats");
 DEFINE_validator(vfs_print_readahead_stats, brpc::PassValidate);
 
+DEFINE_uint32(vfs_slice_prefetch_chunks, 4,
+              "number of chunks whose slices are prefetched ahead of "
+              "sequential read, 0 means disable");
+DEFINE_validator(vfs_slice_prefetch_chunks, brpc::PassValidate);
+DEFINE_uint32(vfs_slice_prefetch_min_level, 3,
+              "min readahead level to prefetch slices of next chunks");
+DEFINE_validator(vfs_slice_prefetch_min_level, brpc::PassValidate);
+DEFINE_uint64(vfs_slice_prefetch_file_max_mb, 0,
+              "prefetch slices of all chunks at open if file is not larger "
+              "than this, 0 means disable");
+DEFINE_validator(vfs_slice_prefetch_file_max_mb, brpc::PassValidate);
+
+DEFINE_bool(vfs_shared_read_cache_enable, false,
+            "enable read cache shared by all file handles");
+DEFINE_validator(vfs_shared_read_cache_enable, brpc::PassValidate);
+DEFINE_int64(vfs_shared_read_cache_mb, 512,
+             "max size of shared read cache in MB, part of read buffer");
+DEFINE_validator(vfs_shared_read_cache_mb, brpc::PassValidate);
+
 // prefetch
 DEFINE_uint32(vfs_prefetch_blocks, 1, "number of blocks to prefetch");
 DEFINE_validator(vfs_prefetch_blocks, brpc::PassValidate);
@@ -145,11 +193,36 @@ DEFINE_validator(vfs_warmup_trigger_restart_interval_secs, brpc::PassValidate);
 // vfs meta
 
 DEFINE_uint32(vfs_meta_read_dir_batch_size, 1024, "read dir batch size.");
+DEFINE_uint32(vfs_meta_read_dir_prefetch_max_batches, 4,
+              "max read dir batches fetched ahead of consumer, 0 disable");
+DEFINE_validator(vfs_meta_read_dir_prefetch_max_batches, brpc::PassValidate);
+DEFINE_bool(vfs_meta_dir_snapshot_enable, false,
+            "enable serve opendir from cached dir snapshot");
+DEFINE_validator(vfs_meta_dir_snapshot_enable, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_dir_snapshot_expired_s, 30,
+              "dir snapshot expired time");
+DEFINE_validator(vfs_meta_dir_snapshot_expired_s, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_dir_snapshot_max_entries, 65536,
+              "max entries of dir which can be cached as snapshot");
+DEFINE_validator(vfs_meta_dir_snapshot_max_entries, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_dir_delta_max_count, 4096,
+              "max dentry changes applied to dir snapshot, more do full list");
+DEFINE_validator(vfs_meta_dir_delta_max_count, brpc::PassValidate);
 DEFINE_uint32(vfs_meta_rpc_timeout_ms, 10000, "rpc timeout ms");
 DEFINE_validator(vfs_meta_rpc_timeout_ms, brpc::PassValidate);
 
 DEFINE_int32(vfs_meta_rpc_retry_times, 8, "rpc retry time");
 DEFINE_validator(vfs_meta_rpc_retry_times, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_rpc_retry_max_wait_ms, 10000,
+              "max wait time before rpc retry");
+DEFINE_validator(vfs_meta_rpc_retry_max_wait_ms, brpc::PassValidate);
+
+DEFINE_bool(vfs_meta_follower_read_enable, false,
+            "enable send read request to follower mds with bounded staleness");
+DEFINE_validator(vfs_meta_follower_read_enable, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_follower_max_staleness_ms, 1000,
+              "max staleness ms of follower read, capped by mds");
+DEFINE_validator(vfs_meta_follower_max_staleness_ms, brpc::PassValidate);
 
 DEFINE_bool(vfs_meta_batch_operation_enable, false,
             "enable batch operation, default is false");
@@ -159,6 +232,23 @@ DEFINE_uint32(vfs_meta_batch_operation_merge_delay_us, 10,
               "batch operation merge delay us.");
 DEFINE_validator(vfs_meta_batch_operation_merge_delay_us, brpc::PassValidate);
 
+DEFINE_bool(vfs_meta_group_commit_enable, false,
+            "merge write slice of different inodes into one rpc per mds.");
+DEFINE_validator(vfs_meta_group_commit_enable, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_group_commit_max_delay_us, 500,
+              "max group commit window, window adapts between batch "
+              "operation merge delay and this value by load.");
+DEFINE_validator(vfs_meta_group_commit_max_delay_us, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_group_commit_max_inodes, 64,
+              "max inodes in one group commit rpc.");
+DEFINE_validator(vfs_meta_group_commit_max_inodes, brpc::PassValidate);
+DEFINE_bool(vfs_meta_batch_read_enable, false,
+            "enable coalesce concurrent getattr/getxattr/lookup into batch");
+DEFINE_validator(vfs_meta_batch_read_enable, brpc::PassValidate);
+DEFINE_uint32(vfs_meta_batch_read_max_inodes, 128,
+              "max inodes of one batch getattr rpc");
+DEFINE_validator(vfs_meta_batch_read_max_inodes, brpc::PassValidate);
+
 DEFINE_uint32(vfs_meta_commit_slice_max_num, 2048,
               "maximum number of slices to commit at once.");
 DEFINE_validator(vfs_meta_commit_slice_max_num, brpc::PassValidate);
@@ -234,6 +324,14 @@ DEFINE_bool(vfs_data_writeback, false, "whether to use writeback");
 DEFINE_validator(vfs_data_writeback, brpc::PassValidate);
 DEFINE_string(vfs_data_writeback_suffix, "",
               "file name with suffix for writeback");
+DEFINE_bool(vfs_data_pack_enable, false,
+            "whether to pack small files into shared block objects");
+DEFINE_uint32(vfs_data_pack_slice_max_kb, 512,
+              "max slice size in kb which can be packed");
+DEFINE_validator(vfs_data_pack_slice_max_kb, brpc::PassValidate);
+DEFINE_uint32(vfs_data_pack_delay_ms, 20,
+              "max time in ms a pack waits for more slices before upload");
+DEFINE_validator(vfs_data_pack_delay_ms, brpc::PassValidate);
 
 DEFINE_uint32(vfs_dummy_server_port, 10000, "dummy server port");
 DEFINE_validator(vfs_dummy_server_port, brpc::PassValidate);
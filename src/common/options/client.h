@@ -71,6 +71,15 @@ DECLARE_uint64(vfs_meta_memo_expired_s);
 DECLARE_uint64(vfs_meta_chunk_cache_expired_s);
 DECLARE_uint64(vfs_meta_inode_cache_expired_s);
 DECLARE_uint64(vfs_meta_tiny_file_data_cache_expired_s);
+DECLARE_bool(vfs_meta_dentry_cache_enable);
+DECLARE_bool(vfs_meta_attr_lease_enable);
+DECLARE_uint64(vfs_meta_memory_budget_mb);
+DECLARE_bool(vfs_meta_disk_cache_enable);
+DECLARE_string(vfs_meta_disk_cache_dir);
+DECLARE_uint32(vfs_meta_disk_cache_flush_interval_s);
+DECLARE_string(vfs_meta_local_engine);
+DECLARE_bool(vfs_meta_local_wal_sync);
+DECLARE_uint32(vfs_meta_local_checkpoint_wal_mb);
 
 DECLARE_bool(vfs_tiny_file_data_enable);
 DECLARE_uint64(vfs_tiny_file_max_size);
@@ -80,6 +89,11 @@ DECLARE_int32(vfs_read_executor_thread);
 DECLARE_int32(vfs_read_max_retry_block_not_found);
 DECLARE_int64(vfs_read_buffer_total_mb);
 DECLARE_bool(vfs_print_readahead_stats);
+DECLARE_uint32(vfs_slice_prefetch_chunks);
+DECLARE_uint32(vfs_slice_prefetch_min_level);
+DECLARE_uint64(vfs_slice_prefetch_file_max_mb);
+DECLARE_bool(vfs_shared_read_cache_enable);
+DECLARE_int64(vfs_shared_read_cache_mb);
 
 // vfs write
 DECLARE_uint32(vfs_write_buffer_page_size);
@@ -108,11 +122,24 @@ DECLARE_int32(vfs_periodic_trim_mem_ms);
 
 // vfs meta
 DECLARE_uint32(vfs_meta_read_dir_batch_size);
+DECLARE_uint32(vfs_meta_read_dir_prefetch_max_batches);
+DECLARE_bool(vfs_meta_dir_snapshot_enable);
+DECLARE_uint32(vfs_meta_dir_snapshot_expired_s);
+DECLARE_uint32(vfs_meta_dir_snapshot_max_entries);
+DECLARE_uint32(vfs_meta_dir_delta_max_count);
 DECLARE_uint32(vfs_meta_rpc_timeout_ms);
 DECLARE_int32(vfs_meta_rpc_retry_times);
+DECLARE_uint32(vfs_meta_rpc_retry_max_wait_ms);
+DECLARE_bool(vfs_meta_follower_read_enable);
+DECLARE_uint32(vfs_meta_follower_max_staleness_ms);
 
 DECLARE_bool(vfs_meta_batch_operation_enable);
 DECLARE_uint32(vfs_meta_batch_operation_merge_delay_us);
+DECLARE_bool(vfs_meta_group_commit_enable);
+DECLARE_uint32(vfs_meta_group_commit_max_delay_us);
+DECLARE_uint32(vfs_meta_group_commit_max_inodes);
+DECLARE_bool(vfs_meta_batch_read_enable);
+DECLARE_uint32(vfs_meta_batch_read_max_inodes);
 DECLARE_uint32(vfs_meta_commit_slice_max_num);
 
 DECLARE_bool(vfs_meta_compact_chunk_enable);
@@ -123,6 +150,9 @@ DECLARE_uint32(vfs_meta_compact_chunk_interval_ms);
 DECLARE_uint32(vfs_meta_max_name_length);
 DECLARE_bool(vfs_data_writeback);
 DECLARE_string(vfs_data_writeback_suffix);
+DECLARE_bool(vfs_data_pack_enable);
+DECLARE_uint32(vfs_data_pack_slice_max_kb);
+DECLARE_uint32(vfs_data_pack_delay_ms);
 DECLARE_uint32(vfs_dummy_server_port);
 
 // trace log
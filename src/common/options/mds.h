@@ -29,7 +29,7 @@ DECLARE_string(mds_gc_lock_name);
 DECLARE_string(mds_pid_file_name);
 
 // storage config
-DECLARE_string(mds_storage_engine);     // e.g dingo-store|dummy
+DECLARE_string(mds_storage_engine);     // e.g dingo-store|tikv|memory|dummy
 DECLARE_string(mds_id_generator_type);  // e.g coor|store
 
 // quota config
@@ -0,0 +1,219 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/background/balance_planner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "brpc/reloadable_flags.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_double(mds_balancer_ewma_alpha, 0.5, "balancer weight of new bucket op rate sample.");
+DEFINE_validator(mds_balancer_ewma_alpha, brpc::PassValidate);
+
+DEFINE_double(mds_balancer_trigger_ratio, 0.3, "balancer start when hottest mds exceed mean load by ratio.");
+DEFINE_validator(mds_balancer_trigger_ratio, brpc::PassValidate);
+
+DEFINE_double(mds_balancer_target_ratio, 0.1, "balancer stop when hottest mds within mean load by ratio.");
+DEFINE_validator(mds_balancer_target_ratio, brpc::PassValidate);
+
+DEFINE_double(mds_balancer_min_load, 500, "balancer not move when hottest mds exceed mean less than op/s.");
+DEFINE_validator(mds_balancer_min_load, brpc::PassValidate);
+
+DEFINE_uint32(mds_balancer_max_move_num, 4, "balancer max bucket move num of one fs every round.");
+DEFINE_validator(mds_balancer_max_move_num, brpc::PassValidate);
+
+DEFINE_uint32(mds_balancer_bucket_cooldown_s, 600, "balancer not move bucket again within seconds.");
+DEFINE_validator(mds_balancer_bucket_cooldown_s, brpc::PassValidate);
+
+DEFINE_uint32(mds_balancer_round_cooldown_s, 60, "balancer not balance fs again within seconds after move.");
+DEFINE_validator(mds_balancer_round_cooldown_s, brpc::PassValidate);
+
+std::string BucketMove::ToString() const {
+  return fmt::format("{}:{}->{}({:.1f})", bucket_id, from_mds_id, to_mds_id, load);
+}
+
+BalancePlanner::Options BalancePlanner::Options::FromFlags() {
+  Options options;
+  options.ewma_alpha = std::clamp(FLAGS_mds_balancer_ewma_alpha, 0.01, 1.0);
+  options.trigger_ratio = FLAGS_mds_balancer_trigger_ratio;
+  options.target_ratio = std::min(FLAGS_mds_balancer_target_ratio, FLAGS_mds_balancer_trigger_ratio);
+  options.min_load = FLAGS_mds_balancer_min_load;
+  options.max_move_num = FLAGS_mds_balancer_max_move_num;
+  options.bucket_cooldown_ms = static_cast<uint64_t>(FLAGS_mds_balancer_bucket_cooldown_s) * 1000;
+  options.round_cooldown_ms = static_cast<uint64_t>(FLAGS_mds_balancer_round_cooldown_s) * 1000;
+
+  return options;
+}
+
+BalancePlanner::BalancePlanner(uint32_t bucket_num)
+    : bucket_num_(bucket_num),
+      loads_(bucket_num, 0),
+      has_loads_(bucket_num, false),
+      move_time_ms_(bucket_num, 0) {}
+
+void BalancePlanner::Update(const Options& options, const std::map<uint32_t, double>& bucket_rates) {
+  const double alpha = options.ewma_alpha;
+
+  for (const auto& [bucket_id, rate] : bucket_rates) {
+    if (bucket_id >= bucket_num_) continue;
+
+    loads_[bucket_id] = has_loads_[bucket_id] ? (alpha * rate + (1 - alpha) * loads_[bucket_id]) : rate;
+    has_loads_[bucket_id] = true;
+  }
+}
+
+double BalancePlanner::BucketLoad(uint32_t bucket_id) const {
+  return bucket_id < bucket_num_ ? loads_[bucket_id] : 0;
+}
+
+std::map<uint64_t, double> BalancePlanner::MdsLoads(const BucketLayout& layout) const {
+  std::map<uint64_t, double> mds_loads;
+  for (const auto& [mds_id, bucket_ids] : layout) {
+    double load = 0;
+    for (auto bucket_id : bucket_ids) load += BucketLoad(bucket_id);
+    mds_loads[mds_id] = load;
+  }
+
+  return mds_loads;
+}
+
+double BalancePlanner::Imbalance(const std::map<uint64_t, double>& mds_loads) {
+  if (mds_loads.empty()) return 0;
+
+  double total = 0, max_load = 0;
+  for (const auto& [_, load] : mds_loads) {
+    total += load;
+    max_load = std::max(max_load, load);
+  }
+  if (total <= 0) return 0;
+
+  double mean = total / mds_loads.size();
+  return (max_load - mean) / mean;
+}
+
+bool BalancePlanner::IsCooling(const Options& options, uint32_t bucket_id, uint64_t now_ms) const {
+  return move_time_ms_[bucket_id] > 0 && move_time_ms_[bucket_id] + options.bucket_cooldown_ms > now_ms;
+}
+
+// greedy move bucket from hottest mds to coldest mds, pick the bucket which
+// lower the peak of the two most, stop when no move lower the peak.
+std::vector<BucketMove> BalancePlanner::Plan(const Options& options, const BucketLayout& layout, uint64_t now_ms) {
+  std::vector<BucketMove> moves;
+  if (layout.size() < 2) return moves;
+
+  auto mds_loads = MdsLoads(layout);
+  double total = 0;
+  for (const auto& [_, load] : mds_loads) total += load;
+  if (total <= 0) return moves;
+
+  const double mean = total / mds_loads.size();
+  const double imbalance = Imbalance(mds_loads);
+
+  // hysteresis, start at trigger ratio and stop at target ratio
+  if (!is_balancing_) {
+    double max_load = mean * (1 + imbalance);
+    if (imbalance <= options.trigger_ratio || max_load - mean < options.min_load) return moves;
+    is_balancing_ = true;
+
+  } else if (imbalance <= options.target_ratio) {
+    is_balancing_ = false;
+    return moves;
+  }
+
+  // wait reports after last move
+  if (last_move_time_ms_ > 0 && last_move_time_ms_ + options.round_cooldown_ms > now_ms) return moves;
+
+  BucketLayout new_layout = layout;
+  for (uint32_t i = 0; i < options.max_move_num; ++i) {
+    auto src_it = std::max_element(mds_loads.begin(), mds_loads.end(),
+                                   [](const auto& a, const auto& b) { return a.second < b.second; });
+    auto dst_it = std::min_element(mds_loads.begin(), mds_loads.end(),
+                                   [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (src_it == dst_it) break;
+
+    const double src_load = src_it->second;
+    const double dst_load = dst_it->second;
+    if ((src_load - mean) / mean <= options.target_ratio) break;
+
+    auto& src_bucket_ids = new_layout[src_it->first];
+    // mds keep one bucket at least
+    if (src_bucket_ids.size() <= 1) break;
+
+    int best_index = -1;
+    double best_peak = src_load;
+    for (size_t j = 0; j < src_bucket_ids.size(); ++j) {
+      uint32_t bucket_id = src_bucket_ids[j];
+      double load = BucketLoad(bucket_id);
+      if (load <= 0 || IsCooling(options, bucket_id, now_ms)) continue;
+
+      double peak = std::max(src_load - load, dst_load + load);
+      if (peak < best_peak) {
+        best_peak = peak;
+        best_index = static_cast<int>(j);
+      }
+    }
+    if (best_index < 0) break;
+
+    BucketMove move;
+    move.bucket_id = src_bucket_ids[best_index];
+    move.from_mds_id = src_it->first;
+    move.to_mds_id = dst_it->first;
+    move.load = BucketLoad(move.bucket_id);
+
+    src_bucket_ids.erase(src_bucket_ids.begin() + best_index);
+    new_layout[move.to_mds_id].push_back(move.bucket_id);
+    src_it->second -= move.load;
+    dst_it->second += move.load;
+
+    moves.push_back(move);
+  }
+
+  return moves;
+}
+
+void BalancePlanner::Commit(const std::vector<BucketMove>& moves, uint64_t now_ms) {
+  if (moves.empty()) return;
+
+  for (const auto& move : moves) {
+    if (move.bucket_id < bucket_num_) move_time_ms_[move.bucket_id] = now_ms;
+  }
+  last_move_time_ms_ = now_ms;
+}
+
+void BalancePlanner::Apply(const std::vector<BucketMove>& moves, BucketLayout& layout) {
+  for (const auto& move : moves) {
+    auto& from_bucket_ids = layout[move.from_mds_id];
+    auto it = std::find(from_bucket_ids.begin(), from_bucket_ids.end(), move.bucket_id);
+    CHECK(it != from_bucket_ids.end()) << fmt::format("bucket({}) not belong to mds({}).", move.bucket_id,
+                                                       move.from_mds_id);
+
+    from_bucket_ids.erase(it);
+    layout[move.to_mds_id].push_back(move.bucket_id);
+  }
+
+  for (auto& [_, bucket_ids] : layout) std::sort(bucket_ids.begin(), bucket_ids.end());
+}
+
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_BACKGROUND_BALANCE_PLANNER_H_
+#define DINGOFS_MDS_BACKGROUND_BALANCE_PLANNER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dingofs {
+namespace mds {
+
+// bucket layout of one hash partition fs, mds_id -> bucket ids
+using BucketLayout = std::map<uint64_t, std::vector<uint32_t>>;
+
+struct BucketMove {
+  uint32_t bucket_id{0};
+  uint64_t from_mds_id{0};
+  uint64_t to_mds_id{0};
+  // op rate of bucket
+  double load{0};
+
+  std::string ToString() const;
+};
+
+// plan hot bucket move of one hash partition fs by bucket op rate.
+// bucket op rate is smoothed by ewma, balance start when the hottest mds exceed
+// mean by trigger ratio and stop when it fall within target ratio, so small
+// fluctuation not cause move. moved bucket is not moved again in cooldown, and
+// fs is not balanced again until reports after last move come.
+class BalancePlanner {
+ public:
+  struct Options {
+    double ewma_alpha{0.5};
+    // start balance when (max - mean) / mean exceed it
+    double trigger_ratio{0.3};
+    // stop balance when (max - mean) / mean fall within it
+    double target_ratio{0.1};
+    // not balance when max - mean less than it, avoid move for idle fs
+    double min_load{500};
+    uint32_t max_move_num{4};
+    uint64_t bucket_cooldown_ms{600 * 1000};
+    uint64_t round_cooldown_ms{60 * 1000};
+
+    static Options FromFlags();
+  };
+
+  explicit BalancePlanner(uint32_t bucket_num);
+  ~BalancePlanner() = default;
+
+  uint32_t BucketNum() const { return bucket_num_; }
+  bool IsBalancing() const { return is_balancing_; }
+  uint64_t LastMoveTimeMs() const { return last_move_time_ms_; }
+
+  // merge op rate of reported bucket, bucket not reported keep last load
+  void Update(const Options& options, const std::map<uint32_t, double>& bucket_rates);
+
+  double BucketLoad(uint32_t bucket_id) const;
+  std::map<uint64_t, double> MdsLoads(const BucketLayout& layout) const;
+  // (max - mean) / mean of mds load
+  static double Imbalance(const std::map<uint64_t, double>& mds_loads);
+
+  // plan moves under layout, empty when balanced or in cooldown
+  std::vector<BucketMove> Plan(const Options& options, const BucketLayout& layout, uint64_t now_ms);
+  // moves are executed, start cooldown
+  void Commit(const std::vector<BucketMove>& moves, uint64_t now_ms);
+
+  static void Apply(const std::vector<BucketMove>& moves, BucketLayout& layout);
+
+ private:
+  bool IsCooling(const Options& options, uint32_t bucket_id, uint64_t now_ms) const;
+
+  const uint32_t bucket_num_;
+
+  std::vector<double> loads_;
+  std::vector<bool> has_loads_;
+  std::vector<uint64_t> move_time_ms_;
+
+  bool is_balancing_{false};
+  uint64_t last_move_time_ms_{0};
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_BACKGROUND_BALANCE_PLANNER_H_
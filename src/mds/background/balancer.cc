@@ -0,0 +1,159 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/background/balancer.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "brpc/reloadable_flags.h"
+#include "dingofs/error.pb.h"
+#include "dingofs/mds.pb.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "mds/common/context.h"
+#include "mds/common/helper.h"
+#include "mds/common/synchronization.h"
+#include "mds/server.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_bool(mds_balancer_enable, false, "enable move hot bucket of hash partition fs between mds.");
+DEFINE_validator(mds_balancer_enable, brpc::PassValidate);
+
+bool Balancer::Init() { return dist_lock_->Init(); }
+
+void Balancer::Destroy() { dist_lock_->Destroy(); }
+
+void Balancer::Run() {
+  bool running = false;
+  if (!is_running_.compare_exchange_strong(running, true)) {
+    LOG(INFO) << "[balancer] already running......";
+    return;
+  }
+  DEFER(is_running_.store(false));
+
+  if (!FLAGS_mds_balancer_enable) return;
+
+  // load history is only valid for lock owner
+  if (!dist_lock_->IsLocked()) {
+    planners_.clear();
+    return;
+  }
+
+  std::vector<MdsEntry> mdses;
+  Context ctx;
+  auto status = Server::GetInstance().GetHeartbeat()->GetMDSList(ctx, mdses);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[balancer] get mds list fail, {}.", status.error_str());
+    return;
+  }
+
+  for (const auto& fs : fs_set_->GetAllFileSystem()) {
+    if (!fs->IsParentHashPartition()) continue;
+
+    status = BalanceFs(fs, mdses);
+    if (!status.ok()) {
+      LOG(WARNING) << fmt::format("[balancer.{}] balance fail, {}.", fs->FsId(), status.error_str());
+    }
+  }
+}
+
+void Balancer::NotifyRefreshFs(const std::vector<uint64_t>& mds_ids, const FsInfoEntry& fs_info) {
+  for (auto mds_id : mds_ids) {
+    notify_buddy_->AsyncNotify(notify::RefreshFsInfoMessage::Create(mds_id, fs_info.fs_id(), fs_info.fs_name()));
+  }
+}
+
+Status Balancer::BalanceFs(FileSystemSPtr fs, const std::vector<MdsEntry>& mdses) {
+  const uint32_t fs_id = fs->FsId();
+  auto fs_info = fs->GetFsInfo();
+  const auto& hash = fs_info.partition_policy().parent_hash();
+  if (hash.bucket_num() == 0 || hash.distributions().size() < 2) return Status::OK();
+
+  auto it = planners_.find(fs_id);
+  if (it == planners_.end() || it->second.BucketNum() != hash.bucket_num()) {
+    planners_.erase(fs_id);
+    it = planners_.emplace(fs_id, BalancePlanner(hash.bucket_num())).first;
+  }
+  auto& planner = it->second;
+
+  BucketLayout layout;
+  for (const auto& [mds_id, bucket_set] : hash.distributions()) {
+    layout[mds_id].assign(bucket_set.bucket_ids().begin(), bucket_set.bucket_ids().end());
+  }
+
+  // collect op rate of owned bucket, report whose window start before last
+  // move is skipped, because moved bucket is counted by old owner partly.
+  std::map<uint32_t, double> bucket_rates;
+  for (const auto& mds : mdses) {
+    auto layout_it = layout.find(mds.id());
+    if (layout_it == layout.end()) continue;
+    // leave offline mds to monitor
+    if (!mds.is_online()) return Status(pb::error::EINTERNAL, fmt::format("mds({}) is offline", mds.id()));
+
+    for (const auto& load : mds.bucket_loads()) {
+      if (load.fs_id() != fs_id || load.window_ms() == 0) continue;
+      if (mds.last_online_time_ms() < planner.LastMoveTimeMs() + load.window_ms()) continue;
+
+      // owned bucket not in report is idle
+      for (auto bucket_id : layout_it->second) {
+        auto ops_it = load.bucket_ops().find(bucket_id);
+        uint64_t ops = ops_it != load.bucket_ops().end() ? ops_it->second : 0;
+        bucket_rates[bucket_id] = static_cast<double>(ops) * 1000 / load.window_ms();
+      }
+    }
+  }
+
+  auto options = BalancePlanner::Options::FromFlags();
+  planner.Update(options, bucket_rates);
+
+  const uint64_t now_ms = utils::TimestampMs();
+  auto moves = planner.Plan(options, layout, now_ms);
+  if (moves.empty()) return Status::OK();
+
+  double old_imbalance = BalancePlanner::Imbalance(planner.MdsLoads(layout));
+  BalancePlanner::Apply(moves, layout);
+  double new_imbalance = BalancePlanner::Imbalance(planner.MdsLoads(layout));
+
+  std::map<uint64_t, BucketSetEntry> distributions;
+  for (const auto& [mds_id, bucket_ids] : layout) {
+    Helper::VectorToPbRepeated(bucket_ids, distributions[mds_id].mutable_bucket_ids());
+  }
+
+  std::vector<std::string> move_strs;
+  for (const auto& move : moves) move_strs.push_back(move.ToString());
+
+  auto status = fs->UpdatePartitionPolicy(distributions, "move hot bucket by balancer");
+  LOG(INFO) << fmt::format("[balancer.{}] move bucket({}) imbalance({:.2f}->{:.2f}) finish, status({}).", fs_id,
+                           Helper::VectorToString(move_strs), old_imbalance, new_imbalance, status.error_str());
+  if (!status.ok()) return status;
+
+  planner.Commit(moves, now_ms);
+
+  // notify mds lost bucket clean cache and mds got bucket serve it
+  std::vector<uint64_t> mds_ids;
+  for (const auto& [mds_id, _] : layout) mds_ids.push_back(mds_id);
+  NotifyRefreshFs(mds_ids, fs->GetFsInfo());
+
+  return Status::OK();
+}
+
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,75 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_BACKGROUND_BALANCER_H_
+#define DINGOFS_MDS_BACKGROUND_BALANCER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "mds/background/balance_planner.h"
+#include "mds/common/distribution_lock.h"
+#include "mds/common/status.h"
+#include "mds/filesystem/filesystem.h"
+
+namespace dingofs {
+namespace mds {
+
+class Balancer;
+using BalancerSPtr = std::shared_ptr<Balancer>;
+
+// move hot bucket of hash partition fs between its mds, run by the lock owner.
+// every mds report bucket op rate of owned buckets in heartbeat, balancer plan
+// moves and update partition policy, then notify mds refresh fs info, the mds
+// lost bucket drop its cache and the mds got bucket start serve it.
+class Balancer {
+ public:
+  Balancer(FileSystemSetSPtr fs_set, DistributionLockSPtr dist_lock, notify::NotifyBuddySPtr notify_buddy)
+      : fs_set_(fs_set), dist_lock_(dist_lock), notify_buddy_(notify_buddy) {}
+  ~Balancer() = default;
+
+  static BalancerSPtr New(FileSystemSetSPtr fs_set, DistributionLockSPtr dist_lock,
+                          notify::NotifyBuddySPtr notify_buddy) {
+    return std::make_shared<Balancer>(fs_set, dist_lock, notify_buddy);
+  }
+
+  bool Init();
+  void Destroy();
+
+  void Run();
+
+ private:
+  Status BalanceFs(FileSystemSPtr fs, const std::vector<MdsEntry>& mdses);
+  void NotifyRefreshFs(const std::vector<uint64_t>& mds_ids, const FsInfoEntry& fs_info);
+
+  std::atomic<bool> is_running_{false};
+
+  FileSystemSetSPtr fs_set_;
+
+  DistributionLockSPtr dist_lock_;
+
+  // notify buddy
+  notify::NotifyBuddySPtr notify_buddy_;
+
+  // fs_id -> planner, only access in Run
+  std::map<uint32_t, BalancePlanner> planners_;
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_BACKGROUND_BALANCER_H_
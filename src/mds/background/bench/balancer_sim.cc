@@ -0,0 +1,300 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Hot bucket balancer simulator, replay op trace against a bucket layout and
+// run the balancer planner every report interval, report load imbalance of
+// static layout and balanced layout, and bucket moves. Trace is mds log with
+// service request line, or plain text line "<time_ms> <ino>", ino is parent
+// for dentry op. Op is counted to bucket same as mds, by parent if the request
+// has it, otherwise by ino, file ino op without parent is skipped when
+// --ino_affinity=false as its bucket is unknown. Layout file line is "<mds_id> <bucket_id>,<bucket_id>...",
+// default layout split buckets evenly to --mds_num mds. Planner is tuned by
+// --mds_balancer_* flags same as mds.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "mds/background/balance_planner.h"
+#include "mds/filesystem/bucket_load.h"
+
+DEFINE_string(trace_file, "", "op trace file, mds log or lines of <time_ms> <ino>");
+DEFINE_string(layout_file, "", "bucket layout file, lines of <mds_id> <bucket_id>,<bucket_id>...");
+DEFINE_uint32(fs_id, 0, "only replay op of the fs in mds log, 0 means all");
+DEFINE_uint32(bucket_num, 1024, "hash bucket num");
+DEFINE_uint32(mds_num, 3, "mds num of default layout");
+DEFINE_uint32(report_interval_ms, 5000, "bucket load report interval ms, same as heartbeat");
+DEFINE_bool(ino_affinity, true, "file ino is allocated in parent bucket, op of file ino is not counted if false");
+DEFINE_bool(verbose, false, "print every interval");
+
+namespace dingofs {
+namespace mds {
+
+static const uint64_t kDayMs = 24 * 3600 * 1000;
+
+struct Op {
+  uint64_t time_ms{0};
+  uint64_t ino{0};
+  // ino is parent of dentry op
+  bool is_parent{true};
+};
+
+// find "<key>: <number>" as a whole field
+static bool FindField(const std::string& line, size_t pos, const std::string& key, uint64_t& value) {
+  const std::string pattern = key + ": ";
+  while ((pos = line.find(pattern, pos)) != std::string::npos) {
+    if (pos == 0 || line[pos - 1] == ' ' || line[pos - 1] == '(') {
+      value = std::strtoull(line.c_str() + pos + pattern.size(), nullptr, 10);
+      return true;
+    }
+    pos += pattern.size();
+  }
+
+  return false;
+}
+
+// glog line start with "I0101 12:00:00.000000" or "I20260101 12:00:00.000000"
+static bool ParseLogTimeMs(const std::string& line, uint64_t& time_ms) {
+  size_t pos = line.find(' ');
+  if (pos == std::string::npos || pos + 16 > line.size()) return false;
+
+  uint32_t hour = 0, minute = 0, second = 0, micros = 0;
+  if (std::sscanf(line.c_str() + pos + 1, "%2u:%2u:%2u.%6u", &hour, &minute, &second, &micros) != 4) return false;
+
+  time_ms = ((hour * 60 + minute) * 60 + second) * 1000ULL + micros / 1000;
+  return true;
+}
+
+static bool ParseLogLine(const std::string& line, Op& op) {
+  size_t pos = line.find("request(");
+  if (pos == std::string::npos || line.find("[service.") == std::string::npos) return false;
+
+  uint64_t fs_id = 0;
+  if (FLAGS_fs_id != 0 && (!FindField(line, pos, "fs_id", fs_id) || fs_id != FLAGS_fs_id)) return false;
+
+  if (!FindField(line, pos, "parent", op.ino)) {
+    if (!FindField(line, pos, "ino", op.ino)) return false;
+    op.is_parent = false;
+  }
+
+  return ParseLogTimeMs(line, op.time_ms);
+}
+
+static bool LoadTrace(const std::string& path, std::vector<Op>& ops) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    LOG(ERROR) << fmt::format("open trace file({}) fail.", path);
+    return false;
+  }
+
+  uint64_t day_offset_ms = 0, last_time_ms = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    Op op;
+    std::istringstream stream(line);
+    if (line.find("request(") != std::string::npos) {
+      if (!ParseLogLine(line, op)) continue;
+
+      // log time is time of day, cross midnight when time go back much
+      op.time_ms += day_offset_ms;
+      if (op.time_ms + kDayMs / 2 < last_time_ms) {
+        day_offset_ms += kDayMs;
+        op.time_ms += kDayMs;
+      }
+
+    } else if (!(stream >> op.time_ms >> op.ino)) {
+      continue;
+    }
+
+    last_time_ms = op.time_ms;
+    ops.push_back(op);
+  }
+
+  return true;
+}
+
+static bool LoadLayout(const std::string& path, BucketLayout& layout) {
+  if (path.empty()) {
+    for (uint32_t bucket_id = 0; bucket_id < FLAGS_bucket_num; ++bucket_id) {
+      layout[1 + static_cast<uint64_t>(bucket_id) * FLAGS_mds_num / FLAGS_bucket_num].push_back(bucket_id);
+    }
+    return true;
+  }
+
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    LOG(ERROR) << fmt::format("open layout file({}) fail.", path);
+    return false;
+  }
+
+  uint32_t bucket_count = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    uint64_t mds_id = 0;
+    std::string bucket_ids;
+    if (!(stream >> mds_id >> bucket_ids)) continue;
+
+    std::istringstream bucket_stream(bucket_ids);
+    std::string bucket_id;
+    while (std::getline(bucket_stream, bucket_id, ',')) {
+      uint32_t id = std::strtoul(bucket_id.c_str(), nullptr, 10);
+      if (id >= FLAGS_bucket_num) {
+        LOG(ERROR) << fmt::format("layout bucket({}) exceed bucket num({}).", id, FLAGS_bucket_num);
+        return false;
+      }
+
+      layout[mds_id].push_back(id);
+      ++bucket_count;
+    }
+  }
+
+  if (bucket_count != FLAGS_bucket_num) {
+    LOG(ERROR) << fmt::format("layout bucket count({}) not equal bucket num({}).", bucket_count, FLAGS_bucket_num);
+    return false;
+  }
+
+  return true;
+}
+
+static std::map<uint64_t, double> GetMdsLoads(const BucketLayout& layout, const std::vector<uint64_t>& bucket_ops) {
+  std::map<uint64_t, double> mds_loads;
+  for (const auto& [mds_id, bucket_ids] : layout) {
+    double load = 0;
+    for (auto bucket_id : bucket_ids) load += bucket_ops[bucket_id];
+    mds_loads[mds_id] = load;
+  }
+
+  return mds_loads;
+}
+
+static std::string MdsLoadsToString(const std::map<uint64_t, double>& mds_loads) {
+  std::string str;
+  for (const auto& [mds_id, load] : mds_loads) {
+    if (!str.empty()) str += " ";
+    str += fmt::format("{}:{:.0f}", mds_id, load);
+  }
+
+  return str;
+}
+
+static void RunSim() {
+  std::vector<Op> ops;
+  CHECK(LoadTrace(FLAGS_trace_file, ops)) << "load trace fail.";
+  CHECK(!ops.empty()) << "trace is empty.";
+
+  BucketLayout static_layout;
+  CHECK(LoadLayout(FLAGS_layout_file, static_layout)) << "load layout fail.";
+  BucketLayout layout = static_layout;
+
+  auto options = BalancePlanner::Options::FromFlags();
+  BalancePlanner planner(FLAGS_bucket_num);
+
+  const uint64_t interval_ms = FLAGS_report_interval_ms;
+  uint64_t window_end_ms = ops.front().time_ms + interval_ms;
+  std::vector<uint64_t> bucket_ops(FLAGS_bucket_num, 0);
+
+  uint32_t window_count = 0, move_count = 0;
+  double static_imbalance_sum = 0, balanced_imbalance_sum = 0;
+  double static_peak = 0, balanced_peak = 0;
+
+  auto finish_window = [&]() {
+    auto static_loads = GetMdsLoads(static_layout, bucket_ops);
+    auto balanced_loads = GetMdsLoads(layout, bucket_ops);
+
+    ++window_count;
+    static_imbalance_sum += BalancePlanner::Imbalance(static_loads);
+    balanced_imbalance_sum += BalancePlanner::Imbalance(balanced_loads);
+    for (const auto& [_, load] : static_loads) static_peak = std::max(static_peak, load);
+    for (const auto& [_, load] : balanced_loads) balanced_peak = std::max(balanced_peak, load);
+
+    // report op rate as mds heartbeat do
+    std::map<uint32_t, double> bucket_rates;
+    for (uint32_t bucket_id = 0; bucket_id < FLAGS_bucket_num; ++bucket_id) {
+      bucket_rates[bucket_id] = static_cast<double>(bucket_ops[bucket_id]) * 1000 / interval_ms;
+    }
+    planner.Update(options, bucket_rates);
+
+    auto moves = planner.Plan(options, layout, window_end_ms);
+    if (!moves.empty()) {
+      BalancePlanner::Apply(moves, layout);
+      planner.Commit(moves, window_end_ms);
+      move_count += moves.size();
+    }
+
+    if (FLAGS_verbose) {
+      std::vector<std::string> move_strs;
+      for (const auto& move : moves) move_strs.push_back(move.ToString());
+
+      std::cout << fmt::format("window({}) static({}) balanced({}) moves({})\n", window_count,
+                               MdsLoadsToString(static_loads), MdsLoadsToString(balanced_loads),
+                               fmt::join(move_strs, ","));
+    }
+
+    std::fill(bucket_ops.begin(), bucket_ops.end(), 0);
+    window_end_ms += interval_ms;
+  };
+
+  for (const auto& op : ops) {
+    while (op.time_ms >= window_end_ms) finish_window();
+
+    uint32_t bucket_id = 0;
+    if (op.is_parent) {
+      bucket_id = BucketLoadRecorder::ParentBucketId(op.ino, FLAGS_bucket_num);
+    } else if (!BucketLoadRecorder::InoBucketId(op.ino, 0, FLAGS_bucket_num, FLAGS_ino_affinity, bucket_id)) {
+      continue;
+    }
+    ++bucket_ops[bucket_id];
+  }
+  finish_window();
+
+  std::cout << fmt::format("ops: {} windows: {} interval(ms): {} mds: {} buckets: {}\n", ops.size(), window_count,
+                           interval_ms, layout.size(), FLAGS_bucket_num);
+  std::cout << fmt::format("static layout avg imbalance: {:.3f} max mds ops/window: {:.0f}\n",
+                           static_imbalance_sum / window_count, static_peak);
+  std::cout << fmt::format("balanced layout avg imbalance: {:.3f} max mds ops/window: {:.0f} moves: {}\n",
+                           balanced_imbalance_sum / window_count, balanced_peak, move_count);
+
+  for (const auto& [mds_id, bucket_ids] : layout) {
+    std::cout << fmt::format("{} {}\n", mds_id, fmt::join(bucket_ids, ","));
+  }
+}
+
+}  // namespace mds
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(!FLAGS_trace_file.empty()) << "trace_file is empty.";
+  CHECK(FLAGS_bucket_num > 0) << "bucket_num must be positive.";
+  CHECK(FLAGS_mds_num > 0) << "mds_num must be positive.";
+  CHECK(FLAGS_report_interval_ms > 0) << "report_interval_ms must be positive.";
+
+  dingofs::mds::RunSim();
+
+  return 0;
+}
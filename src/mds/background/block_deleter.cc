@@ -0,0 +1,245 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/background/block_deleter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "brpc/reloadable_flags.h"
+#include "bthread/bthread.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
+#include "bvar/window.h"
+#include "dingofs/error.pb.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_uint32(mds_gc_delete_concurrency, 16, "gc concurrent batch delete request num of every fs.");
+
+DEFINE_uint32(mds_gc_delete_batch_size, 1000, "gc max object num of one batch delete request, s3 allow 1000 at most.");
+DEFINE_validator(mds_gc_delete_batch_size, brpc::PassValidate);
+
+DEFINE_uint32(mds_gc_delete_batch_wait_ms, 20, "gc max wait time to fill a batch delete request.");
+DEFINE_validator(mds_gc_delete_batch_wait_ms, brpc::PassValidate);
+
+DEFINE_uint32(mds_gc_delete_max_pending_num, 200000, "gc max pending object num to delete of every fs.");
+DEFINE_validator(mds_gc_delete_max_pending_num, brpc::PassValidate);
+
+DEFINE_uint32(mds_gc_delete_object_rate, 0, "gc max deleted object num per second of every fs, 0 means no limit.");
+DEFINE_validator(mds_gc_delete_object_rate, brpc::PassValidate);
+
+static const uint32_t kMaxBatchDeleteObjectSize = 1000;
+
+static bvar::Adder<uint64_t> g_gc_delete_object_count("mds_gc_delete_object_count");
+static bvar::PerSecond<bvar::Adder<uint64_t>> g_gc_delete_object_per_second("mds_gc_delete_object_per_second",
+                                                                             &g_gc_delete_object_count);
+static bvar::Adder<uint64_t> g_gc_delete_fail_count("mds_gc_delete_fail_count");
+static bvar::LatencyRecorder g_gc_delete_batch_size_recorder("mds_gc_delete_batch", "size");
+static bvar::LatencyRecorder g_gc_delete_batch_latency("mds_gc_delete_batch");
+
+Status BlockDeleter::Waiter::Wait() {
+  std::unique_lock<bthread::Mutex> lock(mutex_);
+  while (pending_ > 0) {
+    cond_.wait(lock);
+  }
+
+  return status_;
+}
+
+void BlockDeleter::Waiter::Add(uint32_t count) {
+  std::lock_guard<bthread::Mutex> lock(mutex_);
+  pending_ += count;
+}
+
+void BlockDeleter::Waiter::Done(const Status& status) {
+  std::lock_guard<bthread::Mutex> lock(mutex_);
+  if (!status.ok() && status_.ok()) status_ = status;
+
+  CHECK(pending_ > 0) << "waiter pending underflow.";
+  if (--pending_ == 0) cond_.notify_all();
+}
+
+BlockDeleter::BlockDeleter(uint32_t fs_id, blockaccess::BlockAccesserSPtr block_accessor)
+    : fs_id_(fs_id), block_accessor_(block_accessor), rate_limiter_(fmt::format("gc_delete_{}", fs_id)) {}
+
+BlockDeleter::~BlockDeleter() { Destroy(); }
+
+bool BlockDeleter::Init() {
+  const uint32_t worker_num = std::max(FLAGS_mds_gc_delete_concurrency, 1U);
+  for (uint32_t i = 0; i < worker_num; ++i) {
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr, &BlockDeleter::RunWorker, this) != 0) {
+      LOG(ERROR) << fmt::format("[gc.deleter.{}] start worker fail.", fs_id_);
+      return false;
+    }
+    workers_.push_back(tid);
+  }
+
+  LOG(INFO) << fmt::format("[gc.deleter.{}] init finish, worker({}).", fs_id_, worker_num);
+
+  return true;
+}
+
+void BlockDeleter::Destroy() {
+  {
+    std::lock_guard<bthread::Mutex> lock(mutex_);
+    if (is_stop_) return;
+    is_stop_ = true;
+  }
+
+  worker_cond_.notify_all();
+  submit_cond_.notify_all();
+
+  // worker flush remain batches before exit
+  for (auto tid : workers_) bthread_join(tid, nullptr);
+  workers_.clear();
+}
+
+void BlockDeleter::Submit(std::list<std::string>& keys, WaiterSPtr waiter) {
+  if (keys.empty()) return;
+
+  const uint32_t batch_size = std::clamp(FLAGS_mds_gc_delete_batch_size, 1U, kMaxBatchDeleteObjectSize);
+
+  std::unique_lock<bthread::Mutex> lock(mutex_);
+  while (!is_stop_ && pending_key_count_ >= FLAGS_mds_gc_delete_max_pending_num) {
+    submit_cond_.wait(lock);
+  }
+
+  if (is_stop_) {
+    lock.unlock();
+    waiter->Add(1);
+    waiter->Done(Status(pb::error::EINTERNAL, "block deleter stopped"));
+    return;
+  }
+
+  const uint64_t now_ms = utils::TimestampMs();
+  while (!keys.empty()) {
+    if (current_batch_.keys.empty()) current_batch_time_ms_ = now_ms;
+
+    // batch hold one reference of every waiter
+    if (current_batch_.waiters.empty() || current_batch_.waiters.back() != waiter) {
+      waiter->Add(1);
+      current_batch_.waiters.push_back(waiter);
+    }
+
+    current_batch_.keys.splice(current_batch_.keys.end(), keys, keys.begin());
+    ++pending_key_count_;
+
+    if (current_batch_.keys.size() >= batch_size) {
+      ready_batches_.push_back(std::move(current_batch_));
+      current_batch_ = Batch{};
+      worker_cond_.notify_one();
+    }
+  }
+}
+
+Status BlockDeleter::Delete(std::list<std::string>& keys) {
+  auto waiter = NewWaiter();
+  Submit(keys, waiter);
+
+  return waiter->Wait();
+}
+
+bool BlockDeleter::TakeBatch(Batch& batch) {
+  std::unique_lock<bthread::Mutex> lock(mutex_);
+  while (true) {
+    if (!ready_batches_.empty()) {
+      batch = std::move(ready_batches_.front());
+      ready_batches_.pop_front();
+      return true;
+    }
+
+    // flush not full batch when wait timeout or stop
+    if (!current_batch_.keys.empty() &&
+        (is_stop_ || utils::TimestampMs() >= current_batch_time_ms_ + FLAGS_mds_gc_delete_batch_wait_ms)) {
+      batch = std::move(current_batch_);
+      current_batch_ = Batch{};
+      return true;
+    }
+
+    if (is_stop_) return false;
+
+    worker_cond_.wait_for(lock, std::max(FLAGS_mds_gc_delete_batch_wait_ms, 1U) * 1000);
+  }
+}
+
+void BlockDeleter::UpdateRateLimit() {
+  std::lock_guard<bthread::Mutex> lock(mutex_);
+
+  const uint32_t rate_limit = FLAGS_mds_gc_delete_object_rate;
+  if (rate_limit == rate_limit_) return;
+
+  if (rate_limiter_.SetLimit(rate_limit, 0, 0)) {
+    LOG(INFO) << fmt::format("[gc.deleter.{}] update rate limit {} -> {}.", fs_id_, rate_limit_, rate_limit);
+    rate_limit_ = rate_limit;
+  }
+}
+
+void BlockDeleter::ExecuteBatch(Batch& batch) {
+  const size_t key_count = batch.keys.size();
+
+  // pace by object num, no wait when no limit
+  UpdateRateLimit();
+  rate_limiter_.Add(key_count);
+
+  utils::Duration duration;
+  auto status = block_accessor_->BatchDelete(batch.keys);
+  g_gc_delete_batch_latency << duration.ElapsedUs();
+  g_gc_delete_batch_size_recorder << key_count;
+
+  Status result;
+  if (status.ok()) {
+    g_gc_delete_object_count << key_count;
+    deleted_count_.fetch_add(key_count, std::memory_order_relaxed);
+
+  } else {
+    g_gc_delete_fail_count << key_count;
+    result = Status(pb::error::EINTERNAL,
+                    fmt::format("delete s3 object fail, keys({}) status({}).", key_count, status.ToString()));
+    LOG(ERROR) << fmt::format("[gc.deleter.{}] {}", fs_id_, result.error_str());
+  }
+
+  {
+    std::lock_guard<bthread::Mutex> lock(mutex_);
+    pending_key_count_ -= key_count;
+  }
+  submit_cond_.notify_all();
+
+  for (auto& waiter : batch.waiters) waiter->Done(result);
+}
+
+void* BlockDeleter::RunWorker(void* arg) {
+  auto* self = reinterpret_cast<BlockDeleter*>(arg);
+
+  Batch batch;
+  while (self->TakeBatch(batch)) {
+    self->ExecuteBatch(batch);
+    batch = Batch{};
+  }
+
+  return nullptr;
+}
+
+}  // namespace mds
+}  // namespace dingofs
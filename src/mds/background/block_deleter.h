@@ -0,0 +1,129 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_BACKGROUND_BLOCK_DELETER_H_
+#define DINGOFS_MDS_BACKGROUND_BLOCK_DELETER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "bthread/condition_variable.h"
+#include "bthread/mutex.h"
+#include "common/blockaccess/block_accesser.h"
+#include "mds/common/status.h"
+#include "utils/leaky_bucket.h"
+
+namespace dingofs {
+namespace mds {
+
+class BlockDeleter;
+using BlockDeleterSPtr = std::shared_ptr<BlockDeleter>;
+
+// delete block keys of many gc tasks of one fs, keys are packed into max size
+// batch delete request across tasks, run by a bounded bthread pool and paced
+// by object rate. Task submit keys in segments and wait all of them done.
+class BlockDeleter {
+ public:
+  BlockDeleter(uint32_t fs_id, blockaccess::BlockAccesserSPtr block_accessor);
+  ~BlockDeleter();
+
+  static BlockDeleterSPtr New(uint32_t fs_id, blockaccess::BlockAccesserSPtr block_accessor) {
+    return std::make_shared<BlockDeleter>(fs_id, block_accessor);
+  }
+
+  // track keys of one task
+  class Waiter {
+   public:
+    Waiter() = default;
+    ~Waiter() = default;
+
+    // wait all submitted keys done, return first error
+    Status Wait();
+
+   private:
+    friend class BlockDeleter;
+
+    void Add(uint32_t count);
+    void Done(const Status& status);
+
+    bthread::Mutex mutex_;
+    bthread::ConditionVariable cond_;
+    uint32_t pending_{0};
+    Status status_;
+  };
+  using WaiterSPtr = std::shared_ptr<Waiter>;
+
+  static WaiterSPtr NewWaiter() { return std::make_shared<Waiter>(); }
+
+  bool Init();
+  void Destroy();
+
+  // append keys into batch, block when too many pending keys
+  void Submit(std::list<std::string>& keys, WaiterSPtr waiter);
+
+  // submit and wait
+  Status Delete(std::list<std::string>& keys);
+
+  uint32_t FsId() const { return fs_id_; }
+
+  // total deleted object count
+  uint64_t DeletedCount() const { return deleted_count_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Batch {
+    std::list<std::string> keys;
+    std::vector<WaiterSPtr> waiters;
+  };
+
+  // return false when stop
+  bool TakeBatch(Batch& batch);
+  void ExecuteBatch(Batch& batch);
+  void UpdateRateLimit();
+
+  static void* RunWorker(void* arg);
+
+  const uint32_t fs_id_;
+  blockaccess::BlockAccesserSPtr block_accessor_;
+
+  bthread::Mutex mutex_;
+  // notify worker ready batch
+  bthread::ConditionVariable worker_cond_;
+  // notify submitter pending keys decrease
+  bthread::ConditionVariable submit_cond_;
+  bool is_stop_{false};
+
+  // batch in filling
+  Batch current_batch_;
+  uint64_t current_batch_time_ms_{0};
+  std::deque<Batch> ready_batches_;
+  uint64_t pending_key_count_{0};
+
+  std::vector<bthread_t> workers_;
+
+  utils::LeakyBucket rate_limiter_;
+  uint32_t rate_limit_{0};
+
+  std::atomic<uint64_t> deleted_count_{0};
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_BACKGROUND_BLOCK_DELETER_H_
@@ -14,15 +14,20 @@
 
 #include "mds/background/gc.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <list>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "brpc/reloadable_flags.h"
 #include "cache/blockcache/cache_store.h"
+#include "common/blockaccess/files/file_common.h"
 #include "common/blockaccess/rados/rados_common.h"
 #include "common/blockaccess/s3/s3_common.h"
 #include "common/logging.h"
@@ -32,6 +37,7 @@
 #include "gflags/gflags.h"
 #include "glog/logging.h"
 #include "mds/common/codec.h"
+#include "mds/common/event_log.h"
 #include "mds/common/helper.h"
 #include "mds/common/runnable.h"
 #include "mds/common/status.h"
@@ -51,10 +57,15 @@ DEFINE_validator(mds_gc_max_pending_task_count, brpc::PassValidate);
 
 DEFINE_bool(mds_gc_delslice_enable, true, "gc delslice enable");
 DEFINE_validator(mds_gc_delslice_enable, brpc::PassValidate);
+DEFINE_bool(mds_gc_delpack_enable, true, "gc delpack enable");
+DEFINE_validator(mds_gc_delpack_enable, brpc::PassValidate);
 DEFINE_bool(mds_gc_delfile_enable, true, "gc delfile enable");
 DEFINE_validator(mds_gc_delfile_enable, brpc::PassValidate);
 DEFINE_bool(mds_gc_filesession_enable, true, "gc filesession enable");
 DEFINE_validator(mds_gc_filesession_enable, brpc::PassValidate);
+DEFINE_uint32(mds_gc_filesession_full_scan_interval_s, 3600,
+              "gc full scan filesession interval, for dead client and session without expire index");
+DEFINE_validator(mds_gc_filesession_full_scan_interval_s, brpc::PassValidate);
 DEFINE_bool(mds_gc_delfs_enable, true, "gc delfs enable");
 DEFINE_validator(mds_gc_delfs_enable, brpc::PassValidate);
 
@@ -64,36 +75,16 @@ DEFINE_validator(mds_gc_delslice_reserve_time_s, brpc::PassValidate);
 DEFINE_uint32(mds_gc_delfile_reserve_time_s, 600, "gc del file reserve time");
 DEFINE_validator(mds_gc_delfile_reserve_time_s, brpc::PassValidate);
 
-static const std::string kWorkerSetName = "GC";
-
-static const uint32_t kBatchDeleteObjectSize = 1000;
+DEFINE_uint32(mds_gc_delpack_uncommit_time_s, 3600,
+              "gc pack whose slices not all committed after this time since its last slice change");
+DEFINE_validator(mds_gc_delpack_uncommit_time_s, brpc::PassValidate);
 
-// batch delete s3 object
-static Status BatchDeleteBlocks(blockaccess::BlockAccesserSPtr& data_accessor, const std::list<std::string>& keys) {
-  if (keys.size() <= kBatchDeleteObjectSize) {
-    auto status = data_accessor->BatchDelete(keys);
-    if (!status.ok()) {
-      return Status(pb::error::EINTERNAL,
-                    fmt::format("delete s3 object fail, keys({}) status({}).", keys.size(), status.ToString()));
-    }
-  } else {
-    auto it = keys.begin();
-    while (it != keys.end()) {
-      std::list<std::string> batch_keys;
-      for (uint32_t i = 0; i < kBatchDeleteObjectSize && it != keys.end(); ++i, ++it) {
-        batch_keys.push_back(*it);
-      }
-
-      auto status = data_accessor->BatchDelete(batch_keys);
-      if (!status.ok()) {
-        return Status(pb::error::EINTERNAL,
-                      fmt::format("delete s3 object fail, keys({}) status({}).", batch_keys.size(), status.ToString()));
-      }
-    }
-  }
+static const std::string kWorkerSetName = "GC";
 
-  return Status::OK();
-}
+// submit keys to block deleter in segment, avoid holding all keys of big file
+static const uint32_t kDeleteKeySegmentSize = 1000;
+// scan chunks of file in page, avoid holding all chunks of big file
+static const uint32_t kScanChunkSliceNum = 4096;
 
 // range [start, end)
 static IntRange CalBlockIndex(uint64_t block_size, uint64_t chunk_offset, const SliceEntry& slice) {
@@ -128,6 +119,7 @@ void CleanDelSliceTask::Run() {
 }
 
 Status CleanDelSliceTask::CleanDelSlice() {
+  auto waiter = BlockDeleter::NewWaiter();
   std::list<std::string> keys;
   std::string slice_id_trace;
   auto trash_slice_list = MetaCodec::DecodeDelSliceValue(value_);
@@ -141,8 +133,9 @@ Status CleanDelSliceTask::CleanDelSlice() {
         cache::BlockKey block_key(slice.fs_id(), slice.ino(), slice.slice_id(), block_index,
                                   slice_range.compaction_version());
 
-        LOG(INFO) << fmt::format("[gc.delslice.{}] delete block key({}).", ino_, block_key.StoreKey());
+        EVENT_LOG(INFO, "[gc.delslice.{}] delete block key({}).", ino_, block_key.StoreKey());
         keys.push_back(block_key.StoreKey());
+        if (keys.size() >= kDeleteKeySegmentSize) block_deleter_->Submit(keys, waiter);
       }
     }
 
@@ -153,15 +146,14 @@ Status CleanDelSliceTask::CleanDelSlice() {
   }
 
   // delete data from s3
-  if (!keys.empty()) {
-    auto status = BatchDeleteBlocks(data_accessor_, keys);
-    if (!status.ok()) return status;
-  }
+  block_deleter_->Submit(keys, waiter);
+  auto status = waiter->Wait();
+  if (!status.ok()) return status;
 
   // delete slice
   class Trace trace;
   CleanDelSliceOperation operation(trace, key_);
-  auto status = operation_processor_->RunAlone(&operation);
+  status = operation_processor_->RunAlone(&operation);
   if (!status.ok()) {
     return status;
   }
@@ -171,6 +163,41 @@ Status CleanDelSliceTask::CleanDelSlice() {
   return Status::OK();
 }
 
+// pack object is stored as the only block of pack slice
+static std::string PackBlockKey(uint32_t fs_id, uint64_t pack_id) {
+  return cache::BlockKey(fs_id, 0, pack_id, 0, 0).StoreKey();
+}
+
+void CleanDelPackTask::Run() {
+  auto status = CleanDelPack();
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[gc.delpack.{}] clean deleted pack fail, {}", pack_id_, status.error_str());
+  }
+
+  // forget task
+  if (task_memo_ != nullptr) task_memo_->Forget(MetaCodec::EncodeDelPackKey(fs_id_, pack_id_, 0));
+}
+
+Status CleanDelPackTask::CleanDelPack() {
+  // delete data from s3
+  std::list<std::string> keys = {PackBlockKey(fs_id_, pack_id_)};
+  EVENT_LOG(INFO, "[gc.delpack.{}] delete block key({}).", pack_id_, keys.front());
+  auto status = block_deleter_->Delete(keys);
+  if (!status.ok()) return status;
+
+  // delete pack dead record
+  class Trace trace;
+  CleanDelPackOperation operation(trace, keys_);
+  status = operation_processor_->RunAlone(&operation);
+  if (!status.ok()) {
+    return status;
+  }
+
+  LOG(INFO) << fmt::format("[gc.delpack.{}] clean pack finish, refs({}).", pack_id_, keys_.size());
+
+  return Status::OK();
+}
+
 void CleanDelFileTask::Run() {
   auto status = CleanDelFile(attr_);
   if (!status.ok()) {
@@ -183,20 +210,27 @@ void CleanDelFileTask::Run() {
   }
 }
 
-static Status GetChunks(OperationProcessorSPtr operation_processor, uint32_t fs_id, Ino ino,
-                        std::vector<ChunkEntry>& chunks) {
-  class Trace trace;
-  ScanChunkOperation operation(trace, fs_id, ino);
-  operation.SetIsolationLevel(Txn::kReadCommitted);
+// scan chunks page by page, every page stop at chunk boundary
+static Status ScanChunks(OperationProcessorSPtr operation_processor, uint32_t fs_id, Ino ino,
+                         const std::function<void(const ChunkEntry&)>& handler) {
+  uint64_t start_chunk_index = 0;
+  while (true) {
+    class Trace trace;
+    ScanChunkOperation operation(trace, fs_id, ino, kScanChunkSliceNum, start_chunk_index);
+    operation.SetIsolationLevel(Txn::kReadCommitted);
 
-  auto status = operation_processor->RunAlone(&operation);
-  if (!status.ok()) {
-    return status;
-  }
+    auto status = operation_processor->RunAlone(&operation);
+    if (!status.ok()) {
+      return status;
+    }
 
-  auto& result = operation.GetResult();
+    auto& result = operation.GetResult();
+    if (result.chunks.empty()) break;
+
+    for (const auto& chunk : result.chunks) handler(chunk);
 
-  chunks = std::move(result.chunks);
+    start_chunk_index = result.chunks.back().index() + 1;
+  }
 
   return Status::OK();
 }
@@ -204,36 +238,39 @@ static Status GetChunks(OperationProcessorSPtr operation_processor, uint32_t fs_
 Status CleanDelFileTask::CleanDelFile(const AttrEntry& attr) {
   LOG(INFO) << fmt::format("[gc.delfile.{}] clean delfile, nlink({}) len({}) ctime({}) version({}).", attr.ino(),
                            attr.nlink(), attr.length(), attr.ctime(), attr.version());
-  // get file chunks
-  std::vector<ChunkEntry> chunks;
-  auto status = GetChunks(operation_processor_, attr.fs_id(), attr.ino(), chunks);
-  if (!status.ok()) {
-    return status;
-  }
-
-  // delete data from s3
+  // delete data from s3, chunks are scanned page by page
+  auto waiter = BlockDeleter::NewWaiter();
   std::list<std::string> keys;
-  for (const auto& chunk : chunks) {
+  std::vector<SliceEntry> packed_slices;
+  auto status = ScanChunks(operation_processor_, attr.fs_id(), attr.ino(), [&](const ChunkEntry& chunk) {
     uint64_t chunk_offset = chunk.index() * chunk.chunk_size();
     for (const auto& slice : chunk.slices()) {
+      // pack object is shared, deleted by delpack gc
+      if (slice.pack_refs() > 0) {
+        packed_slices.push_back(slice);
+        continue;
+      }
+
       auto range = CalBlockIndex(chunk.block_size(), chunk_offset, slice);
       for (uint32_t block_index = range.start; block_index < range.end; ++block_index) {
         cache::BlockKey block_key(attr.fs_id(), attr.ino(), slice.id(), block_index, slice.compaction_version());
 
-        LOG(INFO) << fmt::format("[gc.delfile.{}] delete block key({}).", attr.ino(), block_key.StoreKey());
+        EVENT_LOG(INFO, "[gc.delfile.{}] delete block key({}).", attr.ino(), block_key.StoreKey());
         keys.push_back(block_key.StoreKey());
+        if (keys.size() >= kDeleteKeySegmentSize) block_deleter_->Submit(keys, waiter);
       }
     }
-  }
+  });
 
-  if (!keys.empty()) {
-    auto status = BatchDeleteBlocks(data_accessor_, keys);
-    if (!status.ok()) return status;
-  }
+  // wait submitted keys even scan fail
+  block_deleter_->Submit(keys, waiter);
+  auto wait_status = waiter->Wait();
+  if (!status.ok()) return status;
+  if (!wait_status.ok()) return wait_status;
 
   // delete inode
   class Trace trace;
-  CleanDelFileOperation operation(trace, attr.fs_id(), attr.ino(), attr.maybe_tiny_file());
+  CleanDelFileOperation operation(trace, attr.fs_id(), attr.ino(), attr.maybe_tiny_file(), std::move(packed_slices));
   status = operation_processor_->RunAlone(&operation);
   if (!status.ok()) {
     return status;
@@ -254,42 +291,51 @@ void CleanFileTask::Run() {
 Status CleanFileTask::CleanFile(const AttrEntry& attr) {
   LOG(INFO) << fmt::format("[gc.delfs] clean delfs, ino({}) nlink({}) len({}) version({}).", attr.ino(), attr.nlink(),
                            attr.length(), attr.version());
-  // get file chunks
-  std::vector<ChunkEntry> chunks;
-  auto status = GetChunks(operation_processor_, attr.fs_id(), attr.ino(), chunks);
-  if (!status.ok()) {
-    return status;
-  }
-
-  // delete data from s3
+  // delete data from s3, chunks are scanned page by page
+  auto waiter = BlockDeleter::NewWaiter();
+  uint64_t block_count = 0;
   std::list<std::string> keys;
-  for (const auto& chunk : chunks) {
+  std::set<uint64_t> pack_ids;
+  auto status = ScanChunks(operation_processor_, attr.fs_id(), attr.ino(), [&](const ChunkEntry& chunk) {
     uint64_t chunk_offset = chunk.index() * chunk.chunk_size();
     for (const auto& slice : chunk.slices()) {
+      // whole fs is deleted, so pack object can be deleted directly
+      if (slice.pack_refs() > 0) {
+        if (pack_ids.insert(slice.id()).second) {
+          EVENT_LOG(INFO, "[gc.delfs] delete pack key({}).", PackBlockKey(attr.fs_id(), slice.id()));
+          keys.push_back(PackBlockKey(attr.fs_id(), slice.id()));
+          ++block_count;
+        }
+        continue;
+      }
+
       auto range = CalBlockIndex(chunk.block_size(), chunk_offset, slice);
       for (uint32_t block_index = range.start; block_index < range.end; ++block_index) {
         cache::BlockKey block_key(attr.fs_id(), attr.ino(), slice.id(), block_index, slice.compaction_version());
 
-        LOG(INFO) << fmt::format("[gc.delfs] delete block key({}).", block_key.StoreKey());
+        EVENT_LOG(INFO, "[gc.delfs] delete block key({}).", block_key.StoreKey());
         keys.push_back(block_key.StoreKey());
+        ++block_count;
+        if (keys.size() >= kDeleteKeySegmentSize) block_deleter_->Submit(keys, waiter);
       }
     }
-  }
+  });
 
-  if (!keys.empty()) {
-    auto status = BatchDeleteBlocks(data_accessor_, keys);
-    if (!status.ok()) return status;
-  }
+  // wait submitted keys even scan fail
+  block_deleter_->Submit(keys, waiter);
+  auto wait_status = waiter->Wait();
+  if (!status.ok()) return status;
+  if (!wait_status.ok()) return wait_status;
 
-  // update recyle progress
+  // update recyle progress, count the file only when its blocks are all deleted
   class Trace trace;
-  UpdateFsRecycleProgressOperation operation(trace, fs_name_, attr.ino());
+  UpdateFsRecycleProgressOperation operation(trace, fs_name_, attr.ino(), block_count);
   status = operation_processor_->RunAlone(&operation);
   if (!status.ok()) {
     return status;
   }
 
-  LOG(INFO) << fmt::format("[gc.delfs] clean file({}/{}) finish.", attr.fs_id(), attr.ino());
+  LOG(INFO) << fmt::format("[gc.delfs] clean file({}/{}) finish, blocks({}).", attr.fs_id(), attr.ino(), block_count);
 
   return Status::OK();
 }
@@ -337,6 +383,13 @@ void GcProcessor::Destroy() {
   if (worker_set_ != nullptr) {
     worker_set_->Destroy();
   }
+
+  // after worker set, no more submit
+  utils::WriteLockGuard lk(block_deleter_lock_);
+  for (auto& [_, block_deleter] : block_deleters_) {
+    block_deleter->Destroy();
+  }
+  block_deleters_.clear();
 }
 
 void GcProcessor::Run() {
@@ -347,15 +400,15 @@ void GcProcessor::Run() {
 }
 
 Status GcProcessor::ManualCleanDelSlice(Trace& trace, uint32_t fs_id, Ino ino, uint64_t chunk_index) {
-  auto block_accessor = GetOrCreateDataAccesser(fs_id);
-  if (block_accessor == nullptr) {
-    LOG(ERROR) << fmt::format("[gc.delfile] get data accesser fail, fs_id({}).", fs_id);
-    return Status(pb::error::EINTERNAL, "get data accesser fail");
+  auto block_deleter = GetOrCreateBlockDeleter(fs_id);
+  if (block_deleter == nullptr) {
+    LOG(ERROR) << fmt::format("[gc.delfile] get block deleter fail, fs_id({}).", fs_id);
+    return Status(pb::error::EINTERNAL, "get block deleter fail");
   }
 
   ScanDelSliceOperation operation(
       trace, fs_id, ino, chunk_index, [&](const std::string& key, const std::string& value) -> bool {
-        auto task = CleanDelSliceTask::New(operation_processor_, block_accessor, nullptr, ino, key, value);
+        auto task = CleanDelSliceTask::New(operation_processor_, block_deleter, nullptr, ino, key, value);
         auto status = task->CleanDelSlice();
         if (!status.ok()) {
           LOG(ERROR) << fmt::format("[gc.delslice] clean delfile fail, status({}).", status.error_str());
@@ -375,10 +428,10 @@ Status GcProcessor::ManualCleanDelSlice(Trace& trace, uint32_t fs_id, Ino ino, u
 }
 
 Status GcProcessor::ManualCleanDelFile(Trace& trace, uint32_t fs_id, Ino ino) {
-  auto block_accessor = GetOrCreateDataAccesser(fs_id);
-  if (block_accessor == nullptr) {
-    LOG(ERROR) << fmt::format("[gc.delfile] get data accesser fail, fs_id({}).", fs_id);
-    return Status(pb::error::EINTERNAL, "get data accesser fail");
+  auto block_deleter = GetOrCreateBlockDeleter(fs_id);
+  if (block_deleter == nullptr) {
+    LOG(ERROR) << fmt::format("[gc.delfile] get block deleter fail, fs_id({}).", fs_id);
+    return Status(pb::error::EINTERNAL, "get block deleter fail");
   }
 
   GetDelFileOperation operation(trace, fs_id, ino);
@@ -392,7 +445,7 @@ Status GcProcessor::ManualCleanDelFile(Trace& trace, uint32_t fs_id, Ino ino) {
   auto& result = operation.GetResult();
   const auto& attr = result.attr;
 
-  auto task = CleanDelFileTask::New(operation_processor_, block_accessor, nullptr, attr);
+  auto task = CleanDelFileTask::New(operation_processor_, block_deleter, nullptr, attr);
   status = task->CleanDelFile(attr);
   if (!status.ok()) {
     LOG(ERROR) << fmt::format("[gc.delfile] clean delfile fail, status({}).", status.error_str());
@@ -432,6 +485,13 @@ Status GcProcessor::LaunchGc() {
     }
   }
 
+  // delpack
+  if (FLAGS_mds_gc_delpack_enable) {
+    for (auto& fs_info : fs_infoes) {
+      ScanDelPack(fs_info);
+    }
+  }
+
   // delfile
   if (FLAGS_mds_gc_delfile_enable) {
     for (auto& fs_info : fs_infoes) {
@@ -441,8 +501,17 @@ Status GcProcessor::LaunchGc() {
 
   // filesession
   if (FLAGS_mds_gc_filesession_enable) {
+    // full scan at long interval, otherwise only scan expire index
+    const uint64_t now_s = utils::Timestamp();
+    bool is_full_scan = now_s >= last_filesession_full_scan_time_s_ + FLAGS_mds_gc_filesession_full_scan_interval_s;
+    if (is_full_scan) last_filesession_full_scan_time_s_ = now_s;
+
     for (auto& fs_info : fs_infoes) {
-      ScanExpiredFileSession(fs_info);
+      if (is_full_scan) {
+        ScanFileSession(fs_info);
+      } else {
+        ScanExpiredFileSession(fs_info);
+      }
     }
   }
 
@@ -496,6 +565,19 @@ Status GcProcessor::GetClientList(std::set<std::string>& clients) {
 }
 
 bool GcProcessor::HasFileSession(uint32_t fs_id, Ino ino) {
+  // memory lookup when file session cache is authoritative
+  auto fs = file_system_set_->GetFileSystem(fs_id);
+  if (fs != nullptr) {
+    bool is_alive = false;
+    auto status = fs->GetFileSessionManager().IsAlive(ino, is_alive);
+    if (!status.ok()) {
+      LOG(ERROR) << fmt::format("[gc.delfile] check file session fail, {}.", status.error_str());
+      return true;
+    }
+
+    return is_alive;
+  }
+
   Trace trace;
   bool is_exist = false;
   ScanFileSessionOperation operation(trace, fs_id, ino, [&](const FileSessionEntry&) -> bool {
@@ -539,14 +621,14 @@ void GcProcessor::ScanDelSlice(const FsInfoEntry& fs_info) {
       return true;
     }
 
-    auto block_accessor = GetOrCreateDataAccesser(fs_info);
-    if (block_accessor == nullptr) {
-      LOG(ERROR) << fmt::format("[gc.delslice] get data accesser fail, fs_id({}).", fs_id);
+    auto block_deleter = GetOrCreateBlockDeleter(fs_info);
+    if (block_deleter == nullptr) {
+      LOG(ERROR) << fmt::format("[gc.delslice] get block deleter fail, fs_id({}).", fs_id);
       return true;
     }
 
     task_memo_->Remember(key);
-    if (!Execute(ino, CleanDelSliceTask::New(operation_processor_, block_accessor, task_memo_, ino, key, value))) {
+    if (!Execute(ino, CleanDelSliceTask::New(operation_processor_, block_deleter, task_memo_, ino, key, value))) {
       task_memo_->Forget(key);
       return false;
     }
@@ -563,6 +645,107 @@ void GcProcessor::ScanDelSlice(const FsInfoEntry& fs_info) {
                            status.error_str());
 }
 
+void GcProcessor::ScanDelPack(const FsInfoEntry& fs_info) {
+  const uint32_t fs_id = fs_info.fs_id();
+
+  const uint64_t now_s = utils::Timestamp();
+
+  struct PackRef {
+    uint64_t pack_id{0};
+    uint64_t pack_refs{0};
+    // record of committed slice
+    uint32_t slice_num{0};
+    uint32_t live_num{0};
+    uint64_t latest_time_ns{0};
+    std::vector<std::string> keys;
+  };
+
+  uint32_t count = 0, pack_count = 0, exec_count = 0;
+  // return false when stop scan
+  auto clean_pack_fn = [&](PackRef& pack_ref) -> bool {
+    ++pack_count;
+
+    // some files still reference the pack
+    if (pack_ref.live_num > 0) return true;
+
+    // all slices are dead wait reserve time, otherwise some or all slices never committed,
+    // e.g. write fail or client crash, wait them longer
+    uint64_t reserve_time_s = (pack_ref.pack_refs > 0 && pack_ref.slice_num >= pack_ref.pack_refs)
+                                  ? FLAGS_mds_gc_delslice_reserve_time_s
+                                  : FLAGS_mds_gc_delpack_uncommit_time_s;
+    if ((pack_ref.latest_time_ns / 1000000000ULL + reserve_time_s) > now_s) return true;
+
+    // check already exist task
+    std::string memo_key = MetaCodec::EncodeDelPackKey(fs_id, pack_ref.pack_id, 0);
+    if (task_memo_->Exist(memo_key)) return true;
+
+    auto block_deleter = GetOrCreateBlockDeleter(fs_info);
+    if (block_deleter == nullptr) {
+      LOG(ERROR) << fmt::format("[gc.delpack] get block deleter fail, fs_id({}).", fs_id);
+      return false;
+    }
+
+    task_memo_->Remember(memo_key);
+    if (!Execute(pack_ref.pack_id, CleanDelPackTask::New(operation_processor_, block_deleter, task_memo_, fs_id,
+                                                         pack_ref.pack_id, pack_ref.keys))) {
+      task_memo_->Forget(memo_key);
+      return false;
+    }
+
+    ++exec_count;
+
+    return true;
+  };
+
+  // keys are ordered by pack id, so clean a pack once its keys are all scanned
+  PackRef pack_ref;
+  bool is_stop = false;
+  Trace trace;
+  ScanDelPackOperation operation(trace, fs_id, [&](const std::string& key, const std::string& value) -> bool {
+    ++count;
+
+    uint32_t fs_id = 0;
+    uint64_t pack_id = 0, refs = 0, time_ns = 0;
+    Ino ino = 0;
+    bool is_live = false;
+    MetaCodec::DecodeDelPackKey(key, fs_id, pack_id, ino);
+    MetaCodec::DecodeDelPackValue(value, refs, time_ns, is_live);
+
+    if (pack_id != pack_ref.pack_id && !pack_ref.keys.empty()) {
+      if (!clean_pack_fn(pack_ref)) {
+        is_stop = true;
+        return false;
+      }
+      pack_ref = PackRef{};
+    }
+
+    pack_ref.pack_id = pack_id;
+    pack_ref.latest_time_ns = std::max(pack_ref.latest_time_ns, time_ns);
+    pack_ref.keys.push_back(key);
+    // pending record has no slice
+    if (ino != MetaCodec::kPendingPackIno) {
+      pack_ref.pack_refs = refs;
+      ++pack_ref.slice_num;
+      if (is_live) ++pack_ref.live_num;
+    }
+
+    return true;
+  });
+  operation.SetIsolationLevel(Txn::kReadCommitted);
+
+  auto status = operation_processor_->RunAlone(&operation);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[gc.delpack.{}] scan delpack fail, status({}).", fs_id, status.error_str());
+    return;
+  }
+
+  // last pack
+  if (!is_stop && !pack_ref.keys.empty()) clean_pack_fn(pack_ref);
+
+  LOG(INFO) << fmt::format("[gc.delpack.{}] scan delpack count({}/{}/{}), status({}).", fs_id, exec_count, pack_count,
+                           count, status.error_str());
+}
+
 void GcProcessor::ScanDelFile(const FsInfoEntry& fs_info) {
   const uint32_t fs_id = fs_info.fs_id();
 
@@ -588,16 +771,16 @@ void GcProcessor::ScanDelFile(const FsInfoEntry& fs_info) {
       return true;
     }
 
-    auto block_accessor = GetOrCreateDataAccesser(fs_info);
-    if (block_accessor == nullptr) {
-      LOG(ERROR) << fmt::format("[gc.delfile] get data accesser fail, fs_id({}).", fs_id);
+    auto block_deleter = GetOrCreateBlockDeleter(fs_info);
+    if (block_deleter == nullptr) {
+      LOG(ERROR) << fmt::format("[gc.delfile] get block deleter fail, fs_id({}).", fs_id);
       return true;
     }
 
     auto attr = MetaCodec::DecodeDelFileValue(value);
     if (ShouldDeleteFile(attr)) {
       task_memo_->Remember(key);
-      if (!Execute(CleanDelFileTask::New(operation_processor_, block_accessor, task_memo_, attr))) {
+      if (!Execute(CleanDelFileTask::New(operation_processor_, block_deleter, task_memo_, attr))) {
         task_memo_->Forget(key);
         return false;
       }
@@ -635,6 +818,48 @@ void GcProcessor::ForgotFileSessionTask(const std::vector<FileSessionEntry>& fil
 
 void GcProcessor::ScanExpiredFileSession(const FsInfoEntry& fs_info) {
   const uint32_t fs_id = fs_info.fs_id();
+  const uint64_t now_s = utils::Timestamp();
+
+  Status status;
+  std::string start_key;
+  uint32_t count = 0, stale_count = 0, exec_count = 0;
+  while (true) {
+    Trace trace;
+    ScanExpiredFileSessionOperation operation(trace, fs_id, now_s, start_key, FLAGS_mds_scan_batch_size);
+    status = operation_processor_->RunAlone(&operation);
+    if (!status.ok()) break;
+
+    auto& result = operation.GetResult();
+    count += result.file_sessions.size();
+    stale_count += result.stale_count;
+    start_key = result.last_key;
+
+    // check already exist task
+    std::vector<FileSessionEntry> file_sessions;
+    for (auto& file_session : result.file_sessions) {
+      std::string key =
+          MetaCodec::EncodeFileSessionKey(file_session.fs_id(), file_session.ino(), file_session.session_id());
+      if (!task_memo_->Exist(key)) file_sessions.push_back(std::move(file_session));
+    }
+
+    if (!file_sessions.empty()) {
+      RememberFileSessionTask(file_sessions);
+      if (!Execute(CleanExpiredFileSessionTask::New(operation_processor_, task_memo_, file_sessions))) {
+        ForgotFileSessionTask(file_sessions);
+        break;
+      }
+      exec_count += file_sessions.size();
+    }
+
+    if (result.is_end) break;
+  }
+
+  LOG(INFO) << fmt::format("[gc.filesession.{}] scan expired file session count({}/{}) stale({}), status({}).", fs_id,
+                           exec_count, count, stale_count, status.error_str());
+}
+
+void GcProcessor::ScanFileSession(const FsInfoEntry& fs_info) {
+  const uint32_t fs_id = fs_info.fs_id();
 
   // get alive clients
   // to dead clients, we will clean their file sessions
@@ -721,13 +946,13 @@ void GcProcessor::ScanDelFs(const FsInfoEntry& fs_info) {
 
         ++file_count;
 
-        auto block_accessor = GetOrCreateDataAccesser(fs_info);
-        if (block_accessor == nullptr) {
-          LOG(ERROR) << fmt::format("[gc.delfs] get data accesser fail, fs_id({}).", fs_id);
+        auto block_deleter = GetOrCreateBlockDeleter(fs_info);
+        if (block_deleter == nullptr) {
+          LOG(ERROR) << fmt::format("[gc.delfs] get block deleter fail, fs_id({}).", fs_id);
           return true;
         }
 
-        if (!Execute(CleanFileTask::New(operation_processor_, block_accessor, task_memo_, fs_info.fs_name(), attr))) {
+        if (!Execute(CleanFileTask::New(operation_processor_, block_deleter, task_memo_, fs_info.fs_name(), attr))) {
           return false;
         }
         task_memo_->Remember(memo_key);
@@ -751,6 +976,10 @@ void GcProcessor::ScanDelFs(const FsInfoEntry& fs_info) {
     status = CleanFsInfo(fs_info);
     LOG(INFO) << fmt::format("[gc.delfs.{}] clean fs info, status({}).", fs_id, status.error_str());
     if (status.ok() && task_memo_ != nullptr) task_memo_->Clear(prefix);
+
+    // deleter stop when last task release it
+    utils::WriteLockGuard lk(block_deleter_lock_);
+    block_deleters_.erase(fs_id);
   }
 }
 
@@ -822,6 +1051,16 @@ blockaccess::BlockAccesserSPtr GcProcessor::GetOrCreateDataAccesser(const FsInfo
     options.s3_options.s3_info = blockaccess::S3Info{
         .ak = s3_info.ak(), .sk = s3_info.sk(), .endpoint = s3_info.endpoint(), .bucket_name = s3_info.bucketname()};
 
+  } else if (fs_info.fs_type() == pb::mds::FsType::LOCALFILE) {
+    const auto& file_info = fs_info.extra().file_info();
+    if (file_info.path().empty()) {
+      LOG(ERROR) << fmt::format("[gc] get local file info fail, fs_id({}).", fs_id);
+      return nullptr;
+    }
+
+    options.type = blockaccess::AccesserType::kLocalFile;
+    options.file_options = blockaccess::LocalFileOptions{.path = file_info.path()};
+
   } else {
     const auto& rados_info = fs_info.extra().rados_info();
     if (rados_info.mon_host().empty() || rados_info.user_name().empty() || rados_info.key().empty() ||
@@ -851,5 +1090,45 @@ blockaccess::BlockAccesserSPtr GcProcessor::GetOrCreateDataAccesser(const FsInfo
   return block_accessor;
 }
 
+BlockDeleterSPtr GcProcessor::GetOrCreateBlockDeleter(uint32_t fs_id) {
+  auto fs = file_system_set_->GetFileSystem(fs_id);
+  if (fs == nullptr) {
+    LOG(ERROR) << fmt::format("[gc] get filesystem({}) fail.", fs_id);
+    return nullptr;
+  }
+
+  return GetOrCreateBlockDeleter(fs->GetFsInfo());
+}
+
+BlockDeleterSPtr GcProcessor::GetOrCreateBlockDeleter(const FsInfoEntry& fs_info) {
+  const uint32_t fs_id = fs_info.fs_id();
+
+  {
+    utils::ReadLockGuard lk(block_deleter_lock_);
+
+    auto it = block_deleters_.find(fs_id);
+    if (it != block_deleters_.end()) return it->second;
+  }
+
+  utils::WriteLockGuard lk(block_deleter_lock_);
+
+  auto it = block_deleters_.find(fs_id);
+  if (it != block_deleters_.end()) return it->second;
+
+  auto block_accessor = GetOrCreateDataAccesser(fs_info);
+  if (block_accessor == nullptr) return nullptr;
+
+  auto block_deleter = BlockDeleter::New(fs_id, block_accessor);
+  if (!block_deleter->Init()) {
+    LOG(ERROR) << fmt::format("[gc] init block deleter fail, fs_id({}).", fs_id);
+    block_deleter->Destroy();
+    return nullptr;
+  }
+
+  block_deleters_[fs_id] = block_deleter;
+
+  return block_deleter;
+}
+
 }  // namespace mds
 }  // namespace dingofs
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "common/blockaccess/block_accesser.h"
+#include "mds/background/block_deleter.h"
 #include "mds/common/distribution_lock.h"
 #include "mds/common/runnable.h"
 #include "mds/common/status.h"
@@ -38,6 +39,9 @@ using TaskMemoSPtr = std::shared_ptr<TaskMemo>;
 class CleanDelSliceTask;
 using CleanDelSliceTaskSPtr = std::shared_ptr<CleanDelSliceTask>;
 
+class CleanDelPackTask;
+using CleanDelPackTaskSPtr = std::shared_ptr<CleanDelPackTask>;
+
 class CleanDelFileTask;
 using CleanDelFileTaskSPtr = std::shared_ptr<CleanDelFileTask>;
 
@@ -96,20 +100,19 @@ class TaskMemo {
 // clean trash slice corresponding to s3 object
 class CleanDelSliceTask : public TaskRunnable {
  public:
-  CleanDelSliceTask(OperationProcessorSPtr operation_processor, blockaccess::BlockAccesserSPtr block_accessor,
-                    TaskMemoSPtr task_memo, Ino ino, const std::string& key, const std::string& value)
+  CleanDelSliceTask(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter, TaskMemoSPtr task_memo,
+                    Ino ino, const std::string& key, const std::string& value)
       : operation_processor_(operation_processor),
-        data_accessor_(block_accessor),
+        block_deleter_(block_deleter),
         ino_(ino),
         key_(key),
         value_(value),
         task_memo_(task_memo) {}
   ~CleanDelSliceTask() override = default;
 
-  static CleanDelSliceTaskSPtr New(OperationProcessorSPtr operation_processor,
-                                   blockaccess::BlockAccesserSPtr block_accessor, TaskMemoSPtr task_memo, Ino ino,
-                                   const std::string& key, const std::string& value) {
-    return std::make_shared<CleanDelSliceTask>(operation_processor, block_accessor, task_memo, ino, key, value);
+  static CleanDelSliceTaskSPtr New(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter,
+                                   TaskMemoSPtr task_memo, Ino ino, const std::string& key, const std::string& value) {
+    return std::make_shared<CleanDelSliceTask>(operation_processor, block_deleter, task_memo, ino, key, value);
   }
   std::string Type() override { return "CLEAN_DELETED_SLICE"; }
 
@@ -127,8 +130,47 @@ class CleanDelSliceTask : public TaskRunnable {
 
   OperationProcessorSPtr operation_processor_;
 
-  // data accessor for s3
-  blockaccess::BlockAccesserSPtr data_accessor_;
+  // delete s3 object in batch
+  BlockDeleterSPtr block_deleter_;
+
+  TaskMemoSPtr task_memo_;
+};
+
+// clean pack object which has no live slice
+class CleanDelPackTask : public TaskRunnable {
+ public:
+  CleanDelPackTask(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter, TaskMemoSPtr task_memo,
+                   uint32_t fs_id, uint64_t pack_id, const std::vector<std::string>& keys)
+      : operation_processor_(operation_processor),
+        block_deleter_(block_deleter),
+        task_memo_(task_memo),
+        fs_id_(fs_id),
+        pack_id_(pack_id),
+        keys_(keys) {}
+  ~CleanDelPackTask() override = default;
+
+  static CleanDelPackTaskSPtr New(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter,
+                                  TaskMemoSPtr task_memo, uint32_t fs_id, uint64_t pack_id,
+                                  const std::vector<std::string>& keys) {
+    return std::make_shared<CleanDelPackTask>(operation_processor, block_deleter, task_memo, fs_id, pack_id, keys);
+  }
+
+  std::string Type() override { return "CLEAN_DELETED_PACK"; }
+
+  void Run() override;
+
+ private:
+  Status CleanDelPack();
+
+  const uint32_t fs_id_;
+  const uint64_t pack_id_;
+  // delpack keys of pack
+  const std::vector<std::string> keys_;
+
+  OperationProcessorSPtr operation_processor_;
+
+  // delete s3 object in batch
+  BlockDeleterSPtr block_deleter_;
 
   TaskMemoSPtr task_memo_;
 };
@@ -136,15 +178,14 @@ class CleanDelSliceTask : public TaskRunnable {
 // clean delete file corresponding to s3 object
 class CleanDelFileTask : public TaskRunnable {
  public:
-  CleanDelFileTask(OperationProcessorSPtr operation_processor, blockaccess::BlockAccesserSPtr block_accessor,
-                   TaskMemoSPtr task_memo, const AttrEntry& attr)
-      : operation_processor_(operation_processor), data_accessor_(block_accessor), task_memo_(task_memo), attr_(attr) {}
+  CleanDelFileTask(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter, TaskMemoSPtr task_memo,
+                   const AttrEntry& attr)
+      : operation_processor_(operation_processor), block_deleter_(block_deleter), task_memo_(task_memo), attr_(attr) {}
   ~CleanDelFileTask() override = default;
 
-  static CleanDelFileTaskSPtr New(OperationProcessorSPtr operation_processor,
-                                  blockaccess::BlockAccesserSPtr block_accessor, TaskMemoSPtr task_memo,
-                                  const AttrEntry& attr) {
-    return std::make_shared<CleanDelFileTask>(operation_processor, block_accessor, task_memo, attr);
+  static CleanDelFileTaskSPtr New(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter,
+                                  TaskMemoSPtr task_memo, const AttrEntry& attr) {
+    return std::make_shared<CleanDelFileTask>(operation_processor, block_deleter, task_memo, attr);
   }
 
   std::string Type() override { return "CLEAN_DELETED_FILE"; }
@@ -160,8 +201,8 @@ class CleanDelFileTask : public TaskRunnable {
 
   OperationProcessorSPtr operation_processor_;
 
-  // data accessor for s3
-  blockaccess::BlockAccesserSPtr data_accessor_;
+  // delete s3 object in batch
+  BlockDeleterSPtr block_deleter_;
 
   TaskMemoSPtr task_memo_;
 };
@@ -169,19 +210,18 @@ class CleanDelFileTask : public TaskRunnable {
 // clean file corresponding to s3 object
 class CleanFileTask : public TaskRunnable {
  public:
-  CleanFileTask(OperationProcessorSPtr operation_processor, blockaccess::BlockAccesserSPtr block_accessor,
-                TaskMemoSPtr task_memo, const std::string& fs_name, const AttrEntry& attr)
+  CleanFileTask(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter, TaskMemoSPtr task_memo,
+                const std::string& fs_name, const AttrEntry& attr)
       : operation_processor_(operation_processor),
-        data_accessor_(block_accessor),
+        block_deleter_(block_deleter),
         task_memo_(task_memo),
         fs_name_(fs_name),
         attr_(attr) {}
   ~CleanFileTask() override = default;
 
-  static CleanFileTaskSPtr New(OperationProcessorSPtr operation_processor,
-                               blockaccess::BlockAccesserSPtr block_accessor, TaskMemoSPtr task_memo,
-                               const std::string& fs_name, const AttrEntry& attr) {
-    return std::make_shared<CleanFileTask>(operation_processor, block_accessor, task_memo, fs_name, attr);
+  static CleanFileTaskSPtr New(OperationProcessorSPtr operation_processor, BlockDeleterSPtr block_deleter,
+                               TaskMemoSPtr task_memo, const std::string& fs_name, const AttrEntry& attr) {
+    return std::make_shared<CleanFileTask>(operation_processor, block_deleter, task_memo, fs_name, attr);
   }
 
   std::string Type() override { return "CLEAN_FILE"; }
@@ -198,8 +238,8 @@ class CleanFileTask : public TaskRunnable {
 
   OperationProcessorSPtr operation_processor_;
 
-  // data accessor for s3
-  blockaccess::BlockAccesserSPtr data_accessor_;
+  // delete s3 object in batch
+  BlockDeleterSPtr block_deleter_;
 
   TaskMemoSPtr task_memo_;
 };
@@ -266,8 +306,12 @@ class GcProcessor {
   void ForgotFileSessionTask(const std::vector<FileSessionEntry>& file_sessions);
 
   void ScanDelSlice(const FsInfoEntry& fs_info);
+  void ScanDelPack(const FsInfoEntry& fs_info);
   void ScanDelFile(const FsInfoEntry& fs_info);
+  // scan expire index, work is proportional to expired file session
   void ScanExpiredFileSession(const FsInfoEntry& fs_info);
+  // scan all file session, clean expired and dead client file session
+  void ScanFileSession(const FsInfoEntry& fs_info);
   void ScanDelFs(const FsInfoEntry& fs_info);
 
   static bool ShouldDeleteFile(const AttrEntry& attr);
@@ -280,8 +324,13 @@ class GcProcessor {
   blockaccess::BlockAccesserSPtr GetOrCreateDataAccesser(uint32_t fs_id);
   blockaccess::BlockAccesserSPtr GetOrCreateDataAccesser(const FsInfoEntry& fs_info);
 
+  BlockDeleterSPtr GetOrCreateBlockDeleter(uint32_t fs_id);
+  BlockDeleterSPtr GetOrCreateBlockDeleter(const FsInfoEntry& fs_info);
+
   std::atomic<bool> is_running_{false};
 
+  uint64_t last_filesession_full_scan_time_s_{0};
+
   DistributionLockSPtr dist_lock_;
 
   OperationProcessorSPtr operation_processor_;
@@ -289,6 +338,10 @@ class GcProcessor {
   // fs_id -> data accessor
   std::map<uint32_t, blockaccess::BlockAccesserSPtr> block_accessers_;
 
+  // fs_id -> block deleter
+  utils::RWLock block_deleter_lock_;
+  std::map<uint32_t, BlockDeleterSPtr> block_deleters_;
+
   FileSystemSetSPtr file_system_set_;
 
   WorkerSetSPtr worker_set_;
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/logging.h"
@@ -67,6 +68,16 @@ void Heartbeat::SendHeartbeat() {
 
   Context ctx;
   auto mds = self_mds_meta.ToProto();
+
+  // report hash bucket load for balancer
+  auto fs_set = Server::GetInstance().GetFileSystemSet();
+  if (fs_set != nullptr) {
+    for (auto& fs : fs_set->GetAllFileSystem()) {
+      BucketLoadEntry load;
+      if (fs->TakeBucketLoad(load)) *mds.add_bucket_loads() = std::move(load);
+    }
+  }
+
   SendHeartbeat(ctx, mds);
 }
 
@@ -409,6 +409,7 @@ Status Backup::BackupFsMetaTable(uint32_t fs_id, OutputUPtr output) {
 
   uint64_t total_count = 0, inode_count = 0, dentry_count = 0, chunk_count = 0;
   uint64_t dir_quota_count = 0, file_session_count = 0, del_slice_count = 0, del_file_count = 0;
+  uint64_t del_pack_count = 0;
 
   Trace trace;
   ScanFsMetaTableOperation operation(trace, fs_id, [&](const std::string& key, const std::string& value) -> bool {
@@ -420,12 +421,14 @@ Status Backup::BackupFsMetaTable(uint32_t fs_id, OutputUPtr output) {
       ++inode_count;
     } else if (MetaCodec::IsDentryKey(key)) {
       ++dentry_count;
-    } else if (MetaCodec::IsChunkKey(key)) {
+    } else if (MetaCodec::IsChunkKey(key) || MetaCodec::IsChunkDeltaKey(key)) {
       ++chunk_count;
     } else if (MetaCodec::IsFileSessionKey(key)) {
       ++file_session_count;
     } else if (MetaCodec::IsDelSliceKey(key)) {
       ++del_slice_count;
+    } else if (MetaCodec::IsDelPackKey(key)) {
+      ++del_pack_count;
     } else if (MetaCodec::IsDelFileKey(key)) {
       ++del_file_count;
     } else {
@@ -445,9 +448,9 @@ Status Backup::BackupFsMetaTable(uint32_t fs_id, OutputUPtr output) {
   std::cout << fmt::format(
       "backup fsmeta table done.\n summary total_count({}) inode_count({}) dentry_count({}) chunk_count({}) "
       "dir_quota_count({}) "
-      "file_session_count({}) del_slice_count({}) del_file_count({}).\n",
+      "file_session_count({}) del_slice_count({}) del_pack_count({}) del_file_count({}).\n",
       total_count, inode_count, dentry_count, chunk_count, dir_quota_count, file_session_count, del_slice_count,
-      del_file_count);
+      del_pack_count, del_file_count);
 
   return status;
 }
@@ -685,6 +688,7 @@ Status Restore::RestoreFsMetaTable(uint32_t fs_id, InputUPtr input, bool is_forc
 
   uint64_t total_count = 0, dir_quota_count = 0, inode_count = 0, dentry_count = 0;
   uint64_t chunk_count = 0, file_session_count = 0, del_slice_count = 0, del_file_count = 0;
+  uint64_t del_pack_count = 0;
 
   std::vector<KeyValue> kvs;
   while (true) {
@@ -700,12 +704,14 @@ Status Restore::RestoreFsMetaTable(uint32_t fs_id, InputUPtr input, bool is_forc
       ++inode_count;
     } else if (MetaCodec::IsDentryKey(kv.key)) {
       ++dentry_count;
-    } else if (MetaCodec::IsChunkKey(kv.key)) {
+    } else if (MetaCodec::IsChunkKey(kv.key) || MetaCodec::IsChunkDeltaKey(kv.key)) {
       ++chunk_count;
     } else if (MetaCodec::IsFileSessionKey(kv.key)) {
       ++file_session_count;
     } else if (MetaCodec::IsDelSliceKey(kv.key)) {
       ++del_slice_count;
+    } else if (MetaCodec::IsDelPackKey(kv.key)) {
+      ++del_pack_count;
     } else if (MetaCodec::IsDelFileKey(kv.key)) {
       ++del_file_count;
     } else {
@@ -731,9 +737,10 @@ Status Restore::RestoreFsMetaTable(uint32_t fs_id, InputUPtr input, bool is_forc
 
   std::cout << fmt::format(
       "restore fsmeta table done.\n summary total_count({}) inode_count({}) dentry_count({}) chunk_count({}) "
-      "dir_quota_count({}) file_session_count({}) del_slice_count({}) del_file_count({}) status({}).\n",
+      "dir_quota_count({}) file_session_count({}) del_slice_count({}) del_pack_count({}) del_file_count({}) "
+      "status({}).\n",
       total_count, inode_count, dentry_count, chunk_count, dir_quota_count, file_session_count, del_slice_count,
-      del_file_count, status.error_str());
+      del_pack_count, del_file_count, status.error_str());
 
   return Status::OK();
 }
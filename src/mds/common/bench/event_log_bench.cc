@@ -0,0 +1,111 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Hot path log benchmark, every thread run ops which log like writeslice,
+// report ops/s and op latency percentile. Run it with --mode=none, glog and
+// event to compare, events dropped by full ring are reported too, enlarge
+// --mds_event_log_ring_size to avoid.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bvar/variable.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "mds/common/event_log.h"
+#include "utils/time.h"
+
+DEFINE_string(mode, "event", "log mode, none|glog|event");
+DEFINE_uint32(thread_num, 16, "thread number");
+DEFINE_uint32(op_num, 100000, "op number per thread");
+DEFINE_uint32(log_per_op, 2, "log line number per op");
+
+namespace dingofs {
+namespace mds {
+
+static void RunOps(uint32_t index, std::vector<uint64_t>& latencies) {
+  latencies.reserve(FLAGS_op_num);
+
+  const bool is_log = FLAGS_mode != "none";
+  for (uint32_t i = 0; i < FLAGS_op_num; ++i) {
+    uint64_t start_ns = utils::TimestampNs();
+
+    if (is_log) {
+      for (uint32_t j = 0; j < FLAGS_log_per_op; ++j) {
+        EVENT_LOG(INFO, "[fs.{}.{}.{}][{}us] writeslice finish, chunk({},{}).", 10000, index, i, 123, j, i + j);
+      }
+    }
+
+    latencies.push_back(utils::TimestampNs() - start_ns);
+  }
+}
+
+static uint64_t Percentile(const std::vector<uint64_t>& sorted, double ratio) {
+  return sorted[std::min(sorted.size() - 1, static_cast<size_t>(sorted.size() * ratio))];
+}
+
+static void RunBench() {
+  // glog mode write through glog directly
+  FLAGS_mds_event_log_enable = (FLAGS_mode == "event");
+  CHECK(EventLog::GetInstance().Init(FLAGS_log_dir)) << "init event log fail.";
+
+  std::vector<std::vector<uint64_t>> latencies(FLAGS_thread_num);
+  std::vector<std::thread> threads;
+
+  utils::Duration duration;
+  for (uint32_t t = 0; t < FLAGS_thread_num; ++t) {
+    threads.emplace_back([t, &latencies]() { RunOps(t, latencies[t]); });
+  }
+  for (auto& thread : threads) thread.join();
+  double elapsed_s = static_cast<double>(duration.ElapsedUs()) / 1000000;
+
+  EventLog::GetInstance().Destroy();
+
+  std::vector<uint64_t> all_latencies;
+  for (auto& thread_latencies : latencies) {
+    all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  std::sort(all_latencies.begin(), all_latencies.end());
+
+  uint64_t total = static_cast<uint64_t>(FLAGS_thread_num) * FLAGS_op_num;
+  std::cout << fmt::format("mode: {} threads: {} ops: {} log_per_op: {}\n", FLAGS_mode, FLAGS_thread_num, total,
+                           FLAGS_log_per_op);
+  std::cout << fmt::format("ops/s: {:.2f}\n", total / elapsed_s);
+  std::cout << fmt::format("latency(ns) p50: {} p99: {} p999: {} max: {}\n", Percentile(all_latencies, 0.5),
+                           Percentile(all_latencies, 0.99), Percentile(all_latencies, 0.999), all_latencies.back());
+  if (FLAGS_mode == "event") {
+    std::cout << fmt::format("dropped: {}\n", bvar::Variable::describe_exposed("mds_event_log_drop_count"));
+  }
+}
+
+}  // namespace mds
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(FLAGS_mode == "none" || FLAGS_mode == "glog" || FLAGS_mode == "event") << "invalid mode.";
+  CHECK(FLAGS_thread_num > 0) << "thread_num must be positive.";
+  CHECK(FLAGS_op_num > 0) << "op_num must be positive.";
+
+  dingofs::mds::RunBench();
+
+  return 0;
+}
@@ -72,6 +72,9 @@ static uint32_t kDentryKeyHeaderSize = 1 + 4 + 1 + 8 + 1;
 // inode chunk format: ${prefix} kTableFsMeta  {fs_id}  kMetaFsInode {ino} kFsInodeChunk {chunk_index}
 static uint32_t kChunkKeySize = 1 + 4 + 1 + 8 + 1 + 8;
 
+// inode chunk delta format: ${prefix} kTableFsMeta  {fs_id}  kMetaFsInode {ino} kFsInodeChunk {chunk_index} {version}
+static uint32_t kChunkDeltaKeySize = 1 + 4 + 1 + 8 + 1 + 8 + 8;
+
 // inode file session format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSession {ino} {session_id}
 static uint32_t kFileSessionKeySize = 1 + 4 + 1 + 8 + 36;
 
@@ -90,6 +93,12 @@ static uint32_t kFsStatsKeySize = 1 + 1 + 4 + 8;
 // fs tiny file data format: ${prefix} kTableFsMeta {fs_id} kMetaFsTinyFileData {ino}
 static uint32_t kTinyFileDataKeySize = 1 + 4 + 1 + 8;
 
+// delpack format: ${prefix} kTableFsMeta {fs_id} kMetaFsDelPack {pack_id} {ino}
+static uint32_t kDelPackKeySize = 1 + 4 + 1 + 8 + 8;
+
+// file session expire format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSessionExpire {bucket} {ino} {session_id}
+static uint32_t kFileSessionExpireKeySize = 1 + 4 + 1 + 8 + 8 + 36;
+
 // table:
 //      kTableMeta: all filesystem shared
 //      kTableFsStats: store fs stats for client upload, all filesystem shared
@@ -112,6 +121,8 @@ enum TableID : unsigned char {
 //      kMetaFsStats: fs stats, used for filesystem stats
 //      kMetaFsDelSlice: fs deleted slice, used for deleted file data slice
 //      kMetaFsDelFile: fs deleted file, used for deleted file
+//      kMetaFsDelPack: fs live or dead slice of pack, used for deleted pack object
+//      kMetaFsFileSessionExpire: fs file session expire index, used for gc expired file session
 enum MetaType : unsigned char {
   kMetaLock = 1,
   kMetaAutoIncrementID = 3,
@@ -127,6 +138,8 @@ enum MetaType : unsigned char {
   kMetaFsOpLog = 23,
   kMetaCacheMember = 25,
   kMetaFsTinyFileData = 27,
+  kMetaFsDelPack = 29,
+  kMetaFsFileSessionExpire = 31,
 };
 
 // inode meta type:
@@ -165,11 +178,15 @@ void MetaCodec::SetClusterID(uint32_t cluster_id) {
   kInodeKeySize += kPrefixSize;
   kDentryKeyHeaderSize += kPrefixSize;
   kChunkKeySize += kPrefixSize;
+  kChunkDeltaKeySize += kPrefixSize;
   kFileSessionKeySize += kPrefixSize;
   kDirQuotaKeySize += kPrefixSize;
   kDelSliceKeySize += kPrefixSize;
   kDelFileKeySize += kPrefixSize;
   kFsStatsKeySize += kPrefixSize;
+  kTinyFileDataKeySize += kPrefixSize;
+  kDelPackKeySize += kPrefixSize;
+  kFileSessionExpireKeySize += kPrefixSize;
 }
 
 uint32_t MetaCodec::GetClusterID() { return kClusterID; }
@@ -402,6 +419,14 @@ Range MetaCodec::GetChunkRange(uint32_t fs_id, Ino ino) {
   return range;
 }
 
+Range MetaCodec::GetChunkIndexRange(uint32_t fs_id, Ino ino, uint64_t chunk_index) {
+  Range range;
+  range.start = EncodeChunkKey(fs_id, ino, chunk_index);
+  range.end = EncodeChunkKey(fs_id, ino, chunk_index + 1);
+
+  return range;
+}
+
 Range MetaCodec::GetFileSessionRange(uint32_t fs_id) {
   Range range;
 
@@ -440,6 +465,25 @@ Range MetaCodec::GetFileSessionRange(uint32_t fs_id, Ino ino) {
   return range;
 }
 
+Range MetaCodec::GetFileSessionExpireRange(uint32_t fs_id, uint64_t end_bucket) {
+  Range range;
+
+  auto& start = range.start;
+  start = kPrefix;
+  start.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, start);
+  start.push_back(kMetaFsFileSessionExpire);
+
+  auto& end = range.end;
+  end = kPrefix;
+  end.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, end);
+  end.push_back(kMetaFsFileSessionExpire);
+  SerialHelper::WriteULong(end_bucket, end);
+
+  return range;
+}
+
 Range MetaCodec::GetDirQuotaRange(uint32_t fs_id) {
   Range range;
 
@@ -588,6 +632,24 @@ Range MetaCodec::GetTinyFileDataRange(uint32_t fs_id) {
   return range;
 }
 
+Range MetaCodec::GetDelPackRange(uint32_t fs_id) {
+  Range range;
+
+  auto& start = range.start;
+  start = kPrefix;
+  start.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, start);
+  start.push_back(kMetaFsDelPack);
+
+  auto& end = range.end;
+  end = kPrefix;
+  end.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, end);
+  end.push_back(kMetaFsDelPack + 1);
+
+  return range;
+}
+
 // lock format: ${prefix} kTableMeta kMetaLock {name}
 
 bool MetaCodec::IsLockKey(const std::string& key) {
@@ -1110,6 +1172,51 @@ ChunkEntry MetaCodec::DecodeChunkValue(const std::string& value) {
   return chunk;
 }
 
+// inode chunk delta format: ${prefix} kTableFsMeta {fs_id} kMetaFsInode {ino} kFsInodeChunk {chunk_index} {version}
+bool MetaCodec::IsChunkDeltaKey(const std::string& key) {
+  if (key.size() != kChunkDeltaKeySize) {
+    return false;
+  }
+
+  // Check the prefix, table id, and meta type
+  if (key.at(kPrefixSize) != kTableFsMeta || key.at(kPrefixSize + 1 + 4) != kMetaFsInode) {
+    return false;
+  }
+
+  // Check the inode type
+  if (key.at(kChunkDeltaKeySize - 8 - 8 - 1) != kFsInodeChunk) {
+    return false;
+  }
+
+  return true;
+}
+
+std::string MetaCodec::EncodeChunkDeltaKey(uint32_t fs_id, Ino ino, uint64_t chunk_index, uint64_t version) {
+  std::string key;
+  key.reserve(kChunkDeltaKeySize);
+
+  key.append(kPrefix);
+  key.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, key);
+  key.push_back(kMetaFsInode);
+  SerialHelper::WriteULong(ino, key);
+  key.push_back(kFsInodeChunk);
+  SerialHelper::WriteULong(chunk_index, key);
+  SerialHelper::WriteULong(version, key);
+
+  return key;
+}
+
+void MetaCodec::DecodeChunkDeltaKey(const std::string& key, uint32_t& fs_id, uint64_t& ino, uint64_t& chunk_index,
+                                    uint64_t& version) {
+  CHECK(IsChunkDeltaKey(key)) << fmt::format("invalid chunk delta key({}).", Helper::StringToHex(key));
+
+  fs_id = SerialHelper::ReadInt(key.substr(kPrefixSize + 1));
+  ino = SerialHelper::ReadULong(key.substr(kPrefixSize + 1 + 4 + 1));
+  chunk_index = SerialHelper::ReadULong(key.substr(kChunkDeltaKeySize - 8 - 8));
+  version = SerialHelper::ReadULong(key.substr(kChunkDeltaKeySize - 8));
+}
+
 // inode file session format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSession {ino} {session_id}
 bool MetaCodec::IsFileSessionKey(const std::string& key) {
   if (key.size() != kFileSessionKeySize) {
@@ -1159,6 +1266,46 @@ FileSessionEntry MetaCodec::DecodeFileSessionValue(const std::string& value) {
   return file_session;
 }
 
+// file session expire format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSessionExpire {bucket} {ino} {session_id}
+bool MetaCodec::IsFileSessionExpireKey(const std::string& key) {
+  if (key.size() != kFileSessionExpireKeySize) {
+    return false;
+  }
+
+  // Check the prefix, table id, and meta type
+  if (key.at(kPrefixSize) != kTableFsMeta || key.at(kPrefixSize + 1 + 4) != kMetaFsFileSessionExpire) {
+    return false;
+  }
+
+  return true;
+}
+
+std::string MetaCodec::EncodeFileSessionExpireKey(uint32_t fs_id, uint64_t bucket, Ino ino,
+                                                  const std::string& session_id) {
+  std::string key;
+  key.reserve(kFileSessionExpireKeySize);
+
+  key.append(kPrefix);
+  key.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, key);
+  key.push_back(kMetaFsFileSessionExpire);
+  SerialHelper::WriteULong(bucket, key);
+  SerialHelper::WriteULong(ino, key);
+  key.append(session_id);
+
+  return key;
+}
+
+void MetaCodec::DecodeFileSessionExpireKey(const std::string& key, uint32_t& fs_id, uint64_t& bucket, Ino& ino,
+                                           std::string& session_id) {
+  CHECK(IsFileSessionExpireKey(key)) << fmt::format("invalid file session expire key({}).", Helper::StringToHex(key));
+
+  fs_id = SerialHelper::ReadInt(key.substr(kPrefixSize + 1));
+  bucket = SerialHelper::ReadULong(key.substr(kPrefixSize + 1 + 4 + 1));
+  ino = SerialHelper::ReadULong(key.substr(kPrefixSize + 1 + 4 + 1 + 8));
+  session_id = key.substr(kFileSessionExpireKeySize - 36);
+}
+
 // dir quota format: ${prefix} kTableFsMeta {fs_id} kMetaFsDirQuota {ino}
 bool MetaCodec::IsDirQuotaKey(const std::string& key) {
   if (key.size() != kDirQuotaKeySize) {
@@ -1299,6 +1446,62 @@ AttrEntry MetaCodec::DecodeDelFileValue(const std::string& value) {
   return attr;
 }
 
+// delpack format: ${prefix} kTableFsMeta {fs_id} kMetaFsDelPack {pack_id} {ino}
+
+bool MetaCodec::IsDelPackKey(const std::string& key) {
+  if (key.size() != kDelPackKeySize) {
+    return false;
+  }
+
+  // Check the prefix, table id, and meta type
+  if (key.at(kPrefixSize) != kTableFsMeta || key.at(kPrefixSize + 1 + 4) != kMetaFsDelPack) {
+    return false;
+  }
+
+  return true;
+}
+
+std::string MetaCodec::EncodeDelPackKey(uint32_t fs_id, uint64_t pack_id, Ino ino) {
+  std::string key;
+  key.reserve(kDelPackKeySize);
+
+  key.append(kPrefix);
+  key.push_back(kTableFsMeta);
+  SerialHelper::WriteInt(fs_id, key);
+  key.push_back(kMetaFsDelPack);
+  SerialHelper::WriteULong(pack_id, key);
+  SerialHelper::WriteULong(ino, key);
+
+  return key;
+}
+
+void MetaCodec::DecodeDelPackKey(const std::string& key, uint32_t& fs_id, uint64_t& pack_id, Ino& ino) {
+  CHECK(IsDelPackKey(key)) << fmt::format("invalid del pack key({}).", Helper::StringToHex(key));
+
+  fs_id = SerialHelper::ReadInt(key.substr(kPrefixSize + 1));
+  pack_id = SerialHelper::ReadULong(key.substr(kPrefixSize + 1 + 4 + 1));
+  ino = SerialHelper::ReadULong(key.substr(kPrefixSize + 1 + 4 + 1 + 8));
+}
+
+std::string MetaCodec::EncodeDelPackValue(uint64_t pack_refs, uint64_t time_ns, bool is_live) {
+  std::string value;
+  value.reserve(17);
+
+  SerialHelper::WriteULong(pack_refs, value);
+  SerialHelper::WriteULong(time_ns, value);
+  value.push_back(is_live ? 1 : 0);
+
+  return value;
+}
+
+void MetaCodec::DecodeDelPackValue(const std::string& value, uint64_t& pack_refs, uint64_t& time_ns, bool& is_live) {
+  CHECK(value.size() == 17) << fmt::format("del pack value({}) size is invalid.", Helper::StringToHex(value));
+
+  pack_refs = SerialHelper::ReadULong(value.substr(0, 8));
+  time_ns = SerialHelper::ReadULong(value.substr(8, 8));
+  is_live = value.at(16) != 0;
+}
+
 // fs stats format: ${prefix} kTableFsStats kMetaFsStats {fs_id} {time_ns}
 bool MetaCodec::IsFsStatsKey(const std::string& key) {
   if (key.size() != kFsStatsKeySize) {
@@ -1581,6 +1784,18 @@ std::pair<std::string, std::string> MetaCodec::ParseFsMetaTableKey(const std::st
           uint32_t fs_id;
           Ino ino;
           uint64_t chunk_index;
+          if (IsChunkDeltaKey(key)) {
+            uint64_t version;
+            DecodeChunkDeltaKey(key, fs_id, ino, chunk_index, version);
+
+            key_desc = fmt::format("{} kTableFsMeta {} kMetaFsInode {} kFsInodeChunk {} {}", kPrefix, fs_id, ino,
+                                   chunk_index, version);
+
+            auto delta = DecodeChunkValue(value);
+            value_desc = delta.ShortDebugString();
+            break;
+          }
+
           DecodeChunkKey(key, fs_id, ino, chunk_index);
 
           key_desc =
@@ -1643,6 +1858,18 @@ std::pair<std::string, std::string> MetaCodec::ParseFsMetaTableKey(const std::st
       value_desc = del_file.ShortDebugString();
     } break;
 
+    case kMetaFsFileSessionExpire: {
+      uint32_t fs_id;
+      uint64_t bucket;
+      Ino ino;
+      std::string session_id;
+      DecodeFileSessionExpireKey(key, fs_id, bucket, ino, session_id);
+
+      key_desc = fmt::format("{} kTableFsMeta {} kMetaFsFileSessionExpire {} {} {}", kPrefix, fs_id, bucket, ino,
+                             session_id);
+      value_desc = value;
+    } break;
+
     default:
       CHECK(false) << fmt::format("invalid meta type({}) key({}).", static_cast<int>(meta_type),
                                   Helper::StringToHex(key));
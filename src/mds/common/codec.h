@@ -61,9 +61,14 @@ class MetaCodec {
   static Range GetDentryRange(uint32_t fs_id, Ino ino, bool include_parent);
   // format: ${prefix} kTableFsMeta {fs_id} kMetaFsInode {ino} kFsInodeChunk
   static Range GetChunkRange(uint32_t fs_id, Ino ino);
+  // format: ${prefix} kTableFsMeta {fs_id} kMetaFsInode {ino} kFsInodeChunk {chunk_index}
+  // include the chunk base record and all its delta records
+  static Range GetChunkIndexRange(uint32_t fs_id, Ino ino, uint64_t chunk_index);
   // format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSession {ino}
   static Range GetFileSessionRange(uint32_t fs_id);
   static Range GetFileSessionRange(uint32_t fs_id, Ino ino);
+  // format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSessionExpire [0, {end_bucket})
+  static Range GetFileSessionExpireRange(uint32_t fs_id, uint64_t end_bucket);
 
   // format: ${prefix} kTableFsMeta {fs_id} kMetaDirQuota
   static Range GetDirQuotaRange(uint32_t fs_id);
@@ -86,6 +91,9 @@ class MetaCodec {
   // format: ${prefix} kTableFsMeta {fs_id} kMetaFsTinyFileData
   static Range GetTinyFileDataRange(uint32_t fs_id);
 
+  // format: ${prefix} kTableFsMeta {fs_id} kMetaFsDelPack
+  static Range GetDelPackRange(uint32_t fs_id);
+
   // lock format: ${prefix} kTableMeta kMetaLock {name}
   static bool IsLockKey(const std::string& key);
   static std::string EncodeLockKey(const std::string& name);
@@ -161,6 +169,13 @@ class MetaCodec {
   static std::string EncodeChunkValue(const ChunkEntry& chunk);
   static ChunkEntry DecodeChunkValue(const std::string& value);
 
+  // inode chunk delta format: ${prefix} kTableFsMeta {fs_id} kMetaFsInode {ino} kFsInodeChunk {chunk_index} {version}
+  // value is ChunkEntry which only carry the new slices of the write
+  static bool IsChunkDeltaKey(const std::string& key);
+  static std::string EncodeChunkDeltaKey(uint32_t fs_id, Ino ino, uint64_t chunk_index, uint64_t version);
+  static void DecodeChunkDeltaKey(const std::string& key, uint32_t& fs_id, uint64_t& ino, uint64_t& chunk_index,
+                                  uint64_t& version);
+
   // inode file session format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSession {ino} {session_id}
   static bool IsFileSessionKey(const std::string& key);
   static std::string EncodeFileSessionKey(uint32_t fs_id, Ino ino, const std::string& session_id);
@@ -168,6 +183,14 @@ class MetaCodec {
   static std::string EncodeFileSessionValue(const FileSessionEntry& file_session);
   static FileSessionEntry DecodeFileSessionValue(const std::string& value);
 
+  // file session expire format: ${prefix} kTableFsMeta {fs_id} kMetaFsFileSessionExpire {bucket} {ino} {session_id}
+  // index file session by expire time bucket, value is client id
+  static bool IsFileSessionExpireKey(const std::string& key);
+  static std::string EncodeFileSessionExpireKey(uint32_t fs_id, uint64_t bucket, Ino ino,
+                                                const std::string& session_id);
+  static void DecodeFileSessionExpireKey(const std::string& key, uint32_t& fs_id, uint64_t& bucket, Ino& ino,
+                                         std::string& session_id);
+
   // dir quota format: ${prefix} kTableFsMeta {fs_id} kMetaFsDirQuota {ino}
   static bool IsDirQuotaKey(const std::string& key);
   static std::string EncodeDirQuotaKey(uint32_t fs_id, Ino ino);
@@ -190,6 +213,17 @@ class MetaCodec {
   static std::string EncodeDelFileValue(const AttrEntry& attr);
   static AttrEntry DecodeDelFileValue(const std::string& value);
 
+  // delpack format: ${prefix} kTableFsMeta {fs_id} kMetaFsDelPack {pack_id} {ino}
+  // one key for each slice of the pack, live when the slice is committed and dead when it is dropped,
+  // pack is deleted when it has no live slice. key of kPendingPackIno is written when pack id is allocated,
+  // so pack none of whose slices is committed is also deleted
+  static constexpr Ino kPendingPackIno = 0;
+  static bool IsDelPackKey(const std::string& key);
+  static std::string EncodeDelPackKey(uint32_t fs_id, uint64_t pack_id, Ino ino);
+  static void DecodeDelPackKey(const std::string& key, uint32_t& fs_id, uint64_t& pack_id, Ino& ino);
+  static std::string EncodeDelPackValue(uint64_t pack_refs, uint64_t time_ns, bool is_live);
+  static void DecodeDelPackValue(const std::string& value, uint64_t& pack_refs, uint64_t& time_ns, bool& is_live);
+
   // fs stats format: ${prefix} kTableFsStats kMetaFsStats {fs_id} {time_ns}
   static bool IsFsStatsKey(const std::string& key);
   static std::string EncodeFsStatsKey(uint32_t fs_id, uint64_t time_ns);
@@ -34,6 +34,8 @@ class Context {
         use_base_version_(ctx.use_base_version()),
         inode_version_(ctx.inode_version()),
         client_id_(ctx.client_id()),
+        is_follower_read_(ctx.is_follower_read()),
+        max_staleness_ms_(ctx.max_staleness_ms()),
         request_id_(request_id),
         method_name_(method_name) {
     ancestors_ = {ctx.ancestors().begin(), ctx.ancestors().end()};
@@ -43,6 +45,8 @@ class Context {
   bool UseBaseVersion() const { return use_base_version_; }
   uint64_t GetInodeVersion() const { return inode_version_; }
   const std::string& ClientId() const { return client_id_; }
+  bool IsFollowerRead() const { return is_follower_read_; }
+  uint64_t MaxStalenessMs() const { return max_staleness_ms_; }
   const std::string& RequestId() const { return request_id_; }
   const std::string& MethodName() const { return method_name_; }
   Trace& GetTrace() { return trace_; }
@@ -57,6 +61,11 @@ class Context {
   const uint64_t inode_version_{0};
 
   const std::string client_id_;
+
+  // read allowed to be served by non-owner mds, data may be stale at most max_staleness_ms_
+  const bool is_follower_read_{false};
+  const uint64_t max_staleness_ms_{0};
+
   const std::string request_id_;
   const std::string method_name_;
 
@@ -0,0 +1,342 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/common/event_log.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "brpc/reloadable_flags.h"
+#include "bvar/reducer.h"
+#include "fmt/args.h"
+#include "glog/logging.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_bool(mds_event_log_enable, true, "write hot path log by async event log, otherwise by glog.");
+DEFINE_validator(mds_event_log_enable, brpc::PassValidate);
+
+DEFINE_uint32(mds_event_log_ring_size, 1024, "event ring size of every thread, round up to power of 2.");
+
+DEFINE_uint32(mds_event_log_flush_interval_ms, 50, "event log writer flush interval ms.");
+DEFINE_validator(mds_event_log_flush_interval_ms, brpc::PassValidate);
+
+DEFINE_uint32(mds_event_log_info_sample, 1, "record one of every n info events, 0 means drop all.");
+DEFINE_validator(mds_event_log_info_sample, brpc::PassValidate);
+
+DEFINE_uint32(mds_event_log_max_file_mb, 1024, "rotate event log file when exceed.");
+DEFINE_validator(mds_event_log_max_file_mb, brpc::PassValidate);
+
+static bvar::Adder<uint64_t> g_event_log_count("mds_event_log_count");
+// ring is full
+static bvar::Adder<uint64_t> g_event_log_drop_count("mds_event_log_drop_count");
+static bvar::Adder<uint64_t> g_event_log_sample_skip_count("mds_event_log_sample_skip_count");
+
+static const char kLevelChars[] = {'I', 'W', 'E'};
+
+static int32_t GetTid() {
+  static thread_local int32_t tid = static_cast<int32_t>(::syscall(SYS_gettid));
+  return tid;
+}
+
+static uint64_t RoundUpPowerOfTwo(uint64_t value) {
+  uint64_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+void EventEncoder::PutValue(char tag, const void* value, size_t size) {
+  if (event_.is_truncated || event_.data_size + 1 + size > Event::kDataSize) {
+    event_.is_truncated = true;
+    return;
+  }
+
+  char* buf = event_.data + event_.data_size;
+  buf[0] = tag;
+  memcpy(buf + 1, value, size);
+  event_.data_size += 1 + size;
+}
+
+void EventEncoder::PutString(std::string_view value) {
+  const size_t header_size = 1 + sizeof(uint16_t);
+  if (event_.is_truncated || event_.data_size + header_size > Event::kDataSize) {
+    event_.is_truncated = true;
+    return;
+  }
+
+  // long string is cut off
+  uint16_t len = std::min(value.size(), Event::kDataSize - event_.data_size - header_size);
+
+  char* buf = event_.data + event_.data_size;
+  buf[0] = 's';
+  memcpy(buf + 1, &len, sizeof(len));
+  memcpy(buf + header_size, value.data(), len);
+  event_.data_size += header_size + len;
+}
+
+EventRing::EventRing(uint32_t capacity)
+    : mask_(RoundUpPowerOfTwo(std::max(capacity, 2U)) - 1), events_(mask_ + 1) {}
+
+Event* EventRing::Reserve() {
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) > mask_) return nullptr;
+
+  auto& event = events_[tail & mask_];
+  event.is_truncated = false;
+  event.data_size = 0;
+
+  return &event;
+}
+
+void EventRing::Commit() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+size_t EventRing::Drain(std::vector<Event>& out) {
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  uint64_t tail = tail_.load(std::memory_order_acquire);
+  for (uint64_t i = head; i < tail; ++i) {
+    out.push_back(events_[i & mask_]);
+  }
+
+  head_.store(tail, std::memory_order_release);
+
+  return tail - head;
+}
+
+bool EventRing::SampleInfo() {
+  const uint32_t sample = FLAGS_mds_event_log_info_sample;
+  if (sample == 1) return true;
+  if (sample == 0) return false;
+
+  return (sample_count_++ % sample) == 0;
+}
+
+EventLog& EventLog::GetInstance() {
+  static EventLog instance;
+  return instance;
+}
+
+EventLog::~EventLog() { Destroy(); }
+
+bool EventLog::Init(const std::string& log_dir) {
+  if (is_running_.load()) return true;
+
+  path_ = fmt::format("{}/mds_event.log", log_dir.empty() ? "." : log_dir);
+  file_ = fopen(path_.c_str(), "a");
+  if (file_ == nullptr) {
+    LOG(ERROR) << fmt::format("[eventlog] open file({}) fail, {}.", path_, strerror(errno));
+    return false;
+  }
+  file_size_ = ftell(file_);
+
+  is_running_.store(true);
+  writer_ = std::thread([this] { Run(); });
+
+  LOG(INFO) << fmt::format("[eventlog] init finish, path({}).", path_);
+
+  return true;
+}
+
+void EventLog::Destroy() {
+  if (!is_running_.exchange(false)) return;
+
+  if (writer_.joinable()) writer_.join();
+
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+void EventLog::SyncLog(EventLevel level, const char* file, int line, const std::string& message) {
+  static const google::LogSeverity kSeverities[] = {google::GLOG_INFO, google::GLOG_WARNING, google::GLOG_ERROR};
+  google::LogMessage(file, line, kSeverities[static_cast<uint8_t>(level)]).stream() << message;
+}
+
+EventRing* EventLog::GetThreadRing() {
+  // ring live with process, so thread exit never invalidate it
+  static thread_local EventRing* ring = nullptr;
+  if (ring != nullptr) return ring;
+
+  auto new_ring = std::make_unique<EventRing>(FLAGS_mds_event_log_ring_size);
+  ring = new_ring.get();
+
+  std::lock_guard<std::mutex> lock(ring_mutex_);
+  rings_.push_back(std::move(new_ring));
+
+  return ring;
+}
+
+Event* EventLog::Reserve() {
+  auto* ring = GetThreadRing();
+  if (!ring->SampleInfo()) {
+    g_event_log_sample_skip_count << 1;
+    return nullptr;
+  }
+
+  Event* event = ring->Reserve();
+  if (event == nullptr) {
+    g_event_log_drop_count << 1;
+    return nullptr;
+  }
+
+  event->time_us = utils::TimestampUs();
+  event->tid = GetTid();
+  event->level = EventLevel::kINFO;
+
+  return event;
+}
+
+void EventLog::Commit() {
+  GetThreadRing()->Commit();
+  g_event_log_count << 1;
+}
+
+std::string EventLog::FormatMessage(const Event& event) {
+  fmt::dynamic_format_arg_store<fmt::format_context> store;
+
+  uint32_t offset = 0;
+  while (offset < event.data_size) {
+    char tag = event.data[offset++];
+    switch (tag) {
+      case 'b': {
+        uint64_t value;
+        memcpy(&value, event.data + offset, sizeof(value));
+        store.push_back(value != 0);
+        offset += sizeof(value);
+        break;
+      }
+      case 'i': {
+        int64_t value;
+        memcpy(&value, event.data + offset, sizeof(value));
+        store.push_back(value);
+        offset += sizeof(value);
+        break;
+      }
+      case 'u': {
+        uint64_t value;
+        memcpy(&value, event.data + offset, sizeof(value));
+        store.push_back(value);
+        offset += sizeof(value);
+        break;
+      }
+      case 'd': {
+        double value;
+        memcpy(&value, event.data + offset, sizeof(value));
+        store.push_back(value);
+        offset += sizeof(value);
+        break;
+      }
+      case 's': {
+        uint16_t len;
+        memcpy(&len, event.data + offset, sizeof(len));
+        offset += sizeof(len);
+        store.push_back(std::string(event.data + offset, len));
+        offset += len;
+        break;
+      }
+      default:
+        return fmt::format("{} (invalid arg tag {})", event.format, tag);
+    }
+  }
+
+  try {
+    return fmt::vformat(event.format, store);
+  } catch (const fmt::format_error& e) {
+    return fmt::format("{} (format fail, {}{})", event.format, e.what(), event.is_truncated ? ", truncated" : "");
+  }
+}
+
+// same layout as glog, e.g. I20261019 10:00:00.123456 12345 filesystem.cc:100] message
+static void AppendLine(const Event& event, std::string& buf) {
+  time_t seconds = event.time_us / 1000000;
+  struct tm tm;
+  localtime_r(&seconds, &tm);
+
+  const char* file = strrchr(event.file, '/');
+  file = (file != nullptr) ? file + 1 : event.file;
+
+  fmt::format_to(std::back_inserter(buf), "{}{:04}{:02}{:02} {:02}:{:02}:{:02}.{:06} {} {}:{}] {}\n",
+                 kLevelChars[static_cast<uint8_t>(event.level)], tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                 tm.tm_hour, tm.tm_min, tm.tm_sec, event.time_us % 1000000, event.tid, file, event.line,
+                 EventLog::FormatMessage(event));
+}
+
+void EventLog::Run() {
+  while (is_running_.load(std::memory_order_relaxed)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::max(FLAGS_mds_event_log_flush_interval_ms, 1U)));
+
+    DrainAndWrite();
+  }
+
+  // flush remain events
+  DrainAndWrite();
+}
+
+void EventLog::DrainAndWrite() {
+  std::vector<EventRing*> rings;
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    rings.reserve(rings_.size());
+    for (auto& ring : rings_) rings.push_back(ring.get());
+  }
+
+  std::vector<Event> events;
+  for (auto* ring : rings) ring->Drain(events);
+  if (events.empty()) return;
+
+  // merge events of all threads by time
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event& lhs, const Event& rhs) { return lhs.time_us < rhs.time_us; });
+
+  std::string buf;
+  buf.reserve(events.size() * 128);
+  for (const auto& event : events) AppendLine(event, buf);
+
+  if (fwrite(buf.data(), 1, buf.size(), file_) != buf.size()) {
+    LOG(ERROR) << fmt::format("[eventlog] write file({}) fail, {}.", path_, strerror(errno));
+  }
+  fflush(file_);
+  file_size_ += buf.size();
+
+  RotateIfNeed();
+}
+
+void EventLog::RotateIfNeed() {
+  if (file_size_ < static_cast<uint64_t>(FLAGS_mds_event_log_max_file_mb) * 1024 * 1024) return;
+
+  fclose(file_);
+
+  std::string old_path = path_ + ".1";
+  if (rename(path_.c_str(), old_path.c_str()) != 0) {
+    LOG(ERROR) << fmt::format("[eventlog] rename file({}) fail, {}.", path_, strerror(errno));
+  }
+
+  file_ = fopen(path_.c_str(), "a");
+  CHECK(file_ != nullptr) << fmt::format("[eventlog] open file({}) fail, {}.", path_, strerror(errno));
+  file_size_ = 0;
+}
+
+}  // namespace mds
+}  // namespace dingofs
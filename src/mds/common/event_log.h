@@ -0,0 +1,208 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_COMMON_EVENT_LOG_H_
+#define DINGOFS_MDS_COMMON_EVENT_LOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_bool(mds_event_log_enable);
+
+// same name as glog severity, so EVENT_LOG(INFO, ...) read like LOG(INFO)
+enum class EventLevel : uint8_t {
+  kINFO = 0,
+  kWARNING = 1,
+  kERROR = 2,
+};
+
+// one log event, keep the format literal and encoded args,
+// formatting is deferred to the background writer.
+struct Event {
+  static constexpr uint32_t kDataSize = 480;
+
+  uint64_t time_us{0};
+  const char* file{nullptr};
+  const char* format{nullptr};
+  int32_t line{0};
+  int32_t tid{0};
+  EventLevel level{EventLevel::kINFO};
+  // args overflow the data buffer
+  bool is_truncated{false};
+  uint16_t data_size{0};
+  // [tag][value], string value is [u16 len][bytes]
+  char data[kDataSize];
+};
+
+// encode args into event data buffer
+class EventEncoder {
+ public:
+  explicit EventEncoder(Event& event) : event_(event) {}
+
+  template <typename T>
+  void Encode(const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      PutInteger('b', static_cast<uint64_t>(value));
+
+    } else if constexpr (std::is_enum_v<T>) {
+      PutInteger('i', static_cast<int64_t>(value));
+
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      PutInteger('i', static_cast<int64_t>(value));
+
+    } else if constexpr (std::is_integral_v<T>) {
+      PutInteger('u', static_cast<uint64_t>(value));
+
+    } else if constexpr (std::is_floating_point_v<T>) {
+      double d = value;
+      PutValue('d', &d, sizeof(d));
+
+    } else {
+      PutString(std::string_view(value));
+    }
+  }
+
+ private:
+  template <typename V>
+  void PutInteger(char tag, V value) {
+    PutValue(tag, &value, sizeof(value));
+  }
+
+  void PutValue(char tag, const void* value, size_t size);
+  void PutString(std::string_view value);
+
+  Event& event_;
+};
+
+// per thread single producer single consumer ring of events
+class EventRing {
+ public:
+  explicit EventRing(uint32_t capacity);
+
+  // return nullptr when full
+  Event* Reserve();
+  void Commit();
+
+  // pop all events into out, return pop count
+  size_t Drain(std::vector<Event>& out);
+
+  // return true when the info event should be recorded
+  bool SampleInfo();
+
+ private:
+  const uint64_t mask_;
+  std::vector<Event> events_;
+
+  // written by consumer
+  alignas(64) std::atomic<uint64_t> head_{0};
+  // written by producer
+  alignas(64) std::atomic<uint64_t> tail_{0};
+
+  // only accessed by producer
+  uint64_t sample_count_{0};
+};
+
+// low overhead async log for hot path, every thread push event into its own
+// ring without lock, a background thread drain, format and write them to
+// file. Fallback to glog when disabled or not running. Info event may be
+// sampled out or dropped when ring is full, warning and error event always
+// go to glog directly, so they are never lost. Keep hot path lines such as
+// txn retry and conflict at info.
+class EventLog {
+ public:
+  static EventLog& GetInstance();
+
+  bool Init(const std::string& log_dir);
+  void Destroy();
+
+  bool IsRunning() const { return is_running_.load(std::memory_order_relaxed) && FLAGS_mds_event_log_enable; }
+
+  template <typename... Args>
+  static void Emit(EventLevel level, const char* file, int line, const char* format, const Args&... args);
+
+  // format event message, used by writer
+  static std::string FormatMessage(const Event& event);
+
+ private:
+  EventLog() = default;
+  ~EventLog();
+
+  static void SyncLog(EventLevel level, const char* file, int line, const std::string& message);
+
+  // reserve info event slot of current thread, return nullptr when sampled out or full
+  Event* Reserve();
+  void Commit();
+
+  EventRing* GetThreadRing();
+
+  void Run();
+  void DrainAndWrite();
+  void RotateIfNeed();
+
+  std::atomic<bool> is_running_{false};
+
+  std::mutex ring_mutex_;
+  std::vector<std::unique_ptr<EventRing>> rings_;
+
+  std::thread writer_;
+  std::string path_;
+  FILE* file_{nullptr};
+  uint64_t file_size_{0};
+};
+
+template <typename... Args>
+void EventLog::Emit(EventLevel level, const char* file, int line, const char* format, const Args&... args) {
+  auto& event_log = GetInstance();
+  if (level != EventLevel::kINFO || !event_log.IsRunning()) {
+    SyncLog(level, file, line, fmt::vformat(format, fmt::make_format_args(args...)));
+    return;
+  }
+
+  Event* event = event_log.Reserve();
+  if (event == nullptr) return;
+
+  event->file = file;
+  event->line = line;
+  event->format = format;
+
+  EventEncoder encoder(*event);
+  (encoder.Encode(args), ...);
+
+  event_log.Commit();
+}
+
+}  // namespace mds
+}  // namespace dingofs
+
+// format must be string literal, e.g. EVENT_LOG(INFO, "[fs.{}] mkdir finish.", fs_id)
+#define EVENT_LOG(severity, format, ...)                                                              \
+  ::dingofs::mds::EventLog::Emit(::dingofs::mds::EventLevel::k##severity, __FILE__, __LINE__, format, \
+                                 ##__VA_ARGS__)
+
+#endif  // DINGOFS_MDS_COMMON_EVENT_LOG_H_
@@ -38,6 +38,7 @@ using TrashSliceList = pb::mds::TrashSliceList;
 using QuotaEntry = pb::mds::Quota;
 using UsageEntry = pb::mds::Usage;
 using MdsEntry = pb::mds::MDS;
+using BucketLoadEntry = pb::mds::MDS::BucketLoad;
 using ClientEntry = pb::mds::Client;
 using FileSessionEntry = pb::mds::FileSession;
 using FsStatsDataEntry = pb::mds::FsStatsData;
@@ -47,6 +48,7 @@ using FileType = pb::mds::FileType;
 using CacheMemberEntry = pb::mds::CacheGroupMember;
 using HashPartitionEntry = pb::mds::HashPartition;
 using BucketSetEntry = pb::mds::HashPartition::BucketSet;
+using AttrLeaseEntry = pb::mds::AttrLease;
 using DeltaSliceEntry = pb::mds::WriteSliceRequest::DeltaSlice;
 using RecycleProgress = pb::mds::RecycleProgress;
 using ContextEntry = pb::mds::Context;
@@ -0,0 +1,245 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mds/filesystem/attr_lease.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/format.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_bool(mds_attr_lease_enable, false, "enable grant attr lease to client.");
+DEFINE_validator(mds_attr_lease_enable, brpc::PassValidate);
+
+DEFINE_uint32(mds_attr_lease_ms, 5000, "attr lease time ms.");
+DEFINE_validator(mds_attr_lease_ms, brpc::PassValidate);
+
+static const std::string kAttrLeaseGrantReadCountMetricsName = "dingofs_{}_attr_lease_grant_read_count";
+static const std::string kAttrLeaseGrantWriteCountMetricsName = "dingofs_{}_attr_lease_grant_write_count";
+static const std::string kAttrLeaseConflictCountMetricsName = "dingofs_{}_attr_lease_conflict_count";
+static const std::string kAttrLeaseRecallCountMetricsName = "dingofs_{}_attr_lease_recall_count";
+static const std::string kAttrLeaseRecallLatencyMetricsName = "dingofs_{}_attr_lease_recall";
+
+AttrLeaseManager::AttrLeaseManager(uint32_t fs_id, ClientNotifier& client_notifier)
+    : fs_id_(fs_id),
+      client_notifier_(client_notifier),
+      grant_read_count_(fmt::format(kAttrLeaseGrantReadCountMetricsName, fs_id)),
+      grant_write_count_(fmt::format(kAttrLeaseGrantWriteCountMetricsName, fs_id)),
+      conflict_count_(fmt::format(kAttrLeaseConflictCountMetricsName, fs_id)),
+      recall_count_(fmt::format(kAttrLeaseRecallCountMetricsName, fs_id)),
+      recall_latency_(fmt::format(kAttrLeaseRecallLatencyMetricsName, fs_id)) {}
+
+bool AttrLeaseManager::Destroy() {
+  is_stop_.store(true);
+  return true;
+}
+
+AttrLeaseEntry AttrLeaseManager::Grant(Ino ino, const std::string& client_id, pb::mds::AttrLeaseType type) {
+  AttrLeaseEntry lease;
+  lease.set_type(pb::mds::ATTR_LEASE_NONE);
+
+  if (!FLAGS_mds_attr_lease_enable || client_id.empty() || is_stop_.load(std::memory_order_relaxed)) {
+    return lease;
+  }
+
+  const uint64_t lease_ms = FLAGS_mds_attr_lease_ms;
+  if (lease_ms == 0 || type == pb::mds::ATTR_LEASE_NONE) return lease;
+
+  const uint64_t now_ns = utils::TimestampNs();
+  bool is_conflict = false;
+  lease_map_.withWLock(
+      [&](Map& map) mutable {
+        auto& inode_lease = map[ino];
+
+        // other client is writing, its length and mtime change without recall
+        if (inode_lease.writer_id != client_id && inode_lease.writer_expire_time_ns > now_ns) {
+          is_conflict = true;
+          return;
+        }
+
+        auto& holders = inode_lease.holders;
+        for (const auto& [holder_id, holder_lease] : holders) {
+          if (holder_id == client_id || holder_lease.expire_time_ns <= now_ns) continue;
+
+          // write delegation is exclusive
+          if (type == pb::mds::ATTR_LEASE_WRITE || holder_lease.type == pb::mds::ATTR_LEASE_WRITE) {
+            is_conflict = true;
+            return;
+          }
+        }
+
+        holders[client_id] = Lease{.type = type, .expire_time_ns = now_ns + lease_ms * 1000000};
+      },
+      ino);
+
+  if (is_conflict) {
+    conflict_count_ << 1;
+    return lease;
+  }
+
+  if (type == pb::mds::ATTR_LEASE_WRITE) {
+    grant_write_count_ << 1;
+  } else {
+    grant_read_count_ << 1;
+  }
+
+  lease.set_type(type);
+  lease.set_lease_ms(lease_ms);
+
+  return lease;
+}
+
+void AttrLeaseManager::Recall(Ino ino, const std::string& client_id, bool only_write) {
+  const uint64_t now_ns = utils::TimestampNs();
+
+  // write holders are kept until recall acknowledged
+  std::vector<std::pair<std::string, uint64_t>> write_holders;
+  std::vector<std::string> read_holders;
+  lease_map_.withWLock(
+      [&](Map& map) mutable {
+        auto it = map.find(ino);
+        if (it == map.end()) return;
+
+        auto& holders = it->second.holders;
+        for (auto holder_it = holders.begin(); holder_it != holders.end();) {
+          const auto& holder_id = holder_it->first;
+          const auto& holder_lease = holder_it->second;
+          if (holder_id == client_id || (only_write && holder_lease.type != pb::mds::ATTR_LEASE_WRITE)) {
+            ++holder_it;
+            continue;
+          }
+
+          if (holder_lease.expire_time_ns > now_ns && holder_lease.type == pb::mds::ATTR_LEASE_WRITE) {
+            write_holders.emplace_back(holder_id, holder_lease.expire_time_ns);
+            ++holder_it;
+            continue;
+          }
+
+          if (holder_lease.expire_time_ns > now_ns) read_holders.push_back(holder_id);
+          holders.erase(holder_it++);
+        }
+
+        if (holders.empty() && it->second.writer_expire_time_ns <= now_ns) map.erase(it);
+      },
+      ino);
+
+  for (const auto& holder_id : read_holders) {
+    client_notifier_.AsyncRecallAttrLease(holder_id, ino);
+    recall_count_ << 1;
+  }
+
+  // wait holder write back dirty attr, if fail the delegation expire by itself
+  for (const auto& [holder_id, expire_time_ns] : write_holders) {
+    utils::Duration duration;
+    auto status = client_notifier_.RecallAttrLease(holder_id, {ino});
+    recall_latency_ << duration.ElapsedUs();
+    recall_count_ << 1;
+
+    LOG(INFO) << fmt::format("[attrlease.{}.{}][{}us] recall write delegation from client({}), status({}).", fs_id_,
+                             ino, duration.ElapsedUs(), holder_id, status.error_str());
+    if (!status.ok()) continue;
+
+    // holder may be granted again meanwhile
+    lease_map_.withWLock(
+        [&](Map& map) mutable {
+          auto it = map.find(ino);
+          if (it == map.end()) return;
+
+          auto& holders = it->second.holders;
+          auto holder_it = holders.find(holder_id);
+          if (holder_it != holders.end() && holder_it->second.expire_time_ns == expire_time_ns) {
+            holders.erase(holder_it);
+          }
+        },
+        ino);
+  }
+}
+
+void AttrLeaseManager::MarkWrite(Ino ino, const std::string& client_id) {
+  if (!FLAGS_mds_attr_lease_enable || client_id.empty()) return;
+
+  const uint64_t now_ns = utils::TimestampNs();
+
+  std::vector<std::string> read_holders;
+  lease_map_.withWLock(
+      [&](Map& map) mutable {
+        auto& inode_lease = map[ino];
+        inode_lease.writer_id = client_id;
+        inode_lease.writer_expire_time_ns = now_ns + static_cast<uint64_t>(FLAGS_mds_attr_lease_ms) * 1000000;
+
+        auto& holders = inode_lease.holders;
+        for (auto holder_it = holders.begin(); holder_it != holders.end();) {
+          const auto& holder_id = holder_it->first;
+          const auto& holder_lease = holder_it->second;
+          if (holder_id == client_id || holder_lease.type != pb::mds::ATTR_LEASE_READ) {
+            ++holder_it;
+            continue;
+          }
+
+          if (holder_lease.expire_time_ns > now_ns) read_holders.push_back(holder_id);
+          holders.erase(holder_it++);
+        }
+      },
+      ino);
+
+  for (const auto& holder_id : read_holders) {
+    client_notifier_.AsyncRecallAttrLease(holder_id, ino);
+    recall_count_ << 1;
+  }
+}
+
+void AttrLeaseManager::CleanExpired() {
+  const uint64_t now_ns = utils::TimestampNs();
+
+  lease_map_.iterateWLock([now_ns](Map& map) {
+    for (auto it = map.begin(); it != map.end();) {
+      auto& inode_lease = it->second;
+      absl::erase_if(inode_lease.holders,
+                     [now_ns](const auto& holder) { return holder.second.expire_time_ns <= now_ns; });
+
+      if (inode_lease.holders.empty() && inode_lease.writer_expire_time_ns <= now_ns) {
+        map.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  });
+}
+
+size_t AttrLeaseManager::Size() {
+  size_t size = 0;
+  lease_map_.iterate([&size](Map& map) { size += map.size(); });
+  return size;
+}
+
+void AttrLeaseManager::Summary(Json::Value& value) {
+  value["name"] = "attrlease";
+  value["count"] = Size();
+  value["grant_read_count"] = grant_read_count_.get_value();
+  value["grant_write_count"] = grant_write_count_.get_value();
+  value["conflict_count"] = conflict_count_.get_value();
+  value["recall_count"] = recall_count_.get_value();
+  value["recall_latency_us"] = recall_latency_.latency();
+}
+
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,102 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGOFS_MDS_FILESYSTEM_ATTR_LEASE_H_
+#define DINGOFS_MDS_FILESYSTEM_ATTR_LEASE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
+#include "json/value.h"
+#include "mds/common/type.h"
+#include "mds/filesystem/client_notifier.h"
+#include "utils/shards.h"
+
+namespace dingofs {
+namespace mds {
+
+// grant client delegation of file attr, read delegation allow client serve
+// getattr from cache, write delegation additionally allow client update
+// time attr locally and write back later. conflict delegation held by other
+// client is recalled before change inode, read delegation is not granted
+// while other client is writing the file.
+class AttrLeaseManager {
+ public:
+  AttrLeaseManager(uint32_t fs_id, ClientNotifier& client_notifier);
+  ~AttrLeaseManager() = default;
+
+  bool Destroy();
+
+  // grant lease if not conflict with other client
+  AttrLeaseEntry Grant(Ino ino, const std::string& client_id, pb::mds::AttrLeaseType type);
+
+  // recall lease held by other clients, write delegation is recalled
+  // synchronously so its dirty attr is written back, only_write means
+  // keep read delegation. write delegation fail to recall is kept until
+  // expired, so conflict lease is not granted meanwhile.
+  void Recall(Ino ino, const std::string& client_id, bool only_write);
+
+  // client open file for write or write data, recall read delegation of
+  // other clients and not grant them new one for a lease time.
+  void MarkWrite(Ino ino, const std::string& client_id);
+
+  void CleanExpired();
+
+  size_t Size();
+
+  void Summary(Json::Value& value);
+
+ private:
+  struct Lease {
+    pb::mds::AttrLeaseType type;
+    uint64_t expire_time_ns{0};
+  };
+
+  const uint32_t fs_id_;
+
+  // client_id -> lease
+  using LeaseHolders = absl::flat_hash_map<std::string, Lease>;
+
+  struct InodeLease {
+    LeaseHolders holders;
+    // last client write the file
+    std::string writer_id;
+    uint64_t writer_expire_time_ns{0};
+  };
+  using Map = absl::flat_hash_map<Ino, InodeLease>;
+
+  constexpr static size_t kShardNum = 64;
+  utils::Shards<Map, kShardNum> lease_map_;
+
+  std::atomic<bool> is_stop_{false};
+
+  ClientNotifier& client_notifier_;
+
+  // statistics
+  bvar::Adder<int64_t> grant_read_count_;
+  bvar::Adder<int64_t> grant_write_count_;
+  bvar::Adder<int64_t> conflict_count_;
+  bvar::Adder<int64_t> recall_count_;
+  bvar::LatencyRecorder recall_latency_;
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_FILESYSTEM_ATTR_LEASE_H_
@@ -0,0 +1,196 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Create storm benchmark of OperationProcessor, many bthreads create files
+// under one hot dir, report ops/s and retry. Run it with
+// --mds_store_operation_inode_serial_enable=false to compare, and with
+// --storage=tikv --storage_addr=... against real store. With --dir_num > 1
+// files spread over dirs, run it with
+// --mds_store_operation_multi_inode_batch_enable to see the batch size and
+// saved commits.
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "bthread/countdown_event.h"
+#include "bvar/variable.h"
+#include "common/const.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "mds/common/tracing.h"
+#include "mds/filesystem/dentry.h"
+#include "mds/filesystem/store_operation.h"
+#include "mds/storage/dummy_storage.h"
+#include "mds/storage/memory_storage.h"
+#include "mds/storage/tikv_storage.h"
+#include "utils/time.h"
+
+DEFINE_string(storage, "dummy", "storage type, dummy|memory|tikv");
+DEFINE_string(storage_addr, "", "storage address");
+DEFINE_uint32(fs_id, 10000, "fs id");
+DEFINE_uint32(bthread_num, 64, "bthread number");
+DEFINE_uint32(file_num, 1000, "file number per bthread");
+DEFINE_uint32(dir_num, 1, "dir number, bthreads create files under dir index % dir_num");
+
+namespace dingofs {
+namespace mds {
+
+struct BenchContext {
+  OperationProcessorSPtr processor;
+  uint32_t index{0};
+  Ino parent{0};
+  std::atomic<uint64_t>* ino_seq{nullptr};
+  std::atomic<uint64_t>* error_count{nullptr};
+};
+
+static AttrEntry GenAttr(Ino ino, Ino parent, pb::mds::FileType type) {
+  uint64_t now_ns = utils::TimestampNs();
+
+  AttrEntry attr;
+  attr.set_fs_id(FLAGS_fs_id);
+  attr.set_ino(ino);
+  attr.set_mode(type == pb::mds::FileType::DIRECTORY ? (S_IFDIR | 0777) : (S_IFREG | 0644));
+  attr.set_nlink(type == pb::mds::FileType::DIRECTORY ? kEmptyDirMinLinkNum : 1);
+  attr.set_type(type);
+  attr.set_ctime(now_ns);
+  attr.set_mtime(now_ns);
+  attr.set_atime(now_ns);
+  attr.add_parents(parent);
+
+  return attr;
+}
+
+static Status RunBatched(OperationProcessorSPtr& processor, Operation* operation) {
+  bthread::CountdownEvent count_down(1);
+  operation->SetEvent(&count_down);
+
+  if (!processor->RunBatched(operation)) {
+    return Status(pb::error::EINTERNAL, "run batched fail");
+  }
+  CHECK(count_down.wait() == 0) << "count down wait fail.";
+
+  return operation->GetResult().status;
+}
+
+static void* CreateFiles(void* arg) {
+  auto* ctx = reinterpret_cast<BenchContext*>(arg);
+
+  for (uint32_t i = 0; i < FLAGS_file_num; ++i) {
+    Ino ino = ctx->ino_seq->fetch_add(2);
+    std::string name = fmt::format("file_{}_{}", ctx->index, i);
+
+    Trace trace;
+    Dentry dentry(FLAGS_fs_id, name, ctx->parent, ino, pb::mds::FileType::FILE, 0);
+    MkNodOperation operation(trace, dentry, GenAttr(ino, ctx->parent, pb::mds::FileType::FILE));
+
+    auto status = RunBatched(ctx->processor, &operation);
+    if (!status.ok()) ctx->error_count->fetch_add(1);
+  }
+
+  return nullptr;
+}
+
+static void RunBench() {
+  KVStorageSPtr kv_storage;
+  if (FLAGS_storage == "tikv") {
+    kv_storage = TikvStorage::New();
+  } else if (FLAGS_storage == "memory") {
+    kv_storage = MemoryStorage::New();
+  } else {
+    kv_storage = DummyStorage::New();
+  }
+  CHECK(kv_storage->Init(FLAGS_storage_addr)) << "init kv storage fail.";
+
+  auto processor = OperationProcessor::New(kv_storage);
+  CHECK(processor->Init()) << "init operation processor fail.";
+
+  // hot dir
+  Trace trace;
+  Dentry root_dentry(FLAGS_fs_id, "/", kRootParentIno, kRootIno, pb::mds::FileType::DIRECTORY, 0);
+  CreateRootOperation root_operation(trace, root_dentry,
+                                     GenAttr(kRootIno, kRootParentIno, pb::mds::FileType::DIRECTORY));
+  auto status = processor->RunAlone(&root_operation);
+  CHECK(status.ok()) << "create root fail, " << status.error_str();
+
+  std::atomic<uint64_t> ino_seq{utils::TimestampNs() << 1};
+  std::atomic<uint64_t> error_count{0};
+
+  // dirs under root, dir ino is odd so never collide with file ino
+  std::vector<Ino> dirs = {kRootIno};
+  for (uint32_t i = 1; i < FLAGS_dir_num; ++i) {
+    Ino ino = ino_seq.fetch_add(2) + 1;
+    Dentry dentry(FLAGS_fs_id, fmt::format("dir_{}", i), kRootIno, ino, pb::mds::FileType::DIRECTORY, 0);
+    MkDirOperation operation(trace, dentry, GenAttr(ino, kRootIno, pb::mds::FileType::DIRECTORY));
+    status = RunBatched(processor, &operation);
+    CHECK(status.ok()) << "create dir fail, " << status.error_str();
+    dirs.push_back(ino);
+  }
+
+  std::vector<BenchContext> contexts(FLAGS_bthread_num);
+  std::vector<bthread_t> tids(FLAGS_bthread_num);
+
+  utils::Duration duration;
+  for (uint32_t i = 0; i < FLAGS_bthread_num; ++i) {
+    contexts[i] = {.processor = processor,
+                   .index = i,
+                   .parent = dirs[i % dirs.size()],
+                   .ino_seq = &ino_seq,
+                   .error_count = &error_count};
+    CHECK(bthread_start_background(&tids[i], nullptr, CreateFiles, &contexts[i]) == 0) << "start bthread fail.";
+  }
+  for (auto tid : tids) bthread_join(tid, nullptr);
+
+  double elapsed_s = static_cast<double>(duration.ElapsedUs()) / 1000000;
+  uint64_t total = static_cast<uint64_t>(FLAGS_bthread_num) * FLAGS_file_num;
+
+  processor->Destroy();
+
+  std::cout << fmt::format("storage: {} bthreads: {} dirs: {} files: {} errors: {}\n", FLAGS_storage,
+                           FLAGS_bthread_num, dirs.size(), total, error_count.load());
+  std::cout << fmt::format("create ops/s: {:.2f}\n", total / elapsed_s);
+
+  // conflict and retry statistics of mknod, and multi inode batch statistics
+  std::vector<std::string> names;
+  bvar::Variable::list_exposed(&names);
+  for (const auto& name : names) {
+    if (name.rfind("mds_operation_mk_nod", 0) != 0 && name.rfind("mds_operation_multi_inode_batch", 0) != 0 &&
+        name != "mds_operation_serial_merge_count") {
+      continue;
+    }
+    std::cout << name << ": " << bvar::Variable::describe_exposed(name) << "\n";
+  }
+}
+
+}  // namespace mds
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(FLAGS_bthread_num > 0) << "bthread_num must be positive.";
+  CHECK(FLAGS_file_num > 0) << "file_num must be positive.";
+  CHECK(FLAGS_dir_num > 0) << "dir_num must be positive.";
+
+  dingofs::mds::RunBench();
+
+  return 0;
+}
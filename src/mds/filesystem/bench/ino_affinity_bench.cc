@@ -0,0 +1,125 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// File ino allocation benchmark, compare AffinityInoAllocator with plain id
+// generator allocation under hash partition. threads create files under
+// --dir_num dirs, --hot_ratio of creates go to the first dir. report create
+// ino rate and ids consumed from id generator per ino, which include the
+// odd ids and the ids discarded by full buckets.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "mds/filesystem/id_generator.h"
+#include "mds/storage/memory_storage.h"
+#include "utils/time.h"
+
+DEFINE_uint32(thread_num, 8, "thread number");
+DEFINE_uint32(file_num, 100000, "file number per thread");
+DEFINE_uint32(dir_num, 1024, "parent dir number");
+DEFINE_double(hot_ratio, 0, "ratio of creates under the first dir");
+DEFINE_uint32(bucket_num, 1024, "hash bucket num");
+DEFINE_uint32(batch, 4, "affinity file ino number per bucket of one refill");
+DEFINE_uint32(max_cached, 256, "affinity max cached file ino per bucket");
+
+namespace dingofs {
+namespace mds {
+
+static const uint32_t kFsId = 10000;
+
+// run func(parent) on all threads, return ino/s
+template <typename Func>
+static double RunPhase(const std::vector<Ino>& dirs, Func func) {
+  std::vector<std::thread> threads;
+
+  utils::Duration duration;
+  for (uint32_t t = 0; t < FLAGS_thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937_64 rng(t);
+      std::uniform_real_distribution<double> ratio_dist(0, 1);
+      std::uniform_int_distribution<size_t> dir_dist(0, dirs.size() - 1);
+
+      for (uint32_t i = 0; i < FLAGS_file_num; ++i) {
+        Ino parent = ratio_dist(rng) < FLAGS_hot_ratio ? dirs[0] : dirs[dir_dist(rng)];
+        CHECK(func(parent)) << "generate file ino fail.";
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  double elapsed_s = std::max(duration.ElapsedNs(), static_cast<int64_t>(1)) / 1e9;
+  return static_cast<double>(FLAGS_thread_num) * FLAGS_file_num / elapsed_s;
+}
+
+static IdGeneratorUPtr NewIdGenerator(KVStorageSPtr kv_storage, const std::string& name) {
+  auto id_generator = NewInodeIdGenerator(kFsId, kv_storage);
+  CHECK(id_generator->Init()) << fmt::format("init {} id generator fail.", name);
+  return id_generator;
+}
+
+static void RunBench() {
+  auto kv_storage = MemoryStorage::New();
+  CHECK(kv_storage->Init("")) << "init kv storage fail.";
+
+  // dir ino is odd
+  std::vector<Ino> dirs;
+  for (uint32_t i = 0; i < FLAGS_dir_num; ++i) dirs.push_back((2ULL * i) + 1);
+
+  const uint64_t total = static_cast<uint64_t>(FLAGS_thread_num) * FLAGS_file_num;
+
+  auto plain_id_generator = NewIdGenerator(kv_storage, "plain");
+  double plain_rate = RunPhase(dirs, [&](Ino) {
+    uint64_t ino = 0;
+    return plain_id_generator->GenID(2, ino);
+  });
+
+  auto affinity_id_generator = NewIdGenerator(kv_storage, "affinity");
+  AffinityInoAllocator allocator(*affinity_id_generator, FLAGS_batch, FLAGS_max_cached);
+  double affinity_rate = RunPhase(dirs, [&](Ino parent) {
+    uint64_t ino = 0;
+    return allocator.GenFileIno(FLAGS_bucket_num, parent % FLAGS_bucket_num, ino);
+  });
+
+  const uint64_t affinity_ids = total + allocator.DiscardedCount() + allocator.CachedCount();
+
+  std::cout << fmt::format("threads: {} files: {} dirs: {} hot_ratio: {} buckets: {} batch: {} max_cached: {}\n",
+                           FLAGS_thread_num, total, FLAGS_dir_num, FLAGS_hot_ratio, FLAGS_bucket_num, FLAGS_batch,
+                           FLAGS_max_cached);
+  std::cout << fmt::format("plain ino/s: {:.2f} ids/ino: {:.2f}\n", plain_rate, 2.0);
+  std::cout << fmt::format("affinity ino/s: {:.2f} ids/ino: {:.2f} cached: {}\n", affinity_rate,
+                           static_cast<double>(affinity_ids) / total, allocator.CachedCount());
+}
+
+}  // namespace mds
+}  // namespace dingofs
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  CHECK(FLAGS_thread_num > 0) << "thread_num must be positive.";
+  CHECK(FLAGS_dir_num > 0) << "dir_num must be positive.";
+  CHECK(FLAGS_bucket_num > 0) << "bucket_num must be positive.";
+
+  dingofs::mds::RunBench();
+
+  return 0;
+}
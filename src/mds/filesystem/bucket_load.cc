@@ -0,0 +1,55 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/filesystem/bucket_load.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include "gflags/gflags.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_uint32(mds_filesystem_hash_bucket_num);
+
+BucketLoadRecorder::BucketLoadRecorder(uint32_t bucket_num)
+    : bucket_num_(bucket_num),
+      capacity_(std::max(bucket_num, FLAGS_mds_filesystem_hash_bucket_num)),
+      counters_(new std::atomic<uint64_t>[capacity_]),
+      last_take_time_ms_(utils::TimestampMs()) {
+  for (uint32_t i = 0; i < capacity_; ++i) counters_[i].store(0, std::memory_order_relaxed);
+}
+
+uint64_t BucketLoadRecorder::Take(std::map<uint32_t, uint64_t>& bucket_ops) {
+  std::lock_guard<bthread::Mutex> lock(mutex_);
+
+  const uint32_t bucket_num = std::min(BucketNum(), capacity_);
+  for (uint32_t i = 0; i < bucket_num; ++i) {
+    uint64_t ops = counters_[i].exchange(0, std::memory_order_relaxed);
+    if (ops > 0) bucket_ops[i] = ops;
+  }
+
+  const uint64_t now_ms = utils::TimestampMs();
+  const uint64_t window_ms = now_ms > last_take_time_ms_ ? now_ms - last_take_time_ms_ : 0;
+  last_take_time_ms_ = now_ms;
+
+  return window_ms;
+}
+
+}  // namespace mds
+}  // namespace dingofs
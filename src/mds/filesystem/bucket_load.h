@@ -0,0 +1,99 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_FILESYSTEM_BUCKET_LOAD_H_
+#define DINGOFS_MDS_FILESYSTEM_BUCKET_LOAD_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include "bthread/mutex.h"
+
+namespace dingofs {
+namespace mds {
+
+// count access of every hash bucket of one fs, bucket is same as client router
+// route the op. heartbeat take the counts as op rate of window since last take,
+// and balancer move hot bucket by it.
+class BucketLoadRecorder {
+ public:
+  explicit BucketLoadRecorder(uint32_t bucket_num);
+  ~BucketLoadRecorder() = default;
+
+  // counters are allocated once, bucket id beyond it is not counted
+  void SetBucketNum(uint32_t bucket_num) { bucket_num_.store(bucket_num, std::memory_order_relaxed); }
+  uint32_t BucketNum() const { return bucket_num_.load(std::memory_order_relaxed); }
+
+  // file ino is allocated in parent bucket, see FileSystem::IsInoAffinity
+  void SetInoAffinity(bool ino_affinity) { ino_affinity_.store(ino_affinity, std::memory_order_relaxed); }
+  bool IsInoAffinity() const { return ino_affinity_.load(std::memory_order_relaxed); }
+
+  // dentry and partition op is routed by parent
+  static uint32_t ParentBucketId(uint64_t parent, uint32_t bucket_num) { return parent % bucket_num; }
+  // inode op, dir ino(odd) is hashed by itself. file ino(even) bucket is derived
+  // from ino with ino affinity(see FileSystem::GenFileIno), otherwise it is parent
+  // bucket, 0 parent means unknown and the op is not counted.
+  static bool InoBucketId(uint64_t ino, uint64_t parent, uint32_t bucket_num, bool ino_affinity,
+                          uint32_t& bucket_id) {
+    if (ino & 1) {
+      bucket_id = ino % bucket_num;
+    } else if (ino_affinity) {
+      bucket_id = (ino >> 1) % bucket_num;
+    } else if (parent != 0) {
+      bucket_id = parent % bucket_num;
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  // parent is needed to count op of the ino
+  bool IsParentNeeded(uint64_t ino) const { return BucketNum() > 0 && (ino & 1) == 0 && !IsInoAffinity(); }
+
+  void RecordParent(uint64_t parent) {
+    const uint32_t bucket_num = bucket_num_.load(std::memory_order_relaxed);
+    if (bucket_num > 0) Count(ParentBucketId(parent, bucket_num));
+  }
+
+  void RecordIno(uint64_t ino, uint64_t parent) {
+    const uint32_t bucket_num = bucket_num_.load(std::memory_order_relaxed);
+    uint32_t bucket_id = 0;
+    if (bucket_num > 0 && InoBucketId(ino, parent, bucket_num, IsInoAffinity(), bucket_id)) Count(bucket_id);
+  }
+
+  // take non-zero counts and reset, return window ms since last take
+  uint64_t Take(std::map<uint32_t, uint64_t>& bucket_ops);
+
+ private:
+  void Count(uint32_t bucket_id) {
+    if (bucket_id < capacity_) counters_[bucket_id].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint32_t> bucket_num_{0};
+  std::atomic<bool> ino_affinity_{false};
+
+  const uint32_t capacity_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counters_;
+
+  bthread::Mutex mutex_;
+  uint64_t last_take_time_ms_{0};
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_FILESYSTEM_BUCKET_LOAD_H_
@@ -40,22 +40,26 @@ static ChunkCache::ChunkSPtr NewChunk(ChunkEntry&& chunk) { return std::make_sha
 
 bool ChunkCache::PutIf(uint64_t ino, ChunkEntry chunk) {
   chunk.set_expire_time_s(utils::Timestamp());
+  const uint64_t now_ms = utils::TimestampMs();
 
   bool ret = true;
   shard_map_.withWLock(
-      [this, ino, &ret, &chunk](Map& map) mutable {
+      [this, ino, now_ms, &ret, &chunk](Map& map) mutable {
         Key key{.ino = ino, .chunk_index = chunk.index()};
         auto it = map.find(key);
         if (it == map.end()) {
-          map.insert(std::make_pair(key, NewChunk(std::move(chunk))));
+          map.insert(std::make_pair(key, Item{.chunk = NewChunk(std::move(chunk)), .load_time_ms = now_ms}));
 
           total_count_ << 1;
 
         } else {
-          const auto& old_chunk = it->second;
-          if (chunk.version() > old_chunk->version()) {
-            it->second = NewChunk(std::move(chunk));
+          auto& item = it->second;
+          if (chunk.version() > item.chunk->version()) {
+            item.chunk = NewChunk(std::move(chunk));
+            item.load_time_ms = now_ms;
+
           } else {
+            if (chunk.version() == item.chunk->version()) item.load_time_ms = now_ms;
             ret = false;
           }
         }
@@ -105,6 +109,11 @@ void ChunkCache::BatchDeleteIf(const std::function<bool(const Ino&)>& f) {
 }
 
 ChunkCache::ChunkSPtr ChunkCache::Get(uint64_t ino, uint64_t chunk_index) {
+  uint64_t load_time_ms = 0;
+  return Get(ino, chunk_index, load_time_ms);
+}
+
+ChunkCache::ChunkSPtr ChunkCache::Get(uint64_t ino, uint64_t chunk_index, uint64_t& load_time_ms) {
   ChunkCache::ChunkSPtr chunk;
   shard_map_.withRLock(
       [&](Map& map) mutable {
@@ -112,7 +121,8 @@ ChunkCache::ChunkSPtr ChunkCache::Get(uint64_t ino, uint64_t chunk_index) {
 
         auto it = map.find(key);
         if (it != map.end()) {
-          chunk = it->second;
+          chunk = it->second.chunk;
+          load_time_ms = it->second.load_time_ms;
           access_hit_count_ << 1;
 
         } else {
@@ -136,8 +146,8 @@ std::vector<ChunkCache::ChunkSPtr> ChunkCache::Get(uint64_t ino) {
         for (auto it = map.lower_bound(key); it != map.end(); ++it) {
           if (it->first.ino != ino) break;
 
-          it->second->set_expire_time_s(now_s);
-          chunks.push_back(it->second);
+          it->second.chunk->set_expire_time_s(now_s);
+          chunks.push_back(it->second.chunk);
         }
       },
       ino);
@@ -157,8 +167,9 @@ size_t ChunkCache::Size() {
 size_t ChunkCache::Bytes() {
   size_t bytes = 0;
   shard_map_.iterate([&bytes](Map& map) {
-    for (auto& [key, chunk] : map) {
-      bytes += sizeof(Key) + sizeof(ChunkEntry) + chunk->slices_size() * sizeof(SliceEntry) +
+    for (auto& [key, item] : map) {
+      const auto& chunk = item.chunk;
+      bytes += sizeof(Key) + sizeof(Item) + sizeof(ChunkEntry) + chunk->slices_size() * sizeof(SliceEntry) +
                chunk->compacted_slices_size() * sizeof(ChunkEntry::CompactedSlice);
     }
   });
@@ -177,8 +188,8 @@ void ChunkCache::CleanExpired(uint64_t expire_s) {
 
   std::vector<Key> keys;
   shard_map_.iterate([&](const Map& map) {
-    for (const auto& [key, chunk] : map) {
-      if (chunk->expire_time_s() < expire_s) {
+    for (const auto& [key, item] : map) {
+      if (item.chunk->expire_time_s() < expire_s) {
         keys.push_back(key);
       }
     }
@@ -41,13 +41,15 @@ class ChunkCache {
 
   static ChunkCacheUPtr New(uint32_t fs_id) { return std::make_unique<ChunkCache>(fs_id); }
 
-  // if version is newer then put
+  // if version is newer then put, same version only refresh load time
   bool PutIf(uint64_t ino, ChunkEntry chunk);
   void Delete(uint64_t ino, uint64_t chunk_index);
   void Delete(uint64_t ino);
   void BatchDeleteIf(const std::function<bool(const Ino&)>& f);
 
   ChunkSPtr Get(uint64_t ino, uint64_t chunk_index);
+  // load_time_ms is the last time chunk is loaded or confirmed from store/write
+  ChunkSPtr Get(uint64_t ino, uint64_t chunk_index, uint64_t& load_time_ms);
   std::vector<ChunkSPtr> Get(uint64_t ino);
 
   size_t Size();
@@ -75,8 +77,13 @@ class ChunkCache {
 
   const uint32_t fs_id_{0};
 
+  struct Item {
+    ChunkSPtr chunk;
+    uint64_t load_time_ms{0};
+  };
+
   // ino/chunk_index -> ChunkEntry
-  using Map = absl::btree_map<Key, ChunkSPtr>;
+  using Map = absl::btree_map<Key, Item>;
   constexpr static size_t kShardNum = 64;
   utils::Shards<Map, kShardNum> shard_map_;
 
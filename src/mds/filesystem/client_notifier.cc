@@ -0,0 +1,232 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mds/filesystem/client_notifier.h"
+
+#include <bthread/types.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "bthread/mutex.h"
+#include "common/logging.h"
+#include "fmt/format.h"
+#include "mds/service/service_access.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_uint32(mds_client_notify_refresh_interval_s, 5, "refresh client endpoint interval s.");
+DEFINE_validator(mds_client_notify_refresh_interval_s, brpc::PassValidate);
+
+ClientNotifier::ClientNotifier(uint32_t fs_id, OperationProcessorSPtr operation_processor)
+    : fs_id_(fs_id), operation_processor_(operation_processor) {
+  bthread_mutex_init(&mutex_, nullptr);
+  bthread_cond_init(&cond_, nullptr);
+  bthread_mutex_init(&endpoint_mutex_, nullptr);
+}
+
+ClientNotifier::~ClientNotifier() {
+  bthread_cond_destroy(&cond_);
+  bthread_mutex_destroy(&mutex_);
+  bthread_mutex_destroy(&endpoint_mutex_);
+}
+
+bool ClientNotifier::Init() {
+  struct Param {
+    ClientNotifier* self{nullptr};
+  };
+
+  Param* param = new Param({this});
+
+  const bthread_attr_t attr = BTHREAD_ATTR_NORMAL;
+  if (bthread_start_background(
+          &tid_, &attr,
+          [](void* arg) -> void* {
+            Param* param = reinterpret_cast<Param*>(arg);
+
+            param->self->DispatchMessage();
+
+            delete param;
+            return nullptr;
+          },
+          param) != 0) {
+    tid_ = 0;
+    delete param;
+    LOG(FATAL) << "[clientnotify] start background thread fail.";
+    return false;
+  }
+
+  return true;
+}
+
+bool ClientNotifier::Destroy() {
+  is_stop_.store(true);
+
+  if (tid_ > 0) {
+    bthread_cond_signal(&cond_);
+
+    if (bthread_stop(tid_) != 0) {
+      LOG(ERROR) << fmt::format("[clientnotify.{}] bthread_stop fail.", fs_id_);
+    }
+
+    if (bthread_join(tid_, nullptr) != 0) {
+      LOG(ERROR) << fmt::format("[clientnotify.{}] bthread_join fail.", fs_id_);
+    }
+  }
+
+  return true;
+}
+
+void ClientNotifier::AsyncInvalidateDentry(const std::string& client_id, Ino parent) {
+  Enqueue(Message{.type = Type::kInvalidateDentry, .client_id = client_id, .ino = parent});
+}
+
+void ClientNotifier::AsyncRecallAttrLease(const std::string& client_id, Ino ino) {
+  Enqueue(Message{.type = Type::kRecallAttrLease, .client_id = client_id, .ino = ino});
+}
+
+Status ClientNotifier::RecallAttrLease(const std::string& client_id, const std::vector<Ino>& inos) {
+  butil::EndPoint endpoint;
+  if (!GetClientEndpoint(client_id, endpoint)) {
+    return Status(pb::error::ENOT_FOUND, fmt::format("not found client({}) endpoint", client_id));
+  }
+
+  pb::client::RecallAttrLeaseRequest request;
+  request.set_fs_id(fs_id_);
+  for (const auto& ino : inos) {
+    request.add_inos(ino);
+  }
+
+  return ServiceAccess::RecallAttrLease(endpoint, request);
+}
+
+void ClientNotifier::Enqueue(Message&& message) {
+  if (is_stop_.load(std::memory_order_relaxed)) return;
+
+  queue_.Enqueue(std::move(message));
+
+  bthread_cond_signal(&cond_);
+}
+
+void ClientNotifier::DispatchMessage() {
+  while (true) {
+    Message message;
+    while (!queue_.Dequeue(message) && !is_stop_.load(std::memory_order_relaxed)) {
+      bthread_mutex_lock(&mutex_);
+      bthread_cond_wait(&cond_, &mutex_);
+      bthread_mutex_unlock(&mutex_);
+    }
+
+    if (is_stop_.load(std::memory_order_relaxed)) {
+      break;
+    }
+
+    // client_id -> inos
+    std::map<std::string, std::vector<Ino>> invalidate_dentry_map;
+    std::map<std::string, std::vector<Ino>> recall_attr_lease_map;
+    do {
+      if (message.type == Type::kInvalidateDentry) {
+        invalidate_dentry_map[message.client_id].push_back(message.ino);
+      } else {
+        recall_attr_lease_map[message.client_id].push_back(message.ino);
+      }
+    } while (queue_.Dequeue(message));
+
+    for (auto& [client_id, parents] : invalidate_dentry_map) {
+      SendInvalidateDentry(client_id, parents);
+    }
+
+    for (auto& [client_id, inos] : recall_attr_lease_map) {
+      auto status = RecallAttrLease(client_id, inos);
+      if (!status.ok()) {
+        LOG(ERROR) << fmt::format("[clientnotify.{}] recall client({}) attr lease fail, {}.", fs_id_, client_id,
+                                  status.error_str());
+      }
+    }
+  }
+}
+
+void ClientNotifier::SendInvalidateDentry(const std::string& client_id, const std::vector<Ino>& parents) {
+  butil::EndPoint endpoint;
+  if (!GetClientEndpoint(client_id, endpoint)) {
+    LOG(WARNING) << fmt::format("[clientnotify.{}] not found client({}) endpoint.", fs_id_, client_id);
+    return;
+  }
+
+  pb::client::InvalidateDentryRequest request;
+  request.set_fs_id(fs_id_);
+  for (const auto& parent : parents) {
+    request.add_parents(parent);
+  }
+
+  auto status = ServiceAccess::InvalidateDentry(endpoint, request);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[clientnotify.{}] invalidate client({}) dentry fail, {}.", fs_id_, client_id,
+                              status.error_str());
+  }
+}
+
+bool ClientNotifier::GetClientEndpoint(const std::string& client_id, butil::EndPoint& endpoint) {
+  BAIDU_SCOPED_LOCK(endpoint_mutex_);
+
+  auto it = client_endpoints_.find(client_id);
+  if (it == client_endpoints_.end()) {
+    RefreshClientEndpoints();
+    it = client_endpoints_.find(client_id);
+  }
+
+  if (it == client_endpoints_.end()) return false;
+
+  endpoint = it->second;
+  return true;
+}
+
+void ClientNotifier::RefreshClientEndpoints() {
+  const uint64_t now_s = utils::Timestamp();
+  if (now_s < last_refresh_client_time_s_ + FLAGS_mds_client_notify_refresh_interval_s) {
+    return;
+  }
+  last_refresh_client_time_s_ = now_s;
+
+  Trace trace;
+  ScanClientOperation operation(trace);
+  operation.SetIsolationLevel(Txn::kReadCommitted);
+
+  auto status = operation_processor_->RunAlone(&operation);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[clientnotify.{}] scan client fail, error({}).", fs_id_, status.error_str());
+    return;
+  }
+
+  auto& result = operation.GetResult();
+
+  client_endpoints_.clear();
+  for (const auto& client : result.client_entries) {
+    butil::EndPoint endpoint;
+    if (butil::str2endpoint(client.ip().c_str(), client.port(), &endpoint) != 0) {
+      continue;
+    }
+
+    client_endpoints_[client.id()] = endpoint;
+  }
+}
+
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,91 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGOFS_MDS_FILESYSTEM_CLIENT_NOTIFIER_H_
+#define DINGOFS_MDS_FILESYSTEM_CLIENT_NOTIFIER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bthread/types.h"
+#include "butil/containers/mpsc_queue.h"
+#include "butil/endpoint.h"
+#include "mds/common/status.h"
+#include "mds/common/type.h"
+#include "mds/filesystem/store_operation.h"
+
+namespace dingofs {
+namespace mds {
+
+// send notification to client of filesystem, e.g. invalidate dentry cache
+// or recall attr lease. client endpoint is resolved by heartbeat record.
+class ClientNotifier {
+ public:
+  ClientNotifier(uint32_t fs_id, OperationProcessorSPtr operation_processor);
+  ~ClientNotifier();
+
+  bool Init();
+  bool Destroy();
+
+  void AsyncInvalidateDentry(const std::string& client_id, Ino parent);
+  void AsyncRecallAttrLease(const std::string& client_id, Ino ino);
+
+  // wait client flush its dirty attr and drop lease
+  Status RecallAttrLease(const std::string& client_id, const std::vector<Ino>& inos);
+
+ private:
+  enum class Type : uint8_t {
+    kInvalidateDentry = 0,
+    kRecallAttrLease = 1,
+  };
+
+  struct Message {
+    Type type;
+    std::string client_id;
+    Ino ino{0};
+  };
+
+  void Enqueue(Message&& message);
+  void DispatchMessage();
+  void SendInvalidateDentry(const std::string& client_id, const std::vector<Ino>& parents);
+
+  bool GetClientEndpoint(const std::string& client_id, butil::EndPoint& endpoint);
+  void RefreshClientEndpoints();
+
+  const uint32_t fs_id_;
+
+  bthread_t tid_{0};
+  bthread_mutex_t mutex_;
+  bthread_cond_t cond_;
+
+  std::atomic<bool> is_stop_{false};
+
+  butil::MPSCQueue<Message> queue_;
+
+  // client_id -> endpoint
+  bthread_mutex_t endpoint_mutex_;
+  std::map<std::string, butil::EndPoint> client_endpoints_;
+  uint64_t last_refresh_client_time_s_{0};
+
+  OperationProcessorSPtr operation_processor_;
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_FILESYSTEM_CLIENT_NOTIFIER_H_
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mds/filesystem/dentry_lease.h"
+
+#include <cstdint>
+#include <string>
+
+#include "fmt/format.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_bool(mds_dentry_lease_enable, false, "enable grant dentry lease to client.");
+DEFINE_validator(mds_dentry_lease_enable, brpc::PassValidate);
+
+DEFINE_uint32(mds_dentry_lease_ms, 3000, "dentry lease time ms.");
+DEFINE_validator(mds_dentry_lease_ms, brpc::PassValidate);
+
+static const std::string kDentryLeaseGrantCountMetricsName = "dingofs_{}_dentry_lease_grant_count";
+static const std::string kDentryLeaseRevokeCountMetricsName = "dingofs_{}_dentry_lease_revoke_count";
+
+DentryLeaseManager::DentryLeaseManager(uint32_t fs_id, ClientNotifier& client_notifier)
+    : fs_id_(fs_id),
+      client_notifier_(client_notifier),
+      grant_count_(fmt::format(kDentryLeaseGrantCountMetricsName, fs_id)),
+      revoke_count_(fmt::format(kDentryLeaseRevokeCountMetricsName, fs_id)) {}
+
+bool DentryLeaseManager::Destroy() {
+  is_stop_.store(true);
+  return true;
+}
+
+uint64_t DentryLeaseManager::Grant(Ino parent, const std::string& client_id) {
+  if (!FLAGS_mds_dentry_lease_enable || client_id.empty() || is_stop_.load(std::memory_order_relaxed)) {
+    return 0;
+  }
+
+  const uint64_t lease_ms = FLAGS_mds_dentry_lease_ms;
+  if (lease_ms == 0) return 0;
+
+  const uint64_t expire_time_ns = utils::TimestampNs() + lease_ms * 1000000;
+  lease_map_.withWLock(
+      [parent, &client_id, expire_time_ns](Map& map) mutable { map[parent][client_id] = expire_time_ns; }, parent);
+
+  grant_count_ << 1;
+
+  return lease_ms;
+}
+
+void DentryLeaseManager::Revoke(Ino parent, const std::string& client_id) {
+  LeaseHolders holders;
+  lease_map_.withWLock(
+      [parent, &holders](Map& map) mutable {
+        auto it = map.find(parent);
+        if (it != map.end()) {
+          holders.swap(it->second);
+          map.erase(it);
+        }
+      },
+      parent);
+
+  if (holders.empty()) return;
+
+  const uint64_t now_ns = utils::TimestampNs();
+  for (const auto& [holder_id, expire_time_ns] : holders) {
+    // the client that modify dentry is responsible for its own cache
+    if (expire_time_ns <= now_ns || holder_id == client_id) continue;
+
+    client_notifier_.AsyncInvalidateDentry(holder_id, parent);
+    revoke_count_ << 1;
+  }
+}
+
+void DentryLeaseManager::CleanExpired() {
+  const uint64_t now_ns = utils::TimestampNs();
+
+  lease_map_.iterateWLock([now_ns](Map& map) {
+    for (auto it = map.begin(); it != map.end();) {
+      auto& holders = it->second;
+      absl::erase_if(holders, [now_ns](const auto& holder) { return holder.second <= now_ns; });
+
+      if (holders.empty()) {
+        map.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  });
+}
+
+size_t DentryLeaseManager::Size() {
+  size_t size = 0;
+  lease_map_.iterate([&size](Map& map) { size += map.size(); });
+  return size;
+}
+
+void DentryLeaseManager::Summary(Json::Value& value) {
+  value["name"] = "dentrylease";
+  value["count"] = Size();
+  value["grant_count"] = grant_count_.get_value();
+  value["revoke_count"] = revoke_count_.get_value();
+}
+
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGOFS_MDS_FILESYSTEM_DENTRY_LEASE_H_
+#define DINGOFS_MDS_FILESYSTEM_DENTRY_LEASE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "bvar/reducer.h"
+#include "json/value.h"
+#include "mds/common/type.h"
+#include "mds/filesystem/client_notifier.h"
+#include "utils/shards.h"
+
+namespace dingofs {
+namespace mds {
+
+// grant client lease of directory dentries, client serve lookup from its
+// dentry cache during lease. when directory is changed, lease held by other
+// clients are revoked and they are notified to drop cached dentries.
+class DentryLeaseManager {
+ public:
+  DentryLeaseManager(uint32_t fs_id, ClientNotifier& client_notifier);
+  ~DentryLeaseManager() = default;
+
+  bool Destroy();
+
+  // return lease time ms, 0 means not grant
+  uint64_t Grant(Ino parent, const std::string& client_id);
+
+  // revoke lease of parent held by other clients
+  void Revoke(Ino parent, const std::string& client_id);
+
+  void CleanExpired();
+
+  size_t Size();
+
+  void Summary(Json::Value& value);
+
+ private:
+  const uint32_t fs_id_;
+
+  // client_id -> lease expire time ns
+  using LeaseHolders = absl::flat_hash_map<std::string, uint64_t>;
+  using Map = absl::flat_hash_map<Ino, LeaseHolders>;
+
+  constexpr static size_t kShardNum = 64;
+  utils::Shards<Map, kShardNum> lease_map_;
+
+  std::atomic<bool> is_stop_{false};
+
+  ClientNotifier& client_notifier_;
+
+  // statistics
+  bvar::Adder<int64_t> grant_count_;
+  bvar::Adder<int64_t> revoke_count_;
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_FILESYSTEM_DENTRY_LEASE_H_
@@ -259,6 +259,61 @@ Status FileSessionManager::IsExist(uint64_t ino, bool just_cache, bool& is_exist
   return IsExistFromStore(ino, is_exist);
 }
 
+Status FileSessionManager::IsAlive(uint64_t ino, bool& is_alive) {
+  is_alive = false;
+
+  auto file_sessions = file_session_cache_.Get(ino);
+  if (file_sessions.empty() && IsAuthoritative()) return Status::OK();
+
+  const uint64_t now_s = utils::Timestamp();
+  for (const auto& file_session : file_sessions) {
+    if (file_session->expire_time_s() >= now_s) {
+      is_alive = true;
+      return Status::OK();
+    }
+  }
+
+  // cache miss or only expired, check store
+  auto status = IsExistFromStore(ino, is_alive);
+  if (!status.ok()) return status;
+
+  // expired session already cleaned by gc
+  if (!is_alive) {
+    for (const auto& file_session : file_sessions) file_session_cache_.Delete(ino, file_session->session_id());
+  }
+
+  return Status::OK();
+}
+
+void FileSessionManager::KeepAlive(uint64_t ino, const std::vector<std::string>& session_ids) {
+  const uint64_t expire_time_s = utils::Timestamp() + FLAGS_mds_filesession_live_time_s;
+  for (const auto& session_id : session_ids) {
+    auto file_session = file_session_cache_.Get(ino, session_id);
+    if (file_session == nullptr) continue;
+
+    // copy on write, entry is shared with reader
+    auto new_file_session = std::make_shared<FileSessionEntry>(*file_session);
+    new_file_session->set_expire_time_s(expire_time_s);
+    file_session_cache_.Upsert(new_file_session);
+  }
+}
+
+Status FileSessionManager::Load() {
+  std::vector<FileSessionEntry> file_sessions;
+  auto status = GetAll(file_sessions);
+  if (!status.ok()) return status;
+
+  for (auto& file_session : file_sessions) {
+    file_session_cache_.Upsert(std::make_shared<FileSessionEntry>(std::move(file_session)));
+  }
+
+  is_authoritative_.store(true, std::memory_order_release);
+
+  LOG(INFO) << fmt::format("[filesession.{}] load file session finish, count({}).", fs_id_, file_sessions.size());
+
+  return Status::OK();
+}
+
 Status FileSessionManager::Delete(uint64_t ino, const std::string& session_id) {
   // delete cache
   file_session_cache_.Delete(ino, session_id);
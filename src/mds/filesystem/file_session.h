@@ -15,6 +15,7 @@
 #ifndef DINGOFS_MDS_FILESYSTEM_FILE_SESSION_H_
 #define DINGOFS_MDS_FILESYSTEM_FILE_SESSION_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -95,6 +96,8 @@ class FileSessionManager {
   FileSessionSPtr Create(uint64_t ino, const std::string& client_id, const std::string& session_id) const;
   bool Put(FileSessionSPtr file_session);
   Status IsExist(uint64_t ino, bool just_cache, bool& is_exist);
+  // check alive file session, trust cache when it is authoritative
+  Status IsAlive(uint64_t ino, bool& is_alive);
   Status Delete(uint64_t ino, const std::string& session_id);
   Status Delete(uint64_t ino);
 
@@ -102,6 +105,15 @@ class FileSessionManager {
   std::vector<FileSessionSPtr> Get(uint64_t ino, bool just_cache = false);
   Status GetAll(std::vector<FileSessionEntry>& file_sessions);
 
+  // refresh cache expire time after keepalive
+  void KeepAlive(uint64_t ino, const std::vector<std::string>& session_ids);
+
+  // load all file session from store, then cache is authoritative,
+  // only for owner mds of mono partition fs which open all its files.
+  Status Load();
+  void ResetAuthoritative() { is_authoritative_.store(false, std::memory_order_release); }
+  bool IsAuthoritative() const { return is_authoritative_.load(std::memory_order_acquire); }
+
   FileSessionCache& GetFileSessionCache() { return file_session_cache_; }
 
   void Summary(Json::Value& value) { file_session_cache_.Summary(value); }
@@ -115,6 +127,8 @@ class FileSessionManager {
 
   // cache file session
   FileSessionCache file_session_cache_;
+  // cache hold all file session of fs
+  std::atomic<bool> is_authoritative_{false};
 
   OperationProcessorSPtr operation_processor_;
 };
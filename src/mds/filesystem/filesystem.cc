@@ -23,12 +23,14 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "brpc/reloadable_flags.h"
 #include "butil/status.h"
 #include "common/const.h"
@@ -42,6 +44,7 @@
 #include "glog/logging.h"
 #include "json/value.h"
 #include "mds/common/codec.h"
+#include "mds/common/event_log.h"
 #include "mds/common/helper.h"
 #include "mds/common/partition_helper.h"
 #include "mds/common/status.h"
@@ -72,6 +75,14 @@ DEFINE_uint32(mds_filesystem_name_max_size, 1024, "Max size of filesystem name."
 DEFINE_validator(mds_filesystem_name_max_size, brpc::PassValidate);
 DEFINE_uint32(mds_filesystem_hash_bucket_num, 1024, "Filesystem hash bucket num.");
 DEFINE_validator(mds_filesystem_hash_bucket_num, brpc::PassValidate);
+DEFINE_bool(mds_filesystem_ino_affinity_enable, false,
+            "Allocate file ino in parent bucket for hash partition fs created later.");
+DEFINE_validator(mds_filesystem_ino_affinity_enable, brpc::PassValidate);
+DEFINE_uint32(mds_filesystem_ino_affinity_batch, 4, "File ino number per bucket of one affinity refill.");
+DEFINE_uint32(mds_filesystem_ino_affinity_max_cached, 256, "Max cached file ino per bucket for affinity.");
+DEFINE_uint32(mds_filesystem_handoff_inode_max_num, 65536,
+             "Max cached inode num handed off to new owner mds when bucket moved, 0 means disable.");
+DEFINE_validator(mds_filesystem_handoff_inode_max_num, brpc::PassValidate);
 DEFINE_uint32(mds_filesystem_hash_mds_num_default, 3, "Filesystem hash mds num.");
 DEFINE_validator(mds_filesystem_hash_mds_num_default, brpc::PassValidate);
 DEFINE_uint32(mds_filesystem_recycle_time_hour, 1, "Filesystem recycle time hour.");
@@ -93,9 +104,9 @@ DEFINE_validator(mds_prefetch_chunk_num, brpc::PassValidate);
 DEFINE_uint32(mds_cache_expire_interval_s, 7200, "Cache expire interval in seconds.");
 DEFINE_validator(mds_cache_expire_interval_s, brpc::PassValidate);
 
-DEFINE_string(mds_storage_engine, "dummy", "mds storage engine, e.g dingo-store|tikv|dummy");
+DEFINE_string(mds_storage_engine, "dummy", "mds storage engine, e.g dingo-store|tikv|memory|dummy");
 DEFINE_validator(mds_storage_engine, [](const char*, const std::string& value) -> bool {
-  return value == "dingo-store" || value == "tikv" || value == "dummy";
+  return value == "dingo-store" || value == "tikv" || value == "memory" || value == "dummy";
 });
 
 DEFINE_string(mds_id_generator_type, "coor", "id generator type, e.g coor|store");
@@ -123,6 +134,13 @@ static bool IsTinyFile(const std::string& name) {
   return g_suffix_set.HasSuffix(name);
 }
 
+// bucket num of parent hash partition, 0 means not hash partition
+static uint32_t GetHashBucketNum(const PartitionPolicy& partition_policy) {
+  return partition_policy.type() == pb::mds::PartitionType::PARENT_ID_HASH_PARTITION
+             ? partition_policy.parent_hash().bucket_num()
+             : 0;
+}
+
 FileSystem::FileSystem(uint64_t self_mds_id, FsInfoSPtr fs_info, IdGeneratorUPtr ino_id_generator,
                        IdGeneratorSPtr slice_id_generator, KVStorageSPtr kv_storage,
                        OperationProcessorSPtr operation_processor, MDSMetaMapSPtr mds_meta_map,
@@ -133,6 +151,8 @@ FileSystem::FileSystem(uint64_t self_mds_id, FsInfoSPtr fs_info, IdGeneratorUPtr
       inode_cache_(fs_id_),
       partition_cache_(fs_id_),
       ino_id_generator_(std::move(ino_id_generator)),
+      affinity_ino_allocator_(*ino_id_generator_, FLAGS_mds_filesystem_ino_affinity_batch,
+                              FLAGS_mds_filesystem_ino_affinity_max_cached),
       slice_id_generator_(slice_id_generator),
       kv_storage_(kv_storage),
       operation_processor_(operation_processor),
@@ -140,9 +160,15 @@ FileSystem::FileSystem(uint64_t self_mds_id, FsInfoSPtr fs_info, IdGeneratorUPtr
       parent_memo_(fs_id_),
       chunk_cache_(fs_id_),
       quota_manager_(fs_info, parent_memo_, operation_processor, quota_worker_set, notify_buddy),
+      client_notifier_(fs_id_, operation_processor),
+      dentry_lease_manager_(fs_id_, client_notifier_),
+      attr_lease_manager_(fs_id_, client_notifier_),
       notify_buddy_(notify_buddy),
-      file_session_manager_(fs_id_, operation_processor) {
+      file_session_manager_(fs_id_, operation_processor),
+      follower_manager_(fs_id_),
+      bucket_load_recorder_(GetHashBucketNum(fs_info_->GetPartitionPolicy())) {
   can_serve_ = CanServe(self_mds_id);
+  bucket_load_recorder_.SetInoAffinity(IsInoAffinity());
 };
 
 FileSystem::~FileSystem() {
@@ -150,6 +176,11 @@ FileSystem::~FileSystem() {
   quota_manager_.Destroy();
 
   renamer_.Destroy();
+
+  dentry_lease_manager_.Destroy();
+  attr_lease_manager_.Destroy();
+
+  client_notifier_.Destroy();
 }
 
 FileSystemSPtr FileSystem::GetSelfPtr() { return std::dynamic_pointer_cast<FileSystem>(shared_from_this()); }
@@ -170,9 +201,32 @@ bool FileSystem::Init() {
     return false;
   }
 
+  if (!client_notifier_.Init()) {
+    LOG(ERROR) << fmt::format("[fs.{}] init client notifier fail.", fs_id_);
+    return false;
+  }
+
+  RefreshFileSessionAuthority();
+
   return true;
 }
 
+void FileSystem::RefreshFileSessionAuthority() {
+  bool should_authoritative = can_serve_.load(std::memory_order_acquire) && IsMonoPartition();
+  if (!should_authoritative) {
+    file_session_manager_.ResetAuthoritative();
+    return;
+  }
+
+  if (file_session_manager_.IsAuthoritative()) return;
+
+  // fail is fine, fallback to check store
+  auto status = file_session_manager_.Load();
+  if (!status.ok()) {
+    LOG(WARNING) << fmt::format("[fs.{}] load file session fail, status({}).", fs_id_, status.error_str());
+  }
+}
+
 uint64_t FileSystem::Epoch() const {
   auto partition_policy = fs_info_->GetPartitionPolicy();
   return partition_policy.epoch();
@@ -186,6 +240,9 @@ bool FileSystem::IsMonoPartition() const {
 bool FileSystem::IsParentHashPartition() const {
   return fs_info_->GetPartitionType() == pb::mds::PartitionType::PARENT_ID_HASH_PARTITION;
 }
+bool FileSystem::IsInoAffinity() const {
+  return IsParentHashPartition() && fs_info_->GetPartitionPolicy().parent_hash().ino_affinity();
+}
 
 bool FileSystem::CanServe(Context& ctx) {
   if (ctx.IsBypassCache()) {
@@ -195,6 +252,53 @@ bool FileSystem::CanServe(Context& ctx) {
   return can_serve_.load(std::memory_order_acquire);
 };
 
+bool FileSystem::CanServeRead(Context& ctx) {
+  if (CanServe(ctx)) return true;
+
+  if (!ctx.IsFollowerRead() || !FLAGS_mds_follower_read_enable) return false;
+
+  RenewFollow();
+
+  return true;
+}
+
+bool FileSystem::IsOwner(Ino ino) {
+  if (!can_serve_.load(std::memory_order_acquire)) return false;
+  if (IsMonoPartition()) return true;
+
+  return GetMdsIdByIno(ino) == self_mds_id_;
+}
+
+bool FileSystem::IsFollowerRead(Context& ctx, Ino ino) { return ctx.IsFollowerRead() && !IsOwner(ino); }
+
+bool FileSystem::IsFollowerStale(Context& ctx, Ino ino, uint64_t verify_time_ms) {
+  if (!IsFollowerRead(ctx, ino)) return false;
+
+  return verify_time_ms + FollowerManager::StalenessMs(ctx.MaxStalenessMs()) < utils::TimestampMs();
+}
+
+// subscribe change from owner, so cache is refreshed before staleness bound mostly
+void FileSystem::RenewFollow() {
+  if (notify_buddy_ == nullptr || !follower_manager_.ShouldRenew()) return;
+
+  std::vector<uint64_t> mds_ids;
+  auto partition_policy = fs_info_->GetPartitionPolicy();
+  if (partition_policy.type() == pb::mds::PartitionType::MONOLITHIC_PARTITION) {
+    mds_ids.push_back(partition_policy.mono().mds_id());
+
+  } else if (partition_policy.type() == pb::mds::PartitionType::PARENT_ID_HASH_PARTITION) {
+    for (const auto& [mds_id, _] : partition_policy.parent_hash().distributions()) {
+      mds_ids.push_back(mds_id);
+    }
+  }
+
+  for (auto mds_id : mds_ids) {
+    if (mds_id == 0 || mds_id == self_mds_id_) continue;
+
+    notify_buddy_->AsyncNotify(notify::FollowFsMessage::Create(mds_id, fs_id_, self_mds_id_));
+  }
+}
+
 // odd number is dir inode
 Status FileSystem::GenDirIno(Ino& ino) {
   bool ret = ino_id_generator_->GenID(2, ino);
@@ -204,7 +308,17 @@ Status FileSystem::GenDirIno(Ino& ino) {
 }
 
 // even number is file inode
-Status FileSystem::GenFileIno(Ino& ino) {
+// under parent hash partition with ino affinity, file ino has same affinity bucket as parent,
+// client route it by (ino >> 1) % bucket_num when parent is unknown.
+Status FileSystem::GenFileIno(Ino parent, Ino& ino) {
+  if (IsInoAffinity()) {
+    const uint32_t bucket_num = fs_info_->GetPartitionPolicy().parent_hash().bucket_num();
+    if (bucket_num > 0) {
+      bool ret = affinity_ino_allocator_.GenFileIno(bucket_num, parent % bucket_num, ino);
+      return ret ? Status::OK() : Status(pb::error::EALLOC_ID, "generate inode id fail");
+    }
+  }
+
   bool ret = ino_id_generator_->GenID(2, ino);
   ino = (ino & 1) ? (ino + 1) : ino;  // ensure even number for file inode
 
@@ -234,30 +348,30 @@ Status FileSystem::GetPartitionParentInode(Context& ctx, PartitionPtr& partition
 }
 
 void FileSystem::AddDentryToPartition(Ino parent, const Dentry& dentry, uint64_t version) {
-  auto partition = GetPartitionFromCache(parent);
-  if (partition != nullptr) {
-    partition->Put(dentry, version);
-  } else {
-    LOG(WARNING) << fmt::format("partition({}) not exist in cache.", parent);
-  }
+  UpdatePartition(parent, version, {}, {dentry});
 }
 
 void FileSystem::DeleteDentryFromPartition(Ino parent, const std::string& name, uint64_t version) {
-  auto partition = GetPartitionFromCache(parent);
-  if (partition != nullptr) {
-    partition->Delete(name, version);
-  } else {
-    LOG(WARNING) << fmt::format("partition({}) not exist in cache.", parent);
-  }
+  UpdatePartition(parent, version, {name}, {});
 }
 
 void FileSystem::DeleteDentryFromPartition(Ino parent, const std::vector<std::string>& names, uint64_t version) {
+  UpdatePartition(parent, version, names, {});
+}
+
+// apply dentry change of one mutation, deleted names before put dentries, and
+// push the change to followers as one message
+void FileSystem::UpdatePartition(Ino parent, uint64_t version, const std::vector<std::string>& deleted_names,
+                                 const std::vector<Dentry>& dentries) {
   auto partition = GetPartitionFromCache(parent);
   if (partition != nullptr) {
-    partition->Delete(names, version);
+    if (!deleted_names.empty()) partition->Delete(deleted_names, version);
+    for (const auto& dentry : dentries) partition->Put(dentry, version);
   } else {
     LOG(WARNING) << fmt::format("partition({}) not exist in cache.", parent);
   }
+
+  NotifyFollowerUpdateDentry(parent, version, deleted_names, dentries);
 }
 
 Status FileSystem::GetPartition(Context& ctx, Ino parent, PartitionPtr& out_partition) {
@@ -272,6 +386,7 @@ Status FileSystem::GetPartition(Context& ctx, Ino parent, PartitionPtr& out_part
 
 Status FileSystem::GetPartition(Context& ctx, uint64_t version, Ino parent, PartitionPtr& out_partition) {
   auto& trace = ctx.GetTrace();
+  bucket_load_recorder_.RecordParent(parent);
   const bool bypass_cache = ctx.IsBypassCache();
   const bool use_base_version = ctx.UseBaseVersion();
 
@@ -305,6 +420,15 @@ Status FileSystem::GetPartition(Context& ctx, uint64_t version, Ino parent, Part
     return status;
   }
 
+  if (IsFollowerStale(ctx, parent, partition->VerifyTimeMs())) {
+    auto status = GetPartitionFromStore(ctx, parent, "FollowerStale", out_partition);
+    if (!status.ok()) {
+      return Status(status.error_code(), fmt::format("not found partition({}), {}.", parent, status.error_str()));
+    }
+
+    return status;
+  }
+
   trace.SetHitPartition();
   out_partition = partition;
 
@@ -344,6 +468,7 @@ Status FileSystem::GetPartitionFromStore(Context& ctx, Ino parent, const std::st
 
   auto old_partition = partition_cache_.Get(parent);
   if (old_partition != nullptr && parent_inode->Version() <= old_partition->BaseVersion()) {
+    old_partition->UpdateVerifyTime();
     out_partition = old_partition;
     LOG(INFO) << fmt::format("[fs.{}.{}.{}.{}] exist fresh partition, version({}:{}) reason({}).", fs_id_, parent,
                              method_name, request_id, old_partition->BaseVersion(), parent_inode->Version(), reason);
@@ -407,6 +532,8 @@ Status FileSystem::GetInode(Context& ctx, uint64_t version, const Dentry& dentry
                             InodeSPtr& out_inode) {
   auto& trace = ctx.GetTrace();
   const bool bypass_cache = ctx.IsBypassCache();
+  // lookup under parent, routed by parent
+  bucket_load_recorder_.RecordParent(dentry.ParentIno());
 
   bool is_fetch = false;
   Status status;
@@ -433,6 +560,12 @@ Status FileSystem::GetInode(Context& ctx, uint64_t version, const Dentry& dentry
       break;
     }
 
+    if (IsFollowerStale(ctx, dentry.INo(), inode->VerifyTimeMs())) {
+      status = GetInodeFromStore(ctx, dentry.INo(), "FollowerStale", true, out_inode);
+      is_fetch = true;
+      break;
+    }
+
     out_inode = inode;
     trace.SetHitInode();
 
@@ -450,6 +583,14 @@ Status FileSystem::GetInode(Context& ctx, Ino ino, InodeSPtr& out_inode) {
 }
 
 Status FileSystem::GetInode(Context& ctx, uint64_t version, Ino ino, InodeSPtr& out_inode) {
+  auto status = GetInodeImpl(ctx, version, ino, out_inode);
+  // parent of file ino is known after get
+  RecordInoLoad(ino, status.ok() ? out_inode : nullptr);
+
+  return status;
+}
+
+Status FileSystem::GetInodeImpl(Context& ctx, uint64_t version, Ino ino, InodeSPtr& out_inode) {
   auto& trace = ctx.GetTrace();
   const bool bypass_cache = ctx.IsBypassCache();
 
@@ -466,6 +607,10 @@ Status FileSystem::GetInode(Context& ctx, uint64_t version, Ino ino, InodeSPtr&
     return GetInodeFromStore(ctx, ino, "OutOfDate", true, out_inode);
   }
 
+  if (IsFollowerStale(ctx, ino, inode->VerifyTimeMs())) {
+    return GetInodeFromStore(ctx, ino, "FollowerStale", true, out_inode);
+  }
+
   out_inode = inode;
   trace.SetHitInode();
 
@@ -537,10 +682,18 @@ void FileSystem::UpsertInodeCache(Ino ino, InodeSPtr inode) { inode_cache_.PutIf
 
 void FileSystem::UpsertInodeCache(InodeSPtr inode) { inode_cache_.PutIf(inode->Ino(), inode); }
 
-void FileSystem::UpsertInodeCache(const AttrEntry& attr) { inode_cache_.PutIf(attr); }
+void FileSystem::UpsertInodeCache(const AttrEntry& attr) {
+  inode_cache_.PutIf(attr);
+
+  NotifyFollowerRefreshInode(attr);
+}
 
 void FileSystem::DeleteInodeFromCache(Ino ino) { inode_cache_.Delete(ino); }
 
+void FileSystem::RecordInoLoad(Ino ino, const InodeSPtr& inode) {
+  bucket_load_recorder_.RecordIno(ino, inode != nullptr ? inode->FirstParent() : 0);
+}
+
 void FileSystem::ClearCache() {
   ClearPartitionCache();
   ClearInodeCache();
@@ -646,7 +799,7 @@ Status FileSystem::CreateQuota() {
 }
 
 Status FileSystem::Lookup(Context& ctx, Ino parent, const std::string& name, EntryOut& entry_out) {
-  if (!CanServe(ctx)) {
+  if (!CanServeRead(ctx)) {
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
@@ -658,6 +811,10 @@ Status FileSystem::Lookup(Context& ctx, Ino parent, const std::string& name, Ent
     return status;
   }
 
+  // grant lease before read dentry, so change after this will revoke it,
+  // negative entry is also covered by the lease. follower can't revoke it, so not grant.
+  if (!IsFollowerRead(ctx, parent)) entry_out.dentry_lease_ms = dentry_lease_manager_.Grant(parent, ctx.ClientId());
+
   Dentry dentry;
   if (!partition->Get(name, dentry)) {
     return Status(pb::error::ENOT_FOUND, fmt::format("dentry({}) not found.", name));
@@ -666,6 +823,7 @@ Status FileSystem::Lookup(Context& ctx, Ino parent, const std::string& name, Ent
   InodeSPtr inode;
   status = GetInode(ctx, 0, dentry, partition, inode);
   if (!status.ok()) {
+    entry_out.dentry_lease_ms = 0;
     return status;
   }
 
@@ -741,7 +899,7 @@ Status FileSystem::BatchCreate(Context& ctx, Ino parent, const std::vector<MkNod
     }
 
     Ino ino = 0;
-    auto status = GenFileIno(ino);
+    auto status = GenFileIno(param.parent, ino);
     if (!status.ok()) return status;
 
     Inode::AttrEntry attr;
@@ -797,6 +955,9 @@ Status FileSystem::BatchCreate(Context& ctx, Ino parent, const std::vector<MkNod
   }
   UpsertInodeCache(parent_attr);
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("create.{}.{}", parent, names);
   quota_manager_.UpdateFsUsage(0, params.size(), reason);
@@ -840,7 +1001,7 @@ Status FileSystem::MkNod(Context& ctx, const MkNodParam& param, EntryOut& entry_
 
   // generate inode id
   Ino ino = 0;
-  auto status = GenFileIno(ino);
+  auto status = GenFileIno(param.parent, ino);
   if (!status.ok()) return status;
   trace.RecordElapsedTime("gen_ino");
 
@@ -893,6 +1054,9 @@ Status FileSystem::MkNod(Context& ctx, const MkNodParam& param, EntryOut& entry_
   UpsertInodeCache(parent_attr);
   AddDentryToPartition(parent, dentry, parent_attr.version());
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(param.parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("mknod.{}.{}", parent, param.name);
   quota_manager_.UpdateFsUsage(0, 1, reason);
@@ -953,7 +1117,7 @@ Status FileSystem::BatchMkNod(Context& ctx, const std::vector<MkNodParam>& param
 
     // generate inode id
     Ino ino = 0;
-    auto status = GenFileIno(ino);
+    auto status = GenFileIno(parent, ino);
     if (!status.ok()) return status;
 
     // build inode
@@ -998,7 +1162,10 @@ Status FileSystem::BatchMkNod(Context& ctx, const std::vector<MkNodParam>& param
   // update cache
   UpsertInodeCache(parent_attr);
   for (auto& inode : inodes) UpsertInodeCache(inode->Ino(), inode);
-  for (const auto& dentry : dentries) AddDentryToPartition(parent, dentry, parent_attr.version());
+  UpdatePartition(parent, parent_attr.version(), {}, dentries);
+
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(parent, ctx.ClientId());
 
   // update quota
   std::string reason = fmt::format("batchmknod.{}.{}", parent, join_name);
@@ -1059,6 +1226,14 @@ Status FileSystem::Open(Context& ctx, Ino ino, const OpenParam& param, EntryOut&
 
   utils::Duration duration;
 
+  // recall conflict attr lease held by other clients, write delegation holder
+  // write back its dirty attr, then grant new lease before open.
+  const bool is_write = (flags & O_WRONLY) || (flags & O_RDWR);
+  attr_lease_manager_.Recall(ino, client_id, !is_write);
+  if (is_write) attr_lease_manager_.MarkWrite(ino, client_id);
+  entry_out.attr_lease =
+      attr_lease_manager_.Grant(ino, client_id, is_write ? pb::mds::ATTR_LEASE_WRITE : pb::mds::ATTR_LEASE_READ);
+
   InodeSPtr inode;
   auto status = GetInode(ctx, ino, inode);
   if (!status.ok()) return status;
@@ -1307,6 +1482,12 @@ void FileSystem::AsyncKeepAliveFileSession(const std::vector<FileSessionParam>&
         auto status = param->filesystem.RunOperation(&operation);
         LOG(INFO) << fmt::format("[meta.fs.{}] keep alive file session finish, ino({}), status({}).", fs_id, ino_str,
                                  status.error_str());
+        if (status.ok()) {
+          auto& file_session_manager = param->filesystem.GetFileSessionManager();
+          for (const auto& op_file_session : op_param.file_sessions) {
+            file_session_manager.KeepAlive(op_file_session.ino, op_file_session.session_ids);
+          }
+        }
 
         return nullptr;
       },
@@ -1396,6 +1577,9 @@ Status FileSystem::MkDir(Context& ctx, const MkDirParam& param, EntryOut& entry_
     partition_cache_.PutIf(Partition(inode));
   }
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(param.parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("mkdir.{}.{}", parent, param.name);
   quota_manager_.UpdateFsUsage(0, 1, reason);
@@ -1501,12 +1685,15 @@ Status FileSystem::BatchMkDir(Context& ctx, const std::vector<MkDirParam>& param
   // update cache
   UpsertInodeCache(parent_attr);
   for (auto& inode : inodes) UpsertInodeCache(inode->Ino(), inode);
-  for (auto& dentry : dentries) AddDentryToPartition(parent, dentry, parent_attr.version());
+  UpdatePartition(parent, parent_attr.version(), {}, dentries);
 
   if (IsMonoPartition()) {
     for (auto& inode : inodes) partition_cache_.PutIf(Partition(inode));
   }
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("batchmkdir.{}.{}", parent, join_name);
   quota_manager_.UpdateFsUsage(0, params.size(), reason);
@@ -1573,6 +1760,9 @@ Status FileSystem::RmDir(Context& ctx, Ino parent, const std::string& name, Ino&
   UpsertInodeCache(parent_attr);
   DeleteDentryFromPartition(parent, name, parent_attr.version());
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("rmdir.{}.{}", parent, name);
   quota_manager_.UpdateFsUsage(0, -1, reason);
@@ -1593,7 +1783,7 @@ Status FileSystem::RmDir(Context& ctx, Ino parent, const std::string& name, Ino&
 
 Status FileSystem::ReadDir(Context& ctx, Ino ino, const std::string& last_name, uint32_t limit, bool with_attr,
                            std::vector<EntryOut>& entry_outs) {
-  if (!CanServe(ctx)) {
+  if (!CanServeRead(ctx)) {
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
@@ -1627,6 +1817,49 @@ Status FileSystem::ReadDir(Context& ctx, Ino ino, const std::string& last_name,
   return Status::OK();
 }
 
+Status FileSystem::ReadDirSince(Context& ctx, Ino ino, const Partition::Cursor& cursor, uint32_t limit,
+                                bool with_attr, bool& is_complete, Partition::Cursor& cur_cursor,
+                                std::vector<DentryDeltaOut>& delta_outs) {
+  if (!CanServe(ctx)) {
+    return Status(pb::error::ENOT_SERVE, "can not serve");
+  }
+
+  PartitionPtr partition;
+  auto status = GetPartition(ctx, ino, partition);
+  if (!status.ok()) {
+    return status;
+  }
+
+  std::vector<Partition::DentryDelta> deltas;
+  is_complete = partition->ScanDelta(cursor, limit, deltas, cur_cursor);
+  if (!is_complete) return Status::OK();
+
+  delta_outs.reserve(deltas.size());
+  for (auto& delta : deltas) {
+    const auto& dentry = delta.dentry;
+
+    DentryDeltaOut delta_out;
+    delta_out.is_delete = (delta.op_type == Partition::DentryOpType::DELETE);
+    delta_out.entry.name = dentry.Name();
+    delta_out.entry.attr.set_ino(dentry.INo());
+
+    if (with_attr && !delta_out.is_delete) {
+      // inode may be deleted by later op, the DELETE op will follow
+      InodeSPtr inode;
+      status = GetInode(ctx, 0, dentry, partition, inode);
+      if (status.ok()) {
+        delta_out.entry.attr = inode->Copy();
+      } else if (status.error_code() != pb::error::ENOT_FOUND) {
+        return status;
+      }
+    }
+
+    delta_outs.push_back(std::move(delta_out));
+  }
+
+  return Status::OK();
+}
+
 // create hard link for file
 // 1. create dentry and update parent inode(nlink/mtime/ctime)
 // 2. update inode(mtime/ctime/nlink)
@@ -1672,6 +1905,10 @@ Status FileSystem::Link(Context& ctx, Ino ino, Ino new_parent, const std::string
   auto& parent_attr = result.attr;
   auto& attr = result.child_attr;
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(new_parent, ctx.ClientId());
+  attr_lease_manager_.Recall(attr.ino(), ctx.ClientId(), false);
+
   // update quota
   std::string reason = fmt::format("link.{}.{}.{}", ino, new_parent, new_name);
   quota_manager_.AsyncUpdateDirUsage(new_parent, attr.length(), 1, reason);
@@ -1733,6 +1970,10 @@ Status FileSystem::UnLink(Context& ctx, Ino parent, const std::string& name, Ent
 
   if (!status.ok()) return status;
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(parent, ctx.ClientId());
+  attr_lease_manager_.Recall(attr.ino(), ctx.ClientId(), false);
+
   // update quota
   std::string reason = fmt::format("unlink.{}.{}", parent, name);
   int64_t delta_bytes = attr.type() != pb::mds::SYM_LINK ? attr.length() : 0;
@@ -1807,6 +2048,9 @@ Status FileSystem::BatchUnLink(Context& ctx, Ino parent, const std::vector<std::
 
   if (!status.ok()) return status;
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("batchunlink.{}.{}", parent, join_name);
   for (const auto& attr : child_attrs) {
@@ -1854,7 +2098,7 @@ Status FileSystem::Symlink(Context& ctx, const std::string& symlink, Ino new_par
 
   // generate inode id
   Ino ino = 0;
-  auto status = GenFileIno(ino);
+  auto status = GenFileIno(new_parent, ino);
   if (!status.ok()) return status;
   trace.RecordElapsedTime("gen_ino");
 
@@ -1908,6 +2152,9 @@ Status FileSystem::Symlink(Context& ctx, const std::string& symlink, Ino new_par
   UpsertInodeCache(parent_attr);
   AddDentryToPartition(parent_attr.ino(), dentry, parent_attr.version());
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(new_parent, ctx.ClientId());
+
   // update quota
   std::string reason = fmt::format("symlink.{}.{}", new_parent, new_name);
   quota_manager_.UpdateFsUsage(0, 1, reason);
@@ -1944,10 +2191,15 @@ Status FileSystem::ReadLink(Context& ctx, Ino ino, std::string& link) {
 }
 
 Status FileSystem::GetAttr(Context& ctx, Ino ino, EntryOut& entry_out) {
-  if (!CanServe(ctx)) {
+  if (!CanServeRead(ctx)) {
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
+  // attr lease is managed by owner, not granted when conflict with writer
+  if (!IsDir(ino) && !IsFollowerRead(ctx, ino)) {
+    entry_out.attr_lease = attr_lease_manager_.Grant(ino, ctx.ClientId(), pb::mds::ATTR_LEASE_READ);
+  }
+
   InodeSPtr inode;
   auto status = GetInode(ctx, ino, inode);
   if (!status.ok()) {
@@ -1964,6 +2216,8 @@ Status FileSystem::SetAttr(Context& ctx, Ino ino, const SetAttrParam& param, Ent
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
+  if (!IsDir(ino)) attr_lease_manager_.Recall(ino, ctx.ClientId(), false);
+
   auto& trace = ctx.GetTrace();
 
   utils::Duration duration;
@@ -2069,6 +2323,8 @@ Status FileSystem::SetXAttr(Context& ctx, Ino ino, const Inode::XAttrMap& xattrs
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
+  if (!IsDir(ino)) attr_lease_manager_.Recall(ino, ctx.ClientId(), false);
+
   auto& trace = ctx.GetTrace();
 
   InodeSPtr inode;
@@ -2108,6 +2364,8 @@ Status FileSystem::RemoveXAttr(Context& ctx, Ino ino, const std::string& name, E
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
+  if (!IsDir(ino)) attr_lease_manager_.Recall(ino, ctx.ClientId(), false);
+
   auto& trace = ctx.GetTrace();
 
   InodeSPtr inode;
@@ -2181,6 +2439,34 @@ void FileSystem::NotifyBuddyRefreshInode(AttrEntry&& attr) {
   }
 }
 
+void FileSystem::NotifyFollowerRefreshInode(const AttrEntry& attr) {
+  if (notify_buddy_ == nullptr || !follower_manager_.HasFollower()) return;
+
+  for (auto mds_id : follower_manager_.GetFollowers()) {
+    if (mds_id == self_mds_id_) continue;
+
+    notify_buddy_->AsyncNotify(notify::RefreshInodeMessage::Create(mds_id, fs_id_, AttrEntry(attr)));
+  }
+}
+
+void FileSystem::NotifyFollowerUpdateDentry(Ino parent, uint64_t version,
+                                            const std::vector<std::string>& deleted_names,
+                                            const std::vector<Dentry>& dentries) {
+  if (notify_buddy_ == nullptr || !follower_manager_.HasFollower()) return;
+
+  std::vector<DentryEntry> dentry_entries;
+  dentry_entries.reserve(dentries.size());
+  for (const auto& dentry : dentries) dentry_entries.push_back(dentry.Copy());
+
+  for (auto mds_id : follower_manager_.GetFollowers()) {
+    if (mds_id == self_mds_id_) continue;
+
+    notify_buddy_->AsyncNotify(notify::UpdateDentryMessage::Create(
+        mds_id, fs_id_, parent, version, std::vector<std::string>(deleted_names),
+        std::vector<DentryEntry>(dentry_entries)));
+  }
+}
+
 void FileSystem::NotifyBuddyCleanPartitionCache(Ino ino) {
   if (notify_buddy_ == nullptr) return;
 
@@ -2318,11 +2604,8 @@ Status FileSystem::Rename(Context& ctx, const RenameParam& param, uint64_t& old_
     // refresh parent inode and dentry cache
     if (is_same_parent) {
       UpsertInodeCache(old_parent_attr);
-      if (is_exist_new_dentry) {
-        DeleteDentryFromPartition(old_parent, prev_new_dentry.name(), old_parent_attr.version());
-      }
-      AddDentryToPartition(new_parent, new_dentry, old_parent_attr.version());
-      DeleteDentryFromPartition(old_parent, old_dentry.name(), old_parent_attr.version());
+      // prev new dentry has the new name, it is replaced by put
+      UpdatePartition(old_parent, old_parent_attr.version(), {old_dentry.name()}, {new_dentry});
     }
 
     // refresh parent of parent inode cache
@@ -2344,6 +2627,10 @@ Status FileSystem::Rename(Context& ctx, const RenameParam& param, uint64_t& old_
     }
   }
 
+  // revoke dentry lease held by other clients
+  dentry_lease_manager_.Revoke(old_parent, ctx.ClientId());
+  dentry_lease_manager_.Revoke(new_parent, ctx.ClientId());
+
   // update fs quota
   std::string reason = fmt::format("rename.{}.{}.to.{}.{}", old_parent, old_name, new_parent, new_name);
   if (is_exist_new_dentry) {
@@ -2393,6 +2680,9 @@ Status FileSystem::WriteSlice(Context& ctx, Ino, Ino ino, const std::vector<Delt
   auto status = GetInode(ctx, ino, inode);
   if (!status.ok()) return status;
 
+  // length and mtime change, reader should not serve attr from cache
+  attr_lease_manager_.MarkWrite(ino, ctx.ClientId());
+
   auto& trace = ctx.GetTrace();
 
   utils::Duration duration;
@@ -2407,10 +2697,95 @@ Status FileSystem::WriteSlice(Context& ctx, Ino, Ino ino, const std::vector<Delt
   auto& effected_chunks = result.effected_chunks;
 
   for (auto& chunk : effected_chunks) {
-    LOG(INFO) << fmt::format("[fs.{}.{}.{}][{}us] writeslice finish, chunk({},{}).", fs_id_, ino, ctx.RequestId(),
-                             duration.ElapsedUs(), chunk.index(), chunk.version());
+    EVENT_LOG(INFO, "[fs.{}.{}.{}][{}us] writeslice finish, chunk({},{}).", fs_id_, ino, ctx.RequestId(),
+                    duration.ElapsedUs(), chunk.index(), chunk.version());
   }
 
+  BuildWriteSliceResult(ino, delta_slices, effected_chunks, out_chunks);
+
+  return Status::OK();
+}
+
+Status FileSystem::BatchWriteSlice(Context& ctx, std::vector<WriteSliceParam>& params) {
+  if (!CanServe(ctx)) {
+    return Status(pb::error::ENOT_SERVE, "can not serve");
+  }
+
+  utils::Duration duration;
+
+  // every inode has its own transaction, run them concurrently
+  struct Param {
+    FileSystem* self{nullptr};
+    UpsertChunkOperation* operation{nullptr};
+    Status* status{nullptr};
+    bthread::CountdownEvent* count_down{nullptr};
+  };
+
+  bthread::CountdownEvent count_down(params.size());
+  std::vector<Trace> traces(params.size());
+  std::vector<std::unique_ptr<UpsertChunkOperation>> operations(params.size());
+  // result keep default ok when operation is not run, e.g. processor stopping, so use run status
+  std::vector<Status> run_statuses(params.size());
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto& param = params[i];
+
+    InodeSPtr inode;
+    param.status = GetInode(ctx, param.ino, inode);
+    if (!param.status.ok()) {
+      count_down.signal();
+      continue;
+    }
+
+    attr_lease_manager_.MarkWrite(param.ino, ctx.ClientId());
+
+    operations[i] = std::make_unique<UpsertChunkOperation>(traces[i], GetFsInfo(), param.ino, param.delta_slices);
+
+    auto* run_param = new Param{
+        .self = this, .operation = operations[i].get(), .status = &run_statuses[i], .count_down = &count_down};
+    bthread_t tid;
+    bthread_attr_t attr = BTHREAD_ATTR_SMALL;
+    if (bthread_start_background(
+            &tid, &attr,
+            [](void* arg) -> void* {
+              auto* param = reinterpret_cast<Param*>(arg);
+
+              *param->status = param->self->RunOperation(param->operation);
+              param->count_down->signal();
+
+              delete param;
+              return nullptr;
+            },
+            run_param) != 0) {
+      delete run_param;
+      LOG(ERROR) << fmt::format("[fs.{}.{}] start bthread fail.", fs_id_, param.ino);
+      param.status = Status(pb::error::EINTERNAL, "start bthread fail");
+      operations[i] = nullptr;
+      count_down.signal();
+    }
+  }
+
+  CHECK(count_down.wait() == 0) << "count down wait fail.";
+
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto& param = params[i];
+    if (operations[i] == nullptr) continue;
+
+    param.status = run_statuses[i];
+    if (!param.status.ok()) continue;
+
+    auto& result = operations[i]->GetResult();
+
+    BuildWriteSliceResult(param.ino, param.delta_slices, result.effected_chunks, param.out_chunks);
+  }
+
+  EVENT_LOG(INFO, "[fs.{}.{}][{}us] batch writeslice finish, count({}).", fs_id_, ctx.RequestId(),
+                  duration.ElapsedUs(), params.size());
+
+  return Status::OK();
+}
+
+void FileSystem::BuildWriteSliceResult(Ino ino, const std::vector<DeltaSliceEntry>& delta_slices,
+                                       std::vector<ChunkEntry>& effected_chunks, std::vector<ChunkEntry>& out_chunks) {
   auto query_curr_versoin_fn = [&delta_slices](uint32_t index) -> uint64_t {
     for (const auto& slice : delta_slices) {
       if (slice.chunk_index() == index) {
@@ -2439,21 +2814,33 @@ Status FileSystem::WriteSlice(Context& ctx, Ino, Ino ino, const std::vector<Delt
 
     chunk_cache_.PutIf(ino, std::move(chunk));
   }
-
-  return Status::OK();
 }
 
 Status FileSystem::ReadSlice(Context& ctx, Ino ino, const std::vector<ChunkDescriptor>& chunk_descriptors,
-                             std::vector<ChunkEntry>& chunks) {
-  if (!CanServe(ctx)) {
+                             std::vector<ChunkEntry>& chunks, std::vector<uint32_t>* not_modified_indexes) {
+  if (!CanServeRead(ctx)) {
     return Status(pb::error::ENOT_SERVE, "can not serve");
   }
 
+  RecordInoLoad(ino, bucket_load_recorder_.IsParentNeeded(ino) ? GetInodeFromCache(ino) : nullptr);
+
   auto& trace = ctx.GetTrace();
   const bool bypass_cache = ctx.IsBypassCache();
 
   utils::Duration duration;
 
+  // client already has the chunk of this version, no need to return it
+  absl::flat_hash_map<uint32_t, uint64_t> if_modified_versions;
+  auto is_not_modified = [&](const ChunkEntry& chunk) -> bool {
+    if (not_modified_indexes == nullptr) return false;
+
+    auto it = if_modified_versions.find(chunk.index());
+    if (it == if_modified_versions.end() || it->second != chunk.version()) return false;
+
+    not_modified_indexes->push_back(chunk.index());
+    return true;
+  };
+
   // get chunk from cache
   std::string param_desc;
   std::vector<uint32_t> miss_chunk_indexes;
@@ -2462,11 +2849,13 @@ Status FileSystem::ReadSlice(Context& ctx, Ino ino, const std::vector<ChunkDescr
     const uint64_t chunk_version = chunk_descriptor.version();
 
     param_desc += fmt::format("{}:{},", chunk_index, chunk_version);
+    if (chunk_descriptor.if_modified()) if_modified_versions[chunk_index] = chunk_version;
 
     if (!bypass_cache) {
-      auto chunk = chunk_cache_.Get(ino, chunk_index);
-      if (chunk != nullptr && chunk->version() >= chunk_version) {
-        chunks.push_back(*chunk);
+      uint64_t load_time_ms = 0;
+      auto chunk = chunk_cache_.Get(ino, chunk_index, load_time_ms);
+      if (chunk != nullptr && chunk->version() >= chunk_version && !IsFollowerStale(ctx, ino, load_time_ms)) {
+        if (!is_not_modified(*chunk)) chunks.push_back(*chunk);
         continue;
       }
     }
@@ -2483,8 +2872,8 @@ Status FileSystem::ReadSlice(Context& ctx, Ino ino, const std::vector<ChunkDescr
 
   auto status = RunOperation(&operation);
 
-  LOG(INFO) << fmt::format("[fs.{}][{}us] readslice {}/{} finish, miss({}) status({}).", fs_id_, duration.ElapsedUs(),
-                           ino, param_desc, Helper::VectorToString(miss_chunk_indexes), status.error_str());
+  EVENT_LOG(INFO, "[fs.{}][{}us] readslice {}/{} finish, miss({}) status({}).", fs_id_, duration.ElapsedUs(),
+                  ino, param_desc, Helper::VectorToString(miss_chunk_indexes), status.error_str());
 
   if (!status.ok() && status.error_code() != pb::error::ENOT_FOUND) {
     return status;
@@ -2494,7 +2883,7 @@ Status FileSystem::ReadSlice(Context& ctx, Ino ino, const std::vector<ChunkDescr
     auto& result = operation.GetResult();
 
     for (auto& chunk : result.chunks) {
-      chunks.push_back(chunk);
+      if (!is_not_modified(chunk)) chunks.push_back(chunk);
       // update chunk cache
       chunk_cache_.PutIf(ino, std::move(chunk));
     }
@@ -2607,6 +2996,17 @@ Status FileSystem::CompactChunk(Context& ctx, Ino ino, uint32_t index, const Com
   return Status::OK();
 }
 
+Status FileSystem::AddPendingPack(uint64_t pack_id) {
+  Trace trace;
+  AddPendingPackOperation operation(trace, fs_id_, pack_id);
+
+  auto status = RunOperation(&operation);
+
+  LOG(INFO) << fmt::format("[fs.{}] add pending pack({}) finish, status({}).", fs_id_, pack_id, status.error_str());
+
+  return status;
+}
+
 Status FileSystem::GetDentry(Context& ctx, Ino parent, const std::string& name, Dentry& dentry) {
   bool bypass_cache = ctx.IsBypassCache();
   auto& trace = ctx.GetTrace();
@@ -2659,18 +3059,37 @@ Status FileSystem::GetInode(Context& ctx, Ino ino, EntryOut& entry_out) {
 Status FileSystem::BatchGetInode(Context& ctx, const std::vector<uint64_t>& inoes, std::vector<EntryOut>& out_entries) {
   bool bypass_cache = ctx.IsBypassCache();
 
+  // batched getattr of client, grant attr lease as GetAttr
+  absl::flat_hash_map<Ino, AttrLeaseEntry> attr_leases;
+  if (!ctx.ClientId().empty()) {
+    for (auto ino : inoes) {
+      if (IsDir(ino)) continue;
+
+      attr_leases[ino] = attr_lease_manager_.Grant(ino, ctx.ClientId(), pb::mds::ATTR_LEASE_READ);
+    }
+  }
+
+  auto add_entry_func = [&](const InodeSPtr& inode) {
+    EntryOut entry_out;
+    entry_out.attr = inode->Copy();
+    auto it = attr_leases.find(inode->Ino());
+    if (it != attr_leases.end()) entry_out.attr_lease = it->second;
+    out_entries.push_back(std::move(entry_out));
+  };
+
   out_entries.reserve(inoes.size());
   if (!bypass_cache) {
     for (auto ino : inoes) {
-      InodeSPtr inode = GetInodeFromCache(ino);
-      if (inode == nullptr) {
+      InodeSPtr inode;
+      auto status = GetInode(ctx, 0, ino, inode);
+      if (!status.ok()) {
+        if (status.error_code() != pb::error::ENOT_FOUND) return status;
+
         LOG(WARNING) << fmt::format("[fs.{}] not found inode({}).", fs_id_, ino);
         continue;
       }
 
-      EntryOut entry_out;
-      entry_out.attr = inode->Copy();
-      out_entries.push_back(entry_out);
+      add_entry_func(inode);
     }
 
   } else {
@@ -2681,9 +3100,7 @@ Status FileSystem::BatchGetInode(Context& ctx, const std::vector<uint64_t>& inoe
     }
 
     for (auto& inode : inodes) {
-      EntryOut entry_out;
-      entry_out.attr = inode->Copy();
-      out_entries.push_back(entry_out);
+      add_entry_func(inode);
     }
   }
 
@@ -2729,7 +3146,28 @@ Status FileSystem::BatchGetXAttr(Context& ctx, const std::vector<uint64_t>& inoe
   return Status::OK();
 }
 
-void FileSystem::RefreshInode(AttrEntry& attr) { UpsertInodeCache(attr); }
+void FileSystem::RefreshDentry(const pb::mds::NotifyBuddyRequest::UpdateDentry& update_dentry) {
+  const Ino parent = update_dentry.ino();
+  auto partition = partition_cache_.Get(parent);
+  if (partition == nullptr) return;
+
+  std::vector<std::string> deleted_names(update_dentry.deleted_names().begin(), update_dentry.deleted_names().end());
+  std::vector<Dentry> dentries;
+  dentries.reserve(update_dentry.dentries_size());
+  for (const auto& dentry : update_dentry.dentries()) dentries.emplace_back(dentry);
+
+  // change may arrive out of order, drop the partition and load it again
+  if (!partition->ApplyDelta(update_dentry.version(), deleted_names, dentries)) {
+    partition_cache_.Delete(parent);
+  }
+}
+
+void FileSystem::RefreshInode(AttrEntry& attr) {
+  // follower chunk cache may be changed by owner write
+  if (attr.type() == pb::mds::FileType::FILE && !IsOwner(attr.ino())) chunk_cache_.Delete(attr.ino());
+
+  UpsertInodeCache(attr);
+}
 
 Status FileSystem::RefreshFsInfo(const std::string& reason) { return RefreshFsInfo(fs_info_->GetName(), reason); }
 
@@ -2770,6 +3208,39 @@ static std::set<uint32_t> GetDeletedBucketIds(int64_t mds_id, const pb::mds::Has
   return deleted_bucket_ids;
 }
 
+// push cached inode of moved bucket to its new owner, so new owner does not start cold.
+// version is checked by receiver, stale inode is dropped.
+void FileSystem::HandoffInodeCache(const pb::mds::HashPartition& hash, const std::set<uint32_t>& bucket_ids) {
+  if (notify_buddy_ == nullptr || bucket_ids.empty() || FLAGS_mds_filesystem_handoff_inode_max_num == 0) return;
+
+  std::map<uint32_t, uint64_t> bucket_mds_ids;
+  for (const auto& [mds_id, bucketset] : hash.distributions()) {
+    for (const auto& bucket_id : bucketset.bucket_ids()) {
+      if (bucket_ids.count(bucket_id) > 0) bucket_mds_ids[bucket_id] = mds_id;
+    }
+  }
+
+  const bool ino_affinity = hash.ino_affinity();
+  uint32_t count = 0;
+  for (auto& inode : inode_cache_.GetAll()) {
+    if (count >= FLAGS_mds_filesystem_handoff_inode_max_num) break;
+
+    uint32_t bucket_id = 0;
+    if (!BucketLoadRecorder::InoBucketId(inode->Ino(), inode->FirstParent(), hash.bucket_num(), ino_affinity,
+                                         bucket_id)) {
+      continue;
+    }
+
+    auto it = bucket_mds_ids.find(bucket_id);
+    if (it == bucket_mds_ids.end() || it->second == self_mds_id_) continue;
+
+    notify_buddy_->AsyncNotify(notify::RefreshInodeMessage::Create(it->second, fs_id_, inode->Copy()));
+    ++count;
+  }
+
+  LOG(INFO) << fmt::format("[fs.{}] handoff inode cache, bucket({}) inode({}).", fs_id_, bucket_ids.size(), count);
+}
+
 void FileSystem::RefreshFsInfo(const FsInfoEntry& fs_info, const std::string& reason) {
   // clean partition and inode cache
   auto pre_handler = [&](const FsInfoEntry& old_fs_info, const FsInfoEntry& new_fs_info) {
@@ -2786,7 +3257,9 @@ void FileSystem::RefreshFsInfo(const FsInfoEntry& fs_info, const std::string& re
         ClearCache();
 
       } else {
-        BatchDeleteCache(new_hash.bucket_num(), GetDeletedBucketIds(self_mds_id_, old_hash, new_hash));
+        auto deleted_bucket_ids = GetDeletedBucketIds(self_mds_id_, old_hash, new_hash);
+        HandoffInodeCache(new_hash, deleted_bucket_ids);
+        BatchDeleteCache(new_hash.bucket_num(), deleted_bucket_ids);
       }
     }
   };
@@ -2795,6 +3268,9 @@ void FileSystem::RefreshFsInfo(const FsInfoEntry& fs_info, const std::string& re
 
   if (fs_info_->Update(fs_info, pre_handler)) {
     can_serve_.store(CanServe(self_mds_id_), std::memory_order_release);
+    RefreshFileSessionAuthority();
+    bucket_load_recorder_.SetBucketNum(GetHashBucketNum(fs_info.partition_policy()));
+    bucket_load_recorder_.SetInoAffinity(IsInoAffinity());
 
     LOG(INFO) << fmt::format("[fs.{}][{}us] update fs({} v{}) can_serve({}) reason({}).", fs_id_, duration.ElapsedUs(),
                              fs_info.fs_name(), fs_info.version(), can_serve_ ? "true" : "false", reason);
@@ -3156,6 +3632,28 @@ Status FileSystem::UpdatePartitionPolicy(const std::map<uint64_t, BucketSetEntry
   return Status::OK();
 }
 
+bool FileSystem::TakeBucketLoad(BucketLoadEntry& load) {
+  std::map<uint32_t, uint64_t> bucket_ops;
+  uint64_t window_ms = bucket_load_recorder_.Take(bucket_ops);
+  if (!can_serve_.load(std::memory_order_acquire) || !IsParentHashPartition()) return false;
+  if (window_ms == 0) return false;
+
+  // only report owned bucket, other is counted by follower read.
+  // report even if idle, so balancer know the buckets cool down.
+  auto partition_policy = fs_info_->GetPartitionPolicy();
+  auto it = partition_policy.parent_hash().distributions().find(self_mds_id_);
+  if (it == partition_policy.parent_hash().distributions().end()) return false;
+
+  load.set_fs_id(fs_id_);
+  load.set_window_ms(window_ms);
+  for (const auto& bucket_id : it->second.bucket_ids()) {
+    auto ops_it = bucket_ops.find(bucket_id);
+    if (ops_it != bucket_ops.end()) load.mutable_bucket_ops()->insert({bucket_id, ops_it->second});
+  }
+
+  return true;
+}
+
 void FileSystem::CleanExpiredCache() {
   uint64_t now_s = utils::Timestamp();
 
@@ -3163,6 +3661,13 @@ void FileSystem::CleanExpiredCache() {
   partition_cache_.CleanExpired(expired_time);
   inode_cache_.CleanExpired(expired_time);
   chunk_cache_.CleanExpired(expired_time);
+
+  dentry_lease_manager_.CleanExpired();
+  attr_lease_manager_.CleanExpired();
+}
+
+void FileSystem::RevokeDentryLease(Ino parent, const std::string& client_id) {
+  dentry_lease_manager_.Revoke(parent, client_id);
 }
 
 void FileSystem::DescribeByJson(Json::Value& value) {
@@ -3213,6 +3718,18 @@ void FileSystem::Summary(Json::Value& value) {
   parent_memo_.Summary(parent_memo_value);
   fs_value.append(parent_memo_value);
 
+  Json::Value dentry_lease_value = Json::objectValue;
+  dentry_lease_manager_.Summary(dentry_lease_value);
+  fs_value.append(dentry_lease_value);
+
+  Json::Value attr_lease_value = Json::objectValue;
+  attr_lease_manager_.Summary(attr_lease_value);
+  fs_value.append(attr_lease_value);
+
+  Json::Value follower_value = Json::objectValue;
+  follower_manager_.Summary(follower_value);
+  fs_value.append(follower_value);
+
   value["fsid"] = fs_id_;
   value["fs_name"] = fs_info_->GetName();
   value["caches"] = fs_value;
@@ -3341,6 +3858,8 @@ FsInfoEntry FileSystemSet::GenFsInfo(uint32_t fs_id, const CreateFsParam& param)
   } else if (param.partition_type == pb::mds::PartitionType::PARENT_ID_HASH_PARTITION) {
     auto* parent_hash = partition_policy->mutable_parent_hash();
     parent_hash->set_bucket_num(FLAGS_mds_filesystem_hash_bucket_num);
+    // fixed for the fs life, client and mds route file ino by it
+    parent_hash->set_ino_affinity(FLAGS_mds_filesystem_ino_affinity_enable);
     parent_hash->set_expect_mds_num(param.expect_mds_num == 0 ? FLAGS_mds_filesystem_hash_mds_num_default
                                                               : param.expect_mds_num);
 
@@ -29,9 +29,14 @@
 #include "mds/common/context.h"
 #include "mds/common/status.h"
 #include "mds/common/type.h"
+#include "mds/filesystem/attr_lease.h"
+#include "mds/filesystem/bucket_load.h"
 #include "mds/filesystem/chunk_cache.h"
+#include "mds/filesystem/client_notifier.h"
 #include "mds/filesystem/dentry.h"
+#include "mds/filesystem/dentry_lease.h"
 #include "mds/filesystem/file_session.h"
+#include "mds/filesystem/follower.h"
 #include "mds/filesystem/fs_info.h"
 #include "mds/filesystem/id_generator.h"
 #include "mds/filesystem/inode.h"
@@ -68,6 +73,16 @@ struct EntryOut {
   AttrEntry attr;
   std::vector<AttrEntry> attrs;
   bool shrink_file{false};
+  // lease of parent dentries granted to client, 0 means no lease
+  uint64_t dentry_lease_ms{0};
+  // attr lease of inode granted to client
+  AttrLeaseEntry attr_lease;
+};
+
+// dentry change of dir
+struct DentryDeltaOut {
+  bool is_delete{false};
+  EntryOut entry;
 };
 
 class FileSystem : public std::enable_shared_from_this<FileSystem> {
@@ -105,6 +120,8 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   pb::mds::PartitionType PartitionType() const;
   bool IsMonoPartition() const;
   bool IsParentHashPartition() const;
+  // file ino is allocated in its parent bucket
+  bool IsInoAffinity() const;
 
   bool CanServe(Context& ctx);
 
@@ -165,6 +182,10 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   Status RmDir(Context& ctx, Ino parent, const std::string& name, Ino& ino, EntryOut& entry_out);
   Status ReadDir(Context& ctx, Ino ino, const std::string& last_name, uint32_t limit, bool with_attr,
                  std::vector<EntryOut>& entry_outs);
+  // read dentry changes after cursor, is_complete is false when the changes can not be served incrementally,
+  // then client should read the whole dir, cur_cursor is always the latest position.
+  Status ReadDirSince(Context& ctx, Ino ino, const Partition::Cursor& cursor, uint32_t limit, bool with_attr,
+                      bool& is_complete, Partition::Cursor& cur_cursor, std::vector<DentryDeltaOut>& delta_outs);
 
   // create hard link
   Status Link(Context& ctx, Ino ino, Ino new_parent, const std::string& new_name, EntryOut& entry_out);
@@ -210,8 +231,18 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   // slice
   Status WriteSlice(Context& ctx, Ino parent, Ino ino, const std::vector<DeltaSliceEntry>& delta_slices,
                     std::vector<ChunkEntry>& out_chunks);
+  struct WriteSliceParam {
+    Ino ino{0};
+    std::vector<DeltaSliceEntry> delta_slices;
+
+    Status status;
+    std::vector<ChunkEntry> out_chunks;
+  };
+  // write slices of different inodes, every inode has its own status
+  Status BatchWriteSlice(Context& ctx, std::vector<WriteSliceParam>& params);
+  // chunk which descriptor set if_modified and version not changed is put into not_modified_indexes
   Status ReadSlice(Context& ctx, Ino ino, const std::vector<ChunkDescriptor>& chunk_descriptors,
-                   std::vector<ChunkEntry>& chunks);
+                   std::vector<ChunkEntry>& chunks, std::vector<uint32_t>* not_modified_indexes = nullptr);
 
   // fallocate
   Status Fallocate(Context& ctx, Ino ino, int32_t mode, uint64_t offset, uint64_t len, EntryOut& entry_out);
@@ -231,6 +262,9 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   };
   Status CompactChunk(Context& ctx, Ino ino, uint32_t index, const CompactChunkParam& param, ChunkEntry& chunk_out);
 
+  // pack id is allocated by client
+  Status AddPendingPack(uint64_t pack_id);
+
   // dentry/inode
   Status GetDentry(Context& ctx, Ino parent, const std::string& name, Dentry& dentry);
   Status ListDentry(Context& ctx, Ino parent, const std::string& last_name, uint32_t limit, bool is_only_dir,
@@ -240,6 +274,8 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   Status BatchGetXAttr(Context& ctx, const std::vector<uint64_t>& inoes, std::vector<pb::mds::XAttr>& out_xattrs);
 
   void RefreshInode(AttrEntry& attr);
+  // apply dentry change pushed by owner to follower partition cache
+  void RefreshDentry(const pb::mds::NotifyBuddyRequest::UpdateDentry& update_dentry);
 
   Status RefreshFsInfo(const std::string& reason);
   Status RefreshFsInfo(const std::string& name, const std::string& reason);
@@ -260,6 +296,15 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
 
   FileSessionManager& GetFileSessionManager() { return file_session_manager_; }
 
+  // follower mds subscribe change of this fs
+  void AddFollower(uint64_t mds_id) { follower_manager_.Follow(mds_id); }
+
+  // take access count of hash bucket owned by self since last take, for balancer
+  bool TakeBucketLoad(BucketLoadEntry& load);
+
+  // revoke dentry lease of parent held by clients except the given client
+  void RevokeDentryLease(Ino parent, const std::string& client_id = "");
+
   void CleanExpiredCache();
 
   void DescribeByJson(Json::Value& value);
@@ -273,15 +318,28 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
 
   Status RunOperation(Operation* operation);
 
+  void BuildWriteSliceResult(Ino ino, const std::vector<DeltaSliceEntry>& delta_slices,
+                             std::vector<ChunkEntry>& effected_chunks, std::vector<ChunkEntry>& out_chunks);
+
   // generate ino
   Status GenDirIno(Ino& ino);
-  Status GenFileIno(Ino& ino);
+  Status GenFileIno(Ino parent, Ino& ino);
   bool CanServe(uint64_t self_mds_id);
 
+  // follower read
+  bool CanServeRead(Context& ctx);
+  bool IsOwner(Ino ino);
+  bool IsFollowerRead(Context& ctx, Ino ino);
+  // cache entry verified before staleness bound of follower read
+  bool IsFollowerStale(Context& ctx, Ino ino, uint64_t verify_time_ms);
+  void RenewFollow();
+
   Status GetPartitionParentInode(Context& ctx, PartitionPtr& partition, InodeSPtr& out_inode);
   void AddDentryToPartition(Ino parent, const Dentry& dentry, uint64_t version);
   void DeleteDentryFromPartition(Ino parent, const std::string& name, uint64_t version);
   void DeleteDentryFromPartition(Ino parent, const std::vector<std::string>& names, uint64_t version);
+  void UpdatePartition(Ino parent, uint64_t version, const std::vector<std::string>& deleted_names,
+                       const std::vector<Dentry>& dentries);
 
   // get partition
   Status GetPartition(Context& ctx, Ino parent, PartitionPtr& out_partition);
@@ -300,6 +358,7 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   Status GetInode(Context& ctx, uint64_t version, const Dentry& dentry, PartitionPtr partition, InodeSPtr& out_inode);
   Status GetInode(Context& ctx, Ino ino, InodeSPtr& out_inode);
   Status GetInode(Context& ctx, uint64_t version, Ino ino, InodeSPtr& out_inode);
+  Status GetInodeImpl(Context& ctx, uint64_t version, Ino ino, InodeSPtr& out_inode);
 
   Status GetInodeFromStore(Context& ctx, Ino ino, const std::string& reason, bool is_cache, InodeSPtr& out_inode);
   Status BatchGetInodeFromStore(std::vector<uint64_t> inoes, std::vector<InodeSPtr>& out_inodes);
@@ -316,11 +375,18 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   void UpsertInodeCache(const AttrEntry& attr);
   void DeleteInodeFromCache(Ino ino);
 
+  // count op of ino to its bucket, inode is used for parent of file ino
+  void RecordInoLoad(Ino ino, const InodeSPtr& inode);
+
   void ClearCache();
   void ClearInodeCache();
   void ClearPartitionCache();
   void ClearChunkCache();
   void BatchDeleteCache(uint32_t bucket_num, const std::set<uint32_t>& bucket_ids);
+  void HandoffInodeCache(const pb::mds::HashPartition& hash, const std::set<uint32_t>& bucket_ids);
+
+  // file session cache is authoritative when own mono partition fs
+  void RefreshFileSessionAuthority();
 
   uint64_t GetMdsIdByIno(Ino ino);
 
@@ -330,6 +396,11 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   void NotifyBuddyRefreshInode(AttrEntry&& attr);
   void NotifyBuddyCleanPartitionCache(Ino ino);
 
+  // push change to followers
+  void NotifyFollowerRefreshInode(const AttrEntry& attr);
+  void NotifyFollowerUpdateDentry(Ino parent, uint64_t version, const std::vector<std::string>& deleted_names,
+                                  const std::vector<Dentry>& dentries);
+
   uint64_t self_mds_id_;
 
   // filesystem info
@@ -340,6 +411,8 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
 
   // generate inode id
   IdGeneratorUPtr ino_id_generator_;
+  // generate file inode id with parent bucket affinity
+  AffinityInoAllocator affinity_ino_allocator_;
   // for slice id
   IdGeneratorSPtr slice_id_generator_;
 
@@ -367,6 +440,15 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
   // quota
   quota::QuotaManager quota_manager_;
 
+  // notify client invalidate cache
+  ClientNotifier client_notifier_;
+
+  // client dentry lease
+  DentryLeaseManager dentry_lease_manager_;
+
+  // client attr lease
+  AttrLeaseManager attr_lease_manager_;
+
   // renamer
   Renamer renamer_;
 
@@ -374,6 +456,12 @@ class FileSystem : public std::enable_shared_from_this<FileSystem> {
 
   // notify buddy
   notify::NotifyBuddySPtr notify_buddy_;
+
+  // follower read
+  FollowerManager follower_manager_;
+
+  // access count of hash bucket
+  BucketLoadRecorder bucket_load_recorder_;
 };
 
 // manage all filesystem
@@ -0,0 +1,127 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/filesystem/follower.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "brpc/reloadable_flags.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_bool(mds_follower_read_enable, false, "enable serve follower read of fs not owned by self.");
+DEFINE_validator(mds_follower_read_enable, brpc::PassValidate);
+
+DEFINE_uint32(mds_follower_max_staleness_ms, 1000, "follower read max staleness ms, request can only lower it.");
+DEFINE_validator(mds_follower_max_staleness_ms, brpc::PassValidate);
+
+DEFINE_uint32(mds_follower_expire_s, 30, "follower expire time s when not renew, renew at a third of it.");
+DEFINE_validator(mds_follower_expire_s, brpc::PassValidate);
+
+static const std::string kFollowerFollowCountMetricsName = "dingofs_{}_follower_follow_count";
+
+FollowerManager::FollowerManager(uint32_t fs_id)
+    : fs_id_(fs_id), follow_count_(fmt::format(kFollowerFollowCountMetricsName, fs_id)) {}
+
+uint64_t FollowerManager::StalenessMs(uint64_t request_staleness_ms) {
+  const uint64_t max_staleness_ms = FLAGS_mds_follower_max_staleness_ms;
+
+  return request_staleness_ms > 0 ? std::min(request_staleness_ms, max_staleness_ms) : max_staleness_ms;
+}
+
+void FollowerManager::Follow(uint64_t mds_id) {
+  const uint64_t expire_time_ms = utils::TimestampMs() + static_cast<uint64_t>(FLAGS_mds_follower_expire_s) * 1000;
+
+  bool is_new = false;
+  {
+    utils::WriteLockGuard lk(lock_);
+
+    auto it = followers_.find(mds_id);
+    if (it == followers_.end()) {
+      followers_[mds_id] = expire_time_ms;
+      is_new = true;
+    } else {
+      it->second = expire_time_ms;
+    }
+
+    follower_count_.store(followers_.size(), std::memory_order_relaxed);
+  }
+
+  follow_count_ << 1;
+
+  if (is_new) LOG(INFO) << fmt::format("[fs.{}] add follower({}).", fs_id_, mds_id);
+}
+
+std::vector<uint64_t> FollowerManager::GetFollowers() {
+  const uint64_t now_ms = utils::TimestampMs();
+
+  std::vector<uint64_t> mds_ids;
+  bool has_expired = false;
+  {
+    utils::ReadLockGuard lk(lock_);
+
+    for (const auto& [mds_id, expire_time_ms] : followers_) {
+      if (expire_time_ms > now_ms) {
+        mds_ids.push_back(mds_id);
+      } else {
+        has_expired = true;
+      }
+    }
+  }
+
+  if (has_expired) {
+    utils::WriteLockGuard lk(lock_);
+
+    for (auto it = followers_.begin(); it != followers_.end();) {
+      if (it->second <= now_ms) {
+        LOG(INFO) << fmt::format("[fs.{}] remove expired follower({}).", fs_id_, it->first);
+        followers_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+
+    follower_count_.store(followers_.size(), std::memory_order_relaxed);
+  }
+
+  return mds_ids;
+}
+
+bool FollowerManager::ShouldRenew() {
+  const uint64_t now_ms = utils::TimestampMs();
+  const uint64_t interval_ms = static_cast<uint64_t>(FLAGS_mds_follower_expire_s) * 1000 / 3;
+
+  uint64_t last_renew_time_ms = last_renew_time_ms_.load(std::memory_order_relaxed);
+  if (last_renew_time_ms + interval_ms > now_ms) return false;
+
+  // only one caller renew in a interval
+  return last_renew_time_ms_.compare_exchange_strong(last_renew_time_ms, now_ms, std::memory_order_relaxed);
+}
+
+void FollowerManager::Summary(Json::Value& value) {
+  value["name"] = "follower";
+  value["count"] = follower_count_.load(std::memory_order_relaxed);
+  value["follow_count"] = follow_count_.get_value();
+}
+
+}  // namespace mds
+}  // namespace dingofs
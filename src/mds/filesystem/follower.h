@@ -0,0 +1,74 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_FILESYSTEM_FOLLOWER_H_
+#define DINGOFS_MDS_FILESYSTEM_FOLLOWER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "bvar/reducer.h"
+#include "gflags/gflags.h"
+#include "json/value.h"
+#include "utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_bool(mds_follower_read_enable);
+DECLARE_uint32(mds_follower_max_staleness_ms);
+
+// follower read: mds which not own the fs serve read-only request from its
+// cache, cache entry is refetched from store when older than the staleness
+// bound. follower subscribe the owner, and owner push inode/partition change
+// to alive followers, so the follower cache is mostly fresh within bound.
+class FollowerManager {
+ public:
+  FollowerManager(uint32_t fs_id);
+  ~FollowerManager() = default;
+
+  // effective staleness bound ms of request, 0 means no bound is allowed
+  static uint64_t StalenessMs(uint64_t request_staleness_ms);
+
+  // owner side, add or renew follower
+  void Follow(uint64_t mds_id);
+  // owner side, get alive followers and clean expired
+  std::vector<uint64_t> GetFollowers();
+  bool HasFollower() const { return follower_count_.load(std::memory_order_relaxed) > 0; }
+
+  // follower side, return true when it is time to renew subscription
+  bool ShouldRenew();
+
+  void Summary(Json::Value& value);
+
+ private:
+  const uint32_t fs_id_;
+
+  utils::RWLock lock_;
+  // mds_id -> expire time ms
+  absl::flat_hash_map<uint64_t, uint64_t> followers_;
+  std::atomic<uint32_t> follower_count_{0};
+
+  std::atomic<uint64_t> last_renew_time_ms_{0};
+
+  // statistics
+  bvar::Adder<uint64_t> follow_count_;
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_FILESYSTEM_FOLLOWER_H_
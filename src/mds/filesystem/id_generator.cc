@@ -18,11 +18,14 @@
 #include <cstdint>
 #include <string>
 
+#include "brpc/reloadable_flags.h"
+#include "bthread/bthread.h"
 #include "bthread/mutex.h"
+#include "bvar/reducer.h"
 #include "common/logging.h"
 #include "dingofs/error.pb.h"
 #include "fmt/format.h"
-#include "gflags/gflags_declare.h"
+#include "gflags/gflags.h"
 #include "glog/logging.h"
 #include "mds/common/codec.h"
 #include "mds/common/status.h"
@@ -33,6 +36,19 @@ namespace mds {
 
 DECLARE_uint32(mds_txn_max_retry_times);
 
+DEFINE_uint32(mds_id_prefetch_watermark_percent, 50,
+              "prefetch next id bundle when remaining ids below this percent of bundle.");
+DEFINE_validator(mds_id_prefetch_watermark_percent, brpc::PassValidate);
+
+DEFINE_uint32(mds_id_bundle_duration_ms, 1000, "expected time one id bundle lasts, bundle size adapt to alloc rate.");
+DEFINE_validator(mds_id_bundle_duration_ms, brpc::PassValidate);
+
+DEFINE_uint32(mds_id_bundle_max_size, 65536, "max id bundle size when adapt to alloc rate.");
+DEFINE_validator(mds_id_bundle_max_size, brpc::PassValidate);
+
+static bvar::Adder<uint64_t> g_id_prefetch_count("mds_id_prefetch_count");
+static bvar::Adder<uint64_t> g_id_sync_fetch_count("mds_id_sync_fetch_count");
+
 const std::string kFsAutoIncrementIdName = "dingofs-fs-id";
 static const int64_t kFsTableId = 1000;
 static const int64_t kFsIdBatchSize = 2;
@@ -49,20 +65,190 @@ const std::string kInoAutoIncrementIdName = "dingofs-inode-id";
 static const int64_t kInoBatchSize = 1024;
 static const int64_t kInoStartId = 2e10;  // 20 billion
 
-CoorAutoIncrementIdGenerator::CoorAutoIncrementIdGenerator(CoordinatorClientSPtr client, const std::string& name,
-                                                           int64_t table_id, uint64_t start_id, uint32_t batch_size)
-    : client_(client), name_(name), table_id_(table_id), start_id_(start_id), batch_size_(batch_size) {
-  next_id_ = start_id;
-  bundle_ = start_id;
-  bundle_end_ = start_id;
-
+BundleIdGenerator::BundleIdGenerator(const std::string& name, uint32_t batch_size)
+    : name_(name), batch_size_(std::max(batch_size, 1U)), bundle_size_(batch_size_) {
   CHECK(bthread_mutex_init(&mutex_, nullptr) == 0) << "init mutex fail.";
 }
 
-CoorAutoIncrementIdGenerator::~CoorAutoIncrementIdGenerator() {
+BundleIdGenerator::~BundleIdGenerator() {
+  // prefetch bthread touch nothing after decrease count
+  while (running_prefetch_count_.load(std::memory_order_acquire) > 0) {
+    bthread_usleep(1000);
+  }
+
   CHECK(bthread_mutex_destroy(&mutex_) == 0) << "destory mutex fail.";
 }
 
+bool BundleIdGenerator::GenID(uint32_t num, uint64_t& id) { return GenID(num, 0, id); }
+
+bool BundleIdGenerator::GenID(uint32_t num, uint64_t min_slice_id, uint64_t& id) {
+  if (num == 0) {
+    LOG(ERROR) << fmt::format("[idalloc.{}] num cant not 0.", name_);
+    return false;
+  }
+
+  while (true) {
+    if (is_destroyed_.load(std::memory_order_acquire)) {
+      LOG(ERROR) << fmt::format("[idalloc.{}] id generator is destroyed.", name_);
+      return false;
+    }
+
+    auto bundle = std::atomic_load(&bundle_);
+    if (bundle != nullptr && TakeFromBundle(*bundle, num, min_slice_id, id)) {
+      MaybePrefetch(*bundle);
+
+      LOG_DEBUG << fmt::format("[idalloc.{}] alloc id {},{} bundle[{}, {}).", name_, id, num, bundle->start,
+                               bundle->end);
+      return true;
+    }
+
+    if (!SwitchBundle(bundle, num, min_slice_id)) return false;
+  }
+}
+
+bool BundleIdGenerator::TakeFromBundle(Bundle& bundle, uint32_t num, uint64_t min_id, uint64_t& id) {
+  uint64_t next_id = bundle.next_id.load(std::memory_order_relaxed);
+  uint64_t start = 0;
+  do {
+    start = std::max(next_id, min_id);
+    if (start + num > bundle.end) return false;
+
+  } while (!bundle.next_id.compare_exchange_weak(next_id, start + num, std::memory_order_relaxed));
+
+  id = start;
+  return true;
+}
+
+bool BundleIdGenerator::SwitchBundle(const BundleSPtr& old_bundle, uint32_t num, uint64_t min_id) {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  // other thread already switch
+  if (std::atomic_load(&bundle_) != old_bundle) return true;
+
+  UpdateBundleSize(old_bundle);
+
+  uint64_t min_start = min_id;
+  if (old_bundle != nullptr) min_start = std::max(min_start, old_bundle->end);
+
+  uint64_t start = 0, end = 0;
+  if (prefetch_end_ > 0 && std::max(prefetch_start_, min_id) + num <= prefetch_end_) {
+    start = prefetch_start_;
+    end = prefetch_end_;
+
+  } else {
+    // no prefetched bundle or not fit, ids of it are abandoned
+    if (prefetch_end_ > 0) {
+      LOG(INFO) << fmt::format("[idalloc.{}] abandon prefetched bundle[{}, {}), num({}) min_id({}).", name_,
+                               prefetch_start_, prefetch_end_, num, min_id);
+    }
+
+    utils::Duration duration;
+    auto status = FetchBundle(std::max(num, bundle_size_.load(std::memory_order_relaxed)), min_start, start, end);
+    g_id_sync_fetch_count << 1;
+    if (!status.ok()) {
+      LOG(ERROR) << fmt::format("[idalloc.{}][{}us] fetch bundle fail, {}.", name_, duration.ElapsedUs(),
+                                status.error_str());
+      return false;
+    }
+  }
+
+  prefetch_start_ = 0;
+  prefetch_end_ = 0;
+  bundle_switch_time_us_ = utils::TimestampUs();
+
+  std::atomic_store(&bundle_, std::make_shared<Bundle>(start, end));
+  is_prefetch_triggered_.store(false, std::memory_order_release);
+
+  LOG(INFO) << fmt::format("[idalloc.{}] switch bundle[{}, {}) bundle_size({}).", name_, start, end,
+                           bundle_size_.load(std::memory_order_relaxed));
+
+  return true;
+}
+
+// must hold mutex_
+void BundleIdGenerator::UpdateBundleSize(const BundleSPtr& old_bundle) {
+  if (old_bundle == nullptr || bundle_switch_time_us_ == 0) return;
+
+  // alloc rate of last bundle decide size of next bundle
+  const uint64_t now_us = utils::TimestampUs();
+  const uint64_t elapsed_us = std::max(now_us - bundle_switch_time_us_, static_cast<uint64_t>(1));
+  const uint64_t used_num = old_bundle->end - old_bundle->start;
+  const uint64_t expect_size = used_num * FLAGS_mds_id_bundle_duration_ms * 1000 / elapsed_us;
+
+  const uint32_t max_size = std::max(FLAGS_mds_id_bundle_max_size, batch_size_);
+  const uint64_t bundle_size = std::clamp(expect_size, static_cast<uint64_t>(batch_size_), uint64_t(max_size));
+  bundle_size_.store(static_cast<uint32_t>(bundle_size), std::memory_order_relaxed);
+}
+
+void BundleIdGenerator::MaybePrefetch(const Bundle& bundle) {
+  const uint64_t next_id = bundle.next_id.load(std::memory_order_relaxed);
+  const uint64_t remain_num = bundle.end > next_id ? bundle.end - next_id : 0;
+  if (remain_num * 100 > (bundle.end - bundle.start) * FLAGS_mds_id_prefetch_watermark_percent) return;
+
+  if (is_prefetch_triggered_.load(std::memory_order_relaxed) ||
+      is_prefetch_triggered_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  running_prefetch_count_.fetch_add(1, std::memory_order_acq_rel);
+
+  bthread_t tid;
+  if (bthread_start_background(&tid, nullptr, &BundleIdGenerator::RunPrefetch, this) != 0) {
+    LOG(ERROR) << fmt::format("[idalloc.{}] start prefetch bthread fail.", name_);
+    running_prefetch_count_.fetch_sub(1, std::memory_order_acq_rel);
+    is_prefetch_triggered_.store(false, std::memory_order_release);
+  }
+}
+
+void BundleIdGenerator::Prefetch() {
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  if (is_destroyed_.load(std::memory_order_acquire) || prefetch_end_ > 0) return;
+
+  auto bundle = std::atomic_load(&bundle_);
+  const uint64_t min_id = bundle != nullptr ? bundle->end : 0;
+
+  utils::Duration duration;
+  uint64_t start = 0, end = 0;
+  auto status = FetchBundle(bundle_size_.load(std::memory_order_relaxed), min_id, start, end);
+  g_id_prefetch_count << 1;
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[idalloc.{}][{}us] prefetch bundle fail, {}.", name_, duration.ElapsedUs(),
+                              status.error_str());
+    // next alloc trigger again
+    is_prefetch_triggered_.store(false, std::memory_order_release);
+    return;
+  }
+
+  prefetch_start_ = start;
+  prefetch_end_ = end;
+
+  LOG(INFO) << fmt::format("[idalloc.{}][{}us] prefetch bundle[{}, {}).", name_, duration.ElapsedUs(), start, end);
+}
+
+void* BundleIdGenerator::RunPrefetch(void* arg) {
+  auto* self = reinterpret_cast<BundleIdGenerator*>(arg);
+
+  self->Prefetch();
+  self->running_prefetch_count_.fetch_sub(1, std::memory_order_acq_rel);
+
+  return nullptr;
+}
+
+std::string BundleIdGenerator::DescribeBundle() const {
+  auto bundle = std::atomic_load(&bundle_);
+  if (bundle == nullptr) {
+    return fmt::format("bundle_size({}) range[0, 0) next_id(0)", bundle_size_.load(std::memory_order_relaxed));
+  }
+
+  return fmt::format("bundle_size({}) range[{}, {}) next_id({})", bundle_size_.load(std::memory_order_relaxed),
+                     bundle->start, bundle->end, bundle->next_id.load(std::memory_order_relaxed));
+}
+
+CoorAutoIncrementIdGenerator::CoorAutoIncrementIdGenerator(CoordinatorClientSPtr client, const std::string& name,
+                                                           int64_t table_id, uint64_t start_id, uint32_t batch_size)
+    : BundleIdGenerator(name, batch_size), table_id_(table_id), start_id_(start_id), client_(client) {}
+
 bool CoorAutoIncrementIdGenerator::Init() {
   auto status = IsExistAutoIncrement();
   if (status.ok()) {
@@ -100,36 +286,9 @@ bool CoorAutoIncrementIdGenerator::Destroy() {
   return true;
 }
 
-bool CoorAutoIncrementIdGenerator::GenID(uint32_t num, uint64_t& id) { return GenID(num, 0, id); }
-
-bool CoorAutoIncrementIdGenerator::GenID(uint32_t num, uint64_t min_slice_id, uint64_t& id) {
-  BAIDU_SCOPED_LOCK(mutex_);
-
-  if (is_destroyed_) {
-    LOG(ERROR) << fmt::format("[idalloc.{}] id generator is destroyed.", name_);
-    return false;
-  }
-
-  next_id_ = std::max(next_id_, min_slice_id);
-
-  if (next_id_ + num > bundle_end_) {
-    auto status = AllocateIds(std::max(num, batch_size_));
-    if (!status.ok()) {
-      return false;
-    }
-  }
-
-  id = next_id_;
-  next_id_ += num;
-
-  LOG(INFO) << fmt::format("[idalloc.{}] alloc id {},{} bundle[{}, {}).", name_, id, num, bundle_, bundle_end_);
-
-  return true;
-}
-
 std::string CoorAutoIncrementIdGenerator::Describe() const {
-  return fmt::format("[coordinator] name({}) start_id({}) batch_size({}) range[{}, {}) next_id({})", name_, start_id_,
-                     batch_size_, bundle_, bundle_end_, next_id_);
+  return fmt::format("[coordinator] name({}) start_id({}) batch_size({}) {}", name_, start_id_, batch_size_,
+                     DescribeBundle());
 }
 
 Status CoorAutoIncrementIdGenerator::IsExistAutoIncrement() {
@@ -147,46 +306,39 @@ Status CoorAutoIncrementIdGenerator::DeleteAutoIncrement() {
   return client_->DeleteAutoIncrement(table_id_);
 }
 
-Status CoorAutoIncrementIdGenerator::AllocateIds(uint32_t num) {
+Status CoorAutoIncrementIdGenerator::FetchBundle(uint32_t size, uint64_t min_id, uint64_t& start, uint64_t& end) {
+  min_id = std::max(min_id, start_id_);
+
   Status status;
   utils::Duration duration;
   int64_t bundle = 0;
   int64_t bundle_end = 0;
   do {
-    status = client_->GenerateAutoIncrement(table_id_, num, bundle, bundle_end);
+    status = client_->GenerateAutoIncrement(table_id_, size, bundle, bundle_end);
     if (!status.ok()) {
       break;
     }
 
     CHECK(bundle >= 0 && bundle_end >= 0) << "bundle id is negative.";
-  } while (static_cast<uint64_t>(bundle) < next_id_);
+  } while (static_cast<uint64_t>(bundle) < min_id);
 
   if (status.ok()) {
-    bundle_ = static_cast<uint64_t>(bundle);
-    next_id_ = static_cast<uint64_t>(bundle);
-    bundle_end_ = static_cast<uint64_t>(bundle_end);
+    start = static_cast<uint64_t>(bundle);
+    end = static_cast<uint64_t>(bundle_end);
   }
 
-  LOG(INFO) << fmt::format("[idalloc.{}][{}us] take bundle id, bundle[{},{}) num({}) status({}).", name_,
-                           duration.ElapsedUs(), bundle_, bundle_end_, num, status.error_str());
+  LOG(INFO) << fmt::format("[idalloc.{}][{}us] take bundle id, bundle[{},{}) size({}) status({}).", name_,
+                           duration.ElapsedUs(), start, end, size, status.error_str());
 
   return status;
 }
 
 StoreAutoIncrementIdGenerator::StoreAutoIncrementIdGenerator(KVStorageSPtr kv_storage, const std::string& name,
                                                              int64_t start_id, int batch_size)
-    : kv_storage_(kv_storage),
-      name_(name),
+    : BundleIdGenerator(name, batch_size),
+      kv_storage_(kv_storage),
       key_(MetaCodec::EncodeAutoIncrementIDKey(name)),
-      next_id_(start_id),
-      last_alloc_id_(start_id),
-      batch_size_(batch_size) {
-  CHECK(bthread_mutex_init(&mutex_, nullptr) == 0) << "init mutex fail.";
-}
-
-StoreAutoIncrementIdGenerator::~StoreAutoIncrementIdGenerator() {
-  CHECK(bthread_mutex_destroy(&mutex_) == 0) << "destory mutex fail.";
-}
+      last_alloc_id_(start_id) {}
 
 bool StoreAutoIncrementIdGenerator::Init() {
   uint64_t alloc_id = 0;
@@ -196,7 +348,7 @@ bool StoreAutoIncrementIdGenerator::Init() {
     return false;
   }
 
-  next_id_ = alloc_id;
+  BAIDU_SCOPED_LOCK(mutex_);
   last_alloc_id_ = alloc_id;
 
   return true;
@@ -211,41 +363,14 @@ bool StoreAutoIncrementIdGenerator::Destroy() {
     return false;
   }
 
-  return true;
-}
-
-bool StoreAutoIncrementIdGenerator::GenID(uint32_t num, uint64_t& id) { return GenID(num, 0, id); }
-
-bool StoreAutoIncrementIdGenerator::GenID(uint32_t num, uint64_t min_slice_id, uint64_t& id) {
-  if (num == 0) {
-    LOG(ERROR) << fmt::format("[idalloc.{}] num cant not 0.", name_);
-    return false;
-  }
-
-  BAIDU_SCOPED_LOCK(mutex_);
-
-  next_id_ = std::max(next_id_, min_slice_id);
-
-  if (next_id_ + num > last_alloc_id_) {
-    auto status = AllocateIds(std::max(num, batch_size_));
-    if (!status.ok()) {
-      LOG(ERROR) << fmt::format("[idalloc.{}] allocate id fail, {}.", name_, status.error_str());
-      return false;
-    }
-  }
-
-  // allocate id
-  id = next_id_;
-  next_id_ += num;
-
-  LOG(INFO) << fmt::format("[idalloc.{}] alloc id({}) num({}).", name_, id, num);
+  is_destroyed_ = true;
 
   return true;
 }
 
 std::string StoreAutoIncrementIdGenerator::Describe() const {
-  return fmt::format("[store] name({}) batch_size({}) last_alloc_id({}) next_id({})", name_, batch_size_,
-                     last_alloc_id_, next_id_);
+  return fmt::format("[store] name({}) batch_size({}) last_alloc_id({}) {}", name_, batch_size_, last_alloc_id_,
+                     DescribeBundle());
 }
 
 Status StoreAutoIncrementIdGenerator::GetOrPutAllocId(uint64_t& alloc_id) {
@@ -285,11 +410,11 @@ Status StoreAutoIncrementIdGenerator::GetOrPutAllocId(uint64_t& alloc_id) {
   return status;
 }
 
-Status StoreAutoIncrementIdGenerator::AllocateIds(uint32_t size) {
+Status StoreAutoIncrementIdGenerator::FetchBundle(uint32_t size, uint64_t min_id, uint64_t& start, uint64_t& end) {
   utils::Duration duration;
   Status status;
   uint32_t retry = 0;
-  uint64_t start_alloc_id = std::max(next_id_, last_alloc_id_);
+  uint64_t start_alloc_id = std::max(min_id, last_alloc_id_);
   do {
     auto txn = kv_storage_->NewTxn();
     if (txn == nullptr) {
@@ -321,11 +446,12 @@ Status StoreAutoIncrementIdGenerator::AllocateIds(uint32_t size) {
 
   if (status.ok()) {
     last_alloc_id_ = start_alloc_id + size;
-    next_id_ = start_alloc_id;
+    start = start_alloc_id;
+    end = last_alloc_id_;
   }
 
   LOG(INFO) << fmt::format("[idalloc.{}][{}us] take bundle id, bundle[{},{}) size({}) status({}).", name_,
-                           duration.ElapsedUs(), next_id_, last_alloc_id_, size, status.error_str());
+                           duration.ElapsedUs(), start_alloc_id, start_alloc_id + size, size, status.error_str());
 
   return status;
 }
@@ -352,6 +478,95 @@ Status StoreAutoIncrementIdGenerator::DestroyId() {
   return status;
 }
 
+AffinityInoAllocator::AffinityInoAllocator(IdGenerator& id_generator, uint32_t batch_per_bucket,
+                                           uint32_t max_cached_per_bucket)
+    : id_generator_(id_generator),
+      batch_per_bucket_(std::max(batch_per_bucket, 1U)),
+      max_cached_per_bucket_(std::max(max_cached_per_bucket, batch_per_bucket_)) {
+  bthread_mutex_init(&mutex_, nullptr);
+}
+
+AffinityInoAllocator::~AffinityInoAllocator() { bthread_mutex_destroy(&mutex_); }
+
+bool AffinityInoAllocator::GenFileIno(uint32_t bucket_num, uint32_t bucket_id, uint64_t& ino) {
+  CHECK(bucket_num > 0) << "bucket_num is zero.";
+  CHECK(bucket_id < bucket_num) << fmt::format("invalid bucket_id({}).", bucket_id);
+
+  BAIDU_SCOPED_LOCK(mutex_);
+
+  // bucket num changed, cached inos are useless
+  if (bucket_num != bucket_num_) Reset(bucket_num);
+
+  auto& bucket = buckets_[bucket_id];
+  if (bucket.strides.empty() && !Refill(bucket_num)) return false;
+
+  CHECK(!bucket.strides.empty()) << fmt::format("refill bucket({}) fail.", bucket_id);
+  auto& stride = bucket.strides.front();
+  ino = stride.next << 1;
+  stride.next += bucket_num;
+  if (--stride.remain == 0) bucket.strides.pop_front();
+  --bucket.cached_count;
+  --cached_count_;
+
+  return true;
+}
+
+// must hold mutex
+void AffinityInoAllocator::Reset(uint32_t bucket_num) {
+  for (const auto& bucket : buckets_) discarded_count_ += bucket.cached_count;
+
+  buckets_.clear();
+  buckets_.resize(bucket_num);
+  bucket_num_ = bucket_num;
+  cached_count_ = 0;
+}
+
+// must hold mutex
+bool AffinityInoAllocator::Refill(uint32_t bucket_num) {
+  // every 2 * bucket_num continuous ids has one even id for each bucket
+  const uint64_t num = 2ULL * bucket_num * batch_per_bucket_;
+  CHECK(num <= UINT32_MAX) << fmt::format("refill num({}) too large.", num);
+
+  uint64_t start_id = 0;
+  if (!id_generator_.GenID(num, start_id)) return false;
+
+  // even ids of [start_id, start_id + num) are half id [start, start + num / 2)
+  const uint64_t start = (start_id + 1) >> 1;
+  const uint64_t start_bucket_id = start % bucket_num;
+  uint64_t discard_count = 0;
+  for (uint32_t bucket_id = 0; bucket_id < bucket_num; ++bucket_id) {
+    auto& bucket = buckets_[bucket_id];
+    if (bucket.cached_count + batch_per_bucket_ > max_cached_per_bucket_) {
+      discard_count += batch_per_bucket_;
+      continue;
+    }
+
+    Stride stride;
+    stride.next = start + (bucket_id + bucket_num - start_bucket_id) % bucket_num;
+    stride.remain = batch_per_bucket_;
+    bucket.strides.push_back(stride);
+    bucket.cached_count += batch_per_bucket_;
+    cached_count_ += batch_per_bucket_;
+  }
+  // odd ids are dropped as well
+  discarded_count_ += discard_count + (num - (num >> 1));
+
+  LOG_DEBUG << fmt::format("[idalloc] refill affinity ino [{}, {}), discard({}) cached({}).", start_id,
+                           start_id + num, discard_count, cached_count_);
+
+  return true;
+}
+
+size_t AffinityInoAllocator::CachedCount() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  return cached_count_;
+}
+
+uint64_t AffinityInoAllocator::DiscardedCount() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  return discarded_count_;
+}
+
 IdGeneratorUPtr NewFsIdGenerator(CoordinatorClientSPtr coordinator_client) {
   CHECK(coordinator_client != nullptr) << "coordinator_client is nullptr.";
 
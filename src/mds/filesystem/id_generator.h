@@ -15,9 +15,12 @@
 #ifndef DINGOFS_MDS_ID_GENERATOR_H_
 #define DINGOFS_MDS_ID_GENERATOR_H_
 
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "bthread/types.h"
 #include "mds/common/status.h"
@@ -44,11 +47,74 @@ class IdGenerator {
 using IdGeneratorUPtr = std::unique_ptr<IdGenerator>;
 using IdGeneratorSPtr = std::shared_ptr<IdGenerator>;
 
-class CoorAutoIncrementIdGenerator : public IdGenerator {
+// hand out ids from a bundle of continuous ids without lock, fetch-add the
+// bundle and swap in a new one when exhausted. the next bundle is prefetched
+// in background when remaining ids fall below low watermark, so request path
+// rarely wait a remote fetch. bundle size adapts to allocation rate.
+class BundleIdGenerator : public IdGenerator {
+ public:
+  BundleIdGenerator(const std::string& name, uint32_t batch_size);
+  ~BundleIdGenerator() override;
+
+  bool GenID(uint32_t num, uint64_t& id) override;
+  bool GenID(uint32_t num, uint64_t min_slice_id, uint64_t& id) override;
+
+ protected:
+  // fetch [start, end) from backend, start >= min_id and end - start >= size.
+  // called with mutex_ held.
+  virtual Status FetchBundle(uint32_t size, uint64_t min_id, uint64_t& start, uint64_t& end) = 0;
+
+  std::string DescribeBundle() const;
+
+  const std::string name_;
+  // min bundle size
+  const uint32_t batch_size_{0};
+
+  // protect fetch and swap bundle
+  bthread_mutex_t mutex_;
+
+  std::atomic<bool> is_destroyed_{false};
+
+ private:
+  struct Bundle {
+    Bundle(uint64_t start, uint64_t end) : start(start), end(end), next_id(start) {}
+
+    // [start, end)
+    const uint64_t start;
+    const uint64_t end;
+    std::atomic<uint64_t> next_id;
+  };
+  using BundleSPtr = std::shared_ptr<Bundle>;
+
+  static bool TakeFromBundle(Bundle& bundle, uint32_t num, uint64_t min_id, uint64_t& id);
+
+  // swap in a new bundle, prefer prefetched one
+  bool SwitchBundle(const BundleSPtr& old_bundle, uint32_t num, uint64_t min_id);
+  void UpdateBundleSize(const BundleSPtr& old_bundle);
+
+  void MaybePrefetch(const Bundle& bundle);
+  void Prefetch();
+  static void* RunPrefetch(void* arg);
+
+  // current bundle, read by atomic_load and replaced by atomic_store
+  BundleSPtr bundle_;
+
+  // protected by mutex_
+  uint64_t prefetch_start_{0};
+  uint64_t prefetch_end_{0};
+  uint64_t bundle_switch_time_us_{0};
+
+  std::atomic<uint32_t> bundle_size_{0};
+  // one prefetch for one bundle
+  std::atomic<bool> is_prefetch_triggered_{false};
+  std::atomic<uint32_t> running_prefetch_count_{0};
+};
+
+class CoorAutoIncrementIdGenerator : public BundleIdGenerator {
  public:
   CoorAutoIncrementIdGenerator(CoordinatorClientSPtr client, const std::string& name, int64_t table_id,
                                uint64_t start_id, uint32_t batch_size);
-  ~CoorAutoIncrementIdGenerator() override;
+  ~CoorAutoIncrementIdGenerator() override = default;
 
   static IdGeneratorUPtr New(CoordinatorClientSPtr client, const std::string& name, int64_t table_id, uint64_t start_id,
                              uint32_t batch_size) {
@@ -62,9 +128,6 @@ class CoorAutoIncrementIdGenerator : public IdGenerator {
   bool Init() override;
   bool Destroy() override;
 
-  bool GenID(uint32_t num, uint64_t& id) override;
-  bool GenID(uint32_t num, uint64_t min_slice_id, uint64_t& id) override;
-
   std::string Describe() const override;
 
  private:
@@ -72,30 +135,18 @@ class CoorAutoIncrementIdGenerator : public IdGenerator {
   Status CreateAutoIncrement();
   Status DeleteAutoIncrement();
 
-  Status AllocateIds(uint32_t num);
-
-  const std::string name_;
+  Status FetchBundle(uint32_t size, uint64_t min_id, uint64_t& start, uint64_t& end) override;
 
   const int64_t table_id_{0};
   const uint64_t start_id_{0};
-  const uint32_t batch_size_{0};
 
   CoordinatorClientSPtr client_;
-
-  bthread_mutex_t mutex_;
-
-  // [bundle, bundle_end)
-  uint64_t bundle_{0};
-  uint64_t bundle_end_{0};
-  uint64_t next_id_{0};
-
-  bool is_destroyed_{false};
 };
 
-class StoreAutoIncrementIdGenerator : public IdGenerator {
+class StoreAutoIncrementIdGenerator : public BundleIdGenerator {
  public:
   StoreAutoIncrementIdGenerator(KVStorageSPtr kv_storage, const std::string& name, int64_t start_id, int batch_size);
-  ~StoreAutoIncrementIdGenerator() override;
+  ~StoreAutoIncrementIdGenerator() override = default;
 
   static IdGeneratorUPtr New(KVStorageSPtr kv_storage, const std::string& name, int64_t start_id, int batch_size) {
     return std::make_unique<StoreAutoIncrementIdGenerator>(kv_storage, name, start_id, batch_size);
@@ -108,32 +159,64 @@ class StoreAutoIncrementIdGenerator : public IdGenerator {
   bool Init() override;
   bool Destroy() override;
 
-  bool GenID(uint32_t num, uint64_t& id) override;
-  bool GenID(uint32_t num, uint64_t min_slice_id, uint64_t& id) override;
-
   std::string Describe() const override;
 
  private:
   Status GetOrPutAllocId(uint64_t& alloc_id);
-  Status AllocateIds(uint32_t bundle_size);
+  Status FetchBundle(uint32_t size, uint64_t min_id, uint64_t& start, uint64_t& end) override;
   Status DestroyId();
 
   KVStorageSPtr kv_storage_;
 
-  bthread_mutex_t mutex_;
-
-  const std::string name_;
   // the key of id
   const std::string key_;
 
-  // the next id can be allocated in this bunlde
-  uint64_t next_id_;
-  // the last id can be allocated in this bunlde
+  // the end of ids fetched from store, protected by mutex_
   uint64_t last_alloc_id_;
-  // get the numnber of id at a time
-  const uint32_t batch_size_;
+};
 
-  bool is_destroyed_{false};
+// allocate file ino with bucket affinity, (ino >> 1) % bucket_num == bucket_id.
+// under parent hash partition file ino is allocated in its parent bucket, so
+// the owner mds of a file ino can be computed without knowing its parent.
+// one refill carve 2 * bucket_num * batch continuous ids, every bucket own a
+// stride of it, half id base + k * bucket_num. a bucket keep its strides
+// until used up, ids are discarded only when a bucket has too many cached.
+class AffinityInoAllocator {
+ public:
+  AffinityInoAllocator(IdGenerator& id_generator, uint32_t batch_per_bucket, uint32_t max_cached_per_bucket);
+  ~AffinityInoAllocator();
+
+  // ino is even, as file ino
+  bool GenFileIno(uint32_t bucket_num, uint32_t bucket_id, uint64_t& ino);
+
+  size_t CachedCount();
+  // ids fetched from id generator but never handed out
+  uint64_t DiscardedCount();
+
+ private:
+  // half id next, next + bucket_num ... of a bucket
+  struct Stride {
+    uint64_t next{0};
+    uint32_t remain{0};
+  };
+
+  struct Bucket {
+    std::deque<Stride> strides;
+    uint64_t cached_count{0};
+  };
+
+  bool Refill(uint32_t bucket_num);
+  void Reset(uint32_t bucket_num);
+
+  IdGenerator& id_generator_;
+  const uint32_t batch_per_bucket_;
+  const uint32_t max_cached_per_bucket_;
+
+  bthread_mutex_t mutex_;
+  uint32_t bucket_num_{0};
+  std::vector<Bucket> buckets_;
+  size_t cached_count_{0};
+  uint64_t discarded_count_{0};
 };
 
 IdGeneratorUPtr NewFsIdGenerator(CoordinatorClientSPtr coordinator_client);
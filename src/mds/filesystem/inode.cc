@@ -42,6 +42,9 @@ bool Inode::PutIf(const AttrEntry& attr) {
   LOG(INFO) << fmt::format("[inode.{}] update attr,this({}) version({}->{}).", ino_, (void*)this, version_,
                            attr.version());
 
+  // same version also means cached attr is up to date
+  if (attr.version() >= version_) verify_time_ms_.store(utils::TimestampMs(), std::memory_order_relaxed);
+
   if (attr.version() <= version_) {
     LOG_DEBUG << fmt::format("[inode.{}] version abnormal, old({}) new({}).", ino_, version_, attr.version());
     return false;
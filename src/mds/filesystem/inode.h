@@ -63,6 +63,7 @@ class Inode {
         version_(attr.version()),
         parents_(attr.parents().begin(), attr.parents().end()) {
     last_active_time_s_ = utils::Timestamp();
+    verify_time_ms_ = utils::TimestampMs();
     for (const auto& xattr : attr.xattrs()) {
       xattrs_.emplace(xattr.first, xattr.second);
     }
@@ -129,6 +130,12 @@ class Inode {
     return version_;
   }
 
+  // first parent, 0 if unknown
+  mds::Ino FirstParent() const {
+    utils::ReadLockGuard lk(lock_);
+    return parents_.empty() ? 0 : parents_.front();
+  }
+
   XAttrMap XAttrs() const {
     utils::ReadLockGuard lk(lock_);
 
@@ -156,6 +163,9 @@ class Inode {
   void UpdateLastActiveTime() { last_active_time_s_.store(utils::Timestamp(), std::memory_order_relaxed); }
   uint64_t LastActiveTimeS() { return last_active_time_s_.load(std::memory_order_relaxed); }
 
+  // last time attr is confirmed up to date, used by follower read to bound staleness
+  uint64_t VerifyTimeMs() const { return verify_time_ms_.load(std::memory_order_relaxed); }
+
  private:
   mutable utils::RWLock lock_;
 
@@ -184,6 +194,7 @@ class Inode {
   uint64_t version_{0};
 
   std::atomic<uint64_t> last_active_time_s_{0};
+  std::atomic<uint64_t> verify_time_ms_{0};
 };
 
 class InodeCache;
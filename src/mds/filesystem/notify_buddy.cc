@@ -17,7 +17,9 @@
 #include <bthread/types.h>
 
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <tuple>
 
 #include "bthread/bthread.h"
 #include "common/logging.h"
@@ -127,6 +129,32 @@ std::map<uint64_t, NotifyBuddy::BatchMessage> NotifyBuddy::GroupingByMdsID(const
   return batch_message_map;
 }
 
+void NotifyBuddy::CoalesceRefreshInode(std::vector<MessageSPtr>& messages) {
+  // (mds_id, fs_id, ino) -> index of newest attr
+  std::map<std::tuple<uint64_t, uint32_t, Ino>, size_t> newest_indexes;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (messages[i] == nullptr || messages[i]->type != Type::kRefreshInode) continue;
+
+    auto refresh_inode_message = std::dynamic_pointer_cast<RefreshInodeMessage>(messages[i]);
+    auto key = std::make_tuple(messages[i]->mds_id, messages[i]->fs_id, refresh_inode_message->attr.ino());
+    auto it = newest_indexes.find(key);
+    if (it == newest_indexes.end()) {
+      newest_indexes.emplace(key, i);
+      continue;
+    }
+
+    auto& newest_message = messages[it->second];
+    auto newest_refresh_inode_message = std::dynamic_pointer_cast<RefreshInodeMessage>(newest_message);
+    if (refresh_inode_message->attr.version() >= newest_refresh_inode_message->attr.version()) {
+      newest_message = nullptr;
+      it->second = i;
+
+    } else {
+      messages[i] = nullptr;
+    }
+  }
+}
+
 void NotifyBuddy::DispatchMessage() {
   std::vector<MessageSPtr> messages;
   messages.reserve(FLAGS_mds_notify_message_batch_size);
@@ -153,6 +181,8 @@ void NotifyBuddy::DispatchMessage() {
       messages.push_back(message);
     } while (queue_.Dequeue(message));
 
+    CoalesceRefreshInode(messages);
+
     auto batch_message_map = GroupingByMdsID(messages);
     for (auto& [mds_id, batch_message] : batch_message_map) {
       LaunchSendMessage(mds_id, batch_message);
@@ -215,7 +245,7 @@ void NotifyBuddy::SendMessage(uint64_t mds_id, BatchMessage& batch_message) {
         auto refresh_inode_message = std::dynamic_pointer_cast<RefreshInodeMessage>(message);
         mut_refresh_inode->mutable_inode()->Swap(&refresh_inode_message->attr);
 
-        LOG(INFO) << fmt::format("[notify.{}] refresh inode, inode({}).", mds_id,
+        LOG_DEBUG << fmt::format("[notify.{}] refresh inode, inode({}).", mds_id,
                                  mut_refresh_inode->inode().ShortDebugString());
 
       } break;
@@ -226,7 +256,7 @@ void NotifyBuddy::SendMessage(uint64_t mds_id, BatchMessage& batch_message) {
         auto clean_partition_cache_message = std::dynamic_pointer_cast<CleanPartitionCacheMessage>(message);
         mut_message->mutable_clean_partition_cache()->set_ino(clean_partition_cache_message->ino);
 
-        LOG(INFO) << fmt::format("[notify.{}] clean partition cache({}/{}) info.", mds_id, message->fs_id,
+        LOG_DEBUG << fmt::format("[notify.{}] clean partition cache({}/{}) info.", mds_id, message->fs_id,
                                  clean_partition_cache_message->ino);
 
       } break;
@@ -255,6 +285,37 @@ void NotifyBuddy::SendMessage(uint64_t mds_id, BatchMessage& batch_message) {
 
       } break;
 
+      case Type::kFollowFs: {
+        mut_message->set_type(pb::mds::NotifyBuddyRequest::TYPE_FOLLOW_FS);
+
+        auto follow_fs_message = std::dynamic_pointer_cast<FollowFsMessage>(message);
+        mut_message->mutable_follow_fs()->set_mds_id(follow_fs_message->follower_mds_id);
+
+        LOG(INFO) << fmt::format("[notify.{}] follow fs({}), follower({}).", mds_id, message->fs_id,
+                                 follow_fs_message->follower_mds_id);
+
+      } break;
+
+      case Type::kUpdateDentry: {
+        mut_message->set_type(pb::mds::NotifyBuddyRequest::TYPE_UPDATE_DENTRY);
+
+        auto update_dentry_message = std::dynamic_pointer_cast<UpdateDentryMessage>(message);
+        auto* mut_update_dentry = mut_message->mutable_update_dentry();
+        mut_update_dentry->set_ino(update_dentry_message->ino);
+        mut_update_dentry->set_version(message->version);
+        for (auto& name : update_dentry_message->deleted_names) {
+          mut_update_dentry->add_deleted_names(std::move(name));
+        }
+        for (auto& dentry : update_dentry_message->dentries) {
+          mut_update_dentry->add_dentries()->Swap(&dentry);
+        }
+
+        LOG_DEBUG << fmt::format("[notify.{}] update dentry({}/{}) version({}) delete({}) put({}).", mds_id,
+                                 message->fs_id, update_dentry_message->ino, message->version,
+                                 mut_update_dentry->deleted_names_size(), mut_update_dentry->dentries_size());
+
+      } break;
+
       default:
         LOG(FATAL) << fmt::format("[notify] unknown message type: {}.", static_cast<int>(message->type));
         break;
@@ -19,6 +19,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,8 @@ enum class Type : int8_t {
   kCleanPartitionCache = 2,
   kSetDirQuota = 3,
   kDeleteDirQuota = 4,
+  kFollowFs = 5,
+  kUpdateDentry = 6,
 };
 
 struct Message {
@@ -112,6 +115,39 @@ struct DeleteDirQuotaMessage : public Message {
   std::string uuid;
 };
 
+// follower mds subscribe fs change from owner mds
+struct FollowFsMessage : public Message {
+  FollowFsMessage(uint64_t mds_id, uint32_t fs_id, uint64_t follower_mds_id)
+      : Message{Type::kFollowFs, mds_id, fs_id}, follower_mds_id(follower_mds_id) {}
+
+  static MessageSPtr Create(uint64_t mds_id, uint32_t fs_id, uint64_t follower_mds_id) {
+    return std::make_shared<FollowFsMessage>(mds_id, fs_id, follower_mds_id);
+  }
+
+  uint64_t follower_mds_id{0};
+};
+
+// owner push dentry change of one mutation to follower mds, deleted names are
+// applied before put dentries
+struct UpdateDentryMessage : public Message {
+  UpdateDentryMessage(uint64_t mds_id, uint32_t fs_id, Ino ino, uint64_t version,
+                      std::vector<std::string>&& deleted_names, std::vector<DentryEntry>&& dentries)
+      : Message{Type::kUpdateDentry, mds_id, fs_id, version},
+        ino(ino),
+        deleted_names(std::move(deleted_names)),
+        dentries(std::move(dentries)) {}
+
+  static MessageSPtr Create(uint64_t mds_id, uint32_t fs_id, Ino ino, uint64_t version,
+                            std::vector<std::string>&& deleted_names, std::vector<DentryEntry>&& dentries) {
+    return std::make_shared<UpdateDentryMessage>(mds_id, fs_id, ino, version, std::move(deleted_names),
+                                                 std::move(dentries));
+  }
+
+  Ino ino{0};
+  std::vector<std::string> deleted_names;
+  std::vector<DentryEntry> dentries;
+};
+
 class NotifyBuddy;
 using NotifyBuddySPtr = std::shared_ptr<NotifyBuddy>;
 
@@ -134,6 +170,8 @@ class NotifyBuddy {
 
   // mds_id -> messages
   static std::map<uint64_t, BatchMessage> GroupingByMdsID(const std::vector<MessageSPtr>& messages);
+  // keep only the newest refresh inode message of same inode and target
+  static void CoalesceRefreshInode(std::vector<MessageSPtr>& messages);
   void DispatchMessage();
   void LaunchSendMessage(uint64_t mds_id, const BatchMessage& batch_message);
   void SendMessage(uint64_t mds_id, BatchMessage& batch_message);
@@ -70,10 +70,11 @@ void Partition::Put(const Dentry& dentry, uint64_t version) {
     it->second = dentry;
   } else {
     children_[dentry.Name()] = dentry;
-
-    AddDeltaDentryOp(DentryOp{DentryOpType::ADD, version, dentry});
   }
 
+  // ADD is upsert, replaced dentry also need to be logged
+  AddDeltaDentryOp(DentryOp{DentryOpType::ADD, version, dentry});
+
   delta_version_ = std::max(version, delta_version_);
 }
 
@@ -118,6 +119,35 @@ void Partition::Delete(const std::vector<std::string>& names, uint64_t version)
   delta_version_ = std::max(version, delta_version_);
 }
 
+bool Partition::ApplyDelta(uint64_t version, const std::vector<std::string>& deleted_names,
+                           const std::vector<Dentry>& dentries) {
+  utils::WriteLockGuard lk(lock_);
+
+  if (version <= base_version_) return true;
+  // same version is one mutation or one batch txn
+  if (version < delta_version_) return false;
+
+  for (const auto& name : deleted_names) {
+    Dentry detry(name);
+    auto it = children_.find(name);
+    if (it != children_.end()) {
+      detry = it->second;
+      children_.erase(it);
+    }
+
+    AddDeltaDentryOp(DentryOp{DentryOpType::DELETE, version, detry});
+  }
+
+  for (const auto& dentry : dentries) {
+    children_[dentry.Name()] = dentry;
+    AddDeltaDentryOp(DentryOp{DentryOpType::ADD, version, dentry});
+  }
+
+  delta_version_ = version;
+
+  return true;
+}
+
 bool Partition::Empty() {
   utils::ReadLockGuard lk(lock_);
 
@@ -178,6 +208,30 @@ std::vector<Dentry> Partition::GetAll() {
   return dentries;
 }
 
+Partition::Cursor Partition::GetCursor() {
+  utils::ReadLockGuard lk(lock_);
+
+  return Cursor{epoch_, delta_seq_};
+}
+
+bool Partition::ScanDelta(const Cursor& cursor, uint32_t limit, std::vector<DentryDelta>& deltas,
+                          Cursor& cur_cursor) {
+  utils::ReadLockGuard lk(lock_);
+
+  cur_cursor = Cursor{epoch_, delta_seq_};
+
+  if (cursor.epoch != epoch_ || cursor.seq < delta_min_seq_ || cursor.seq > delta_seq_) return false;
+  if (limit > 0 && delta_seq_ - cursor.seq > limit) return false;
+
+  deltas.reserve(delta_seq_ - cursor.seq);
+  for (auto it = delta_dentry_ops_.rbegin(); it != delta_dentry_ops_.rend() && it->seq > cursor.seq; ++it) {
+    deltas.push_back(DentryDelta{it->op_type, it->dentry});
+  }
+  std::reverse(deltas.begin(), deltas.end());
+
+  return true;
+}
+
 bool Partition::Merge(PartitionPtr& other_partition) { return Merge(std::move(*other_partition)); }
 
 bool Partition::Merge(Partition&& other_partition) {  // NOLINT
@@ -212,6 +266,12 @@ bool Partition::Merge(Partition&& other_partition) {  // NOLINT
 
   delta_dentry_ops_.clear();
 
+  // children are rebuilt, old cursor is invalid
+  epoch_ = std::max(utils::TimestampNs(), epoch_ + 1);
+  delta_min_seq_ = delta_seq_;
+
+  verify_time_ms_.store(other_partition.VerifyTimeMs(), std::memory_order_relaxed);
+
   return true;
 }
 
@@ -219,18 +279,22 @@ void Partition::UpdateLastActiveTime() { last_active_time_s_.store(utils::Timest
 
 uint64_t Partition::LastActiveTimeS() { return last_active_time_s_.load(std::memory_order_relaxed); }
 
+void Partition::UpdateVerifyTime() { verify_time_ms_.store(utils::TimestampMs(), std::memory_order_relaxed); }
+
+uint64_t Partition::VerifyTimeMs() { return verify_time_ms_.load(std::memory_order_relaxed); }
+
 void Partition::AddDeltaDentryOp(DentryOp&& op) {
-  op.time_s = utils::Timestamp();
+  uint64_t now_s = utils::Timestamp();
+
+  op.time_s = now_s;
+  op.seq = ++delta_seq_;
   delta_dentry_ops_.push_back(std::move(op));
 
-  // clean expired ops
-  uint64_t now_s = utils::Timestamp();
-  for (auto it = delta_dentry_ops_.begin(); it != delta_dentry_ops_.end();) {
-    if (it->time_s + FLAGS_mds_partition_dentry_op_expire_interval_s < now_s) {
-      it = delta_dentry_ops_.erase(it);
-    } else {
-      ++it;
-    }
+  // clean expired ops, ops are appended in time order
+  while (!delta_dentry_ops_.empty() &&
+         delta_dentry_ops_.front().time_s + FLAGS_mds_partition_dentry_op_expire_interval_s < now_s) {
+    delta_min_seq_ = delta_dentry_ops_.front().seq;
+    delta_dentry_ops_.pop_front();
   }
 }
 
@@ -25,6 +25,7 @@
 #include "json/value.h"
 #include "mds/filesystem/dentry.h"
 #include "mds/filesystem/inode.h"
+#include "utils/time.h"
 
 namespace dingofs {
 namespace mds {
@@ -34,15 +35,37 @@ using PartitionPtr = std::shared_ptr<Partition>;
 
 class Partition {
  public:
-  Partition(InodeSPtr inode) : ino_(inode->Ino()), inode_(inode), base_version_(inode->Version()) {};
+  Partition(InodeSPtr inode)
+      : ino_(inode->Ino()),
+        inode_(inode),
+        base_version_(inode->Version()),
+        epoch_(utils::TimestampNs()),
+        verify_time_ms_(utils::TimestampMs()) {};
   Partition(Partition&& partition) noexcept : ino_(partition.ino_) {
     inode_ = partition.inode_;
     base_version_ = partition.base_version_;
     delta_version_ = partition.delta_version_;
+    epoch_ = partition.epoch_;
+    delta_seq_ = partition.delta_seq_;
+    delta_min_seq_ = partition.delta_min_seq_;
+    verify_time_ms_ = partition.verify_time_ms_.load(std::memory_order_relaxed);
     children_.swap(partition.children_);
     delta_dentry_ops_.swap(partition.delta_dentry_ops_);
   }
 
+  enum class DentryOpType : uint8_t { ADD = 0, DELETE = 1 };
+
+  // position in dentry change log, epoch changes when children are rebuilt
+  struct Cursor {
+    uint64_t epoch{0};
+    uint64_t seq{0};
+  };
+
+  struct DentryDelta {
+    DentryOpType op_type;
+    Dentry dentry;
+  };
+
   ~Partition() = default;
 
   static PartitionPtr New(InodeSPtr& inode) { return std::make_shared<Partition>(inode); }
@@ -62,6 +85,11 @@ class Partition {
   void Delete(const std::string& name, uint64_t version);
   void Delete(const std::vector<std::string>& names, uint64_t version);
 
+  // apply dentry change of follower, change already in base is skipped.
+  // return false when it is older than applied change, children may be stale.
+  bool ApplyDelta(uint64_t version, const std::vector<std::string>& deleted_names,
+                  const std::vector<Dentry>& dentries);
+
   bool Empty();
   size_t Size();
   size_t Bytes();
@@ -70,12 +98,21 @@ class Partition {
   std::vector<Dentry> Scan(const std::string& start_name, uint32_t limit, bool is_only_dir);
   std::vector<Dentry> GetAll();
 
+  Cursor GetCursor();
+  // get dentry changes after cursor in apply order, return false when the
+  // changes are not complete(expired or children rebuilt) or exceed limit.
+  bool ScanDelta(const Cursor& cursor, uint32_t limit, std::vector<DentryDelta>& deltas, Cursor& cur_cursor);
+
   bool Merge(PartitionPtr& other_partition);
   bool Merge(Partition&& other_partition);
 
   void UpdateLastActiveTime();
   uint64_t LastActiveTimeS();
 
+  // last time children are confirmed up to date, used by follower read to bound staleness
+  void UpdateVerifyTime();
+  uint64_t VerifyTimeMs();
+
  private:
   const Ino ino_;
 
@@ -89,20 +126,26 @@ class Partition {
   // name -> dentry
   absl::btree_map<std::string, Dentry> children_;
 
-  // version -> dentry
-  enum class DentryOpType : uint8_t { ADD = 0, DELETE = 1 };
+  // dentry change log, ordered by seq which is the apply order
+  // version may be out of order because of concurrent mutation
+  uint64_t epoch_{0};
+  uint64_t delta_seq_{0};
+  // ops whose seq <= delta_min_seq_ have been dropped
+  uint64_t delta_min_seq_{0};
 
   struct DentryOp {
     DentryOpType op_type;
     uint64_t version;
     Dentry dentry;
     uint64_t time_s;
+    uint64_t seq;
   };
   void AddDeltaDentryOp(DentryOp&& op);
 
   std::list<DentryOp> delta_dentry_ops_;
 
   std::atomic<uint64_t> last_active_time_s_{0};
+  std::atomic<uint64_t> verify_time_ms_{0};
 };
 
 class PartitionCache {
@@ -16,21 +16,29 @@
 #include <fcntl.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "brpc/reloadable_flags.h"
 #include "bthread/bthread.h"
+#include "bthread/mutex.h"
 #include "bthread/types.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
 #include "common/const.h"
 #include "dingofs/error.pb.h"
 #include "dingofs/mds.pb.h"
 #include "fmt/format.h"
 #include "glog/logging.h"
 #include "mds/common/codec.h"
+#include "mds/common/event_log.h"
 #include "mds/common/helper.h"
 #include "mds/common/status.h"
 #include "mds/common/type.h"
@@ -56,6 +64,24 @@ DEFINE_validator(mds_store_operation_merge_delay_us, brpc::PassValidate);
 DEFINE_bool(mds_tiny_file_data_enable, false, "enable tiny file data feature.");
 DEFINE_validator(mds_tiny_file_data_enable, brpc::PassValidate);
 
+DEFINE_bool(mds_store_operation_inode_serial_enable, true,
+            "run batch operation of same inode one by one, merge the arrived ones into next batch.");
+DEFINE_validator(mds_store_operation_inode_serial_enable, brpc::PassValidate);
+
+DEFINE_bool(mds_store_operation_multi_inode_batch_enable, false,
+            "commit batch operations of different inodes arrived in one merge window by one txn.");
+DEFINE_validator(mds_store_operation_multi_inode_batch_enable, brpc::PassValidate);
+
+DEFINE_uint32(mds_store_operation_multi_inode_batch_max_num, 32, "max inode num of one multi inode batch txn.");
+DEFINE_validator(mds_store_operation_multi_inode_batch_max_num, brpc::PassValidate);
+
+DEFINE_bool(mds_chunk_delta_enable, false,
+            "write new slices as append-only chunk delta record, keep it on once enabled.");
+DEFINE_validator(mds_chunk_delta_enable, brpc::PassValidate);
+
+DEFINE_uint32(mds_chunk_delta_max_num, 64, "max delta record num of one chunk, fold into base when reach.");
+DEFINE_validator(mds_chunk_delta_max_num, brpc::PassValidate);
+
 DECLARE_uint32(mds_filesession_live_time_s);
 
 static const uint32_t kOpNameBufInitSize = 128;
@@ -63,6 +89,9 @@ static const uint32_t kCleanCompactedSliceIntervalS = 180;  // 3 minutes
 
 static const uint32_t kScheduleThreadNum = 1;
 
+// file session expire index time bucket, keepalive move index only when cross bucket
+static const uint64_t kFileSessionExpireBucketS = 60;
+
 static uint32_t CalWaitTimeUs(int retry) {
   // exponential backoff
   return Helper::GenerateRealRandomInteger(1000, 5000) * (1 << retry);
@@ -76,6 +105,61 @@ static bool IsRetry(uint32_t& retry) {
   return false;
 }
 
+// operations merged into the pending batch of running inode
+static bvar::Adder<uint64_t> g_operation_serial_merge_count("mds_operation_serial_merge_count");
+
+// multi inode batch statistics
+static bvar::LatencyRecorder g_multi_inode_batch_size_recorder("mds_operation_multi_inode_batch", "size");
+static bvar::Adder<uint64_t> g_multi_inode_batch_saved_commit_count(
+    "mds_operation_multi_inode_batch_saved_commit_count");
+static bvar::Adder<uint64_t> g_multi_inode_batch_split_count("mds_operation_multi_inode_batch_split_count");
+
+// conflict and retry statistics of one op type
+struct OperationStat {
+  OperationStat(const std::string& op_name)
+      : conflict_count(fmt::format("mds_operation_{}", op_name), "conflict_count"),
+        retry_recorder(fmt::format("mds_operation_{}", op_name), "retry") {}
+
+  bvar::Adder<uint64_t> conflict_count;
+  // distribution of retry times
+  bvar::LatencyRecorder retry_recorder;
+};
+
+// index by op type, created at first use and live with process
+static std::array<std::atomic<OperationStat*>, 256> g_operation_stats;
+
+static OperationStat& GetOperationStat(Operation* operation) {
+  auto& slot = g_operation_stats[static_cast<uint8_t>(operation->GetOpType())];
+  auto* stat = slot.load(std::memory_order_acquire);
+  if (stat != nullptr) return *stat;
+
+  auto* new_stat = new OperationStat(operation->OpName());
+  if (slot.compare_exchange_strong(stat, new_stat, std::memory_order_acq_rel)) return *new_stat;
+
+  delete new_stat;
+  return *stat;
+}
+
+static void RecordConflict(BatchOperation& batch_operation) {
+  for (auto* operation : batch_operation.setattr_operations) {
+    GetOperationStat(operation).conflict_count << 1;
+  }
+
+  for (auto* operation : batch_operation.create_operations) {
+    GetOperationStat(operation).conflict_count << 1;
+  }
+}
+
+static void RecordRetry(BatchOperation& batch_operation, uint32_t retry) {
+  for (auto* operation : batch_operation.setattr_operations) {
+    GetOperationStat(operation).retry_recorder << retry;
+  }
+
+  for (auto* operation : batch_operation.create_operations) {
+    GetOperationStat(operation).retry_recorder << retry;
+  }
+}
+
 static std::string FindValue(const std::vector<KeyValue>& kvs, const std::string& key) {
   for (const auto& kv : kvs) {
     if (kv.key == key) {
@@ -130,6 +214,44 @@ static void Notify(BatchOperation& batch_operation) {
   }
 }
 
+static bool IsEmpty(const BatchOperation& batch_operation) {
+  return batch_operation.setattr_operations.empty() && batch_operation.create_operations.empty();
+}
+
+// run operations of batch in txn, return the first failed operation
+static Status RunBatchOperation(TxnUPtr& txn, BatchOperation& batch_operation, AttrEntry& attr,
+                                const std::vector<KeyValue>& prefetch_kvs, Operation*& failed_operation) {
+  for (auto* operation : batch_operation.setattr_operations) {
+    auto status = operation->RunInBatch(txn, attr, prefetch_kvs);
+    if (!status.ok()) {
+      failed_operation = operation;
+      return status;
+    }
+  }
+
+  for (auto* operation : batch_operation.create_operations) {
+    auto status = operation->RunInBatch(txn, attr, prefetch_kvs);
+    if (!status.ok()) {
+      failed_operation = operation;
+      return status;
+    }
+  }
+
+  return Status::OK();
+}
+
+// finish failed operation and remove it from batch, its writes are discarded with the txn
+static void DropOperation(BatchOperation& batch_operation, Operation* operation, const Status& status) {
+  auto remove_fn = [operation](std::vector<Operation*>& operations) {
+    operations.erase(std::remove(operations.begin(), operations.end(), operation), operations.end());
+  };
+  remove_fn(batch_operation.setattr_operations);
+  remove_fn(batch_operation.create_operations);
+
+  operation->SetStatus(status);
+  operation->NotifyEvent();
+}
+
 static void SetTrace(BatchOperation& batch_operation, const Trace::Txn& txn_trace) {
   for (auto* operation : batch_operation.setattr_operations) {
     operation->GetTrace().AddTxn(txn_trace);
@@ -150,6 +272,21 @@ static void SetElapsedTime(BatchOperation& batch_operation, const std::string& n
   }
 }
 
+static uint64_t FileSessionExpireBucket(uint64_t expire_time_s) { return expire_time_s / kFileSessionExpireBucketS; }
+
+static std::string EncodeFileSessionExpireKey(const FileSessionEntry& file_session) {
+  uint64_t bucket = FileSessionExpireBucket(file_session.expire_time_s());
+  return MetaCodec::EncodeFileSessionExpireKey(file_session.fs_id(), bucket, file_session.ino(),
+                                               file_session.session_id());
+}
+
+// put file session and its expire index
+static void PutFileSession(TxnUPtr& txn, const FileSessionEntry& file_session) {
+  txn->Put(MetaCodec::EncodeFileSessionKey(file_session.fs_id(), file_session.ino(), file_session.session_id()),
+           MetaCodec::EncodeFileSessionValue(file_session));
+  txn->Put(EncodeFileSessionExpireKey(file_session), file_session.client_id());
+}
+
 static bool IsExistMountPoint(const FsInfoEntry& fs_info, const pb::mds::MountPoint& mountpoint) {
   for (const auto& mp : fs_info.mount_points()) {
     if (mp.client_id() == mountpoint.client_id()) {
@@ -309,12 +446,21 @@ const char* Operation::OpName() const {
     case OpType::kDeleteFileSession:
       return "DeleteFileSession";
 
+    case OpType::kScanExpiredFileSession:
+      return "ScanExpiredFileSession";
+
     case OpType::kCleanDelSlice:
       return "CleanDelSlice";
 
     case OpType::kCleanDelFile:
       return "CleanDelFile";
 
+    case OpType::kCleanDelPack:
+      return "CleanDelPack";
+
+    case OpType::kAddPendingPack:
+      return "AddPendingPack";
+
     case OpType::kScanLock:
       return "ScanLock";
 
@@ -333,6 +479,9 @@ const char* Operation::OpName() const {
     case OpType::kScanDelSlice:
       return "ScanDelSlice";
 
+    case OpType::kScanDelPack:
+      return "ScanDelPack";
+
     case OpType::kScanMetaTable:
       return "ScanMetaTable";
 
@@ -666,9 +815,24 @@ Status UpdateFsRecycleProgressOperation::Run(TxnUPtr& txn) {
 
   auto fs_info = MetaCodec::DecodeFsValue(value);
 
+  // count the file only once, remove its inode in same txn, so retry or rescan
+  // of the same file after commit not count it again
+  std::string inode_key = MetaCodec::EncodeInodeKey(fs_info.fs_id(), ino_);
+  std::string inode_value;
+  status = txn->Get(inode_key, inode_value);
+  if (!status.ok() && status.error_code() != pb::error::ENOT_FOUND) {
+    return status;
+  }
+  const bool is_counted = !status.ok();
+
   auto* recycle_progress = fs_info.mutable_recycle_progress();
   recycle_progress->set_last_ino(ino_);
   recycle_progress->set_last_time_ms(GetTime() / 1e6);
+  if (!is_counted) {
+    recycle_progress->set_deleted_file_num(recycle_progress->deleted_file_num() + 1);
+    recycle_progress->set_deleted_block_num(recycle_progress->deleted_block_num() + deleted_block_num_);
+    txn->Delete(inode_key);
+  }
 
   txn->Put(fs_key, MetaCodec::EncodeFsValue(fs_info));
 
@@ -792,8 +956,7 @@ Status BatchCreateFileOperation::RunInBatch(TxnUPtr& txn, AttrEntry& parent_attr
     txn->Put(MetaCodec::EncodeInodeKey(fs_id, dentry.INo()), MetaCodec::EncodeInodeValue(attr));
 
     // add file session
-    txn->Put(MetaCodec::EncodeFileSessionKey(file_session->fs_id(), file_session->ino(), file_session->session_id()),
-             MetaCodec::EncodeFileSessionValue(*file_session));
+    PutFileSession(txn, *file_session);
   }
 
   // update parent attr
@@ -873,29 +1036,193 @@ Status SmyLinkOperation::RunInBatch(TxnUPtr& txn, AttrEntry& parent_attr, const
   return Status::OK();
 }
 
-static Status GetChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, uint64_t chunk_index, ChunkEntry& chunk) {
-  std::string value;
-  auto status = txn->Get(MetaCodec::EncodeChunkKey(fs_id, ino, chunk_index), value);
+// chunk is stored as one base record and some append-only delta records,
+// delta record only carry the new slices of one write and is keyed by the version it produced,
+// so reader merge them in key order, and writer fold them into base when rewrite whole chunk.
+// every writer touch the delta key of the version it produced, append put it and fold delete it,
+// so concurrent append and fold of the same version conflict in txn instead of both commit,
+// otherwise the appended delta is skipped by the folded base and its slices are lost.
+struct ChunkRecord {
+  ChunkEntry chunk;
+  // delta record keys merged into chunk
+  std::vector<std::string> delta_keys;
+};
+
+static bool DecodeChunkIndex(const std::string& key, uint64_t& chunk_index) {
+  uint32_t fs_id;
+  Ino ino;
+  if (MetaCodec::IsChunkKey(key)) {
+    MetaCodec::DecodeChunkKey(key, fs_id, ino, chunk_index);
+    return true;
+  }
+
+  if (MetaCodec::IsChunkDeltaKey(key)) {
+    uint64_t version;
+    MetaCodec::DecodeChunkDeltaKey(key, fs_id, ino, chunk_index, version);
+    return true;
+  }
+
+  return false;
+}
+
+// merge base or delta record, base record is always scanned before its delta records
+static void MergeChunkRecord(const std::string& key, const std::string& value,
+                             std::map<uint64_t, ChunkRecord>& records) {
+  uint32_t fs_id;
+  Ino ino;
+  uint64_t chunk_index;
+  if (MetaCodec::IsChunkKey(key)) {
+    MetaCodec::DecodeChunkKey(key, fs_id, ino, chunk_index);
+    records[chunk_index].chunk = MetaCodec::DecodeChunkValue(value);
+    return;
+  }
+
+  if (!MetaCodec::IsChunkDeltaKey(key)) return;
+
+  uint64_t version;
+  MetaCodec::DecodeChunkDeltaKey(key, fs_id, ino, chunk_index, version);
+
+  auto& record = records[chunk_index];
+  record.delta_keys.push_back(key);
+  // already folded into base
+  if (version <= record.chunk.version()) return;
+
+  auto delta = MetaCodec::DecodeChunkValue(value);
+  auto& chunk = record.chunk;
+  if (chunk.version() == 0) {
+    chunk.set_index(delta.index());
+    chunk.set_chunk_size(delta.chunk_size());
+    chunk.set_block_size(delta.block_size());
+  }
+  for (auto& slice : *delta.mutable_slices()) {
+    chunk.add_slices()->Swap(&slice);
+  }
+  chunk.set_version(version);
+}
+
+static Status ScanChunk(TxnUPtr& txn, const Range& range, std::map<uint64_t, ChunkRecord>& records) {
+  return txn->Scan(range, [&](const std::string& key, const std::string& value) -> bool {
+    MergeChunkRecord(key, value, records);
+    return true;
+  });
+}
+
+static Status ScanChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, std::map<uint64_t, ChunkRecord>& records) {
+  return ScanChunk(txn, MetaCodec::GetChunkRange(fs_id, ino), records);
+}
+
+// delta records are only written with mds_chunk_delta_enable, otherwise get base record by key
+static Status GetChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, uint64_t chunk_index, ChunkRecord& record) {
+  if (!FLAGS_mds_chunk_delta_enable) {
+    std::string value;
+    auto status = txn->Get(MetaCodec::EncodeChunkKey(fs_id, ino, chunk_index), value);
+    if (!status.ok()) return status;
+
+    record.chunk = MetaCodec::DecodeChunkValue(value);
+    return Status::OK();
+  }
+
+  std::map<uint64_t, ChunkRecord> records;
+  auto status = ScanChunk(txn, MetaCodec::GetChunkIndexRange(fs_id, ino, chunk_index), records);
   if (!status.ok()) return status;
 
-  chunk = MetaCodec::DecodeChunkValue(value);
+  auto it = records.find(chunk_index);
+  if (it == records.end()) {
+    return Status(pb::error::ENOT_FOUND, fmt::format("not found chunk({})", chunk_index));
+  }
+
+  record = std::move(it->second);
 
   return Status::OK();
 }
 
-static Status ScanChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, std::map<uint64_t, ChunkEntry>& chunks) {
-  Range range = MetaCodec::GetChunkRange(fs_id, ino);
+// not exist chunk is skipped
+static Status BatchGetChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, const std::vector<uint32_t>& chunk_indexes,
+                            std::map<uint64_t, ChunkRecord>& records) {
+  if (FLAGS_mds_chunk_delta_enable) {
+    for (const auto& chunk_index : chunk_indexes) {
+      if (records.count(chunk_index) > 0) continue;
 
-  auto status = txn->Scan(range, [&](const std::string& key, const std::string& value) -> bool {
-    if (!MetaCodec::IsChunkKey(key)) return true;
+      ChunkRecord record;
+      auto status = GetChunk(txn, fs_id, ino, chunk_index, record);
+      if (status.error_code() == pb::error::ENOT_FOUND) continue;
+      if (!status.ok()) return status;
 
-    auto chunk = MetaCodec::DecodeChunkValue(value);
-    chunks.insert({chunk.index(), std::move(chunk)});
+      records[chunk_index] = std::move(record);
+    }
 
+    return Status::OK();
+  }
+
+  std::vector<std::string> keys;
+  keys.reserve(chunk_indexes.size());
+  for (const auto& chunk_index : chunk_indexes) {
+    keys.push_back(MetaCodec::EncodeChunkKey(fs_id, ino, chunk_index));
+  }
+
+  std::vector<KeyValue> kvs;
+  auto status = txn->BatchGet(keys, kvs);
+  if (!status.ok()) return status;
+
+  for (const auto& kv : kvs) {
+    MergeChunkRecord(kv.key, kv.value, records);
+  }
+
+  return Status::OK();
+}
+
+// rewrite whole chunk as base record, fold all its delta records
+static void PutChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, ChunkRecord& record) {
+  const auto& chunk = record.chunk;
+  txn->Put(MetaCodec::EncodeChunkKey(fs_id, ino, chunk.index()), MetaCodec::EncodeChunkValue(chunk));
+
+  for (const auto& delta_key : record.delta_keys) {
+    txn->Delete(delta_key);
+  }
+  record.delta_keys.clear();
+
+  // fence append of the same version
+  txn->Delete(MetaCodec::EncodeChunkDeltaKey(fs_id, ino, chunk.index(), chunk.version()));
+}
+
+// mark the packed slice of file live when committed and dead when dropped,
+// pack object is deleted by gc when none of its slices is live
+static void PutPackRef(TxnUPtr& txn, uint32_t fs_id, Ino ino, const SliceEntry& slice, bool is_live) {
+  txn->Put(MetaCodec::EncodeDelPackKey(fs_id, slice.id(), ino),
+           MetaCodec::EncodeDelPackValue(slice.pack_refs(), utils::TimestampNs(), is_live));
+}
+
+// delete chunk [start_index, end_index) with their delta records
+static Status DeleteChunk(TxnUPtr& txn, uint32_t fs_id, Ino ino, uint64_t start_index, uint64_t end_index) {
+  if (start_index >= end_index) return Status::OK();
+
+  Range range;
+  range.start = MetaCodec::EncodeChunkKey(fs_id, ino, start_index);
+  range.end = MetaCodec::EncodeChunkKey(fs_id, ino, end_index);
+
+  std::vector<std::string> keys;
+  std::map<uint64_t, ChunkRecord> records;
+  auto status = txn->Scan(range, [&](const std::string& key, const std::string& value) -> bool {
+    keys.push_back(key);
+    MergeChunkRecord(key, value, records);
     return true;
   });
+  if (!status.ok()) return status;
 
-  return status;
+  for (const auto& key : keys) {
+    txn->Delete(key);
+  }
+
+  // fence append of the next version, and packed slice is dropped with chunk, e.g. truncate
+  for (const auto& [chunk_index, record] : records) {
+    txn->Delete(MetaCodec::EncodeChunkDeltaKey(fs_id, ino, chunk_index, record.chunk.version() + 1));
+
+    for (const auto& slice : record.chunk.slices()) {
+      if (slice.pack_refs() > 0) PutPackRef(txn, fs_id, ino, slice, false);
+    }
+  }
+
+  return Status::OK();
 }
 
 static Status ResetFileRange(TxnUPtr& txn, uint32_t fs_id, Ino ino, uint64_t old_length, uint64_t new_length,
@@ -910,11 +1237,12 @@ static Status ResetFileRange(TxnUPtr& txn, uint32_t fs_id, Ino ino, uint64_t old
   uint64_t chunk_version = 0;
   SliceEntry slice;
   if (new_length % chunk_size != 0) {
-    ChunkEntry chunk;
-    auto status = GetChunk(txn, fs_id, ino, new_num - 1, chunk);
+    ChunkRecord record;
+    auto status = GetChunk(txn, fs_id, ino, new_num - 1, record);
     if (!status.ok() && status.error_code() != pb::error::ENOT_FOUND) {
       return Status(status.error_code(), fmt::format("retfilerange fail({})", status.error_str()));
     }
+    auto& chunk = record.chunk;
 
     slice.set_id(slice_id);
     slice.set_offset(new_length);
@@ -924,13 +1252,15 @@ static Status ResetFileRange(TxnUPtr& txn, uint32_t fs_id, Ino ino, uint64_t old
 
     *chunk.add_slices() = slice;
 
+    chunk.set_index(new_num - 1);
     chunk.set_version(chunk.version() + 1);
-    txn->Put(MetaCodec::EncodeChunkKey(fs_id, ino, new_num - 1), MetaCodec::EncodeChunkValue(chunk));
+    PutChunk(txn, fs_id, ino, record);
     chunk_version = chunk.version();
   }
 
-  for (uint32_t i = new_num; i < old_num; ++i) {
-    txn->Delete(MetaCodec::EncodeChunkKey(fs_id, ino, i));
+  auto status = DeleteChunk(txn, fs_id, ino, new_num, old_num);
+  if (!status.ok()) {
+    return Status(status.error_code(), fmt::format("retfilerange fail({})", status.error_str()));
   }
 
   LOG(INFO) << fmt::format("[operation.{}.{}] reset file range, length({},{}) chunk_num({},{},{}) blank_slice({}).",
@@ -1012,83 +1342,100 @@ Status RemoveXAttrOperation::RunInBatch(TxnUPtr&, AttrEntry& attr, const std::ve
   return Status::OK();
 }
 
+// clean compacted slices if expired
+static void CleanExpiredCompactedSlice(ChunkEntry& chunk, uint64_t now_ms) {
+  auto it = chunk.mutable_compacted_slices()->begin();
+  while (it != chunk.mutable_compacted_slices()->end()) {
+    if (it->time_ms() + (kCleanCompactedSliceIntervalS * 1000) < now_ms) {
+      it = chunk.mutable_compacted_slices()->erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 Status UpsertChunkOperation::Run(TxnUPtr& txn) {
   const uint32_t fs_id = fs_info_.fs_id();
   const uint64_t now_ms = utils::TimestampMs();
 
-  std::set<std::string> keys;
+  std::vector<uint32_t> chunk_indexes;
+  chunk_indexes.reserve(delta_slices_.size());
   for (const auto& delta_slices : delta_slices_) {
-    keys.insert(MetaCodec::EncodeChunkKey(fs_id, ino_, delta_slices.chunk_index()));
+    chunk_indexes.push_back(delta_slices.chunk_index());
   }
 
-  std::vector<KeyValue> kvs;
-  auto status = txn->BatchGet(std::vector<std::string>(keys.begin(), keys.end()), kvs);
+  std::map<uint64_t, ChunkRecord> records;
+  auto status = BatchGetChunk(txn, fs_id, ino_, chunk_indexes, records);
   if (!status.ok()) return status;
 
   int64_t length = 0;
   result_.effected_chunks.clear();
   for (const auto& delta_slices : delta_slices_) {
-    ChunkEntry chunk;
     const auto& chunk_index = delta_slices.chunk_index();
+    auto& record = records[chunk_index];
+    auto& chunk = record.chunk;
 
-    const std::string key = MetaCodec::EncodeChunkKey(fs_id, ino_, chunk_index);
-    auto value = FindValue(kvs, key);
-    if (!value.empty()) chunk = MetaCodec::DecodeChunkValue(value);
-
-    bool has_update = false;
     // not exist chunk, create a new one
     if (chunk.version() == 0) {
-      has_update = true;
       chunk.set_index(chunk_index);
       chunk.set_chunk_size(fs_info_.chunk_size());
       chunk.set_block_size(fs_info_.block_size());
       *chunk.mutable_slices() = delta_slices.slices();
+      chunk.set_version(1);
 
-    } else {
-      // exist chunk, update slice
-      // check if slice already exist
-      auto is_exist_fn = [&](const SliceEntry& slice) -> bool {
-        for (const auto& exist_slice : chunk.slices()) {
-          if (exist_slice.id() == slice.id()) {
-            return true;
-          }
-        }
-        for (const auto& compacted_slice : chunk.compacted_slices()) {
-          for (const uint64_t& compacted_slice_id : compacted_slice.slice_ids()) {
-            if (compacted_slice_id == slice.id()) {
-              return true;
-            }
-          }
-        }
-        return false;
-      };
+      for (const auto& slice : chunk.slices()) {
+        if (slice.pack_refs() > 0) PutPackRef(txn, fs_id, ino_, slice, true);
+      }
 
-      for (const auto& slice : delta_slices.slices()) {
-        if (is_exist_fn(slice)) continue;
+      PutChunk(txn, fs_id, ino_, record);
+      result_.effected_chunks.push_back(chunk);
+      continue;
+    }
 
-        has_update = true;
-        *chunk.add_slices() = slice;
-        length = std::max(length, static_cast<int64_t>(slice.offset() + slice.len()));
-      }
+    // exist chunk, filter out the slice already exist
+    absl::flat_hash_set<uint64_t> slice_ids;
+    slice_ids.reserve(chunk.slices_size());
+    for (const auto& exist_slice : chunk.slices()) {
+      slice_ids.insert(exist_slice.id());
+    }
+    for (const auto& compacted_slice : chunk.compacted_slices()) {
+      slice_ids.insert(compacted_slice.slice_ids().begin(), compacted_slice.slice_ids().end());
     }
 
-    if (has_update) {
-      // clean compacted slices if expired
-      auto it = chunk.mutable_compacted_slices()->begin();
-      while (it != chunk.mutable_compacted_slices()->end()) {
-        if (it->time_ms() + (kCleanCompactedSliceIntervalS * 1000) < now_ms) {
-          it = chunk.mutable_compacted_slices()->erase(it);
-        } else {
-          ++it;
-        }
-      }
+    ChunkEntry delta;
+    for (const auto& slice : delta_slices.slices()) {
+      if (!slice_ids.insert(slice.id()).second) continue;
+
+      *delta.add_slices() = slice;
+      length = std::max(length, static_cast<int64_t>(slice.offset() + slice.len()));
+
+      if (slice.pack_refs() > 0) PutPackRef(txn, fs_id, ino_, slice, true);
+    }
 
+    if (delta.slices_size() > 0) {
+      for (const auto& slice : delta.slices()) {
+        *chunk.add_slices() = slice;
+      }
       chunk.set_version(chunk.version() + 1);
 
-      txn->Put(key, MetaCodec::EncodeChunkValue(chunk));
+      if (FLAGS_mds_chunk_delta_enable && record.delta_keys.size() < FLAGS_mds_chunk_delta_max_num) {
+        // only append new slices as delta record
+        delta.set_index(chunk_index);
+        delta.set_chunk_size(chunk.chunk_size());
+        delta.set_block_size(chunk.block_size());
+        delta.set_version(chunk.version());
+
+        std::string delta_key = MetaCodec::EncodeChunkDeltaKey(fs_id, ino_, chunk_index, chunk.version());
+        txn->Put(delta_key, MetaCodec::EncodeChunkValue(delta));
+        record.delta_keys.push_back(std::move(delta_key));
+
+      } else {
+        CleanExpiredCompactedSlice(chunk, now_ms);
+        PutChunk(txn, fs_id, ino_, record);
+      }
     }
 
-    result_.effected_chunks.push_back(std::move(chunk));
+    result_.effected_chunks.push_back(chunk);
   }
 
   result_.length = length;
@@ -1097,19 +1444,13 @@ Status UpsertChunkOperation::Run(TxnUPtr& txn) {
 }
 
 Status GetChunkOperation::Run(TxnUPtr& txn) {
-  std::vector<std::string> keys;
-  keys.reserve(chunk_indexes_.size());
-  for (const auto& chunk_index : chunk_indexes_) {
-    keys.push_back(MetaCodec::EncodeChunkKey(fs_id_, ino_, chunk_index));
-  }
-
-  std::vector<KeyValue> kvs;
-  auto status = txn->BatchGet(keys, kvs);
+  std::map<uint64_t, ChunkRecord> records;
+  auto status = BatchGetChunk(txn, fs_id_, ino_, chunk_indexes_, records);
   if (!status.ok()) return status;
 
   result_.chunks.clear();
-  for (const auto& kv : kvs) {
-    result_.chunks.push_back(MetaCodec::DecodeChunkValue(kv.value));
+  for (auto& [_, record] : records) {
+    result_.chunks.push_back(std::move(record.chunk));
   }
 
   return Status::OK();
@@ -1117,20 +1458,37 @@ Status GetChunkOperation::Run(TxnUPtr& txn) {
 
 Status ScanChunkOperation::Run(TxnUPtr& txn) {
   Range range = MetaCodec::GetChunkRange(fs_id_, ino_);
+  if (start_chunk_index_ > 0) range.start = MetaCodec::EncodeChunkKey(fs_id_, ino_, start_chunk_index_);
 
-  result_.chunks.clear();
+  std::map<uint64_t, ChunkRecord> records;
   uint32_t slice_num = 0;
-  return txn->Scan(range, [&](const std::string& key, const std::string& value) -> bool {
-    if (!MetaCodec::IsChunkKey(key)) return true;
+  uint64_t last_chunk_index = UINT64_MAX;
+  auto status = txn->Scan(range, [&](const std::string& key, const std::string& value) -> bool {
+    uint64_t chunk_index = 0;
+    if (!DecodeChunkIndex(key, chunk_index)) return true;
 
-    auto chunk = MetaCodec::DecodeChunkValue(value);
-    slice_num += chunk.slices_size();
-    result_.chunks.push_back(std::move(chunk));
+    // stop at chunk boundary, so returned chunk is always merged completely
+    if (chunk_index != last_chunk_index && last_chunk_index != UINT64_MAX) {
+      slice_num += records[last_chunk_index].chunk.slices_size();
+      if (max_slice_num_ != 0 && slice_num >= max_slice_num_) return false;
+    }
+    last_chunk_index = chunk_index;
 
-    if (max_slice_num_ != 0 && slice_num >= max_slice_num_) return false;
+    MergeChunkRecord(key, value, records);
 
     return true;
   });
+  if (!status.ok()) return status;
+
+  result_.chunks.clear();
+  result_.chunks.reserve(records.size());
+  for (auto& [chunk_index, record] : records) {
+    // caller page by index of last chunk
+    record.chunk.set_index(chunk_index);
+    result_.chunks.push_back(std::move(record.chunk));
+  }
+
+  return Status::OK();
 }
 
 Status CleanChunkOperation::Run(TxnUPtr& txn) {
@@ -1138,7 +1496,8 @@ Status CleanChunkOperation::Run(TxnUPtr& txn) {
   CHECK(ino_ > 0) << " ino is 0.";
 
   for (auto& chunk_index : chunk_indexs_) {
-    txn->Delete(MetaCodec::EncodeChunkKey(fs_id_, ino_, chunk_index));
+    auto status = DeleteChunk(txn, fs_id_, ino_, chunk_index, chunk_index + 1);
+    if (!status.ok()) return status;
   }
 
   return Status::OK();
@@ -1157,9 +1516,10 @@ Status FallocateOperation::PreAlloc(TxnUPtr& txn, AttrEntry& attr, uint64_t offs
   uint64_t slice_id = param_.slice_id;
   const uint32_t slice_num = param_.slice_num;
 
-  ChunkEntry max_chunk;
-  auto status = GetChunk(txn, fs_id, ino, length / chunk_size, max_chunk);
+  ChunkRecord max_record;
+  auto status = GetChunk(txn, fs_id, ino, length / chunk_size, max_record);
   if (!status.ok()) return status;
+  auto& max_chunk = max_record.chunk;
 
   std::vector<ChunkEntry> effected_chunks;
   uint32_t count = 0;
@@ -1192,7 +1552,7 @@ Status FallocateOperation::PreAlloc(TxnUPtr& txn, AttrEntry& attr, uint64_t offs
 
     } else {
       max_chunk.add_slices()->Swap(&slice);
-      txn->Put(MetaCodec::EncodeChunkKey(fs_id, ino, chunk_index), MetaCodec::EncodeChunkValue(max_chunk));
+      PutChunk(txn, fs_id, ino, max_record);
       effected_chunks.push_back(max_chunk);
     }
 
@@ -1224,8 +1584,8 @@ Status FallocateOperation::SetZero(TxnUPtr& txn, AttrEntry& attr, uint64_t offse
   uint64_t end_offset = keep_size ? std::min(attr.length(), offset + len) : (offset + len);
 
   // scan chunks
-  std::map<uint64_t, ChunkEntry> chunks;
-  auto status = ScanChunk(txn, fs_id, ino, chunks);
+  std::map<uint64_t, ChunkRecord> records;
+  auto status = ScanChunk(txn, fs_id, ino, records);
   if (!status.ok()) return status;
 
   std::vector<ChunkEntry> effected_chunks;
@@ -1244,8 +1604,8 @@ Status FallocateOperation::SetZero(TxnUPtr& txn, AttrEntry& attr, uint64_t offse
     slice.set_zero(true);
 
     // todo
-    auto it = chunks.find(chunk_index);
-    if (it == chunks.end()) {
+    auto it = records.find(chunk_index);
+    if (it == records.end()) {
       ChunkEntry chunk;
       chunk.set_index(chunk_index);
       chunk.set_chunk_size(chunk_size);
@@ -1257,9 +1617,9 @@ Status FallocateOperation::SetZero(TxnUPtr& txn, AttrEntry& attr, uint64_t offse
       effected_chunks.push_back(std::move(chunk));
 
     } else {
-      auto& chunk = it->second;
+      auto& chunk = it->second.chunk;
       chunk.add_slices()->Swap(&slice);
-      txn->Put(MetaCodec::EncodeChunkKey(fs_id, ino, chunk_index), MetaCodec::EncodeChunkValue(chunk));
+      PutChunk(txn, fs_id, ino, it->second);
       effected_chunks.push_back(chunk);
     }
 
@@ -1314,25 +1674,23 @@ Status FallocateOperation::RunInBatch(TxnUPtr& txn, AttrEntry& attr, const std::
   return Status::OK();
 }
 
-void OpenFileOperation::ResetFileRange(TxnUPtr& txn, uint64_t length) {
+Status OpenFileOperation::ResetFileRange(TxnUPtr& txn, uint64_t length) {
   const uint32_t fs_id = file_session_.fs_id();
   const Ino ino = file_session_.ino();
 
   uint32_t old_num = (length / chunk_size_) + ((length % chunk_size_) != 0 ? 1 : 0);
 
-  for (uint32_t i = 0; i < old_num; ++i) {
-    txn->Delete(MetaCodec::EncodeChunkKey(fs_id, ino, i));
-  }
+  return DeleteChunk(txn, fs_id, ino, 0, old_num);
 }
 
+// chunk is merged from base and delta records, so only prefetch by key when delta is disabled
 std::vector<std::string> OpenFileOperation::PrefetchKey() {
   std::vector<std::string> keys;
 
-  if (prefetch_chunks_.empty() && !prefetch_data_) return keys;
-
-  keys.reserve(prefetch_chunks_.size() + 1);
-  for (const auto& chunk_index : prefetch_chunks_) {
-    keys.push_back(MetaCodec::EncodeChunkKey(file_session_.fs_id(), file_session_.ino(), chunk_index));
+  if (!FLAGS_mds_chunk_delta_enable) {
+    for (const auto& chunk_index : prefetch_chunks_) {
+      keys.push_back(MetaCodec::EncodeChunkKey(file_session_.fs_id(), file_session_.ino(), chunk_index));
+    }
   }
 
   if (FLAGS_mds_tiny_file_data_enable && prefetch_data_) {
@@ -1342,13 +1700,51 @@ std::vector<std::string> OpenFileOperation::PrefetchKey() {
   return keys;
 }
 
+Status OpenFileOperation::PrefetchChunk(TxnUPtr& txn, const std::vector<KeyValue>& prefetch_kvs) {
+  if (prefetch_chunks_.empty()) return Status::OK();
+
+  const uint32_t fs_id = file_session_.fs_id();
+  const Ino ino = file_session_.ino();
+
+  if (!FLAGS_mds_chunk_delta_enable) {
+    // prefetch kvs may belong to other inodes of the same txn, so find by key
+    for (const auto& chunk_index : prefetch_chunks_) {
+      auto value = FindValue(prefetch_kvs, MetaCodec::EncodeChunkKey(fs_id, ino, chunk_index));
+      if (!value.empty()) result_.chunks.push_back(MetaCodec::DecodeChunkValue(value));
+    }
+    return Status::OK();
+  }
+  auto [min_it, max_it] = std::minmax_element(prefetch_chunks_.begin(), prefetch_chunks_.end());
+
+  // prefetch chunks are mostly continuous, so scan them at once
+  Range range;
+  range.start = MetaCodec::EncodeChunkKey(fs_id, ino, *min_it);
+  range.end = MetaCodec::EncodeChunkKey(fs_id, ino, static_cast<uint64_t>(*max_it) + 1);
+
+  std::map<uint64_t, ChunkRecord> records;
+  auto status = ScanChunk(txn, range, records);
+  if (!status.ok()) return status;
+
+  for (const auto& chunk_index : prefetch_chunks_) {
+    auto it = records.find(chunk_index);
+    if (it != records.end()) result_.chunks.push_back(std::move(it->second.chunk));
+  }
+
+  return Status::OK();
+}
+
 Status OpenFileOperation::RunInBatch(TxnUPtr& txn, AttrEntry& attr, const std::vector<KeyValue>& prefetch_kvs) {
   if (attr.nlink() == 0) {
     return Status(pb::error::EDELETED, "file is deleted");
   }
 
+  // prefetch chunks
+  auto status = PrefetchChunk(txn, prefetch_kvs);
+  if (!status.ok()) return status;
+
   if (flags_ & O_TRUNC) {
-    ResetFileRange(txn, attr.length());
+    status = ResetFileRange(txn, attr.length());
+    if (!status.ok()) return status;
 
     // delete tiny file data
     if (FLAGS_mds_tiny_file_data_enable && attr.maybe_tiny_file()) {
@@ -1365,15 +1761,11 @@ Status OpenFileOperation::RunInBatch(TxnUPtr& txn, AttrEntry& attr, const std::v
   attr.set_atime(std::max(attr.atime(), GetTime()));
 
   // add file session
-  txn->Put(MetaCodec::EncodeFileSessionKey(file_session_.fs_id(), file_session_.ino(), file_session_.session_id()),
-           MetaCodec::EncodeFileSessionValue(file_session_));
+  PutFileSession(txn, file_session_);
 
-  // prefetch chunks and tiny file data
+  // prefetch tiny file data
   for (const auto& kv : prefetch_kvs) {
-    if (MetaCodec::IsChunkKey(kv.key)) {
-      result_.chunks.push_back(MetaCodec::DecodeChunkValue(kv.value));
-
-    } else if (MetaCodec::IsTinyFileDataKey(kv.key)) {
+    if (MetaCodec::IsTinyFileDataKey(kv.key)) {
       if (attr.length() > 0) {
         auto& mut_kv = const_cast<KeyValue&>(kv);
         uint64_t data_version = 0;
@@ -1389,7 +1781,19 @@ Status OpenFileOperation::RunInBatch(TxnUPtr& txn, AttrEntry& attr, const std::v
 }
 
 Status CloseFileOperation::Run(TxnUPtr& txn) {
-  txn->Delete(MetaCodec::EncodeFileSessionKey(fs_id_, ino_, session_id_));
+  std::string key = MetaCodec::EncodeFileSessionKey(fs_id_, ino_, session_id_);
+
+  // get expire time for delete expire index
+  std::string value;
+  auto status = txn->Get(key, value);
+  if (!status.ok() && status.error_code() != pb::error::ENOT_FOUND) return status;
+
+  if (status.ok()) {
+    txn->Delete(EncodeFileSessionExpireKey(MetaCodec::DecodeFileSessionValue(value)));
+  }
+
+  txn->Delete(key);
+
   return Status::OK();
 }
 
@@ -1828,13 +2232,12 @@ Status CompactChunkOperation::Run(TxnUPtr& txn) {
   CHECK(param_.end_pos >= param_.start_pos) << "invalid pos range.";
   CHECK(param_.new_slices.size() < (param_.end_pos - param_.start_pos)) << "new_slices size invalid.";
 
-  std::string chunk_key = MetaCodec::EncodeChunkKey(fs_id, ino_, chunk_index);
-
-  std::string value;
-  auto status = txn->Get(chunk_key, value);
+  // merge delta records, fold them into base at the end
+  ChunkRecord record;
+  auto status = GetChunk(txn, fs_id, ino_, chunk_index, record);
   if (!status.ok()) return status;
 
-  ChunkEntry chunk = MetaCodec::DecodeChunkValue(value);
+  ChunkEntry& chunk = record.chunk;
   CHECK(chunk.index() == chunk_index) << "chunk index not match.";
 
   const auto& slices = chunk.slices();
@@ -1851,6 +2254,7 @@ Status CompactChunkOperation::Run(TxnUPtr& txn) {
 
   // generate trash slice list
   TrashSliceList trash_slice_list;
+  std::vector<uint64_t> compacted_slice_ids;
   for (uint32_t i = param_.start_pos; i <= param_.end_pos; ++i) {
     const auto& slice = slices.at(i);
 
@@ -1864,6 +2268,14 @@ Status CompactChunkOperation::Run(TxnUPtr& txn) {
     }
     if (found) continue;
 
+    compacted_slice_ids.push_back(slice.id());
+
+    // pack object is shared with other files, only mark this slice dead
+    if (slice.pack_refs() > 0) {
+      PutPackRef(txn, fs_id, ino_, slice, false);
+      continue;
+    }
+
     TrashSliceEntry* trash_slice = trash_slice_list.add_slices();
     trash_slice->set_fs_id(fs_id);
     trash_slice->set_ino(ino_);
@@ -1895,22 +2307,26 @@ Status CompactChunkOperation::Run(TxnUPtr& txn) {
   // record compacted slices
   auto* compacted_slices = chunk.add_compacted_slices();
   compacted_slices->set_time_ms(utils::TimestampMs());
-  for (const auto& slice : trash_slice_list.slices()) {
-    compacted_slices->add_slice_ids(slice.slice_id());
+  for (const auto& slice_id : compacted_slice_ids) {
+    compacted_slices->add_slice_ids(slice_id);
   }
 
+  CleanExpiredCompactedSlice(chunk, utils::TimestampMs());
   chunk.set_version(chunk.version() + 1);
 
   LOG(INFO) << fmt::format(
-      "[operation.{}.{}.{}] compact chunk, pos[{},{}] slice_id[{},{}] new_slices({}) old_slices({}) final_slices({}).",
+      "[operation.{}.{}.{}] compact chunk, pos[{},{}] slice_id[{},{}] new_slices({}) old_slices({}) final_slices({}) "
+      "fold_deltas({}).",
       fs_id, ino_, chunk_index, param_.start_pos, param_.end_pos, param_.start_slice_id, param_.end_slice_id,
-      Helper::ToString(param_.new_slices), old_slice_size, chunk.slices_size());
+      Helper::ToString(param_.new_slices), old_slice_size, chunk.slices_size(), record.delta_keys.size());
 
-  txn->Put(chunk_key, MetaCodec::EncodeChunkValue(chunk));
+  PutChunk(txn, fs_id, ino_, record);
 
   // save trash slice list
-  txn->Put(MetaCodec::EncodeDelSliceKey(fs_id, ino_, chunk.index(), GetTime()),
-           MetaCodec::EncodeDelSliceValue(trash_slice_list));
+  if (trash_slice_list.slices_size() > 0) {
+    txn->Put(MetaCodec::EncodeDelSliceKey(fs_id, ino_, chunk.index(), GetTime()),
+             MetaCodec::EncodeDelSliceValue(trash_slice_list));
+  }
 
   result_.chunk = chunk;
 
@@ -2247,6 +2663,59 @@ Status ScanFileSessionOperation::Run(TxnUPtr& txn) {
 Status DeleteFileSessionOperation::Run(TxnUPtr& txn) {
   for (const auto& file_session : file_sessions_) {
     txn->Delete(MetaCodec::EncodeFileSessionKey(file_session.fs_id(), file_session.ino(), file_session.session_id()));
+    txn->Delete(EncodeFileSessionExpireKey(file_session));
+  }
+
+  return Status::OK();
+}
+
+Status ScanExpiredFileSessionOperation::Run(TxnUPtr& txn) {
+  CHECK(fs_id_ > 0) << "fs_id is 0";
+
+  // bucket before now bucket are all expired
+  Range range = MetaCodec::GetFileSessionExpireRange(fs_id_, FileSessionExpireBucket(now_s_));
+  if (!start_key_.empty()) range.start = start_key_ + '\0';
+
+  std::vector<std::string> expire_keys;
+  std::vector<std::string> keys;
+  auto status = txn->Scan(range, [&](const std::string& key, const std::string&) -> bool {
+    uint32_t fs_id;
+    uint64_t bucket;
+    Ino ino;
+    std::string session_id;
+    MetaCodec::DecodeFileSessionExpireKey(key, fs_id, bucket, ino, session_id);
+
+    expire_keys.push_back(key);
+    keys.push_back(MetaCodec::EncodeFileSessionKey(fs_id, ino, session_id));
+
+    return expire_keys.size() < limit_;
+  });
+  if (!status.ok()) return status;
+
+  result_.is_end = expire_keys.size() < limit_;
+  if (keys.empty()) return Status::OK();
+  result_.last_key = expire_keys.back();
+
+  std::vector<KeyValue> kvs;
+  status = txn->BatchGet(keys, kvs);
+  if (!status.ok()) return status;
+
+  std::unordered_map<std::string, std::string> values;
+  for (auto& kv : kvs) values.emplace(std::move(kv.key), std::move(kv.value));
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto it = values.find(keys[i]);
+    if (it != values.end()) {
+      auto file_session = MetaCodec::DecodeFileSessionValue(it->second);
+      if (file_session.expire_time_s() < now_s_) {
+        result_.file_sessions.push_back(std::move(file_session));
+        continue;
+      }
+    }
+
+    // session closed or moved to later bucket by keepalive
+    txn->Delete(expire_keys[i]);
+    ++result_.stale_count;
   }
 
   return Status::OK();
@@ -2269,8 +2738,17 @@ Status KeepAliveFileSessionOperation::Run(TxnUPtr& txn) {
 
   for (auto& kv : kvs) {
     FileSessionEntry file_session = MetaCodec::DecodeFileSessionValue(kv.value);
+    uint64_t old_bucket = FileSessionExpireBucket(file_session.expire_time_s());
+    std::string old_expire_key = EncodeFileSessionExpireKey(file_session);
+
     file_session.set_expire_time_s(utils::Timestamp() + FLAGS_mds_filesession_live_time_s);
     txn->Put(kv.key, MetaCodec::EncodeFileSessionValue(file_session));
+
+    // move expire index when cross bucket
+    if (FileSessionExpireBucket(file_session.expire_time_s()) != old_bucket) {
+      txn->Delete(old_expire_key);
+      txn->Put(EncodeFileSessionExpireKey(file_session), file_session.client_id());
+    }
   }
 
   return Status::OK();
@@ -2300,6 +2778,10 @@ Status CleanDelFileOperation::Run(TxnUPtr& txn) {
   txn->Delete(MetaCodec::EncodeInodeKey(fs_id_, ino_));
   if (maybe_tiny_file_) txn->Delete(MetaCodec::EncodeTinyFileDataKey(fs_id_, ino_));
 
+  for (const auto& slice : packed_slices_) {
+    PutPackRef(txn, fs_id_, ino_, slice, false);
+  }
+
   return Status::OK();
 }
 
@@ -2366,6 +2848,28 @@ Status ScanDelSliceOperation::Run(TxnUPtr& txn) {
   return txn->Scan(range, handler_);
 }
 
+Status ScanDelPackOperation::Run(TxnUPtr& txn) {
+  CHECK(fs_id_ > 0) << "fs_id is 0";
+  Range range = MetaCodec::GetDelPackRange(fs_id_);
+
+  return txn->Scan(range, handler_);
+}
+
+Status CleanDelPackOperation::Run(TxnUPtr& txn) {
+  for (const auto& key : keys_) {
+    txn->Delete(key);
+  }
+
+  return Status::OK();
+}
+
+Status AddPendingPackOperation::Run(TxnUPtr& txn) {
+  txn->Put(MetaCodec::EncodeDelPackKey(fs_id_, pack_id_, MetaCodec::kPendingPackIno),
+           MetaCodec::EncodeDelPackValue(0, utils::TimestampNs(), false));
+
+  return Status::OK();
+}
+
 Status ScanDelFileOperation::Run(TxnUPtr& txn) {
   CHECK(fs_id_ > 0) << "fs_id is 0";
   Range range = MetaCodec::GetDelFileTableRange(fs_id_);
@@ -2525,8 +3029,11 @@ Status ImportKVOperation::Run(TxnUPtr& txn) {
 OperationProcessor::OperationProcessor(KVStorageSPtr kv_storage) : kv_storage_(kv_storage) {
   async_worker_ = Worker::New();
   CHECK(async_worker_ != nullptr) << fmt::format("[operation] create async worker fail.");
+  CHECK(bthread_mutex_init(&key_mutex_, nullptr) == 0) << "[operation] init key mutex fail.";
 }
 
+OperationProcessor::~OperationProcessor() { bthread_mutex_destroy(&key_mutex_); }
+
 bool OperationProcessor::Init() {
   for (uint32_t i = 0; i < kScheduleThreadNum; ++i) {
     threads_.emplace_back([this] { ProcessOperation(); });
@@ -2588,9 +3095,10 @@ Status OperationProcessor::RunAlone(Operation* operation) {
     status = operation->Run(txn);
     if (!status.ok()) {
       if (status.error_code() == pb::error::ESTORE_MAYBE_RETRY) {
-        LOG(WARNING) << fmt::format("[operation.{}.{}][{}][{}us] alone run {} lock conflict, retry({}) status({}).",
-                                    fs_id, ino, txn_id, once_duration.ElapsedUs(), operation->OpName(), retry,
-                                    status.error_str());
+        GetOperationStat(operation).conflict_count << 1;
+        EVENT_LOG(INFO, "[operation.{}.{}][{}][{}us] alone run {} lock conflict, retry({}) status({}).",
+                        fs_id, ino, txn_id, once_duration.ElapsedUs(), operation->OpName(), retry,
+                        status.error_str());
         continue;
       }
       break;
@@ -2606,9 +3114,10 @@ Status OperationProcessor::RunAlone(Operation* operation) {
       break;
     }
 
-    LOG(WARNING) << fmt::format("[operation.{}.{}][{}][{}us] alone run {} fail, txn({}) retry({}) status({}).", fs_id,
-                                ino, txn_id, once_duration.ElapsedUs(), operation->OpName(), commit_type, retry,
-                                status.error_str());
+    GetOperationStat(operation).conflict_count << 1;
+    EVENT_LOG(INFO, "[operation.{}.{}][{}][{}us] alone run {} fail, txn({}) retry({}) status({}).", fs_id,
+                    ino, txn_id, once_duration.ElapsedUs(), operation->OpName(), commit_type, retry,
+                    status.error_str());
 
     if (once_duration.ElapsedMs() > FLAGS_mds_txn_timeout_ms) {
       break;
@@ -2617,9 +3126,10 @@ Status OperationProcessor::RunAlone(Operation* operation) {
   } while (IsRetry(retry));
 
   trace.RecordElapsedTime("store_operate");
+  GetOperationStat(operation).retry_recorder << retry;
 
-  LOG(INFO) << fmt::format("[operation.{}.{}][{}][{}us] alone run {} finish, txn({}) retry({}) status({}).", fs_id, ino,
-                           txn_id, duration.ElapsedUs(), operation->OpName(), commit_type, retry, status.error_str());
+  EVENT_LOG(INFO, "[operation.{}.{}][{}][{}us] alone run {} finish, txn({}) retry({}) status({}).", fs_id, ino,
+                  txn_id, duration.ElapsedUs(), operation->OpName(), commit_type, retry, status.error_str());
 
   if (!status.ok()) {
     operation->SetStatus(status);
@@ -2714,9 +3224,21 @@ void OperationProcessor::ProcessOperation() {
     } while (true);
 
     auto batch_operation_map = Grouping(stage_operations);
+
+    const uint32_t max_num = FLAGS_mds_store_operation_multi_inode_batch_enable
+                                 ? std::max(FLAGS_mds_store_operation_multi_inode_batch_max_num, 1U)
+                                 : 1;
+    std::vector<BatchOperation> batch_operations;
     for (auto& [_, batch_operation] : batch_operation_map) {
-      LaunchExecuteBatchOperation(std::move(batch_operation));
+      if (!AcquireBatchOperation(batch_operation)) continue;
+
+      batch_operations.push_back(std::move(batch_operation));
+      if (batch_operations.size() >= max_num) {
+        LaunchExecuteBatchOperation(std::move(batch_operations));
+        batch_operations.clear();
+      }
     }
+    if (!batch_operations.empty()) LaunchExecuteBatchOperation(std::move(batch_operations));
   }
 
   // print pending operations
@@ -2726,13 +3248,62 @@ void OperationProcessor::ProcessOperation() {
   }
 }
 
-void OperationProcessor::LaunchExecuteBatchOperation(BatchOperation&& batch_operation) {
+bool OperationProcessor::AcquireBatchOperation(BatchOperation& batch_operation) {
+  if (!FLAGS_mds_store_operation_inode_serial_enable) return true;
+
+  // batches of same inode always conflict on the inode key, so run them one by one,
+  // operations arrived meanwhile are merged and committed by one txn later.
+  Key key = {.fs_id = batch_operation.fs_id, .ino = batch_operation.ino};
+  {
+    BAIDU_SCOPED_LOCK(key_mutex_);
+
+    auto it = running_keys_.find(key);
+    if (it != running_keys_.end()) {
+      auto& pending = it->second.pending;
+      pending.fs_id = batch_operation.fs_id;
+      pending.ino = batch_operation.ino;
+      pending.setattr_operations.insert(pending.setattr_operations.end(),
+                                        batch_operation.setattr_operations.begin(),
+                                        batch_operation.setattr_operations.end());
+      pending.create_operations.insert(pending.create_operations.end(), batch_operation.create_operations.begin(),
+                                       batch_operation.create_operations.end());
+
+      g_operation_serial_merge_count << (batch_operation.setattr_operations.size() +
+                                         batch_operation.create_operations.size());
+      return false;
+    }
+
+    running_keys_.emplace(key, KeyState{});
+  }
+
+  return true;
+}
+
+bool OperationProcessor::PopPendingBatchOperation(const Key& key, BatchOperation& batch_operation) {
+  BAIDU_SCOPED_LOCK(key_mutex_);
+
+  auto it = running_keys_.find(key);
+  if (it == running_keys_.end()) return false;
+
+  auto& pending = it->second.pending;
+  if (pending.setattr_operations.empty() && pending.create_operations.empty()) {
+    running_keys_.erase(it);
+    return false;
+  }
+
+  batch_operation = std::move(pending);
+  pending = BatchOperation{};
+
+  return true;
+}
+
+void OperationProcessor::LaunchExecuteBatchOperation(std::vector<BatchOperation>&& batch_operations) {
   struct Params {
     OperationProcessor* self{nullptr};
-    BatchOperation batch_operation;
+    std::vector<BatchOperation> batch_operations;
   };
 
-  Params* params = new Params({.self = this, .batch_operation = std::move(batch_operation)});
+  Params* params = new Params({.self = this, .batch_operations = std::move(batch_operations)});
 
   bthread_t tid;
   bthread_attr_t attr = BTHREAD_ATTR_NORMAL;
@@ -2741,7 +3312,23 @@ void OperationProcessor::LaunchExecuteBatchOperation(BatchOperation&& batch_oper
           [](void* arg) -> void* {
             Params* params = reinterpret_cast<Params*>(arg);
 
-            params->self->ExecuteBatchOperation(params->batch_operation);
+            auto* self = params->self;
+            auto& batch_operations = params->batch_operations;
+            do {
+              self->ExecuteMultiBatchOperation(batch_operations);
+
+              // continue with pending batch operations of these inodes
+              std::vector<BatchOperation> next_batch_operations;
+              for (auto& batch_operation : batch_operations) {
+                const Key key = {.fs_id = batch_operation.fs_id, .ino = batch_operation.ino};
+                BatchOperation pending_batch_operation;
+                if (self->PopPendingBatchOperation(key, pending_batch_operation)) {
+                  next_batch_operations.push_back(std::move(pending_batch_operation));
+                }
+              }
+              batch_operations.swap(next_batch_operations);
+
+            } while (!batch_operations.empty());
 
             delete params;
 
@@ -2770,6 +3357,7 @@ static std::string GetName(const BatchOperation& batch_operation) {
 void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation) {
   const uint32_t fs_id = batch_operation.fs_id;
   const uint64_t ino = batch_operation.ino;
+  if (IsEmpty(batch_operation)) return;
 
   utils::Duration duration;
 
@@ -2786,12 +3374,14 @@ void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation)
   AttrEntry attr;
   Status status;
   uint32_t retry = 0;
-  int count = 0;
+  int count = batch_operation.setattr_operations.size() + batch_operation.create_operations.size();
   int64_t txn_id = 0;
   char* commit_type = (char*)"none";
   std::string op_names = GetName(batch_operation);
+  bool is_rerun = false;
   do {
     utils::Duration once_duration;
+    is_rerun = false;
 
     auto txn = kv_storage_->NewTxn();
     if (txn == nullptr) {
@@ -2804,8 +3394,9 @@ void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation)
     status = txn->BatchGet(keys, prefetch_kvs);
     if (!status.ok()) {
       if (status.error_code() == pb::error::ESTORE_MAYBE_RETRY) {
-        LOG(WARNING) << fmt::format("[operation.{}.{}][{}][{}us] batch run {} lock conflict, retry({}) status({}).",
-                                    fs_id, ino, txn_id, once_duration.ElapsedUs(), op_names, retry, status.error_str());
+        RecordConflict(batch_operation);
+        EVENT_LOG(INFO, "[operation.{}.{}][{}][{}us] batch run {} lock conflict, retry({}) status({}).",
+                        fs_id, ino, txn_id, once_duration.ElapsedUs(), op_names, retry, status.error_str());
         continue;
       }
       break;
@@ -2818,16 +3409,27 @@ void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation)
     }
     attr = MetaCodec::DecodeInodeValue(primary_value);
 
-    // run set attr operations
-    for (auto* operation : batch_operation.setattr_operations) {
-      operation->RunInBatch(txn, attr, prefetch_kvs);
-      if (retry == 0) ++count;
-    }
+    // run set attr and create operations
+    Operation* failed_operation = nullptr;
+    status = RunBatchOperation(txn, batch_operation, attr, prefetch_kvs, failed_operation);
+    if (!status.ok()) {
+      if (status.error_code() == pb::error::ESTORE_MAYBE_RETRY) {
+        RecordConflict(batch_operation);
+        EVENT_LOG(INFO, "[operation.{}.{}][{}][{}us] batch run {} conflict, retry({}) status({}).", fs_id, ino,
+                        txn_id, once_duration.ElapsedUs(), op_names, retry, status.error_str());
+        continue;
+      }
 
-    // run create operations
-    for (auto* operation : batch_operation.create_operations) {
-      operation->RunInBatch(txn, attr, prefetch_kvs);
-      if (retry == 0) ++count;
+      // fail the operation alone, rerun the others with a new txn
+      EVENT_LOG(WARNING, "[operation.{}.{}][{}][{}us] batch run {} fail, status({}).", fs_id, ino, txn_id,
+                         once_duration.ElapsedUs(), failed_operation->OpName(), status.error_str());
+      DropOperation(batch_operation, failed_operation, status);
+      status = Status::OK();
+      if (IsEmpty(batch_operation)) break;
+
+      op_names = GetName(batch_operation);
+      is_rerun = true;
+      continue;
     }
 
     attr.set_version(attr.version() + 1);
@@ -2843,7 +3445,8 @@ void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation)
       break;
     }
 
-    LOG(WARNING) << fmt::format(
+    RecordConflict(batch_operation);
+    EVENT_LOG(INFO,
         "[operation.{}.{}][{}][{}us] batch run ({}) fail, count({}) txn({}) retry({}) status({}).", fs_id, ino, txn_id,
         once_duration.ElapsedUs(), op_names, count, commit_type, retry, status.error_str());
 
@@ -2851,11 +3454,12 @@ void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation)
       break;
     }
 
-  } while (IsRetry(retry));
+  } while (is_rerun || IsRetry(retry));
 
   SetElapsedTime(batch_operation, "store_operate");
+  RecordRetry(batch_operation, retry);
 
-  LOG(INFO) << fmt::format(
+  EVENT_LOG(INFO,
       "[operation.{}.{}][{}][{}us] batch run ({}) finish, count({}) txn({}) retry({}) status({}) attr({}).", fs_id, ino,
       txn_id, duration.ElapsedUs(), op_names, count, commit_type, retry, status.error_str(), DescribeAttr(attr));
 
@@ -2870,6 +3474,144 @@ void OperationProcessor::ExecuteBatchOperation(BatchOperation& batch_operation)
   Notify(batch_operation);
 }
 
+void OperationProcessor::ExecuteMultiBatchOperation(std::vector<BatchOperation>& batch_operations) {
+  if (batch_operations.empty()) return;
+  if (batch_operations.size() == 1) {
+    ExecuteBatchOperation(batch_operations[0]);
+    return;
+  }
+
+  utils::Duration duration;
+
+  // every inode touch its own keys, so batch operations of different inodes are independent
+  std::vector<std::string> keys;
+  for (auto& batch_operation : batch_operations) {
+    keys.push_back(MetaCodec::EncodeInodeKey(batch_operation.fs_id, batch_operation.ino));
+    for (auto* operation : batch_operation.setattr_operations) {
+      auto prefetch_keys = operation->PrefetchKey();
+      if (!prefetch_keys.empty()) keys.insert(keys.end(), prefetch_keys.begin(), prefetch_keys.end());
+    }
+
+    SetElapsedTime(batch_operation, "store_pending");
+  }
+
+  auto split_fn = [&]() {
+    g_multi_inode_batch_split_count << 1;
+
+    size_t half = batch_operations.size() / 2;
+    std::vector<BatchOperation> left(std::make_move_iterator(batch_operations.begin()),
+                                     std::make_move_iterator(batch_operations.begin() + half));
+    std::vector<BatchOperation> right(std::make_move_iterator(batch_operations.begin() + half),
+                                      std::make_move_iterator(batch_operations.end()));
+    ExecuteMultiBatchOperation(left);
+    ExecuteMultiBatchOperation(right);
+
+    // move back, caller pop pending batch operations by their fs_id/ino
+    std::move(left.begin(), left.end(), batch_operations.begin());
+    std::move(right.begin(), right.end(), batch_operations.begin() + half);
+  };
+
+  auto txn = kv_storage_->NewTxn();
+  if (txn == nullptr) {
+    split_fn();
+    return;
+  }
+  const int64_t txn_id = txn->ID();
+
+  std::vector<KeyValue> prefetch_kvs;
+  auto status = txn->BatchGet(keys, prefetch_kvs);
+  if (!status.ok()) {
+    EVENT_LOG(WARNING, "[operation][{}][{}us] multi batch run prefetch fail, batch({}) status({}).", txn_id,
+                       duration.ElapsedUs(), batch_operations.size(), status.error_str());
+    split_fn();
+    return;
+  }
+
+  std::vector<AttrEntry> attrs(batch_operations.size());
+  std::vector<Status> statuses(batch_operations.size());
+  uint32_t run_num = 0;
+  for (size_t i = 0; i < batch_operations.size(); ++i) {
+    auto& batch_operation = batch_operations[i];
+    // all operations of inode are dropped, keep it for caller to pop its pending batch
+    if (IsEmpty(batch_operation)) continue;
+
+    std::string primary_key = MetaCodec::EncodeInodeKey(batch_operation.fs_id, batch_operation.ino);
+
+    auto primary_value = FindValue(prefetch_kvs, primary_key);
+    if (primary_value.empty()) {
+      statuses[i] = Status(pb::error::ENOT_FOUND, fmt::format("not found inode({})", batch_operation.ino));
+      continue;
+    }
+
+    auto& attr = attrs[i];
+    attr = MetaCodec::DecodeInodeValue(primary_value);
+
+    Operation* failed_operation = nullptr;
+    status = RunBatchOperation(txn, batch_operation, attr, prefetch_kvs, failed_operation);
+    if (status.error_code() == pb::error::ESTORE_MAYBE_RETRY) {
+      for (auto& item : batch_operations) RecordConflict(item);
+
+      EVENT_LOG(INFO, "[operation][{}][{}us] multi batch run conflict, batch({}) status({}).", txn_id,
+                      duration.ElapsedUs(), batch_operations.size(), status.error_str());
+      split_fn();
+      return;
+
+    } else if (!status.ok()) {
+      // failed operation already wrote into shared txn, fail it alone and rerun the others with a new txn
+      EVENT_LOG(WARNING, "[operation.{}.{}][{}][{}us] multi batch run {} fail, status({}).", batch_operation.fs_id,
+                         batch_operation.ino, txn_id, duration.ElapsedUs(), failed_operation->OpName(),
+                         status.error_str());
+      DropOperation(batch_operation, failed_operation, status);
+      ExecuteMultiBatchOperation(batch_operations);
+      return;
+    }
+
+    attr.set_version(attr.version() + 1);
+    txn->Put(primary_key, MetaCodec::EncodeInodeValue(attr));
+    ++run_num;
+  }
+
+  status = txn->Commit();
+
+  auto txn_trace = txn->GetTrace();
+  for (auto& batch_operation : batch_operations) SetTrace(batch_operation, txn_trace);
+
+  if (status.error_code() == pb::error::ESTORE_MAYBE_RETRY) {
+    for (auto& batch_operation : batch_operations) RecordConflict(batch_operation);
+
+    EVENT_LOG(INFO, "[operation][{}][{}us] multi batch run conflict, batch({}) txn({}) status({}).",
+                    txn_id, duration.ElapsedUs(), batch_operations.size(), txn_trace.commit_type,
+                    status.error_str());
+    split_fn();
+    return;
+  }
+
+  g_multi_inode_batch_size_recorder << batch_operations.size();
+  if (status.ok() && run_num > 1) g_multi_inode_batch_saved_commit_count << (run_num - 1);
+
+  EVENT_LOG(INFO, "[operation][{}][{}us] multi batch run finish, batch({}) run({}) txn({}) status({}).",
+                  txn_id, duration.ElapsedUs(), batch_operations.size(), run_num, txn_trace.commit_type,
+                  status.error_str());
+
+  for (size_t i = 0; i < batch_operations.size(); ++i) {
+    auto& batch_operation = batch_operations[i];
+    SetElapsedTime(batch_operation, "store_operate");
+    RecordRetry(batch_operation, 0);
+
+    if (!status.ok()) {
+      SetError(batch_operation, status);
+
+    } else if (!statuses[i].ok()) {
+      SetError(batch_operation, statuses[i]);
+
+    } else {
+      SetAttr(batch_operation, attrs[i]);
+    }
+
+    Notify(batch_operation);
+  }
+}
+
 Status OperationProcessor::CheckTable(const Range& range) {
   auto status = kv_storage_->IsExistTable(range.start, range.end);
   if (!status.ok()) {
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -24,6 +25,7 @@
 #include <vector>
 
 #include "bthread/countdown_event.h"
+#include "bthread/types.h"
 #include "butil/containers/mpsc_queue.h"
 #include "dingofs/error.pb.h"
 #include "dingofs/mds.pb.h"
@@ -110,10 +112,13 @@ class Operation {
     kScanFileSession = 101,
     kKeepAliveFileSession = 102,
     kDeleteFileSession = 103,
+    kScanExpiredFileSession = 104,
 
     kCleanDelSlice = 110,
     kGetDelFile = 111,
     kCleanDelFile = 112,
+    kCleanDelPack = 113,
+    kAddPendingPack = 114,
 
     kScanLock = 120,
     kScanFs = 121,
@@ -121,6 +126,7 @@ class Operation {
     kScanDentry = 123,
     kScanDelFile = 124,
     kScanDelSlice = 125,
+    kScanDelPack = 126,
 
     kScanMetaTable = 140,
     kScanFsMetaTable = 141,
@@ -445,8 +451,8 @@ class UpdateFsStateOperation : public Operation {
 
 class UpdateFsRecycleProgressOperation : public Operation {
  public:
-  UpdateFsRecycleProgressOperation(Trace& trace, const std::string& fs_name, Ino ino)
-      : Operation(trace), fs_name_(fs_name), ino_(ino) {};
+  UpdateFsRecycleProgressOperation(Trace& trace, const std::string& fs_name, Ino ino, uint64_t deleted_block_num = 0)
+      : Operation(trace), fs_name_(fs_name), ino_(ino), deleted_block_num_(deleted_block_num) {};
   ~UpdateFsRecycleProgressOperation() override = default;
 
   OpType GetOpType() const override { return OpType::kUpdateFsRecycleProgress; }
@@ -458,7 +464,10 @@ class UpdateFsRecycleProgressOperation : public Operation {
 
  private:
   const std::string fs_name_;
+  // cleaned file, its inode is removed when counted
   Ino ino_;
+  // block num deleted of the file
+  uint64_t deleted_block_num_;
 };
 
 class CreateRootOperation : public Operation {
@@ -772,8 +781,14 @@ class GetChunkOperation : public Operation {
 
 class ScanChunkOperation : public Operation {
  public:
-  ScanChunkOperation(Trace& trace, uint32_t fs_id, uint64_t ino, uint32_t max_slice_num = 0)
-      : Operation(trace), fs_id_(fs_id), ino_(ino), max_slice_num_(max_slice_num) {};
+  // scan chunks from start_chunk_index, stop at chunk boundary once max_slice_num reached
+  ScanChunkOperation(Trace& trace, uint32_t fs_id, uint64_t ino, uint32_t max_slice_num = 0,
+                     uint64_t start_chunk_index = 0)
+      : Operation(trace),
+        fs_id_(fs_id),
+        ino_(ino),
+        max_slice_num_(max_slice_num),
+        start_chunk_index_(start_chunk_index) {};
   ~ScanChunkOperation() override = default;
 
   struct Result : public Operation::Result {
@@ -800,6 +815,7 @@ class ScanChunkOperation : public Operation {
   uint32_t fs_id_;
   uint64_t ino_;
   uint32_t max_slice_num_{0};
+  uint64_t start_chunk_index_{0};
 
   Result result_;
 };
@@ -909,7 +925,8 @@ class OpenFileOperation : public Operation {
   }
 
  private:
-  void ResetFileRange(TxnUPtr& txn, uint64_t length);
+  Status ResetFileRange(TxnUPtr& txn, uint64_t length);
+  Status PrefetchChunk(TxnUPtr& txn, const std::vector<KeyValue>& prefetch_kvs);
 
   uint32_t flags_;
   FileSessionEntry file_session_;
@@ -1640,6 +1657,47 @@ class DeleteFileSessionOperation : public Operation {
   std::vector<FileSessionEntry> file_sessions_;
 };
 
+// scan expire index from start_key(exclusive), get expired file session and clean stale index
+class ScanExpiredFileSessionOperation : public Operation {
+ public:
+  ScanExpiredFileSessionOperation(Trace& trace, uint32_t fs_id, uint64_t now_s, const std::string& start_key,
+                                  uint32_t limit)
+      : Operation(trace), fs_id_(fs_id), now_s_(now_s), start_key_(start_key), limit_(limit) {};
+  ~ScanExpiredFileSessionOperation() override = default;
+
+  struct Result : public Operation::Result {
+    std::vector<FileSessionEntry> file_sessions;
+    uint32_t stale_count{0};
+    // last scanned expire index key
+    std::string last_key;
+    // no more expire index
+    bool is_end{false};
+  };
+
+  OpType GetOpType() const override { return OpType::kScanExpiredFileSession; }
+
+  uint32_t GetFsId() const override { return fs_id_; }
+  Ino GetIno() const override { return 0; }
+
+  Status Run(TxnUPtr& txn) override;
+
+  template <int size = 0>
+  Result& GetResult() {
+    auto& result = Operation::GetResult();
+    result_.status = result.status;
+    result_.attr = std::move(result.attr);
+
+    return result_;
+  }
+
+ private:
+  uint32_t fs_id_;
+  uint64_t now_s_;
+  const std::string start_key_;
+  uint32_t limit_;
+  Result result_;
+};
+
 class KeepAliveFileSessionOperation : public Operation {
  public:
   struct Param {
@@ -1703,8 +1761,13 @@ class GetDelFileOperation : public Operation {
 
 class CleanDelFileOperation : public Operation {
  public:
-  CleanDelFileOperation(Trace& trace, uint32_t fs_id, Ino ino, bool maybe_tiny_file)
-      : Operation(trace), fs_id_(fs_id), ino_(ino), maybe_tiny_file_(maybe_tiny_file) {};
+  CleanDelFileOperation(Trace& trace, uint32_t fs_id, Ino ino, bool maybe_tiny_file,
+                        std::vector<SliceEntry> packed_slices)
+      : Operation(trace),
+        fs_id_(fs_id),
+        ino_(ino),
+        maybe_tiny_file_(maybe_tiny_file),
+        packed_slices_(std::move(packed_slices)) {};
   ~CleanDelFileOperation() override = default;
 
   OpType GetOpType() const override { return OpType::kCleanDelFile; }
@@ -1718,6 +1781,44 @@ class CleanDelFileOperation : public Operation {
   const uint32_t fs_id_;
   const Ino ino_;
   const bool maybe_tiny_file_;
+  // slices of file stored in pack objects
+  const std::vector<SliceEntry> packed_slices_;
+};
+
+class CleanDelPackOperation : public Operation {
+ public:
+  CleanDelPackOperation(Trace& trace, std::vector<std::string> keys) : Operation(trace), keys_(std::move(keys)) {};
+  ~CleanDelPackOperation() override = default;
+
+  OpType GetOpType() const override { return OpType::kCleanDelPack; }
+
+  uint32_t GetFsId() const override { return 0; }
+  Ino GetIno() const override { return 0; }
+
+  Status Run(TxnUPtr& txn) override;
+
+ private:
+  const std::vector<std::string> keys_;
+};
+
+// record pending ref of pack when its id is allocated, so gc can free the pack
+// object even if none of its slices is committed
+class AddPendingPackOperation : public Operation {
+ public:
+  AddPendingPackOperation(Trace& trace, uint32_t fs_id, uint64_t pack_id)
+      : Operation(trace), fs_id_(fs_id), pack_id_(pack_id) {};
+  ~AddPendingPackOperation() override = default;
+
+  OpType GetOpType() const override { return OpType::kAddPendingPack; }
+
+  uint32_t GetFsId() const override { return fs_id_; }
+  Ino GetIno() const override { return 0; }
+
+  Status Run(TxnUPtr& txn) override;
+
+ private:
+  const uint32_t fs_id_;
+  const uint64_t pack_id_;
 };
 
 class ScanLockOperation : public Operation {
@@ -1845,6 +1946,24 @@ class ScanDelSliceOperation : public Operation {
   Txn::ScanHandlerType handler_;
 };
 
+class ScanDelPackOperation : public Operation {
+ public:
+  ScanDelPackOperation(Trace& trace, uint32_t fs_id, Txn::ScanHandlerType handler)
+      : Operation(trace), fs_id_(fs_id), handler_(handler) {};
+  ~ScanDelPackOperation() override = default;
+
+  OpType GetOpType() const override { return OpType::kScanDelPack; }
+
+  uint32_t GetFsId() const override { return 0; }
+  Ino GetIno() const override { return 0; }
+
+  Status Run(TxnUPtr& txn) override;
+
+ private:
+  uint32_t fs_id_{0};
+  Txn::ScanHandlerType handler_;
+};
+
 class ScanDelFileOperation : public Operation {
  public:
   ScanDelFileOperation(Trace& trace, uint32_t fs_id, Txn::ScanHandlerType scan_handler)
@@ -2236,7 +2355,7 @@ class OperationTask : public TaskRunnable {
 class OperationProcessor : public std::enable_shared_from_this<OperationProcessor> {
  public:
   OperationProcessor(KVStorageSPtr kv_storage);
-  ~OperationProcessor() = default;
+  ~OperationProcessor();
 
   OperationProcessor(const OperationProcessor&) = delete;
   OperationProcessor& operator=(const OperationProcessor&) = delete;
@@ -2275,8 +2394,16 @@ class OperationProcessor : public std::enable_shared_from_this<OperationProcesso
  private:
   static std::map<OperationProcessor::Key, BatchOperation> Grouping(std::vector<Operation*>& operations);
   void ProcessOperation();
-  void LaunchExecuteBatchOperation(BatchOperation&& batch_operation);
+  // return true when the inode is idle and the batch should run,
+  // otherwise merge into pending batch of the running inode
+  bool AcquireBatchOperation(BatchOperation& batch_operation);
+  // return next pending batch operation of the inode, or false when the inode is idle
+  bool PopPendingBatchOperation(const Key& key, BatchOperation& batch_operation);
+  // batch operations of different inodes run in one bthread, and commit in one txn if multi inode batch enable
+  void LaunchExecuteBatchOperation(std::vector<BatchOperation>&& batch_operations);
   void ExecuteBatchOperation(BatchOperation& batch_operation);
+  // split into halves when conflict
+  void ExecuteMultiBatchOperation(std::vector<BatchOperation>& batch_operations);
 
   // use std thread
   std::vector<std::thread> threads_;
@@ -2287,6 +2414,13 @@ class OperationProcessor : public std::enable_shared_from_this<OperationProcesso
 
   butil::MPSCQueue<Operation*> operations_;
 
+  // running inode and its pending batch operation
+  struct KeyState {
+    BatchOperation pending;
+  };
+  bthread_mutex_t key_mutex_;
+  std::map<Key, KeyState> running_keys_;
+
   WorkerSPtr async_worker_;
 
   // persistence store
@@ -319,6 +319,7 @@ int main(int argc, char* argv[]) {
   CHECK(server.InitCacheMemberSynchronizer()) << "init cache member synchronizer error.";
   CHECK(server.InitMonitor()) << "init mds monitor error.";
   CHECK(server.InitGcProcessor()) << "init gc error.";
+  CHECK(server.InitBalancer()) << "init balancer error.";
   CHECK(server.InitQuotaSynchronizer()) << "init quota synchronizer error.";
   CHECK(server.InitCrontab()) << "init crontab error.";
   CHECK(server.InitService()) << "init service error.";
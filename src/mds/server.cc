@@ -33,6 +33,7 @@
 #include "mds/background/heartbeat.h"
 #include "mds/cachegroup/member_manager.h"
 #include "mds/common/codec.h"
+#include "mds/common/event_log.h"
 #include "mds/common/helper.h"
 #include "mds/coordinator/dingo_coordinator_client.h"
 #include "mds/service/debug_service.h"
@@ -41,6 +42,7 @@
 #include "mds/statistics/fs_stat.h"
 #include "mds/storage/dingodb_storage.h"
 #include "mds/storage/dummy_storage.h"
+#include "mds/storage/memory_storage.h"
 #include "mds/storage/tikv_storage.h"
 
 #ifdef USE_TCMALLOC
@@ -52,6 +54,7 @@ namespace mds {
 
 DEFINE_string(mds_monitor_lock_name, "/lock/mds/monitor", "mds monitor lock name");
 DEFINE_string(mds_gc_lock_name, "/lock/mds/gc", "gc lock name");
+DEFINE_string(mds_balancer_lock_name, "/lock/mds/balancer", "balancer lock name");
 
 DEFINE_string(mds_pid_file_name, "pid", "pid file name");
 
@@ -67,6 +70,7 @@ DEFINE_uint32(mds_crontab_fsinfosync_interval_s, 10, "fs info sync interval seco
 DEFINE_uint32(mds_crontab_mdsmonitor_interval_s, 5, "mds monitor interval seconds");
 DEFINE_uint32(mds_crontab_quota_sync_interval_s, 3, "quota sync interval seconds");
 DEFINE_uint32(mds_crontab_gc_interval_s, 60, "gc interval seconds");
+DEFINE_uint32(mds_crontab_balancer_interval_s, 10, "balancer interval seconds");
 DEFINE_uint32(mds_crontab_cache_member_sync_interval_s, 3, "cache member sync interval seconds");
 DEFINE_uint32(mds_crontab_clean_expired_cache_interval_s, 600, "clean expired cache interval seconds");
 
@@ -136,7 +140,8 @@ bool Server::InitConfig(const std::string& path) {
 
 bool Server::InitLog() {
   DingoLogVersion();
-  return true;
+
+  return EventLog::GetInstance().Init(::FLAGS_log_dir);
 }
 
 bool Server::InitLogCleanManager() {
@@ -200,6 +205,9 @@ bool Server::InitStorage(const std::string& store_url) {
   } else if (FLAGS_mds_storage_engine == "tikv") {
     kv_storage_ = TikvStorage::New();
 
+  } else if (FLAGS_mds_storage_engine == "memory") {
+    kv_storage_ = MemoryStorage::New();
+
   } else if (FLAGS_mds_storage_engine == "dummy") {
     kv_storage_ = DummyStorage::New();
 
@@ -209,8 +217,10 @@ bool Server::InitStorage(const std::string& store_url) {
   }
   CHECK(kv_storage_ != nullptr) << "new dingodb storage fail.";
 
-  std::string store_addrs = Helper::ParseStorageAddr(store_url);
-  if (FLAGS_mds_storage_engine != "dummy" && store_addrs.empty()) {
+  // memory storage use store url as wal dir, empty means no persistence
+  std::string store_addrs =
+      (FLAGS_mds_storage_engine == "memory") ? store_url : Helper::ParseStorageAddr(store_url);
+  if (FLAGS_mds_storage_engine != "dummy" && FLAGS_mds_storage_engine != "memory" && store_addrs.empty()) {
     return false;
   }
 
@@ -355,6 +365,20 @@ bool Server::InitGcProcessor() {
   return true;
 }
 
+bool Server::InitBalancer() {
+  CHECK(file_system_set_ != nullptr) << "file system set is nullptr.";
+  CHECK(notify_buddy_ != nullptr) << "notify_buddy is nullptr.";
+
+  auto dist_lock = StoreDistributionLock::New(kv_storage_, FLAGS_mds_balancer_lock_name, self_mds_meta_.ID());
+  CHECK(dist_lock != nullptr) << "balancer dist lock is nullptr.";
+
+  balancer_ = Balancer::New(file_system_set_, dist_lock, notify_buddy_);
+
+  CHECK(balancer_->Init()) << "init Balancer fail.";
+
+  return true;
+}
+
 bool Server::InitCrontab() {
   LOG(INFO) << "init crontab.";
 
@@ -398,6 +422,14 @@ bool Server::InitCrontab() {
       [](void*) { Server::GetInstance().GetGcProcessor()->Run(); },
   });
 
+  // Add balancer crontab
+  crontab_configs_.push_back({
+      "BALANCER",
+      FLAGS_mds_crontab_balancer_interval_s * 1000,
+      true,
+      [](void*) { Server::GetInstance().GetBalancer()->Run(); },
+  });
+
   // Add filesystem cache crontab
   crontab_configs_.push_back({
       "CLEAN_EXPIRED_CACHE",
@@ -516,6 +548,12 @@ GcProcessorSPtr Server::GetGcProcessor() {
   return gc_processor_;
 }
 
+BalancerSPtr Server::GetBalancer() {
+  CHECK(balancer_ != nullptr) << "balancer is nullptr.";
+
+  return balancer_;
+}
+
 CacheGroupMemberManagerSPtr Server::GetCacheGroupMemberManager() {
   CHECK(cache_group_member_manager_ != nullptr) << "cache_group_member_manager_ is nullptr.";
 
@@ -580,6 +618,9 @@ void Server::Stop() {
   heartbeat_->Destroy();
   crontab_manager_.Destroy();
   monitor_->Destroy();
+  balancer_->Destroy();
+
+  EventLog::GetInstance().Destroy();
 }
 
 static void DescribeTcmallocByJson(Json::Value& value) {
@@ -21,6 +21,7 @@
 
 #include "brpc/server.h"
 #include "json/value.h"
+#include "mds/background/balancer.h"
 #include "mds/background/cache_member_sync.h"
 #include "mds/background/fsinfo_sync.h"
 #include "mds/background/gc.h"
@@ -78,6 +79,8 @@ class Server {
 
   bool InitGcProcessor();
 
+  bool InitBalancer();
+
   bool InitCrontab();
 
   bool InitService();
@@ -97,6 +100,7 @@ class Server {
   OperationProcessorSPtr GetOperationProcessor();
   QuotaSynchronizerSPtr GetQuotaSynchronizer();
   GcProcessorSPtr GetGcProcessor();
+  BalancerSPtr GetBalancer();
   CacheGroupMemberManagerSPtr GetCacheGroupMemberManager();
   CacheMemberSynchronizerSPtr& GetCacheMemberSynchronizer();
 
@@ -168,6 +172,9 @@ class Server {
   // gc
   GcProcessorSPtr gc_processor_;
 
+  // hot bucket balancer
+  BalancerSPtr balancer_;
+
   // service
   MDSServiceImplUPtr mds_service_;
   DebugServiceImplUPtr debug_service_;
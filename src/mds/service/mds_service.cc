@@ -104,6 +104,8 @@ static Status ValidateRequest(FileSystemSPtr& file_system, T* request, uint64_t
   }
 
   if (file_system == nullptr) {
+    // follower not load fs yet, client should fallback to owner rather than take it as not exist
+    if (request->context().is_follower_read()) return Status(pb::error::ENOT_SERVE, "fs not found");
     return Status(pb::error::ENOT_FOUND, "fs not found");
   }
 
@@ -800,6 +802,7 @@ void MDSServiceImpl::DoBatchGetInode(google::protobuf::RpcController*, const pb:
   }
 
   for (auto& entry : entries) {
+    response->add_attr_leases()->Swap(&entry.attr_lease);
     response->add_inodes()->Swap(&entry.attr);
   }
 }
@@ -877,6 +880,8 @@ void MDSServiceImpl::DoLookup(google::protobuf::RpcController* controller, const
   EntryOut entry_out;
   status = file_system->Lookup(ctx, request->parent(), request->name(), entry_out);
   ServiceHelper::SetResponseInfo(ctx.GetTrace(), response->mutable_info());
+  // lease also cover negative dentry
+  response->set_dentry_lease_ms(entry_out.dentry_lease_ms);
   if (BAIDU_UNLIKELY(!status.ok())) {
     SpanScope::SetStatus(span, status);
     return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
@@ -1297,6 +1302,61 @@ void MDSServiceImpl::ReadDir(google::protobuf::RpcController* controller, const
   RunInQueue(ReadDir, controller, request, response, svr_done, read_worker_set_);
 }
 
+void MDSServiceImpl::DoReadDirSince(google::protobuf::RpcController*, const pb::mds::ReadDirSinceRequest* request,
+                                    pb::mds::ReadDirSinceResponse* response, TraceClosure* done) {
+  brpc::ClosureGuard done_guard(done);
+  done->SetQueueWaitTime();
+
+  auto span = StartSpan("MDSServiceImpl::DoReadDirSince", request->info());
+
+  auto file_system = GetFileSystem(request->fs_id());
+  auto status = ValidateRequest(file_system, request, done->GetQueueWaitTimeUs());
+  if (BAIDU_UNLIKELY(!status.ok())) {
+    SpanScope::SetStatus(span, status);
+    return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
+  }
+
+  Context ctx(request->context(), request->info().request_id(), __func__);
+
+  Partition::Cursor cursor{request->epoch(), request->seq()};
+  Partition::Cursor cur_cursor;
+  bool is_complete = false;
+  std::vector<DentryDeltaOut> delta_outs;
+  status = file_system->ReadDirSince(ctx, request->ino(), cursor, request->limit(), request->with_attr(), is_complete,
+                                     cur_cursor, delta_outs);
+  ServiceHelper::SetResponseInfo(ctx.GetTrace(), response->mutable_info());
+  if (BAIDU_UNLIKELY(!status.ok())) {
+    SpanScope::SetStatus(span, status);
+    return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
+  }
+
+  response->set_is_complete(is_complete);
+  response->set_epoch(cur_cursor.epoch);
+  response->set_seq(cur_cursor.seq);
+  for (auto& delta_out : delta_outs) {
+    auto* mut_delta = response->add_deltas();
+    mut_delta->set_is_delete(delta_out.is_delete);
+    auto* mut_entry = mut_delta->mutable_entry();
+    mut_entry->set_name(delta_out.entry.name);
+    mut_entry->set_ino(delta_out.entry.attr.ino());
+    if (request->with_attr() && !delta_out.is_delete) {
+      mut_entry->mutable_inode()->Swap(&delta_out.entry.attr);
+    }
+  }
+}
+
+void MDSServiceImpl::ReadDirSince(google::protobuf::RpcController* controller,
+                                  const pb::mds::ReadDirSinceRequest* request,
+                                  pb::mds::ReadDirSinceResponse* response, google::protobuf::Closure* done) {
+  auto* svr_done = new ServiceClosure(__func__, done, request, response);
+
+  // run in place.
+  RunInPlace(ReadDirSince, controller, request, response, svr_done);
+
+  // run in queue.
+  RunInQueue(ReadDirSince, controller, request, response, svr_done, read_worker_set_);
+}
+
 void MDSServiceImpl::DoOpen(google::protobuf::RpcController*, const pb::mds::OpenRequest* request,
                             pb::mds::OpenResponse* response, TraceClosure* done) {
   brpc::ClosureGuard done_guard(done);
@@ -1337,7 +1397,7 @@ void MDSServiceImpl::DoOpen(google::protobuf::RpcController*, const pb::mds::Ope
   response->mutable_inode()->Swap(&entry_out.attr);
   Helper::VectorToPbRepeated(chunks, response->mutable_chunks());
   response->set_data(std::move(data));
-  response->set_data_version(data_version);
+  response->set_data_version(data_version);  response->mutable_attr_lease()->Swap(&entry_out.attr_lease);
 }
 
 void MDSServiceImpl::Open(google::protobuf::RpcController* controller, const pb::mds::OpenRequest* request,
@@ -1706,6 +1766,7 @@ void MDSServiceImpl::DoGetAttr(google::protobuf::RpcController*, const pb::mds::
   }
 
   response->mutable_inode()->Swap(&entry_out.attr);
+  response->mutable_attr_lease()->Swap(&entry_out.attr_lease);
 }
 
 void MDSServiceImpl::GetAttr(google::protobuf::RpcController* controller, const pb::mds::GetAttrRequest* request,
@@ -2085,6 +2146,20 @@ void MDSServiceImpl::DoAllocSliceId(google::protobuf::RpcController*, const pb::
                                    "param alloc_num is error");
   }
 
+  // pack id is one by one, it is recorded pending until its slices are committed
+  FileSystemSPtr file_system;
+  if (request->is_pack()) {
+    if (request->alloc_num() != 1) {
+      return ServiceHelper::SetError(response->mutable_error(), pb::error::EILLEGAL_PARAMTETER,
+                                     "param alloc_num of pack is error");
+    }
+
+    file_system = GetFileSystem(request->fs_id());
+    if (file_system == nullptr) {
+      return ServiceHelper::SetError(response->mutable_error(), pb::error::ENOT_FOUND, "fs not found");
+    }
+  }
+
   uint64_t slice_id;
   auto status = file_system_set_->AllocSliceId(request->alloc_num(), request->min_slice_id(), slice_id);
   if (BAIDU_UNLIKELY(!status.ok())) {
@@ -2092,6 +2167,14 @@ void MDSServiceImpl::DoAllocSliceId(google::protobuf::RpcController*, const pb::
     return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
   }
 
+  if (file_system != nullptr) {
+    status = file_system->AddPendingPack(slice_id);
+    if (BAIDU_UNLIKELY(!status.ok())) {
+      SpanScope::SetStatus(span, status);
+      return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
+    }
+  }
+
   response->set_slice_id(slice_id);
 }
 
@@ -2170,6 +2253,89 @@ void MDSServiceImpl::WriteSlice(google::protobuf::RpcController* controller, con
   RunInQueue(WriteSlice, controller, request, response, svr_done, write_worker_set_);
 }
 
+void MDSServiceImpl::DoBatchWriteSlice(google::protobuf::RpcController*,
+                                       const pb::mds::BatchWriteSliceRequest* request,
+                                       pb::mds::BatchWriteSliceResponse* response, TraceClosure* done) {
+  brpc::ClosureGuard done_guard(done);
+  done->SetQueueWaitTime();
+
+  auto span = StartSpan("MDSServiceImpl::DoBatchWriteSlice", request->info());
+
+  auto file_system = GetFileSystem(request->fs_id());
+  auto status = ValidateRequest(file_system, request, done->GetQueueWaitTimeUs());
+  if (BAIDU_UNLIKELY(!status.ok())) {
+    SpanScope::SetStatus(span, status);
+    return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
+  }
+
+  Context ctx(request->context(), request->info().request_id(), __func__);
+
+  std::vector<FileSystem::WriteSliceParam> params;
+  params.reserve(request->items_size());
+  for (const auto& item : request->items()) {
+    FileSystem::WriteSliceParam param;
+    param.ino = item.ino();
+    param.delta_slices = Helper::PbRepeatedToVector(item.delta_slices());
+    params.push_back(std::move(param));
+  }
+
+  status = file_system->BatchWriteSlice(ctx, params);
+  ServiceHelper::SetResponseInfo(ctx.GetTrace(), response->mutable_info());
+  if (BAIDU_UNLIKELY(!status.ok())) {
+    SpanScope::SetStatus(span, status);
+    return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
+  }
+
+  for (auto& param : params) {
+    auto* result = response->add_results();
+    result->set_ino(param.ino);
+    if (!param.status.ok()) {
+      ServiceHelper::SetError(result->mutable_error(), param.status.error_code(), param.status.error_str());
+      continue;
+    }
+
+    Helper::VectorToPbRepeated(param.out_chunks, result->mutable_chunks());
+  }
+}
+
+void MDSServiceImpl::BatchWriteSlice(google::protobuf::RpcController* controller,
+                                     const pb::mds::BatchWriteSliceRequest* request,
+                                     pb::mds::BatchWriteSliceResponse* response, google::protobuf::Closure* done) {
+  auto* svr_done = new ServiceClosure(__func__, done, request, response);
+
+  // validate request
+  auto validate_fn = [&]() -> Status {
+    if (request->fs_id() == 0) {
+      return Status(pb::error::EILLEGAL_PARAMTETER, "fs_id is 0");
+    }
+    if (request->items().empty()) {
+      return Status(pb::error::EILLEGAL_PARAMTETER, "items is empty");
+    }
+    for (const auto& item : request->items()) {
+      if (item.ino() == 0) {
+        return Status(pb::error::EILLEGAL_PARAMTETER, "ino is 0");
+      }
+      if (item.delta_slices().empty()) {
+        return Status(pb::error::EILLEGAL_PARAMTETER, "delta_slices is empty");
+      }
+    }
+
+    return Status::OK();
+  };
+
+  auto status = validate_fn();
+  if (BAIDU_UNLIKELY(!status.ok())) {
+    brpc::ClosureGuard done_guard(svr_done);
+    return ServiceHelper::SetError(response->mutable_error(), status.error_code(), status.error_str());
+  }
+
+  // run in place.
+  RunInPlace(BatchWriteSlice, controller, request, response, svr_done);
+
+  // run in queue.
+  RunInQueue(BatchWriteSlice, controller, request, response, svr_done, write_worker_set_);
+}
+
 void MDSServiceImpl::DoReadSlice(google::protobuf::RpcController* controller, const pb::mds::ReadSliceRequest* request,
                                  pb::mds::ReadSliceResponse* response, TraceClosure* done) {
   brpc::ClosureGuard done_guard(done);
@@ -2187,8 +2353,9 @@ void MDSServiceImpl::DoReadSlice(google::protobuf::RpcController* controller, co
   Context ctx(request->context(), request->info().request_id(), __func__);
 
   std::vector<ChunkEntry> chunks;
-  status =
-      file_system->ReadSlice(ctx, request->ino(), Helper::PbRepeatedToVector(request->chunk_descriptors()), chunks);
+  std::vector<uint32_t> not_modified_indexes;
+  status = file_system->ReadSlice(ctx, request->ino(), Helper::PbRepeatedToVector(request->chunk_descriptors()),
+                                  chunks, &not_modified_indexes);
   ServiceHelper::SetResponseInfo(ctx.GetTrace(), response->mutable_info());
   if (BAIDU_UNLIKELY(!status.ok())) {
     SpanScope::SetStatus(span, status);
@@ -2196,6 +2363,7 @@ void MDSServiceImpl::DoReadSlice(google::protobuf::RpcController* controller, co
   }
 
   Helper::VectorToPbRepeated(chunks, response->mutable_chunks());
+  Helper::VectorToPbRepeated(not_modified_indexes, response->mutable_not_modified_indexes());
 }
 
 void MDSServiceImpl::ReadSlice(google::protobuf::RpcController* controller, const pb::mds::ReadSliceRequest* request,
@@ -2989,7 +3157,26 @@ void MDSServiceImpl::DoNotifyBuddy(google::protobuf::RpcController*, const pb::m
         }
 
         file_system->GetPartitionCache().Delete(message.clean_partition_cache().ino());
+        file_system->RevokeDentryLease(message.clean_partition_cache().ino());
+
+      } break;
+
+      case pb::mds::NotifyBuddyRequest::TYPE_FOLLOW_FS: {
+        auto file_system = GetFileSystem(message.fs_id());
+        if (file_system == nullptr) {
+          return ServiceHelper::SetError(response->mutable_error(), pb::error::ENOT_FOUND, "fs not found");
+        }
+
+        file_system->AddFollower(message.follow_fs().mds_id());
+      } break;
+
+      case pb::mds::NotifyBuddyRequest::TYPE_UPDATE_DENTRY: {
+        auto file_system = GetFileSystem(message.fs_id());
+        if (file_system == nullptr) {
+          return ServiceHelper::SetError(response->mutable_error(), pb::error::ENOT_FOUND, "fs not found");
+        }
 
+        file_system->RefreshDentry(message.update_dentry());
       } break;
 
       case pb::mds::NotifyBuddyRequest::TYPE_SET_DIR_QUOTA: {
@@ -108,6 +108,8 @@ class MDSServiceImpl : public pb::mds::MDSService {
              pb::mds::RmDirResponse* response, google::protobuf::Closure* done) override;
   void ReadDir(google::protobuf::RpcController* controller, const pb::mds::ReadDirRequest* request,
                pb::mds::ReadDirResponse* response, google::protobuf::Closure* done) override;
+  void ReadDirSince(google::protobuf::RpcController* controller, const pb::mds::ReadDirSinceRequest* request,
+                    pb::mds::ReadDirSinceResponse* response, google::protobuf::Closure* done) override;
 
   void Open(google::protobuf::RpcController* controller, const pb::mds::OpenRequest* request,
             pb::mds::OpenResponse* response, google::protobuf::Closure* done) override;
@@ -157,6 +159,8 @@ class MDSServiceImpl : public pb::mds::MDSService {
 
   void WriteSlice(google::protobuf::RpcController* controller, const pb::mds::WriteSliceRequest* request,
                   pb::mds::WriteSliceResponse* response, google::protobuf::Closure* done) override;
+  void BatchWriteSlice(google::protobuf::RpcController* controller, const pb::mds::BatchWriteSliceRequest* request,
+                       pb::mds::BatchWriteSliceResponse* response, google::protobuf::Closure* done) override;
 
   void ReadSlice(google::protobuf::RpcController* controller, const pb::mds::ReadSliceRequest* request,
                  pb::mds::ReadSliceResponse* response, google::protobuf::Closure* done) override;
@@ -302,6 +306,8 @@ class MDSServiceImpl : public pb::mds::MDSService {
                pb::mds::RmDirResponse* response, TraceClosure* done);
   void DoReadDir(google::protobuf::RpcController* controller, const pb::mds::ReadDirRequest* request,
                  pb::mds::ReadDirResponse* response, TraceClosure* done);
+  void DoReadDirSince(google::protobuf::RpcController* controller, const pb::mds::ReadDirSinceRequest* request,
+                      pb::mds::ReadDirSinceResponse* response, TraceClosure* done);
 
   void DoOpen(google::protobuf::RpcController* controller, const pb::mds::OpenRequest* request,
               pb::mds::OpenResponse* response, TraceClosure* done);
@@ -346,6 +352,8 @@ class MDSServiceImpl : public pb::mds::MDSService {
                       pb::mds::AllocSliceIdResponse* response, TraceClosure* done);
   void DoWriteSlice(google::protobuf::RpcController* controller, const pb::mds::WriteSliceRequest* request,
                     pb::mds::WriteSliceResponse* response, TraceClosure* done);
+  void DoBatchWriteSlice(google::protobuf::RpcController* controller, const pb::mds::BatchWriteSliceRequest* request,
+                         pb::mds::BatchWriteSliceResponse* response, TraceClosure* done);
   void DoReadSlice(google::protobuf::RpcController* controller, const pb::mds::ReadSliceRequest* request,
                    pb::mds::ReadSliceResponse* response, TraceClosure* done);
 
@@ -104,5 +104,51 @@ Status ServiceAccess::NotifyBuddy(const butil::EndPoint& endpoint, const pb::mds
   return Status::OK();
 }
 
+Status ServiceAccess::InvalidateDentry(const butil::EndPoint& endpoint,
+                                      const pb::client::InvalidateDentryRequest& request) {
+  auto channel = ChannelPool::GetInstance().GetChannel(endpoint);
+  if (channel == nullptr) {
+    return Status(pb::error::EINTERNAL, "get channel fail");
+  }
+
+  pb::client::MetaCacheService_Stub stub(channel.get());
+
+  brpc::Controller cntl;
+  cntl.set_timeout_ms(kRpcTimeoutMs);
+
+  pb::client::InvalidateDentryResponse response;
+
+  stub.InvalidateDentry(&cntl, &request, &response, nullptr);
+  if (cntl.Failed()) {
+    LOG(ERROR) << "send request fail, " << cntl.ErrorText();
+    return Status(pb::error::EINTERNAL, cntl.ErrorText());
+  }
+
+  return Status::OK();
+}
+
+Status ServiceAccess::RecallAttrLease(const butil::EndPoint& endpoint,
+                                     const pb::client::RecallAttrLeaseRequest& request) {
+  auto channel = ChannelPool::GetInstance().GetChannel(endpoint);
+  if (channel == nullptr) {
+    return Status(pb::error::EINTERNAL, "get channel fail");
+  }
+
+  pb::client::MetaCacheService_Stub stub(channel.get());
+
+  brpc::Controller cntl;
+  cntl.set_timeout_ms(kRpcTimeoutMs);
+
+  pb::client::RecallAttrLeaseResponse response;
+
+  stub.RecallAttrLease(&cntl, &request, &response, nullptr);
+  if (cntl.Failed()) {
+    LOG(ERROR) << "send request fail, " << cntl.ErrorText();
+    return Status(pb::error::EINTERNAL, cntl.ErrorText());
+  }
+
+  return Status::OK();
+}
+
 }  // namespace mds
 }  // namespace dingofs
\ No newline at end of file
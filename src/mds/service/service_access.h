@@ -21,6 +21,7 @@
 #include "brpc/channel.h"
 #include "bthread/types.h"
 #include "dingofs/mds.pb.h"
+#include "dingofs/vfs.pb.h"
 #include "mds/common/status.h"
 
 namespace dingofs {
@@ -45,6 +46,8 @@ class ServiceAccess {
  public:
   static Status CheckAlive(const butil::EndPoint& endpoint);
   static Status NotifyBuddy(const butil::EndPoint& endpoint, const pb::mds::NotifyBuddyRequest& request);
+  static Status InvalidateDentry(const butil::EndPoint& endpoint, const pb::client::InvalidateDentryRequest& request);
+  static Status RecallAttrLease(const butil::EndPoint& endpoint, const pb::client::RecallAttrLeaseRequest& request);
 };
 
 }  // namespace mds
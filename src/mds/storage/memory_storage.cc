@@ -0,0 +1,897 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/storage/memory_storage.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "brpc/reloadable_flags.h"
+#include "bthread/bthread.h"
+#include "bthread/mutex.h"
+#include "butil/crc32c.h"
+#include "dingofs/error.pb.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "mds/common/synchronization.h"
+#include "utils/time.h"
+
+namespace dingofs {
+namespace mds {
+
+DEFINE_uint32(mds_storage_memory_shard_num, 16, "memory storage shard num.");
+
+DEFINE_bool(mds_storage_memory_wal_sync, false, "memory storage fdatasync wal for every commit.");
+DEFINE_validator(mds_storage_memory_wal_sync, brpc::PassValidate);
+
+DEFINE_uint32(mds_storage_memory_checkpoint_mb, 256, "memory storage checkpoint when wal exceed this size.");
+DEFINE_validator(mds_storage_memory_checkpoint_mb, brpc::PassValidate);
+
+static const size_t kRecordHeaderSize = 8;
+// guard against garbage length of torn record
+static const uint32_t kMaxRecordSize = 256 * 1024 * 1024;
+static const uint32_t kSnapshotBatchSize = 1024;
+// kvs buffered by every shard cursor of snapshot scan
+static const uint32_t kScanBatchSize = 64;
+// min gc keys every commit, so gc keep up with write
+static const uint32_t kGcBatchSize = 64;
+
+// wal/snapshot record: {length u32}{crc u32}{payload}
+// payload: {commit_ts u64} [{op u8}{key_len u32}{key}{value_len u32}{value}]...
+static void EncodePayload(uint64_t commit_ts, const MemoryStorage::WriteSet& writes, std::string& payload) {
+  payload.append(reinterpret_cast<const char*>(&commit_ts), sizeof(commit_ts));
+  for (const auto& [key, kv] : writes) {
+    payload.push_back(static_cast<char>(kv.opt_type));
+
+    uint32_t key_len = key.size();
+    payload.append(reinterpret_cast<const char*>(&key_len), sizeof(key_len));
+    payload.append(key);
+
+    uint32_t value_len = kv.value.size();
+    payload.append(reinterpret_cast<const char*>(&value_len), sizeof(value_len));
+    payload.append(kv.value);
+  }
+}
+
+static bool DecodePayload(const std::string& payload, uint64_t& commit_ts, MemoryStorage::WriteSet& writes) {
+  if (payload.size() < sizeof(commit_ts)) return false;
+
+  size_t offset = 0;
+  memcpy(&commit_ts, payload.data(), sizeof(commit_ts));
+  offset += sizeof(commit_ts);
+
+  auto read_string = [&](std::string& out) -> bool {
+    uint32_t len;
+    if (offset + sizeof(len) > payload.size()) return false;
+    memcpy(&len, payload.data() + offset, sizeof(len));
+    offset += sizeof(len);
+
+    if (offset + len > payload.size()) return false;
+    out.assign(payload.data() + offset, len);
+    offset += len;
+    return true;
+  };
+
+  while (offset < payload.size()) {
+    KeyValue kv;
+    kv.opt_type = static_cast<KeyValue::OpType>(payload[offset++]);
+    if (!read_string(kv.key) || !read_string(kv.value)) return false;
+
+    std::string key = kv.key;
+    writes[key] = std::move(kv);
+  }
+
+  return true;
+}
+
+static void AppendRecord(const std::string& payload, std::string& out) {
+  uint32_t length = payload.size();
+  uint32_t crc = butil::crc32c::Value(payload.data(), payload.size());
+
+  out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  out.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+  out.append(payload);
+}
+
+// replay records until eof or torn record, return the valid size
+static bool ReplayRecords(const std::string& path, const std::function<bool(const std::string&)>& func,
+                          uint64_t& valid_size) {
+  valid_size = 0;
+
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) return errno == ENOENT;
+
+  std::string payload;
+  char header[kRecordHeaderSize];
+  while (fread(header, 1, kRecordHeaderSize, file) == kRecordHeaderSize) {
+    uint32_t length, crc;
+    memcpy(&length, header, sizeof(length));
+    memcpy(&crc, header + sizeof(length), sizeof(crc));
+    if (length > kMaxRecordSize) break;
+
+    payload.resize(length);
+    if (fread(payload.data(), 1, length, file) != length) break;
+    if (butil::crc32c::Value(payload.data(), payload.size()) != crc) break;
+
+    if (!func(payload)) {
+      fclose(file);
+      return false;
+    }
+
+    valid_size += kRecordHeaderSize + length;
+  }
+
+  fclose(file);
+
+  return true;
+}
+
+static Status WriteFully(int fd, const std::string& data) {
+  size_t offset = 0;
+  while (offset < data.size()) {
+    ssize_t n = ::write(fd, data.data() + offset, data.size() - offset);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return Status(pb::error::EBACKEND_STORE, fmt::format("write fail, {}", strerror(errno)));
+    }
+    offset += n;
+  }
+
+  return Status::OK();
+}
+
+MemoryStorage::MemoryStorage() {
+  CHECK(bthread_mutex_init(&commit_mutex_, nullptr) == 0) << "[storage] init commit mutex fail.";
+  CHECK(bthread_mutex_init(&active_mutex_, nullptr) == 0) << "[storage] init active mutex fail.";
+
+  uint32_t shard_num = std::max(FLAGS_mds_storage_memory_shard_num, 1U);
+  shards_.reserve(shard_num);
+  for (uint32_t i = 0; i < shard_num; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+MemoryStorage::~MemoryStorage() {
+  Destroy();
+
+  bthread_mutex_destroy(&commit_mutex_);
+  bthread_mutex_destroy(&active_mutex_);
+}
+
+bool MemoryStorage::Init(const std::string& addr) {
+  LOG(INFO) << fmt::format("[storage] init memory storage, path({}).", addr);
+
+  if (addr.empty()) return true;
+
+  path_ = addr;
+  if (::mkdir(path_.c_str(), 0755) != 0 && errno != EEXIST) {
+    LOG(ERROR) << fmt::format("[storage] create dir({}) fail, {}.", path_, strerror(errno));
+    return false;
+  }
+
+  BAIDU_SCOPED_LOCK(commit_mutex_);
+
+  return Recover();
+}
+
+bool MemoryStorage::Destroy() {
+  bthread_t checkpoint_tid = 0;
+  {
+    BAIDU_SCOPED_LOCK(commit_mutex_);
+    checkpoint_tid = checkpoint_tid_;
+    checkpoint_tid_ = 0;
+  }
+  if (checkpoint_tid != 0) bthread_join(checkpoint_tid, nullptr);
+
+  BAIDU_SCOPED_LOCK(commit_mutex_);
+
+  if (wal_fd_ >= 0) {
+    ::fdatasync(wal_fd_);
+    ::close(wal_fd_);
+    wal_fd_ = -1;
+  }
+
+  return true;
+}
+
+bool MemoryStorage::Recover() {
+  // wal record already in snapshot is skipped, e.g. old wal left by crash after snapshot saved
+  uint64_t snapshot_ts = 0;
+  auto replay_fn = [&](const std::string& payload) -> bool {
+    uint64_t commit_ts = 0;
+    WriteSet writes;
+    if (!DecodePayload(payload, commit_ts, writes)) return false;
+    if (commit_ts <= snapshot_ts) return true;
+
+    ApplyWrites(commit_ts, writes);
+    commit_ts_ = std::max(commit_ts_, commit_ts);
+    read_ts_.store(commit_ts_, std::memory_order_release);
+    return true;
+  };
+
+  uint64_t snapshot_size = 0;
+  if (!ReplayRecords(SnapshotPath(), replay_fn, snapshot_size)) {
+    LOG(ERROR) << fmt::format("[storage] replay snapshot({}) fail.", SnapshotPath());
+    return false;
+  }
+  snapshot_ts = commit_ts_;
+
+  uint64_t old_wal_size = 0;
+  if (!ReplayRecords(OldWalPath(), replay_fn, old_wal_size)) {
+    LOG(ERROR) << fmt::format("[storage] replay wal({}) fail.", OldWalPath());
+    return false;
+  }
+  has_old_wal_ = ::access(OldWalPath().c_str(), F_OK) == 0;
+
+  uint64_t wal_size = 0;
+  if (!ReplayRecords(WalPath(), replay_fn, wal_size)) {
+    LOG(ERROR) << fmt::format("[storage] replay wal({}) fail.", WalPath());
+    return false;
+  }
+
+  wal_fd_ = ::open(WalPath().c_str(), O_CREAT | O_WRONLY, 0644);
+  if (wal_fd_ < 0) {
+    LOG(ERROR) << fmt::format("[storage] open wal({}) fail, {}.", WalPath(), strerror(errno));
+    return false;
+  }
+
+  // drop torn tail record
+  if (::ftruncate(wal_fd_, wal_size) != 0 || ::lseek(wal_fd_, wal_size, SEEK_SET) < 0) {
+    LOG(ERROR) << fmt::format("[storage] truncate wal({}) fail, {}.", WalPath(), strerror(errno));
+    return false;
+  }
+  wal_size_ = wal_size;
+
+  read_ts_.store(commit_ts_, std::memory_order_release);
+
+  LOG(INFO) << fmt::format(
+      "[storage] recover memory storage finish, snapshot_size({}) old_wal_size({}) wal_size({}) ts({}).",
+      snapshot_size, old_wal_size, wal_size, commit_ts_);
+
+  return true;
+}
+
+Status MemoryStorage::AppendWal(uint64_t commit_ts, const WriteSet& writes) {
+  if (wal_fd_ < 0) return Status::OK();
+  if (!wal_status_.ok()) return wal_status_;
+
+  std::string payload, record;
+  EncodePayload(commit_ts, writes, payload);
+  AppendRecord(payload, record);
+
+  auto status = WriteFully(wal_fd_, record);
+  if (!status.ok()) {
+    // drop torn record, otherwise later records are appended after garbage and lost on recover
+    if (::ftruncate(wal_fd_, wal_size_) != 0 || ::lseek(wal_fd_, wal_size_, SEEK_SET) < 0) {
+      wal_status_ = Status(pb::error::EBACKEND_STORE, fmt::format("truncate wal fail, {}", strerror(errno)));
+      LOG(ERROR) << fmt::format("[storage] wal broken, status({}).", wal_status_.error_str());
+    }
+    return status;
+  }
+
+  if (FLAGS_mds_storage_memory_wal_sync && ::fdatasync(wal_fd_) != 0) {
+    // page cache state is unknown after sync fail, record may or may not replay, so fail stop
+    wal_status_ = Status(pb::error::EBACKEND_STORE, fmt::format("sync wal fail, {}", strerror(errno)));
+    LOG(ERROR) << fmt::format("[storage] wal broken, status({}).", wal_status_.error_str());
+    return wal_status_;
+  }
+
+  wal_size_ += record.size();
+
+  return Status::OK();
+}
+
+// must hold commit mutex
+void MemoryStorage::MaybeCheckpoint() {
+  if (wal_fd_ < 0 || is_checkpointing_) return;
+  if (wal_size_ <= static_cast<uint64_t>(FLAGS_mds_storage_memory_checkpoint_mb) * 1024 * 1024) return;
+
+  // old wal is left by failed checkpoint, keep it until a snapshot cover it
+  if (!has_old_wal_) {
+    auto status = RotateWal();
+    if (!status.ok()) {
+      LOG(ERROR) << fmt::format("[storage] rotate wal fail, status({}).", status.error_str());
+      return;
+    }
+  }
+
+  // hold versions of checkpoint ts until snapshot saved
+  checkpoint_ts_ = BeginTxn();
+  CHECK(checkpoint_ts_ == commit_ts_) << "checkpoint ts not match commit ts.";
+  is_checkpointing_ = true;
+
+  if (checkpoint_tid_ != 0) bthread_join(checkpoint_tid_, nullptr);
+  if (bthread_start_background(&checkpoint_tid_, nullptr, RunCheckpoint, this) != 0) {
+    LOG(ERROR) << "[storage] start checkpoint bthread fail.";
+    checkpoint_tid_ = 0;
+    EndTxn(checkpoint_ts_);
+    is_checkpointing_ = false;
+  }
+}
+
+// must hold commit mutex
+Status MemoryStorage::RotateWal() {
+  if (::rename(WalPath().c_str(), OldWalPath().c_str()) != 0) {
+    return Status(pb::error::EBACKEND_STORE, fmt::format("rename wal fail, {}", strerror(errno)));
+  }
+  has_old_wal_ = true;
+
+  int fd = ::open(WalPath().c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+  if (fd < 0) {
+    return Status(pb::error::EBACKEND_STORE, fmt::format("open wal fail, {}", strerror(errno)));
+  }
+
+  ::close(wal_fd_);
+  wal_fd_ = fd;
+  wal_size_ = 0;
+
+  return Status::OK();
+}
+
+void* MemoryStorage::RunCheckpoint(void* arg) {
+  auto* self = static_cast<MemoryStorage*>(arg);
+
+  uint64_t ts = 0;
+  {
+    BAIDU_SCOPED_LOCK(self->commit_mutex_);
+    ts = self->checkpoint_ts_;
+  }
+
+  auto status = self->Checkpoint(ts);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("[storage] checkpoint memory storage fail, status({}).", status.error_str());
+  }
+
+  self->EndTxn(ts);
+
+  BAIDU_SCOPED_LOCK(self->commit_mutex_);
+  if (status.ok()) self->has_old_wal_ = false;
+  self->is_checkpointing_ = false;
+
+  return nullptr;
+}
+
+// dump snapshot of ts to snapshot file then remove old wal, commit go on meanwhile
+Status MemoryStorage::Checkpoint(uint64_t ts) {
+  utils::Duration duration;
+
+  std::string tmp_path = SnapshotPath() + ".tmp";
+  int fd = ::open(tmp_path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+  if (fd < 0) {
+    return Status(pb::error::EBACKEND_STORE, fmt::format("open {} fail, {}", tmp_path, strerror(errno)));
+  }
+  ON_SCOPE_EXIT([&]() { ::close(fd); });
+
+  uint64_t count = 0;
+  WriteSet batch;
+  std::string buffer;
+  auto flush_fn = [&]() -> Status {
+    if (batch.empty()) return Status::OK();
+
+    std::string payload;
+    EncodePayload(ts, batch, payload);
+    AppendRecord(payload, buffer);
+    batch.clear();
+
+    auto status = WriteFully(fd, buffer);
+    buffer.clear();
+    return status;
+  };
+
+  Status status;
+  SnapshotScan(Range{}, ts, [&](KeyValue& kv) -> bool {
+    std::string key = kv.key;
+    batch[key] = std::move(kv);
+    ++count;
+    if (batch.size() >= kSnapshotBatchSize) status = flush_fn();
+    return status.ok();
+  });
+  if (!status.ok()) return status;
+
+  status = flush_fn();
+  if (!status.ok()) return status;
+
+  if (::fdatasync(fd) != 0 || ::rename(tmp_path.c_str(), SnapshotPath().c_str()) != 0) {
+    return Status(pb::error::EBACKEND_STORE, fmt::format("save snapshot fail, {}", strerror(errno)));
+  }
+
+  // snapshot must be durable before drop old wal
+  int dir_fd = ::open(path_.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir_fd < 0 || ::fsync(dir_fd) != 0) {
+    if (dir_fd >= 0) ::close(dir_fd);
+    return Status(pb::error::EBACKEND_STORE, fmt::format("sync dir fail, {}", strerror(errno)));
+  }
+  ::close(dir_fd);
+
+  if (::unlink(OldWalPath().c_str()) != 0 && errno != ENOENT) {
+    return Status(pb::error::EBACKEND_STORE, fmt::format("remove old wal fail, {}", strerror(errno)));
+  }
+
+  LOG(INFO) << fmt::format("[storage][{}us] checkpoint memory storage finish, count({}) ts({}).",
+                           duration.ElapsedUs(), count, ts);
+
+  return Status::OK();
+}
+
+MemoryStorage::Shard& MemoryStorage::GetShard(const std::string& key) {
+  return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+const MemoryStorage::Version* MemoryStorage::FindVersion(const VersionChain& chain, uint64_t ts) {
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    if (it->ts <= ts) return &(*it);
+  }
+
+  return nullptr;
+}
+
+void MemoryStorage::PruneVersion(VersionChain& chain, uint64_t min_active_ts) {
+  // keep the newest version visible to min_active_ts and all newer ones
+  for (size_t i = chain.size(); i > 0; --i) {
+    if (chain[i - 1].ts <= min_active_ts) {
+      if (i > 1) chain.erase(chain.begin(), chain.begin() + (i - 1));
+      return;
+    }
+  }
+}
+
+uint64_t MemoryStorage::BeginTxn() {
+  BAIDU_SCOPED_LOCK(active_mutex_);
+
+  uint64_t start_ts = ReadTs();
+  active_ts_.insert(start_ts);
+
+  return start_ts;
+}
+
+void MemoryStorage::EndTxn(uint64_t start_ts) {
+  BAIDU_SCOPED_LOCK(active_mutex_);
+
+  auto it = active_ts_.find(start_ts);
+  if (it != active_ts_.end()) active_ts_.erase(it);
+}
+
+uint64_t MemoryStorage::MinActiveTs() {
+  BAIDU_SCOPED_LOCK(active_mutex_);
+
+  return active_ts_.empty() ? ReadTs() : *active_ts_.begin();
+}
+
+bool MemoryStorage::SnapshotGet(const std::string& key, uint64_t ts, std::string& value) {
+  auto& shard = GetShard(key);
+  utils::ReadLockGuard lock(shard.lock);
+
+  auto it = shard.data.find(key);
+  if (it == shard.data.end()) return false;
+
+  const auto* version = FindVersion(it->second, ts);
+  if (version == nullptr || version->is_deleted) return false;
+
+  value = version->value;
+
+  return true;
+}
+
+void MemoryStorage::SnapshotScan(const Range& range, uint64_t ts, const std::function<bool(KeyValue&)>& handler) {
+  // every shard is ordered, buffer a few kvs of each shard and refill by seek after the last key,
+  // so shard lock is held only when refill
+  struct Cursor {
+    Shard* shard{nullptr};
+    std::string seek_key;
+    std::deque<KeyValue> kvs;
+    bool is_eof{false};
+  };
+
+  auto refill_fn = [&](Cursor& cursor) {
+    utils::ReadLockGuard lock(cursor.shard->lock);
+
+    auto& data = cursor.shard->data;
+    for (auto it = data.lower_bound(cursor.seek_key); it != data.end(); ++it) {
+      if (!range.end.empty() && it->first >= range.end) break;
+      if (cursor.kvs.size() >= kScanBatchSize) {
+        cursor.seek_key = it->first;
+        return;
+      }
+
+      const auto* version = FindVersion(it->second, ts);
+      if (version == nullptr || version->is_deleted) continue;
+
+      cursor.kvs.push_back(KeyValue{KeyValue::OpType::kPut, it->first, version->value});
+    }
+
+    cursor.is_eof = true;
+  };
+
+  std::vector<Cursor> cursors(shards_.size());
+  // min heap of cursor index by its first key
+  auto cmp = [&cursors](size_t a, size_t b) { return cursors[a].kvs.front().key > cursors[b].kvs.front().key; };
+  std::vector<size_t> heap;
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    cursors[i].shard = shards_[i].get();
+    cursors[i].seek_key = range.start;
+    refill_fn(cursors[i]);
+    if (!cursors[i].kvs.empty()) heap.push_back(i);
+  }
+  std::make_heap(heap.begin(), heap.end(), cmp);
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), cmp);
+    auto& cursor = cursors[heap.back()];
+
+    KeyValue kv = std::move(cursor.kvs.front());
+    cursor.kvs.pop_front();
+    if (cursor.kvs.empty() && !cursor.is_eof) refill_fn(cursor);
+
+    if (cursor.kvs.empty()) {
+      heap.pop_back();
+    } else {
+      std::push_heap(heap.begin(), heap.end(), cmp);
+    }
+
+    if (!handler(kv)) return;
+  }
+}
+
+void MemoryStorage::SnapshotScan(const Range& range, uint64_t ts, uint64_t limit, std::vector<KeyValue>& kvs) {
+  if (limit == 0) return;
+
+  SnapshotScan(range, ts, [&](KeyValue& kv) -> bool {
+    kvs.push_back(std::move(kv));
+    return kvs.size() < limit;
+  });
+}
+
+void MemoryStorage::ApplyWrites(uint64_t commit_ts, const WriteSet& writes) {
+  const uint64_t min_active_ts = MinActiveTs();
+
+  for (const auto& [key, kv] : writes) {
+    auto& shard = GetShard(key);
+    utils::WriteLockGuard lock(shard.lock);
+
+    auto& chain = shard.data[key];
+    chain.push_back(Version{commit_ts, kv.opt_type == KeyValue::OpType::kDelete, kv.value});
+    PruneVersion(chain, min_active_ts);
+
+    // old version or tombstone is still visible to some txn, collect later
+    if (chain.size() > 1 || chain.front().is_deleted) gc_keys_.push_back(GcKey{commit_ts, key});
+  }
+
+  CollectGarbage(min_active_ts, kGcBatchSize + writes.size());
+}
+
+void MemoryStorage::CollectGarbage(uint64_t min_active_ts, uint32_t budget) {
+  for (uint32_t i = 0; i < budget && !gc_keys_.empty(); ++i) {
+    auto& gc_key = gc_keys_.front();
+    if (gc_key.ts > min_active_ts) break;
+
+    auto& shard = GetShard(gc_key.key);
+    {
+      utils::WriteLockGuard lock(shard.lock);
+
+      auto it = shard.data.find(gc_key.key);
+      if (it != shard.data.end()) {
+        auto& chain = it->second;
+        PruneVersion(chain, min_active_ts);
+
+        // deleted key is invisible to everyone
+        if (chain.size() == 1 && chain.front().is_deleted && chain.front().ts <= min_active_ts) {
+          shard.data.erase(it);
+        }
+      }
+    }
+
+    gc_keys_.pop_front();
+  }
+}
+
+Status MemoryStorage::CommitTxn(uint64_t start_ts, const WriteSet& writes,
+                                const std::set<std::string>& if_absent_keys) {
+  if (writes.empty()) return Status::OK();
+
+  BAIDU_SCOPED_LOCK(commit_mutex_);
+
+  // write-write conflict, someone commit after we started
+  for (const auto& [key, _] : writes) {
+    auto& shard = GetShard(key);
+    utils::ReadLockGuard lock(shard.lock);
+
+    auto it = shard.data.find(key);
+    if (it == shard.data.end() || it->second.empty()) continue;
+
+    const auto& latest = it->second.back();
+    if (start_ts != UINT64_MAX && latest.ts > start_ts) {
+      return Status(pb::error::ESTORE_MAYBE_RETRY, fmt::format("write conflict, commit_ts({})", latest.ts));
+    }
+
+    if (if_absent_keys.count(key) > 0 && !latest.is_deleted) {
+      return Status(pb::error::EEXISTED, "key already exist");
+    }
+  }
+
+  uint64_t commit_ts = commit_ts_ + 1;
+  auto status = AppendWal(commit_ts, writes);
+  if (!status.ok()) return status;
+
+  commit_ts_ = commit_ts;
+  ApplyWrites(commit_ts, writes);
+
+  // publish after all writes are applied, so snapshot never see partial txn
+  read_ts_.store(commit_ts, std::memory_order_release);
+
+  MaybeCheckpoint();
+
+  return Status::OK();
+}
+
+Status MemoryStorage::CreateTable(const std::string& name, const TableOption& option, int64_t& table_id) {
+  utils::WriteLockGuard lock(table_lock_);
+
+  tables_[++next_table_id_] = Table{name, option.start_key, option.end_key};
+  table_id = next_table_id_;
+
+  return Status::OK();
+}
+
+Status MemoryStorage::DropTable(int64_t table_id) {
+  utils::WriteLockGuard lock(table_lock_);
+
+  tables_.erase(table_id);
+
+  return Status::OK();
+}
+
+Status MemoryStorage::DropTable(const Range& range) {
+  utils::WriteLockGuard lock(table_lock_);
+
+  for (auto it = tables_.begin(); it != tables_.end();) {
+    if (it->second.start_key == range.start && it->second.end_key == range.end) {
+      it = tables_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status MemoryStorage::IsExistTable(const std::string&, const std::string&) { return Status::OK(); }
+
+Status MemoryStorage::Put(WriteOption option, const std::string& key, const std::string& value) {
+  KeyValue kv{KeyValue::OpType::kPut, key, value};
+  return Put(option, kv);
+}
+
+Status MemoryStorage::Put(WriteOption option, KeyValue& kv) {
+  return Put(option, std::vector<KeyValue>{kv});
+}
+
+Status MemoryStorage::Put(WriteOption option, const std::vector<KeyValue>& kvs) {
+  WriteSet writes;
+  std::set<std::string> if_absent_keys;
+  for (const auto& kv : kvs) {
+    writes[kv.key] = kv;
+    if (option.is_if_absent) if_absent_keys.insert(kv.key);
+  }
+
+  return CommitTxn(UINT64_MAX, writes, if_absent_keys);
+}
+
+Status MemoryStorage::Get(const std::string& key, std::string& value) {
+  // register read ts, so versions it see are not pruned
+  const uint64_t ts = BeginTxn();
+  DEFER(EndTxn(ts));
+
+  if (!SnapshotGet(key, ts, value)) {
+    return Status(pb::error::ENOT_FOUND, "key not found");
+  }
+
+  return Status::OK();
+}
+
+Status MemoryStorage::BatchGet(const std::vector<std::string>& keys, std::vector<KeyValue>& kvs) {
+  const uint64_t ts = BeginTxn();
+  DEFER(EndTxn(ts));
+
+  for (const auto& key : keys) {
+    std::string value;
+    if (SnapshotGet(key, ts, value)) {
+      kvs.push_back(KeyValue{KeyValue::OpType::kPut, key, std::move(value)});
+    }
+  }
+
+  return Status::OK();
+}
+
+Status MemoryStorage::Scan(const Range& range, std::vector<KeyValue>& kvs) {
+  const uint64_t ts = BeginTxn();
+  DEFER(EndTxn(ts));
+
+  SnapshotScan(range, ts, UINT64_MAX, kvs);
+  return Status::OK();
+}
+
+Status MemoryStorage::Delete(const std::string& key) { return Delete(std::vector<std::string>{key}); }
+
+Status MemoryStorage::Delete(const std::vector<std::string>& keys) {
+  WriteSet writes;
+  for (const auto& key : keys) {
+    writes[key] = KeyValue{KeyValue::OpType::kDelete, key, ""};
+  }
+
+  return CommitTxn(UINT64_MAX, writes, {});
+}
+
+TxnUPtr MemoryStorage::NewTxn(Txn::IsolationLevel isolation_level) {
+  return std::make_unique<MemoryTxn>(this, isolation_level);
+}
+
+MemoryTxn::MemoryTxn(MemoryStorage* storage, Txn::IsolationLevel isolation_level)
+    : storage_(storage), isolation_level_(isolation_level) {
+  start_ts_ = storage_->BeginTxn();
+  txn_id_ = utils::TimestampNs();
+}
+
+MemoryTxn::~MemoryTxn() { storage_->EndTxn(start_ts_); }
+
+int64_t MemoryTxn::ID() const { return txn_id_; }
+
+uint64_t MemoryTxn::ReadTs() const {
+  return isolation_level_ == Txn::kReadCommitted ? storage_->ReadTs() : start_ts_;
+}
+
+Status MemoryTxn::Put(const std::string& key, const std::string& value) {
+  writes_[key] = KeyValue{KeyValue::OpType::kPut, key, value};
+  return Status::OK();
+}
+
+Status MemoryTxn::PutIfAbsent(const std::string& key, const std::string& value) {
+  std::string exist_value;
+  auto status = Get(key, exist_value);
+  if (status.ok()) return Status(pb::error::EEXISTED, "key already exist");
+
+  writes_[key] = KeyValue{KeyValue::OpType::kPut, key, value};
+  if_absent_keys_.insert(key);
+
+  return Status::OK();
+}
+
+Status MemoryTxn::Delete(const std::string& key) {
+  writes_[key] = KeyValue{KeyValue::OpType::kDelete, key, ""};
+  return Status::OK();
+}
+
+Status MemoryTxn::Get(const std::string& key, std::string& value) {
+  uint64_t start_time = utils::TimestampUs();
+  ON_SCOPE_EXIT([&]() { txn_trace_.read_time_us += (utils::TimestampUs() - start_time); });
+
+  // check staged writes first
+  auto it = writes_.find(key);
+  if (it != writes_.end()) {
+    if (it->second.opt_type == KeyValue::OpType::kDelete) {
+      return Status(pb::error::ENOT_FOUND, "key not found");
+    }
+
+    value = it->second.value;
+    return Status::OK();
+  }
+
+  if (!storage_->SnapshotGet(key, ReadTs(), value)) {
+    return Status(pb::error::ENOT_FOUND, "key not found");
+  }
+
+  return Status::OK();
+}
+
+Status MemoryTxn::BatchGet(const std::vector<std::string>& keys, std::vector<KeyValue>& kvs) {
+  for (const auto& key : keys) {
+    std::string value;
+    auto status = Get(key, value);
+    if (status.ok()) {
+      kvs.push_back(KeyValue{KeyValue::OpType::kPut, key, std::move(value)});
+    }
+  }
+
+  return Status::OK();
+}
+
+void MemoryTxn::DoScan(const Range& range, const std::function<bool(KeyValue&)>& handler) {
+  uint64_t start_time = utils::TimestampUs();
+  ON_SCOPE_EXIT([&]() { txn_trace_.read_time_us += (utils::TimestampUs() - start_time); });
+
+  // copy staged writes of range, handler may write txn during scan
+  auto begin = writes_.lower_bound(range.start);
+  auto end = range.end.empty() ? writes_.end() : writes_.lower_bound(range.end);
+  std::vector<KeyValue> staged_kvs;
+  for (auto it = begin; it != end; ++it) staged_kvs.push_back(it->second);
+
+  // merge staged writes, staged one win on same key and staged delete hide the key
+  auto staged_it = staged_kvs.begin();
+  bool is_stop = false;
+  storage_->SnapshotScan(range, ReadTs(), [&](KeyValue& kv) -> bool {
+    bool is_overwritten = false;
+    for (; staged_it != staged_kvs.end() && staged_it->key <= kv.key; ++staged_it) {
+      if (staged_it->key == kv.key) is_overwritten = true;
+      if (staged_it->opt_type == KeyValue::OpType::kPut && !handler(*staged_it)) {
+        ++staged_it;
+        is_stop = true;
+        return false;
+      }
+    }
+
+    if (is_overwritten) return true;
+
+    is_stop = !handler(kv);
+    return !is_stop;
+  });
+
+  for (; !is_stop && staged_it != staged_kvs.end(); ++staged_it) {
+    if (staged_it->opt_type == KeyValue::OpType::kPut && !handler(*staged_it)) break;
+  }
+}
+
+Status MemoryTxn::Scan(const Range& range, uint64_t limit, std::vector<KeyValue>& kvs) {
+  if (limit == 0) return Status::OK();
+
+  DoScan(range, [&](KeyValue& kv) -> bool {
+    kvs.push_back(kv);
+    return kvs.size() < limit;
+  });
+
+  return Status::OK();
+}
+
+Status MemoryTxn::Scan(const Range& range, ScanHandlerType handler) {
+  DoScan(range, [&](KeyValue& kv) -> bool { return handler(kv.key, kv.value); });
+
+  return Status::OK();
+}
+
+Status MemoryTxn::Scan(const Range& range, std::function<bool(KeyValue&)> handler) {
+  DoScan(range, handler);
+
+  return Status::OK();
+}
+
+Status MemoryTxn::Commit() {
+  uint64_t start_time = utils::TimestampUs();
+  ON_SCOPE_EXIT([&]() { txn_trace_.write_time_us += (utils::TimestampUs() - start_time); });
+
+  CHECK(!is_committed_) << "txn already committed.";
+  is_committed_ = true;
+
+  auto status = storage_->CommitTxn(start_ts_, writes_, if_absent_keys_);
+  if (status.error_code() == pb::error::ESTORE_MAYBE_RETRY) txn_trace_.is_conflict = true;
+
+  return status;
+}
+
+Trace::Txn MemoryTxn::GetTrace() {
+  txn_trace_.txn_id = ID();
+  return txn_trace_;
+}
+
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,211 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGOFS_MDS_MEMORY_STORAGE_H_
+#define DINGOFS_MDS_MEMORY_STORAGE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/container/btree_map.h"
+#include "bthread/types.h"
+#include "mds/storage/storage.h"
+#include "utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace mds {
+
+// embedded mvcc kv engine for single node mds and benchmark.
+// every key keep a version chain, txn read the snapshot of its start ts and
+// stage writes locally, commit check write-write conflict like remote store
+// and return ESTORE_MAYBE_RETRY. keys are hash sharded into ordered b-trees,
+// commits are optionally persisted by write ahead log and snapshot.
+class MemoryStorage : public KVStorage {
+ public:
+  MemoryStorage();
+  ~MemoryStorage() override;
+
+  static KVStorageSPtr New() { return std::make_shared<MemoryStorage>(); }
+
+  // addr is the wal dir, empty means no persistence
+  bool Init(const std::string& addr) override;
+  bool Destroy() override;
+
+  Status CreateTable(const std::string& name, const TableOption& option, int64_t& table_id) override;
+  Status DropTable(int64_t table_id) override;
+  Status DropTable(const Range& range) override;
+  Status IsExistTable(const std::string& start_key, const std::string& end_key) override;
+
+  Status Put(WriteOption option, const std::string& key, const std::string& value) override;
+  Status Put(WriteOption option, KeyValue& kv) override;
+  Status Put(WriteOption option, const std::vector<KeyValue>& kvs) override;
+  Status Get(const std::string& key, std::string& value) override;
+  Status BatchGet(const std::vector<std::string>& keys, std::vector<KeyValue>& kvs) override;
+  Status Scan(const Range& range, std::vector<KeyValue>& kvs) override;
+  Status Delete(const std::string& key) override;
+  Status Delete(const std::vector<std::string>& keys) override;
+
+  TxnUPtr NewTxn(Txn::IsolationLevel isolation_level = Txn::kSnapshotIsolation) override;
+
+  // used by MemoryTxn
+  using WriteSet = absl::btree_map<std::string, KeyValue>;
+
+  uint64_t ReadTs() const { return read_ts_.load(std::memory_order_acquire); }
+  uint64_t BeginTxn();
+  void EndTxn(uint64_t start_ts);
+
+  bool SnapshotGet(const std::string& key, uint64_t ts, std::string& value);
+  // merge ordered shards on the fly, stop when handler return false.
+  // no lock is held when call handler, caller must register ts as active.
+  void SnapshotScan(const Range& range, uint64_t ts, const std::function<bool(KeyValue&)>& handler);
+  void SnapshotScan(const Range& range, uint64_t ts, uint64_t limit, std::vector<KeyValue>& kvs);
+
+  // start_ts is UINT64_MAX for blind write, if_absent_keys must not exist at commit
+  Status CommitTxn(uint64_t start_ts, const WriteSet& writes, const std::set<std::string>& if_absent_keys);
+
+ private:
+  struct Version {
+    uint64_t ts{0};
+    bool is_deleted{false};
+    std::string value;
+  };
+  // newest version at back
+  using VersionChain = std::vector<Version>;
+
+  struct Shard {
+    utils::RWLock lock;
+    absl::btree_map<std::string, VersionChain> data;
+  };
+
+  struct Table {
+    std::string name;
+    std::string start_key;
+    std::string end_key;
+  };
+
+  Shard& GetShard(const std::string& key);
+
+  static const Version* FindVersion(const VersionChain& chain, uint64_t ts);
+  // drop versions which are invisible to all active txns
+  static void PruneVersion(VersionChain& chain, uint64_t min_active_ts);
+  uint64_t MinActiveTs();
+
+  // must hold commit mutex
+  void ApplyWrites(uint64_t commit_ts, const WriteSet& writes);
+  // prune old versions and tombstones which are pending for active txns
+  void CollectGarbage(uint64_t min_active_ts, uint32_t budget);
+
+  // persistence, must hold commit mutex
+  bool Recover();
+  Status AppendWal(uint64_t commit_ts, const WriteSet& writes);
+  // rotate wal and start background checkpoint at current ts
+  void MaybeCheckpoint();
+  Status RotateWal();
+
+  // run in background without commit mutex
+  static void* RunCheckpoint(void* arg);
+  Status Checkpoint(uint64_t ts);
+
+  std::string WalPath() const { return path_ + "/memory_storage.wal"; }
+  // wal rotated by running checkpoint, removed when snapshot is saved
+  std::string OldWalPath() const { return path_ + "/memory_storage.wal.old"; }
+  std::string SnapshotPath() const { return path_ + "/memory_storage.snapshot"; }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  // serialize commit, protect commit_ts_ and wal
+  bthread_mutex_t commit_mutex_;
+  uint64_t commit_ts_{0};
+  // max ts whose writes are all applied, snapshot of new txn
+  std::atomic<uint64_t> read_ts_{0};
+
+  // start ts of active txns
+  bthread_mutex_t active_mutex_;
+  std::multiset<uint64_t> active_ts_;
+
+  // keys still have old versions, protected by commit mutex
+  struct GcKey {
+    uint64_t ts;
+    std::string key;
+  };
+  std::deque<GcKey> gc_keys_;
+
+  utils::RWLock table_lock_;
+  int64_t next_table_id_{0};
+  std::map<int64_t, Table> tables_;
+
+  std::string path_;
+  int wal_fd_{-1};
+  uint64_t wal_size_{0};
+  // sticky wal error, fail every later commit once wal state is unknown
+  Status wal_status_;
+
+  // protected by commit mutex
+  bool is_checkpointing_{false};
+  bool has_old_wal_{false};
+  uint64_t checkpoint_ts_{0};
+  bthread_t checkpoint_tid_{0};
+};
+
+class MemoryTxn : public Txn {
+ public:
+  MemoryTxn(MemoryStorage* storage, Txn::IsolationLevel isolation_level);
+  ~MemoryTxn() override;
+
+  int64_t ID() const override;
+  Status Put(const std::string& key, const std::string& value) override;
+
+  Status PutIfAbsent(const std::string& key, const std::string& value) override;
+  Status Delete(const std::string& key) override;
+
+  Status Get(const std::string& key, std::string& value) override;
+  Status BatchGet(const std::vector<std::string>& keys, std::vector<KeyValue>& kvs) override;
+  Status Scan(const Range& range, uint64_t limit, std::vector<KeyValue>& kvs) override;
+  Status Scan(const Range& range, ScanHandlerType handler) override;
+  Status Scan(const Range& range, std::function<bool(KeyValue&)> handler) override;
+
+  Status Commit() override;
+
+  Trace::Txn GetTrace() override;
+
+ private:
+  // read committed always read latest snapshot
+  uint64_t ReadTs() const;
+  // merge staged writes into snapshot scan on the fly
+  void DoScan(const Range& range, const std::function<bool(KeyValue&)>& handler);
+
+  MemoryStorage* storage_{nullptr};
+  Txn::IsolationLevel isolation_level_;
+
+  uint64_t start_ts_{0};
+  int64_t txn_id_{0};
+
+  MemoryStorage::WriteSet writes_;
+  std::set<std::string> if_absent_keys_;
+
+  Trace::Txn txn_trace_;
+  bool is_committed_{false};
+};
+
+}  // namespace mds
+}  // namespace dingofs
+
+#endif  // DINGOFS_MDS_MEMORY_STORAGE_H_
@@ -0,0 +1,267 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "client/vfs/components/shared_read_cache.h"
+#include "client/vfs/hub/vfs_hub.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+static const int64_t kBlockSize = 4096;
+static const int64_t kChunkSize = 4 * kBlockSize;
+
+// block store count fetch, complete fetch inline or hold it until Finish
+class FakeBlockStore : public BlockStore {
+ public:
+  Status Start() override { return Status::OK(); }
+  void Shutdown() override {}
+
+  void RangeAsync(ContextSPtr, RangeReq req, StatusCallback cb) override {
+    ++fetch_count;
+    std::string data(req.length, static_cast<char>('a' + req.block.id % 26));
+    req.data->IOBuf().append(data);
+
+    if (hold) {
+      pending.push_back(std::move(cb));
+    } else {
+      cb(fetch_status);
+    }
+  }
+
+  void PutAsync(ContextSPtr, PutReq, StatusCallback cb) override {
+    cb(Status::OK());
+  }
+
+  void PrefetchAsync(ContextSPtr, PrefetchReq, StatusCallback cb) override {
+    cb(Status::OK());
+  }
+
+  bool EnableCache() const override { return false; }
+  cache::BlockCache* GetBlockCache() const override { return nullptr; }
+
+  void Finish() {
+    auto cbs = std::move(pending);
+    for (auto& cb : cbs) cb(fetch_status);
+  }
+
+  int fetch_count{0};
+  bool hold{false};
+  Status fetch_status;
+  std::vector<StatusCallback> pending;
+};
+
+// only block store and read buffer manager are used by shared read cache
+class FakeVFSHub : public VFSHub {
+ public:
+  explicit FakeVFSHub(int64_t read_buffer_bytes)
+      : read_buffer_manager_(read_buffer_bytes) {}
+
+  Status Start(bool) override { return Status::OK(); }
+  Status Stop(bool) override { return Status::OK(); }
+  ClientId GetClientId() override { return ClientId(); }
+  MetaWrapper* GetMetaSystem() override { return nullptr; }
+  HandleManager* GetHandleManager() override { return nullptr; }
+  BlockStore* GetBlockStore() override { return &block_store_; }
+  blockaccess::BlockAccesser* GetBlockAccesser() override { return nullptr; }
+  Executor* GetReadExecutor() override { return nullptr; }
+  Executor* GetBGExecutor() override { return nullptr; }
+  Executor* GetFlushExecutor() override { return nullptr; }
+  Executor* GetCBExecutor() override { return nullptr; }
+  WriteBufferManager* GetWriteBufferManager() override { return nullptr; }
+  ReadBufferManager* GetReadBufferManager() override {
+    return &read_buffer_manager_;
+  }
+  FileSuffixWatcher* GetFileSuffixWatcher() override { return nullptr; }
+  PrefetchManager* GetPrefetchManager() override { return nullptr; }
+  WarmupManager* GetWarmupManager() override { return nullptr; }
+  SharedReadCache* GetSharedReadCache() override { return nullptr; }
+  PackWriter* GetPackWriter() override { return nullptr; }
+  Compactor* GetCompactor() override { return nullptr; }
+  TraceManager* GetTraceManager() override { return nullptr; }
+  FsInfo GetFsInfo() override { return FsInfo(); }
+  blockaccess::BlockAccessOptions GetBlockAccesserOptions() override {
+    return blockaccess::BlockAccessOptions();
+  }
+
+  FakeBlockStore& block_store() { return block_store_; }
+
+ private:
+  FakeBlockStore block_store_;
+  ReadBufferManager read_buffer_manager_;
+};
+
+class SharedReadCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    hub_ = std::make_unique<FakeVFSHub>(64 * kBlockSize);
+    cache_ = SharedReadCache::New(hub_.get(), 4 * kBlockSize, kChunkSize);
+  }
+
+  void TearDown() override { cache_.reset(); }
+
+  // read [offset, offset + length) of block id of chunk 0 of ino 1
+  Status Read(uint64_t id, int64_t offset, int64_t length, IOBuffer* data,
+              uint64_t chunk_version = 1, int64_t chunk_index = 0) {
+    Status status = Status::Internal("not called");
+    cache_->RangeAsync(nullptr, 1, chunk_index, chunk_version,
+                       NewRangeReq(id, offset, length, data),
+                       [&status](Status s) { status = s; });
+    return status;
+  }
+
+  static RangeReq NewRangeReq(uint64_t id, int64_t offset, int64_t length,
+                              IOBuffer* data) {
+    RangeReq req;
+    req.block = BlockKey(1, 1, id, 0, 0);
+    req.block_size = kBlockSize;
+    req.offset = offset;
+    req.length = length;
+    req.data = data;
+    return req;
+  }
+
+  FakeBlockStore& block_store() { return hub_->block_store(); }
+
+  std::unique_ptr<FakeVFSHub> hub_;
+  SharedReadCacheUPtr cache_;
+};
+
+TEST_F(SharedReadCacheTest, Hit) {
+  IOBuffer data1;
+  ASSERT_TRUE(Read(1, 0, 100, &data1).ok());
+  EXPECT_EQ(1, block_store().fetch_count);
+  EXPECT_EQ(100, data1.Size());
+
+  // other range of the same block is served from memory
+  IOBuffer data2;
+  ASSERT_TRUE(Read(1, 1000, 200, &data2).ok());
+  EXPECT_EQ(1, block_store().fetch_count);
+  EXPECT_EQ(200, data2.Size());
+  EXPECT_EQ(kBlockSize, cache_->Bytes());
+  EXPECT_EQ(kBlockSize, hub_->GetReadBufferManager()->GetUsedBytes());
+}
+
+TEST_F(SharedReadCacheTest, JoinInflightFetch) {
+  block_store().hold = true;
+
+  IOBuffer data1, data2;
+  Status status1 = Status::Internal("not called");
+  Status status2 = Status::Internal("not called");
+  cache_->RangeAsync(nullptr, 1, 0, 1, NewRangeReq(1, 0, 100, &data1),
+                     [&status1](Status s) { status1 = s; });
+  cache_->RangeAsync(nullptr, 1, 0, 1, NewRangeReq(1, 100, 100, &data2),
+                     [&status2](Status s) { status2 = s; });
+  EXPECT_EQ(1, block_store().fetch_count);
+  EXPECT_FALSE(status1.ok());
+  EXPECT_FALSE(status2.ok());
+
+  block_store().Finish();
+  EXPECT_TRUE(status1.ok());
+  EXPECT_TRUE(status2.ok());
+  EXPECT_EQ(100, data1.Size());
+  EXPECT_EQ(100, data2.Size());
+}
+
+TEST_F(SharedReadCacheTest, FetchFailNotCached) {
+  block_store().fetch_status = Status::Internal("fetch fail");
+
+  IOBuffer data1;
+  EXPECT_FALSE(Read(1, 0, 100, &data1).ok());
+  EXPECT_EQ(0, cache_->Bytes());
+
+  // next reader retry
+  block_store().fetch_status = Status::OK();
+  IOBuffer data2;
+  EXPECT_TRUE(Read(1, 0, 100, &data2).ok());
+  EXPECT_EQ(2, block_store().fetch_count);
+}
+
+TEST_F(SharedReadCacheTest, EvictLru) {
+  // capacity is 4 blocks
+  for (uint64_t id = 1; id <= 4; ++id) {
+    IOBuffer data;
+    ASSERT_TRUE(Read(id, 0, 10, &data).ok());
+  }
+  EXPECT_EQ(4 * kBlockSize, cache_->Bytes());
+
+  // touch block 1, block 2 become the least recently used
+  IOBuffer data;
+  ASSERT_TRUE(Read(1, 0, 10, &data).ok());
+  ASSERT_TRUE(Read(5, 0, 10, &data).ok());
+  EXPECT_EQ(5, block_store().fetch_count);
+  EXPECT_EQ(4 * kBlockSize, cache_->Bytes());
+  EXPECT_EQ(4 * kBlockSize, hub_->GetReadBufferManager()->GetUsedBytes());
+
+  ASSERT_TRUE(Read(1, 0, 10, &data).ok());
+  EXPECT_EQ(5, block_store().fetch_count);
+  ASSERT_TRUE(Read(2, 0, 10, &data).ok());
+  EXPECT_EQ(6, block_store().fetch_count);
+}
+
+TEST_F(SharedReadCacheTest, InvalidateOnWrite) {
+  IOBuffer data;
+  ASSERT_TRUE(Read(1, 0, 10, &data, 1, 0).ok());
+  ASSERT_TRUE(Read(2, 0, 10, &data, 1, 1).ok());
+  EXPECT_EQ(2 * kBlockSize, cache_->Bytes());
+
+  // write in chunk 1 drop only entries of chunk 1
+  cache_->Invalidate(1, kChunkSize + 100, 10);
+  EXPECT_EQ(kBlockSize, cache_->Bytes());
+  EXPECT_EQ(kBlockSize, hub_->GetReadBufferManager()->GetUsedBytes());
+
+  ASSERT_TRUE(Read(1, 0, 10, &data, 1, 0).ok());
+  EXPECT_EQ(2, block_store().fetch_count);
+  ASSERT_TRUE(Read(2, 0, 10, &data, 1, 1).ok());
+  EXPECT_EQ(3, block_store().fetch_count);
+
+  // invalidate an inflight fetch, its readers still get the data
+  block_store().hold = true;
+  Status status = Status::Internal("not called");
+  cache_->RangeAsync(nullptr, 1, 0, 1, NewRangeReq(3, 0, 10, &data),
+                     [&status](Status s) { status = s; });
+  cache_->Invalidate(1, 0, kChunkSize);
+  block_store().Finish();
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(kBlockSize, cache_->Bytes());
+}
+
+TEST_F(SharedReadCacheTest, NewerChunkVersion) {
+  IOBuffer data;
+  ASSERT_TRUE(Read(1, 0, 10, &data, 1).ok());
+  ASSERT_TRUE(Read(2, 0, 10, &data, 2).ok());
+
+  // same version keep entries
+  cache_->UpdateChunkVersion(1, 0, 2);
+  EXPECT_EQ(2 * kBlockSize, cache_->Bytes());
+
+  // entries fetched under older version are dropped
+  cache_->UpdateChunkVersion(1, 0, 3);
+  EXPECT_EQ(0, cache_->Bytes());
+
+  ASSERT_TRUE(Read(1, 0, 10, &data, 3).ok());
+  EXPECT_EQ(3, block_store().fetch_count);
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -370,6 +370,45 @@ TEST(ConvertSliceReadReqToBlockReadReqsTest, NonAlignedBlockBoundaries) {
   }
 }
 
+TEST(ConvertSliceReadReqToBlockReadReqsTest, PackedSlice) {
+  bool is_zero = false;
+  uint64_t compaction = 0;
+  Slice slice = CreateSlice(0, 100, 1, is_zero, compaction);
+  slice.size = 1000;
+  slice.pack_offset = 200;
+  slice.pack_refs = 5;
+
+  SliceReadReq slice_req = CreateSliceReadReq(10, 50, slice);
+
+  uint64_t fs_id = 1;
+  uint64_t ino = 2;
+  uint64_t chunk_size = 128;
+  uint64_t block_size = 32;
+
+  auto block_read_reqs = ConvertSliceReadReqToBlockReadReqs(
+      slice_req, fs_id, ino, chunk_size, block_size);
+
+  // packed slice is always read from one pack object
+  ASSERT_EQ(block_read_reqs.size(), 1);
+
+  BlockDesc expected_block{
+      .file_offset = 0,
+      .block_len = 100,
+      .zero = is_zero,
+      .version = compaction,
+      .slice_id = slice_req.slice->id,
+      .index = 0,
+  };
+
+  EXPECT_EQ(block_read_reqs[0].block_offset, 210);
+  EXPECT_EQ(block_read_reqs[0].len, 50);
+  CHECK_BLOCK_BOJ_EQUAL(block_read_reqs[0].block, expected_block);
+  EXPECT_TRUE(block_read_reqs[0].block.packed);
+  EXPECT_EQ(block_read_reqs[0].block.pack_len, 1000);
+  EXPECT_EQ(block_read_reqs[0].block.KeyIno(ino), kPackBlockIno);
+  EXPECT_EQ(block_read_reqs[0].block.ObjectLen(), 1000);
+}
+
 TEST(ConvertSliceReadReqToBlockReadReqsTest, InvalidSlice) {
   SliceReadReq slice_req{
       .file_offset = 32,
@@ -0,0 +1,139 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "client/vfs/data/reader/read_request.h"
+#include "client/vfs/data/reader/read_request_index.h"
+#include "client/vfs/data/test_data_utils_common.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+
+static const int64_t kBlockSize = 4 * 1024 * 1024;
+static const int64_t kChunkSize = 64 * 1024 * 1024;
+
+static ReadRequestSptr NewRequest(int64_t offset, int64_t len) {
+  auto req = std::make_shared<ReadRequest>(
+      1, offset / kChunkSize, offset % kChunkSize, CreateFileRange(offset, len));
+  req->state = ReadRequestState::kReady;
+  return req;
+}
+
+static std::vector<ReadRequestSptr> CollectOverlap(
+    const ReadRequestIndex& index, const FileRange& frange) {
+  std::vector<ReadRequestSptr> reqs;
+  index.ForEachOverlap(frange, [&](const ReadRequestSptr& req) {
+    reqs.push_back(req);
+    return true;
+  });
+  return reqs;
+}
+
+TEST(ReadRequestIndexTest, InsertErase) {
+  ReadRequestIndex index;
+  auto req1 = NewRequest(0, kBlockSize);
+  auto req2 = NewRequest(kBlockSize, kBlockSize);
+
+  index.Insert(req1);
+  index.Insert(req2);
+  ASSERT_EQ(index.Size(), 2);
+
+  EXPECT_TRUE(index.Erase(req1));
+  EXPECT_FALSE(index.Erase(req1));
+  ASSERT_EQ(index.Size(), 1);
+
+  EXPECT_TRUE(index.Erase(req2));
+  EXPECT_TRUE(index.Empty());
+}
+
+TEST(ReadRequestIndexTest, ForEachOrderByOffset) {
+  ReadRequestIndex index;
+  index.Insert(NewRequest(2 * kBlockSize, kBlockSize));
+  index.Insert(NewRequest(0, kBlockSize));
+  index.Insert(NewRequest(kBlockSize, kBlockSize));
+
+  std::vector<int64_t> offsets;
+  index.ForEach([&](const ReadRequestSptr& req) {
+    offsets.push_back(req->req.frange.offset);
+    return true;
+  });
+
+  ASSERT_EQ(offsets.size(), 3);
+  EXPECT_EQ(offsets[0], 0);
+  EXPECT_EQ(offsets[1], kBlockSize);
+  EXPECT_EQ(offsets[2], 2 * kBlockSize);
+}
+
+TEST(ReadRequestIndexTest, ForEachOverlap) {
+  ReadRequestIndex index;
+  index.Insert(NewRequest(0, 100));
+  index.Insert(NewRequest(100, 100));
+  index.Insert(NewRequest(200, 100));
+  index.Insert(NewRequest(1000, 50));
+
+  // inside one request
+  auto reqs = CollectOverlap(index, CreateFileRange(120, 10));
+  ASSERT_EQ(reqs.size(), 1);
+  EXPECT_EQ(reqs[0]->req.frange.offset, 100);
+
+  // cross two requests
+  reqs = CollectOverlap(index, CreateFileRange(150, 100));
+  ASSERT_EQ(reqs.size(), 2);
+  EXPECT_EQ(reqs[0]->req.frange.offset, 100);
+  EXPECT_EQ(reqs[1]->req.frange.offset, 200);
+
+  // boundary is exclusive
+  reqs = CollectOverlap(index, CreateFileRange(300, 700));
+  EXPECT_TRUE(reqs.empty());
+
+  // hole
+  reqs = CollectOverlap(index, CreateFileRange(500, 100));
+  EXPECT_TRUE(reqs.empty());
+}
+
+TEST(ReadRequestIndexTest, ForEachOverlapDuplicateRange) {
+  ReadRequestIndex index;
+  auto old_req = NewRequest(0, 100);
+  old_req->state = ReadRequestState::kInvalid;
+  index.Insert(old_req);
+  index.Insert(NewRequest(0, 100));
+
+  auto reqs = CollectOverlap(index, CreateFileRange(50, 10));
+  ASSERT_EQ(reqs.size(), 2);
+  EXPECT_TRUE(reqs[0]->IsInvalid());
+  EXPECT_FALSE(reqs[1]->IsInvalid());
+}
+
+TEST(ReadRequestIndexTest, ForEachOverlapStop) {
+  ReadRequestIndex index;
+  for (int64_t i = 0; i < 10; ++i) {
+    index.Insert(NewRequest(i * 100, 100));
+  }
+
+  int count = 0;
+  index.ForEachOverlap(CreateFileRange(0, 1000),
+                       [&](const ReadRequestSptr&) { return ++count < 3; });
+  EXPECT_EQ(count, 3);
+}
+
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,279 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "client/vfs/metasystem/local/compact_meta_store.h"
+#include "client/vfs/metasystem/local/meta_store.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace local {
+
+static const uint32_t kFsId = 1;
+static const Ino kRootIno = 1;
+static const Ino kDirIno = 3;
+
+class CompactMetaStoreTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    test_dir_ = "/tmp/dingofs_test_compact_meta_store_" +
+                std::to_string(getpid());
+    std::filesystem::remove_all(test_dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(test_dir_); }
+
+  std::string NewDir(const std::string& name) {
+    std::string path = test_dir_ + "/" + name;
+    std::filesystem::create_directories(path);
+    return path;
+  }
+
+  // copy files of an opened store, same as what left on disk after crash
+  std::string CopyDir(const std::string& from, const std::string& name) {
+    std::string path = test_dir_ + "/" + name;
+    std::filesystem::copy(from, path,
+                          std::filesystem::copy_options::recursive);
+    return path;
+  }
+
+  static mds::AttrEntry GenAttr(Ino ino, Ino parent, pb::mds::FileType type,
+                                uint64_t version) {
+    mds::AttrEntry attr;
+    attr.set_fs_id(kFsId);
+    attr.set_ino(ino);
+    attr.set_type(type);
+    attr.set_mode(type == pb::mds::FileType::DIRECTORY ? 040755 : 0100644);
+    attr.set_nlink(type == pb::mds::FileType::DIRECTORY ? 2 : 1);
+    attr.set_length(ino * 10);
+    attr.set_ctime(version);
+    attr.set_mtime(version);
+    attr.set_atime(version);
+    attr.set_version(version);
+    attr.add_parents(parent);
+
+    return attr;
+  }
+
+  static mds::DentryEntry GenDentry(Ino parent, const std::string& name,
+                                    Ino ino, pb::mds::FileType type) {
+    mds::DentryEntry dentry;
+    dentry.set_fs_id(kFsId);
+    dentry.set_parent(parent);
+    dentry.set_name(name);
+    dentry.set_ino(ino);
+    dentry.set_type(type);
+
+    return dentry;
+  }
+
+  static void MkDir(MetaStore& store, Ino parent, const std::string& name,
+                    Ino ino) {
+    MetaBatch batch;
+    batch.PutInode(GenAttr(ino, parent, pb::mds::FileType::DIRECTORY, 1));
+    batch.PutDentry(GenDentry(parent, name, ino, pb::mds::FileType::DIRECTORY));
+    ASSERT_TRUE(store.WriteAndSync(batch).ok());
+  }
+
+  static void Create(MetaStore& store, Ino parent, const std::string& name,
+                     Ino ino) {
+    MetaBatch batch;
+    batch.PutInode(GenAttr(ino, parent, pb::mds::FileType::FILE, 1));
+    batch.PutDentry(GenDentry(parent, name, ino, pb::mds::FileType::FILE));
+    batch.Put("chunk/" + std::to_string(ino), "chunk" + std::to_string(ino));
+    ASSERT_TRUE(store.WriteAndSync(batch).ok());
+  }
+
+  static void Rename(MetaStore& store, Ino old_parent,
+                     const std::string& old_name, Ino new_parent,
+                     const std::string& new_name, Ino ino) {
+    MetaBatch batch;
+    batch.DeleteDentry(old_parent, old_name);
+    batch.PutDentry(
+        GenDentry(new_parent, new_name, ino, pb::mds::FileType::FILE));
+    batch.PutInode(GenAttr(ino, new_parent, pb::mds::FileType::FILE, 2));
+    ASSERT_TRUE(store.WriteAndSync(batch).ok());
+  }
+
+  static void Unlink(MetaStore& store, Ino parent, const std::string& name,
+                     Ino ino) {
+    MetaBatch batch;
+    batch.DeleteDentry(parent, name);
+    batch.DeleteInode(ino);
+    batch.Delete("chunk/" + std::to_string(ino));
+    ASSERT_TRUE(store.WriteAndSync(batch).ok());
+  }
+
+  static void RunOps(MetaStore& store, uint32_t file_num) {
+    MetaBatch batch;
+    batch.PutInode(GenAttr(kRootIno, 0, pb::mds::FileType::DIRECTORY, 1));
+    ASSERT_TRUE(store.WriteAndSync(batch).ok());
+
+    MkDir(store, kRootIno, "dir", kDirIno);
+    for (uint32_t i = 0; i < file_num; ++i) {
+      Create(store, kDirIno, "file_" + std::to_string(i), FileIno(i));
+    }
+    // move half file to root, unlink a quarter
+    for (uint32_t i = 0; i < file_num; i += 2) {
+      Rename(store, kDirIno, "file_" + std::to_string(i), kRootIno,
+             "moved_" + std::to_string(i), FileIno(i));
+    }
+    for (uint32_t i = 1; i < file_num; i += 4) {
+      Unlink(store, kDirIno, "file_" + std::to_string(i), FileIno(i));
+    }
+  }
+
+  static Ino FileIno(uint32_t i) { return 100 + (2 * i); }
+
+  // readable state of store, used for compare
+  static std::string DumpState(MetaStore& store, uint32_t file_num) {
+    std::string state;
+
+    std::vector<Ino> inos = {kDirIno};
+    for (uint32_t i = 0; i < file_num; ++i) inos.push_back(FileIno(i));
+    for (auto ino : inos) {
+      mds::AttrEntry attr;
+      if (!store.GetInode(ino, attr).ok()) {
+        state += "inode " + std::to_string(ino) + " none\n";
+        continue;
+      }
+      state += "inode " + std::to_string(ino) + " " +
+               std::to_string(attr.version()) + " " +
+               std::to_string(attr.length()) + " " +
+               std::to_string(attr.mode()) + " " +
+               std::to_string(attr.parents(0)) + "\n";
+    }
+
+    for (auto parent : {kRootIno, kDirIno}) {
+      std::vector<mds::DentryEntry> dentries;
+      EXPECT_TRUE(store.GetDentries(parent, dentries).ok());
+      std::map<std::string, Ino> sorted;
+      for (const auto& dentry : dentries) sorted[dentry.name()] = dentry.ino();
+      for (const auto& [name, ino] : sorted) {
+        state += "dentry " + std::to_string(parent) + "/" + name + " " +
+                 std::to_string(ino) + "\n";
+      }
+    }
+
+    EXPECT_TRUE(store
+                    .Scan("chunk/",
+                          [&state](const std::string& key,
+                                   const std::string& value) {
+                            if (key.rfind("chunk/", 0) != 0) return false;
+                            state += "kv " + key + " " + value + "\n";
+                            return true;
+                          })
+                    .ok());
+
+    return state;
+  }
+
+  std::string test_dir_;
+};
+
+TEST_F(CompactMetaStoreTest, SameAsLevelDB) {
+  const uint32_t kFileNum = 64;
+
+  LevelMetaStore level_store(kFsId);
+  ASSERT_TRUE(level_store.Open(NewDir("leveldb")));
+  RunOps(level_store, kFileNum);
+
+  const std::string compact_path = NewDir("compact");
+  std::string expect = DumpState(level_store, kFileNum);
+  {
+    CompactMetaStore compact_store(kFsId);
+    ASSERT_TRUE(compact_store.Open(compact_path));
+    RunOps(compact_store, kFileNum);
+    EXPECT_EQ(expect, DumpState(compact_store, kFileNum));
+  }
+
+  // reopen from snapshot
+  CompactMetaStore compact_store(kFsId);
+  ASSERT_TRUE(compact_store.Open(compact_path));
+  EXPECT_EQ(expect, DumpState(compact_store, kFileNum));
+}
+
+TEST_F(CompactMetaStoreTest, ReplayTornTail) {
+  const uint32_t kFileNum = 16;
+
+  CompactMetaStore store(kFsId);
+  ASSERT_TRUE(store.Open(NewDir("origin")));
+  RunOps(store, kFileNum);
+  const std::string expect = DumpState(store, kFileNum);
+
+  // crash in the middle of appending a record
+  const std::string crash_path = CopyDir(test_dir_ + "/origin", "crash");
+  {
+    std::ofstream wal(crash_path + "/meta.wal",
+                      std::ios::binary | std::ios::app);
+    const uint32_t length = 1024;
+    wal.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    wal.write("torn", 4);
+  }
+
+  CompactMetaStore crash_store(kFsId);
+  ASSERT_TRUE(crash_store.Open(crash_path));
+  EXPECT_EQ(expect, DumpState(crash_store, kFileNum));
+
+  // torn tail is dropped, record appended after it is replayable
+  Create(crash_store, kRootIno, "after_crash", FileIno(kFileNum));
+  CompactMetaStore replay_store(kFsId);
+  ASSERT_TRUE(replay_store.Open(CopyDir(crash_path, "replay")));
+  EXPECT_EQ(DumpState(crash_store, kFileNum + 1),
+            DumpState(replay_store, kFileNum + 1));
+
+  mds::DentryEntry dentry;
+  EXPECT_TRUE(replay_store.GetDentry(kRootIno, "after_crash", dentry).ok());
+}
+
+TEST_F(CompactMetaStoreTest, CheckpointAndReopen) {
+  const uint32_t kFileNum = 16;
+  const std::string path = NewDir("origin");
+
+  CompactMetaStore store(kFsId);
+  ASSERT_TRUE(store.Open(path));
+  RunOps(store, kFileNum);
+
+  ASSERT_TRUE(store.Checkpoint().ok());
+  EXPECT_EQ(0, std::filesystem::file_size(path + "/meta.wal"));
+  EXPECT_LT(0, std::filesystem::file_size(path + "/meta.snapshot"));
+
+  // state after checkpoint is in log only
+  Create(store, kRootIno, "after_checkpoint", FileIno(kFileNum));
+  const std::string expect = DumpState(store, kFileNum + 1);
+
+  CompactMetaStore crash_store(kFsId);
+  ASSERT_TRUE(crash_store.Open(CopyDir(path, "crash")));
+  EXPECT_EQ(expect, DumpState(crash_store, kFileNum + 1));
+
+  store.Close();
+  CompactMetaStore reopen_store(kFsId);
+  ASSERT_TRUE(reopen_store.Open(path));
+  EXPECT_EQ(expect, DumpState(reopen_store, kFileNum + 1));
+}
+
+}  // namespace local
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
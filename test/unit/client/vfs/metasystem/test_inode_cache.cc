@@ -0,0 +1,161 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/vfs/metasystem/mds/inode_cache.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+static const uint32_t kFsId = 1;
+static const Ino kIno = 100;
+
+// all hot attrs derive from version, so a torn read is detectable
+static mds::AttrEntry GenAttr(uint64_t version) {
+  mds::AttrEntry attr;
+  attr.set_fs_id(kFsId);
+  attr.set_ino(kIno);
+  attr.set_type(pb::mds::FileType::FILE);
+  attr.set_version(version);
+  attr.set_length(version * 4096);
+  attr.set_ctime(version + 1);
+  attr.set_mtime(version + 2);
+  attr.set_atime(version + 3);
+  attr.set_uid(static_cast<uint32_t>(version));
+  attr.set_gid(static_cast<uint32_t>(version));
+  attr.set_mode(static_cast<uint32_t>(version));
+  attr.set_nlink(1);
+  attr.add_parents(1);
+  if (version % 2 == 0) attr.add_parents(version);
+
+  return attr;
+}
+
+static void CheckConsistent(const mds::AttrEntry& attr) {
+  const uint64_t version = attr.version();
+  ASSERT_EQ(version * 4096, attr.length());
+  ASSERT_EQ(version + 1, attr.ctime());
+  ASSERT_EQ(version + 2, attr.mtime());
+  ASSERT_EQ(version + 3, attr.atime());
+  ASSERT_EQ(static_cast<uint32_t>(version), attr.uid());
+  ASSERT_EQ(static_cast<uint32_t>(version), attr.gid());
+  ASSERT_EQ(static_cast<uint32_t>(version), attr.mode());
+  ASSERT_EQ(version % 2 == 0 ? 2 : 1, attr.parents_size());
+}
+
+TEST(InodeTest, PutIf) {
+  auto inode = Inode::New(GenAttr(2));
+  EXPECT_EQ(kIno, inode->Ino());
+  EXPECT_EQ(2, inode->Version());
+  EXPECT_EQ(2, inode->Parents().size());
+
+  // stale version is ignored
+  EXPECT_FALSE(inode->PutIf(GenAttr(1)));
+  EXPECT_EQ(2, inode->Version());
+
+  EXPECT_TRUE(inode->PutIf(GenAttr(3)));
+  EXPECT_EQ(3, inode->Version());
+  EXPECT_EQ(3 * 4096, inode->Length());
+  EXPECT_EQ(1, inode->Parents().size());
+  CheckConsistent(inode->ToAttrEntry());
+}
+
+TEST(InodeTest, XAttr) {
+  auto inode = Inode::New(GenAttr(1));
+  EXPECT_TRUE(inode->ListXAttrs().empty());
+
+  inode->SetXAttr("user.a", "1");
+  inode->SetXAttr("user.b", "2");
+  EXPECT_EQ("1", inode->GetXAttr("user.a"));
+  EXPECT_EQ(2, inode->ListXAttrs().size());
+
+  inode->RemoveXAttr("user.a");
+  EXPECT_EQ("", inode->GetXAttr("user.a"));
+  EXPECT_EQ(1, inode->ToAttrEntry().xattrs_size());
+}
+
+TEST(InodeTest, SeqlockConsistentRead) {
+  auto inode = Inode::New(GenAttr(1));
+
+  const uint64_t kMaxVersion = 20000;
+  std::atomic<bool> stop{false};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      uint64_t last_version = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto attr = inode->ToAttrEntry();
+        CheckConsistent(attr);
+        // version never go back
+        ASSERT_LE(last_version, attr.version());
+        last_version = attr.version();
+
+        auto short_attr = inode->ToAttr();
+        ASSERT_EQ(short_attr.version * 4096, short_attr.length);
+        ASSERT_EQ(short_attr.version + 2, short_attr.mtime);
+      }
+    });
+  }
+
+  for (uint64_t version = 2; version <= kMaxVersion; ++version) {
+    inode->PutIf(GenAttr(version));
+  }
+
+  stop.store(true);
+  for (auto& reader : readers) reader.join();
+
+  EXPECT_EQ(kMaxVersion, inode->Version());
+  CheckConsistent(inode->ToAttrEntry());
+}
+
+TEST(InodeTest, SlotSize) {
+  const size_t slot_size = Inode::SlotSize();
+  // control block and inode share the slot
+  EXPECT_LT(sizeof(Inode), slot_size);
+  EXPECT_EQ(0, slot_size % alignof(std::max_align_t));
+}
+
+TEST(InodeCacheTest, PutGetDelete) {
+  InodeCache cache(kFsId);
+
+  cache.Put(kIno, GenAttr(1));
+  auto inode = cache.Get(kIno);
+  ASSERT_NE(nullptr, inode);
+  EXPECT_EQ(1, inode->Version());
+
+  // put newer version update the cached inode in place
+  cache.Put(kIno, GenAttr(2));
+  EXPECT_EQ(2, inode->Version());
+  EXPECT_EQ(1, cache.Size());
+  EXPECT_LT(0, cache.Bytes());
+
+  cache.Delete(kIno);
+  EXPECT_EQ(nullptr, cache.Get(kIno));
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,139 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "client/vfs/metasystem/mds/slab.h"
+
+namespace dingofs {
+namespace client {
+namespace vfs {
+namespace meta {
+
+static const size_t kChunkBytes = 1024;
+
+TEST(FixedSlabTest, ReuseFreeSlot) {
+  FixedSlab slab(kChunkBytes);
+
+  void* ptr = slab.Allocate(40);
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(1, slab.UsedCount());
+  EXPECT_EQ(kChunkBytes, slab.Bytes());
+
+  slab.Deallocate(ptr, 40);
+  EXPECT_EQ(0, slab.UsedCount());
+
+  EXPECT_EQ(ptr, slab.Allocate(40));
+  EXPECT_EQ(1, slab.UsedCount());
+}
+
+TEST(FixedSlabTest, GrowChunk) {
+  FixedSlab slab(kChunkBytes);
+
+  const size_t slot_size = FixedSlab::SlotSizeOf(40);
+  const size_t slot_num = kChunkBytes / slot_size;
+
+  std::set<void*> ptrs;
+  for (size_t i = 0; i < slot_num + 1; ++i) {
+    void* ptr = slab.Allocate(40);
+    ASSERT_TRUE(ptrs.insert(ptr).second) << "slot allocated twice.";
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t));
+  }
+  EXPECT_EQ(slot_num + 1, slab.UsedCount());
+  EXPECT_EQ(2 * kChunkBytes, slab.Bytes());
+
+  for (void* ptr : ptrs) slab.Deallocate(ptr, 40);
+  EXPECT_EQ(0, slab.UsedCount());
+  // free chunk is returned except the last one
+  EXPECT_EQ(1, slab.ChunkCount());
+  EXPECT_EQ(kChunkBytes, slab.Bytes());
+}
+
+TEST(FixedSlabTest, ReleaseFreeChunk) {
+  FixedSlab slab(kChunkBytes);
+
+  const size_t slot_num = kChunkBytes / FixedSlab::SlotSizeOf(40);
+
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < 3 * slot_num; ++i) ptrs.push_back(slab.Allocate(40));
+  EXPECT_EQ(3, slab.ChunkCount());
+
+  // free the middle chunk, keep one slot of the others
+  for (size_t i = 1; i < 3 * slot_num - 1; ++i) slab.Deallocate(ptrs[i], 40);
+  EXPECT_EQ(2, slab.UsedCount());
+  EXPECT_EQ(2, slab.ChunkCount());
+  EXPECT_EQ(2 * kChunkBytes, slab.Bytes());
+
+  // allocate from partial chunk before new chunk
+  for (size_t i = 0; i < 2 * (slot_num - 1); ++i) slab.Allocate(40);
+  EXPECT_EQ(2, slab.ChunkCount());
+}
+
+TEST(FixedSlabTest, LargeFallback) {
+  FixedSlab slab(kChunkBytes);
+
+  void* small = slab.Allocate(16);
+  void* large = slab.Allocate(512);
+  ASSERT_NE(nullptr, large);
+  EXPECT_EQ(1, slab.UsedCount());
+  EXPECT_EQ(kChunkBytes + 512, slab.Bytes());
+
+  slab.Deallocate(large, 512);
+  slab.Deallocate(small, 16);
+  EXPECT_EQ(0, slab.UsedCount());
+}
+
+TEST(FixedSlabTest, SlotSizeOf) {
+  EXPECT_LE(sizeof(void*), FixedSlab::SlotSizeOf(1));
+  EXPECT_EQ(0, FixedSlab::SlotSizeOf(100) % alignof(std::max_align_t));
+  EXPECT_LE(100, FixedSlab::SlotSizeOf(100));
+}
+
+TEST(FixedSlabTest, AllocateShared) {
+  FixedSlab slab(kChunkBytes);
+
+  struct Object {
+    uint64_t a{0};
+    uint64_t b{0};
+  };
+
+  size_t size = 0;
+  std::allocate_shared<Object>(SizeProbeAllocator<Object>(&size));
+  ASSERT_LT(sizeof(Object), size);
+
+  std::vector<std::shared_ptr<Object>> objects;
+  for (int i = 0; i < 8; ++i) {
+    objects.push_back(
+        std::allocate_shared<Object>(SlabAllocator<Object>(&slab)));
+    objects.back()->a = i;
+  }
+  // control block and object live in one slab slot
+  EXPECT_EQ(8, slab.UsedCount());
+  EXPECT_EQ(kChunkBytes, slab.Bytes());
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(i, objects[i]->a);
+
+  objects.clear();
+  EXPECT_EQ(0, slab.UsedCount());
+}
+
+}  // namespace meta
+}  // namespace vfs
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/background/balance_planner.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace mds {
+namespace unit_test {
+
+class BalancePlannerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    options_.ewma_alpha = 1.0;
+    options_.trigger_ratio = 0.3;
+    options_.target_ratio = 0.1;
+    options_.min_load = 10;
+    options_.max_move_num = 4;
+    options_.bucket_cooldown_ms = 1000;
+    options_.round_cooldown_ms = 100;
+  }
+
+  // 2 mds, mds 1 own bucket 0-3, mds 2 own bucket 4-7
+  static BucketLayout GenLayout() {
+    return BucketLayout{{1, {0, 1, 2, 3}}, {2, {4, 5, 6, 7}}};
+  }
+
+  static std::map<uint32_t, double> GenRates(const std::vector<double>& rates) {
+    std::map<uint32_t, double> bucket_rates;
+    for (uint32_t i = 0; i < rates.size(); ++i) bucket_rates[i] = rates[i];
+    return bucket_rates;
+  }
+
+  BalancePlanner::Options options_;
+};
+
+TEST_F(BalancePlannerTest, MoveHotBucket) {
+  BalancePlanner planner(8);
+  planner.Update(options_, GenRates({100, 100, 10, 10, 10, 10, 10, 10}));
+
+  auto layout = GenLayout();
+  auto moves = planner.Plan(options_, layout, 1000);
+  ASSERT_EQ(1, moves.size());
+  EXPECT_EQ(0, moves[0].bucket_id);
+  EXPECT_EQ(1, moves[0].from_mds_id);
+  EXPECT_EQ(2, moves[0].to_mds_id);
+  EXPECT_TRUE(planner.IsBalancing());
+
+  BalancePlanner::Apply(moves, layout);
+  planner.Commit(moves, 1000);
+  EXPECT_EQ(3, layout[1].size());
+  EXPECT_EQ(5, layout[2].size());
+  EXPECT_LT(BalancePlanner::Imbalance(planner.MdsLoads(layout)), 0.1);
+
+  // balanced, stop balance
+  EXPECT_TRUE(planner.Plan(options_, layout, 2000).empty());
+  EXPECT_FALSE(planner.IsBalancing());
+}
+
+TEST_F(BalancePlannerTest, Hysteresis) {
+  BalancePlanner planner(8);
+  auto layout = GenLayout();
+
+  // imbalance 0.2 not reach trigger ratio
+  planner.Update(options_, GenRates({30, 30, 30, 30, 20, 20, 20, 20}));
+  EXPECT_TRUE(planner.Plan(options_, layout, 1000).empty());
+  EXPECT_FALSE(planner.IsBalancing());
+
+  // idle fs not balance even imbalance is high
+  planner.Update(options_, GenRates({4, 4, 4, 4, 1, 1, 1, 1}));
+  EXPECT_TRUE(planner.Plan(options_, layout, 1000).empty());
+  EXPECT_FALSE(planner.IsBalancing());
+
+  // reach trigger ratio, start balance
+  planner.Update(options_, GenRates({40, 40, 40, 40, 10, 10, 10, 10}));
+  auto moves = planner.Plan(options_, layout, 1000);
+  EXPECT_FALSE(moves.empty());
+  EXPECT_TRUE(planner.IsBalancing());
+}
+
+TEST_F(BalancePlannerTest, Cooldown) {
+  BalancePlanner planner(8);
+  auto layout = GenLayout();
+
+  planner.Update(options_, GenRates({40, 40, 10, 10, 5, 5, 5, 5}));
+  auto moves = planner.Plan(options_, layout, 1000);
+  ASSERT_EQ(1, moves.size());
+  EXPECT_EQ(0, moves[0].bucket_id);
+  BalancePlanner::Apply(moves, layout);
+  planner.Commit(moves, 1000);
+
+  // mds 2 become hot, wait round cooldown
+  planner.Update(options_, GenRates({40, 5, 5, 5, 5, 40, 5, 5}));
+  EXPECT_TRUE(planner.Plan(options_, layout, 1050).empty());
+
+  // bucket 0 is cooling, only bucket 5 can move
+  moves = planner.Plan(options_, layout, 1200);
+  ASSERT_EQ(1, moves.size());
+  EXPECT_EQ(5, moves[0].bucket_id);
+  EXPECT_EQ(2, moves[0].from_mds_id);
+}
+
+TEST_F(BalancePlannerTest, SingleHotBucket) {
+  BalancePlanner planner(8);
+  auto layout = GenLayout();
+
+  // move the only hot bucket just shift the hot spot, no move
+  planner.Update(options_, GenRates({1000, 0, 0, 0, 10, 10, 10, 10}));
+  EXPECT_TRUE(planner.Plan(options_, layout, 1000).empty());
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
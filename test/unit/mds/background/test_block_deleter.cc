@@ -0,0 +1,149 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/background/block_deleter.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/blockaccess/accesser_common.h"
+#include "common/blockaccess/block_accesser.h"
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_uint32(mds_gc_delete_batch_size);
+
+namespace unit_test {
+
+class BlockDeleterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    root_path_ = std::filesystem::temp_directory_path() / ("block_deleter_" + std::to_string(::getpid()));
+
+    blockaccess::BlockAccessOptions options;
+    options.type = blockaccess::AccesserType::kLocalFile;
+    options.file_options.path = root_path_;
+
+    block_accessor_ = blockaccess::NewShareBlockAccesser(options);
+    ASSERT_TRUE(block_accessor_->Init().ok());
+
+    origin_batch_size_ = FLAGS_mds_gc_delete_batch_size;
+  }
+
+  void TearDown() override {
+    FLAGS_mds_gc_delete_batch_size = origin_batch_size_;
+
+    block_accessor_->Destroy();
+    std::filesystem::remove_all(root_path_);
+  }
+
+  std::list<std::string> PutBlocks(const std::string& prefix, uint32_t num) {
+    std::list<std::string> keys;
+    for (uint32_t i = 0; i < num; ++i) {
+      std::string key = fmt::format("{}/block_{}", prefix, i);
+      EXPECT_TRUE(block_accessor_->Put(key, "data").ok());
+      keys.push_back(key);
+    }
+
+    return keys;
+  }
+
+  std::string root_path_;
+  uint32_t origin_batch_size_{0};
+  blockaccess::BlockAccesserSPtr block_accessor_;
+};
+
+TEST_F(BlockDeleterTest, Delete) {
+  FLAGS_mds_gc_delete_batch_size = 16;
+
+  auto block_deleter = BlockDeleter::New(1, block_accessor_);
+  ASSERT_TRUE(block_deleter->Init());
+
+  auto keys = PutBlocks("delete", 100);
+  auto check_keys = keys;
+
+  ASSERT_TRUE(block_deleter->Delete(keys).ok());
+  EXPECT_TRUE(keys.empty());
+  EXPECT_EQ(100, block_deleter->DeletedCount());
+
+  for (const auto& key : check_keys) {
+    EXPECT_FALSE(block_accessor_->BlockExist(key)) << key;
+  }
+
+  block_deleter->Destroy();
+}
+
+TEST_F(BlockDeleterTest, ConcurrentSubmit) {
+  FLAGS_mds_gc_delete_batch_size = 32;
+
+  auto block_deleter = BlockDeleter::New(1, block_accessor_);
+  ASSERT_TRUE(block_deleter->Init());
+
+  const uint32_t task_num = 8;
+  std::vector<std::list<std::string>> task_keys;
+  for (uint32_t i = 0; i < task_num; ++i) {
+    task_keys.push_back(PutBlocks(fmt::format("task_{}", i), 50));
+  }
+  auto check_task_keys = task_keys;
+
+  // every task submit keys in segment, batch mix keys of tasks
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < task_num; ++i) {
+    threads.emplace_back([&, i]() {
+      auto waiter = BlockDeleter::NewWaiter();
+      std::list<std::string> segment;
+      for (auto& key : task_keys[i]) {
+        segment.push_back(key);
+        if (segment.size() >= 7) block_deleter->Submit(segment, waiter);
+      }
+      block_deleter->Submit(segment, waiter);
+
+      EXPECT_TRUE(waiter->Wait().ok());
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(task_num * 50, block_deleter->DeletedCount());
+  for (const auto& keys : check_task_keys) {
+    for (const auto& key : keys) {
+      EXPECT_FALSE(block_accessor_->BlockExist(key)) << key;
+    }
+  }
+
+  block_deleter->Destroy();
+}
+
+TEST_F(BlockDeleterTest, SubmitAfterDestroy) {
+  auto block_deleter = BlockDeleter::New(1, block_accessor_);
+  ASSERT_TRUE(block_deleter->Init());
+  block_deleter->Destroy();
+
+  auto keys = PutBlocks("stopped", 1);
+  EXPECT_FALSE(block_deleter->Delete(keys).ok());
+  EXPECT_TRUE(block_accessor_->BlockExist("stopped/block_0"));
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
@@ -224,6 +224,42 @@ TEST_F(MetaDataCodecTest, ChunkKey) {
   EXPECT_EQ(chunk.version(), actual_chunk.version());
 }
 
+TEST_F(MetaDataCodecTest, ChunkDeltaKey) {
+  uint32_t expected_fs_id = 1;
+  Ino expected_inode_id = 12345;
+  uint64_t expected_chunk_index = 67890;
+  uint64_t expected_version = 7;
+  std::string key = MetaCodec::EncodeChunkDeltaKey(
+      expected_fs_id, expected_inode_id, expected_chunk_index, expected_version);
+
+  EXPECT_TRUE(MetaCodec::IsChunkDeltaKey(key));
+  EXPECT_FALSE(MetaCodec::IsChunkKey(key));
+
+  uint32_t actual_fs_id;
+  uint64_t actual_inode_id;
+  uint64_t actual_chunk_index;
+  uint64_t actual_version;
+  MetaCodec::DecodeChunkDeltaKey(key, actual_fs_id, actual_inode_id,
+                                 actual_chunk_index, actual_version);
+  EXPECT_EQ(expected_fs_id, actual_fs_id);
+  EXPECT_EQ(expected_inode_id, actual_inode_id);
+  EXPECT_EQ(expected_chunk_index, actual_chunk_index);
+  EXPECT_EQ(expected_version, actual_version);
+
+  // delta record is ordered after its base and before next chunk
+  Range range = MetaCodec::GetChunkIndexRange(expected_fs_id, expected_inode_id,
+                                              expected_chunk_index);
+  EXPECT_EQ(MetaCodec::EncodeChunkKey(expected_fs_id, expected_inode_id,
+                                      expected_chunk_index),
+            range.start);
+  EXPECT_LT(range.start, key);
+  EXPECT_LT(key, range.end);
+  EXPECT_LT(key, MetaCodec::EncodeChunkDeltaKey(expected_fs_id,
+                                                expected_inode_id,
+                                                expected_chunk_index,
+                                                expected_version + 1));
+}
+
 TEST_F(MetaDataCodecTest, FileSessionKey) {
   uint32_t expected_fs_id = 1;
   Ino expected_inode_id = 12345;
@@ -252,6 +288,39 @@ TEST_F(MetaDataCodecTest, FileSessionKey) {
   EXPECT_EQ(file_session.ino(), actual_file_session.ino());
 }
 
+TEST_F(MetaDataCodecTest, FileSessionExpireKey) {
+  uint32_t expected_fs_id = 1;
+  uint64_t expected_bucket = 28800;
+  Ino expected_inode_id = 12345;
+  std::string expected_session_id = "123e4567-e89b-12d3-a456-426614174000";
+  std::string key = MetaCodec::EncodeFileSessionExpireKey(
+      expected_fs_id, expected_bucket, expected_inode_id, expected_session_id);
+  EXPECT_TRUE(MetaCodec::IsFileSessionExpireKey(key));
+  EXPECT_FALSE(MetaCodec::IsFileSessionKey(key));
+
+  uint32_t actual_fs_id;
+  uint64_t actual_bucket;
+  Ino actual_inode_id;
+  std::string actual_session_id;
+  MetaCodec::DecodeFileSessionExpireKey(key, actual_fs_id, actual_bucket,
+                                        actual_inode_id, actual_session_id);
+  EXPECT_EQ(expected_fs_id, actual_fs_id);
+  EXPECT_EQ(expected_bucket, actual_bucket);
+  EXPECT_EQ(expected_inode_id, actual_inode_id);
+  EXPECT_EQ(expected_session_id, actual_session_id);
+
+  // range only cover bucket before end bucket
+  auto range =
+      MetaCodec::GetFileSessionExpireRange(expected_fs_id, expected_bucket);
+  EXPECT_LE(range.start, MetaCodec::EncodeFileSessionExpireKey(
+                             expected_fs_id, 0, 1, expected_session_id));
+  EXPECT_LT(MetaCodec::EncodeFileSessionExpireKey(
+                expected_fs_id, expected_bucket - 1, UINT64_MAX,
+                expected_session_id),
+            range.end);
+  EXPECT_LE(range.end, key);
+}
+
 TEST_F(MetaDataCodecTest, DirQuotaKey) {
   uint32_t expected_fs_id = 1;
   Ino expected_inode_id = 12345;
@@ -320,6 +389,45 @@ TEST_F(MetaDataCodecTest, DelSliceKey) {
   }
 }
 
+TEST_F(MetaDataCodecTest, DelPackKey) {
+  uint32_t expected_fs_id = 1;
+  uint64_t expected_pack_id = 67890;
+  Ino expected_inode_id = 12345;
+  std::string key = MetaCodec::EncodeDelPackKey(
+      expected_fs_id, expected_pack_id, expected_inode_id);
+
+  EXPECT_TRUE(MetaCodec::IsDelPackKey(key));
+  EXPECT_FALSE(MetaCodec::IsDelSliceKey(key));
+
+  uint32_t actual_fs_id;
+  uint64_t actual_pack_id;
+  Ino actual_inode_id;
+  MetaCodec::DecodeDelPackKey(key, actual_fs_id, actual_pack_id,
+                              actual_inode_id);
+  EXPECT_EQ(expected_fs_id, actual_fs_id);
+  EXPECT_EQ(expected_pack_id, actual_pack_id);
+  EXPECT_EQ(expected_inode_id, actual_inode_id);
+
+  uint64_t expected_pack_refs = 16;
+  uint64_t expected_time_ns = 1234567890;
+  std::string value = MetaCodec::EncodeDelPackValue(
+      expected_pack_refs, expected_time_ns, true);
+  uint64_t actual_pack_refs;
+  uint64_t actual_time_ns;
+  bool actual_is_live = false;
+  MetaCodec::DecodeDelPackValue(value, actual_pack_refs, actual_time_ns,
+                                actual_is_live);
+  EXPECT_EQ(expected_pack_refs, actual_pack_refs);
+  EXPECT_EQ(expected_time_ns, actual_time_ns);
+  EXPECT_TRUE(actual_is_live);
+
+  value = MetaCodec::EncodeDelPackValue(expected_pack_refs, expected_time_ns,
+                                        false);
+  MetaCodec::DecodeDelPackValue(value, actual_pack_refs, actual_time_ns,
+                                actual_is_live);
+  EXPECT_FALSE(actual_is_live);
+}
+
 TEST_F(MetaDataCodecTest, DelFileKey) {
   uint32_t expected_fs_id = 1;
   Ino expected_inode_id = 12345;
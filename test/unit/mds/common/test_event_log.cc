@@ -0,0 +1,151 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/common/event_log.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_uint32(mds_event_log_ring_size);
+DECLARE_uint32(mds_event_log_flush_interval_ms);
+
+namespace unit_test {
+
+class EventLogTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(EventLogTest, FormatMessage) {
+  Event event;
+  event.format = "[fs.{}.{}] name({}) ratio({:.1f}) ok({}) offset({}).";
+
+  EventEncoder encoder(event);
+  encoder.Encode(uint32_t(1));
+  encoder.Encode(uint64_t(100));
+  encoder.Encode(std::string("file1"));
+  encoder.Encode(0.5);
+  encoder.Encode(true);
+  encoder.Encode(int64_t(-10));
+
+  EXPECT_FALSE(event.is_truncated);
+  EXPECT_EQ("[fs.1.100] name(file1) ratio(0.5) ok(true) offset(-10).", EventLog::FormatMessage(event));
+}
+
+TEST_F(EventLogTest, TruncateLongArg) {
+  Event event;
+  event.format = "key({}) ino({}).";
+
+  EventEncoder encoder(event);
+  encoder.Encode(std::string(1024, 'a'));
+  encoder.Encode(uint64_t(1));
+
+  // long string is cut off, and the arg after it is lost
+  EXPECT_TRUE(event.is_truncated);
+  std::string message = EventLog::FormatMessage(event);
+  EXPECT_NE(std::string::npos, message.find("format fail"));
+}
+
+TEST_F(EventLogTest, Ring) {
+  EventRing ring(4);
+
+  for (int i = 0; i < 4; ++i) {
+    Event* event = ring.Reserve();
+    ASSERT_NE(nullptr, event);
+    event->line = i;
+    ring.Commit();
+  }
+
+  // full
+  EXPECT_EQ(nullptr, ring.Reserve());
+
+  std::vector<Event> events;
+  EXPECT_EQ(4, ring.Drain(events));
+  ASSERT_EQ(4, events.size());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, events[i].line);
+  }
+
+  EXPECT_NE(nullptr, ring.Reserve());
+}
+
+// count glog message of the severity
+class CountLogSink : public google::LogSink {
+ public:
+  explicit CountLogSink(google::LogSeverity severity) : severity_(severity) {}
+
+  void send(google::LogSeverity severity, const char*, const char*, int, const google::LogMessageTime&,
+            const char* message, size_t message_len) override {
+    if (severity == severity_ && std::string(message, message_len).find("[eventlog.test]") != std::string::npos) {
+      ++count_;
+    }
+  }
+
+  int Count() const { return count_.load(); }
+
+ private:
+  google::LogSeverity severity_;
+  std::atomic<int> count_{0};
+};
+
+TEST_F(EventLogTest, NeverDropWarning) {
+  std::string log_dir = std::filesystem::temp_directory_path() / ("event_log_" + std::to_string(::getpid()));
+  std::filesystem::create_directories(log_dir);
+
+  // tiny ring and slow writer, so ring is full soon
+  const uint32_t ring_size = FLAGS_mds_event_log_ring_size;
+  const uint32_t flush_interval_ms = FLAGS_mds_event_log_flush_interval_ms;
+  FLAGS_mds_event_log_ring_size = 2;
+  FLAGS_mds_event_log_flush_interval_ms = 100;
+  ASSERT_TRUE(EventLog::GetInstance().Init(log_dir));
+
+  CountLogSink warning_sink(google::GLOG_WARNING);
+  CountLogSink error_sink(google::GLOG_ERROR);
+  google::AddLogSink(&warning_sink);
+  google::AddLogSink(&error_sink);
+
+  for (uint64_t i = 0; i < 100; ++i) {
+    EVENT_LOG(INFO, "[eventlog.test] info({}).", i);
+    EVENT_LOG(WARNING, "[eventlog.test] warning({}).", i);
+    EVENT_LOG(ERROR, "[eventlog.test] error({}).", i);
+  }
+
+  google::RemoveLogSink(&warning_sink);
+  google::RemoveLogSink(&error_sink);
+  EventLog::GetInstance().Destroy();
+  FLAGS_mds_event_log_ring_size = ring_size;
+  FLAGS_mds_event_log_flush_interval_ms = flush_interval_ms;
+
+  EXPECT_EQ(100, warning_sink.Count());
+  EXPECT_EQ(100, error_sink.Count());
+
+  std::filesystem::remove_all(log_dir);
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <cstdint>
+
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+#include "mds/common/type.h"
+#include "mds/filesystem/attr_lease.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_bool(mds_attr_lease_enable);
+DECLARE_uint32(mds_attr_lease_ms);
+
+namespace unit_test {
+
+const int64_t kFsId = 1000;
+
+class AttrLeaseTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_mds_attr_lease_enable = true;
+    FLAGS_mds_attr_lease_ms = 5000;
+  }
+  void TearDown() override { FLAGS_mds_attr_lease_enable = false; }
+};
+
+TEST_F(AttrLeaseTest, GrantRead) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  AttrLeaseManager lease_manager(kFsId, client_notifier);
+
+  auto lease = lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_READ, lease.type());
+  ASSERT_EQ(5000, lease.lease_ms());
+
+  // read delegation is shared
+  lease = lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_READ, lease.type());
+
+  // no client id
+  lease = lease_manager.Grant(101, "", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+
+  FLAGS_mds_attr_lease_enable = false;
+  lease = lease_manager.Grant(102, "client1", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+}
+
+TEST_F(AttrLeaseTest, GrantWriteConflict) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  AttrLeaseManager lease_manager(kFsId, client_notifier);
+
+  auto lease = lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_READ, lease.type());
+
+  // conflict with read delegation of other client
+  lease = lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_WRITE);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+
+  // upgrade self delegation
+  lease = lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_WRITE);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_WRITE, lease.type());
+
+  // conflict with write delegation of other client
+  lease = lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+}
+
+TEST_F(AttrLeaseTest, RecallRead) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  AttrLeaseManager lease_manager(kFsId, client_notifier);
+
+  lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_READ);
+  lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(1, lease_manager.Size());
+
+  // only recall write delegation
+  lease_manager.Recall(100, "client3", true);
+  ASSERT_EQ(1, lease_manager.Size());
+
+  lease_manager.Recall(100, "client1", false);
+  ASSERT_EQ(1, lease_manager.Size());
+
+  auto lease = lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_WRITE);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+
+  lease_manager.Recall(100, "client2", false);
+  lease = lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_WRITE);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_WRITE, lease.type());
+}
+
+TEST_F(AttrLeaseTest, MarkWrite) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  AttrLeaseManager lease_manager(kFsId, client_notifier);
+
+  FLAGS_mds_attr_lease_ms = 100;
+  lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_READ);
+
+  // read delegation of other client is recalled and not granted while writing
+  lease_manager.MarkWrite(100, "client2");
+  auto lease = lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+
+  lease = lease_manager.Grant(100, "client2", pb::mds::ATTR_LEASE_WRITE);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_WRITE, lease.type());
+
+  // write delegation of writer is kept
+  lease_manager.MarkWrite(100, "client2");
+  lease = lease_manager.Grant(100, "client3", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_NONE, lease.type());
+
+  // writer stop for a lease time
+  ::usleep(200 * 1000);
+  lease = lease_manager.Grant(100, "client1", pb::mds::ATTR_LEASE_READ);
+  ASSERT_EQ(pb::mds::ATTR_LEASE_READ, lease.type());
+
+  lease_manager.CleanExpired();
+  ASSERT_EQ(1, lease_manager.Size());
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/filesystem/bucket_load.h"
+
+#include <cstdint>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "mds/coordinator/dummy_coordinator_client.h"
+#include "mds/filesystem/id_generator.h"
+
+namespace dingofs {
+namespace mds {
+namespace unit_test {
+
+TEST(BucketLoadRecorderTest, FileOpInParentBucket) {
+  auto coordinator_client = DummyCoordinatorClient::New();
+  ASSERT_TRUE(coordinator_client->Init("")) << "init coordinator client fail.";
+
+  auto id_generator = CoorAutoIncrementIdGenerator::New(coordinator_client, "test_bucket_load", 1004, 20000, 64);
+  ASSERT_TRUE(id_generator->Init()) << "init id generator fail.";
+
+  const uint32_t bucket_num = 16;
+  AffinityInoAllocator allocator(*id_generator, 2, 4);
+  BucketLoadRecorder recorder(bucket_num);
+  recorder.SetInoAffinity(true);
+
+  // dir 21 is in bucket 5, lookup/create under it and read/write its files
+  const uint64_t parent = 21;
+  const uint32_t parent_bucket_id = parent % bucket_num;
+  for (int i = 0; i < 100; ++i) {
+    uint64_t ino = 0;
+    ASSERT_TRUE(allocator.GenFileIno(bucket_num, parent_bucket_id, ino));
+
+    recorder.RecordParent(parent);
+    recorder.RecordIno(ino, 0);
+  }
+
+  std::map<uint32_t, uint64_t> bucket_ops;
+  recorder.Take(bucket_ops);
+  ASSERT_EQ(1, bucket_ops.size());
+  ASSERT_EQ(200, bucket_ops[parent_bucket_id]);
+
+  // dir ino is hashed by itself
+  recorder.RecordIno(parent, 0);
+  bucket_ops.clear();
+  recorder.Take(bucket_ops);
+  ASSERT_EQ(1, bucket_ops[parent_bucket_id]);
+}
+
+TEST(BucketLoadRecorderTest, FileOpWithoutAffinity) {
+  BucketLoadRecorder recorder(16);
+  ASSERT_TRUE(recorder.IsParentNeeded(40));
+  ASSERT_FALSE(recorder.IsParentNeeded(21));
+
+  // file ino is counted to parent bucket, unknown parent is not counted
+  recorder.RecordIno(40, 21);
+  recorder.RecordIno(40, 0);
+
+  std::map<uint32_t, uint64_t> bucket_ops;
+  recorder.Take(bucket_ops);
+  ASSERT_EQ(1, bucket_ops.size());
+  ASSERT_EQ(1, bucket_ops[5]);
+
+  recorder.SetInoAffinity(true);
+  ASSERT_FALSE(recorder.IsParentNeeded(40));
+}
+
+TEST(BucketLoadRecorderTest, BucketNumChange) {
+  BucketLoadRecorder recorder(8);
+  recorder.RecordParent(9);
+
+  // no hash partition
+  recorder.SetBucketNum(0);
+  recorder.RecordParent(9);
+  recorder.RecordIno(18, 9);
+
+  std::map<uint32_t, uint64_t> bucket_ops;
+  recorder.SetBucketNum(8);
+  recorder.Take(bucket_ops);
+  ASSERT_EQ(1, bucket_ops.size());
+  ASSERT_EQ(1, bucket_ops[1]);
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
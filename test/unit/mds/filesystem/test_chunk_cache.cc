@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <cstdint>
 
@@ -132,6 +133,31 @@ TEST_F(ChunkCacheTest, Delete) {
   }
 }
 
+TEST_F(ChunkCacheTest, LoadTime) {
+  mds::ChunkCache chunk_cache(kFsId);
+
+  Ino ino = 100000;
+
+  ASSERT_TRUE(chunk_cache.PutIf(ino, GenChunkEntry(0, 2)));
+
+  uint64_t load_time_ms = 0;
+  ASSERT_NE(nullptr, chunk_cache.Get(ino, 0, load_time_ms));
+  ASSERT_GT(load_time_ms, 0);
+
+  usleep(2000);
+
+  // older version not refresh load time
+  uint64_t old_load_time_ms = load_time_ms;
+  ASSERT_FALSE(chunk_cache.PutIf(ino, GenChunkEntry(0, 1)));
+  ASSERT_NE(nullptr, chunk_cache.Get(ino, 0, load_time_ms));
+  ASSERT_EQ(old_load_time_ms, load_time_ms);
+
+  // same version confirm chunk is up to date
+  ASSERT_FALSE(chunk_cache.PutIf(ino, GenChunkEntry(0, 2)));
+  ASSERT_NE(nullptr, chunk_cache.Get(ino, 0, load_time_ms));
+  ASSERT_GT(load_time_ms, old_load_time_ms);
+}
+
 }  // namespace unit_test
 }  // namespace mds
 }  // namespace dingofs
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <cstdint>
+
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+#include "mds/common/type.h"
+#include "mds/filesystem/dentry_lease.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_bool(mds_dentry_lease_enable);
+DECLARE_uint32(mds_dentry_lease_ms);
+
+namespace unit_test {
+
+const int64_t kFsId = 1000;
+
+class DentryLeaseTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_mds_dentry_lease_enable = true;
+    FLAGS_mds_dentry_lease_ms = 3000;
+  }
+  void TearDown() override { FLAGS_mds_dentry_lease_enable = false; }
+};
+
+TEST_F(DentryLeaseTest, Grant) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  DentryLeaseManager lease_manager(kFsId, client_notifier);
+
+  ASSERT_EQ(3000, lease_manager.Grant(100, "client1"));
+  ASSERT_EQ(3000, lease_manager.Grant(100, "client2"));
+  ASSERT_EQ(3000, lease_manager.Grant(101, "client1"));
+  ASSERT_EQ(2, lease_manager.Size());
+
+  // no client id
+  ASSERT_EQ(0, lease_manager.Grant(102, ""));
+  ASSERT_EQ(2, lease_manager.Size());
+
+  FLAGS_mds_dentry_lease_enable = false;
+  ASSERT_EQ(0, lease_manager.Grant(103, "client1"));
+  ASSERT_EQ(2, lease_manager.Size());
+}
+
+TEST_F(DentryLeaseTest, Revoke) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  DentryLeaseManager lease_manager(kFsId, client_notifier);
+
+  lease_manager.Grant(100, "client1");
+  lease_manager.Grant(101, "client1");
+  ASSERT_EQ(2, lease_manager.Size());
+
+  lease_manager.Revoke(100, "client1");
+  ASSERT_EQ(1, lease_manager.Size());
+
+  lease_manager.Revoke(200, "client1");
+  ASSERT_EQ(1, lease_manager.Size());
+
+  lease_manager.Revoke(101, "");
+  ASSERT_EQ(0, lease_manager.Size());
+}
+
+TEST_F(DentryLeaseTest, CleanExpired) {
+  ClientNotifier client_notifier(kFsId, nullptr);
+  DentryLeaseManager lease_manager(kFsId, client_notifier);
+
+  FLAGS_mds_dentry_lease_ms = 1;
+  lease_manager.Grant(100, "client1");
+  lease_manager.Grant(101, "client2");
+  ASSERT_EQ(2, lease_manager.Size());
+
+  usleep(2000);
+
+  FLAGS_mds_dentry_lease_ms = 3000;
+  lease_manager.Grant(101, "client1");
+
+  lease_manager.CleanExpired();
+  ASSERT_EQ(1, lease_manager.Size());
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
@@ -0,0 +1,95 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mds/filesystem/follower.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_uint32(mds_follower_expire_s);
+
+namespace unit_test {
+
+const uint32_t kFsId = 1000;
+
+class FollowerManagerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    origin_expire_s_ = FLAGS_mds_follower_expire_s;
+    origin_max_staleness_ms_ = FLAGS_mds_follower_max_staleness_ms;
+  }
+
+  void TearDown() override {
+    FLAGS_mds_follower_expire_s = origin_expire_s_;
+    FLAGS_mds_follower_max_staleness_ms = origin_max_staleness_ms_;
+  }
+
+  uint32_t origin_expire_s_{0};
+  uint32_t origin_max_staleness_ms_{0};
+};
+
+TEST_F(FollowerManagerTest, Follow) {
+  FollowerManager follower_manager(kFsId);
+  ASSERT_FALSE(follower_manager.HasFollower());
+
+  follower_manager.Follow(1001);
+  follower_manager.Follow(1002);
+  follower_manager.Follow(1001);
+  ASSERT_TRUE(follower_manager.HasFollower());
+
+  auto mds_ids = follower_manager.GetFollowers();
+  std::sort(mds_ids.begin(), mds_ids.end());
+  ASSERT_EQ(std::vector<uint64_t>({1001, 1002}), mds_ids);
+}
+
+TEST_F(FollowerManagerTest, Expire) {
+  FLAGS_mds_follower_expire_s = 0;
+
+  FollowerManager follower_manager(kFsId);
+  follower_manager.Follow(1001);
+
+  usleep(2000);
+
+  ASSERT_TRUE(follower_manager.GetFollowers().empty());
+  ASSERT_FALSE(follower_manager.HasFollower());
+}
+
+TEST_F(FollowerManagerTest, ShouldRenew) {
+  FLAGS_mds_follower_expire_s = 30;
+
+  FollowerManager follower_manager(kFsId);
+  ASSERT_TRUE(follower_manager.ShouldRenew());
+  ASSERT_FALSE(follower_manager.ShouldRenew());
+}
+
+TEST_F(FollowerManagerTest, StalenessMs) {
+  FLAGS_mds_follower_max_staleness_ms = 1000;
+
+  ASSERT_EQ(1000, FollowerManager::StalenessMs(0));
+  ASSERT_EQ(200, FollowerManager::StalenessMs(200));
+  ASSERT_EQ(1000, FollowerManager::StalenessMs(5000));
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
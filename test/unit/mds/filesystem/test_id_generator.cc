@@ -13,12 +13,16 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "fmt/core.h"
 #include "gtest/gtest.h"
 #include "mds/coordinator/dummy_coordinator_client.h"
 #include "mds/filesystem/id_generator.h"
+#include "mds/storage/dummy_storage.h"
 
 namespace dingofs {
 namespace mds {
@@ -51,6 +55,151 @@ TEST_F(AutoIncrementIdGeneratorTest, GenID) {
   }
 }
 
+TEST_F(AutoIncrementIdGeneratorTest, ConcurrentGenID) {
+  auto coordinator_client = DummyCoordinatorClient::New();
+  ASSERT_TRUE(coordinator_client->Init("")) << "init coordinator client fail.";
+
+  int64_t table_id = 1003;
+  auto id_generator = CoorAutoIncrementIdGenerator::New(coordinator_client, "test_concurrent", table_id, 20000, 8);
+  ASSERT_TRUE(id_generator->Init()) << "init id generator fail.";
+
+  // bundle switch and prefetch happen during alloc
+  const int thread_num = 8;
+  std::vector<std::vector<uint64_t>> thread_ids(thread_num);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 10000; ++i) {
+        uint64_t id = 0;
+        ASSERT_TRUE(id_generator->GenID(2, id));
+        thread_ids[t].push_back(id);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  std::set<uint64_t> ids;
+  for (auto& ids_of_thread : thread_ids) {
+    for (auto id : ids_of_thread) {
+      ASSERT_GE(id, 20000);
+      ASSERT_TRUE(ids.insert(id).second) << "duplicate id " << id;
+      ASSERT_TRUE(ids.insert(id + 1).second) << "duplicate id " << id + 1;
+    }
+  }
+}
+
+TEST_F(AutoIncrementIdGeneratorTest, GenIDWithMinID) {
+  auto kv_storage = DummyStorage::New();
+  ASSERT_TRUE(kv_storage->Init("")) << "init kv storage fail.";
+
+  auto id_generator = StoreAutoIncrementIdGenerator::New(kv_storage, "test_min_id", 20000, 16);
+  ASSERT_TRUE(id_generator->Init()) << "init id generator fail.";
+
+  uint64_t last_id = 0;
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t id = 0;
+    ASSERT_TRUE(id_generator->GenID(1, id));
+    ASSERT_GT(id, last_id);
+    last_id = id;
+  }
+
+  // skip beyond current and prefetched bundle
+  uint64_t id = 0;
+  ASSERT_TRUE(id_generator->GenID(4, last_id + 1000000, id));
+  ASSERT_GE(id, last_id + 1000000);
+
+  uint64_t next_id = 0;
+  ASSERT_TRUE(id_generator->GenID(1, next_id));
+  ASSERT_GE(next_id, id + 4);
+
+  // restart never hand out allocated id
+  auto new_id_generator = StoreAutoIncrementIdGenerator::New(kv_storage, "test_min_id", 20000, 16);
+  ASSERT_TRUE(new_id_generator->Init()) << "init id generator fail.";
+  ASSERT_TRUE(new_id_generator->GenID(1, id));
+  ASSERT_GT(id, next_id);
+}
+
+TEST_F(AutoIncrementIdGeneratorTest, AffinityInoAllocator) {
+  auto coordinator_client = DummyCoordinatorClient::New();
+  ASSERT_TRUE(coordinator_client->Init("")) << "init coordinator client fail.";
+
+  int64_t table_id = 1002;
+  auto id_generator = CoorAutoIncrementIdGenerator::New(
+      coordinator_client, "test_affinity", table_id, 20001, 64);
+  ASSERT_TRUE(id_generator->Init()) << "init id generator fail.";
+
+  const uint32_t bucket_num = 16;
+  AffinityInoAllocator allocator(*id_generator, 2, 4);
+
+  std::set<uint64_t> inos;
+  for (int i = 0; i < 100; ++i) {
+    uint32_t bucket_id = (i * 7) % bucket_num;
+
+    uint64_t ino = 0;
+    ASSERT_TRUE(allocator.GenFileIno(bucket_num, bucket_id, ino));
+    ASSERT_EQ(ino & 1, 0) << "file ino should be even.";
+    ASSERT_EQ((ino >> 1) % bucket_num, bucket_id);
+    ASSERT_TRUE(inos.insert(ino).second) << "duplicate ino " << ino;
+  }
+
+  // cached ino per bucket is bounded
+  ASSERT_LE(allocator.CachedCount(), bucket_num * 4);
+
+  // bucket num changed
+  uint64_t ino = 0;
+  ASSERT_TRUE(allocator.GenFileIno(8, 3, ino));
+  ASSERT_EQ((ino >> 1) % 8, 3);
+  ASSERT_TRUE(inos.insert(ino).second) << "duplicate ino " << ino;
+}
+
+TEST_F(AutoIncrementIdGeneratorTest, AffinityInoAllocatorDiscard) {
+  auto coordinator_client = DummyCoordinatorClient::New();
+  ASSERT_TRUE(coordinator_client->Init("")) << "init coordinator client fail.";
+
+  int64_t table_id = 1003;
+  auto id_generator =
+      CoorAutoIncrementIdGenerator::New(coordinator_client, "test_affinity_discard", table_id, 20000, 64);
+  ASSERT_TRUE(id_generator->Init()) << "init id generator fail.";
+
+  const uint32_t bucket_num = 16;
+  const uint32_t batch = 2;
+  AffinityInoAllocator allocator(*id_generator, batch, 8);
+
+  // uniform allocation use every even id of strides
+  std::set<uint64_t> inos;
+  for (uint32_t i = 0; i < bucket_num * batch * 4; ++i) {
+    uint64_t ino = 0;
+    ASSERT_TRUE(allocator.GenFileIno(bucket_num, i % bucket_num, ino));
+    ASSERT_EQ((ino >> 1) % bucket_num, i % bucket_num);
+    ASSERT_TRUE(inos.insert(ino).second) << "duplicate ino " << ino;
+  }
+  ASSERT_EQ(0, allocator.CachedCount());
+  ASSERT_EQ(inos.size(), allocator.DiscardedCount()) << "only odd ids are discarded.";
+
+  // hot bucket, other buckets keep strides until full
+  const uint64_t discarded_count = allocator.DiscardedCount();
+  for (uint32_t i = 0; i < batch * 8; ++i) {
+    uint64_t ino = 0;
+    ASSERT_TRUE(allocator.GenFileIno(bucket_num, 5, ino));
+    ASSERT_EQ((ino >> 1) % bucket_num, 5);
+    ASSERT_TRUE(inos.insert(ino).second) << "duplicate ino " << ino;
+  }
+  // 8 refills, 4 of them fill the other buckets, the rest are discarded
+  const uint64_t refill_num = 2ULL * bucket_num * batch;
+  ASSERT_EQ((bucket_num - 1) * 8, allocator.CachedCount());
+  ASSERT_EQ(discarded_count + (8 * refill_num / 2) + (4 * (bucket_num - 1) * batch), allocator.DiscardedCount());
+
+  // cached strides of other buckets are still usable
+  for (uint32_t bucket_id = 0; bucket_id < bucket_num; ++bucket_id) {
+    if (bucket_id == 5) continue;
+
+    uint64_t ino = 0;
+    ASSERT_TRUE(allocator.GenFileIno(bucket_num, bucket_id, ino));
+    ASSERT_EQ((ino >> 1) % bucket_num, bucket_id);
+    ASSERT_TRUE(inos.insert(ino).second) << "duplicate ino " << ino;
+  }
+}
+
 }  // namespace unit_test
 }  // namespace mds
 }  // namespace dingofs
\ No newline at end of file
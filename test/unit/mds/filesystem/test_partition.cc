@@ -238,6 +238,97 @@ TEST_F(PartitionTest, Merge) {
   }
 }
 
+TEST_F(PartitionTest, ScanDelta) {
+  const Ino parent = 1;
+
+  Partition partition(
+      Inode::New(GenInode(kFsId, parent, pb::mds::FileType::DIRECTORY, 1)));
+
+  auto cursor = partition.GetCursor();
+
+  partition.Put(
+      Dentry(kFsId, "file01", parent, 1001, pb::mds::FileType::FILE, 0), 3);
+  partition.Put(
+      Dentry(kFsId, "file02", parent, 1002, pb::mds::FileType::FILE, 0), 2);
+  partition.Delete("file01", 4);
+
+  // changes in apply order
+  {
+    std::vector<Partition::DentryDelta> deltas;
+    Partition::Cursor cur_cursor;
+    ASSERT_TRUE(partition.ScanDelta(cursor, 0, deltas, cur_cursor));
+    ASSERT_EQ(deltas.size(), 3);
+    ASSERT_EQ(deltas[0].dentry.Name(), "file01");
+    ASSERT_TRUE(deltas[0].op_type == Partition::DentryOpType::ADD);
+    ASSERT_EQ(deltas[1].dentry.Name(), "file02");
+    ASSERT_EQ(deltas[2].dentry.Name(), "file01");
+    ASSERT_TRUE(deltas[2].op_type == Partition::DentryOpType::DELETE);
+    ASSERT_EQ(cur_cursor.epoch, cursor.epoch);
+    ASSERT_EQ(cur_cursor.seq, cursor.seq + 3);
+
+    // no more change
+    deltas.clear();
+    Partition::Cursor next_cursor;
+    ASSERT_TRUE(partition.ScanDelta(cur_cursor, 0, deltas, next_cursor));
+    ASSERT_TRUE(deltas.empty());
+  }
+
+  // exceed limit
+  {
+    std::vector<Partition::DentryDelta> deltas;
+    Partition::Cursor cur_cursor;
+    ASSERT_FALSE(partition.ScanDelta(cursor, 2, deltas, cur_cursor));
+  }
+
+  // epoch changed after merge
+  {
+    Partition other_partition(
+        Inode::New(GenInode(kFsId, parent, pb::mds::FileType::DIRECTORY, 5)));
+    ASSERT_TRUE(partition.Merge(std::move(other_partition)));
+
+    std::vector<Partition::DentryDelta> deltas;
+    Partition::Cursor cur_cursor;
+    ASSERT_FALSE(partition.ScanDelta(cursor, 0, deltas, cur_cursor));
+    ASSERT_NE(cur_cursor.epoch, cursor.epoch);
+  }
+}
+
+TEST_F(PartitionTest, ApplyDelta) {
+  const Ino parent = 1;
+
+  Partition partition(
+      Inode::New(GenInode(kFsId, parent, pb::mds::FileType::DIRECTORY, 2)));
+  partition.Put(
+      Dentry(kFsId, "file01", parent, 1001, pb::mds::FileType::FILE, 0), 2);
+
+  // already in base
+  ASSERT_TRUE(partition.ApplyDelta(
+      2, {"file01"},
+      {Dentry(kFsId, "file02", parent, 1002, pb::mds::FileType::FILE, 0)}));
+  ASSERT_EQ(partition.Size(), 1);
+
+  // rename file01 to file02, delete before put
+  ASSERT_TRUE(partition.ApplyDelta(
+      3, {"file01"},
+      {Dentry(kFsId, "file02", parent, 1001, pb::mds::FileType::FILE, 0)}));
+  Dentry dentry;
+  ASSERT_FALSE(partition.Get("file01", dentry));
+  ASSERT_TRUE(partition.Get("file02", dentry));
+  ASSERT_EQ(dentry.INo(), 1001);
+
+  // same version of one batch
+  ASSERT_TRUE(partition.ApplyDelta(
+      3, {},
+      {Dentry(kFsId, "file03", parent, 1003, pb::mds::FileType::FILE, 0)}));
+  ASSERT_EQ(partition.Size(), 2);
+  ASSERT_EQ(partition.DeltaVersion(), 3);
+
+  // out of order
+  ASSERT_TRUE(partition.ApplyDelta(5, {"file03"}, {}));
+  ASSERT_FALSE(partition.ApplyDelta(4, {"file02"}, {}));
+  ASSERT_TRUE(partition.Get("file02", dentry));
+}
+
 TEST_F(PartitionCacheTest, Put) {
   PartitionCache partition_cache(kFsId);
 
@@ -0,0 +1,618 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bthread/countdown_event.h"
+#include "common/const.h"
+#include "dingofs/error.pb.h"
+#include "dingofs/mds.pb.h"
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+#include "mds/common/codec.h"
+#include "mds/common/tracing.h"
+#include "mds/common/type.h"
+#include "mds/filesystem/store_operation.h"
+#include "mds/storage/memory_storage.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_bool(mds_chunk_delta_enable);
+DECLARE_bool(mds_store_operation_multi_inode_batch_enable);
+
+namespace unit_test {
+
+static const uint32_t kFsId = 1;
+static const uint64_t kChunkSize = 64 * 1024 * 1024;
+static const uint64_t kBlockSize = 4 * 1024 * 1024;
+
+class StoreOperationTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    storage_ = MemoryStorage::New();
+    ASSERT_TRUE(storage_->Init(""));
+
+    fs_info_.set_fs_id(kFsId);
+    fs_info_.set_chunk_size(kChunkSize);
+    fs_info_.set_block_size(kBlockSize);
+  }
+
+  void TearDown() override {
+    FLAGS_mds_chunk_delta_enable = false;
+    FLAGS_mds_store_operation_multi_inode_batch_enable = false;
+    storage_->Destroy();
+  }
+
+  static SliceEntry NewSlice(uint64_t id, uint64_t offset, uint64_t len, uint64_t pack_refs = 0) {
+    SliceEntry slice;
+    slice.set_id(id);
+    slice.set_offset(offset);
+    slice.set_len(len);
+    slice.set_size(len);
+    slice.set_pack_refs(pack_refs);
+    return slice;
+  }
+
+  static std::vector<DeltaSliceEntry> NewDeltaSlices(uint32_t chunk_index, const std::vector<SliceEntry>& slices) {
+    DeltaSliceEntry delta_slices;
+    delta_slices.set_chunk_index(chunk_index);
+    for (const auto& slice : slices) *delta_slices.add_slices() = slice;
+    return {delta_slices};
+  }
+
+  Status RunAndCommit(Operation& operation) {
+    auto txn = storage_->NewTxn();
+    auto status = operation.Run(txn);
+    if (!status.ok()) return status;
+    return txn->Commit();
+  }
+
+  Status WriteSlice(Ino ino, uint32_t chunk_index, const std::vector<SliceEntry>& slices) {
+    Trace trace;
+    UpsertChunkOperation operation(trace, fs_info_, ino, NewDeltaSlices(chunk_index, slices));
+    return RunAndCommit(operation);
+  }
+
+  ChunkEntry GetChunk(Ino ino, uint32_t chunk_index) {
+    Trace trace;
+    GetChunkOperation operation(trace, kFsId, ino, {chunk_index});
+    auto txn = storage_->NewTxn();
+    EXPECT_TRUE(operation.Run(txn).ok());
+
+    auto& result = operation.GetResult();
+    return result.chunks.empty() ? ChunkEntry() : result.chunks.front();
+  }
+
+  static std::vector<uint64_t> SliceIds(const ChunkEntry& chunk) {
+    std::vector<uint64_t> slice_ids;
+    for (const auto& slice : chunk.slices()) slice_ids.push_back(slice.id());
+    return slice_ids;
+  }
+
+  // (pack_id, ino) -> is_live
+  std::map<std::pair<uint64_t, Ino>, bool> ScanPackRefs() {
+    std::map<std::pair<uint64_t, Ino>, bool> pack_refs;
+
+    Trace trace;
+    ScanDelPackOperation operation(trace, kFsId, [&](const std::string& key, const std::string& value) -> bool {
+      uint32_t fs_id = 0;
+      uint64_t pack_id = 0, refs = 0, time_ns = 0;
+      Ino ino = 0;
+      bool is_live = false;
+      MetaCodec::DecodeDelPackKey(key, fs_id, pack_id, ino);
+      MetaCodec::DecodeDelPackValue(value, refs, time_ns, is_live);
+      pack_refs[{pack_id, ino}] = is_live;
+      return true;
+    });
+    auto txn = storage_->NewTxn();
+    EXPECT_TRUE(operation.Run(txn).ok());
+
+    return pack_refs;
+  }
+
+  // compact slice [0, 2] of chunk 0 into new slice
+  static CompactChunkOperation::Param NewCompactParam(const ChunkEntry& chunk, uint64_t new_slice_id) {
+    CompactChunkOperation::Param param;
+    param.chunk_index = 0;
+    param.version = chunk.version();
+    param.start_pos = 0;
+    param.start_slice_id = chunk.slices(0).id();
+    param.end_pos = 2;
+    param.end_slice_id = chunk.slices(2).id();
+    param.new_slices = {NewSlice(new_slice_id, 0, 4096)};
+    return param;
+  }
+
+  KVStorageSPtr storage_;
+  FsInfoEntry fs_info_;
+};
+
+TEST_F(StoreOperationTest, PackRefTruncate) {
+  const Ino ino = 1000;
+  const uint64_t pack_id = 100;
+  ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(pack_id, 0, 4096, 3)}).ok());
+
+  auto pack_refs = ScanPackRefs();
+  ASSERT_EQ(1, pack_refs.size());
+  EXPECT_TRUE(pack_refs[{pack_id, ino}]);
+
+  AttrEntry attr;
+  attr.set_fs_id(kFsId);
+  attr.set_ino(ino);
+  attr.set_length(4096);
+
+  // shrink inside chunk, packed slice is still referenced
+  {
+    AttrEntry new_attr = attr;
+    new_attr.set_length(1024);
+    UpdateAttrOperation::ExtraParam extra_param{.chunk_size = kChunkSize, .block_size = kBlockSize, .slice_id = 200};
+
+    Trace trace;
+    UpdateAttrOperation operation(trace, ino, kSetAttrSize, new_attr, extra_param);
+    auto txn = storage_->NewTxn();
+    ASSERT_TRUE(operation.RunInBatch(txn, attr, {}).ok());
+    ASSERT_TRUE(txn->Commit().ok());
+    EXPECT_TRUE(ScanPackRefs()[{pack_id, ino}]);
+  }
+
+  // truncate to zero drop the chunk, packed slice is dead
+  {
+    AttrEntry new_attr = attr;
+    new_attr.set_length(0);
+    UpdateAttrOperation::ExtraParam extra_param{.chunk_size = kChunkSize, .block_size = kBlockSize, .slice_id = 201};
+
+    Trace trace;
+    UpdateAttrOperation operation(trace, ino, kSetAttrSize, new_attr, extra_param);
+    auto txn = storage_->NewTxn();
+    ASSERT_TRUE(operation.RunInBatch(txn, attr, {}).ok());
+    ASSERT_TRUE(txn->Commit().ok());
+  }
+
+  pack_refs = ScanPackRefs();
+  ASSERT_EQ(1, pack_refs.size());
+  EXPECT_FALSE(pack_refs[{pack_id, ino}]);
+  EXPECT_TRUE(GetChunk(ino, 0).slices().empty());
+}
+
+TEST_F(StoreOperationTest, PackRefCompact) {
+  const Ino ino = 1000;
+  const uint64_t pack_id = 100;
+  ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(pack_id, 0, 4096, 3)}).ok());
+  ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(101, 0, 4096)}).ok());
+  ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(102, 0, 4096)}).ok());
+  EXPECT_TRUE(ScanPackRefs()[{pack_id, ino}]);
+
+  CompactChunkOperation::Param param;
+  param.chunk_index = 0;
+  param.version = GetChunk(ino, 0).version();
+  param.start_pos = 0;
+  param.start_slice_id = pack_id;
+  param.end_pos = 2;
+  param.end_slice_id = 102;
+  param.new_slices = {NewSlice(103, 0, 4096)};
+
+  Trace trace;
+  CompactChunkOperation operation(trace, kFsId, ino, param);
+  ASSERT_TRUE(RunAndCommit(operation).ok());
+
+  EXPECT_FALSE(ScanPackRefs()[{pack_id, ino}]);
+  EXPECT_EQ(std::vector<uint64_t>({103}), SliceIds(GetChunk(ino, 0)));
+
+  // retry write of compacted slice not revive its ref
+  ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(pack_id, 0, 4096, 3)}).ok());
+  EXPECT_FALSE(ScanPackRefs()[{pack_id, ino}]);
+  EXPECT_EQ(std::vector<uint64_t>({103}), SliceIds(GetChunk(ino, 0)));
+}
+
+TEST_F(StoreOperationTest, PackRefPending) {
+  const Ino ino = 1000;
+  const uint64_t pack_id = 100;
+
+  // pending ref is recorded before any slice of pack is committed
+  Trace trace;
+  AddPendingPackOperation operation(trace, kFsId, pack_id);
+  ASSERT_TRUE(RunAndCommit(operation).ok());
+
+  auto pack_refs = ScanPackRefs();
+  ASSERT_EQ(1, pack_refs.size());
+  EXPECT_FALSE(pack_refs[{pack_id, MetaCodec::kPendingPackIno}]);
+
+  // committed slice add its own ref, pending ref is kept
+  ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(pack_id, 0, 4096, 3)}).ok());
+  pack_refs = ScanPackRefs();
+  ASSERT_EQ(2, pack_refs.size());
+  EXPECT_FALSE(pack_refs[{pack_id, MetaCodec::kPendingPackIno}]);
+  EXPECT_TRUE(pack_refs[{pack_id, ino}]);
+}
+
+// append delta and fold base of the same version must not both commit
+TEST_F(StoreOperationTest, ConcurrentAppendAndCompact) {
+  FLAGS_mds_chunk_delta_enable = true;
+
+  const Ino ino = 1000;
+  for (uint64_t slice_id = 100; slice_id < 103; ++slice_id) {
+    ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(slice_id, 0, 4096)}).ok());
+  }
+
+  // append commit first, compact conflict
+  {
+    Trace trace;
+    CompactChunkOperation compact(trace, kFsId, ino, NewCompactParam(GetChunk(ino, 0), 103));
+    auto compact_txn = storage_->NewTxn();
+    ASSERT_TRUE(compact.Run(compact_txn).ok());
+
+    ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(104, 0, 4096)}).ok());
+
+    auto status = compact_txn->Commit();
+    ASSERT_EQ(pb::error::ESTORE_MAYBE_RETRY, status.error_code()) << status.error_str();
+  }
+  EXPECT_EQ(std::vector<uint64_t>({100, 101, 102, 104}), SliceIds(GetChunk(ino, 0)));
+
+  // compact commit first, append conflict and retry
+  {
+    Trace trace;
+    UpsertChunkOperation append(trace, fs_info_, ino, NewDeltaSlices(0, {NewSlice(105, 0, 4096)}));
+    auto append_txn = storage_->NewTxn();
+    ASSERT_TRUE(append.Run(append_txn).ok());
+
+    CompactChunkOperation compact(trace, kFsId, ino, NewCompactParam(GetChunk(ino, 0), 103));
+    ASSERT_TRUE(RunAndCommit(compact).ok());
+
+    auto status = append_txn->Commit();
+    ASSERT_EQ(pb::error::ESTORE_MAYBE_RETRY, status.error_code()) << status.error_str();
+
+    ASSERT_TRUE(WriteSlice(ino, 0, {NewSlice(105, 0, 4096)}).ok());
+  }
+  EXPECT_EQ(std::vector<uint64_t>({103, 104, 105}), SliceIds(GetChunk(ino, 0)));
+}
+
+TEST_F(StoreOperationTest, ScanChunkPage) {
+  const Ino ino = 1000;
+  for (uint32_t chunk_index = 0; chunk_index < 5; ++chunk_index) {
+    uint64_t offset = chunk_index * kChunkSize;
+    ASSERT_TRUE(WriteSlice(ino, chunk_index, {NewSlice(100 + chunk_index * 2, offset, 4096)}).ok());
+    ASSERT_TRUE(WriteSlice(ino, chunk_index, {NewSlice(101 + chunk_index * 2, offset + 4096, 4096)}).ok());
+  }
+
+  // page stop at chunk boundary, every page hold 2 chunks
+  std::vector<uint64_t> chunk_indexes;
+  uint64_t start_chunk_index = 0;
+  while (true) {
+    Trace trace;
+    ScanChunkOperation operation(trace, kFsId, ino, 3, start_chunk_index);
+    auto txn = storage_->NewTxn();
+    ASSERT_TRUE(operation.Run(txn).ok());
+
+    auto& result = operation.GetResult();
+    if (result.chunks.empty()) break;
+    ASSERT_LE(result.chunks.size(), 2);
+
+    for (const auto& chunk : result.chunks) {
+      chunk_indexes.push_back(chunk.index());
+      ASSERT_EQ(2, chunk.slices_size());
+    }
+    start_chunk_index = result.chunks.back().index() + 1;
+  }
+
+  ASSERT_EQ(std::vector<uint64_t>({0, 1, 2, 3, 4}), chunk_indexes);
+}
+
+TEST_F(StoreOperationTest, RecycleProgressCountOnce) {
+  const Ino ino = 1000;
+  fs_info_.set_fs_name("test_fs");
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), MetaCodec::EncodeFsKey(fs_info_.fs_name()),
+                            MetaCodec::EncodeFsValue(fs_info_))
+                  .ok());
+
+  AttrEntry attr;
+  attr.set_fs_id(kFsId);
+  attr.set_ino(ino);
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), MetaCodec::EncodeInodeKey(kFsId, ino),
+                            MetaCodec::EncodeInodeValue(attr))
+                  .ok());
+
+  // clean same file again, e.g. retry after commit or rescan, not count again
+  for (int i = 0; i < 2; ++i) {
+    Trace trace;
+    UpdateFsRecycleProgressOperation operation(trace, fs_info_.fs_name(), ino, 10);
+    ASSERT_TRUE(RunAndCommit(operation).ok());
+  }
+
+  std::string value;
+  ASSERT_TRUE(storage_->Get(MetaCodec::EncodeFsKey(fs_info_.fs_name()), value).ok());
+  auto fs_info = MetaCodec::DecodeFsValue(value);
+  ASSERT_EQ(ino, fs_info.recycle_progress().last_ino());
+  ASSERT_EQ(1, fs_info.recycle_progress().deleted_file_num());
+  ASSERT_EQ(10, fs_info.recycle_progress().deleted_block_num());
+
+  ASSERT_EQ(pb::error::ENOT_FOUND, storage_->Get(MetaCodec::EncodeInodeKey(kFsId, ino), value).error_code());
+}
+
+// fail commit of txn which update more than one inode, until inject count is used up
+TEST_F(StoreOperationTest, BatchFailedOperation) {
+  const Ino ino = 1000;
+  AttrEntry attr;
+  attr.set_fs_id(kFsId);
+  attr.set_ino(ino);
+  attr.set_version(1);
+  ASSERT_TRUE(
+      storage_->Put(KVStorage::WriteOption(), MetaCodec::EncodeInodeKey(kFsId, ino), MetaCodec::EncodeInodeValue(attr))
+          .ok());
+
+  auto processor = OperationProcessor::New(storage_);
+
+  // fallocate fail in the middle of batch, the others still commit
+  Trace trace1, trace2, trace3;
+  AttrEntry new_attr = attr;
+  new_attr.set_mode(7);
+  UpdateAttrOperation::ExtraParam extra_param;
+  UpdateAttrOperation update_operation1(trace1, ino, kSetAttrMode, new_attr, extra_param);
+  FallocateOperation fallocate_operation(
+      trace2, {.fs_id = kFsId, .ino = ino, .mode = FALLOC_FL_COLLAPSE_RANGE, .offset = 0, .len = 4096});
+  new_attr.set_uid(9);
+  UpdateAttrOperation update_operation2(trace3, ino, kSetAttrUid, new_attr, extra_param);
+
+  bthread::CountdownEvent count_down(3);
+  for (Operation* operation : std::vector<Operation*>{&update_operation1, &fallocate_operation, &update_operation2}) {
+    operation->SetEvent(&count_down);
+    ASSERT_TRUE(processor->RunBatched(operation));
+  }
+
+  ASSERT_TRUE(processor->Init());
+  ASSERT_EQ(0, count_down.wait());
+
+  ASSERT_EQ(pb::error::ENOT_SUPPORT, fallocate_operation.GetResult().status.error_code());
+  ASSERT_TRUE(update_operation1.GetResult().status.ok());
+  ASSERT_TRUE(update_operation2.GetResult().status.ok());
+  ASSERT_EQ(2, update_operation2.GetResult().attr.version());
+
+  std::string value;
+  ASSERT_TRUE(storage_->Get(MetaCodec::EncodeInodeKey(kFsId, ino), value).ok());
+  auto stored_attr = MetaCodec::DecodeInodeValue(value);
+  ASSERT_EQ(7, stored_attr.mode());
+  ASSERT_EQ(9, stored_attr.uid());
+
+  processor->Destroy();
+}
+
+class ConflictStorage : public KVStorage {
+ public:
+  ConflictStorage(KVStorageSPtr storage, std::set<std::string> inode_keys, int conflict_count)
+      : storage_(storage), inode_keys_(std::move(inode_keys)), conflict_count_(conflict_count) {}
+
+  class ConflictTxn : public Txn {
+   public:
+    ConflictTxn(ConflictStorage* storage, TxnUPtr txn) : storage_(storage), txn_(std::move(txn)) {}
+
+    int64_t ID() const override { return txn_->ID(); }
+    Status Put(const std::string& key, const std::string& value) override {
+      if (storage_->inode_keys_.count(key) > 0) ++inode_num_;
+      return txn_->Put(key, value);
+    }
+    Status PutIfAbsent(const std::string& key, const std::string& value) override {
+      return txn_->PutIfAbsent(key, value);
+    }
+    Status Delete(const std::string& key) override { return txn_->Delete(key); }
+
+    Status Get(const std::string& key, std::string& value) override { return txn_->Get(key, value); }
+    Status BatchGet(const std::vector<std::string>& keys, std::vector<KeyValue>& kvs) override {
+      return txn_->BatchGet(keys, kvs);
+    }
+    Status Scan(const Range& range, uint64_t limit, std::vector<KeyValue>& kvs) override {
+      return txn_->Scan(range, limit, kvs);
+    }
+    Status Scan(const Range& range, ScanHandlerType handler) override { return txn_->Scan(range, handler); }
+    Status Scan(const Range& range, std::function<bool(KeyValue&)> handler) override {
+      return txn_->Scan(range, handler);
+    }
+
+    Status Commit() override {
+      if (inode_num_ > 1) {
+        ++storage_->multi_commit_count_;
+        if (storage_->conflict_count_.fetch_sub(1) > 0) {
+          return Status(pb::error::ESTORE_MAYBE_RETRY, "inject conflict");
+        }
+      }
+      return txn_->Commit();
+    }
+
+    Trace::Txn GetTrace() override { return txn_->GetTrace(); }
+
+   private:
+    ConflictStorage* storage_;
+    TxnUPtr txn_;
+    int inode_num_{0};
+  };
+
+  bool Init(const std::string& addr) override { return storage_->Init(addr); }
+  bool Destroy() override { return storage_->Destroy(); }
+
+  Status CreateTable(const std::string& name, const TableOption& option, int64_t& table_id) override {
+    return storage_->CreateTable(name, option, table_id);
+  }
+  Status DropTable(int64_t table_id) override { return storage_->DropTable(table_id); }
+  Status DropTable(const Range& range) override { return storage_->DropTable(range); }
+  Status IsExistTable(const std::string& start_key, const std::string& end_key) override {
+    return storage_->IsExistTable(start_key, end_key);
+  }
+
+  Status Put(WriteOption option, const std::string& key, const std::string& value) override {
+    return storage_->Put(option, key, value);
+  }
+  Status Put(WriteOption option, KeyValue& kv) override { return storage_->Put(option, kv); }
+  Status Put(WriteOption option, const std::vector<KeyValue>& kvs) override { return storage_->Put(option, kvs); }
+
+  Status Get(const std::string& key, std::string& value) override { return storage_->Get(key, value); }
+  Status BatchGet(const std::vector<std::string>& keys, std::vector<KeyValue>& kvs) override {
+    return storage_->BatchGet(keys, kvs);
+  }
+
+  Status Scan(const Range& range, std::vector<KeyValue>& kvs) override { return storage_->Scan(range, kvs); }
+
+  Status Delete(const std::string& key) override { return storage_->Delete(key); }
+  Status Delete(const std::vector<std::string>& keys) override { return storage_->Delete(keys); }
+
+  TxnUPtr NewTxn(Txn::IsolationLevel isolation_level) override {
+    return std::make_unique<ConflictTxn>(this, storage_->NewTxn(isolation_level));
+  }
+
+  int MultiCommitCount() const { return multi_commit_count_.load(); }
+
+ private:
+  KVStorageSPtr storage_;
+  std::set<std::string> inode_keys_;
+  std::atomic<int> conflict_count_;
+  std::atomic<int> multi_commit_count_{0};
+};
+
+TEST_F(StoreOperationTest, MultiInodeBatch) {
+  FLAGS_mds_store_operation_multi_inode_batch_enable = true;
+
+  // ino 1004 not exist
+  const std::vector<Ino> inos = {1000, 1001, 1002, 1003, 1004};
+  std::set<std::string> inode_keys;
+  for (auto ino : inos) {
+    inode_keys.insert(MetaCodec::EncodeInodeKey(kFsId, ino));
+    if (ino == 1004) continue;
+
+    AttrEntry attr;
+    attr.set_fs_id(kFsId);
+    attr.set_ino(ino);
+    attr.set_mode(0);
+    attr.set_version(1);
+    ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), MetaCodec::EncodeInodeKey(kFsId, ino),
+                              MetaCodec::EncodeInodeValue(attr))
+                    .ok());
+  }
+
+  // all 5 inodes conflict, then left 2 inodes conflict, split down to single inode
+  auto storage = std::make_shared<ConflictStorage>(storage_, inode_keys, 2);
+  auto processor = OperationProcessor::New(storage);
+
+  std::vector<Trace> traces(inos.size());
+  std::vector<AttrEntry> attrs(inos.size());
+  std::vector<UpdateAttrOperation::ExtraParam> extra_params(inos.size());
+  std::vector<std::unique_ptr<UpdateAttrOperation>> operations;
+  bthread::CountdownEvent count_down(inos.size());
+  for (size_t i = 0; i < inos.size(); ++i) {
+    attrs[i].set_fs_id(kFsId);
+    attrs[i].set_ino(inos[i]);
+    attrs[i].set_mode(inos[i]);
+    operations.push_back(
+        std::make_unique<UpdateAttrOperation>(traces[i], inos[i], kSetAttrMode, attrs[i], extra_params[i]));
+    operations[i]->SetEvent(&count_down);
+    ASSERT_TRUE(processor->RunBatched(operations[i].get()));
+  }
+
+  // all operations are queued before start, so run in one batch
+  ASSERT_TRUE(processor->Init());
+  ASSERT_EQ(0, count_down.wait());
+
+  for (size_t i = 0; i < inos.size(); ++i) {
+    auto& result = operations[i]->GetResult();
+    if (inos[i] == 1004) {
+      ASSERT_EQ(pb::error::ENOT_FOUND, result.status.error_code());
+      continue;
+    }
+
+    ASSERT_TRUE(result.status.ok()) << result.status.error_str();
+    ASSERT_EQ(inos[i], result.attr.ino());
+    ASSERT_EQ(inos[i], result.attr.mode());
+    ASSERT_EQ(2, result.attr.version());
+
+    std::string value;
+    ASSERT_TRUE(storage_->Get(MetaCodec::EncodeInodeKey(kFsId, inos[i]), value).ok());
+    ASSERT_EQ(inos[i], MetaCodec::DecodeInodeValue(value).mode());
+  }
+
+  // 5 -> (2 -> 1 + 1) + 3
+  ASSERT_EQ(3, storage->MultiCommitCount());
+
+  processor->Destroy();
+}
+
+TEST_F(StoreOperationTest, MultiInodeBatchFailedOperation) {
+  FLAGS_mds_store_operation_multi_inode_batch_enable = true;
+
+  const std::vector<Ino> inos = {1000, 1001, 1002};
+  std::set<std::string> inode_keys;
+  for (auto ino : inos) {
+    inode_keys.insert(MetaCodec::EncodeInodeKey(kFsId, ino));
+
+    AttrEntry attr;
+    attr.set_fs_id(kFsId);
+    attr.set_ino(ino);
+    attr.set_version(1);
+    ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), MetaCodec::EncodeInodeKey(kFsId, ino),
+                              MetaCodec::EncodeInodeValue(attr))
+                    .ok());
+  }
+
+  auto storage = std::make_shared<ConflictStorage>(storage_, inode_keys, 0);
+  auto processor = OperationProcessor::New(storage);
+
+  std::vector<Trace> traces(inos.size() + 1);
+  std::vector<AttrEntry> attrs(inos.size());
+  UpdateAttrOperation::ExtraParam extra_param;
+  std::vector<std::unique_ptr<UpdateAttrOperation>> operations;
+  bthread::CountdownEvent count_down(inos.size() + 1);
+  for (size_t i = 0; i < inos.size(); ++i) {
+    attrs[i].set_fs_id(kFsId);
+    attrs[i].set_ino(inos[i]);
+    attrs[i].set_mode(inos[i]);
+    operations.push_back(
+        std::make_unique<UpdateAttrOperation>(traces[i], inos[i], kSetAttrMode, attrs[i], extra_param));
+    operations[i]->SetEvent(&count_down);
+    ASSERT_TRUE(processor->RunBatched(operations[i].get()));
+  }
+
+  // fail in the shared txn of all inodes
+  FallocateOperation fallocate_operation(
+      traces.back(), {.fs_id = kFsId, .ino = 1001, .mode = FALLOC_FL_COLLAPSE_RANGE, .offset = 0, .len = 4096});
+  fallocate_operation.SetEvent(&count_down);
+  ASSERT_TRUE(processor->RunBatched(&fallocate_operation));
+
+  ASSERT_TRUE(processor->Init());
+  ASSERT_EQ(0, count_down.wait());
+
+  ASSERT_EQ(pb::error::ENOT_SUPPORT, fallocate_operation.GetResult().status.error_code());
+  for (size_t i = 0; i < inos.size(); ++i) {
+    auto& result = operations[i]->GetResult();
+    ASSERT_TRUE(result.status.ok()) << result.status.error_str();
+    ASSERT_EQ(inos[i], result.attr.mode());
+
+    std::string value;
+    ASSERT_TRUE(storage_->Get(MetaCodec::EncodeInodeKey(kFsId, inos[i]), value).ok());
+    ASSERT_EQ(inos[i], MetaCodec::DecodeInodeValue(value).mode());
+  }
+
+  // failed txn is not committed, the others rerun in one txn
+  ASSERT_EQ(1, storage->MultiCommitCount());
+
+  processor->Destroy();
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs
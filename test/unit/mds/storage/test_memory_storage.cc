@@ -0,0 +1,335 @@
+// Copyright (c) 2026 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "gflags/gflags.h"
+#include "gtest/gtest.h"
+#include "mds/storage/memory_storage.h"
+
+namespace dingofs {
+namespace mds {
+
+DECLARE_uint32(mds_storage_memory_checkpoint_mb);
+
+namespace unit_test {
+
+class MemoryStorageTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    storage_ = MemoryStorage::New();
+    ASSERT_TRUE(storage_->Init(""));
+  }
+
+  void TearDown() override { storage_->Destroy(); }
+
+  KVStorageSPtr storage_;
+};
+
+TEST_F(MemoryStorageTest, PutGet) {
+  auto txn = storage_->NewTxn();
+  ASSERT_TRUE(txn->Put("key1", "value1").ok());
+
+  // read own write before commit
+  std::string value;
+  ASSERT_TRUE(txn->Get("key1", value).ok());
+  ASSERT_EQ("value1", value);
+  ASSERT_TRUE(txn->Commit().ok());
+
+  value.clear();
+  ASSERT_TRUE(storage_->Get("key1", value).ok());
+  ASSERT_EQ("value1", value);
+
+  ASSERT_TRUE(storage_->Delete("key1").ok());
+  ASSERT_EQ(pb::error::ENOT_FOUND, storage_->Get("key1", value).error_code());
+}
+
+TEST_F(MemoryStorageTest, SnapshotIsolation) {
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key1", "value1").ok());
+
+  auto txn = storage_->NewTxn();
+
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key1", "value2").ok());
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key2", "value2").ok());
+
+  // txn still see the snapshot of its start
+  std::string value;
+  ASSERT_TRUE(txn->Get("key1", value).ok());
+  ASSERT_EQ("value1", value);
+  ASSERT_EQ(pb::error::ENOT_FOUND, txn->Get("key2", value).error_code());
+
+  // read committed see latest
+  auto rc_txn = storage_->NewTxn(Txn::kReadCommitted);
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key1", "value3").ok());
+  ASSERT_TRUE(rc_txn->Get("key1", value).ok());
+  ASSERT_EQ("value3", value);
+}
+
+TEST_F(MemoryStorageTest, WriteConflict) {
+  auto txn1 = storage_->NewTxn();
+  auto txn2 = storage_->NewTxn();
+
+  ASSERT_TRUE(txn1->Put("key1", "value1").ok());
+  ASSERT_TRUE(txn2->Put("key1", "value2").ok());
+
+  ASSERT_TRUE(txn1->Commit().ok());
+  ASSERT_EQ(pb::error::ESTORE_MAYBE_RETRY, txn2->Commit().error_code());
+  ASSERT_TRUE(txn2->GetTrace().is_conflict);
+
+  std::string value;
+  ASSERT_TRUE(storage_->Get("key1", value).ok());
+  ASSERT_EQ("value1", value);
+
+  // disjoint keys never conflict
+  auto txn3 = storage_->NewTxn();
+  auto txn4 = storage_->NewTxn();
+  ASSERT_TRUE(txn3->Put("key3", "value3").ok());
+  ASSERT_TRUE(txn4->Put("key4", "value4").ok());
+  ASSERT_TRUE(txn3->Commit().ok());
+  ASSERT_TRUE(txn4->Commit().ok());
+}
+
+TEST_F(MemoryStorageTest, PutIfAbsent) {
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key1", "value1").ok());
+
+  auto txn = storage_->NewTxn();
+  ASSERT_EQ(pb::error::EEXISTED, txn->PutIfAbsent("key1", "value2").error_code());
+
+  // key created by other txn after started
+  auto txn1 = storage_->NewTxn();
+  ASSERT_TRUE(txn1->PutIfAbsent("key2", "value2").ok());
+  ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key2", "value3").ok());
+  ASSERT_FALSE(txn1->Commit().ok());
+
+  KVStorage::WriteOption option{.is_if_absent = true};
+  ASSERT_EQ(pb::error::EEXISTED, storage_->Put(option, "key2", "value4").error_code());
+}
+
+TEST_F(MemoryStorageTest, Scan) {
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key" + std::to_string(i), "value").ok());
+  }
+
+  auto txn = storage_->NewTxn();
+  ASSERT_TRUE(txn->Delete("key1").ok());
+  ASSERT_TRUE(txn->Delete("key2").ok());
+  ASSERT_TRUE(txn->Put("key35", "staged").ok());
+  ASSERT_TRUE(txn->Put("key4", "staged").ok());
+
+  std::vector<KeyValue> kvs;
+  ASSERT_TRUE(txn->Scan(Range{"key0", "key5"}, 4, kvs).ok());
+  ASSERT_EQ(4, kvs.size());
+  ASSERT_EQ("key0", kvs[0].key);
+  ASSERT_EQ("key3", kvs[1].key);
+  ASSERT_EQ("key35", kvs[2].key);
+  ASSERT_EQ("key4", kvs[3].key);
+  ASSERT_EQ("staged", kvs[3].value);
+
+  kvs.clear();
+  ASSERT_TRUE(storage_->Scan(Range{"key0", "key5"}, kvs).ok());
+  ASSERT_EQ(5, kvs.size());
+}
+
+TEST_F(MemoryStorageTest, ScanStop) {
+  // keys spread over all shards, scan must merge them in order
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), fmt::format("key{:04}", i), "value").ok());
+  }
+
+  auto txn = storage_->NewTxn();
+  ASSERT_TRUE(txn->Put("key0100a", "staged").ok());
+
+  std::vector<std::string> keys;
+  ASSERT_TRUE(txn->Scan(Range{"key0000", "key1000"}, [&](KeyValue& kv) -> bool {
+                   keys.push_back(kv.key);
+                   return keys.size() < 300;
+                 }).ok());
+  ASSERT_EQ(300, keys.size());
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  ASSERT_EQ("key0000", keys.front());
+  ASSERT_EQ("key0100a", keys[101]);
+  ASSERT_EQ("key0298", keys.back());
+
+  std::vector<KeyValue> kvs;
+  ASSERT_TRUE(storage_->Scan(Range{"key0000", "key1000"}, kvs).ok());
+  ASSERT_EQ(1000, kvs.size());
+  ASSERT_EQ("key0999", kvs.back().key);
+}
+
+TEST_F(MemoryStorageTest, ScanWithWrite) {
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(storage_->Put(KVStorage::WriteOption(), "key" + std::to_string(i), "value").ok());
+  }
+
+  auto txn = storage_->NewTxn();
+  ASSERT_TRUE(txn->Put("key55", "staged").ok());
+
+  // write txn in handler, scan see staged writes when scan start
+  int count = 0;
+  ASSERT_TRUE(txn->Scan(Range{"key0", "key9"}, [&](KeyValue& kv) -> bool {
+                   ++count;
+                   EXPECT_TRUE(txn->Delete(kv.key).ok());
+                   EXPECT_TRUE(txn->Put(kv.key + "x", "new").ok());
+                   return true;
+                 }).ok());
+  ASSERT_EQ(10, count);
+  ASSERT_TRUE(txn->Commit().ok());
+
+  std::vector<KeyValue> kvs;
+  ASSERT_TRUE(storage_->Scan(Range{"key0", "key9"}, kvs).ok());
+  ASSERT_EQ(10, kvs.size());
+  for (const auto& kv : kvs) ASSERT_EQ('x', kv.key.back());
+}
+
+TEST(MemoryStorageRecoverTest, Recover) {
+  std::string path = std::filesystem::temp_directory_path() / ("memory_storage_" + std::to_string(::getpid()));
+  std::filesystem::remove_all(path);
+
+  {
+    auto storage = MemoryStorage::New();
+    ASSERT_TRUE(storage->Init(path));
+
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_TRUE(storage->Put(KVStorage::WriteOption(), "key" + std::to_string(i), "value" + std::to_string(i)).ok());
+    }
+    ASSERT_TRUE(storage->Delete("key0").ok());
+
+    auto txn = storage->NewTxn();
+    ASSERT_TRUE(txn->Put("key1", "new_value").ok());
+    ASSERT_TRUE(txn->Commit().ok());
+
+    storage->Destroy();
+  }
+
+  auto storage = MemoryStorage::New();
+  ASSERT_TRUE(storage->Init(path));
+
+  std::string value;
+  ASSERT_EQ(pb::error::ENOT_FOUND, storage->Get("key0", value).error_code());
+  ASSERT_TRUE(storage->Get("key1", value).ok());
+  ASSERT_EQ("new_value", value);
+  ASSERT_TRUE(storage->Get("key99", value).ok());
+  ASSERT_EQ("value99", value);
+
+  // new commit must not reuse recovered ts
+  auto txn = storage->NewTxn();
+  ASSERT_TRUE(txn->Put("key2", "new_value").ok());
+  ASSERT_TRUE(txn->Commit().ok());
+
+  storage->Destroy();
+  std::filesystem::remove_all(path);
+}
+
+TEST(MemoryStorageRecoverTest, Checkpoint) {
+  std::string path =
+      std::filesystem::temp_directory_path() / ("memory_storage_checkpoint_" + std::to_string(::getpid()));
+  std::filesystem::remove_all(path);
+
+  // checkpoint after every commit, in background with commit
+  uint32_t checkpoint_mb = FLAGS_mds_storage_memory_checkpoint_mb;
+  FLAGS_mds_storage_memory_checkpoint_mb = 0;
+
+  {
+    auto storage = MemoryStorage::New();
+    ASSERT_TRUE(storage->Init(path));
+
+    for (int i = 0; i < 2000; ++i) {
+      ASSERT_TRUE(storage->Put(KVStorage::WriteOption(), "key" + std::to_string(i), "value" + std::to_string(i)).ok());
+    }
+    for (int i = 0; i < 2000; i += 2) {
+      ASSERT_TRUE(storage->Delete("key" + std::to_string(i)).ok());
+    }
+
+    storage->Destroy();
+  }
+
+  FLAGS_mds_storage_memory_checkpoint_mb = checkpoint_mb;
+
+  auto storage = MemoryStorage::New();
+  ASSERT_TRUE(storage->Init(path));
+
+  std::vector<KeyValue> kvs;
+  ASSERT_TRUE(storage->Scan(Range{"key", "kez"}, kvs).ok());
+  ASSERT_EQ(1000, kvs.size());
+
+  std::string value;
+  ASSERT_EQ(pb::error::ENOT_FOUND, storage->Get("key0", value).error_code());
+  ASSERT_TRUE(storage->Get("key1999", value).ok());
+  ASSERT_EQ("value1999", value);
+
+  storage->Destroy();
+  std::filesystem::remove_all(path);
+}
+
+TEST(MemoryStorageRecoverTest, ShortWriteWal) {
+  std::string path =
+      std::filesystem::temp_directory_path() / ("memory_storage_short_write_" + std::to_string(::getpid()));
+  std::filesystem::remove_all(path);
+
+  {
+    auto storage = MemoryStorage::New();
+    ASSERT_TRUE(storage->Init(path));
+    ASSERT_TRUE(storage->Put(KVStorage::WriteOption(), "key1", "value1").ok());
+
+    // limit file size so the next wal record is written partially then fail with EFBIG
+    auto wal_size = std::filesystem::file_size(path + "/memory_storage.wal");
+    auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+    struct rlimit old_limit;
+    ASSERT_EQ(0, ::getrlimit(RLIMIT_FSIZE, &old_limit));
+    struct rlimit limit = old_limit;
+    limit.rlim_cur = wal_size + 16;
+    ASSERT_EQ(0, ::setrlimit(RLIMIT_FSIZE, &limit));
+
+    auto status = storage->Put(KVStorage::WriteOption(), "key2", std::string(4096, 'x'));
+
+    ASSERT_EQ(0, ::setrlimit(RLIMIT_FSIZE, &old_limit));
+    std::signal(SIGXFSZ, old_handler);
+
+    ASSERT_FALSE(status.ok());
+    std::string value;
+    ASSERT_EQ(pb::error::ENOT_FOUND, storage->Get("key2", value).error_code());
+
+    // torn record is dropped, later commit is not appended after garbage
+    ASSERT_EQ(wal_size, std::filesystem::file_size(path + "/memory_storage.wal"));
+    ASSERT_TRUE(storage->Put(KVStorage::WriteOption(), "key3", "value3").ok());
+
+    storage->Destroy();
+  }
+
+  auto storage = MemoryStorage::New();
+  ASSERT_TRUE(storage->Init(path));
+
+  std::string value;
+  ASSERT_TRUE(storage->Get("key1", value).ok());
+  ASSERT_EQ("value1", value);
+  ASSERT_EQ(pb::error::ENOT_FOUND, storage->Get("key2", value).error_code());
+  ASSERT_TRUE(storage->Get("key3", value).ok());
+  ASSERT_EQ("value3", value);
+
+  storage->Destroy();
+  std::filesystem::remove_all(path);
+}
+
+}  // namespace unit_test
+}  // namespace mds
+}  // namespace dingofs